@@ -125,11 +125,12 @@ def createOptions(numWorkers=1, initialTimeout=5, initialSplits=0, onlineSplits=
                   preprocessorBoundTolerance=0.0000000001, dumpBounds=False,
                   tighteningStrategy="deeppoly", milpTightening="none", milpSolverTimeout=0,
                   numSimulations=10, numBlasThreads=1, performLpTighteningAfterSplit=False,
-                  lpSolver=""):
+                  lpSolver="", lpTighteningSolver="", deepPolyMemoryBudget=1024,
+                  pricingStrategy="pse"):
     """Create an options object for how Marabou should solve the query
 
     Args:
-        numWorkers (int, optional): Number of workers to use in Split-and-Conquer(SnC) mode, defaults to 4
+        numWorkers (int, optional): Number of workers to use in Split-and-Conquer(SnC) mode, or of threads for DeepPoly analysis otherwise, defaults to 4
         initialTimeout (int, optional): Initial timeout in seconds for SnC mode before dividing, defaults to 5
         initialSplits (int, optional): Number of time sto perform the initial partitioning.
             This creates 2^(initialSplits) sub-problems for SnC mode, defaults to 0
@@ -146,12 +147,15 @@ def createOptions(numWorkers=1, initialTimeout=5, initialSplits=0, onlineSplits=
         preprocessorBoundTolerance ( float, optional): epsilon value for preprocess bound tightening . Defaults to 10^-10.
         dumpBounds (bool, optional): Print out the bounds of each neuron after preprocessing. defaults to False
         tighteningStrategy (string, optional): The abstract-interpretation-based bound tightening techniques used during the search (deeppoly/sbt/none). default to deeppoly.
-        milpTightening (string, optional): The (mi)lp-based bound tightening techniques used to preprocess the query (milp-inc/lp-inc/milp/lp/none). default to lp.
+        milpTightening (string, optional): The (mi)lp-based bound tightening techniques used to preprocess the query (milp-inc/lp-inc/lp-warm/milp/lp/none). default to lp.
         milpSolverTimeout (float, optional): Timeout duration for MILP
         numSimulations (int, optional): Number of simulations generated per neuron, defaults to 10
         numBlasThreads (int, optional): Number of threads to use when using OpenBLAS matrix multiplication (e.g., for DeepPoly analysis), defaults to 1
         performLpTighteningAfterSplit (bool, optional): Whether to perform a LP tightening after a case split, defaults to False
         lpSolver (string, optional): the engine for solving LP (native/gurobi).
+        lpTighteningSolver (string, optional): the engine for solving the LPs of the (mi)lp-based bound tightening (native/gurobi).
+        deepPolyMemoryBudget (int, optional): Megabytes of scratch memory for DeepPoly back-substitution, 0 for no limit, defaults to 1024
+        pricingStrategy (string, optional): Rule for choosing the simplex entering variable (pse/dantzig/bland/partial/multiple), defaults to pse
     Returns:
         :class:`~maraboupy.MarabouCore.Options`
     """
@@ -178,4 +182,7 @@ def createOptions(numWorkers=1, initialTimeout=5, initialSplits=0, onlineSplits=
     options._numBlasThreads = numBlasThreads
     options._performLpTighteningAfterSplit = performLpTighteningAfterSplit
     options._lpSolver = lpSolver
+    options._lpTighteningSolver = lpTighteningSolver
+    options._deepPolyMemoryBudget = deepPolyMemoryBudget
+    options._pricingStrategy = pricingStrategy
     return options
@@ -205,6 +205,7 @@ struct MarabouOptions {
         , _dumpBounds( Options::get()->getBool( Options::DUMP_BOUNDS ) )
         , _numWorkers( Options::get()->getInt( Options::NUM_WORKERS ) )
         , _numBlasThreads( Options::get()->getInt( Options::NUM_BLAS_THREADS ) )
+        , _deepPolyMemoryBudget( Options::get()->getInt( Options::DEEP_POLY_MEMORY_BUDGET_IN_MB ) )
         , _initialTimeout( Options::get()->getInt( Options::INITIAL_TIMEOUT ) )
         , _initialDivides( Options::get()->getInt( Options::NUM_INITIAL_DIVIDES ) )
         , _onlineDivides( Options::get()->getInt( Options::NUM_ONLINE_DIVIDES ) )
@@ -221,6 +222,8 @@ struct MarabouOptions {
         , _tighteningStrategyString( Options::get()->getString( Options::SYMBOLIC_BOUND_TIGHTENING_TYPE ).ascii() )
         , _milpTighteningString( Options::get()->getString( Options::MILP_SOLVER_BOUND_TIGHTENING_TYPE ).ascii() )
         , _lpSolverString( Options::get()->getString( Options::LP_SOLVER ).ascii() )
+        , _lpTighteningSolverString( Options::get()->getString( Options::LP_TIGHTENING_SOLVER ).ascii() )
+        , _pricingStrategyString( Options::get()->getString( Options::PRICING_STRATEGY ).ascii() )
         , _produceProofs( Options::get()->getBool( Options::PRODUCE_PROOFS ))
     {};
 
@@ -237,6 +240,7 @@ struct MarabouOptions {
     // int options
     Options::get()->setInt( Options::NUM_WORKERS, _numWorkers );
     Options::get()->setInt( Options::NUM_BLAS_THREADS, _numBlasThreads );
+    Options::get()->setInt( Options::DEEP_POLY_MEMORY_BUDGET_IN_MB, _deepPolyMemoryBudget );
     Options::get()->setInt( Options::INITIAL_TIMEOUT, _initialTimeout );
     Options::get()->setInt( Options::NUM_INITIAL_DIVIDES, _initialDivides );
     Options::get()->setInt( Options::NUM_ONLINE_DIVIDES, _onlineDivides );
@@ -255,6 +259,8 @@ struct MarabouOptions {
     Options::get()->setString( Options::SYMBOLIC_BOUND_TIGHTENING_TYPE, _tighteningStrategyString );
     Options::get()->setString( Options::MILP_SOLVER_BOUND_TIGHTENING_TYPE, _milpTighteningString );
     Options::get()->setString( Options::LP_SOLVER, _lpSolverString );
+    Options::get()->setString( Options::LP_TIGHTENING_SOLVER, _lpTighteningSolverString );
+    Options::get()->setString( Options::PRICING_STRATEGY, _pricingStrategyString );
   }
 
     bool _snc;
@@ -265,6 +271,7 @@ struct MarabouOptions {
     bool _produceProofs;
     unsigned _numWorkers;
     unsigned _numBlasThreads;
+    unsigned _deepPolyMemoryBudget;
     unsigned _initialTimeout;
     unsigned _initialDivides;
     unsigned _onlineDivides;
@@ -280,6 +287,8 @@ struct MarabouOptions {
     std::string _tighteningStrategyString;
     std::string _milpTighteningString;
     std::string _lpSolverString;
+    std::string _lpTighteningSolverString;
+    std::string _pricingStrategyString;
 };
 
 
@@ -426,6 +435,7 @@ PYBIND11_MODULE(MarabouCore, m) {
         .def(py::init())
         .def_readwrite("_numWorkers", &MarabouOptions::_numWorkers)
         .def_readwrite("_numBlasThreads", &MarabouOptions::_numBlasThreads)
+        .def_readwrite("_deepPolyMemoryBudget", &MarabouOptions::_deepPolyMemoryBudget)
         .def_readwrite("_initialTimeout", &MarabouOptions::_initialTimeout)
         .def_readwrite("_initialDivides", &MarabouOptions::_initialDivides)
         .def_readwrite("_onlineDivides", &MarabouOptions::_onlineDivides)
@@ -444,6 +454,8 @@ PYBIND11_MODULE(MarabouCore, m) {
         .def_readwrite("_tighteningStrategy", &MarabouOptions::_tighteningStrategyString)
         .def_readwrite("_milpTightening", &MarabouOptions::_milpTighteningString)
         .def_readwrite("_lpSolver", &MarabouOptions::_lpSolverString)
+        .def_readwrite("_lpTighteningSolver", &MarabouOptions::_lpTighteningSolverString)
+        .def_readwrite("_pricingStrategy", &MarabouOptions::_pricingStrategyString)
         .def_readwrite("_numSimulations", &MarabouOptions::_numSimulations)
         .def_readwrite("_performLpTighteningAfterSplit", &MarabouOptions::_performLpTighteningAfterSplit)
         .def_readwrite("_produceProofs", &MarabouOptions::_produceProofs);
@@ -482,14 +494,14 @@ PYBIND11_MODULE(MarabouCore, m) {
 
         Args:
             inputQuery (:class:`~maraboupy.MarabouCore.InputQuery`): Marabou input query to be saved
-            filename (str): Name of file to save query
+            filename (str): Name of file to save query, the binary format is used if it ends with .ipqb
         )pbdoc",
         py::arg("inputQuery"), py::arg("filename"));
     m.def("loadQuery", &loadQuery, R"pbdoc(
         Loads and returns a serialized InputQuery from the given filename
 
         Args:
-            filename (str): Name of file to load into an InputQuery
+            filename (str): Name of file to load into an InputQuery, read in the binary format if it ends with .ipqb
 
         Returns:
             :class:`~maraboupy.MarabouCore.InputQuery`
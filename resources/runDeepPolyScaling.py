@@ -0,0 +1,97 @@
+#! /usr/bin/env python3
+'''
+This file is part of the Marabou project.
+Copyright (c) 2017-2021 by the authors listed in the file AUTHORS
+in the top-level source directory) and their institutional affiliations.
+All rights reserved. See the file COPYING in the top-level source
+directory for licensing information.
+
+Measure how DeepPoly back-substitution scales with the number of threads.
+For every network, the input is bounded by an L-inf ball around a random
+point, and the query is preprocessed (which runs DeepPoly once) with
+--num-workers set to each of the requested thread counts.
+
+No scaling results from 1 to 32 threads have been recorded yet. They need a
+host with at least 32 cores, and none was available.
+'''
+
+import argparse
+import numpy as np
+import os
+import sys
+import time
+
+import pathlib
+sys.path.insert(0, os.path.join(str(pathlib.Path(__file__).parent.absolute()), "../"))
+from maraboupy import Marabou
+from maraboupy import MarabouCore
+
+RESOURCES_DIR = str(pathlib.Path(__file__).parent.absolute())
+
+DEFAULT_NETWORKS = ["onnx/mnist2x10.onnx",
+                    "onnx/cnn_max_mninst2.onnx",
+                    "onnx/cifar10/cifar_base_kw_simp.onnx",
+                    "onnx/cifar10/cifar_wide_kw_simp.onnx",
+                    "onnx/cifar10/cifar_deep_kw_simp.onnx"]
+
+def main():
+    args = arguments().parse_args()
+    networks = args.networks if args.networks else \
+        [os.path.join(RESOURCES_DIR, network) for network in DEFAULT_NETWORKS]
+    threads = [int(t) for t in args.threads.split(',')]
+
+    # Threads beyond the number of cores only time-share them, so their
+    # speedups say nothing about how DeepPoly scales
+    numberOfCores = len(os.sched_getaffinity(0))
+    if max(threads) > numberOfCores:
+        print("Warning: only {} cores are available, the speedups of more threads "
+              "are not meaningful".format(numberOfCores), file=sys.stderr)
+
+    print("{:<40} {:>8} {:>12} {:>8}".format("network", "threads", "seconds", "speedup"))
+    for networkPath in networks:
+        baseline = None
+        for numberOfThreads in threads:
+            seconds = min(timePreprocessing(networkPath, numberOfThreads, args)
+                          for _ in range(args.repeat))
+            if baseline is None:
+                baseline = seconds
+            print("{:<40} {:>8} {:>12.3f} {:>8.2f}".format(
+                os.path.basename(networkPath), numberOfThreads, seconds,
+                baseline / seconds))
+
+def timePreprocessing(networkPath, numberOfThreads, args):
+    network = Marabou.read_onnx(networkPath)
+    inputVars = np.array(network.inputVars).flatten()
+
+    rng = np.random.default_rng(args.seed)
+    point = rng.uniform(0, 1, len(inputVars))
+    for x, value in zip(inputVars, point):
+        network.setLowerBound(x, max(0, value - args.epsilon))
+        network.setUpperBound(x, min(1, value + args.epsilon))
+
+    query = network.getMarabouQuery()
+    options = Marabou.createOptions(numWorkers=numberOfThreads, verbosity=0,
+                                    tighteningStrategy="deeppoly",
+                                    deepPolyMemoryBudget=args.memory_budget)
+    start = time.perf_counter()
+    MarabouCore.preprocess(query, options, os.devnull)
+    return time.perf_counter() - start
+
+def arguments():
+    parser = argparse.ArgumentParser(description="Measure the scaling of DeepPoly with the number of threads")
+    parser.add_argument('networks', type=str, nargs='*',
+                        help='The onnx networks to analyze, defaults to the CIFAR10 and MNIST networks in resources/onnx')
+    parser.add_argument('--threads', type=str, default="1,2,4,8,16,32",
+                        help='Comma-separated thread counts, the first one is the baseline')
+    parser.add_argument('-e', '--epsilon', type=float, default=0.01,
+                        help='The radius of the L-inf ball around the input point')
+    parser.add_argument('--seed', type=int, default=1,
+                        help='The seed of the random input point')
+    parser.add_argument('--repeat', type=int, default=3,
+                        help='The number of runs per thread count, the fastest one is reported')
+    parser.add_argument('--memory-budget', type=int, default=1024,
+                        help='Megabytes of DeepPoly scratch memory, shared by all threads')
+    return parser
+
+if __name__ == "__main__":
+    main()
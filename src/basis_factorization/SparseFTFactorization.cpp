@@ -31,10 +31,15 @@ SparseFTFactorization::SparseFTFactorization( unsigned m, const BasisColumnOracl
     , _z2( NULL )
     , _z3( NULL )
     , _z4( NULL )
+    , _nonZeroIndices( NULL )
+    , _inPattern( NULL )
+    , _yIndices( NULL )
+    , _xIndices( NULL )
 {
     _z1 = new double[m];
     if ( !_z1 )
         throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseFTFactorization::z1" );
+    std::fill_n( _z1, m, 0.0 );
 
     _z2 = new double[m];
     if ( !_z2 )
@@ -47,6 +52,23 @@ SparseFTFactorization::SparseFTFactorization( unsigned m, const BasisColumnOracl
     _z4 = new double[m];
     if ( !_z4 )
         throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseFTFactorization::z4" );
+
+    _nonZeroIndices = new unsigned[m];
+    if ( !_nonZeroIndices )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseFTFactorization::nonZeroIndices" );
+
+    _inPattern = new bool[m];
+    if ( !_inPattern )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseFTFactorization::inPattern" );
+    std::fill_n( _inPattern, m, false );
+
+    _yIndices = new unsigned[m];
+    if ( !_yIndices )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseFTFactorization::yIndices" );
+
+    _xIndices = new unsigned[m];
+    if ( !_xIndices )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseFTFactorization::xIndices" );
 }
 
 SparseFTFactorization::~SparseFTFactorization()
@@ -81,6 +103,30 @@ void SparseFTFactorization::freeIfNeeded()
         delete[] _z4;
         _z4 = NULL;
     }
+
+    if ( _nonZeroIndices )
+    {
+        delete[] _nonZeroIndices;
+        _nonZeroIndices = NULL;
+    }
+
+    if ( _inPattern )
+    {
+        delete[] _inPattern;
+        _inPattern = NULL;
+    }
+
+    if ( _yIndices )
+    {
+        delete[] _yIndices;
+        _yIndices = NULL;
+    }
+
+    if ( _xIndices )
+    {
+        delete[] _xIndices;
+        _xIndices = NULL;
+    }
 }
 
 const double *SparseFTFactorization::getBasis() const
@@ -308,24 +354,71 @@ void SparseFTFactorization::updateToAdjacentBasis( unsigned columnIndex,
 }
 
 void SparseFTFactorization::forwardTransformation( const double *y, double *x ) const
+{
+    unsigned yNnz = collectNonZeros( y, _yIndices );
+    unsigned xNnz;
+
+    std::fill_n( x, _m, 0.0 );
+    forwardTransformation( y, _yIndices, yNnz, x, _xIndices, xNnz );
+}
+
+void SparseFTFactorization::backwardTransformation( const double *y, double *x ) const
+{
+    unsigned yNnz = collectNonZeros( y, _yIndices );
+    unsigned xNnz;
+
+    std::fill_n( x, _m, 0.0 );
+    backwardTransformation( y, _yIndices, yNnz, x, _xIndices, xNnz );
+}
+
+void SparseFTFactorization::forwardTransformation( const double *y, const unsigned *yIndices, unsigned yNnz,
+                                                   double *x, unsigned *xIndices, unsigned &xNnz ) const
 {
     /*
       We are solving Bx = y, and we have the factorization:
 
         B = FHV
+
+      The F and V solves are hypersparse while the vectors remain sparse.
+      They give up before changing any values if the vector becomes too
+      dense, in which case we continue with the dense solves.
     */
 
+    unsigned nnz = yNnz;
+    for ( unsigned i = 0; i < yNnz; ++i )
+    {
+        _z1[yIndices[i]] = y[yIndices[i]];
+        _nonZeroIndices[i] = yIndices[i];
+    }
+
     // Eliminate F
-    _sparseLUFactors.fForwardTransformation( y, _z1 );
+    if ( !_sparseLUFactors.fForwardTransformationSparse( _z1, _nonZeroIndices, nnz ) )
+    {
+        _sparseLUFactors.fForwardTransformation( y, _z1 );
+        hForwardTransformation( _z1, _z2 );
+        _sparseLUFactors.vForwardTransformation( _z2, x );
+
+        std::fill_n( _z1, _m, 0.0 );
+        xNnz = collectNonZeros( x, xIndices );
+        return;
+    }
 
     // Eliminate H
-    hForwardTransformation( _z1, _z2 );
+    hForwardTransformationSparse( _z1, _nonZeroIndices, nnz );
 
-    // Eliminate V
-    _sparseLUFactors.vForwardTransformation( _z2, x );
+    // Eliminate V. On success, this also clears _z1
+    if ( !_sparseLUFactors.vForwardTransformationSparse( _z1, _nonZeroIndices, nnz, x, xIndices, xNnz ) )
+    {
+        _sparseLUFactors.vForwardTransformation( _z1, x );
+
+        for ( unsigned i = 0; i < nnz; ++i )
+            _z1[_nonZeroIndices[i]] = 0;
+        xNnz = collectNonZeros( x, xIndices );
+    }
 }
 
-void SparseFTFactorization::backwardTransformation( const double *y, double *x ) const
+void SparseFTFactorization::backwardTransformation( const double *y, const unsigned *yIndices, unsigned yNnz,
+                                                    double *x, unsigned *xIndices, unsigned &xNnz ) const
 {
     /*
       We are solving xB = y, and we have the factorization:
@@ -333,14 +426,31 @@ void SparseFTFactorization::backwardTransformation( const double *y, double *x )
         B = FHV
     */
 
-    // Eliminate V
-    _sparseLUFactors.vBackwardTransformation( y, _z1 );
+    for ( unsigned i = 0; i < yNnz; ++i )
+        _z1[yIndices[i]] = y[yIndices[i]];
+
+    // Eliminate V. On success, this also clears _z1
+    if ( !_sparseLUFactors.vBackwardTransformationSparse( _z1, yIndices, yNnz, x, xIndices, xNnz ) )
+    {
+        _sparseLUFactors.vBackwardTransformation( y, _z1 );
+        hBackwardTransformation( _z1, _z2 );
+        _sparseLUFactors.fBackwardTransformation( _z2, x );
+
+        std::fill_n( _z1, _m, 0.0 );
+        xNnz = collectNonZeros( x, xIndices );
+        return;
+    }
 
     // Eliminate H
-    hBackwardTransformation( _z1, _z2 );
+    hBackwardTransformationSparse( x, xIndices, xNnz );
 
     // Eliminate F
-    _sparseLUFactors.fBackwardTransformation( _z2, x );
+    if ( !_sparseLUFactors.fBackwardTransformationSparse( x, xIndices, xNnz ) )
+    {
+        memcpy( _z2, x, sizeof(double) * _m );
+        _sparseLUFactors.fBackwardTransformation( _z2, x );
+        xNnz = collectNonZeros( x, xIndices );
+    }
 }
 
 void SparseFTFactorization::clearFactorization()
@@ -479,6 +589,75 @@ void SparseFTFactorization::hBackwardTransformation( const double *y, double *x
     }
 }
 
+void SparseFTFactorization::hForwardTransformationSparse( double *x, unsigned *indices, unsigned &nnz ) const
+{
+    if ( _etas.empty() )
+        return;
+
+    for ( unsigned i = 0; i < nnz; ++i )
+        _inPattern[indices[i]] = true;
+
+    for ( const auto &eta : _etas )
+    {
+        unsigned pivotIndex = eta->_columnIndex;
+
+        for ( const auto &entry : eta->_sparseColumn )
+            x[pivotIndex] -= entry._value * x[entry._index];
+
+        if ( !_inPattern[pivotIndex] && x[pivotIndex] != 0.0 )
+        {
+            _inPattern[pivotIndex] = true;
+            indices[nnz++] = pivotIndex;
+        }
+    }
+
+    for ( unsigned i = 0; i < nnz; ++i )
+        _inPattern[indices[i]] = false;
+}
+
+void SparseFTFactorization::hBackwardTransformationSparse( double *x, unsigned *indices, unsigned &nnz ) const
+{
+    if ( _etas.empty() )
+        return;
+
+    for ( unsigned i = 0; i < nnz; ++i )
+        _inPattern[indices[i]] = true;
+
+    for ( auto eta = _etas.rbegin(); eta != _etas.rend(); ++eta )
+    {
+        double pivotValue = x[(*eta)->_columnIndex];
+        if ( pivotValue == 0.0 )
+            continue;
+
+        for ( const auto &entry : (*eta)->_sparseColumn )
+        {
+            unsigned entryIndex = entry._index;
+            x[entryIndex] -= entry._value * pivotValue;
+
+            if ( !_inPattern[entryIndex] )
+            {
+                _inPattern[entryIndex] = true;
+                indices[nnz++] = entryIndex;
+            }
+        }
+    }
+
+    for ( unsigned i = 0; i < nnz; ++i )
+        _inPattern[indices[i]] = false;
+}
+
+unsigned SparseFTFactorization::collectNonZeros( const double *vector, unsigned *indices ) const
+{
+    unsigned nnz = 0;
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        if ( vector[i] != 0.0 )
+            indices[nnz++] = i;
+    }
+
+    return nnz;
+}
+
 void SparseFTFactorization::fixPForL()
 {
     if ( !_sparseLUFactors._usePForF )
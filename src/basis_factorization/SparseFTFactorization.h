@@ -71,6 +71,21 @@ public:
     */
     void backwardTransformation( const double *y, double *x ) const;
 
+    /*
+      Variants of the transformations for sparse vectors. Vectors are
+      stored densely, the non-zero entries of y are y[yIndices[0..yNnz)],
+      and x needs to be all zeros on entry. On exit, the non-zero entries of x are listed in
+      xIndices[0..xNnz) (the list may also include entries that cancelled
+      out to 0).
+
+      While the vectors involved are sparse, the work done depends on the
+      number of non-zero entries rather than on m.
+    */
+    void forwardTransformation( const double *y, const unsigned *yIndices, unsigned yNnz,
+                                double *x, unsigned *xIndices, unsigned &xNnz ) const;
+    void backwardTransformation( const double *y, const unsigned *yIndices, unsigned yNnz,
+                                 double *x, unsigned *xIndices, unsigned &xNnz ) const;
+
     /*
       Store and restore the basis factorization.
     */
@@ -144,12 +159,37 @@ private:
     double *_z3;
     double *_z4;
 
+    /*
+      Work memory for the sparse transformations: the non-zero pattern
+      of the vector being transformed, a marker of the entries in that
+      pattern, and the patterns of the input and output of the dense
+      transformations. _z1 is kept all zeros between transformations.
+    */
+    unsigned *_nonZeroIndices;
+    bool *_inPattern;
+    unsigned *_yIndices;
+    unsigned *_xIndices;
+
     /*
       Transformations on the H matrix (the list of etas)
     */
     void hForwardTransformation( const double *y, double *x ) const;
     void hBackwardTransformation( const double *y, double *x ) const;
 
+    /*
+      In-place variants of the H transformations for a vector whose
+      non-zero entries are listed in indices[0..nnz). Entries that
+      become non-zero are appended to the list.
+    */
+    void hForwardTransformationSparse( double *x, unsigned *indices, unsigned &nnz ) const;
+    void hBackwardTransformationSparse( double *x, unsigned *indices, unsigned &nnz ) const;
+
+    /*
+      List the indices of the non-zero entries of a dense vector, and
+      return their number.
+    */
+    unsigned collectNonZeros( const double *vector, unsigned *indices ) const;
+
     /*
       Free any allocated memory.
     */
@@ -16,6 +16,7 @@
 #include "BasisFactorizationError.h"
 #include "Debug.h"
 #include "FloatUtils.h"
+#include "GlobalConfiguration.h"
 #include "MString.h"
 #include "SparseLUFactors.h"
 
@@ -33,6 +34,11 @@ SparseLUFactors::SparseLUFactors( unsigned m )
     , _z( NULL )
     , _workMatrix( NULL )
     , _workVector( NULL )
+    , _marked( NULL )
+    , _dfsStack( NULL )
+    , _dfsPosition( NULL )
+    , _reach( NULL )
+    , _hypersparseLimit( m * GlobalConfiguration::HYPERSPARSE_SOLVE_DENSITY_THRESHOLD )
 {
     _F = new SparseUnsortedArrays();
     if ( !_F )
@@ -65,6 +71,23 @@ SparseLUFactors::SparseLUFactors( unsigned m )
     _workVector = new double[m];
     if ( !_workVector )
         throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseLUFactors::workVector" );
+
+    _marked = new bool[m];
+    if ( !_marked )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseLUFactors::marked" );
+    std::fill_n( _marked, m, false );
+
+    _dfsStack = new unsigned[m];
+    if ( !_dfsStack )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseLUFactors::dfsStack" );
+
+    _dfsPosition = new unsigned[m];
+    if ( !_dfsPosition )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseLUFactors::dfsPosition" );
+
+    _reach = new unsigned[m];
+    if ( !_reach )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseLUFactors::reach" );
 }
 
 SparseLUFactors::~SparseLUFactors()
@@ -116,6 +139,30 @@ SparseLUFactors::~SparseLUFactors()
         delete[] _workVector;
         _workVector = NULL;
     }
+
+    if ( _marked )
+    {
+        delete[] _marked;
+        _marked = NULL;
+    }
+
+    if ( _dfsStack )
+    {
+        delete[] _dfsStack;
+        _dfsStack = NULL;
+    }
+
+    if ( _dfsPosition )
+    {
+        delete[] _dfsPosition;
+        _dfsPosition = NULL;
+    }
+
+    if ( _reach )
+    {
+        delete[] _reach;
+        _reach = NULL;
+    }
 }
 
 void SparseLUFactors::dump() const
@@ -404,6 +451,232 @@ void SparseLUFactors::vBackwardTransformation( const double *y, double *x ) cons
     }
 }
 
+bool SparseLUFactors::computeReach( const SparseUnsortedArrays *matrix,
+                                    const unsigned *firstOrdering,
+                                    const unsigned *secondOrdering,
+                                    const unsigned *start,
+                                    unsigned startSize,
+                                    unsigned &top ) const
+{
+    /*
+      An iterative depth-first search. An entry is added to the reach
+      once all of its neighbors have been added, and the reach is filled
+      from the back - so every entry precedes the entries it updates.
+    */
+    top = _m;
+
+    const SparseUnsortedArray *sparseRow;
+    const SparseUnsortedArray::Entry *entry;
+    unsigned nnz;
+
+    for ( unsigned i = 0; i < startSize; ++i )
+    {
+        if ( _marked[start[i]] )
+            continue;
+
+        int head = 0;
+        _dfsStack[0] = start[i];
+        _dfsPosition[0] = 0;
+        _marked[start[i]] = true;
+
+        while ( head >= 0 )
+        {
+            unsigned node = _dfsStack[head];
+            unsigned row = firstOrdering ? secondOrdering[firstOrdering[node]] : node;
+
+            sparseRow = matrix->getRow( row );
+            entry = sparseRow->getArray();
+            nnz = sparseRow->getNnz();
+
+            unsigned &position = _dfsPosition[head];
+            while ( position < nnz && _marked[entry[position]._index] )
+                ++position;
+
+            if ( position < nnz )
+            {
+                // Descend into an unvisited neighbor
+                unsigned neighbor = entry[position]._index;
+                ++position;
+
+                _marked[neighbor] = true;
+                ++head;
+                _dfsStack[head] = neighbor;
+                _dfsPosition[head] = 0;
+                continue;
+            }
+
+            --head;
+            _reach[--top] = node;
+
+            if ( _m - top > _hypersparseLimit )
+            {
+                // Too dense, give up
+                for ( unsigned j = top; j < _m; ++j )
+                    _marked[_reach[j]] = false;
+                for ( int j = 0; j <= head; ++j )
+                    _marked[_dfsStack[j]] = false;
+                return false;
+            }
+        }
+    }
+
+    for ( unsigned i = top; i < _m; ++i )
+        _marked[_reach[i]] = false;
+
+    return true;
+}
+
+bool SparseLUFactors::fForwardTransformationSparse( double *x, unsigned *indices, unsigned &nnz ) const
+{
+    // Solve F*x = y, where column j of F updates the entries of x in row j of F'
+    unsigned top;
+    if ( nnz > _hypersparseLimit || !computeReach( _Ft, NULL, NULL, indices, nnz, top ) )
+        return false;
+
+    double xElement;
+    const SparseUnsortedArray *sparseColumn;
+    const SparseUnsortedArray::Entry *entry;
+    unsigned columnNnz;
+
+    nnz = 0;
+    for ( unsigned i = top; i < _m; ++i )
+    {
+        unsigned fColumn = _reach[i];
+        indices[nnz++] = fColumn;
+
+        xElement = x[fColumn];
+        if ( xElement != 0.0 )
+        {
+            sparseColumn = _Ft->getRow( fColumn );
+            entry = sparseColumn->getArray();
+            columnNnz = sparseColumn->getNnz();
+
+            for ( unsigned j = 0; j < columnNnz; ++j )
+                x[entry[j]._index] -= xElement * entry[j]._value;
+        }
+    }
+
+    return true;
+}
+
+bool SparseLUFactors::fBackwardTransformationSparse( double *x, unsigned *indices, unsigned &nnz ) const
+{
+    // Solve x*F = y, where row j of F updates the entries of x it lists
+    unsigned top;
+    if ( nnz > _hypersparseLimit || !computeReach( _F, NULL, NULL, indices, nnz, top ) )
+        return false;
+
+    double xElement;
+    const SparseUnsortedArray *sparseRow;
+    const SparseUnsortedArray::Entry *entry;
+    unsigned rowNnz;
+
+    nnz = 0;
+    for ( unsigned i = top; i < _m; ++i )
+    {
+        unsigned fRow = _reach[i];
+        indices[nnz++] = fRow;
+
+        xElement = x[fRow];
+        if ( xElement != 0.0 )
+        {
+            sparseRow = _F->getRow( fRow );
+            entry = sparseRow->getArray();
+            rowNnz = sparseRow->getNnz();
+
+            for ( unsigned j = 0; j < rowNnz; ++j )
+                x[entry[j]._index] -= xElement * entry[j]._value;
+        }
+    }
+
+    return true;
+}
+
+bool SparseLUFactors::vForwardTransformationSparse( double *y, const unsigned *yIndices, unsigned yNnz,
+                                                    double *x, unsigned *xIndices, unsigned &xNnz ) const
+{
+    /*
+      Solve V*x = y. Entry vRow of y determines entry vColumn of x, where
+      (vRow, vColumn) is a diagonal element of V, and then updates the
+      entries of y in column vColumn of V.
+    */
+    unsigned top;
+    if ( yNnz > _hypersparseLimit ||
+         !computeReach( _Vt, _P._rowOrdering, _Q._rowOrdering, yIndices, yNnz, top ) )
+        return false;
+
+    double xElement;
+    const SparseUnsortedArray *sparseColumn;
+    const SparseUnsortedArray::Entry *entry;
+    unsigned columnNnz;
+
+    xNnz = 0;
+    for ( unsigned i = top; i < _m; ++i )
+    {
+        unsigned vRow = _reach[i];
+        unsigned vColumn = _Q._rowOrdering[_P._rowOrdering[vRow]];
+        xIndices[xNnz++] = vColumn;
+
+        xElement = x[vColumn] = ( y[vRow] / _vDiagonalElements[vRow] );
+        if ( xElement != 0.0 )
+        {
+            sparseColumn = _Vt->getRow( vColumn );
+            entry = sparseColumn->getArray();
+            columnNnz = sparseColumn->getNnz();
+
+            for ( unsigned j = 0; j < columnNnz; ++j )
+                y[entry[j]._index] -= xElement * entry[j]._value;
+        }
+
+        // Later entries in the order do not update this one
+        y[vRow] = 0;
+    }
+
+    return true;
+}
+
+bool SparseLUFactors::vBackwardTransformationSparse( double *y, const unsigned *yIndices, unsigned yNnz,
+                                                     double *x, unsigned *xIndices, unsigned &xNnz ) const
+{
+    /*
+      Solve x*V = y. Entry vColumn of y determines entry vRow of x, where
+      (vRow, vColumn) is a diagonal element of V, and then updates the
+      entries of y in row vRow of V.
+    */
+    unsigned top;
+    if ( yNnz > _hypersparseLimit ||
+         !computeReach( _V, _Q._columnOrdering, _P._columnOrdering, yIndices, yNnz, top ) )
+        return false;
+
+    double xElement;
+    const SparseUnsortedArray *sparseRow;
+    const SparseUnsortedArray::Entry *entry;
+    unsigned rowNnz;
+
+    xNnz = 0;
+    for ( unsigned i = top; i < _m; ++i )
+    {
+        unsigned vColumn = _reach[i];
+        unsigned vRow = _P._columnOrdering[_Q._columnOrdering[vColumn]];
+        xIndices[xNnz++] = vRow;
+
+        xElement = x[vRow] = ( y[vColumn] / _vDiagonalElements[vRow] );
+        if ( xElement != 0.0 )
+        {
+            sparseRow = _V->getRow( vRow );
+            entry = sparseRow->getArray();
+            rowNnz = sparseRow->getNnz();
+
+            for ( unsigned j = 0; j < rowNnz; ++j )
+                y[entry[j]._index] -= xElement * entry[j]._value;
+        }
+
+        y[vColumn] = 0;
+    }
+
+    return true;
+}
+
 void SparseLUFactors::forwardTransformation( const double *y, double *x ) const
 {
     /*
@@ -110,6 +110,32 @@ public:
     void vForwardTransformation( const double *y, double *x ) const;
     void vBackwardTransformation( const double *y, double *x ) const;
 
+    /*
+      Hypersparse variants of the F and V transformations, for right-hand
+      sides with few non-zero entries. Vectors are stored densely, and the
+      positions of their non-zero entries are listed in indices[0..nnz).
+      On exit, the list holds the non-zero pattern of the solution (which
+      may include entries that cancelled out to 0).
+
+      The pattern of the solution is computed first, by a depth-first
+      search over the graph of the factor from the non-zero entries of y
+      (Gilbert-Peierls). The numeric phase then visits only these entries,
+      in a topological order. If the right-hand side or the pattern of the
+      solution is too dense, the functions return false before changing
+      any values, and the dense transformations should be used instead.
+
+      The F transformations work in place, on x. The V transformations
+      store the solution in x, which needs to be all zeros on entry, and
+      its pattern in xIndices. They use y as work memory, and leave it all
+      zeros on success.
+    */
+    bool fForwardTransformationSparse( double *x, unsigned *indices, unsigned &nnz ) const;
+    bool fBackwardTransformationSparse( double *x, unsigned *indices, unsigned &nnz ) const;
+    bool vForwardTransformationSparse( double *y, const unsigned *yIndices, unsigned yNnz,
+                                       double *x, unsigned *xIndices, unsigned &xNnz ) const;
+    bool vBackwardTransformationSparse( double *y, const unsigned *yIndices, unsigned yNnz,
+                                        double *x, unsigned *xIndices, unsigned &xNnz ) const;
+
     /*
       Compute the inverse of the factorized basis
     */
@@ -122,6 +148,33 @@ public:
     double *_workMatrix;
     double *_workVector;
 
+    /*
+      Work memory for the hypersparse transformations: the search marks,
+      the search stack and the reached entries in topological order
+      (stored at the end of _reach). The largest pattern handled
+      hypersparsely is _hypersparseLimit entries.
+    */
+    bool *_marked;
+    unsigned *_dfsStack;
+    unsigned *_dfsPosition;
+    unsigned *_reach;
+    unsigned _hypersparseLimit;
+
+    /*
+      Compute the entries reachable from start[0..startSize) in the graph
+      of a factor, where the neighbors of entry i are the indices of
+      matrix row secondOrdering[firstOrdering[i]] (or row i, if no
+      orderings are given). The result is stored in _reach[top.._m), in
+      topological order. Returns false if more than _hypersparseLimit
+      entries are reachable.
+    */
+    bool computeReach( const SparseUnsortedArrays *matrix,
+                       const unsigned *firstOrdering,
+                       const unsigned *secondOrdering,
+                       const unsigned *start,
+                       unsigned startSize,
+                       unsigned &top ) const;
+
     /*
       Clone this SparseLUFactors object into another object
     */
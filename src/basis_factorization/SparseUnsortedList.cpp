@@ -17,30 +17,115 @@
 #include "Debug.h"
 #include "FloatUtils.h"
 #include "SparseUnsortedList.h"
+#include "SparseUnsortedListArena.h"
+
+#include <cstring>
 
 SparseUnsortedList::SparseUnsortedList()
     : _size( 0 )
+    , _entries( NULL )
+    , _nnz( 0 )
+    , _capacity( 0 )
+    , _arena( NULL )
 {
 }
 
 SparseUnsortedList::SparseUnsortedList( unsigned size )
     : _size( size )
+    , _entries( NULL )
+    , _nnz( 0 )
+    , _capacity( 0 )
+    , _arena( NULL )
+{
+}
+
+SparseUnsortedList::SparseUnsortedList( unsigned size, SparseUnsortedListArena *arena )
+    : _size( size )
+    , _entries( NULL )
+    , _nnz( 0 )
+    , _capacity( 0 )
+    , _arena( arena )
 {
 }
 
 SparseUnsortedList::SparseUnsortedList( const double *V, unsigned size )
+    : _size( 0 )
+    , _entries( NULL )
+    , _nnz( 0 )
+    , _capacity( 0 )
+    , _arena( NULL )
 {
     initialize( V, size );
 }
 
+SparseUnsortedList::SparseUnsortedList( const SparseUnsortedList &other )
+    : _size( 0 )
+    , _entries( NULL )
+    , _nnz( 0 )
+    , _capacity( 0 )
+    , _arena( NULL )
+{
+    other.storeIntoOther( this );
+}
+
 SparseUnsortedList::~SparseUnsortedList()
 {
+    freeMemoryIfNeeded();
+}
+
+void SparseUnsortedList::freeMemoryIfNeeded()
+{
+    if ( _entries )
+    {
+        if ( _arena )
+            _arena->release( _entries, _capacity );
+        else
+            delete[] _entries;
+
+        _entries = NULL;
+    }
+
+    _nnz = 0;
+    _capacity = 0;
+}
+
+void SparseUnsortedList::reserve( unsigned capacity )
+{
+    if ( capacity <= _capacity )
+        return;
+
+    unsigned newCapacity = _capacity > 0 ? _capacity : (unsigned)MIN_CAPACITY;
+    while ( newCapacity < capacity )
+        newCapacity *= 2;
+
+    Entry *newEntries;
+    if ( _arena )
+        newEntries = _arena->allocate( newCapacity, newCapacity );
+    else
+        newEntries = new Entry[newCapacity];
+
+    if ( !newEntries )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseUnsortedList::entries" );
+
+    if ( _entries )
+    {
+        memcpy( newEntries, _entries, sizeof(Entry) * _nnz );
+
+        if ( _arena )
+            _arena->release( _entries, _capacity );
+        else
+            delete[] _entries;
+    }
+
+    _entries = newEntries;
+    _capacity = newCapacity;
 }
 
 void SparseUnsortedList::initialize( const double *V, unsigned size )
 {
     _size = size;
-    _list.clear();
+    _nnz = 0;
 
     for ( unsigned i = 0; i < _size; ++i )
     {
@@ -48,31 +133,42 @@ void SparseUnsortedList::initialize( const double *V, unsigned size )
         if ( FloatUtils::isZero( V[i] ) )
             continue;
 
-        _list.append( Entry( i, V[i] ) );
+        append( i, V[i] );
     }
 }
 
+void SparseUnsortedList::initializeToEmpty()
+{
+    _size = 0;
+    _nnz = 0;
+}
+
 void SparseUnsortedList::clear()
 {
-    _list.clear();
+    _nnz = 0;
 }
 
 unsigned SparseUnsortedList::getNnz() const
 {
-    return _list.size();
+    return _nnz;
 }
 
 bool SparseUnsortedList::empty() const
 {
-    return _list.empty();
+    return _nnz == 0;
+}
+
+unsigned SparseUnsortedList::getCapacity() const
+{
+    return _capacity;
 }
 
 double SparseUnsortedList::get( unsigned entry ) const
 {
-    for ( const auto &listEntry : _list )
+    for ( unsigned i = 0; i < _nnz; ++i )
     {
-        if ( listEntry._index == entry )
-            return listEntry._value;
+        if ( _entries[i]._index == entry )
+            return _entries[i]._value;
     }
 
     return 0;
@@ -80,8 +176,8 @@ double SparseUnsortedList::get( unsigned entry ) const
 
 void SparseUnsortedList::dump() const
 {
-    printf( "\nDumping sparse unsortedList: (nnz = %u)\n", _list.size() );
-    for ( const auto &entry : _list )
+    printf( "\nDumping sparse unsortedList: (nnz = %u)\n", _nnz );
+    for ( const auto &entry : *this )
         printf( "\tEntry %u: %6.2lf\n", entry._index, entry._value );
     printf( "\n" );
 }
@@ -101,14 +197,14 @@ void SparseUnsortedList::toDense( double *result ) const
 {
     std::fill_n( result, _size, 0 );
 
-    for ( const auto &entry : _list )
-        result[entry._index] = entry._value;
+    for ( unsigned i = 0; i < _nnz; ++i )
+        result[_entries[i]._index] = _entries[i]._value;
 }
 
 SparseUnsortedList &SparseUnsortedList::operator=( const SparseUnsortedList &other )
 {
-    _size = other._size;
-    _list = other._list;
+    if ( this != &other )
+        other.storeIntoOther( this );
 
     return *this;
 }
@@ -116,27 +212,32 @@ SparseUnsortedList &SparseUnsortedList::operator=( const SparseUnsortedList &oth
 void SparseUnsortedList::storeIntoOther( SparseUnsortedList *other ) const
 {
     other->_size = _size;
-    other->_list = _list;
+    other->_nnz = 0;
+    other->reserve( _nnz );
+
+    if ( _nnz > 0 )
+        memcpy( other->_entries, _entries, sizeof(Entry) * _nnz );
+    other->_nnz = _nnz;
 }
 
-List<SparseUnsortedList::Entry>::const_iterator SparseUnsortedList::begin() const
+SparseUnsortedList::const_iterator SparseUnsortedList::begin() const
 {
-    return _list.begin();
+    return _entries;
 }
 
-List<SparseUnsortedList::Entry>::const_iterator SparseUnsortedList::end() const
+SparseUnsortedList::const_iterator SparseUnsortedList::end() const
 {
-    return _list.end();
+    return _entries + _nnz;
 }
 
-List<SparseUnsortedList::Entry>::iterator SparseUnsortedList::begin()
+SparseUnsortedList::iterator SparseUnsortedList::begin()
 {
-    return _list.begin();
+    return _entries;
 }
 
-List<SparseUnsortedList::Entry>::iterator SparseUnsortedList::end()
+SparseUnsortedList::iterator SparseUnsortedList::end()
 {
-    return _list.end();
+    return _entries + _nnz;
 }
 
 void SparseUnsortedList::set( unsigned index, double value )
@@ -148,7 +249,7 @@ void SparseUnsortedList::set( unsigned index, double value )
         if ( it->_index == index )
         {
             if ( isZero )
-                _list.erase( it );
+                erase( it );
             else
                 it->_value = value;
 
@@ -157,18 +258,23 @@ void SparseUnsortedList::set( unsigned index, double value )
     }
 
     if ( !isZero )
-        _list.append( Entry( index, value ) );
+        append( index, value );
 }
 
 void SparseUnsortedList::append( unsigned index, double value )
 {
-    _list.append( Entry( index, value ) );
+    if ( _nnz == _capacity )
+        reserve( _nnz + 1 );
+
+    _entries[_nnz]._index = index;
+    _entries[_nnz]._value = value;
+    ++_nnz;
 }
 
 void SparseUnsortedList::addLastEntry( double entry )
 {
     if ( !FloatUtils::isZero( entry ) )
-        _list.append( Entry( _size, entry ) );
+        append( _size, entry );
 
     ++_size;
 }
@@ -180,33 +286,33 @@ void SparseUnsortedList::incrementSize()
 
 void SparseUnsortedList::mergeEntries( unsigned source, unsigned target )
 {
-    List<Entry>::iterator sourceIt = _list.end();
-    List<Entry>::iterator targetIt = _list.end();
-    List<Entry>::iterator it;
+    iterator sourceIt = end();
+    iterator targetIt = end();
+    iterator it;
 
-    for ( it = _list.begin(); it != _list.end(); ++it )
+    for ( it = begin(); it != end(); ++it )
     {
         if ( it->_index == source )
         {
             sourceIt = it;
-            if ( targetIt != _list.end() )
+            if ( targetIt != end() )
                 break;
         }
 
         if ( it->_index == target )
         {
             targetIt = it;
-            if ( sourceIt != _list.end() )
+            if ( sourceIt != end() )
                 break;
         }
     }
 
     // If no source entry exists, we are done
-    if ( sourceIt == _list.end() )
+    if ( sourceIt == end() )
         return;
 
     // If no target entry, simply change index on source entry
-    if ( targetIt == _list.end() )
+    if ( targetIt == end() )
     {
         sourceIt->_index = target;
         return;
@@ -214,15 +320,26 @@ void SparseUnsortedList::mergeEntries( unsigned source, unsigned target )
 
     // Both source and target entries
     targetIt->_value += sourceIt->_value;
+    bool targetIsZero = FloatUtils::isZero( targetIt->_value );
+
+    // Erasing the source shifts the target if it comes later
+    if ( targetIt > sourceIt )
+        --targetIt;
+    erase( sourceIt );
 
-    _list.erase( sourceIt );
-    if ( FloatUtils::isZero( targetIt->_value ) )
-         _list.erase( targetIt );
+    if ( targetIsZero )
+        erase( targetIt );
 }
 
-List<SparseUnsortedList::Entry>::iterator SparseUnsortedList::erase( List<SparseUnsortedList::Entry>::iterator it )
+SparseUnsortedList::iterator SparseUnsortedList::erase( iterator it )
 {
-    return _list.erase( it );
+    ASSERT( begin() <= it && it < end() );
+
+    iterator last = end();
+    memmove( it, it + 1, sizeof(Entry) * ( last - it - 1 ) );
+    --_nnz;
+
+    return it;
 }
 
 unsigned SparseUnsortedList::getSize() const
@@ -19,11 +19,19 @@
 #include "HashMap.h"
 #include "SparseMatrix.h"
 
+class SparseUnsortedListArena;
+
 class SparseUnsortedList
 {
 public:
     struct Entry
     {
+        Entry()
+            : _index( 0 )
+            , _value( 0 )
+        {
+        }
+
         Entry( unsigned index, double value )
             : _index( index )
             , _value( value )
@@ -34,17 +42,30 @@ public:
         double _value;
     };
 
+    /*
+      The entries are kept contiguously in memory, and so iterators are
+      plain pointers. Erasing an entry or growing the storage
+      invalidates iterators.
+    */
+    typedef Entry *iterator;
+    typedef const Entry *const_iterator;
+
     /*
       Initialization: the size determines the dimension of the
       underlying storage.
 
       A unsortedList can be initialized from a dense unsortedList, or it
       can remain empty.
+
+      If an arena is provided, the entry storage is taken from (and
+      returned to) the arena, which must outlive the list.
     */
     SparseUnsortedList();
     ~SparseUnsortedList();
     SparseUnsortedList( unsigned size );
+    SparseUnsortedList( unsigned size, SparseUnsortedListArena *arena );
     SparseUnsortedList( const double *V, unsigned size );
+    SparseUnsortedList( const SparseUnsortedList &other );
     void initialize( const double *V, unsigned size );
     void initializeToEmpty();
 
@@ -93,15 +114,17 @@ public:
     /*
       Retrieve entries
     */
-    List<Entry>::const_iterator begin() const;
-    List<Entry>::const_iterator end() const;
-    List<Entry>::iterator begin();
-    List<Entry>::iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+    iterator begin();
+    iterator end();
 
     /*
-      Erasing an element by iterator
+      Erasing an element by iterator. The order of the remaining
+      elements is preserved, and the returned iterator points to the
+      element that followed the erased one.
     */
-    List<Entry>::iterator erase( List<Entry>::iterator it );
+    iterator erase( iterator it );
 
     /*
       Addes the coefficient for entry 'source' to entry 'target'
@@ -120,9 +143,31 @@ public:
     void dump() const;
     void dumpDense() const;
 
+    /*
+      The number of entries that fit in the currently allocated
+      storage
+    */
+    unsigned getCapacity() const;
+
 private:
+    enum {
+        MIN_CAPACITY = 4,
+    };
+
     unsigned _size;
-    List<Entry> _list;
+
+    Entry *_entries;
+    unsigned _nnz;
+    unsigned _capacity;
+
+    SparseUnsortedListArena *_arena;
+
+    /*
+      Make room for at least the given number of entries, keeping
+      the current ones
+    */
+    void reserve( unsigned capacity );
+    void freeMemoryIfNeeded();
 };
 
 #endif // __SparseUnsortedList_h__
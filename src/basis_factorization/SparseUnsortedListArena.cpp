@@ -0,0 +1,98 @@
+/*********************                                                        */
+/*! \file SparseUnsortedListArena.cpp
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "BasisFactorizationError.h"
+#include "Debug.h"
+#include "SparseUnsortedListArena.h"
+
+SparseUnsortedListArena::SparseUnsortedListArena()
+    : _numberOfAllocatedBytes( 0 )
+    , _currentSlab( NULL )
+    , _currentSlabUsed( 0 )
+{
+}
+
+SparseUnsortedListArena::~SparseUnsortedListArena()
+{
+    for ( auto &slab : _slabs )
+        delete[] slab;
+    _slabs.clear();
+}
+
+SparseUnsortedList::Entry *SparseUnsortedListArena::allocateSlab( unsigned size )
+{
+    SparseUnsortedList::Entry *slab = new SparseUnsortedList::Entry[size];
+    if ( !slab )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseUnsortedListArena::slab" );
+
+    _slabs.append( slab );
+    _numberOfAllocatedBytes += sizeof(SparseUnsortedList::Entry) * size;
+    return slab;
+}
+
+SparseUnsortedList::Entry *SparseUnsortedListArena::allocate( unsigned requested, unsigned &capacity )
+{
+    unsigned sizeClass = 0;
+    capacity = 1;
+    while ( capacity < requested )
+    {
+        capacity *= 2;
+        ++sizeClass;
+    }
+
+    if ( sizeClass < _freeBlocks.size() && !_freeBlocks[sizeClass].empty() )
+        return _freeBlocks[sizeClass].pop();
+
+    // Large blocks get a slab of their own
+    if ( capacity >= SLAB_SIZE )
+        return allocateSlab( capacity );
+
+    if ( !_currentSlab || _currentSlabUsed + capacity > SLAB_SIZE )
+    {
+        _currentSlab = allocateSlab( SLAB_SIZE );
+        _currentSlabUsed = 0;
+    }
+
+    SparseUnsortedList::Entry *block = _currentSlab + _currentSlabUsed;
+    _currentSlabUsed += capacity;
+    return block;
+}
+
+void SparseUnsortedListArena::release( SparseUnsortedList::Entry *block, unsigned capacity )
+{
+    ASSERT( block );
+
+    unsigned sizeClass = 0;
+    while ( ( 1U << sizeClass ) < capacity )
+        ++sizeClass;
+
+    ASSERT( ( 1U << sizeClass ) == capacity );
+
+    while ( _freeBlocks.size() <= sizeClass )
+        _freeBlocks.append( Vector<SparseUnsortedList::Entry *>() );
+    _freeBlocks[sizeClass].append( block );
+}
+
+unsigned long long SparseUnsortedListArena::getNumberOfAllocatedBytes() const
+{
+    return _numberOfAllocatedBytes;
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
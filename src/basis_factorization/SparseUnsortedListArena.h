@@ -0,0 +1,77 @@
+/*********************                                                        */
+/*! \file SparseUnsortedListArena.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#ifndef __SparseUnsortedListArena_h__
+#define __SparseUnsortedListArena_h__
+
+#include "List.h"
+#include "SparseUnsortedList.h"
+#include "Vector.h"
+
+/*
+  An arena from which many SparseUnsortedLists (e.g., the rows and
+  columns of a tableau) take their entry storage. Memory is carved out
+  of large slabs in power-of-two blocks; released blocks are recycled
+  for later requests of the same size, and all memory is returned when
+  the arena is destroyed.
+*/
+class SparseUnsortedListArena
+{
+public:
+    SparseUnsortedListArena();
+    ~SparseUnsortedListArena();
+
+    /*
+      Allocate a block of at least the requested number of entries.
+      The actual capacity of the block is stored in capacity.
+    */
+    SparseUnsortedList::Entry *allocate( unsigned requested, unsigned &capacity );
+
+    /*
+      Return a block to the arena, for reuse
+    */
+    void release( SparseUnsortedList::Entry *block, unsigned capacity );
+
+    /*
+      The total number of bytes held by the arena
+    */
+    unsigned long long getNumberOfAllocatedBytes() const;
+
+private:
+    enum {
+        SLAB_SIZE = 4096,
+    };
+
+    List<SparseUnsortedList::Entry *> _slabs;
+    unsigned long long _numberOfAllocatedBytes;
+
+    SparseUnsortedList::Entry *_currentSlab;
+    unsigned _currentSlabUsed;
+
+    /*
+      Released blocks, indexed by the log2 of their capacity
+    */
+    Vector<Vector<SparseUnsortedList::Entry *>> _freeBlocks;
+
+    SparseUnsortedList::Entry *allocateSlab( unsigned size );
+};
+
+#endif // __SparseUnsortedListArena_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
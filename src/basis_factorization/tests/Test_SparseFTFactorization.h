@@ -375,6 +375,117 @@ public:
         TS_ASSERT_THROWS_NOTHING( basis.forwardTransformation( a3, d3 ) );
         TS_ASSERT( memcmp( d3other, d3, sizeof(double) * 3 ) );
     }
+
+    void checkTransformations( const SparseFTFactorization &basis, const double *B, unsigned m )
+    {
+        double *y = new double[m];
+        double *x = new double[m];
+        double *sparseX = new double[m];
+        unsigned *xIndices = new unsigned[m];
+        unsigned xNnz;
+
+        // Unit vectors are solved hypersparsely, the all-ones vector densely
+        for ( unsigned k = 0; k <= m; ++k )
+        {
+            for ( unsigned i = 0; i < m; ++i )
+                y[i] = ( k == m || i == k ) ? 1 : 0;
+
+            // Bx = y
+            std::fill_n( x, m, 7.0 );
+            TS_ASSERT_THROWS_NOTHING( basis.forwardTransformation( y, x ) );
+            for ( unsigned i = 0; i < m; ++i )
+            {
+                double sum = 0;
+                for ( unsigned j = 0; j < m; ++j )
+                    sum += B[i * m + j] * x[j];
+                TS_ASSERT( FloatUtils::areEqual( sum, y[i] ) );
+            }
+
+            if ( k < m )
+            {
+                // The sparse variant reports the pattern of the solution
+                std::fill_n( sparseX, m, 0.0 );
+                TS_ASSERT_THROWS_NOTHING( basis.forwardTransformation( y, &k, 1, sparseX, xIndices, xNnz ) );
+                for ( unsigned i = 0; i < xNnz; ++i )
+                    sparseX[xIndices[i]] -= x[xIndices[i]];
+                for ( unsigned i = 0; i < m; ++i )
+                    TS_ASSERT( FloatUtils::isZero( sparseX[i] ) );
+            }
+
+            // xB = y
+            std::fill_n( x, m, 7.0 );
+            TS_ASSERT_THROWS_NOTHING( basis.backwardTransformation( y, x ) );
+            for ( unsigned j = 0; j < m; ++j )
+            {
+                double sum = 0;
+                for ( unsigned i = 0; i < m; ++i )
+                    sum += x[i] * B[i * m + j];
+                TS_ASSERT( FloatUtils::areEqual( sum, y[j] ) );
+            }
+
+            if ( k < m )
+            {
+                std::fill_n( sparseX, m, 0.0 );
+                TS_ASSERT_THROWS_NOTHING( basis.backwardTransformation( y, &k, 1, sparseX, xIndices, xNnz ) );
+                for ( unsigned i = 0; i < xNnz; ++i )
+                    sparseX[xIndices[i]] -= x[xIndices[i]];
+                for ( unsigned i = 0; i < m; ++i )
+                    TS_ASSERT( FloatUtils::isZero( sparseX[i] ) );
+            }
+        }
+
+        delete[] xIndices;
+        delete[] sparseX;
+        delete[] x;
+        delete[] y;
+    }
+
+    void test_hypersparse_transformations()
+    {
+        /*
+          A sparse basis, large enough for the hypersparse solves to kick
+          in: a diagonal of 4s, with some entries paired by an entry
+          below the diagonal and some columns having an extra entry far
+          from the diagonal. The basis is diagonally dominant by columns,
+          and so remains invertible when columns are replaced below.
+        */
+        const unsigned m = 60;
+        double B[m * m];
+        std::fill_n( B, m * m, 0.0 );
+        for ( unsigned j = 0; j < m; ++j )
+        {
+            B[j * m + j] = 4;
+            if ( j % 2 == 0 )
+                B[( j + 1 ) * m + j] = 1;
+            if ( j % 9 == 0 )
+                B[( ( j + 31 ) % m ) * m + j] = -1.5;
+        }
+
+        oracle->storeBasis( m, B );
+        SparseFTFactorization basis( m, *oracle );
+        basis.obtainFreshBasis();
+
+        checkTransformations( basis, B, m );
+
+        // Replace some columns, so that the factorization accumulates etas
+        unsigned columns[] = { 3, 40, 17, 58, 8 };
+        double newColumn[m];
+        for ( unsigned column : columns )
+        {
+            std::fill_n( newColumn, m, 0.0 );
+            newColumn[column] = -4;
+            newColumn[( column + 5 ) % m] = 1;
+            newColumn[( column + m - 2 ) % m] = 2;
+
+            basis.updateToAdjacentBasis( column, NULL, newColumn );
+
+            for ( unsigned i = 0; i < m; ++i )
+                B[i * m + column] = newColumn[i];
+            oracle->storeBasis( m, B );
+
+            checkTransformations( basis, B, m );
+        }
+    }
 };
 
 //
@@ -18,6 +18,7 @@
 #include "FloatUtils.h"
 #include "Map.h"
 #include "SparseUnsortedList.h"
+#include "SparseUnsortedListArena.h"
 
 class MockForSparseUnsortedList
 {
@@ -174,6 +175,71 @@ public:
 
         TS_ASSERT_EQUALS( v1.getNnz(), 0U );
     }
+
+    void test_erase()
+    {
+        double dense[6] = {
+            1, 0, 2, 3, 0, 4
+        };
+
+        SparseUnsortedList v1( dense, 6 );
+
+        // Erase every even value while iterating
+        for ( auto it = v1.begin(); it != v1.end(); )
+        {
+            if ( FloatUtils::areEqual( it->_value, 2 ) || FloatUtils::areEqual( it->_value, 4 ) )
+                it = v1.erase( it );
+            else
+                ++it;
+        }
+
+        TS_ASSERT_EQUALS( v1.getNnz(), 2U );
+
+        // The remaining entries keep their order
+        auto it = v1.begin();
+        TS_ASSERT_EQUALS( it->_index, 0U );
+        ++it;
+        TS_ASSERT_EQUALS( it->_index, 3U );
+        ++it;
+        TS_ASSERT_EQUALS( it, v1.end() );
+    }
+
+    void test_arena()
+    {
+        SparseUnsortedListArena arena;
+
+        SparseUnsortedList *v1 = new SparseUnsortedList( 100, &arena );
+        SparseUnsortedList *v2 = new SparseUnsortedList( 100, &arena );
+
+        for ( unsigned i = 0; i < 100; i += 2 )
+            v1->append( i, i + 1 );
+
+        TS_ASSERT_EQUALS( v1->getNnz(), 50U );
+        TS_ASSERT_EQUALS( v1->getCapacity(), 64U );
+        for ( unsigned i = 0; i < 100; ++i )
+            TS_ASSERT_EQUALS( v1->get( i ), i % 2 == 0 ? i + 1 : 0 );
+
+        // Cloning into a list outside the arena, and back
+        SparseUnsortedList v3;
+        TS_ASSERT_THROWS_NOTHING( v1->storeIntoOther( &v3 ) );
+        TS_ASSERT_EQUALS( v3.getNnz(), 50U );
+        TS_ASSERT_THROWS_NOTHING( v3.storeIntoOther( v2 ) );
+        for ( unsigned i = 0; i < 100; ++i )
+            TS_ASSERT_EQUALS( v2->get( i ), v1->get( i ) );
+
+        unsigned long long allocatedBytes = arena.getNumberOfAllocatedBytes();
+        TS_ASSERT( allocatedBytes > 0 );
+
+        // Released blocks are recycled
+        TS_ASSERT_THROWS_NOTHING( delete v1 );
+        SparseUnsortedList *v4 = new SparseUnsortedList( 100, &arena );
+        for ( unsigned i = 0; i < 50; ++i )
+            v4->append( i, 1 );
+        TS_ASSERT_EQUALS( arena.getNumberOfAllocatedBytes(), allocatedBytes );
+
+        TS_ASSERT_THROWS_NOTHING( delete v4 );
+        TS_ASSERT_THROWS_NOTHING( delete v2 );
+    }
 };
 
 //
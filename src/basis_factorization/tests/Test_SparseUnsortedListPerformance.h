@@ -0,0 +1,133 @@
+/*********************                                                        */
+/*! \file Test_SparseUnsortedListPerformance.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Micro-benchmark comparing the contiguous SparseUnsortedList against
+ ** the linked-list layout it replaced. Timings are printed, not
+ ** asserted; the suite is labeled "perf" and only runs when
+ ** RUN_PERF_TEST is on.
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "FloatUtils.h"
+#include "List.h"
+#include "SparseUnsortedList.h"
+#include "SparseUnsortedListArena.h"
+#include "TimeUtils.h"
+
+class SparseUnsortedListPerformanceTestSuite : public CxxTest::TestSuite
+{
+public:
+    enum {
+        NUM_LISTS = 2000,
+        LIST_SIZE = 2000,
+        NNZ_PER_LIST = 40,
+        ITERATIONS = 50,
+    };
+
+    /*
+      The previous layout: one heap node per entry
+    */
+    typedef List<SparseUnsortedList::Entry> LinkedEntries;
+
+    void populate( SparseUnsortedList **lists, LinkedEntries *linkedLists )
+    {
+        for ( unsigned i = 0; i < NUM_LISTS; ++i )
+        {
+            for ( unsigned j = 0; j < NNZ_PER_LIST; ++j )
+            {
+                unsigned index = ( i * 7 + j * 53 ) % LIST_SIZE;
+                double value = 1.0 + ( i + j ) % 11;
+                lists[i]->append( index, value );
+                linkedLists[i].append( SparseUnsortedList::Entry( index, value ) );
+            }
+        }
+    }
+
+    void report( const char *name, unsigned long long linkedMicro, unsigned long long contiguousMicro )
+    {
+        printf( "\n\t%s: linked list %llu us, contiguous %llu us (speedup %.2fx)",
+                name,
+                linkedMicro,
+                contiguousMicro,
+                contiguousMicro > 0 ? (double)linkedMicro / contiguousMicro : 0 );
+    }
+
+    void test_iteration_and_store_into_other()
+    {
+        SparseUnsortedListArena arena;
+        SparseUnsortedList *lists[NUM_LISTS];
+        SparseUnsortedList *copies[NUM_LISTS];
+        LinkedEntries *linkedLists = new LinkedEntries[NUM_LISTS];
+        LinkedEntries *linkedCopies = new LinkedEntries[NUM_LISTS];
+
+        for ( unsigned i = 0; i < NUM_LISTS; ++i )
+        {
+            lists[i] = new SparseUnsortedList( LIST_SIZE, &arena );
+            copies[i] = new SparseUnsortedList( LIST_SIZE );
+        }
+
+        populate( lists, linkedLists );
+
+        // Iteration
+        double linkedSum = 0;
+        struct timespec start = TimeUtils::sampleMicro();
+        for ( unsigned k = 0; k < ITERATIONS; ++k )
+            for ( unsigned i = 0; i < NUM_LISTS; ++i )
+                for ( const auto &entry : linkedLists[i] )
+                    linkedSum += entry._value * entry._index;
+        unsigned long long linkedMicro = TimeUtils::timePassed( start, TimeUtils::sampleMicro() );
+
+        double contiguousSum = 0;
+        start = TimeUtils::sampleMicro();
+        for ( unsigned k = 0; k < ITERATIONS; ++k )
+            for ( unsigned i = 0; i < NUM_LISTS; ++i )
+                for ( const auto &entry : *lists[i] )
+                    contiguousSum += entry._value * entry._index;
+        unsigned long long contiguousMicro = TimeUtils::timePassed( start, TimeUtils::sampleMicro() );
+
+        TS_ASSERT( FloatUtils::areEqual( linkedSum, contiguousSum ) );
+        report( "Iteration", linkedMicro, contiguousMicro );
+
+        // Cloning
+        start = TimeUtils::sampleMicro();
+        for ( unsigned k = 0; k < ITERATIONS; ++k )
+            for ( unsigned i = 0; i < NUM_LISTS; ++i )
+                linkedCopies[i] = linkedLists[i];
+        linkedMicro = TimeUtils::timePassed( start, TimeUtils::sampleMicro() );
+
+        start = TimeUtils::sampleMicro();
+        for ( unsigned k = 0; k < ITERATIONS; ++k )
+            for ( unsigned i = 0; i < NUM_LISTS; ++i )
+                lists[i]->storeIntoOther( copies[i] );
+        contiguousMicro = TimeUtils::timePassed( start, TimeUtils::sampleMicro() );
+
+        for ( unsigned i = 0; i < NUM_LISTS; ++i )
+            TS_ASSERT_EQUALS( copies[i]->getNnz(), linkedCopies[i].size() );
+        report( "storeIntoOther", linkedMicro, contiguousMicro );
+        printf( "\n" );
+
+        for ( unsigned i = 0; i < NUM_LISTS; ++i )
+        {
+            delete copies[i];
+            delete lists[i];
+        }
+        delete[] linkedCopies;
+        delete[] linkedLists;
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,24 @@
+# Writes the abbreviated hash of the current commit to BenchCommitHash.h.
+# Run at build time, so that the hash is never older than the build; the
+# header is only rewritten when the hash changes.
+#
+#   cmake -DSOURCE_DIR=<dir> -DOUTPUT=<file> -P CommitHash.cmake
+
+execute_process(
+  COMMAND git log -1 --format=%h
+  WORKING_DIRECTORY ${SOURCE_DIR}
+  OUTPUT_VARIABLE BENCH_COMMIT_HASH
+  OUTPUT_STRIP_TRAILING_WHITESPACE
+  ERROR_QUIET
+)
+if ("${BENCH_COMMIT_HASH}" STREQUAL "")
+    set(BENCH_COMMIT_HASH "unknown")
+endif()
+
+set(contents "#define BENCH_COMMIT_HASH \"${BENCH_COMMIT_HASH}\"\n")
+if (EXISTS ${OUTPUT})
+    file(READ ${OUTPUT} previous)
+endif()
+if (NOT "${contents}" STREQUAL "${previous}")
+    file(WRITE ${OUTPUT} "${contents}")
+endif()
@@ -0,0 +1,86 @@
+#! /usr/bin/env python3
+'''
+Compare two JSON files written by MarabouBench (the marabou-bench target).
+
+For every query that appears in both files, the median over the
+repetitions of the wall time and of each phase timer is reported, along
+with the ratio of the new median to the baseline one. Queries whose
+answer changed, or whose wall time grew by more than the threshold, are
+flagged.
+'''
+
+import argparse
+import json
+import statistics
+import sys
+
+PHASES = ["wall_time_micro", "preprocessing_micro", "sbt_micro", "simplex_micro",
+          "smt_core_micro", "bound_tightening_micro"]
+
+def main():
+    args = arguments().parse_args()
+    baseline = load(args.baseline)
+    current = load(args.current)
+
+    print("{:<60} {:>12} {:>12} {:>8}".format("query / phase", "baseline ms", "current ms", "ratio"))
+    regressions = []
+    for name, runs in current.items():
+        if name not in baseline:
+            print("{:<60} {:>12} (new query)".format(name, ""))
+            continue
+
+        oldRuns = baseline[name]
+        oldResults = {run["result"] for run in oldRuns}
+        newResults = {run["result"] for run in runs}
+        if oldResults != newResults:
+            regressions.append("{}: answer changed from {} to {}".format(
+                name, "/".join(sorted(oldResults)), "/".join(sorted(newResults))))
+
+        for phase in PHASES:
+            old = median(oldRuns, phase)
+            new = median(runs, phase)
+            ratio = new / old if old > 0 else None
+            label = name if phase == "wall_time_micro" else "  " + phase
+            print("{:<60} {:>12.1f} {:>12.1f} {:>8}".format(label[:60], old / 1000, new / 1000,
+                                                          "-" if ratio is None else "{:.2f}".format(ratio)))
+
+            if phase == "wall_time_micro" and ratio is not None and ratio > 1 + args.threshold:
+                regressions.append("{}: wall time grew by {:.0f}%".format(name, (ratio - 1) * 100))
+
+    for name in baseline:
+        if name not in current:
+            print("{:<60} (missing from the current run)".format(name))
+
+    totalOld = sum(median(baseline[name], "wall_time_micro") for name in current if name in baseline)
+    totalNew = sum(median(current[name], "wall_time_micro") for name in current if name in baseline)
+    if totalOld > 0:
+        print("\nTotal wall time of common queries: {:.1f} ms -> {:.1f} ms ({:.2f}x)".format(
+            totalOld / 1000, totalNew / 1000, totalNew / totalOld))
+
+    if regressions:
+        print("\nRegressions (threshold {:.0f}%):".format(args.threshold * 100))
+        for regression in regressions:
+            print("  " + regression)
+        if args.fail_on_regression:
+            sys.exit(1)
+
+def load(path):
+    with open(path) as f:
+        results = json.load(f)
+    return {query["name"]: query["runs"] for query in results["queries"]}
+
+def median(runs, phase):
+    return statistics.median(run[phase] for run in runs)
+
+def arguments():
+    parser = argparse.ArgumentParser(description="Compare two marabou-bench result files")
+    parser.add_argument('baseline', type=str, help='The JSON file of the baseline run')
+    parser.add_argument('current', type=str, help='The JSON file of the run to compare')
+    parser.add_argument('--threshold', type=float, default=0.1,
+                        help='Relative growth of the median wall time reported as a regression')
+    parser.add_argument('--fail-on-regression', action='store_true',
+                        help='Exit with a non-zero code if there are regressions')
+    return parser
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,403 @@
+/*********************                                                        */
+/*! \file main.cpp
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Runs every query of a benchmark suite a number of times, in-process,
+ ** and writes the wall time and the phase timers of the engine's
+ ** statistics of each run to a JSON file. Options that are not
+ ** recognized here are passed on to Marabou, e.g.
+ **
+ **   MarabouBench --suite suite.txt --output bench.json --blas-threads 4
+ **
+ ** Queries are solved by a single engine, so options that would make
+ ** Marabou solve in split-and-conquer mode are rejected.
+ **
+ ** The suite file lists one query per line: either a network (.nnet or
+ ** .onnx) followed by an optional property file, an .mps file, or a
+ ** serialized .ipq or .ipqb query. Paths are relative to --root, and lines
+ ** starting with # are ignored.
+
+ **/
+
+#include "AcasParser.h"
+#include "BenchCommitHash.h"
+#include "BinaryQueryFormat.h"
+#include "CommonError.h"
+#include "Engine.h"
+#include "Error.h"
+#include "File.h"
+#include "InputQuery.h"
+#include "MarabouError.h"
+#include "MStringf.h"
+#include "MpsParser.h"
+#include "OnnxParser.h"
+#include "Options.h"
+#include "PropertyParser.h"
+#include "QueryLoader.h"
+#include "Statistics.h"
+#include "TimeUtils.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#ifdef ENABLE_OPENBLAS
+#include "cblas.h"
+#endif
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+struct BenchmarkQuery
+{
+    String _name;
+    String _queryFile;
+    String _propertyFile;
+};
+
+struct BenchmarkRun
+{
+    String _result;
+    unsigned long long _wallTimeMicro;
+    unsigned long long _parsingTimeMicro;
+    unsigned long long _preprocessingTimeMicro;
+    unsigned long long _sbtTimeMicro;
+    unsigned long long _simplexTimeMicro;
+    unsigned long long _smtCoreTimeMicro;
+    unsigned long long _boundTighteningTimeMicro;
+    unsigned long long _mainLoopIterations;
+    unsigned long long _simplexSteps;
+    unsigned _splits;
+};
+
+static void printUsage()
+{
+    printf( "Usage: MarabouBench --suite <file> [--output <file>] [--root <dir>]\n"
+            "                    [--repetitions <n>] [--cpu <cpu>] [--timeout <seconds>]\n"
+            "                    [--filter <substring>] [Marabou options]\n" );
+}
+
+static String baseName( const String &path )
+{
+    List<String> tokens = path.tokenize( "/" );
+    return tokens.empty() ? path : tokens.back();
+}
+
+static List<BenchmarkQuery> readSuite( const String &suiteFile, const String &root,
+                                       const String &filter )
+{
+    List<BenchmarkQuery> queries;
+
+    File file( suiteFile );
+    file.open( File::MODE_READ );
+
+    try
+    {
+        while ( true )
+        {
+            String line = file.readLine().trim();
+            if ( line.length() == 0 || line.substring( 0, 1 ) == "#" )
+                continue;
+
+            List<String> tokens = line.tokenize( " " );
+            BenchmarkQuery query;
+            query._queryFile = root + "/" + tokens.front();
+            query._name = baseName( tokens.front() );
+            if ( tokens.size() > 1 )
+            {
+                query._propertyFile = root + "/" + tokens.back();
+                query._name += String( "%" ) + baseName( tokens.back() );
+            }
+
+            if ( filter.length() == 0 || query._name.contains( filter ) )
+                queries.append( query );
+        }
+    }
+    catch ( const CommonError &e )
+    {
+        // A "READ_FAILED" is how we know we're out of lines
+        if ( e.getCode() != CommonError::READ_FAILED )
+            throw e;
+    }
+
+    return queries;
+}
+
+static void loadQuery( const BenchmarkQuery &query, InputQuery &inputQuery )
+{
+    String path = query._queryFile;
+    if ( !File::exists( path ) )
+        throw MarabouError( MarabouError::FILE_DOESNT_EXIST, path.ascii() );
+
+    if ( path.endsWith( ".ipq" ) || path.endsWith( BinaryQueryFormat::FILE_EXTENSION ) )
+    {
+        inputQuery = QueryLoader::loadQuery( path );
+        inputQuery.constructNetworkLevelReasoner();
+        return;
+    }
+
+    if ( path.endsWith( ".mps" ) )
+    {
+        MpsParser( path ).generateQuery( inputQuery );
+        return;
+    }
+
+    if ( path.endsWith( ".onnx" ) )
+        OnnxParser( path ).generateQuery( inputQuery );
+    else
+        AcasParser( path ).generateQuery( inputQuery );
+
+    inputQuery.constructNetworkLevelReasoner();
+
+    if ( query._propertyFile.length() > 0 )
+        PropertyParser().parse( query._propertyFile, inputQuery );
+}
+
+static String exitCodeToString( Engine::ExitCode exitCode )
+{
+    switch ( exitCode )
+    {
+    case Engine::SAT:
+        return "sat";
+    case Engine::UNSAT:
+        return "unsat";
+    case Engine::TIMEOUT:
+        return "timeout";
+    case Engine::ERROR:
+        return "error";
+    default:
+        return "unknown";
+    }
+}
+
+static BenchmarkRun runQuery( const BenchmarkQuery &query, unsigned timeoutInSeconds )
+{
+    BenchmarkRun run = BenchmarkRun();
+
+    struct timespec start = TimeUtils::sampleMicro();
+
+    InputQuery inputQuery;
+    loadQuery( query, inputQuery );
+
+    struct timespec parsed = TimeUtils::sampleMicro();
+
+    Engine engine;
+    if ( engine.processInputQuery( inputQuery ) )
+        engine.solve( timeoutInSeconds );
+
+    struct timespec end = TimeUtils::sampleMicro();
+
+    run._result = exitCodeToString( engine.getExitCode() );
+    run._wallTimeMicro = TimeUtils::timePassed( start, end );
+    run._parsingTimeMicro = TimeUtils::timePassed( start, parsed );
+
+    const Statistics *statistics = engine.getStatistics();
+    run._preprocessingTimeMicro =
+        statistics->getLongAttribute( Statistics::PREPROCESSING_TIME_MICRO );
+    run._sbtTimeMicro =
+        statistics->getLongAttribute( Statistics::TOTAL_TIME_PERFORMING_SYMBOLIC_BOUND_TIGHTENING );
+    run._simplexTimeMicro =
+        statistics->getLongAttribute( Statistics::TIME_SIMPLEX_STEPS_MICRO );
+    run._smtCoreTimeMicro =
+        statistics->getLongAttribute( Statistics::TOTAL_TIME_SMT_CORE_MICRO );
+    run._boundTighteningTimeMicro =
+        statistics->getLongAttribute( Statistics::TOTAL_TIME_EXPLICIT_BASIS_BOUND_TIGHTENING_MICRO ) +
+        statistics->getLongAttribute( Statistics::TOTAL_TIME_CONSTRAINT_MATRIX_BOUND_TIGHTENING_MICRO ) +
+        statistics->getLongAttribute( Statistics::TOTAL_TIME_APPLYING_STORED_TIGHTENINGS_MICRO );
+    run._mainLoopIterations =
+        statistics->getLongAttribute( Statistics::NUM_MAIN_LOOP_ITERATIONS );
+    run._simplexSteps =
+        statistics->getLongAttribute( Statistics::NUM_SIMPLEX_STEPS );
+    run._splits = statistics->getUnsignedAttribute( Statistics::NUM_SPLITS );
+
+    return run;
+}
+
+static String runToJson( const BenchmarkRun &run )
+{
+    return Stringf( "{ \"result\": \"%s\", \"wall_time_micro\": %llu, "
+                    "\"parsing_micro\": %llu, \"preprocessing_micro\": %llu, "
+                    "\"sbt_micro\": %llu, \"simplex_micro\": %llu, "
+                    "\"smt_core_micro\": %llu, \"bound_tightening_micro\": %llu, "
+                    "\"main_loop_iterations\": %llu, \"simplex_steps\": %llu, "
+                    "\"splits\": %u }",
+                    run._result.ascii(), run._wallTimeMicro,
+                    run._parsingTimeMicro, run._preprocessingTimeMicro,
+                    run._sbtTimeMicro, run._simplexTimeMicro,
+                    run._smtCoreTimeMicro, run._boundTighteningTimeMicro,
+                    run._mainLoopIterations, run._simplexSteps,
+                    run._splits );
+}
+
+static void pinToCpu( int cpu )
+{
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO( &set );
+    CPU_SET( cpu, &set );
+    if ( sched_setaffinity( 0, sizeof(set), &set ) != 0 )
+        printf( "Warning: could not pin the benchmark to cpu %d\n", cpu );
+#else
+    printf( "Warning: cpu pinning is only supported on Linux, ignoring cpu %d\n", cpu );
+#endif
+}
+
+int main( int argc, char **argv )
+{
+    String suiteFile;
+    String outputFile = "bench.json";
+    String root = String( RESOURCES_DIR ) + "/..";
+    String filter;
+    unsigned repetitions = 1;
+    unsigned timeoutInSeconds = 600;
+    int cpu = -1;
+
+    // Arguments not recognized here are handed to Marabou's option parser
+    std::vector<char *> marabouArguments;
+    marabouArguments.push_back( argv[0] );
+
+    for ( int i = 1; i < argc; ++i )
+    {
+        String argument = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if ( argument == "--help" )
+        {
+            printUsage();
+            return 0;
+        }
+        else if ( argument == "--suite" && hasValue )
+            suiteFile = argv[++i];
+        else if ( argument == "--output" && hasValue )
+            outputFile = argv[++i];
+        else if ( argument == "--root" && hasValue )
+            root = argv[++i];
+        else if ( argument == "--filter" && hasValue )
+            filter = argv[++i];
+        else if ( argument == "--repetitions" && hasValue )
+            repetitions = atoi( argv[++i] );
+        else if ( argument == "--timeout" && hasValue )
+            timeoutInSeconds = atoi( argv[++i] );
+        else if ( argument == "--cpu" && hasValue )
+            cpu = atoi( argv[++i] );
+        else
+            marabouArguments.push_back( argv[i] );
+    }
+
+    if ( suiteFile.length() == 0 || repetitions == 0 )
+    {
+        printUsage();
+        return 1;
+    }
+
+    try
+    {
+        Options *options = Options::get();
+        options->parseOptions( marabouArguments.size(), marabouArguments.data() );
+
+        // Quiet and deterministic unless asked otherwise. Parsing resets
+        // the options to their defaults, so this has to come after it.
+        if ( !options->optionSpecified( "verbosity" ) )
+            options->setInt( Options::VERBOSITY, 0 );
+        if ( !options->optionSpecified( "seed" ) )
+            options->setInt( Options::SEED, 1 );
+
+        // The same condition under which Marabou's main runs DnCMarabou
+        if ( options->getBool( Options::DNC_MODE ) ||
+             ( !options->getBool( Options::NO_PARALLEL_DEEPSOI ) &&
+               !options->getBool( Options::SOLVE_WITH_MILP ) &&
+               options->getInt( Options::NUM_WORKERS ) > 1 ) )
+        {
+            printf( "MarabouBench solves every query with a single engine, and does not "
+                    "support --snc or --num-workers\n" );
+            return 1;
+        }
+
+#ifdef ENABLE_OPENBLAS
+        openblas_set_num_threads( options->getInt( Options::NUM_BLAS_THREADS ) );
+#endif
+
+        // The engine prints statistics during the solve at higher verbosity,
+        // and these would be timed along with it
+        int verbosity = options->getInt( Options::VERBOSITY );
+        if ( verbosity != 0 )
+            printf( "Warning: running with verbosity %d, the timings include printing "
+                    "statistics\n", verbosity );
+
+        if ( cpu >= 0 )
+            pinToCpu( cpu );
+
+        List<BenchmarkQuery> queries = readSuite( suiteFile, root, filter );
+
+        File output( outputFile );
+        output.open( File::MODE_WRITE_TRUNCATE );
+        output.write( Stringf( "{\n  \"commit\": \"%s\",\n  \"repetitions\": %u,\n"
+                               "  \"cpu\": %d,\n  \"seed\": %d,\n  \"verbosity\": %d,\n"
+                               "  \"queries\": [\n",
+                               BENCH_COMMIT_HASH, repetitions, cpu,
+                               options->getInt( Options::SEED ), verbosity ) );
+
+        unsigned count = 0;
+        for ( const auto &query : queries )
+        {
+            output.write( Stringf( "    { \"name\": \"%s\", \"runs\": [\n", query._name.ascii() ) );
+
+            for ( unsigned i = 0; i < repetitions; ++i )
+            {
+                BenchmarkRun run = BenchmarkRun();
+                try
+                {
+                    run = runQuery( query, timeoutInSeconds );
+                }
+                catch ( const Error &e )
+                {
+                    // Keep benchmarking the other queries
+                    printf( "Caught a %s error while running %s. Code: %u, Message: %s.\n",
+                            e.getErrorClass(), query._name.ascii(), e.getCode(),
+                            e.getUserMessage() );
+                    run._result = "error";
+                }
+                printf( "%-70s %8s %12.3f s\n", query._name.ascii(), run._result.ascii(),
+                        run._wallTimeMicro / 1000000.0 );
+                fflush( stdout );
+
+                output.write( Stringf( "        %s%s\n", runToJson( run ).ascii(),
+                                       i + 1 < repetitions ? "," : "" ) );
+            }
+
+            ++count;
+            output.write( Stringf( "      ] }%s\n", count < queries.size() ? "," : "" ) );
+        }
+
+        output.write( "  ]\n}\n" );
+        output.close();
+
+        printf( "Results written to %s\n", outputFile.ascii() );
+    }
+    catch ( const Error &e )
+    {
+        printf( "Caught a %s error. Code: %u, Errno: %i, Message: %s.\n",
+                e.getErrorClass(),
+                e.getCode(),
+                e.getErrno(),
+                e.getUserMessage() );
+
+        return 1;
+    }
+
+    return 0;
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,104 @@
+/*********************                                                        */
+/*! \file Bitset.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** A fixed-size set of bits, for marking indices in hot loops without
+ ** allocating memory (unlike Set<unsigned>) and with indexing that works
+ ** (unlike Vector<bool>).
+
+ **/
+
+#ifndef __Bitset_h__
+#define __Bitset_h__
+
+#include "Debug.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+class Bitset
+{
+public:
+    Bitset()
+        : _size( 0 )
+    {
+    }
+
+    Bitset( unsigned size )
+    {
+        resize( size );
+    }
+
+    /*
+      Change the number of bits. All bits are cleared.
+    */
+    void resize( unsigned size )
+    {
+        _size = size;
+        _words.assign( ( size + BITS_PER_WORD - 1 ) / BITS_PER_WORD, 0 );
+    }
+
+    unsigned size() const
+    {
+        return _size;
+    }
+
+    void set( unsigned index )
+    {
+        ASSERT( index < _size );
+        _words[index / BITS_PER_WORD] |= ( (uint64_t)1 << ( index % BITS_PER_WORD ) );
+    }
+
+    void unset( unsigned index )
+    {
+        ASSERT( index < _size );
+        _words[index / BITS_PER_WORD] &= ~( (uint64_t)1 << ( index % BITS_PER_WORD ) );
+    }
+
+    bool exists( unsigned index ) const
+    {
+        ASSERT( index < _size );
+        return _words[index / BITS_PER_WORD] & ( (uint64_t)1 << ( index % BITS_PER_WORD ) );
+    }
+
+    /*
+      Clear all bits
+    */
+    void clear()
+    {
+        std::fill( _words.begin(), _words.end(), 0 );
+    }
+
+    bool empty() const
+    {
+        for ( const auto &word : _words )
+        {
+            if ( word )
+                return false;
+        }
+
+        return true;
+    }
+
+private:
+    static const unsigned BITS_PER_WORD = 64;
+
+    std::vector<uint64_t> _words;
+    unsigned _size;
+};
+
+#endif // __Bitset_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
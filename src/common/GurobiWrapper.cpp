@@ -43,12 +43,15 @@ GurobiWrapper::~GurobiWrapper()
 
 void GurobiWrapper::freeModelIfNeeded()
 {
-    for ( auto &entry : _nameToVariable )
+    for ( auto &variable : _variables )
     {
-        delete entry.second;
-        entry.second = NULL;
+        if ( variable )
+        {
+            delete variable;
+            variable = NULL;
+        }
     }
-    _nameToVariable.clear();
+    _variables.clear();
 
     if ( _model )
     {
@@ -100,9 +103,12 @@ void GurobiWrapper::reset()
     _model->reset();
 }
 
-void GurobiWrapper::addVariable( String name, double lb, double ub, VariableType type )
+void GurobiWrapper::addVariable( unsigned variable, double lb, double ub, VariableType type )
 {
-    ASSERT( !_nameToVariable.exists( name ) );
+    while ( _variables.size() <= variable )
+        _variables.append( NULL );
+
+    ASSERT( !_variables[variable] );
 
     char variableType = GRB_CONTINUOUS;
     switch ( type )
@@ -126,10 +132,9 @@ void GurobiWrapper::addVariable( String name, double lb, double ub, VariableType
         *newVar = _model->addVar( lb,
                                   ub,
                                   objectiveValue,
-                                  variableType,
-                                  name.ascii() );
+                                  variableType );
 
-        _nameToVariable[name] = newVar;
+        _variables[variable] = newVar;
     }
     catch ( GRBException e )
     {
@@ -140,16 +145,14 @@ void GurobiWrapper::addVariable( String name, double lb, double ub, VariableType
     }
 }
 
-void GurobiWrapper::setLowerBound( String name, double lb )
+void GurobiWrapper::setLowerBound( unsigned variable, double lb )
 {
-    GRBVar var = _model->getVarByName( name.ascii() );
-    var.set( GRB_DoubleAttr_LB, lb );
+    getVariable( variable ).set( GRB_DoubleAttr_LB, lb );
 }
 
-void GurobiWrapper::setUpperBound( String name, double ub )
+void GurobiWrapper::setUpperBound( unsigned variable, double ub )
 {
-    GRBVar var = _model->getVarByName( name.ascii() );
-    var.set( GRB_DoubleAttr_UB, ub );
+    getVariable( variable ).set( GRB_DoubleAttr_UB, ub );
 }
 
 void GurobiWrapper::setCutoff( double cutoff )
@@ -172,20 +175,19 @@ void GurobiWrapper::addEqConstraint( const List<Term> &terms, double scalar )
     addConstraint( terms, scalar, GRB_EQUAL );
 }
 
+GRBLinExpr GurobiWrapper::buildExpression( const List<Term> &terms )
+{
+    GRBLinExpr expression;
+    for ( const auto &term : terms )
+        expression += GRBLinExpr( getVariable( term._variable ), term._coefficient );
+    return expression;
+}
+
 void GurobiWrapper::addConstraint( const List<Term> &terms, double scalar, char sense )
 {
     try
     {
-        GRBLinExpr constraint;
-
-
-        for ( const auto &term : terms )
-        {
-            ASSERT( _nameToVariable.exists( term._variable ) );
-            constraint += GRBLinExpr( *_nameToVariable[term._variable], term._coefficient );
-        }
-
-        _model->addConstr( constraint, sense, scalar );
+        _model->addConstr( buildExpression( terms ), sense, scalar );
     }
     catch ( GRBException e )
     {
@@ -196,35 +198,27 @@ void GurobiWrapper::addConstraint( const List<Term> &terms, double scalar, char
     }
 }
 
-void GurobiWrapper::addLeqIndicatorConstraint( const String binVarName, const int binVal, const List<Term> &terms, double scalar )
+void GurobiWrapper::addLeqIndicatorConstraint( unsigned binVar, const int binVal, const List<Term> &terms, double scalar )
 {
-    addIndicatorConstraint( binVarName, binVal, terms, scalar, GRB_LESS_EQUAL );
+    addIndicatorConstraint( binVar, binVal, terms, scalar, GRB_LESS_EQUAL );
 }
 
-void GurobiWrapper::addGeqIndicatorConstraint( const String binVarName, const int binVal, const List<Term> &terms, double scalar )
+void GurobiWrapper::addGeqIndicatorConstraint( unsigned binVar, const int binVal, const List<Term> &terms, double scalar )
 {
-    addIndicatorConstraint( binVarName, binVal, terms, scalar, GRB_GREATER_EQUAL );
+    addIndicatorConstraint( binVar, binVal, terms, scalar, GRB_GREATER_EQUAL );
 }
 
-void GurobiWrapper::addEqIndicatorConstraint( const String binVarName, const int binVal, const List<Term> &terms, double scalar )
+void GurobiWrapper::addEqIndicatorConstraint( unsigned binVar, const int binVal, const List<Term> &terms, double scalar )
 {
-    addIndicatorConstraint( binVarName, binVal, terms, scalar, GRB_EQUAL );
+    addIndicatorConstraint( binVar, binVal, terms, scalar, GRB_EQUAL );
 }
 
-void GurobiWrapper::addIndicatorConstraint( const String binVarName, const int binVal, const List<Term> &terms, double scalar, char sense )
+void GurobiWrapper::addIndicatorConstraint( unsigned binVar, const int binVal, const List<Term> &terms, double scalar, char sense )
 {
     try
     {
-        GRBLinExpr constraint;
-
-        for ( const auto &term : terms )
-        {
-            ASSERT( _nameToVariable.exists( term._variable ) );
-            constraint += GRBLinExpr( *_nameToVariable[term._variable], term._coefficient );
-        }
-
-        ASSERT( _nameToVariable.exists( binVarName ) );
-        _model->addGenConstrIndicator( *_nameToVariable[binVarName], binVal, constraint, sense, scalar );
+        _model->addGenConstrIndicator( getVariable( binVar ), binVal,
+                                       buildExpression( terms ), sense, scalar );
     }
     catch ( GRBException e )
     {
@@ -239,14 +233,7 @@ void GurobiWrapper::setCost( const List<Term> &terms, double constant )
 {
     try
     {
-        GRBLinExpr cost;
-
-        for ( const auto &term : terms )
-        {
-            ASSERT( _nameToVariable.exists( term._variable ) );
-            cost += GRBLinExpr( *_nameToVariable[term._variable], term._coefficient );
-        }
-
+        GRBLinExpr cost = buildExpression( terms );
         cost += constant;
 
         _model->setObjective( cost, GRB_MINIMIZE );
@@ -264,14 +251,7 @@ void GurobiWrapper::setObjective( const List<Term> &terms, double constant )
 {
     try
     {
-        GRBLinExpr cost;
-
-        for ( const auto &term : terms )
-        {
-            ASSERT( _nameToVariable.exists( term._variable ) );
-            cost += GRBLinExpr( *_nameToVariable[term._variable], term._coefficient );
-        }
-
+        GRBLinExpr cost = buildExpression( terms );
         cost += constant;
 
         _model->setObjective( cost, GRB_MAXIMIZE );
@@ -331,14 +311,17 @@ bool GurobiWrapper::haveFeasibleSolution()
     return _model->get( GRB_IntAttr_SolCount ) > 0;
 }
 
-void GurobiWrapper::extractSolution( Map<String, double> &values, double &costOrObjective )
+void GurobiWrapper::extractSolution( Map<unsigned, double> &values, double &costOrObjective )
 {
     try
     {
         values.clear();
 
-        for ( const auto &variable : _nameToVariable )
-            values[variable.first] = variable.second->get( GRB_DoubleAttr_X );
+        for ( unsigned i = 0; i < _variables.size(); ++i )
+        {
+            if ( _variables[i] )
+                values[i] = _variables[i]->get( GRB_DoubleAttr_X );
+        }
 
         costOrObjective = _model->get( GRB_DoubleAttr_ObjVal );
     }
@@ -384,6 +367,12 @@ double GurobiWrapper::getObjectiveBound()
 
 void GurobiWrapper::dumpModel( String name )
 {
+    for ( unsigned i = 0; i < _variables.size(); ++i )
+    {
+        if ( _variables[i] )
+            _variables[i]->set( GRB_StringAttr_VarName, Stringf( "x%u", i ).ascii() );
+    }
+
     _model->write( name.ascii() );
 }
 
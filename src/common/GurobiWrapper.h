@@ -16,60 +16,38 @@
 #ifndef __GurobiWrapper_h__
 #define __GurobiWrapper_h__
 
+#include "ILPSolver.h"
+
 #ifdef ENABLE_GUROBI
 
+#include "Debug.h"
 #include "MString.h"
 #include "Map.h"
+#include "Vector.h"
 
 #include "gurobi_c++.h"
 
-class GurobiWrapper
+class GurobiWrapper : public ILPSolver
 {
 public:
-    enum VariableType {
-        CONTINUOUS = 0,
-        BINARY = 1,
-    };
-
-    /*
-      A term has the form: coefficient * variable
-    */
-    struct Term
-    {
-        Term( double coefficient, String variable )
-            : _coefficient( coefficient )
-            , _variable( variable )
-        {
-        }
-
-        Term()
-            : _coefficient( 0 )
-            , _variable( "" )
-        {
-        }
-
-        double _coefficient;
-        String _variable;
-    };
-
     GurobiWrapper();
     ~GurobiWrapper();
 
     // Add a new variabel to the model
-    void addVariable( String name, double lb, double ub, VariableType type = CONTINUOUS );
+    void addVariable( unsigned variable, double lb, double ub, VariableType type = CONTINUOUS );
 
     // Set the lower or upper bound for an existing variable
-    void setLowerBound( String name, double lb );
-    void setUpperBound( String name, double ub );
+    void setLowerBound( unsigned variable, double lb );
+    void setUpperBound( unsigned variable, double ub );
 
-    inline double getLowerBound( const String &name )
+    inline double getLowerBound( unsigned variable )
     {
-        return _model->getVarByName( name.ascii() ).get( GRB_DoubleAttr_LB );
+        return getVariable( variable ).get( GRB_DoubleAttr_LB );
     }
 
-    inline double getUpperBound( const String &name )
+    inline double getUpperBound( unsigned variable )
     {
-        return _model->getVarByName( name.ascii() ).get( GRB_DoubleAttr_UB );
+        return getVariable( variable ).get( GRB_DoubleAttr_UB );
     }
 
     // Add a new LEQ constraint, e.g. 3x + 4y <= -5
@@ -82,13 +60,13 @@ public:
     void addEqConstraint( const List<Term> &terms, double scalar );
 
     // Add a new LEQ indicator constraint 
-    void addLeqIndicatorConstraint( const String binVarName, const int binVal, const List<Term> &terms, double scalar );
+    void addLeqIndicatorConstraint( unsigned binVar, const int binVal, const List<Term> &terms, double scalar );
 
     // Add a new GEQ indicator constraint
-    void addGeqIndicatorConstraint(  const String binVarName, const int binVal, const List<Term> &terms, double scalar );
+    void addGeqIndicatorConstraint( unsigned binVar, const int binVal, const List<Term> &terms, double scalar );
 
     // Add a new EQ indicator constraint
-    void addEqIndicatorConstraint(  const String binVarName, const int binVal, const List<Term> &terms, double scalar );
+    void addEqIndicatorConstraint( unsigned binVar, const int binVal, const List<Term> &terms, double scalar );
 
     // A cost function to minimize, or an objective function to maximize
     void setCost( const List<Term> &terms, double constant = 0 );
@@ -138,18 +116,18 @@ public:
     // Solve and extract the solution, or the best known bound on the
     // objective function
     void solve();
-    void extractSolution( Map<String, double> &values, double &costOrObjective );
+    void extractSolution( Map<unsigned, double> &values, double &costOrObjective );
     double getObjectiveBound();
 
-    inline double getAssignment( const String &variable )
+    inline double getAssignment( unsigned variable )
     {
-        return _nameToVariable[variable]->get( GRB_DoubleAttr_X );
+        return getVariable( variable ).get( GRB_DoubleAttr_X );
     }
 
     // Check if the assignment exists or not.
-    inline bool existsAssignment( const String &variable )
+    inline bool existsAssignment( unsigned variable )
     {
-        return _nameToVariable.exists( variable ) &&
+        return variable < _variables.size() && _variables[variable] &&
             _model->get( GRB_IntAttr_SolCount ) > 0;
     }
 
@@ -181,18 +159,29 @@ public:
 
     // Dump the model to a file. Note that the suffix of the file is
     // used by Gurobi to determine the format. Using ".lp" is a good
-    // default
+    // default. Variables are named after their handles, e.g. x3, only
+    // here: the model itself is built without names.
     void dumpModel( String name );
 
 private:
     GRBEnv *_environment;
     GRBModel *_model;
-    Map<String, GRBVar *> _nameToVariable;
+
+    // The Gurobi variables, indexed by handle. Unused handles are NULL.
+    Vector<GRBVar *> _variables;
     double _timeoutInSeconds;
 
+    inline GRBVar &getVariable( unsigned variable )
+    {
+        ASSERT( variable < _variables.size() && _variables[variable] );
+        return *_variables[variable];
+    }
+
+    GRBLinExpr buildExpression( const List<Term> &terms );
+
     void addConstraint( const List<Term> &terms, double scalar, char sense );
     // Add a new indicator constraint
-    void addIndicatorConstraint( const String binVarName, const int binVal, const List<Term> &terms, double scalar, char sense );
+    void addIndicatorConstraint( unsigned binVar, const int binVal, const List<Term> &terms, double scalar, char sense );
 
     void freeModelIfNeeded();
     void freeMemoryIfNeeded();
@@ -205,44 +194,33 @@ private:
 #include "MString.h"
 #include "Map.h"
 
-class GurobiWrapper
+class GurobiWrapper : public ILPSolver
 {
 public:
     /*
       This is a DUMMY class, for compilation purposes when Gurobi is
       disabled.
     */
-    enum VariableType {
-        CONTINUOUS = 0,
-        BINARY = 1,
-    };
-
-    struct Term
-    {
-        Term( double, String ) {}
-        Term() {}
-    };
-
     GurobiWrapper() {}
     ~GurobiWrapper() {}
 
-    void addVariable( String, double, double, VariableType type = CONTINUOUS ) { (void)type; }
-    void setLowerBound( String, double ) {};
-    void setUpperBound( String, double ) {};
-    double getLowerBound( const String & ) { return 0; };
-    double getUpperBound( const String & ) { return 0; };
+    void addVariable( unsigned, double, double, VariableType type = CONTINUOUS ) { (void)type; }
+    void setLowerBound( unsigned, double ) {};
+    void setUpperBound( unsigned, double ) {};
+    double getLowerBound( unsigned ) { return 0; };
+    double getUpperBound( unsigned ) { return 0; };
     void addLeqConstraint( const List<Term> &, double ) {}
     void addGeqConstraint( const List<Term> &, double ) {}
     void addEqConstraint( const List<Term> &, double ) {}
-    void addLeqIndicatorConstraint( const String, const int, const List<Term> &, double ) {}
-    void addGeqIndicatorConstraint( const String, const int, const List<Term> &, double ) {}
-    void addEqIndicatorConstraint( const String, const int, const List<Term> &, double ) {}
+    void addLeqIndicatorConstraint( unsigned, const int, const List<Term> &, double ) {}
+    void addGeqIndicatorConstraint( unsigned, const int, const List<Term> &, double ) {}
+    void addEqIndicatorConstraint( unsigned, const int, const List<Term> &, double ) {}
     void setCost( const List<Term> &, double /* constant */=0 ) {}
     void setObjective( const List<Term> &, double /* constant */=0 ) {}
     double getOptimalCostOrObjective() { return 0; };
     void setCutoff( double ) {};
     void solve() {}
-    void extractSolution( Map<String, double> &, double & ) {}
+    void extractSolution( Map<unsigned, double> &, double & ) {}
     void reset() {}
     void resetModel() {}
     bool optimal() { return true; }
@@ -254,12 +232,12 @@ public:
     void setVerbosity( unsigned ) {};
     void setNumberOfThreads( unsigned ) {};
     double getObjectiveBound() { return 0; };
-    double getAssignment( const String & ){ return 0; };
+    double getAssignment( unsigned ){ return 0; };
     unsigned getNumberOfSimplexIterations() { return 0; };
     unsigned getNumberOfNodes() { return 0; };
     unsigned getStatusCode() { return 0; };
     void updateModel() {};
-    bool existsAssignment( const String & ){ return false; };
+    bool existsAssignment( unsigned ){ return false; };
 
     void dump() {}
     static void log( const String & );
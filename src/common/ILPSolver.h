@@ -0,0 +1,132 @@
+/*********************                                                        */
+/*! \file ILPSolver.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** The interface of an external (M)LP solver, as used by the LP-based
+ ** bound tightening procedures. Variables are referred to by integer
+ ** handles that the caller chooses, typically the index of the
+ ** corresponding Marabou variable, so that building a model does not
+ ** format or hash a name per term.
+
+ **/
+
+#ifndef __ILPSolver_h__
+#define __ILPSolver_h__
+
+#include "List.h"
+#include "Map.h"
+
+class ILPSolver
+{
+public:
+    enum VariableType {
+        CONTINUOUS = 0,
+        BINARY = 1,
+    };
+
+    /*
+      A term has the form: coefficient * variable
+    */
+    struct Term
+    {
+        Term( double coefficient, unsigned variable )
+            : _coefficient( coefficient )
+            , _variable( variable )
+        {
+        }
+
+        Term()
+            : _coefficient( 0 )
+            , _variable( 0 )
+        {
+        }
+
+        double _coefficient;
+        unsigned _variable;
+    };
+
+    virtual ~ILPSolver() {}
+
+    // Add a new variable to the model, under a handle that is not yet
+    // in use. Handles need not be contiguous, but solvers may store
+    // variables in an array indexed by handle.
+    virtual void addVariable( unsigned variable, double lb, double ub, VariableType type = CONTINUOUS ) = 0;
+
+    // Set the lower or upper bound for an existing variable
+    virtual void setLowerBound( unsigned variable, double lb ) = 0;
+    virtual void setUpperBound( unsigned variable, double ub ) = 0;
+    virtual double getLowerBound( unsigned variable ) = 0;
+    virtual double getUpperBound( unsigned variable ) = 0;
+
+    // Add a new LEQ constraint, e.g. 3x + 4y <= -5
+    virtual void addLeqConstraint( const List<Term> &terms, double scalar ) = 0;
+
+    // Add a new GEQ constraint, e.g. 3x + 4y >= -5
+    virtual void addGeqConstraint( const List<Term> &terms, double scalar ) = 0;
+
+    // Add a new EQ constraint, e.g. 3x + 4y = -5
+    virtual void addEqConstraint( const List<Term> &terms, double scalar ) = 0;
+
+    // A cost function to minimize, or an objective function to maximize
+    virtual void setCost( const List<Term> &terms, double constant = 0 ) = 0;
+    virtual void setObjective( const List<Term> &terms, double constant = 0 ) = 0;
+    virtual double getOptimalCostOrObjective() = 0;
+
+    // Set a cutoff value for the objective function. For example, if
+    // maximizing x with cutoff value 0, the solver will return the
+    // optimal value if greater than 0, and report a cutoff otherwise.
+    virtual void setCutoff( double cutoff ) = 0;
+
+    // Returns true iff an optimal solution has been found
+    virtual bool optimal() = 0;
+
+    // Returns true iff the cutoff value was used
+    virtual bool cutoffOccurred() = 0;
+
+    // Returns true iff the instance is infeasible
+    virtual bool infeasible() = 0;
+
+    // Returns true iff the instance timed out
+    virtual bool timeout() = 0;
+
+    // Returns true iff a feasible solution has been found
+    virtual bool haveFeasibleSolution() = 0;
+
+    // Specify a time limit, in seconds
+    virtual void setTimeLimit( double seconds ) = 0;
+
+    virtual void setVerbosity( unsigned verbosity ) = 0;
+    virtual void setNumberOfThreads( unsigned threads ) = 0;
+
+    // Solve and extract the solution, or the best known bound on the
+    // objective function
+    virtual void solve() = 0;
+    virtual void extractSolution( Map<unsigned, double> &values, double &costOrObjective ) = 0;
+    virtual double getObjectiveBound() = 0;
+
+    virtual double getAssignment( unsigned variable ) = 0;
+    virtual bool existsAssignment( unsigned variable ) = 0;
+
+    virtual unsigned getNumberOfSimplexIterations() = 0;
+
+    // Discard the solution information, keeping the model
+    virtual void reset() = 0;
+
+    // Clear the underlying model and create a fresh model
+    virtual void resetModel() = 0;
+};
+
+#endif // __ILPSolver_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -30,6 +30,15 @@ void matrixMultiplication( const double *matA, const double *matB, double *matC,
     cblas_dgemm( CblasRowMajor, CblasNoTrans, CblasNoTrans, rowsA, columnsB,
                  columnsA, alpha, matA, columnsA, matB, columnsB, beta, matC, columnsB);
 }
+
+void matrixMultiplicationTransposedA( const double *matA, const double *matB,
+                                      double *matC, unsigned rowsA,
+                                      unsigned columnsA, unsigned columnsB )
+{
+    // C <- A^T B + C, where A^T is columnsA x rowsA
+    cblas_dgemm( CblasRowMajor, CblasTrans, CblasNoTrans, columnsA, columnsB,
+                 rowsA, 1, matA, columnsA, matB, columnsB, 1, matC, columnsB );
+}
 #else
 void matrixMultiplication( const double *matA, const double *matB, double *matC,
                            unsigned rowsA, unsigned columnsA,
@@ -47,4 +56,24 @@ void matrixMultiplication( const double *matA, const double *matB, double *matC,
         }
     }
 }
+
+void matrixMultiplicationTransposedA( const double *matA, const double *matB,
+                                      double *matC, unsigned rowsA,
+                                      unsigned columnsA, unsigned columnsB )
+{
+    // Rank-one updates keep the innermost loop over contiguous rows of
+    // matB and matC
+    for ( unsigned k = 0; k < rowsA; ++k )
+    {
+        for ( unsigned i = 0; i < columnsA; ++i )
+        {
+            double coefficient = matA[k * columnsA + i];
+            if ( coefficient == 0 )
+                continue;
+
+            for ( unsigned j = 0; j < columnsB; ++j )
+                matC[i * columnsB + j] += coefficient * matB[k * columnsB + j];
+        }
+    }
+}
 #endif
@@ -11,4 +11,13 @@ void matrixMultiplication( const double *matA, const double *matB, double *matC,
                            unsigned rowsA, unsigned columnsA,
                            unsigned columnsB );
 
+/*
+  The size of matA is rowsA x columnsA,
+  and the size of matB is rowsA x columnsB.
+  Compute matA^T * matB + matC and store the result in matC
+*/
+void matrixMultiplicationTransposedA( const double *matA, const double *matB,
+                                      double *matC, unsigned rowsA,
+                                      unsigned columnsA, unsigned columnsB );
+
 #endif // __MatrixMultiplication_h__
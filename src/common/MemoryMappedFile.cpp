@@ -0,0 +1,102 @@
+/*********************                                                        */
+/*! \file MemoryMappedFile.cpp
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "CommonError.h"
+#include "MemoryMappedFile.h"
+
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MemoryMappedFile::MemoryMappedFile( const String &path )
+    : _data( NULL )
+    , _size( 0 )
+    , _mapped( false )
+{
+#ifndef _WIN32
+    int descriptor = open( path.ascii(), O_RDONLY );
+    if ( descriptor == -1 )
+        throw CommonError( CommonError::OPEN_FAILED, path.ascii() );
+
+    struct stat fileData;
+    if ( fstat( descriptor, &fileData ) != 0 )
+    {
+        close( descriptor );
+        throw CommonError( CommonError::STAT_FAILED, path.ascii() );
+    }
+
+    _size = fileData.st_size;
+    if ( _size > 0 )
+    {
+        void *mapped = mmap( NULL, _size, PROT_READ, MAP_PRIVATE, descriptor, 0 );
+        if ( mapped != MAP_FAILED )
+        {
+            // The file is consumed front to back
+            madvise( mapped, _size, MADV_SEQUENTIAL );
+            _data = (const char *)mapped;
+            _mapped = true;
+        }
+    }
+
+    close( descriptor );
+
+    if ( _mapped || _size == 0 )
+        return;
+#endif
+
+    // Fall back to reading the file into memory
+    std::ifstream input( path.ascii(), std::ios::binary | std::ios::ate );
+    if ( !input )
+        throw CommonError( CommonError::OPEN_FAILED, path.ascii() );
+
+    _size = input.tellg();
+    input.seekg( 0 );
+
+    _buffer = Vector<double>( ( _size + sizeof(double) - 1 ) / sizeof(double) );
+    if ( !input.read( (char *)_buffer.data(), _size ) )
+        throw CommonError( CommonError::READ_FAILED, path.ascii() );
+
+    _data = (const char *)_buffer.data();
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+#ifndef _WIN32
+    if ( _mapped )
+        munmap( (void *)_data, _size );
+#endif
+    _data = NULL;
+}
+
+const char *MemoryMappedFile::data() const
+{
+    return _data;
+}
+
+size_t MemoryMappedFile::size() const
+{
+    return _size;
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
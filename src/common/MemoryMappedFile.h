@@ -0,0 +1,61 @@
+/*********************                                                        */
+/*! \file MemoryMappedFile.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** A read-only view of the contents of a file. On POSIX systems the file
+ ** is mapped into memory, so only the pages that are accessed are read;
+ ** elsewhere it is read into a buffer.
+
+ **/
+
+#ifndef __MemoryMappedFile_h__
+#define __MemoryMappedFile_h__
+
+#include "MString.h"
+#include "Vector.h"
+
+#include <cstddef>
+
+class MemoryMappedFile
+{
+public:
+    /*
+      Throws a CommonError if the file cannot be opened or mapped
+    */
+    MemoryMappedFile( const String &path );
+    ~MemoryMappedFile();
+
+    /*
+      The contents of the file, valid for the lifetime of the object. The
+      data is aligned to at least 8 bytes.
+    */
+    const char *data() const;
+    size_t size() const;
+
+private:
+    const char *_data;
+    size_t _size;
+
+    // Used when the file cannot be mapped
+    Vector<double> _buffer;
+    bool _mapped;
+
+    // Prevent copying
+    MemoryMappedFile( const MemoryMappedFile & );
+    MemoryMappedFile &operator=( const MemoryMappedFile & );
+};
+
+#endif // __MemoryMappedFile_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
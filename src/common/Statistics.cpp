@@ -32,6 +32,11 @@ Statistics::Statistics()
     _unsignedAttributes[NUM_CONTEXT_PUSHES] = 0;
     _unsignedAttributes[NUM_CONTEXT_POPS] = 0;
     _unsignedAttributes[NUM_VISITED_TREE_STATES] = 1;
+    _unsignedAttributes[NUM_LEARNED_CONFLICT_CLAUSES] = 0;
+    _unsignedAttributes[NUM_BACKJUMPED_DECISION_LEVELS] = 0;
+    _unsignedAttributes[NUM_CLAUSE_PROPAGATIONS] = 0;
+    _unsignedAttributes[NUM_LITERALS_DROPPED_FROM_CONFLICT_CLAUSES] = 0;
+    _unsignedAttributes[NUM_DELETED_CONFLICT_CLAUSES] = 0;
     _unsignedAttributes[CURRENT_TABLEAU_M] = 0;
     _unsignedAttributes[CURRENT_TABLEAU_N] = 0;
     _unsignedAttributes[PP_NUM_ELIMINATED_VARS] = 0;
@@ -45,6 +50,10 @@ Statistics::Statistics()
     _longAttributes[NUM_MAIN_LOOP_ITERATIONS] = 0;
     _longAttributes[NUM_SIMPLEX_STEPS] = 0;
     _longAttributes[TIME_SIMPLEX_STEPS_MICRO] = 0;
+    _longAttributes[NUM_DUAL_SIMPLEX_STEPS] = 0;
+    _longAttributes[TIME_DUAL_SIMPLEX_STEPS_MICRO] = 0;
+    _longAttributes[NUM_DUAL_SIMPLEX_PIVOT_CAP_HITS] = 0;
+    _longAttributes[NUM_DUAL_SIMPLEX_STALLS] = 0;
     _longAttributes[TIME_MAIN_LOOP_MICRO] = 0;
     _longAttributes[TIME_CONSTRAINT_FIXING_STEPS_MICRO] = 0;
     _longAttributes[NUM_CONSTRAINT_FIXING_STEPS] = 0;
@@ -56,7 +65,12 @@ Statistics::Statistics()
     _longAttributes[NUM_SIMPLEX_UNSTABLE_PIVOTS] = 0;
     _longAttributes[NUM_ADDED_ROWS] = 0;
     _longAttributes[NUM_MERGED_COLUMNS] = 0;
+    _longAttributes[CONSTRAINT_MATRIX_MEMORY_BYTES] = 0;
+    _longAttributes[NETWORK_PARAMETERS_MEMORY_BYTES] = 0;
+    _longAttributes[SHARED_NETWORK_PARAMETERS_MEMORY_BYTES] = 0;
     _longAttributes[NUM_TABLEAU_BOUND_HOPPING] = 0;
+    _longAttributes[NUM_TABLEAU_LONG_STEP_PIVOTS] = 0;
+    _longAttributes[NUM_TABLEAU_LONG_STEP_BREAKPOINTS_PASSED] = 0;
     _longAttributes[NUM_TIGHTENED_BOUNDS] = 0;
     _longAttributes[NUM_TIGHTENINGS_FROM_SYMBOLIC_BOUND_TIGHTENING] = 0;
     _longAttributes[NUM_ROWS_EXAMINED_BY_ROW_TIGHTENER] = 0;
@@ -71,6 +85,7 @@ Statistics::Statistics()
     _longAttributes[NUM_BASIS_REFACTORIZATIONS] = 0;
     _longAttributes[PSE_NUM_ITERATIONS] = 0;
     _longAttributes[PSE_NUM_RESET_REFERENCE_SPACE] = 0;
+    _longAttributes[NUM_PRICING_CANDIDATES_SCANNED] = 0;
     _longAttributes[TOTAL_TIME_PERFORMING_VALID_CASE_SPLITS_MICRO] = 0;
     _longAttributes[TOTAL_TIME_PERFORMING_SYMBOLIC_BOUND_TIGHTENING] = 0;
     _longAttributes[TOTAL_TIME_HANDLING_STATISTICS_MICRO] = 0;
@@ -150,6 +165,12 @@ void Statistics::print()
             , printPercents( timeSimplexStepsMicro, timeMainLoopMicro )
             , timeSimplexStepsMicro / 1000
             );
+    unsigned long long timeDualSimplexStepsMicro =
+        getLongAttribute( Statistics::TIME_DUAL_SIMPLEX_STEPS_MICRO );
+    printf( "\t\t[%.2lf%%] Dual simplex steps: %llu milli\n"
+            , printPercents( timeDualSimplexStepsMicro, timeMainLoopMicro )
+            , timeDualSimplexStepsMicro / 1000
+            );
     unsigned long long totalTimeExplicitBasisBoundTighteningMicro =
         getLongAttribute(TOTAL_TIME_EXPLICIT_BASIS_BOUND_TIGHTENING_MICRO );
     printf( "\t\t[%.2lf%%] Explicit-basis bound tightening: %llu milli\n"
@@ -230,6 +251,7 @@ void Statistics::print()
 
     unsigned long long total =
         timeSimplexStepsMicro +
+        timeDualSimplexStepsMicro +
         timeConstraintFixingStepsMicro +
         totalTimePerformingValidCaseSplitsMicro +
         totalTimeHandlingStatisticsMicro +
@@ -275,6 +297,13 @@ void Statistics::print()
             , printAverage( timeConstraintFixingStepsMicro / 1000,
                             numConstraintFixingSteps )
             );
+    printf( "\tNumber of dual simplex steps after splits: %llu. Total time: %llu milli\n"
+            "\t\tStopped at the pivot cap: %llu. Stopped for lack of progress: %llu\n"
+            , getLongAttribute( Statistics::NUM_DUAL_SIMPLEX_STEPS )
+            , timeDualSimplexStepsMicro / 1000
+            , getLongAttribute( Statistics::NUM_DUAL_SIMPLEX_PIVOT_CAP_HITS )
+            , getLongAttribute( Statistics::NUM_DUAL_SIMPLEX_STALLS )
+            );
     printf( "\tNumber of active piecewise-linear constraints: %u / %u\n"
             "\t\tConstraints disabled by valid splits: %u. "
             "By SMT-originated splits: %u\n"
@@ -316,12 +345,22 @@ void Statistics::print()
 
     printf( "\tTotal number of fake pivots performed: %llu\n",
             getLongAttribute( Statistics::NUM_TABLEAU_BOUND_HOPPING ) );
+    printf( "\tLong-step pivots: %llu. Breakpoints passed: %llu (average per long step: %.2lf)\n"
+            , getLongAttribute( Statistics::NUM_TABLEAU_LONG_STEP_PIVOTS )
+            , getLongAttribute( Statistics::NUM_TABLEAU_LONG_STEP_BREAKPOINTS_PASSED )
+            , printAverage( getLongAttribute( Statistics::NUM_TABLEAU_LONG_STEP_BREAKPOINTS_PASSED ),
+                            getLongAttribute( Statistics::NUM_TABLEAU_LONG_STEP_PIVOTS ) ) );
     printf( "\tTotal number of rows added: %llu. Number of merged columns: %llu\n"
             , getLongAttribute( Statistics::NUM_ADDED_ROWS )
             , getLongAttribute( Statistics::NUM_MERGED_COLUMNS ) );
     printf( "\tCurrent tableau dimensions: M = %u, N = %u\n"
             , getUnsignedAttribute( Statistics::CURRENT_TABLEAU_M )
             , getUnsignedAttribute( Statistics::CURRENT_TABLEAU_N ) );
+    printf( "\tConstraint matrix memory: %llu bytes\n"
+            , getLongAttribute( Statistics::CONSTRAINT_MATRIX_MEMORY_BYTES ) );
+    printf( "\tNetwork weights and biases memory: %llu bytes (%llu bytes shared)\n"
+            , getLongAttribute( Statistics::NETWORK_PARAMETERS_MEMORY_BYTES )
+            , getLongAttribute( Statistics::SHARED_NETWORK_PARAMETERS_MEMORY_BYTES ) );
 
     printf( "\t--- SMT Core Statistics ---\n" );
     printf( "\tTotal depth is %u. Total visited states: %u. Number of splits: %u. Number of pops: %u\n"
@@ -331,6 +370,14 @@ void Statistics::print()
             , getUnsignedAttribute( Statistics::NUM_POPS ) );
     printf( "\tMax stack depth: %u\n"
             , getUnsignedAttribute( Statistics::MAX_DECISION_LEVEL ) );
+    printf( "\tLearned conflict clauses: %u. Backjumped decision levels: %u. "
+            "Clause propagations: %u\n"
+            , getUnsignedAttribute( Statistics::NUM_LEARNED_CONFLICT_CLAUSES )
+            , getUnsignedAttribute( Statistics::NUM_BACKJUMPED_DECISION_LEVELS )
+            , getUnsignedAttribute( Statistics::NUM_CLAUSE_PROPAGATIONS ) );
+    printf( "\tLiterals dropped from conflict clauses: %u. Deleted conflict clauses: %u\n"
+            , getUnsignedAttribute( Statistics::NUM_LITERALS_DROPPED_FROM_CONFLICT_CLAUSES )
+            , getUnsignedAttribute( Statistics::NUM_DELETED_CONFLICT_CLAUSES ) );
 
     printf( "\t--- Bound Tightening Statistics ---\n" );
     printf( "\tNumber of tightened bounds: %llu.\n",
@@ -366,6 +413,13 @@ void Statistics::print()
             , pseNumResetReferenceSpace > 0 ?
             (unsigned)((double)pseNumIterations / pseNumResetReferenceSpace) : 0 );
 
+    unsigned long long numCandidatesScanned =
+        getLongAttribute( Statistics::NUM_PRICING_CANDIDATES_SCANNED );
+    printf( "\t--- Pricing Statistics ---\n" );
+    printf( "\tNumber of candidates scanned: %llu. Avg. per simplex step: %.2lf\n"
+            , numCandidatesScanned
+            , printAverage( numCandidatesScanned, numSimplexSteps ) );
+
     printf( "\t--- SBT ---\n" );
     printf( "\tNumber of tightened bounds: %llu\n",
             getLongAttribute( Statistics::NUM_TIGHTENINGS_FROM_SYMBOLIC_BOUND_TIGHTENING ) );
@@ -54,6 +54,19 @@ public:
      // Total number of states in the search tree visited so far
      NUM_VISITED_TREE_STATES,
 
+     // Conflict-driven clause learning: number of learned conflict clauses,
+     // decision levels skipped by non-chronological backjumps, and cases
+     // excluded by propagating the learned clauses
+     NUM_LEARNED_CONFLICT_CLAUSES,
+     NUM_BACKJUMPED_DECISION_LEVELS,
+     NUM_CLAUSE_PROPAGATIONS,
+
+     // Literals dropped from learned clauses whose remaining literals were
+     // refuted by bound propagation, and learned clauses deleted to keep
+     // their number bounded
+     NUM_LITERALS_DROPPED_FROM_CONFLICT_CLAUSES,
+     NUM_DELETED_CONFLICT_CLAUSES,
+
      // Current Tableau dimensions
      CURRENT_TABLEAU_M,
      CURRENT_TABLEAU_N,
@@ -88,6 +101,17 @@ public:
      // Total time spent on performing simplex steps, in microseconds
      TIME_SIMPLEX_STEPS_MICRO,
 
+     // Number of dual simplex pivots performed after case splits, and the
+     // total time spent on them, in microseconds
+     NUM_DUAL_SIMPLEX_STEPS,
+     TIME_DUAL_SIMPLEX_STEPS_MICRO,
+
+     // Number of times the dual simplex after a split stopped because it
+     // reached its pivot cap, or because the sum of infeasibilities
+     // stopped decreasing
+     NUM_DUAL_SIMPLEX_PIVOT_CAP_HITS,
+     NUM_DUAL_SIMPLEX_STALLS,
+
      // Total time spent in the main loop, in microseconds
      TIME_MAIN_LOOP_MICRO,
 
@@ -121,9 +145,23 @@ public:
      // Total number of merged columns in the tableau
      NUM_MERGED_COLUMNS,
 
+     // Memory used by the tableau's sparse constraint matrix, in bytes
+     CONSTRAINT_MATRIX_MEMORY_BYTES,
+
+     // Memory used by the weights and biases of the network, in bytes, and
+     // the part of it shared with the engines of other DnC workers
+     NETWORK_PARAMETERS_MEMORY_BYTES,
+     SHARED_NETWORK_PARAMETERS_MEMORY_BYTES,
+
      // opposite bound.
      NUM_TABLEAU_BOUND_HOPPING,
 
+     // Number of pivots whose entering variable was moved past the bounds of
+     // out-of-bounds basic variables by the long-step ratio test, and the total
+     // number of such breakpoints passed
+     NUM_TABLEAU_LONG_STEP_PIVOTS,
+     NUM_TABLEAU_LONG_STEP_BREAKPOINTS_PASSED,
+
      // This combines tightenings from all sources: rows, basis, PL constraints, etc.
      NUM_TIGHTENED_BOUNDS,
 
@@ -161,6 +199,10 @@ public:
      PSE_NUM_ITERATIONS,
      PSE_NUM_RESET_REFERENCE_SPACE,
 
+     // Number of non-basic variables examined when choosing entering
+     // variables, over all simplex steps
+     NUM_PRICING_CANDIDATES_SCANNED,
+
      // Total amount of time spent performing valid case splits
      TOTAL_TIME_PERFORMING_VALID_CASE_SPLITS_MICRO,
      TOTAL_TIME_PERFORMING_SYMBOLIC_BOUND_TIGHTENING,
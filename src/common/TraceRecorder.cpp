@@ -0,0 +1,200 @@
+/*********************                                                        */
+/*! \file TraceRecorder.cpp
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "File.h"
+#include "GlobalConfiguration.h"
+#include "MStringf.h"
+#include "TraceRecorder.h"
+
+static std::atomic<unsigned> nextRecorderId( 0 );
+
+TraceRecorder::TraceRecorder( unsigned eventsPerThread )
+    : _eventsPerThread( eventsPerThread > 0 ? eventsPerThread : 1 )
+    , _enabled( false )
+    , _origin( std::chrono::steady_clock::now() )
+    , _recorderId( nextRecorderId++ )
+{
+}
+
+TraceRecorder::~TraceRecorder()
+{
+    for ( const auto &buffer : _buffers )
+        delete buffer;
+    _buffers.clear();
+}
+
+TraceRecorder *TraceRecorder::get()
+{
+    static TraceRecorder singleton( GlobalConfiguration::TRACE_EVENTS_PER_THREAD );
+    return &singleton;
+}
+
+void TraceRecorder::setEnabled( bool enabled )
+{
+    _enabled = enabled;
+}
+
+bool TraceRecorder::isEnabled() const
+{
+    return _enabled.load( std::memory_order_relaxed );
+}
+
+unsigned long long TraceRecorder::nowInMicro() const
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>
+        ( std::chrono::steady_clock::now() - _origin ).count();
+}
+
+void TraceRecorder::record( const char *name,
+                            const char *category,
+                            unsigned long long startInMicro,
+                            unsigned long long durationInMicro )
+{
+    ThreadBuffer *buffer = getBufferOfThisThread();
+
+    Event &event = buffer->_events[buffer->_next];
+    event._name = name;
+    event._category = category;
+    event._startInMicro = startInMicro;
+    event._durationInMicro = durationInMicro;
+
+    if ( ++buffer->_next == _eventsPerThread )
+        buffer->_next = 0;
+    ++buffer->_numberOfRecordedEvents;
+}
+
+TraceRecorder::ThreadBuffer *TraceRecorder::getBufferOfThisThread()
+{
+    // Only the first event of each thread takes the lock
+    static thread_local unsigned cachedRecorderId = 0;
+    static thread_local ThreadBuffer *cachedBuffer = NULL;
+
+    if ( cachedBuffer && cachedRecorderId == _recorderId )
+        return cachedBuffer;
+
+    ThreadBuffer *buffer = new ThreadBuffer;
+    buffer->_events = Vector<Event>( _eventsPerThread );
+    buffer->_next = 0;
+    buffer->_numberOfRecordedEvents = 0;
+
+    {
+        std::lock_guard<std::mutex> lock( _buffersMutex );
+        buffer->_threadId = _buffers.size();
+        _buffers.append( buffer );
+    }
+
+    cachedRecorderId = _recorderId;
+    cachedBuffer = buffer;
+    return buffer;
+}
+
+const TraceRecorder::ThreadBuffer *TraceRecorder::getBuffer( unsigned thread ) const
+{
+    for ( const auto &buffer : _buffers )
+        if ( buffer->_threadId == thread )
+            return buffer;
+    return NULL;
+}
+
+unsigned TraceRecorder::getNumberOfThreads() const
+{
+    std::lock_guard<std::mutex> lock( _buffersMutex );
+    return _buffers.size();
+}
+
+void TraceRecorder::getEvents( unsigned thread, Vector<Event> &events ) const
+{
+    events.clear();
+
+    std::lock_guard<std::mutex> lock( _buffersMutex );
+    const ThreadBuffer *buffer = getBuffer( thread );
+    if ( !buffer )
+        return;
+
+    if ( buffer->_numberOfRecordedEvents <= _eventsPerThread )
+    {
+        for ( unsigned i = 0; i < buffer->_next; ++i )
+            events.append( buffer->_events[i] );
+        return;
+    }
+
+    // The buffer wrapped around: the oldest event is the next to be
+    // overwritten
+    for ( unsigned i = 0; i < _eventsPerThread; ++i )
+        events.append( buffer->_events[( buffer->_next + i ) % _eventsPerThread] );
+}
+
+unsigned long long TraceRecorder::getNumberOfDroppedEvents() const
+{
+    std::lock_guard<std::mutex> lock( _buffersMutex );
+
+    unsigned long long dropped = 0;
+    for ( const auto &buffer : _buffers )
+        if ( buffer->_numberOfRecordedEvents > _eventsPerThread )
+            dropped += buffer->_numberOfRecordedEvents - _eventsPerThread;
+    return dropped;
+}
+
+void TraceRecorder::clear()
+{
+    // The buffers are kept, as the threads cache pointers to them
+    std::lock_guard<std::mutex> lock( _buffersMutex );
+    for ( const auto &buffer : _buffers )
+    {
+        buffer->_next = 0;
+        buffer->_numberOfRecordedEvents = 0;
+    }
+}
+
+String TraceRecorder::toChromeTrace() const
+{
+    String trace = "{\"traceEvents\":[";
+    bool first = true;
+
+    Vector<Event> events;
+    unsigned numberOfThreads = getNumberOfThreads();
+    for ( unsigned thread = 0; thread < numberOfThreads; ++thread )
+    {
+        trace += Stringf( "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,"
+                          "\"args\":{\"name\":\"Thread %u\"}}",
+                          first ? "" : ",", thread, thread );
+        first = false;
+
+        getEvents( thread, events );
+        for ( const auto &event : events )
+            trace += Stringf( ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%llu,"
+                              "\"dur\":%llu,\"pid\":0,\"tid\":%u}",
+                              event._name, event._category, event._startInMicro,
+                              event._durationInMicro, thread );
+    }
+
+    trace += Stringf( "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"droppedEvents\":%llu}}\n",
+                      getNumberOfDroppedEvents() );
+    return trace;
+}
+
+void TraceRecorder::writeChromeTrace( const String &path ) const
+{
+    File file( path );
+    file.open( File::MODE_WRITE_TRUNCATE );
+    file.write( toChromeTrace() );
+    file.close();
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
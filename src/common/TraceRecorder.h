@@ -0,0 +1,164 @@
+/*********************                                                        */
+/*! \file TraceRecorder.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** A timeline of the events of a run (simplex steps, splits, bound
+ ** propagations, etc.), exported in the Chrome trace format so that it can
+ ** be inspected with chrome://tracing or Perfetto. Each thread records into
+ ** its own ring buffer, so recording an event takes no locks.
+ **
+ ** Spans are recorded with the MARABOU_TRACE_SPAN macro, which expands to
+ ** nothing unless Marabou is built with ENABLE_TRACING.
+
+ **/
+
+#ifndef __TraceRecorder_h__
+#define __TraceRecorder_h__
+
+#include "List.h"
+#include "MString.h"
+#include "Vector.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+class TraceRecorder
+{
+public:
+    struct Event
+    {
+        // Names and categories must be string literals: only the pointers
+        // are stored
+        const char *_name;
+        const char *_category;
+        unsigned long long _startInMicro;
+        unsigned long long _durationInMicro;
+    };
+
+    TraceRecorder( unsigned eventsPerThread );
+    ~TraceRecorder();
+
+    /*
+      The recorder used by the MARABOU_TRACE_SPAN macro
+    */
+    static TraceRecorder *get();
+
+    /*
+      Events are only recorded while the recorder is enabled
+    */
+    void setEnabled( bool enabled );
+    bool isEnabled() const;
+
+    /*
+      Microseconds since the recorder was created
+    */
+    unsigned long long nowInMicro() const;
+
+    /*
+      Record an event of the calling thread
+    */
+    void record( const char *name,
+                 const char *category,
+                 unsigned long long startInMicro,
+                 unsigned long long durationInMicro );
+
+    /*
+      The events currently kept for each thread (oldest first), and the
+      number of events that were overwritten because a buffer was full.
+      Must not be called while other threads are recording.
+    */
+    unsigned getNumberOfThreads() const;
+    void getEvents( unsigned thread, Vector<Event> &events ) const;
+    unsigned long long getNumberOfDroppedEvents() const;
+
+    /*
+      Discard all recorded events
+    */
+    void clear();
+
+    /*
+      Serialize the recorded events as a Chrome trace. Must not be called
+      while other threads are recording, e.g., only after the DnC workers
+      have been joined.
+    */
+    String toChromeTrace() const;
+    void writeChromeTrace( const String &path ) const;
+
+private:
+    struct ThreadBuffer
+    {
+        unsigned _threadId;
+        Vector<Event> _events;
+        // The next slot to write and the total number of events recorded
+        unsigned _next;
+        unsigned long long _numberOfRecordedEvents;
+    };
+
+    unsigned _eventsPerThread;
+    std::atomic_bool _enabled;
+    std::chrono::steady_clock::time_point _origin;
+
+    // Distinguishes the recorders, so that the per-thread cache of a
+    // destroyed recorder is never used by a new one
+    unsigned _recorderId;
+
+    mutable std::mutex _buffersMutex;
+    List<ThreadBuffer *> _buffers;
+
+    ThreadBuffer *getBufferOfThisThread();
+    const ThreadBuffer *getBuffer( unsigned thread ) const;
+};
+
+/*
+  Records the lifetime of the object as a single event
+*/
+class TraceSpan
+{
+public:
+    TraceSpan( const char *category, const char *name,
+               TraceRecorder *recorder = TraceRecorder::get() )
+        : _recorder( recorder->isEnabled() ? recorder : NULL )
+        , _category( category )
+        , _name( name )
+        , _start( _recorder ? _recorder->nowInMicro() : 0 )
+    {
+    }
+
+    ~TraceSpan()
+    {
+        if ( _recorder )
+            _recorder->record( _name, _category, _start,
+                               _recorder->nowInMicro() - _start );
+    }
+
+private:
+    TraceRecorder *_recorder;
+    const char *_category;
+    const char *_name;
+    unsigned long long _start;
+};
+
+#ifdef ENABLE_TRACING
+#  define MARABOU_TRACE_CONCATENATE_( x, y ) x ## y
+#  define MARABOU_TRACE_CONCATENATE( x, y ) MARABOU_TRACE_CONCATENATE_( x, y )
+#  define MARABOU_TRACE_SPAN( category, name )                          \
+    TraceSpan MARABOU_TRACE_CONCATENATE( __traceSpan, __LINE__ )( category, name )
+#else
+#  define MARABOU_TRACE_SPAN( category, name )
+#endif
+
+#endif // __TraceRecorder_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
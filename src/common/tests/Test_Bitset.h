@@ -0,0 +1,81 @@
+/*********************                                                        */
+/*! \file Test_Bitset.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+ **/
+
+#include <cxxtest/TestSuite.h>
+
+#include "Bitset.h"
+
+class BitsetTestSuite : public CxxTest::TestSuite
+{
+public:
+    void test_set_and_unset()
+    {
+        Bitset bits( 130 );
+
+        TS_ASSERT_EQUALS( bits.size(), 130U );
+        TS_ASSERT( bits.empty() );
+
+        bits.set( 0 );
+        bits.set( 63 );
+        bits.set( 64 );
+        bits.set( 129 );
+
+        for ( unsigned i = 0; i < 130; ++i )
+        {
+            bool expected = ( i == 0 || i == 63 || i == 64 || i == 129 );
+            TS_ASSERT_EQUALS( bits.exists( i ), expected );
+        }
+
+        TS_ASSERT( !bits.empty() );
+
+        bits.unset( 63 );
+        TS_ASSERT( !bits.exists( 63 ) );
+        TS_ASSERT( bits.exists( 64 ) );
+
+        // Setting twice is harmless, unsetting a clear bit too
+        bits.set( 0 );
+        bits.unset( 1 );
+        TS_ASSERT( bits.exists( 0 ) );
+        TS_ASSERT( !bits.exists( 1 ) );
+    }
+
+    void test_clear_and_resize()
+    {
+        Bitset bits;
+        TS_ASSERT_EQUALS( bits.size(), 0U );
+        TS_ASSERT( bits.empty() );
+
+        bits.resize( 10 );
+        bits.set( 3 );
+        bits.set( 9 );
+
+        bits.clear();
+        TS_ASSERT_EQUALS( bits.size(), 10U );
+        TS_ASSERT( bits.empty() );
+
+        bits.set( 5 );
+        bits.resize( 200 );
+        TS_ASSERT_EQUALS( bits.size(), 200U );
+        TS_ASSERT( bits.empty() );
+
+        bits.set( 199 );
+        TS_ASSERT( bits.exists( 199 ) );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -41,24 +41,24 @@ public:
 #ifdef ENABLE_GUROBI
         GurobiWrapper gurobi;
 
-        gurobi.addVariable( "x", 0, 3 );
-        gurobi.addVariable( "y", 0, 3 );
-        gurobi.addVariable( "z", 0, 3 );
+        gurobi.addVariable( 0, 0, 3 );
+        gurobi.addVariable( 1, 0, 3 );
+        gurobi.addVariable( 2, 0, 3 );
 
         // x + y + z <= 5
         List<GurobiWrapper::Term> contraint = {
-            GurobiWrapper::Term( 1, "x" ),
-            GurobiWrapper::Term( 1, "y" ),
-            GurobiWrapper::Term( 1, "z" ),
+            GurobiWrapper::Term( 1, 0 ),
+            GurobiWrapper::Term( 1, 1 ),
+            GurobiWrapper::Term( 1, 2 ),
         };
 
         gurobi.addLeqConstraint( contraint, 5 );
 
         // Cost: -x - 2y + z
         List<GurobiWrapper::Term> cost = {
-            GurobiWrapper::Term( -1, "x" ),
-            GurobiWrapper::Term( -2, "y" ),
-            GurobiWrapper::Term( +1, "z" ),
+            GurobiWrapper::Term( -1, 0 ),
+            GurobiWrapper::Term( -2, 1 ),
+            GurobiWrapper::Term( +1, 2 ),
         };
 
         gurobi.setCost( cost );
@@ -66,14 +66,14 @@ public:
         // Solve and extract
         TS_ASSERT_THROWS_NOTHING( gurobi.solve() );
 
-        Map<String, double> solution;
+        Map<unsigned, double> solution;
         double costValue;
 
         TS_ASSERT_THROWS_NOTHING( gurobi.extractSolution( solution, costValue ) );
 
-        TS_ASSERT( FloatUtils::areEqual( solution["x"], 2 ) );
-        TS_ASSERT( FloatUtils::areEqual( solution["y"], 3 ) );
-        TS_ASSERT( FloatUtils::areEqual( solution["z"], 0 ) );
+        TS_ASSERT( FloatUtils::areEqual( solution[0], 2 ) );
+        TS_ASSERT( FloatUtils::areEqual( solution[1], 3 ) );
+        TS_ASSERT( FloatUtils::areEqual( solution[2], 0 ) );
 
         TS_ASSERT( FloatUtils::areEqual( costValue, -8 ) );
 
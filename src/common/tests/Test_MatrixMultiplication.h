@@ -55,6 +55,25 @@ public:
         TS_ASSERT(matC[4] == 23);
         TS_ASSERT(matC[5] == 34);
     }
+
+    void test_transposed_matrix_matrix()
+    {
+        double matA[] = {1,2,3,4,5,6}; // [1,2,3], [4,5,6]
+        double matB[] = {1,2,3,4}; // [1,2], [3,4]
+        double matC[6] = {1,1,1,1,1,1};
+        unsigned rowsA = 2;
+        unsigned columnsA = 3;
+        unsigned columnsB = 2;
+        matrixMultiplicationTransposedA(matA, matB, matC, rowsA, columnsA, columnsB);
+
+        // matA^T = [1,4], [2,5], [3,6]
+        TS_ASSERT(matC[0] == 14);
+        TS_ASSERT(matC[1] == 19);
+        TS_ASSERT(matC[2] == 18);
+        TS_ASSERT(matC[3] == 25);
+        TS_ASSERT(matC[4] == 22);
+        TS_ASSERT(matC[5] == 31);
+    }
 };
 
 //
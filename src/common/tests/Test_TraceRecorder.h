@@ -0,0 +1,131 @@
+/*********************                                                        */
+/*! \file Test_TraceRecorder.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "TraceRecorder.h"
+
+#include <string.h>
+#include <thread>
+
+class TraceRecorderTestSuite : public CxxTest::TestSuite
+{
+public:
+    void setUp()
+    {
+    }
+
+    void tearDown()
+    {
+    }
+
+    void test_spans_are_recorded_only_when_enabled()
+    {
+        TraceRecorder recorder( 16 );
+
+        {
+            TraceSpan span( "engine", "disabled", &recorder );
+        }
+        TS_ASSERT_EQUALS( recorder.getNumberOfThreads(), 0U );
+
+        recorder.setEnabled( true );
+        {
+            TraceSpan outer( "engine", "outer", &recorder );
+            {
+                TraceSpan inner( "smt", "inner", &recorder );
+            }
+        }
+
+        TS_ASSERT_EQUALS( recorder.getNumberOfThreads(), 1U );
+
+        Vector<TraceRecorder::Event> events;
+        recorder.getEvents( 0, events );
+        TS_ASSERT_EQUALS( events.size(), 2U );
+
+        // The inner span ends first, and lies within the outer one
+        TS_ASSERT_EQUALS( strcmp( events[0]._name, "inner" ), 0 );
+        TS_ASSERT_EQUALS( strcmp( events[0]._category, "smt" ), 0 );
+        TS_ASSERT_EQUALS( strcmp( events[1]._name, "outer" ), 0 );
+        TS_ASSERT( events[1]._startInMicro <= events[0]._startInMicro );
+        TS_ASSERT( events[0]._startInMicro + events[0]._durationInMicro <=
+                   events[1]._startInMicro + events[1]._durationInMicro );
+
+        recorder.clear();
+        recorder.getEvents( 0, events );
+        TS_ASSERT( events.empty() );
+    }
+
+    void test_ring_buffer_keeps_the_latest_events()
+    {
+        TraceRecorder recorder( 3 );
+        recorder.setEnabled( true );
+
+        for ( unsigned i = 0; i < 5; ++i )
+            recorder.record( "step", "engine", i, 1 );
+
+        Vector<TraceRecorder::Event> events;
+        recorder.getEvents( 0, events );
+        TS_ASSERT_EQUALS( events.size(), 3U );
+        for ( unsigned i = 0; i < 3; ++i )
+            TS_ASSERT_EQUALS( events[i]._startInMicro, i + 2 );
+
+        TS_ASSERT_EQUALS( recorder.getNumberOfDroppedEvents(), 2U );
+    }
+
+    void test_each_thread_has_its_own_buffer()
+    {
+        TraceRecorder recorder( 100 );
+        recorder.setEnabled( true );
+
+        recorder.record( "main", "engine", 0, 1 );
+
+        std::thread worker( [&recorder]()
+        {
+            for ( unsigned i = 0; i < 10; ++i )
+                recorder.record( "worker", "dnc", i, 1 );
+        } );
+        worker.join();
+
+        TS_ASSERT_EQUALS( recorder.getNumberOfThreads(), 2U );
+
+        Vector<TraceRecorder::Event> events;
+        recorder.getEvents( 0, events );
+        TS_ASSERT_EQUALS( events.size(), 1U );
+        recorder.getEvents( 1, events );
+        TS_ASSERT_EQUALS( events.size(), 10U );
+        TS_ASSERT_EQUALS( strcmp( events[0]._name, "worker" ), 0 );
+    }
+
+    void test_chrome_trace()
+    {
+        TraceRecorder recorder( 10 );
+        recorder.setEnabled( true );
+        recorder.record( "split", "smt", 5, 7 );
+
+        String trace = recorder.toChromeTrace();
+
+        TS_ASSERT( trace.contains( "\"traceEvents\":[" ) );
+        TS_ASSERT( trace.contains( "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0" ) );
+        TS_ASSERT( trace.contains( "{\"name\":\"split\",\"cat\":\"smt\",\"ph\":\"X\",\"ts\":5,"
+                                   "\"dur\":7,\"pid\":0,\"tid\":0}" ) );
+        TS_ASSERT( trace.contains( "\"droppedEvents\":0" ) );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
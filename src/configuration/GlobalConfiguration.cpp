@@ -54,6 +54,13 @@ const double GlobalConfiguration::ACCEPTABLE_SIMPLEX_PIVOT_THRESHOLD = 0.0001;
 const bool GlobalConfiguration::USE_COLUMN_MERGING_EQUATIONS = false;
 const double GlobalConfiguration::GAUSSIAN_ELIMINATION_PIVOT_SCALE_THRESHOLD = 0.1;
 const unsigned GlobalConfiguration::MAX_SIMPLEX_PIVOT_SEARCH_ITERATIONS = 5;
+const unsigned GlobalConfiguration::DUAL_SIMPLEX_MAX_PIVOTS_AFTER_SPLIT = 1000;
+const unsigned GlobalConfiguration::DUAL_SIMPLEX_MAX_NON_IMPROVING_PIVOTS = 100;
+const double GlobalConfiguration::CONFLICT_EXPLANATION_SLACK_RATIO = 0.5;
+const unsigned GlobalConfiguration::CONFLICT_REFUTATION_ROUNDS = 2;
+const double GlobalConfiguration::CONFLICT_REFUTATION_TOLERANCE = 0.000001;
+const unsigned GlobalConfiguration::MAX_CONFLICT_CLAUSE_MINIMIZATION_ATTEMPTS = 32;
+const unsigned GlobalConfiguration::MAX_LEARNED_CONFLICT_CLAUSES = 5000;
 const DivideStrategy GlobalConfiguration::SPLITTING_HEURISTICS = DivideStrategy::ReLUViolation;
 const unsigned GlobalConfiguration::INTERVAL_SPLITTING_FREQUENCY = 3;
 const unsigned GlobalConfiguration::INTERVAL_SPLITTING_THRESHOLD = 10;
@@ -69,6 +76,9 @@ const double GlobalConfiguration::SYMBOLIC_TIGHTENING_ROUNDING_CONSTANT = 0.0000
 
 const double GlobalConfiguration::SIGMOID_CUTOFF_CONSTANT = 20;
 
+const double GlobalConfiguration::NLR_SPARSE_WEIGHTS_MAX_DENSITY = 0.05;
+const unsigned GlobalConfiguration::DEEP_POLY_BLOCK_SIZE = 128;
+
 const bool GlobalConfiguration::PREPROCESS_INPUT_QUERY = true;
 const bool GlobalConfiguration::PREPROCESSOR_ELIMINATE_VARIABLES = true;
 const bool GlobalConfiguration::PL_CONSTRAINTS_ADD_AUX_EQUATIONS_AFTER_PREPROCESSING = true;
@@ -83,6 +93,10 @@ const unsigned GlobalConfiguration::PSE_ITERATIONS_BEFORE_RESET = 1000;
 const double GlobalConfiguration::PSE_GAMMA_ERROR_THRESHOLD = 0.001;
 const double GlobalConfiguration::PSE_GAMMA_UPDATE_TOLERANCE = 0.000000001;
 
+const unsigned GlobalConfiguration::PARTIAL_PRICING_WINDOW_SIZE = 250;
+const unsigned GlobalConfiguration::MULTIPLE_PRICING_LIST_SIZE = 10;
+const unsigned GlobalConfiguration::MULTIPLE_PRICING_MAX_MINOR_ITERATIONS = 10;
+
 const double GlobalConfiguration::CONSTRAINT_COMPARISON_TOLERANCE = 0.00001;
 
 const bool GlobalConfiguration::ONLY_AUX_INITIAL_BASIS = false;
@@ -94,6 +108,7 @@ const bool GlobalConfiguration::EXPLICIT_BOUND_TIGHTENING_UNTIL_SATURATION = fal
 const unsigned GlobalConfiguration::REFACTORIZATION_THRESHOLD = 100;
 const GlobalConfiguration::BasisFactorizationType GlobalConfiguration::BASIS_FACTORIZATION_TYPE =
     GlobalConfiguration::SPARSE_FORREST_TOMLIN_FACTORIZATION;
+const double GlobalConfiguration::HYPERSPARSE_SOLVE_DENSITY_THRESHOLD = 0.1;
 
 const unsigned GlobalConfiguration::POLARITY_CANDIDATES_THRESHOLD = 5;
 
@@ -102,11 +117,16 @@ const unsigned GlobalConfiguration::DNC_DEPTH_THRESHOLD = 5;
 const double GlobalConfiguration::MINIMAL_COEFFICIENT_FOR_TIGHTENING = 0.01;
 const double GlobalConfiguration::LEMMA_CERTIFICATION_TOLERANCE = 0.0000001;
 
+const double GlobalConfiguration::NATIVE_LP_SOLVER_FEASIBILITY_TOLERANCE = 0.000000001;
+const unsigned GlobalConfiguration::NATIVE_LP_SOLVER_DEGENERATE_PIVOTS_BEFORE_BLAND = 50;
+
 #ifdef ENABLE_GUROBI
 const unsigned GlobalConfiguration::GUROBI_NUMBER_OF_THREADS = 1;
 const bool GlobalConfiguration::GUROBI_LOGGING = false;
 #endif // ENABLE_GUROBI
 
+const unsigned GlobalConfiguration::TRACE_EVENTS_PER_THREAD = 1 << 16;
+
 // Logging - note that it is enabled only in Debug mode
 const bool GlobalConfiguration::DNC_MANAGER_LOGGING = false;
 const bool GlobalConfiguration::ENGINE_LOGGING = false;
@@ -125,6 +145,7 @@ const bool GlobalConfiguration::MPS_PARSER_LOGGING= false;
 const bool GlobalConfiguration::ONNX_PARSER_LOGGING= false;
 const bool GlobalConfiguration::SOI_LOGGING = false;
 const bool GlobalConfiguration::SCORE_TRACKER_LOGGING = false;
+const bool GlobalConfiguration::NATIVE_LP_SOLVER_LOGGING = false;
 
 const bool GlobalConfiguration::USE_SMART_FIX = false;
 const bool GlobalConfiguration::USE_LEAST_FIX = false;
@@ -150,6 +171,14 @@ void GlobalConfiguration::print()
     printf( "  USE_COLUMN_MERGING_EQUATIONS: %s\n", USE_COLUMN_MERGING_EQUATIONS ? "Yes" : "No" );
     printf( "  GAUSSIAN_ELIMINATION_PIVOT_SCALE_THRESHOLD: %.15lf\n", GAUSSIAN_ELIMINATION_PIVOT_SCALE_THRESHOLD );
     printf( "  MAX_SIMPLEX_PIVOT_SEARCH_ITERATIONS: %u\n", MAX_SIMPLEX_PIVOT_SEARCH_ITERATIONS );
+    printf( "  DUAL_SIMPLEX_MAX_PIVOTS_AFTER_SPLIT: %u\n", DUAL_SIMPLEX_MAX_PIVOTS_AFTER_SPLIT );
+    printf( "  DUAL_SIMPLEX_MAX_NON_IMPROVING_PIVOTS: %u\n", DUAL_SIMPLEX_MAX_NON_IMPROVING_PIVOTS );
+    printf( "  CONFLICT_EXPLANATION_SLACK_RATIO: %.15lf\n", CONFLICT_EXPLANATION_SLACK_RATIO );
+    printf( "  CONFLICT_REFUTATION_ROUNDS: %u\n", CONFLICT_REFUTATION_ROUNDS );
+    printf( "  CONFLICT_REFUTATION_TOLERANCE: %.15lf\n", CONFLICT_REFUTATION_TOLERANCE );
+    printf( "  MAX_CONFLICT_CLAUSE_MINIMIZATION_ATTEMPTS: %u\n",
+            MAX_CONFLICT_CLAUSE_MINIMIZATION_ATTEMPTS );
+    printf( "  MAX_LEARNED_CONFLICT_CLAUSES: %u\n", MAX_LEARNED_CONFLICT_CLAUSES );
     printf( "  BOUND_TIGHTING_ON_CONSTRAINT_MATRIX_FREQUENCY: %u\n",
             BOUND_TIGHTING_ON_CONSTRAINT_MATRIX_FREQUENCY );
     printf( "  COST_FUNCTION_ERROR_THRESHOLD: %.15lf\n", COST_FUNCTION_ERROR_THRESHOLD );
@@ -159,6 +188,9 @@ void GlobalConfiguration::print()
     printf( "  PREPROCESSOR_ELIMINATE_VARIABLES: %s\n", PREPROCESSOR_ELIMINATE_VARIABLES ? "Yes" : "No" );
     printf( "  PSE_ITERATIONS_BEFORE_RESET: %u\n", PSE_ITERATIONS_BEFORE_RESET );
     printf( "  PSE_GAMMA_ERROR_THRESHOLD: %.15lf\n", PSE_GAMMA_ERROR_THRESHOLD );
+    printf( "  PARTIAL_PRICING_WINDOW_SIZE: %u\n", PARTIAL_PRICING_WINDOW_SIZE );
+    printf( "  MULTIPLE_PRICING_LIST_SIZE: %u\n", MULTIPLE_PRICING_LIST_SIZE );
+    printf( "  MULTIPLE_PRICING_MAX_MINOR_ITERATIONS: %u\n", MULTIPLE_PRICING_MAX_MINOR_ITERATIONS );
     printf( "  CONSTRAINT_COMPARISON_TOLERANCE: %.15lf\n", CONSTRAINT_COMPARISON_TOLERANCE );
 
     String basisBoundTighteningType;
@@ -195,6 +227,7 @@ void GlobalConfiguration::print()
         basisFactorizationType = "Unknown";
 
     printf( "  BASIS_FACTORIZATION_TYPE: %s\n", basisFactorizationType.ascii() );
+    printf( "  HYPERSPARSE_SOLVE_DENSITY_THRESHOLD: %.2lf\n", HYPERSPARSE_SOLVE_DENSITY_THRESHOLD );
     printf( "****************************\n" );
 }
 
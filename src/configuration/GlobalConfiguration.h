@@ -130,6 +130,32 @@ public:
     // How many potential pivots should the engine inspect (at most) in every simplex iteration?
     static const unsigned MAX_SIMPLEX_PIVOT_SEARCH_ITERATIONS;
 
+    // How many dual simplex pivots the engine performs (at most) after a split, before handing
+    // the remaining infeasibilities to the primal simplex
+    static const unsigned DUAL_SIMPLEX_MAX_PIVOTS_AFTER_SPLIT;
+
+    // How many consecutive dual simplex pivots may fail to decrease the sum of infeasibilities
+    // before the engine gives up and hands the remaining infeasibilities to the primal simplex
+    static const unsigned DUAL_SIMPLEX_MAX_NON_IMPROVING_PIVOTS;
+
+    // The fraction of the infeasibility of a failed simplex by which the bounds explaining the
+    // failure may be loosened in total, when explaining a conflict for CDCL
+    static const double CONFLICT_EXPLANATION_SLACK_RATIO;
+
+    // The number of rounds of bound propagation, over the equations and then over the network,
+    // by which CDCL tries to refute the literals of a learned clause from the bounds at a level
+    static const unsigned CONFLICT_REFUTATION_ROUNDS;
+
+    // By how much a lower bound must exceed the upper bound to refute the literals of a clause
+    static const double CONFLICT_REFUTATION_TOLERANCE;
+
+    // The maximal number of refutation attempts when minimizing a learned clause
+    static const unsigned MAX_CONFLICT_CLAUSE_MINIMIZATION_ATTEMPTS;
+
+    // The maximal number of learned clauses kept by CDCL. When exceeded, the longest clauses
+    // that do not currently explain an implication are deleted
+    static const unsigned MAX_LEARNED_CONFLICT_CLAUSES;
+
     static const DivideStrategy SPLITTING_HEURISTICS;
 
     // The frequency to use interval splitting when largest interval splitting strategy is in use.
@@ -161,6 +187,15 @@ public:
     // PSE's Gamma function's update tolerance
     static const double PSE_GAMMA_UPDATE_TOLERANCE;
 
+    // Partial pricing: how many consecutive non-basic variables are priced
+    // before the search stops, provided an entering candidate was found
+    static const unsigned PARTIAL_PRICING_WINDOW_SIZE;
+
+    // Multiple pricing: how many attractive candidates are kept from a full
+    // pricing pass, and for how many pivots they are reused before the next one
+    static const unsigned MULTIPLE_PRICING_LIST_SIZE;
+    static const unsigned MULTIPLE_PRICING_MAX_MINOR_ITERATIONS;
+
     // The tolerance for checking whether f = Constraint( b ), Constraint \in { ReLU, ABS, Sign}
     static const double CONSTRAINT_COMPARISON_TOLERANCE;
 
@@ -195,6 +230,15 @@ public:
 
     static const double SIGMOID_CUTOFF_CONSTANT;
 
+    // Weights of a weighted sum layer with respect to a source layer are
+    // stored in sparse form if at most this fraction of them is non-zero
+    // (e.g., in convolutional layers)
+    static const double NLR_SPARSE_WEIGHTS_MAX_DENSITY;
+
+    // DeepPoly back-substitutes the neurons of a layer in blocks of (at most) this many
+    // neurons, which are shared out between the threads
+    static const unsigned DEEP_POLY_BLOCK_SIZE;
+
     /*
       Constraint fixing heuristics
     */
@@ -223,6 +267,10 @@ public:
     };
     static const BasisFactorizationType BASIS_FACTORIZATION_TYPE;
 
+    // FTRAN/BTRAN in the sparse factorizations use hypersparse triangular solves while the
+    // non-zero pattern of the vector covers at most this fraction of its entries
+    static const double HYPERSPARSE_SOLVE_DENSITY_THRESHOLD;
+
     /* In the polarity-based branching heuristics, only this many earliest nodes
        are considered to branch on.
     */
@@ -240,6 +288,15 @@ public:
     */
     static const double LEMMA_CERTIFICATION_TOLERANCE;
 
+    /* The feasibility tolerance of the native LP solver, used for the LP-based bound tightening
+    */
+    static const double NATIVE_LP_SOLVER_FEASIBILITY_TOLERANCE;
+
+    /* The number of consecutive degenerate pivots after which the native LP solver switches to
+       Bland's rule, to avoid cycling
+    */
+    static const unsigned NATIVE_LP_SOLVER_DEGENERATE_PIVOTS_BEFORE_BLAND;
+
 #ifdef ENABLE_GUROBI
     /*
       The number of threads Gurobi spawns
@@ -248,6 +305,13 @@ public:
     static const bool GUROBI_LOGGING;
 #endif // ENABLE_GUROBI
 
+    /*
+      The number of events each thread keeps for the Chrome trace (see
+      TraceRecorder). Once full, the oldest events of the thread are
+      overwritten.
+    */
+    static const unsigned TRACE_EVENTS_PER_THREAD;
+
     /*
       Logging options
     */
@@ -268,6 +332,7 @@ public:
     static const bool ONNX_PARSER_LOGGING;
     static const bool SOI_LOGGING;
     static const bool SCORE_TRACKER_LOGGING;
+    static const bool NATIVE_LP_SOLVER_LOGGING;
 };
 
 #endif // __GlobalConfiguration_h__
@@ -90,10 +90,13 @@ void OptionParser::initialize()
           "Dump the bounds after preprocessing." )
         ( "query-dump-file",
           boost::program_options::value<std::string>( &(*_stringOptions)[Options::QUERY_DUMP_FILE] )->default_value( (*_stringOptions)[Options::QUERY_DUMP_FILE] ),
-          "Dump the verification query in Marabou's input query format." )
+          "Dump the verification query in Marabou's input query format (binary if the file name ends with .ipqb)." )
         ( "summary-file",
           boost::program_options::value<std::string>( &((*_stringOptions)[Options::SUMMARY_FILE]) )->default_value( (*_stringOptions)[Options::SUMMARY_FILE] ),
           "Produce a summary file of the run." )
+        ( "trace-file",
+          boost::program_options::value<std::string>( &((*_stringOptions)[Options::TRACE_FILE]) )->default_value( (*_stringOptions)[Options::TRACE_FILE] ),
+          "Write a timeline of the run in the Chrome trace format (requires building with ENABLE_TRACING)." )
         ( "export-assignment",
           boost::program_options::bool_switch( &((*_boolOptions)[Options::EXPORT_ASSIGNMENT]) )->default_value( (*_boolOptions)[Options::EXPORT_ASSIGNMENT] ),
           "Export a satisfying assignment if found." )
@@ -154,6 +157,9 @@ void OptionParser::initialize()
         ( "blas-threads",
           boost::program_options::value<int>( &((*_intOptions)[Options::NUM_BLAS_THREADS]) )->default_value( (*_intOptions)[Options::NUM_BLAS_THREADS] ),
           "Number of threads to use for matrix multiplication with OpenBLAS." )
+        ( "deeppoly-memory-budget",
+          boost::program_options::value<int>( &((*_intOptions)[Options::DEEP_POLY_MEMORY_BUDGET_IN_MB]) )->default_value( (*_intOptions)[Options::DEEP_POLY_MEMORY_BUDGET_IN_MB] ),
+          "Megabytes of scratch memory for DeepPoly back-substitution. Larger layers are processed in blocks of neurons. 0 means no limit." )
         ( "reluplex-split-threshold",
           boost::program_options::value<int>( &((*_intOptions)[Options::CONSTRAINT_VIOLATION_THRESHOLD]) )->default_value( (*_intOptions)[Options::CONSTRAINT_VIOLATION_THRESHOLD] ),
           "Max number of tries to repair a relu before splitting when the Reluplex procedure is used." )
@@ -163,6 +169,18 @@ void OptionParser::initialize()
         ( "no-parallel-deepsoi",
           boost::program_options::bool_switch( &(*_boolOptions)[Options::NO_PARALLEL_DEEPSOI] )->default_value( (*_boolOptions)[Options::NO_PARALLEL_DEEPSOI] ),
           "Do not use the parallel deep-soi solving mode when multiple threads are allowed." )
+        ( "dual-simplex",
+          boost::program_options::bool_switch( &(*_boolOptions)[Options::DUAL_SIMPLEX_AFTER_SPLIT] )->default_value( (*_boolOptions)[Options::DUAL_SIMPLEX_AFTER_SPLIT] ),
+          "Reoptimize with dual simplex pivots after a case split, before resuming the primal simplex." )
+        ( "long-step-ratio-test",
+          boost::program_options::bool_switch( &(*_boolOptions)[Options::LONG_STEP_RATIO_TEST] )->default_value( (*_boolOptions)[Options::LONG_STEP_RATIO_TEST] ),
+          "In the primal simplex, let the entering variable move past the violated bounds of several basic variables in one pivot while the infeasibility keeps decreasing." )
+        ( "cdcl",
+          boost::program_options::bool_switch( &(*_boolOptions)[Options::CDCL] )->default_value( (*_boolOptions)[Options::CDCL] ),
+          "Learn conflict clauses over case splits and backjump non-chronologically. Uses the Reluplex procedure instead of DeepSoI." )
+        ( "pricing",
+          boost::program_options::value<std::string>( &((*_stringOptions)[Options::PRICING_STRATEGY]) )->default_value( (*_stringOptions)[Options::PRICING_STRATEGY] ),
+          "Rule for choosing the entering variable in the simplex: pse/dantzig/bland/partial/multiple. The partial and multiple rules price only part of the non-basic variables in each step." )
 #ifdef ENABLE_GUROBI
         ( "lp-solver",
           boost::program_options::value<std::string>( &((*_stringOptions)[Options::LP_SOLVER]) )->default_value( (*_stringOptions)[Options::LP_SOLVER] ),
@@ -176,10 +194,13 @@ void OptionParser::initialize()
         ( "milp-timeout",
           boost::program_options::value<float>( &((*_floatOptions)[Options::MILP_SOLVER_TIMEOUT]) )->default_value( (*_floatOptions)[Options::MILP_SOLVER_TIMEOUT] ),
           "Per-ReLU timeout for iterative propagation." )
+#endif
         ( "milp-tightening",
           boost::program_options::value<std::string>( &((*_stringOptions)[Options::MILP_SOLVER_BOUND_TIGHTENING_TYPE ]) )->default_value((*_stringOptions)[Options::MILP_SOLVER_BOUND_TIGHTENING_TYPE ]) ,
-          "The MILP solver bound tightening type: lp/lp-inc/milp/milp-inc/iter-prop/none." )
-#endif
+          "The MILP solver bound tightening type: lp/lp-inc/lp-warm/milp/milp-inc/iter-prop/none. Without Gurobi, only lp/lp-inc/lp-warm/none are available." )
+        ( "lp-tightening-solver",
+          boost::program_options::value<std::string>( &((*_stringOptions)[Options::LP_TIGHTENING_SOLVER]) )->default_value( (*_stringOptions)[Options::LP_TIGHTENING_SOLVER] ),
+          "Solver for the LP relaxations of the bound tightening: native/gurobi." )
         ;
 
     _optionDescription.add( _positional ).add( _common ).add( _other ).add( _expert );
@@ -203,6 +224,11 @@ bool OptionParser::valueExists( const String &option )
     return _variableMap.count( option.ascii() ) != 0;
 }
 
+bool OptionParser::valueSpecified( const String &option )
+{
+    return valueExists( option ) && !_variableMap[option.ascii()].defaulted();
+}
+
 int OptionParser::extractIntValue( const String &option )
 {
     ASSERT( valueExists( option ) );
@@ -39,6 +39,12 @@ public:
     */
     bool valueExists( const String &option );
 
+    /*
+      Check whether a given key was passed on the command line, rather than
+      taking its default value.
+    */
+    bool valueSpecified( const String &option );
+
     /*
       Extract the value of a given key.
     */
@@ -48,10 +48,13 @@ void Options::initializeDefaultValues()
     _boolOptions[DUMP_BOUNDS] = false;
     _boolOptions[SOLVE_WITH_MILP] = false;
     _boolOptions[PERFORM_LP_TIGHTENING_AFTER_SPLIT] = false;
+    _boolOptions[DUAL_SIMPLEX_AFTER_SPLIT] = false;
     _boolOptions[NO_PARALLEL_DEEPSOI] = false;
     _boolOptions[EXPORT_ASSIGNMENT] = false;
     _boolOptions[DEBUG_ASSIGNMENT] = false;
     _boolOptions[PRODUCE_PROOFS] = false;
+    _boolOptions[LONG_STEP_RATIO_TEST] = false;
+    _boolOptions[CDCL] = false;
 
     /*
       Int options
@@ -67,6 +70,7 @@ void Options::initializeDefaultValues()
     _intOptions[NUMBER_OF_SIMULATIONS] = 100;
     _intOptions[SEED] = 1;
     _intOptions[NUM_BLAS_THREADS] = 1;
+    _intOptions[DEEP_POLY_MEMORY_BUDGET_IN_MB] = 1024;
 
     /*
       Float options
@@ -94,6 +98,9 @@ void Options::initializeDefaultValues()
     _stringOptions[SOI_SEARCH_STRATEGY] = "mcmc";
     _stringOptions[SOI_INITIALIZATION_STRATEGY] = "input-assignment";
     _stringOptions[LP_SOLVER] = gurobiEnabled() ? "gurobi" : "native";
+    _stringOptions[LP_TIGHTENING_SOLVER] = gurobiEnabled() ? "gurobi" : "native";
+    _stringOptions[TRACE_FILE] = "";
+    _stringOptions[PRICING_STRATEGY] = "pse";
 }
 
 void Options::parseOptions( int argc, char **argv )
@@ -101,6 +108,11 @@ void Options::parseOptions( int argc, char **argv )
     _optionParser.parse( argc, argv );
 }
 
+bool Options::optionSpecified( const String &option )
+{
+    return _optionParser.valueSpecified( option );
+}
+
 void Options::printHelpMessage() const
 {
     _optionParser.printHelpMessage();
@@ -191,13 +203,15 @@ SymbolicBoundTighteningType Options::getSymbolicBoundTighteningType() const
 
 MILPSolverBoundTighteningType Options::getMILPSolverBoundTighteningType() const
 {
+    String strategyString = String( _stringOptions.get( Options::MILP_SOLVER_BOUND_TIGHTENING_TYPE ) );
     if ( gurobiEnabled() )
     {
-        String strategyString = String( _stringOptions.get( Options::MILP_SOLVER_BOUND_TIGHTENING_TYPE ) );
         if ( strategyString == "lp" )
             return MILPSolverBoundTighteningType::LP_RELAXATION;
         else if ( strategyString == "lp-inc" )
             return MILPSolverBoundTighteningType::LP_RELAXATION_INCREMENTAL;
+        else if ( strategyString == "lp-warm" )
+            return MILPSolverBoundTighteningType::LP_RELAXATION_WARM_START;
         else if ( strategyString == "milp" )
             return MILPSolverBoundTighteningType::MILP_ENCODING;
         else if ( strategyString == "milp-inc" )
@@ -211,7 +225,16 @@ MILPSolverBoundTighteningType Options::getMILPSolverBoundTighteningType() const
     }
     else
     {
-        return MILPSolverBoundTighteningType::NONE;
+        // Without Gurobi, only the LP relaxations are available, solved
+        // with the native LP solver
+        if ( strategyString == "lp" )
+            return MILPSolverBoundTighteningType::LP_RELAXATION;
+        else if ( strategyString == "lp-inc" )
+            return MILPSolverBoundTighteningType::LP_RELAXATION_INCREMENTAL;
+        else if ( strategyString == "lp-warm" )
+            return MILPSolverBoundTighteningType::LP_RELAXATION_WARM_START;
+        else
+            return MILPSolverBoundTighteningType::NONE;
     }
 }
 
@@ -250,3 +273,33 @@ LPSolverType Options::getLPSolverType() const
     else
         return gurobiEnabled() ? LPSolverType::GUROBI : LPSolverType::NATIVE;
 }
+
+LPSolverType Options::getLPTighteningSolverType() const
+{
+    String solverString = String( _stringOptions.get
+                                  ( Options::LP_TIGHTENING_SOLVER ) );
+    if ( solverString == "native" )
+        return LPSolverType::NATIVE;
+    else if ( solverString == "gurobi" && gurobiEnabled() )
+        return LPSolverType::GUROBI;
+    else
+        return gurobiEnabled() ? LPSolverType::GUROBI : LPSolverType::NATIVE;
+}
+
+PricingStrategy Options::getPricingStrategy() const
+{
+    String strategyString = String( _stringOptions.get
+                                    ( Options::PRICING_STRATEGY ) );
+    if ( strategyString == "pse" )
+        return PricingStrategy::PROJECTED_STEEPEST_EDGE;
+    else if ( strategyString == "dantzig" )
+        return PricingStrategy::DANTZIG;
+    else if ( strategyString == "bland" )
+        return PricingStrategy::BLAND;
+    else if ( strategyString == "partial" )
+        return PricingStrategy::PARTIAL;
+    else if ( strategyString == "multiple" )
+        return PricingStrategy::MULTIPLE;
+    else
+        return PricingStrategy::PROJECTED_STEEPEST_EDGE;
+}
@@ -22,6 +22,7 @@
 #include "Map.h"
 #include "MILPSolverBoundTighteningType.h"
 #include "OptionParser.h"
+#include "PricingStrategy.h"
 #include "SnCDivideStrategy.h"
 #include "SoIInitializationStrategy.h"
 #include "SoISearchStrategy.h"
@@ -60,6 +61,10 @@ public:
         // Whether to call a LP tightening after a case split
         PERFORM_LP_TIGHTENING_AFTER_SPLIT,
 
+        // If true, the engine restores feasibility with dual simplex pivots after a
+        // case split, before resuming the primal simplex
+        DUAL_SIMPLEX_AFTER_SPLIT,
+
         // If false, when multiple threads are allowed, run the DeepSoI-based procedure
         // with a different random seed on each thread. The problem is solved once
         // any of the thread finishes.
@@ -72,7 +77,16 @@ public:
         DEBUG_ASSIGNMENT,
 
         // Produce proofs of unsatisfiability and check them
-        PRODUCE_PROOFS
+        PRODUCE_PROOFS,
+
+        // Let the entering variable pass the violated bounds of several
+        // out-of-bounds basic variables in one pivot, when looking for a
+        // feasible assignment
+        LONG_STEP_RATIO_TEST,
+
+        // Learn conflict clauses and backjump non-chronologically in the
+        // search, instead of backtracking chronologically
+        CDCL
     };
 
     enum IntOptions {
@@ -102,6 +116,10 @@ public:
 
         // The number of threads to use for OpenBLAS matrix multiplication.
         NUM_BLAS_THREADS,
+
+        // The memory, in megabytes, that DeepPoly may use as scratch space
+        // for back-substitution. 0 means no limit.
+        DEEP_POLY_MEMORY_BUDGET_IN_MB,
     };
 
     enum FloatOptions{
@@ -139,6 +157,15 @@ public:
         // The procedure/solver for solving the LP
         LP_SOLVER,
 
+        // The solver for the LPs of the LP-based bound tightening
+        LP_TIGHTENING_SOLVER,
+
+        // Write a Chrome trace of the run to this file (requires a build
+        // with ENABLE_TRACING)
+        TRACE_FILE,
+
+        // The rule for picking the entering variable in a simplex step
+        PRICING_STRATEGY,
     };
 
     /*
@@ -151,6 +178,13 @@ public:
     */
     void parseOptions( int argc, char **argv );
 
+    /*
+      Check whether an option, given by its command line name, was passed
+      to parseOptions() explicitly. Parsing resets all other options to
+      their defaults.
+    */
+    bool optionSpecified( const String &option );
+
     /*
       Print all command arguments
     */
@@ -170,6 +204,8 @@ public:
     SoIInitializationStrategy getSoIInitializationStrategy() const;
     SoISearchStrategy getSoISearchStrategy() const;
     LPSolverType getLPSolverType() const;
+    LPSolverType getLPTighteningSolverType() const;
+    PricingStrategy getPricingStrategy() const;
 
     /*
       Retrieve the value of the various options, by type
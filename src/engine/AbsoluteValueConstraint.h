@@ -58,6 +58,14 @@ public:
     */
     void restoreState( const PiecewiseLinearConstraint *state ) override;
 
+    /*
+      Only the phase, activity and bounds change during the search
+    */
+    bool supportsContextDependentState() const override
+    {
+        return true;
+    }
+
     /*
       Register/unregister the constraint with a talbeau.
      */
@@ -26,8 +26,9 @@ public:
       variable that has the smallest lexicographical index.
     */
     bool select( ITableau &tableau,
-                 const List<unsigned> &candidates,
-                 const Set<unsigned> &excluded );
+                 const unsigned *candidates,
+                 unsigned numberOfCandidates,
+                 const Bitset &excluded );
 };
 
 #endif // __BlandsRule_h__
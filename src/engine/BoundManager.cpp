@@ -34,6 +34,8 @@ BoundManager::BoundManager( Context &context )
     , _firstInconsistentTightening( 0, 0.0, Tightening::LB )
     , _lowerBounds( nullptr )
     , _upperBounds( nullptr )
+    , _boundTrailSize( 0 )
+    , _storedBoundTrailSize( &_context, 0 )
 {
     _consistentBounds = true;
 };
@@ -54,8 +56,6 @@ BoundManager::~BoundManager()
 
     for ( unsigned i = 0; i < _size; ++i )
     {
-        _storedLowerBounds[i]->deleteSelf();
-        _storedUpperBounds[i]->deleteSelf();
         _tightenedLower[i]->deleteSelf();
         _tightenedUpper[i]->deleteSelf();
     }
@@ -96,8 +96,6 @@ void BoundManager::allocateLocalBounds( unsigned size )
 
 unsigned BoundManager::registerNewVariable()
 {
-    ASSERT( _size == _storedLowerBounds.size() );
-    ASSERT( _size == _storedUpperBounds.size() );
     ASSERT( _size == _tightenedLower.size() );
     ASSERT( _size == _tightenedUpper.size() );
 
@@ -117,13 +115,9 @@ unsigned BoundManager::registerNewVariable()
       delete[] oldUpperBounds;
     }
 
-    _storedLowerBounds.append( new ( true ) CDO<double>( &_context ) );
-    _storedUpperBounds.append( new ( true ) CDO<double>( &_context ) );
     _tightenedLower.append( new ( true ) CDO<bool>( &_context ) );
     _tightenedUpper.append( new ( true ) CDO<bool>( &_context ) );
 
-    *_storedLowerBounds[newVar] = FloatUtils::negativeInfinity();
-    *_storedUpperBounds[newVar] = FloatUtils::infinity();
     *_tightenedLower[newVar] = false;
     *_tightenedUpper[newVar] = false;
 
@@ -165,6 +159,7 @@ bool BoundManager::setLowerBound( unsigned variable, double value )
     ASSERT( variable < _size );
     if ( value > _lowerBounds[variable] )
     {
+        recordBoundChange( variable, Tightening::LB, _lowerBounds[variable] );
         _lowerBounds[variable] = value;
         *_tightenedLower[variable] = true;
         if ( !consistentBounds( variable ) )
@@ -180,6 +175,7 @@ bool BoundManager::setUpperBound( unsigned variable, double value )
     ASSERT( variable < _size );
     if ( value < _upperBounds[variable] )
     {
+        recordBoundChange( variable, Tightening::UB, _upperBounds[variable] );
         _upperBounds[variable] = value;
         *_tightenedUpper[variable] = true;
         if ( !consistentBounds( variable ) )
@@ -211,21 +207,82 @@ const double * BoundManager::getUpperBounds() const
     return _upperBounds;
 }
 
+void BoundManager::recordBoundChange( unsigned variable, Tightening::BoundType type, double previousValue )
+{
+    // Changes at the root level are never backtracked
+    if ( _context.getLevel() == 0 )
+        return;
+
+    BoundTrailEntry entry( variable, type, previousValue, _context.getLevel() );
+    if ( _boundTrailSize < _boundTrail.size() )
+        _boundTrail[_boundTrailSize] = entry;
+    else
+        _boundTrail.append( entry );
+
+    ++_boundTrailSize;
+}
+
 void BoundManager::storeLocalBounds()
 {
-    for ( unsigned i = 0; i < _size; ++i )
+    _storedBoundTrailSize = _boundTrailSize;
+}
+
+void BoundManager::restoreLocalBounds()
+{
+    unsigned storedSize = _storedBoundTrailSize;
+
+    // Undo the changes in reverse order, so that each bound ends up with
+    // the value it had when the trail position was stored
+    while ( _boundTrailSize > storedSize )
     {
-      *_storedLowerBounds[i]=_lowerBounds[i];
-      *_storedUpperBounds[i]=_upperBounds[i];
+        --_boundTrailSize;
+        const BoundTrailEntry &entry = _boundTrail[_boundTrailSize];
+        if ( entry._type == Tightening::LB )
+            _lowerBounds[entry._variable] = entry._previousValue;
+        else
+            _upperBounds[entry._variable] = entry._previousValue;
     }
 }
 
-void BoundManager::restoreLocalBounds()
+unsigned BoundManager::getBoundLevel( unsigned variable, Tightening::BoundType type,
+                                      double value ) const
 {
-    for ( unsigned i = 0; i < _size; ++i )
+    ASSERT( variable < _size );
+
+    // The levels on the trail are non-decreasing, so the bound reached the
+    // value with the last change whose previous value was still looser
+    for ( unsigned i = _boundTrailSize; i > 0; --i )
+    {
+        const BoundTrailEntry &entry = _boundTrail[i - 1];
+        if ( entry._variable != variable || entry._type != type )
+            continue;
+
+        if ( type == Tightening::LB ? entry._previousValue < value
+             : entry._previousValue > value )
+            return entry._level;
+    }
+
+    return 0;
+}
+
+void BoundManager::getBoundsAtLevel( unsigned level, double *lowerBounds,
+                                     double *upperBounds ) const
+{
+    std::memcpy( lowerBounds, _lowerBounds, sizeof( double ) * _size );
+    std::memcpy( upperBounds, _upperBounds, sizeof( double ) * _size );
+
+    // Undo the changes above the level latest first, so the earliest
+    // previous value remains
+    for ( unsigned i = _boundTrailSize; i > 0; --i )
     {
-      _lowerBounds[i]=*_storedLowerBounds[i];
-      _upperBounds[i]=*_storedUpperBounds[i];
+        const BoundTrailEntry &entry = _boundTrail[i - 1];
+        if ( entry._level <= level )
+            break;
+
+        if ( entry._type == Tightening::LB )
+            lowerBounds[entry._variable] = entry._previousValue;
+        else
+            upperBounds[entry._variable] = entry._previousValue;
     }
 }
 
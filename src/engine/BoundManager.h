@@ -17,10 +17,14 @@
  ** BoundManager provides a method to obtain a new variable with:
  ** registerNewVariable().
  **
- ** The bound values are stored locally and copied over to and from
- ** context-dependent objects, which backtrack automatically with the central
- ** _context object. The pointers to local bounds are provided to the Tableau
- ** for efficiency of read operations.
+ ** The bound values are stored locally, and every change made above the
+ ** root context level is recorded on a trail, along with the previous value.
+ ** storeLocalBounds() marks the current trail position in a context-dependent
+ ** object, which backtracks automatically with the central _context object,
+ ** and restoreLocalBounds() undoes the trail back to that position. Storing
+ ** and restoring therefore cost time proportional to the number of bound
+ ** changes, not to the number of variables. The pointers to local bounds are
+ ** provided to the Tableau for efficiency of read operations.
  **
  ** There are two sets of methods to set bounds:
  **   * set*Bounds     - local method used to update bounds
@@ -98,11 +102,28 @@ public:
     const double * getUpperBounds() const;
 
     /*
-       Store and restore local bounds after context advances/backtracks.
+       Store and restore local bounds after context advances/backtracks:
+       restoring undoes the bound changes made since the last call to
+       storeLocalBounds() in the current context level.
      */
     void storeLocalBounds();
     void restoreLocalBounds();
 
+    /*
+       Return the lowest context level at which the bound of the variable
+       was already at least as tight as the given value, which must not be
+       tighter than the current bound.
+     */
+    unsigned getBoundLevel( unsigned variable, Tightening::BoundType type,
+                            double value ) const;
+
+    /*
+       Store the bounds that held at the given context level, before the
+       changes made at higher levels, into the given arrays.
+     */
+    void getBoundsAtLevel( unsigned level, double *lowerBounds,
+                           double *upperBounds ) const;
+
     /*
        Obtain a list of all the bound updates since the last call to
        getTightenings or clearTightenings or propagateTighetings.
@@ -152,8 +173,30 @@ private:
     double * _lowerBounds;
     double * _upperBounds;
 
-    Vector<CVC4::context::CDO<double> *> _storedLowerBounds;
-    Vector<CVC4::context::CDO<double> *> _storedUpperBounds;
+    /*
+      The trail of bound changes. Only the first _boundTrailSize entries
+      are in use; the rest are kept to avoid reallocating.
+    */
+    struct BoundTrailEntry
+    {
+        BoundTrailEntry( unsigned variable, Tightening::BoundType type,
+                         double previousValue, unsigned level )
+            : _variable( variable )
+            , _type( type )
+            , _previousValue( previousValue )
+            , _level( level )
+        {
+        }
+
+        unsigned _variable;
+        Tightening::BoundType _type;
+        double _previousValue;
+        unsigned _level;
+    };
+
+    Vector<BoundTrailEntry> _boundTrail;
+    unsigned _boundTrailSize;
+    CVC4::context::CDO<unsigned> _storedBoundTrailSize;
 
     Vector<CVC4::context::CDO<bool> *> _tightenedLower;
     Vector<CVC4::context::CDO<bool> *> _tightenedUpper;
@@ -164,6 +207,8 @@ private:
     void recordInconsistentBound( unsigned variable, double value, Tightening::BoundType type );
 
     void allocateLocalBounds( unsigned size );
+
+    void recordBoundChange( unsigned variable, Tightening::BoundType type, double previousValue );
 };
 
 #endif // __BoundManager_h__
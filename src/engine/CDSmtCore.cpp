@@ -20,10 +20,16 @@
 #include "FloatUtils.h"
 #include "GlobalConfiguration.h"
 #include "IEngine.h"
+#include "InfeasibleQueryException.h"
 #include "MStringf.h"
 #include "MarabouError.h"
 #include "PseudoImpactTracker.h"
 #include "ReluConstraint.h"
+#include "Set.h"
+#include "TraceRecorder.h"
+
+#include <algorithm>
+#include <functional>
 
 using namespace CVC4::context;
 
@@ -32,11 +38,16 @@ CDSmtCore::CDSmtCore( IEngine *engine, Context &ctx )
     , _context( ctx )
     , _trail( &_context )
     , _decisions( &_context )
+    , _trailReasons( &_context )
+    , _trailLevels( &_context )
+    , _numLiveLearnedClauses( 0 )
+    , _propagationHead( &_context, 0 )
+    , _clauseExclusions( &_context )
     , _engine( engine )
     , _needToSplit( false )
     , _constraintForSplitting( NULL )
-    , _constraintViolationThreshold
-      ( Options::CONSTRAINT_VIOLATION_THRESHOLD )
+    , _constraintViolationThreshold( Options::get()->getInt
+                                     ( Options::CONSTRAINT_VIOLATION_THRESHOLD ) )
     , _deepSoIRejectionThreshold( Options::get()->getInt
                                   ( Options::DEEP_SOI_REJECTION_THRESHOLD ) )
     , _branchingHeuristic( Options::get()->getDivideStrategy() )
@@ -62,8 +73,7 @@ void CDSmtCore::reportViolatedConstraint( PiecewiseLinearConstraint *constraint
          _constraintViolationThreshold )
     {
         _needToSplit = true;
-        if ( GlobalConfiguration::SPLITTING_HEURISTICS ==
-             DivideStrategy::ReLUViolation || !pickSplitPLConstraint() )
+        if ( !pickSplitPLConstraint() )
             // If pickSplitConstraint failed to pick one, use the native
             // relu-violation based splitting heuristic.
             _constraintForSplitting = constraint;
@@ -89,7 +99,7 @@ void CDSmtCore::initializeScoreTrackerIfNeeded( const
                 ( new PseudoImpactTracker() );
             _scoreTracker->initialize( plConstraints );
 
-            SMT_LOG( "\tTracking Pseudo Impact..." );
+            CD_SMT_LOG( "\tTracking Pseudo Impact..." );
         }
 }
 
@@ -115,39 +125,75 @@ bool CDSmtCore::needToSplit() const
 
 void CDSmtCore::pushDecision( PiecewiseLinearConstraint *constraint,  PhaseStatus decision )
 {
-    SMT_LOG( Stringf( "Decision @ %d )", _context.getLevel() + 1 ).ascii() );
+    CD_SMT_LOG( Stringf( "Decision @ %d )", _context.getLevel() + 1 ).ascii() );
     TrailEntry te( constraint, decision );
     applyTrailEntry( te, true );
-    SMT_LOG( Stringf( "Decision push @ %d DONE", _context.getLevel() ).ascii() );
+    CD_SMT_LOG( Stringf( "Decision push @ %d DONE", _context.getLevel() ).ascii() );
 }
 
-void CDSmtCore::pushImplication( PiecewiseLinearConstraint *constraint )
+void CDSmtCore::pushImplication( PiecewiseLinearConstraint *constraint,
+                                 unsigned reason )
 {
     ASSERT( constraint->isImplication() );
-    SMT_LOG( Stringf( "Implication @ %d ... ", _context.getLevel() ).ascii() );
+    CD_SMT_LOG( Stringf( "Implication @ %d ... ", _context.getLevel() ).ascii() );
     TrailEntry te( constraint, constraint->nextFeasibleCase() );
-    applyTrailEntry( te, false );
-    SMT_LOG( Stringf( "Implication @ %d DONE", _context.getLevel() ).ascii() );
+    applyTrailEntry( te, false, reason );
+    CD_SMT_LOG( Stringf( "Implication @ %d DONE", _context.getLevel() ).ascii() );
 }
 
-void CDSmtCore::applyTrailEntry( TrailEntry &te, bool isDecision )
+void CDSmtCore::pushBoundImplication( PiecewiseLinearConstraint *constraint )
+{
+    PhaseStatus phase = constraint->getPhaseStatus();
+    if ( !constraint->getAllCases().exists( phase ) )
+    {
+        _engine->applySplit( constraint->getValidCaseSplit() );
+        return;
+    }
+
+    CD_SMT_LOG( Stringf( "Bound implication @ %d ... ", _context.getLevel() ).ascii() );
+    TrailEntry te( constraint, phase );
+    applyTrailEntry( te, false, BOUND_REASON );
+    CD_SMT_LOG( Stringf( "Bound implication @ %d DONE", _context.getLevel() ).ascii() );
+}
+
+void CDSmtCore::applyTrailEntry( TrailEntry &te, bool isDecision,
+                                 unsigned reason )
 {
     if ( isDecision )
     {
+        _engine->preContextPushHook();
         _context.push();
         _decisions.push_back( te );
+        reason = DECISION_REASON;
     }
 
+    _trailIndexOfConstraint[te._pwlConstraint] = _trail.size();
     _trail.push_back( te );
+    _trailReasons.push_back( reason );
+    _trailLevels.push_back( _decisions.size() );
     _engine->applySplit( te.getPiecewiseLinearCaseSplit() );
 }
 
 void CDSmtCore::decide()
 {
+    MARABOU_TRACE_SPAN( "smt", "decide" );
     ASSERT( _needToSplit );
-    SMT_LOG( "Performing a ReLU split" );
+    CD_SMT_LOG( "Performing a ReLU split" );
 
     _numRejectedPhasePatternProposal = 0;
+
+    // Propagate the learned clauses over the implications found since the
+    // last decision, which may resolve the pending split
+    List<TrailEntry> conflict;
+    if ( !propagateLearnedClauses( conflict ) )
+    {
+        _needToSplit = false;
+        _constraintForSplitting = nullptr;
+        if ( !resolveConflict( conflict ) )
+            throw InfeasibleQueryException();
+        return;
+    }
+
     // Maybe the constraint has already become inactive - if so, ignore
     // TODO: Ideally we will not ever reach this point
     // TODO: Maintain a vector of constraints above the threshold
@@ -162,9 +208,11 @@ void CDSmtCore::decide()
 
     ASSERT( _constraintForSplitting->isActive() );
     _needToSplit = false;
-    _constraintForSplitting->setActiveConstraint( false );
 
     decideSplit( _constraintForSplitting );
+
+    if ( !propagateLearnedClauses( conflict ) && !resolveConflict( conflict ) )
+        throw InfeasibleQueryException();
 }
 
 void CDSmtCore::decideSplit( PiecewiseLinearConstraint *constraint )
@@ -185,6 +233,11 @@ void CDSmtCore::decideSplit( PiecewiseLinearConstraint *constraint )
     PhaseStatus decision = constraint->nextFeasibleCase();
     pushDecision( constraint, decision );
 
+    // Deactivate the constraint at the new decision level, so that it is
+    // active again, and can be decided anew, once the decision is undone
+    if ( constraint->isActive() )
+        constraint->setActiveConstraint( false );
+
     if ( _statistics )
     {
         unsigned level = _context.getLevel();
@@ -198,7 +251,7 @@ void CDSmtCore::decideSplit( PiecewiseLinearConstraint *constraint )
         struct timespec end = TimeUtils::sampleMicro();
         _statistics->incLongAttribute( Statistics::TOTAL_TIME_SMT_CORE_MICRO, TimeUtils::timePassed( start, end ) );
     }
-    SMT_LOG( "Performing a ReLU split - DONE" );
+    CD_SMT_LOG( "Performing a ReLU split - DONE" );
 }
 
 
@@ -213,11 +266,11 @@ bool CDSmtCore::popDecisionLevel( TrailEntry &lastDecision )
     if ( _decisions.empty() )
         return false;
 
-    SMT_LOG( "Popping trail ..." );
+    CD_SMT_LOG( "Popping trail ..." );
     lastDecision = _decisions.back();
     _context.pop();
     _engine->postContextPopHook();
-    SMT_LOG( Stringf( "to %d DONE", _context.getLevel() ).ascii() );
+    CD_SMT_LOG( Stringf( "to %d DONE", _context.getLevel() ).ascii() );
     return true;
 }
 
@@ -225,7 +278,7 @@ void CDSmtCore::interruptIfCompliantWithDebugSolution()
 {
     if ( checkSkewFromDebuggingSolution() )
     {
-        SMT_LOG( "Error! Popping from a compliant stack\n" );
+        CD_SMT_LOG( "Error! Popping from a compliant stack\n" );
         throw MarabouError( MarabouError::DEBUGGING_ERROR );
     }
 }
@@ -239,7 +292,7 @@ PiecewiseLinearCaseSplit CDSmtCore::getDecision( unsigned decisionLevel ) const
 
 bool CDSmtCore::backtrackToFeasibleDecision( TrailEntry &lastDecision )
 {
-    SMT_LOG( "Backtracking to a feasible decision..." );
+    CD_SMT_LOG( "Backtracking to a feasible decision..." );
 
     if ( getDecisionLevel() == 0 )
         return false;
@@ -264,6 +317,7 @@ bool CDSmtCore::backtrackToFeasibleDecision( TrailEntry &lastDecision )
 
 bool CDSmtCore::backtrackAndContinueSearch()
 {
+    MARABOU_TRACE_SPAN( "smt", "backtrack" );
     TrailEntry feasibleDecision( nullptr, CONSTRAINT_INFEASIBLE );
     struct timespec start = TimeUtils::sampleMicro();
 
@@ -298,6 +352,668 @@ bool CDSmtCore::backtrackAndContinueSearch()
     return true;
 }
 
+bool CDSmtCore::resolveConflict( const List<TrailEntry> &conflict )
+{
+    MARABOU_TRACE_SPAN( "smt", "resolve conflict" );
+    CD_SMT_LOG( "Resolving a conflict..." );
+    struct timespec start = TimeUtils::sampleMicro();
+
+    List<TrailEntry> currentConflict = conflict;
+    while ( true )
+    {
+        unsigned assertingIndex = 0;
+        List<unsigned> otherIndices;
+
+        // The conflict does not depend on any decision
+        if ( !analyzeConflict( currentConflict, assertingIndex, otherIndices ) )
+        {
+            TrailEntry poppedDecision( nullptr, CONSTRAINT_INFEASIBLE );
+            while ( getDecisionLevel() > 0 )
+                popDecisionLevel( poppedDecision );
+            return false;
+        }
+
+        minimizeLearnedClause( assertingIndex, otherIndices );
+
+        // The search backjumps to the latest of the other literals, which
+        // is watched together with the asserting literal
+        unsigned latestIndex = 0;
+        for ( const auto &index : otherIndices )
+            if ( index > latestIndex )
+                latestIndex = index;
+
+        Vector<TrailEntry> clause;
+        clause.append( _trail[assertingIndex] );
+        unsigned backjumpLevel = 0;
+        if ( !otherIndices.empty() )
+        {
+            clause.append( _trail[latestIndex] );
+            backjumpLevel = _trailLevels[latestIndex];
+            for ( const auto &index : otherIndices )
+                if ( index != latestIndex )
+                    clause.append( _trail[index] );
+        }
+
+        unsigned clauseIndex = storeLearnedClause( clause );
+
+        if ( _statistics )
+        {
+            _statistics->incUnsignedAttribute( Statistics::NUM_LEARNED_CONFLICT_CLAUSES );
+            _statistics->incUnsignedAttribute( Statistics::NUM_BACKJUMPED_DECISION_LEVELS,
+                                               getDecisionLevel() - backjumpLevel - 1 );
+            _statistics->incUnsignedAttribute( Statistics::NUM_VISITED_TREE_STATES );
+        }
+
+        TrailEntry poppedDecision( nullptr, CONSTRAINT_INFEASIBLE );
+        while ( getDecisionLevel() > backjumpLevel )
+            popDecisionLevel( poppedDecision );
+
+        interruptIfCompliantWithDebugSolution();
+
+        // The other literals of the clause still hold, so the asserting
+        // literal's case is infeasible at the backjump level
+        TrailEntry assertingLiteral = clause[0];
+        PiecewiseLinearConstraint *constraint = assertingLiteral._pwlConstraint;
+        if ( !constraint->isCaseInfeasible( assertingLiteral._phase ) )
+        {
+            if ( constraint->numFeasibleCases() <= 1 )
+            {
+                noFeasibleCaseConflict( assertingLiteral, clauseIndex, currentConflict );
+                continue;
+            }
+
+            excludeCase( assertingLiteral, clauseIndex );
+        }
+
+        reduceLearnedClauses();
+
+        if ( propagateLearnedClauses( currentConflict ) )
+            break;
+    }
+
+    if ( _statistics )
+    {
+        unsigned level = _context.getLevel();
+        _statistics->setUnsignedAttribute( Statistics::CURRENT_DECISION_LEVEL,
+                                           level );
+        struct timespec end = TimeUtils::sampleMicro();
+        _statistics->incLongAttribute( Statistics::TOTAL_TIME_SMT_CORE_MICRO, TimeUtils::timePassed( start, end ) );
+    }
+
+    CD_SMT_LOG( "Resolving a conflict - DONE" );
+    return true;
+}
+
+bool CDSmtCore::analyzeConflict( const List<TrailEntry> &conflict,
+                                 unsigned &assertingIndex,
+                                 List<unsigned> &otherIndices ) const
+{
+    otherIndices.clear();
+
+    List<unsigned> conflictIndices;
+    unsigned conflictLevel = 0;
+    for ( const auto &literal : conflict )
+    {
+        unsigned index;
+        if ( !getTrailIndex( literal._pwlConstraint, index ) )
+            continue;
+
+        conflictIndices.append( index );
+        if ( _trailLevels[index] > conflictLevel )
+            conflictLevel = _trailLevels[index];
+    }
+
+    if ( conflictLevel == 0 )
+        return false;
+
+    TrailBounds trailBounds;
+    collectTrailBounds( trailBounds );
+
+    // Entries of the conflict level are replaced by their reasons, latest
+    // first, until only one is left. Entries of lower levels, except those
+    // at level 0 which hold regardless of the decisions, are kept.
+    Set<unsigned> seen;
+    unsigned numPending = 0;
+    List<unsigned> toAdd = conflictIndices;
+    for ( unsigned i = _trail.size(); i > 0; --i )
+    {
+        for ( const auto &index : toAdd )
+        {
+            if ( seen.exists( index ) )
+                continue;
+            seen.insert( index );
+
+            unsigned level = _trailLevels[index];
+            if ( level == conflictLevel )
+                ++numPending;
+            else if ( level > 0 )
+                otherIndices.append( index );
+        }
+        toAdd.clear();
+
+        unsigned index = i - 1;
+        if ( !seen.exists( index ) || _trailLevels[index] != conflictLevel )
+            continue;
+
+        if ( numPending == 1 )
+        {
+            assertingIndex = index;
+            return true;
+        }
+
+        --numPending;
+        ASSERT( _trailReasons[index] != DECISION_REASON );
+        explainTrailEntry( index, trailBounds, toAdd );
+    }
+
+    throw MarabouError( MarabouError::DEBUGGING_ERROR,
+                        "Conflict analysis found no asserting literal" );
+}
+
+void CDSmtCore::explainTrailEntry( unsigned index, const TrailBounds &trailBounds,
+                                   List<unsigned> &indices ) const
+{
+    const TrailEntry &entry = _trail[index];
+    PiecewiseLinearConstraint *constraint = entry._pwlConstraint;
+    unsigned level = _trailLevels[index];
+    unsigned reason = _trailReasons[index];
+
+    if ( reason == BOUND_REASON )
+    {
+        List<Tightening> bounds;
+        if ( explainPhaseByBounds( constraint, entry._phase, bounds ) )
+        {
+            explainBounds( bounds, trailBounds, index, level, indices );
+            return;
+        }
+    }
+    else if ( reason != DECISION_REASON )
+    {
+        // The other cases were excluded by learned clauses, whose other
+        // literals precede the entry on the trail
+        unsigned numExclusions = 0;
+        unsigned exclusion;
+        if ( !getLastClauseExclusion( constraint, exclusion ) )
+            exclusion = NO_EXCLUSION;
+
+        while ( exclusion != NO_EXCLUSION )
+        {
+            const ClauseExclusion &record = _clauseExclusions[exclusion];
+            for ( const auto &literal : _learnedClauses[record._clauseIndex] )
+            {
+                unsigned literalIndex;
+                if ( literal._pwlConstraint != constraint &&
+                     getTrailIndex( literal._pwlConstraint, literalIndex ) )
+                    indices.append( literalIndex );
+            }
+
+            ++numExclusions;
+            exclusion = record._previous;
+        }
+
+        unsigned numInfeasibleCases =
+            constraint->getAllCases().size() - constraint->numFeasibleCases();
+        if ( numExclusions >= numInfeasibleCases )
+            return;
+    }
+
+    // Cases excluded otherwise may depend on any earlier decision
+    collectDecisions( level, indices );
+}
+
+bool CDSmtCore::explainPhaseByBounds( PiecewiseLinearConstraint *constraint,
+                                      PhaseStatus phase,
+                                      List<Tightening> &bounds ) const
+{
+    for ( const auto &otherCase : constraint->getAllCases() )
+    {
+        if ( otherCase == phase )
+            continue;
+
+        bool ruledOut = false;
+        PiecewiseLinearCaseSplit split = constraint->getCaseSplit( otherCase );
+        for ( const auto &tightening : split.getBoundTightenings() )
+        {
+            unsigned variable = tightening._variable;
+            if ( tightening._type == Tightening::LB )
+            {
+                double upperBound = _engine->getUpperBound( variable );
+                if ( FloatUtils::lte( upperBound, tightening._value ) )
+                {
+                    bounds.append( Tightening( variable,
+                                               std::max( upperBound, tightening._value ),
+                                               Tightening::UB ) );
+                    ruledOut = true;
+                    break;
+                }
+            }
+            else
+            {
+                double lowerBound = _engine->getLowerBound( variable );
+                if ( FloatUtils::gte( lowerBound, tightening._value ) )
+                {
+                    bounds.append( Tightening( variable,
+                                               std::min( lowerBound, tightening._value ),
+                                               Tightening::LB ) );
+                    ruledOut = true;
+                    break;
+                }
+            }
+        }
+
+        if ( !ruledOut )
+            return false;
+    }
+
+    return true;
+}
+
+void CDSmtCore::collectDecisions( unsigned level, List<unsigned> &indices ) const
+{
+    ASSERT( level <= _decisions.size() );
+    for ( unsigned i = 0; i < level; ++i )
+    {
+        unsigned index;
+        if ( getTrailIndex( _decisions[i]._pwlConstraint, index ) )
+            indices.append( index );
+    }
+}
+
+void CDSmtCore::minimizeLearnedClause( unsigned assertingIndex, List<unsigned> &otherIndices )
+{
+    if ( otherIndices.empty() )
+        return;
+
+    unsigned attempts = 0;
+    unsigned numLiterals = otherIndices.size();
+
+    // The bounds at a level follow from the decisions up to that level, so
+    // if they refute the asserting literal, these decisions can replace the
+    // other literals, and the search backjumps further
+    unsigned backjumpLevel = 0;
+    for ( const auto &index : otherIndices )
+        if ( _trailLevels[index] > backjumpLevel )
+            backjumpLevel = _trailLevels[index];
+
+    List<PiecewiseLinearCaseSplit> clauseSplits;
+    clauseSplits.append( _trail[assertingIndex].getPiecewiseLinearCaseSplit() );
+    unsigned level = backjumpLevel;
+    while ( level > 0 &&
+            attempts < GlobalConfiguration::MAX_CONFLICT_CLAUSE_MINIMIZATION_ATTEMPTS )
+    {
+        ++attempts;
+        if ( !_engine->caseSplitsAreInfeasible( level - 1, clauseSplits ) )
+            break;
+        --level;
+    }
+
+    if ( level < backjumpLevel )
+    {
+        otherIndices.clear();
+        collectDecisions( level, otherIndices );
+        if ( otherIndices.empty() )
+            return;
+    }
+
+    // Drop the other literals whose removal keeps the clause refuted from
+    // the bounds at level 0, the latest first
+    Map<unsigned, PiecewiseLinearCaseSplit> splits;
+    splits[assertingIndex] = _trail[assertingIndex].getPiecewiseLinearCaseSplit();
+    for ( const auto &index : otherIndices )
+        splits[index] = _trail[index].getPiecewiseLinearCaseSplit();
+
+    clauseSplits.clear();
+    for ( const auto &split : splits )
+        clauseSplits.append( split.second );
+
+    Set<unsigned> dropped;
+    if ( attempts < GlobalConfiguration::MAX_CONFLICT_CLAUSE_MINIMIZATION_ATTEMPTS )
+    {
+        ++attempts;
+        if ( _engine->caseSplitsAreInfeasible( 0, clauseSplits ) )
+        {
+            Vector<unsigned> candidates( otherIndices.begin(), otherIndices.end() );
+            std::sort( candidates.begin(), candidates.end(), std::greater<unsigned>() );
+
+            for ( const auto &candidate : candidates )
+            {
+                if ( attempts == GlobalConfiguration::MAX_CONFLICT_CLAUSE_MINIMIZATION_ATTEMPTS )
+                    break;
+                ++attempts;
+
+                clauseSplits.clear();
+                for ( const auto &split : splits )
+                    if ( split.first != candidate && !dropped.exists( split.first ) )
+                        clauseSplits.append( split.second );
+
+                if ( _engine->caseSplitsAreInfeasible( 0, clauseSplits ) )
+                    dropped.insert( candidate );
+            }
+        }
+    }
+
+    if ( !dropped.empty() )
+    {
+        List<unsigned> keptIndices;
+        for ( const auto &index : otherIndices )
+            if ( !dropped.exists( index ) )
+                keptIndices.append( index );
+        otherIndices = keptIndices;
+    }
+
+    if ( _statistics && otherIndices.size() < numLiterals )
+        _statistics->incUnsignedAttribute( Statistics::NUM_LITERALS_DROPPED_FROM_CONFLICT_CLAUSES,
+                                           numLiterals - otherIndices.size() );
+}
+
+unsigned CDSmtCore::storeLearnedClause( const Vector<TrailEntry> &clause )
+{
+    unsigned clauseIndex = _learnedClauses.size();
+    _learnedClauses.append( clause );
+    ++_numLiveLearnedClauses;
+
+    // A unit clause is asserted at level 0, and never needs to be visited
+    if ( clause.size() > 1 )
+    {
+        _watches[clause[0]._pwlConstraint].append( clauseIndex );
+        _watches[clause[1]._pwlConstraint].append( clauseIndex );
+    }
+
+    return clauseIndex;
+}
+
+void CDSmtCore::reduceLearnedClauses()
+{
+    if ( _numLiveLearnedClauses <= GlobalConfiguration::MAX_LEARNED_CONFLICT_CLAUSES )
+        return;
+
+    // Clauses that explain an entry on the trail are kept
+    Set<unsigned> locked;
+    for ( const auto &reason : _trailReasons )
+        if ( reason < _learnedClauses.size() )
+            locked.insert( reason );
+    for ( const auto &exclusion : _clauseExclusions )
+        locked.insert( exclusion._clauseIndex );
+
+    Vector<unsigned> candidates;
+    for ( unsigned i = 0; i < _learnedClauses.size(); ++i )
+        if ( !_learnedClauses[i].empty() && !locked.exists( i ) )
+            candidates.append( i );
+
+    // Longest first, and older first among clauses of the same length
+    std::stable_sort( candidates.begin(), candidates.end(),
+                      [this]( unsigned first, unsigned second )
+                      {
+                          return _learnedClauses[first].size() >
+                              _learnedClauses[second].size();
+                      } );
+
+    // Deleted clauses are dropped from the watch lists when visited
+    unsigned target = GlobalConfiguration::MAX_LEARNED_CONFLICT_CLAUSES / 2;
+    for ( const auto &clauseIndex : candidates )
+    {
+        if ( _numLiveLearnedClauses <= target )
+            break;
+
+        _learnedClauses[clauseIndex].clear();
+        --_numLiveLearnedClauses;
+        if ( _statistics )
+            _statistics->incUnsignedAttribute( Statistics::NUM_DELETED_CONFLICT_CLAUSES );
+    }
+}
+
+void CDSmtCore::allDecisionsAsConflict( List<TrailEntry> &conflict ) const
+{
+    conflict.clear();
+    for ( const auto &decision : _decisions )
+        conflict.append( decision );
+}
+
+void CDSmtCore::collectTrailBounds( TrailBounds &trailBounds ) const
+{
+    unsigned index = 0;
+    for ( const auto &trailEntry : _trail )
+    {
+        PiecewiseLinearCaseSplit split = trailEntry.getPiecewiseLinearCaseSplit();
+        for ( const auto &tightening : split.getBoundTightenings() )
+            trailBounds[tightening._variable].append
+                ( Pair<unsigned, Tightening>( index, tightening ) );
+        ++index;
+    }
+}
+
+void CDSmtCore::explainBounds( const List<Tightening> &bounds,
+                               List<TrailEntry> &conflict ) const
+{
+    conflict.clear();
+
+    TrailBounds trailBounds;
+    collectTrailBounds( trailBounds );
+
+    List<unsigned> indices;
+    explainBounds( bounds, trailBounds, _trail.size(), _decisions.size(), indices );
+    for ( const auto &index : indices )
+        conflict.append( _trail[index] );
+}
+
+void CDSmtCore::explainBounds( const List<Tightening> &bounds,
+                               const TrailBounds &trailBounds,
+                               unsigned before, unsigned maxLevel,
+                               List<unsigned> &indices ) const
+{
+    unsigned decisionsNeeded = 0;
+    for ( const auto &bound : bounds )
+    {
+        unsigned level = _engine->getBoundLevel( bound._variable, bound._type,
+                                                 bound._value );
+        if ( level == 0 )
+            continue;
+
+        // The earliest trail entry whose case split implies the bound
+        bool explained = false;
+        if ( trailBounds.exists( bound._variable ) )
+        {
+            for ( const auto &trailBound : trailBounds.get( bound._variable ) )
+            {
+                if ( trailBound.first() >= before )
+                    break;
+
+                const Tightening &tightening = trailBound.second();
+                if ( tightening._type != bound._type )
+                    continue;
+
+                if ( bound._type == Tightening::LB ?
+                     FloatUtils::gte( tightening._value, bound._value ) :
+                     FloatUtils::lte( tightening._value, bound._value ) )
+                {
+                    indices.append( trailBound.first() );
+                    explained = true;
+                    break;
+                }
+            }
+        }
+
+        if ( !explained && level > decisionsNeeded )
+            decisionsNeeded = level;
+    }
+
+    collectDecisions( std::min( decisionsNeeded, maxLevel ), indices );
+}
+
+bool CDSmtCore::propagateLearnedClauses( List<TrailEntry> &conflict )
+{
+    while ( _propagationHead < _trail.size() )
+    {
+        TrailEntry asserted = _trail[_propagationHead];
+        _propagationHead = _propagationHead + 1;
+
+        PiecewiseLinearConstraint *constraint = asserted._pwlConstraint;
+        if ( !_watches.exists( constraint ) )
+            continue;
+
+        List<unsigned> &watchers = _watches[constraint];
+        auto it = watchers.begin();
+        while ( it != watchers.end() )
+        {
+            unsigned clauseIndex = *it;
+            Vector<TrailEntry> &clause = _learnedClauses[clauseIndex];
+            if ( clause.empty() )
+            {
+                it = watchers.erase( it );
+                continue;
+            }
+
+            // Make the watched literal of the asserted constraint the first
+            if ( clause[0]._pwlConstraint != constraint )
+                std::swap( clause[0], clause[1] );
+            ASSERT( clause[0]._pwlConstraint == constraint );
+
+            // Another case was asserted, so the clause is satisfied
+            if ( clause[0]._phase != asserted._phase )
+            {
+                ++it;
+                continue;
+            }
+
+            // Watch another literal that does not hold, if there is one
+            bool moved = false;
+            for ( unsigned i = 2; i < clause.size(); ++i )
+            {
+                if ( getLiteralValue( clause[i] ) != LITERAL_TRUE )
+                {
+                    std::swap( clause[0], clause[i] );
+                    _watches[clause[0]._pwlConstraint].append( clauseIndex );
+                    moved = true;
+                    break;
+                }
+            }
+
+            if ( moved )
+            {
+                it = watchers.erase( it );
+                continue;
+            }
+            ++it;
+
+            LiteralValue otherValue = getLiteralValue( clause[1] );
+            if ( otherValue == LITERAL_FALSE )
+                continue;
+
+            if ( otherValue == LITERAL_TRUE )
+            {
+                conflict.clear();
+                for ( const auto &literal : clause )
+                    conflict.append( literal );
+                return false;
+            }
+
+            TrailEntry literal = clause[1];
+            if ( literal._pwlConstraint->numFeasibleCases() <= 1 )
+            {
+                // The only feasible case is excluded by the clause
+                noFeasibleCaseConflict( literal, clauseIndex, conflict );
+                return false;
+            }
+
+            excludeCase( literal, clauseIndex );
+            if ( _statistics )
+                _statistics->incUnsignedAttribute( Statistics::NUM_CLAUSE_PROPAGATIONS );
+        }
+    }
+
+    return true;
+}
+
+CDSmtCore::LiteralValue CDSmtCore::getLiteralValue( const TrailEntry &literal ) const
+{
+    unsigned index;
+    if ( getTrailIndex( literal._pwlConstraint, index ) )
+        return _trail[index]._phase == literal._phase ? LITERAL_TRUE : LITERAL_FALSE;
+
+    if ( literal._pwlConstraint->isCaseInfeasible( literal._phase ) )
+        return LITERAL_FALSE;
+
+    return LITERAL_UNASSIGNED;
+}
+
+bool CDSmtCore::getTrailIndex( PiecewiseLinearConstraint *constraint,
+                               unsigned &index ) const
+{
+    if ( !_trailIndexOfConstraint.exists( constraint ) )
+        return false;
+
+    index = _trailIndexOfConstraint.get( constraint );
+    return index < _trail.size() && _trail[index]._pwlConstraint == constraint;
+}
+
+bool CDSmtCore::getLastClauseExclusion( PiecewiseLinearConstraint *constraint,
+                                        unsigned &index ) const
+{
+    if ( !_lastClauseExclusion.exists( constraint ) )
+        return false;
+
+    index = _lastClauseExclusion.get( constraint );
+    return index < _clauseExclusions.size() &&
+        _clauseExclusions[index]._constraint == constraint;
+}
+
+void CDSmtCore::noFeasibleCaseConflict( const TrailEntry &literal, unsigned clauseIndex,
+                                        List<TrailEntry> &conflict ) const
+{
+    PiecewiseLinearConstraint *constraint = literal._pwlConstraint;
+    conflict.clear();
+    for ( const auto &other : _learnedClauses[clauseIndex] )
+        if ( other._pwlConstraint != constraint )
+            conflict.append( other );
+
+    unsigned numExclusions = 0;
+    unsigned exclusion;
+    if ( !getLastClauseExclusion( constraint, exclusion ) )
+        exclusion = NO_EXCLUSION;
+
+    while ( exclusion != NO_EXCLUSION )
+    {
+        const ClauseExclusion &record = _clauseExclusions[exclusion];
+        for ( const auto &other : _learnedClauses[record._clauseIndex] )
+            if ( other._pwlConstraint != constraint )
+                conflict.append( other );
+
+        ++numExclusions;
+        exclusion = record._previous;
+    }
+
+    // Cases excluded otherwise may depend on any decision
+    unsigned numInfeasibleCases =
+        constraint->getAllCases().size() - constraint->numFeasibleCases();
+    if ( numExclusions < numInfeasibleCases )
+        for ( const auto &decision : _decisions )
+            conflict.append( decision );
+}
+
+void CDSmtCore::excludeCase( const TrailEntry &literal, unsigned clauseIndex )
+{
+    PiecewiseLinearConstraint *constraint = literal._pwlConstraint;
+    constraint->markInfeasible( literal._phase );
+
+    unsigned previous;
+    if ( !getLastClauseExclusion( constraint, previous ) )
+        previous = NO_EXCLUSION;
+    _lastClauseExclusion[constraint] = _clauseExclusions.size();
+    _clauseExclusions.push_back( ClauseExclusion( constraint, clauseIndex, previous ) );
+
+    if ( constraint->isImplication() )
+    {
+        if ( constraint->isActive() )
+            constraint->setActiveConstraint( false );
+        pushImplication( constraint, clauseIndex );
+    }
+}
+
+const Vector<Vector<TrailEntry>> &CDSmtCore::getLearnedClauses() const
+{
+    return _learnedClauses;
+}
+
 void CDSmtCore::resetReportedViolations()
 {
     _constraintToViolationCount.clear();
@@ -472,6 +1188,12 @@ void CDSmtCore::reset()
 {
     _context.popto( 0 );
     _engine->postContextPopHook();
+    // The clauses were learned for the previous query
+    _learnedClauses.clear();
+    _numLiveLearnedClauses = 0;
+    _watches.clear();
+    _trailIndexOfConstraint.clear();
+    _lastClauseExclusion.clear();
     _needToSplit = false;
     _constraintForSplitting = NULL;
     _constraintToViolationCount.clear();
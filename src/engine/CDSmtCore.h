@@ -61,22 +61,65 @@
  ** markInfeasible() methods.
  **
  ** - Using BoundManager class to store bounds in a context-dependent manner
+ **
+ ** Conflict-driven clause learning:
+ **
+ ** When the search state is found to be infeasible, the engine explains the
+ ** infeasibility as a set of bounds that cannot hold simultaneously (e.g.,
+ ** the bounds used by the Farkas-style row combination behind a failed
+ ** simplex phase, or the two bounds of a variable whose lower bound exceeds
+ ** its upper bound). explainBounds() turns these bounds into a conflict: a
+ ** set of trail entries that cannot hold simultaneously.
+ **
+ ** resolveConflict() performs first-UIP analysis: trail entries of the
+ ** highest decision level in the conflict are replaced by their reasons,
+ ** latest first, until a single one is left. The reason of an implication
+ ** is given by the clauses that excluded the other cases of its constraint,
+ ** and the reason of a phase fixed by the bounds by the bounds that ruled
+ ** out the other cases. Entries without a known reason depend on all the
+ ** decisions up to their level.
+ **
+ ** Conflicts found by bound tightening or by the network-level reasoner
+ ** have no explanation of their own, so the clause is then minimized by
+ ** bound propagation (e.g., DeepPoly). The bounds at a decision level follow
+ ** from the decisions up to it, so if the bounds at a lower level are
+ ** refuted together with the asserting literal, the decisions up to that
+ ** level replace the other literals. Literals whose removal keeps the
+ ** clause refuted from the bounds at level 0 are dropped, from the highest
+ ** level down. The search backjumps to the highest level of the remaining
+ ** literals and excludes the case of the asserting literal. A constraint
+ ** with a single case left becomes an implication.
+ **
+ ** Learned clauses are not context dependent. Each watches two of its
+ ** literals that do not hold, and is only visited when one of them is
+ ** asserted on the trail. The position of every constraint on the trail and
+ ** the clauses that excluded its cases are indexed by constraint; the index
+ ** is validated against the context-dependent lists, so it is backtracked
+ ** with them. When there are more than MAX_LEARNED_CONFLICT_CLAUSES clauses,
+ ** the longest clauses that do not explain an entry on the trail are
+ ** deleted. The engine drives the search with the CDSmtCore instead of the
+ ** SmtCore when the --cdcl option is set.
  **/
 
 #ifndef __CDSmtCore_h__
 #define __CDSmtCore_h__
 
+#include "Map.h"
 #include "Options.h"
+#include "Pair.h"
 #include "PiecewiseLinearCaseSplit.h"
 #include "PiecewiseLinearConstraint.h"
 #include "PLConstraintScoreTracker.h"
 #include "Stack.h"
 #include "Statistics.h"
+#include "Tightening.h"
 #include "TrailEntry.h"
+#include "Vector.h"
 #include "context/cdlist.h"
+#include "context/cdo.h"
 #include "context/context.h"
 
-#define SMT_LOG( x, ... ) LOG( GlobalConfiguration::SMT_CORE_LOGGING, "CDSmtCore: %s\n", x )
+#define CD_SMT_LOG( x, ... ) LOG( GlobalConfiguration::SMT_CORE_LOGGING, "CDSmtCore: %s\n", x )
 
 class EngineState;
 class Engine;
@@ -85,6 +128,16 @@ class String;
 class CDSmtCore
 {
 public:
+    /*
+      Reason of trail entries that do not follow from a learned clause.
+    */
+    static const unsigned NO_REASON = (unsigned)-1;
+
+    /*
+      Reason of trail entries whose phase was fixed by the bounds.
+    */
+    static const unsigned BOUND_REASON = (unsigned)-2;
+
     CDSmtCore( IEngine *engine, CVC4::context::Context &context );
     ~CDSmtCore();
 
@@ -149,15 +202,26 @@ public:
     void pushDecision( PiecewiseLinearConstraint *constraint,  PhaseStatus decision );
 
     /*
-      Inform SmtCore of an implied (formerly valid) case split that was discovered.
+      Inform SmtCore of an implied (formerly valid) case split that was
+      discovered. If the implication follows from a learned clause, reason is
+      the index of that clause.
+    */
+    void pushImplication( PiecewiseLinearConstraint *constraint,
+                          unsigned reason = NO_REASON );
+
+    /*
+      Inform SmtCore that the bounds fixed the phase of an active
+      constraint, and apply its valid case split. The phase is asserted on
+      the trail if it is one of the cases of the constraint.
     */
-    void pushImplication( PiecewiseLinearConstraint *constraint );
+    void pushBoundImplication( PiecewiseLinearConstraint *constraint );
 
     /*
         Pushes trail entry onto trail, handles decision book-keeping and
         update bounds and add equations to the engine.
      */
-    void applyTrailEntry( TrailEntry &te, bool isDecision = false );
+    void applyTrailEntry( TrailEntry &te, bool isDecision = false,
+                          unsigned reason = NO_REASON );
 
     /*
       Decide and apply a case split using the constraint marked for splitting.
@@ -186,6 +250,48 @@ public:
     */
     bool popSplit();
 
+    /*
+      Conflict-driven clause learning. The conflict is a set of trail entries
+      that cannot hold simultaneously. It is resolved into a clause with a
+      single literal at its highest decision level, after which the search
+      backjumps to the highest level of the other literals and excludes the
+      case of that literal. Returns false, after backtracking to level 0, if
+      the conflict does not depend on any decision, i.e., the query is
+      unsat.
+    */
+    bool resolveConflict( const List<TrailEntry> &conflict );
+
+    /*
+      Collect the trail entries responsible for a set of bounds that cannot
+      hold simultaneously. A bound implied by the case split of a trail entry
+      is explained by that entry, and any other bound (e.g., one found by
+      bound propagation) by all the decisions up to the lowest level at which
+      it held. Bounds that held at level 0 hold regardless of the decisions.
+    */
+    void explainBounds( const List<Tightening> &bounds,
+                        List<TrailEntry> &conflict ) const;
+
+    /*
+      Store the conflict consisting of all current decisions, which amounts
+      to chronological backtracking.
+    */
+    void allDecisionsAsConflict( List<TrailEntry> &conflict ) const;
+
+    /*
+      Propagate the learned clauses over the trail entries asserted since
+      the last propagation: if all literals of a clause but one hold, the
+      case of the remaining literal is marked infeasible, possibly turning
+      its constraint into an implication. Returns false and stores the
+      conflict if a clause is falsified.
+    */
+    bool propagateLearnedClauses( List<TrailEntry> &conflict );
+
+    /*
+      The clauses learned so far, each a set of literals that cannot hold
+      simultaneously. Deleted clauses are empty.
+    */
+    const Vector<Vector<TrailEntry>> &getLearnedClauses() const;
+
     /*
       Pop a context level - lazily backtracking trail, bounds, etc.
       Return true if successful, false if the stack is empty.
@@ -279,6 +385,67 @@ private:
      */
     CVC4::context::CDList<TrailEntry> _decisions;
 
+    /*
+      For every entry of the trail, the index of the learned clause it was
+      propagated from, BOUND_REASON, DECISION_REASON or NO_REASON.
+    */
+    CVC4::context::CDList<unsigned> _trailReasons;
+
+    /*
+      For every entry of the trail, its decision level.
+    */
+    CVC4::context::CDList<unsigned> _trailLevels;
+
+    /*
+      The index on the trail of every constraint asserted so far. An index
+      is only valid if the trail still holds the constraint there, so
+      backtracking the trail backtracks the index.
+    */
+    Map<PiecewiseLinearConstraint *, unsigned> _trailIndexOfConstraint;
+
+    /*
+      Learned conflict clauses. These are independent of the search state and
+      are therefore not context dependent. The first two literals of a clause
+      are its watched literals.
+    */
+    Vector<Vector<TrailEntry>> _learnedClauses;
+    unsigned _numLiveLearnedClauses;
+
+    /*
+      The indices of the clauses that watch a literal of each constraint.
+      Deleted clauses are dropped lazily.
+    */
+    Map<PiecewiseLinearConstraint *, List<unsigned>> _watches;
+
+    /*
+      The number of trail entries over which the learned clauses have been
+      propagated.
+    */
+    CVC4::context::CDO<unsigned> _propagationHead;
+
+    /*
+      For every case excluded by a learned clause, the constraint, the
+      index of the clause and the previous exclusion of the constraint. The
+      last exclusion of every constraint is indexed like the trail.
+    */
+    struct ClauseExclusion
+    {
+        ClauseExclusion( PiecewiseLinearConstraint *constraint,
+                         unsigned clauseIndex, unsigned previous )
+            : _constraint( constraint )
+            , _clauseIndex( clauseIndex )
+            , _previous( previous )
+        {
+        }
+
+        PiecewiseLinearConstraint *_constraint;
+        unsigned _clauseIndex;
+        unsigned _previous;
+    };
+
+    CVC4::context::CDList<ClauseExclusion> _clauseExclusions;
+    Map<PiecewiseLinearConstraint *, unsigned> _lastClauseExclusion;
+
     /*
       The engine.
     */
@@ -328,6 +495,114 @@ private:
     */
     unsigned _numRejectedPhasePatternProposal;
 
+    /*
+      Reason of decisions on the trail, and marker of no exclusion.
+    */
+    static const unsigned DECISION_REASON = (unsigned)-3;
+    static const unsigned NO_EXCLUSION = (unsigned)-1;
+
+    /*
+      The value of a literal: true if its case is asserted on the trail,
+      false if another case is asserted or its case is infeasible.
+    */
+    enum LiteralValue {
+        LITERAL_TRUE,
+        LITERAL_FALSE,
+        LITERAL_UNASSIGNED,
+    };
+
+    LiteralValue getLiteralValue( const TrailEntry &literal ) const;
+
+    /*
+      Find the index of a constraint on the trail, or the last clause that
+      excluded one of its cases. Return false if there is none.
+    */
+    bool getTrailIndex( PiecewiseLinearConstraint *constraint, unsigned &index ) const;
+    bool getLastClauseExclusion( PiecewiseLinearConstraint *constraint,
+                                 unsigned &index ) const;
+
+    /*
+      The bound tightenings of the case splits on the trail, by variable,
+      together with the index of their trail entry.
+    */
+    typedef Map<unsigned, List<Pair<unsigned, Tightening>>> TrailBounds;
+    void collectTrailBounds( TrailBounds &trailBounds ) const;
+
+    /*
+      Collect the indices of the trail entries before the given index that
+      explain the bounds; bounds that are not implied by their case splits
+      are explained by the decisions up to the lowest level at which they
+      held, but at most up to maxLevel.
+    */
+    void explainBounds( const List<Tightening> &bounds, const TrailBounds &trailBounds,
+                        unsigned before, unsigned maxLevel, List<unsigned> &indices ) const;
+
+    /*
+      Collect the indices of the trail entries from which the entry with
+      the given index was implied.
+    */
+    void explainTrailEntry( unsigned index, const TrailBounds &trailBounds,
+                            List<unsigned> &indices ) const;
+
+    /*
+      Collect the bounds that ruled out every case of a constraint but its
+      current phase. Return false if some case was not ruled out by a
+      bound.
+    */
+    bool explainPhaseByBounds( PiecewiseLinearConstraint *constraint,
+                               PhaseStatus phase, List<Tightening> &bounds ) const;
+
+    /*
+      Collect the indices of the decisions up to the given level.
+    */
+    void collectDecisions( unsigned level, List<unsigned> &indices ) const;
+
+    /*
+      First-UIP analysis of the conflict. Returns false if the conflict
+      does not depend on any decision. Otherwise stores the index of the
+      asserting literal, the only one at the highest level, and the
+      indices of the other literals of the learned clause.
+    */
+    bool analyzeConflict( const List<TrailEntry> &conflict, unsigned &assertingIndex,
+                          List<unsigned> &otherIndices ) const;
+
+    /*
+      Replace the other literals of the learned clause by the decisions up
+      to the lowest level whose bounds refute the asserting literal. Then
+      drop the other literals, starting from the highest level, as long as
+      the engine refutes the remaining ones from the bounds at level 0.
+    */
+    void minimizeLearnedClause( unsigned assertingIndex, List<unsigned> &otherIndices );
+
+    /*
+      Store a learned clause, whose literal with the highest level is the
+      first and whose literal with the second-highest level is the second,
+      and watch them. Returns the index of the clause.
+    */
+    unsigned storeLearnedClause( const Vector<TrailEntry> &clause );
+
+    /*
+      Delete the longest clauses that do not explain an entry on the trail,
+      if there are too many.
+    */
+    void reduceLearnedClauses();
+
+    /*
+      Store the conflict that arises when every feasible case of the
+      constraint of the literal would be excluded by the learned clause with
+      the given index: the other literals of that clause and of the clauses
+      that excluded the other cases.
+    */
+    void noFeasibleCaseConflict( const TrailEntry &literal, unsigned clauseIndex,
+                                 List<TrailEntry> &conflict ) const;
+
+    /*
+      Mark the case of the literal infeasible because of the learned clause
+      with the given index. If a single case of the constraint is left, it is
+      asserted as an implication; otherwise the constraint is left for a
+      later decision.
+    */
+    void excludeCase( const TrailEntry &literal, unsigned clauseIndex );
 };
 
 #endif // __CDSmtCore_h__
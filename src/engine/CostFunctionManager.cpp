@@ -28,6 +28,7 @@ CostFunctionManager::CostFunctionManager( ITableau *tableau )
     , _n( 0 )
     , _m( 0 )
     , _costFunctionStatus( COST_FUNCTION_INVALID )
+    , _recheckAdjustedCostFunction( false )
     , _ANColumn( NULL )
 {
 }
@@ -210,6 +211,7 @@ void CostFunctionManager::adjustBasicCostAccuracy()
     double assignment, lb, relaxedLb, ub, relaxedUb;
 
     bool needToRecompute = false;
+    bool missingOutOfBoundsBasic = false;
     for ( unsigned i = 0; i < _m; ++i )
     {
         variable = _tableau->basicIndexToVariable( i );
@@ -251,8 +253,20 @@ void CostFunctionManager::adjustBasicCostAccuracy()
               It seems to make sense to adjust anything that had cost 0 but should be
               1 or -1, but apparently this leads to cycling.
             */
-        }
+            lb = _tableau->getLowerBound( variable );
+            relaxedLb =
+                lb -
+                ( GlobalConfiguration::BASIC_COSTS_ADDITIVE_TOLERANCE +
+                  GlobalConfiguration::BASIC_COSTS_MULTIPLICATIVE_TOLERANCE * FloatUtils::abs( lb ) );
+            ub = _tableau->getUpperBound( variable );
+            relaxedUb =
+                ub +
+                ( GlobalConfiguration::BASIC_COSTS_ADDITIVE_TOLERANCE +
+                  GlobalConfiguration::BASIC_COSTS_MULTIPLICATIVE_TOLERANCE * FloatUtils::abs( ub ) );
 
+            if ( assignment < relaxedLb || assignment > relaxedUb )
+                missingOutOfBoundsBasic = true;
+        }
     }
 
     if ( needToRecompute )
@@ -262,6 +276,22 @@ void CostFunctionManager::adjustBasicCostAccuracy()
 
         _costFunctionStatus = ICostFunctionManager::COST_FUNCTION_JUST_COMPUTED;
     }
+
+    /*
+      In phase one, the adjusted function still guides the pivots, but it
+      does not prove infeasibility: the reduced costs are updated on top of
+      the previous ones, and the basics that have left their bounds are not
+      accounted for. If requested, have it recomputed from scratch before
+      trusting it.
+    */
+    if ( _recheckAdjustedCostFunction && !_tableau->isOptimizing() &&
+         ( needToRecompute || missingOutOfBoundsBasic ) )
+        _costFunctionStatus = ICostFunctionManager::COST_FUNCTION_UPDATED;
+}
+
+void CostFunctionManager::setRecheckAdjustedCostFunction( bool recheck )
+{
+    _recheckAdjustedCostFunction = recheck;
 }
 
 void CostFunctionManager::computeBasicOOBCosts()
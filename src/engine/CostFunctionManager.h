@@ -88,6 +88,14 @@ public:
     */
     void adjustBasicCostAccuracy();
 
+    /*
+      In phase one, a cost function whose basic costs were adjusted only
+      approximates the core cost function. If set, it is marked as updated
+      rather than just computed, so that a simplex failure under it is
+      retried with a fresh function before it is taken as infeasibility.
+    */
+    void setRecheckAdjustedCostFunction( bool recheck );
+
     /*
       For debugging purposes: dump the cost function.
     */
@@ -117,6 +125,11 @@ private:
     */
     CostFunctionStatus _costFunctionStatus;
 
+    /*
+      Whether an adjusted phase-one cost function is marked as updated.
+    */
+    bool _recheckAdjustedCostFunction;
+
     /*
       Work memeory
     */
@@ -30,8 +30,9 @@ public:
       largest coefficient (in absolute value) in the cost function.
     */
     bool select( ITableau &tableau,
-                 const List<unsigned> &candidates,
-                 const Set<unsigned> &excluded );
+                 const unsigned *candidates,
+                 unsigned numberOfCandidates,
+                 const Bitset &excluded );
 };
 
 #endif // __DantzigsRule_h__
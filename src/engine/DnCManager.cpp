@@ -37,14 +37,16 @@
 #include "cblas.h"
 #endif
 
-void DnCManager::dncSolve( WorkerQueue *workload, std::shared_ptr<Engine> engine,
+void DnCManager::dncSolve( WorkStealingQueue *workload, std::shared_ptr<Engine> engine,
                            std::unique_ptr<InputQuery> inputQuery,
                            std::atomic_int &numUnsolvedSubQueries,
                            std::atomic_bool &shouldQuitSolving,
                            unsigned threadId, unsigned onlineDivides,
                            float timeoutFactor, SnCDivideStrategy divideStrategy,
                            bool restoreTreeStates, unsigned verbosity,
-                           unsigned seed, bool parallelDeepSoI )
+                           unsigned seed, bool parallelDeepSoI,
+                           unsigned long long &busyTimeInMicro,
+                           unsigned long long &idleTimeInMicro )
 {
     unsigned cpuId = 0;
     (void) threadId;
@@ -55,15 +57,23 @@ void DnCManager::dncSolve( WorkerQueue *workload, std::shared_ptr<Engine> engine
 
     engine->setRandomSeed( seed );
     if ( threadId != 0 )
+    {
         engine->processInputQuery( *inputQuery, false );
+        // The engine keeps its own copy of the query, whose network shares
+        // its weights with the base engine, so this one can be released
+        inputQuery = nullptr;
+    }
 
     DnCWorker worker( workload, engine, std::ref( numUnsolvedSubQueries ),
                       std::ref( shouldQuitSolving ), threadId, onlineDivides,
                       timeoutFactor, divideStrategy, verbosity, parallelDeepSoI );
-    while ( !shouldQuitSolving.load() )
-    {
-        worker.popOneSubQueryAndSolve( restoreTreeStates );
-    }
+    // The worker parks inside popOneSubQueryAndSolve while there is no work,
+    // and gets false back once the workload is closed
+    while ( !shouldQuitSolving.load() &&
+            worker.popOneSubQueryAndSolve( restoreTreeStates ) );
+
+    busyTimeInMicro = worker.getBusyTimeInMicro();
+    idleTimeInMicro = worker.getIdleTimeInMicro();
 }
 
 DnCManager::DnCManager( InputQuery *inputQuery )
@@ -104,13 +114,6 @@ void DnCManager::freeMemoryIfNeeded()
 {
     if ( _workload )
     {
-        SubQuery *subQuery = NULL;
-        while ( !_workload->empty() )
-        {
-            _workload->pop( subQuery );
-            delete subQuery;
-        }
-
         delete _workload;
         _workload = NULL;
     }
@@ -154,8 +157,9 @@ void DnCManager::solve()
         quitThreads.append( _engines[i]->getQuitRequested() );
 
     // Partition the input query into initial subqueries, and place these
-    // queries in the queue
-    _workload = new WorkerQueue( 0 );
+    // queries in the workers' deques
+    freeMemoryIfNeeded();
+    _workload = new WorkStealingQueue( numWorkers );
     if ( !_workload )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "DnCManager::workload" );
 
@@ -181,15 +185,7 @@ void DnCManager::solve()
     // Create objects shared across workers
     _numUnsolvedSubQueries = _runParallelDeepSoI ? 1 : subQueries.size();
     std::atomic_bool shouldQuitSolving( false );
-    WorkerQueue *workload = new WorkerQueue( 0 );
-    for ( auto &subQuery : subQueries )
-    {
-        if ( !workload->push( subQuery ) )
-        {
-            // This should never happen
-            ASSERT( false );
-        }
-    }
+    _workload->distribute( subQueries );
 
     unsigned onlineDivides = Options::get()->getInt( Options::NUM_ONLINE_DIVIDES );
     float timeoutFactor = Options::get()->getFloat( Options::TIMEOUT_FACTOR );
@@ -199,6 +195,10 @@ void DnCManager::solve()
     auto baseInputQuery = std::unique_ptr<InputQuery>
         ( new InputQuery( *( _baseEngine->getInputQuery() ) ) );
 
+    // Each worker reports its busy and idle time here before it exits
+    Vector<unsigned long long> busyTimes( numWorkers, 0 );
+    Vector<unsigned long long> idleTimes( numWorkers, 0 );
+
     // Spawn threads and start solving
     std::list<std::thread> threads;
     for ( unsigned threadId = 0; threadId < numWorkers; ++threadId )
@@ -209,7 +209,7 @@ void DnCManager::solve()
             inputQuery = std::unique_ptr<InputQuery>
                 ( new InputQuery( *( baseInputQuery ) ) );
 
-        threads.push_back( std::thread( dncSolve, workload, _engines[ threadId ],
+        threads.push_back( std::thread( dncSolve, _workload, _engines[ threadId ],
                                         threadId != 0 ? std::move( inputQuery ) : nullptr,
                                         std::ref( _numUnsolvedSubQueries ),
                                         std::ref( shouldQuitSolving ),
@@ -217,13 +217,16 @@ void DnCManager::solve()
                                         timeoutFactor, _sncSplittingStrategy,
                                         restoreTreeStates, _verbosity,
                                         _runParallelDeepSoI ? seed + threadId : seed,
-                                        _runParallelDeepSoI
+                                        _runParallelDeepSoI,
+                                        std::ref( busyTimes[threadId] ),
+                                        std::ref( idleTimes[threadId] )
                                         ) );
     }
 
     // Wait until either all subQueries are solved or a satisfying assignment is
-    // found by some worker
-    while ( !shouldQuitSolving.load() )
+    // found by some worker. The workload closes itself when every worker is
+    // parked on an empty queue, since no more work can then be produced.
+    while ( !shouldQuitSolving.load() && !_workload->closed() )
     {
         updateTimeoutReached( startTime, timeoutInMicroSeconds );
         if ( _timeoutReached )
@@ -234,13 +237,25 @@ void DnCManager::solve()
     }
 
 
-    // Now that we are done, tell all workers to quit
+    // Now that we are done, wake up the parked workers and tell the busy
+    // ones to quit
+    _workload->close();
     for ( auto &quitThread : quitThreads )
         *quitThread = true;
 
     for ( auto &thread : threads )
         thread.join();
 
+    DNC_MANAGER_LOG( Stringf( "Sub-queries stolen between workers: %llu",
+                              _workload->getNumSteals() ).ascii() );
+
+    if ( _verbosity > 0 )
+    {
+        for ( unsigned i = 0; i < numWorkers; ++i )
+            printf( "Worker %u: busy %.2f seconds, idle %.2f seconds\n", i,
+                    busyTimes[i] / 1000000.0, idleTimes[i] / 1000000.0 );
+    }
+
     updateDnCExitCode();
     return;
 }
@@ -424,12 +439,16 @@ bool DnCManager::createEngines( unsigned numberOfEngines )
         return false;
 
     _baseEngine->setVerbosity( 0 );
+    // The base engine preprocesses alone, but during the search each
+    // engine occupies one thread, and so does its DeepPoly analysis
+    _baseEngine->setNumberOfDeepPolyThreads( 1 );
 
     // Create engines for each thread
     for ( unsigned i = 1; i < numberOfEngines; ++i )
     {
         auto engine = std::make_shared<Engine>();
         engine->setVerbosity( 0 );
+        engine->setNumberOfDeepPolyThreads( 1 );
         _engines.append( engine );
     }
 
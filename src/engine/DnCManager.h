@@ -21,6 +21,7 @@
 #include "InputQuery.h"
 #include "SubQuery.h"
 #include "Vector.h"
+#include "WorkStealingQueue.h"
 
 #include <atomic>
 
@@ -74,16 +75,19 @@ public:
 
 private:
     /*
-      Create and run a DnCWorker
+      Create and run a DnCWorker. When the worker stops, its busy and idle
+      times are written to the last two arguments.
     */
-    static void dncSolve( WorkerQueue *workload, std::shared_ptr<Engine> engine,
+    static void dncSolve( WorkStealingQueue *workload, std::shared_ptr<Engine> engine,
                           std::unique_ptr<InputQuery> inputQuery,
                           std::atomic_int &numUnsolvedSubQueries,
                           std::atomic_bool &shouldQuitSolving,
                           unsigned threadId, unsigned onlineDivides,
                           float timeoutFactor, SnCDivideStrategy divideStrategy,
                           bool restoreTreeStates, unsigned verbosity,
-                          unsigned seed, bool parallelDeepSoI );
+                          unsigned seed, bool parallelDeepSoI,
+                          unsigned long long &busyTimeInMicro,
+                          unsigned long long &idleTimeInMicro );
 
     /*
       Create the base engine from the network and property files,
@@ -136,9 +140,9 @@ private:
     DnCExitCode _exitCode;
 
     /*
-      Set of subQueries to be solved by workers
+      Set of subQueries to be solved by workers, one deque per worker
     */
-    WorkerQueue *_workload;
+    WorkStealingQueue *_workload;
 
     /*
       Whether the timeout has been reached
@@ -19,19 +19,18 @@
 #include "IEngine.h"
 #include "EngineState.h"
 #include "LargestIntervalDivider.h"
-#include "MarabouError.h"
 #include "MStringf.h"
 #include "PiecewiseLinearCaseSplit.h"
 #include "PolarityBasedDivider.h"
 #include "SubQuery.h"
 #include "TableauStateStorageLevel.h"
+#include "TimeUtils.h"
+#include "TraceRecorder.h"
 
 #include <atomic>
-#include <chrono>
 #include <cmath>
-#include <thread>
 
-DnCWorker::DnCWorker( WorkerQueue *workload, std::shared_ptr<IEngine> engine,
+DnCWorker::DnCWorker( WorkStealingQueue *workload, std::shared_ptr<IEngine> engine,
                       std::atomic_int &numUnsolvedSubQueries,
                       std::atomic_bool &shouldQuitSolving,
                       unsigned threadId, unsigned onlineDivides,
@@ -46,6 +45,8 @@ DnCWorker::DnCWorker( WorkerQueue *workload, std::shared_ptr<IEngine> engine,
     , _timeoutFactor( timeoutFactor )
     , _verbosity( verbosity )
     , _parallelDeepSoI( parallelDeepSoI )
+    , _busyTimeInMicro( 0 )
+    , _idleTimeInMicro( 0 )
 {
     setQueryDivider( divideStrategy );
 
@@ -71,14 +72,24 @@ void DnCWorker::setQueryDivider( SnCDivideStrategy divideStrategy )
     }
 }
 
-void DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
+bool DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
 {
     SubQuery *subQuery = NULL;
-    // Boost queue stores the next element into the passed-in pointer
-    // and returns true if the pop is successful (aka, the queue is not empty
-    // in most cases)
-    if ( _workload->pop( subQuery ) )
+    // The queue stores the next element into the passed-in pointer and
+    // returns true if the pop (or steal) is successful. It blocks while
+    // there is no work.
+    struct timespec idleStart = TimeUtils::sampleMicro();
+    bool popped;
     {
+        MARABOU_TRACE_SPAN( "dnc", "wait for sub-query" );
+        popped = _workload->waitAndPop( _threadId, subQuery );
+    }
+    struct timespec busyStart = TimeUtils::sampleMicro();
+    _idleTimeInMicro += TimeUtils::timePassed( idleStart, busyStart );
+
+    if ( popped )
+    {
+        MARABOU_TRACE_SPAN( "dnc", "sub-query" );
         String queryId = subQuery->_queryId;
         unsigned depth = subQuery->_depth;
         auto split = std::move( subQuery->_split );
@@ -157,12 +168,8 @@ void DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
                     newSubQuery->_smtState = std::move( newSmtStates[i++] );
                 }
 
-                if ( !_workload->push( std::move( newSubQuery ) ) )
-                {
-                    throw MarabouError( MarabouError::UNSUCCESSFUL_QUEUE_PUSH );
-                }
-
                 *_numUnsolvedSubQueries += 1;
+                _workload->push( _threadId, newSubQuery );
             }
             *_numUnsolvedSubQueries -= 1;
             delete subQuery;
@@ -200,12 +207,21 @@ void DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
                 delete subQuery;
             }
         }
+
+        _busyTimeInMicro += TimeUtils::timePassed( busyStart, TimeUtils::sampleMicro() );
     }
-    else
-    {
-        // If the queue is empty but the pop fails, wait and retry
-        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
-    }
+
+    return popped;
+}
+
+unsigned long long DnCWorker::getBusyTimeInMicro() const
+{
+    return _busyTimeInMicro;
+}
+
+unsigned long long DnCWorker::getIdleTimeInMicro() const
+{
+    return _idleTimeInMicro;
 }
 
 void DnCWorker::printProgress( String queryId, IEngine::ExitCode result ) const
@@ -20,13 +20,14 @@
 #include "Engine.h"
 #include "PiecewiseLinearCaseSplit.h"
 #include "QueryDivider.h"
+#include "WorkStealingQueue.h"
 
 #include <atomic>
 
 class DnCWorker
 {
 public:
-    DnCWorker( WorkerQueue *workload, std::shared_ptr<IEngine> engine,
+    DnCWorker( WorkStealingQueue *workload, std::shared_ptr<IEngine> engine,
                std::atomic_int &numUnsolvedSubqueries,
                std::atomic_bool &shouldQuitSolving, unsigned threadId,
                unsigned onlineDivides, float timeoutFactor,
@@ -34,10 +35,20 @@ public:
                bool parallelDeepSoI );
 
     /*
-      Pop one subQuery, solve it and handle the result
-      Return true if the DnCWorker should continue running
+      Pop one subQuery, solve it and handle the result. The subQuery is
+      taken from this worker's own deque if possible, and stolen from
+      another worker's otherwise. New subQueries created on timeout are
+      pushed to this worker's deque. If there is no work, the worker is
+      parked until some arrives. Return false if the workload was closed
+      and no subQuery was solved.
     */
-    void popOneSubQueryAndSolve( bool restoreTreeStates = false );
+    bool popOneSubQueryAndSolve( bool restoreTreeStates = false );
+
+    /*
+      The time this worker spent solving subQueries, and waiting for one
+    */
+    unsigned long long getBusyTimeInMicro() const;
+    unsigned long long getIdleTimeInMicro() const;
 
 private:
     /*
@@ -56,9 +67,9 @@ private:
     void printProgress( String queryId, IEngine::ExitCode result ) const;
 
     /*
-      The queue of subqueries (shared across threads)
+      The per-worker deques of subqueries (shared across threads)
     */
-    WorkerQueue *_workload;
+    WorkStealingQueue *_workload;
     std::shared_ptr<IEngine> _engine;
 
     /*
@@ -83,6 +94,9 @@ private:
     float _timeoutFactor;
     unsigned _verbosity;
     bool _parallelDeepSoI;
+
+    unsigned long long _busyTimeInMicro;
+    unsigned long long _idleTimeInMicro;
 };
 
 #endif // __DnCWorker_h__
@@ -29,6 +29,7 @@
 #include "Preprocessor.h"
 #include "TableauRow.h"
 #include "TimeUtils.h"
+#include "TraceRecorder.h"
 #include "VariableOutOfBoundDuringOptimizationException.h"
 #include "Vector.h"
 
@@ -41,10 +42,13 @@ Engine::Engine()
     , _preprocessedQuery( nullptr )
     , _rowBoundTightener( *_tableau )
     , _smtCore( this )
-    , _numPlConstraintsDisabledByValidSplits( 0 )
+    , _cdSmtCore( this, _context )
+    , _numPlConstraintsDisabledByValidSplits( &_context, 0 )
+    , _searchStateIsContextDependent( false )
     , _preprocessingEnabled( false )
     , _initialStateStored( false )
     , _work( NULL )
+    , _enteringVariableCandidates( NULL )
     , _basisRestorationRequired( Engine::RESTORATION_NOT_NEEDED )
     , _basisRestorationPerformed( Engine::NO_RESTORATION_PERFORMED )
     , _costFunctionManager( _tableau )
@@ -53,27 +57,48 @@ Engine::Engine()
     , _numVisitedStatesAtPreviousRestoration( 0 )
     , _networkLevelReasoner( NULL )
     , _verbosity( Options::get()->getInt( Options::VERBOSITY ) )
+    , _numberOfDeepPolyThreads( 0 )
     , _lastNumVisitedStates( 0 )
     , _lastIterationWithProgress( 0 )
     , _symbolicBoundTighteningType( Options::get()->getSymbolicBoundTighteningType() )
     , _solveWithMILP( Options::get()->getBool( Options::SOLVE_WITH_MILP ) )
+    , _solveWithCDCL( Options::get()->getBool( Options::CDCL ) )
+    , _refutationNetwork( nullptr )
     , _lpSolverType( Options::get()->getLPSolverType() )
     , _gurobi( nullptr )
     , _milpEncoder( nullptr )
     , _soiManager( nullptr )
     , _simulationSize( Options::get()->getInt( Options::NUMBER_OF_SIMULATIONS ) )
-    , _isGurobyEnabled( Options::get()->gurobiEnabled() )
     , _performLpTighteningAfterSplit( Options::get()->getBool( Options::PERFORM_LP_TIGHTENING_AFTER_SPLIT ) )
+    , _dualSimplexAfterSplit( Options::get()->getBool( Options::DUAL_SIMPLEX_AFTER_SPLIT ) )
     , _milpSolverBoundTighteningType( Options::get()->getMILPSolverBoundTighteningType() )
     , _sncMode( false )
     , _queryId( "" )
 {
     _smtCore.setStatistics( &_statistics );
+    _cdSmtCore.setStatistics( &_statistics );
     _tableau->setStatistics( &_statistics );
     _rowBoundTightener->setStatistics( &_statistics );
     _preprocessor.setStatistics( &_statistics );
 
-    _activeEntryStrategy = _projectedSteepestEdgeRule;
+    switch ( Options::get()->getPricingStrategy() )
+    {
+    case PricingStrategy::DANTZIG:
+        _activeEntryStrategy = &_dantzigsRule;
+        break;
+    case PricingStrategy::BLAND:
+        _activeEntryStrategy = &_blandsRule;
+        break;
+    case PricingStrategy::PARTIAL:
+        _activeEntryStrategy = &_partialPricingRule;
+        break;
+    case PricingStrategy::MULTIPLE:
+        _activeEntryStrategy = &_multiplePricingRule;
+        break;
+    default:
+        _activeEntryStrategy = _projectedSteepestEdgeRule;
+        break;
+    }
     _activeEntryStrategy->setStatistics( &_statistics );
     _statistics.stampStartingTime();
     setRandomSeed( Options::get()->getInt( Options::SEED ) );
@@ -91,6 +116,14 @@ Engine::~Engine()
         delete[] _work;
         _work = NULL;
     }
+
+    if ( _enteringVariableCandidates )
+    {
+        delete[] _enteringVariableCandidates;
+        _enteringVariableCandidates = NULL;
+    }
+
+    clearIntervalSplitsForCDCL();
 }
 
 void Engine::setVerbosity( unsigned verbosity )
@@ -98,6 +131,13 @@ void Engine::setVerbosity( unsigned verbosity )
     _verbosity = verbosity;
 }
 
+void Engine::setNumberOfDeepPolyThreads( unsigned numberOfThreads )
+{
+    _numberOfDeepPolyThreads = numberOfThreads;
+    if ( _networkLevelReasoner )
+        _networkLevelReasoner->setNumberOfDeepPolyThreads( numberOfThreads );
+}
+
 void Engine::adjustWorkMemorySize()
 {
     if ( _work )
@@ -109,6 +149,19 @@ void Engine::adjustWorkMemorySize()
     _work = new double[_tableau->getM()];
     if ( !_work )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "Engine::work" );
+
+    if ( _enteringVariableCandidates )
+    {
+        delete[] _enteringVariableCandidates;
+        _enteringVariableCandidates = NULL;
+    }
+
+    unsigned numberOfNonBasics = _tableau->getN() - _tableau->getM();
+    _enteringVariableCandidates = new unsigned[numberOfNonBasics];
+    if ( !_enteringVariableCandidates )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Engine::enteringVariableCandidates" );
+
+    _excludedEnteringVariables.resize( numberOfNonBasics );
 }
 
 
@@ -158,6 +211,7 @@ void Engine::exportInputQueryWithError( String errorMessage )
 
 bool Engine::solve( unsigned timeoutInSeconds )
 {
+    MARABOU_TRACE_SPAN( "engine", "solve" );
     SignalHandler::getInstance()->initialize();
     SignalHandler::getInstance()->registerClient( this );
 
@@ -165,6 +219,28 @@ bool Engine::solve( unsigned timeoutInSeconds )
     for ( auto &plConstraint : _plConstraints )
         plConstraint->registerBoundManager( &_boundManager );
 
+    initializeContextDependentSearchState();
+
+    // Conflict analysis relies on the context to undo the decisions
+    if ( _solveWithCDCL &&
+         ( !_searchStateIsContextDependent ||
+           _lpSolverType != LPSolverType::NATIVE ||
+           GlobalConfiguration::USE_DEEPSOI_LOCAL_SEARCH ) )
+    {
+        if ( _verbosity > 0 )
+            printf( "Engine::solve: CDCL is not supported for this query, "
+                    "backtracking chronologically\n" );
+        _solveWithCDCL = false;
+    }
+
+    // Learned clauses trust every conflict, so a phase-one failure under
+    // an adjusted cost function is retried with a fresh one first
+    _costFunctionManager->setRecheckAdjustedCostFunction( _solveWithCDCL );
+
+    // Other engines may have started or stopped sharing the network since
+    // it was processed
+    updateNetworkMemoryStatistics();
+
     if ( _solveWithMILP )
         return solveWithMILPEncoding( timeoutInSeconds );
 
@@ -257,11 +333,19 @@ bool Engine::solve( unsigned timeoutInSeconds )
             {
                 performBoundTighteningAfterCaseSplit();
                 informLPSolverOfBounds();
+                if ( _dualSimplexAfterSplit && _lpSolverType == LPSolverType::NATIVE )
+                    reoptimizeWithDualSimplex();
                 splitJustPerformed = false;
             }
 
             // Perform any SmtCore-initiated case splits
-            if ( _smtCore.needToSplit() )
+            if ( _solveWithCDCL && _cdSmtCore.needToSplit() )
+            {
+                _cdSmtCore.decide();
+                splitJustPerformed = true;
+                continue;
+            }
+            else if ( _smtCore.needToSplit() )
             {
                 _smtCore.performSplit();
                 splitJustPerformed = true;
@@ -334,7 +418,7 @@ bool Engine::solve( unsigned timeoutInSeconds )
             _tableau->toggleOptimization( false );
             // The current query is unsat, and we need to pop.
             // If we're at level 0, the whole query is unsat.
-            if ( !_smtCore.popSplit() )
+            if ( _solveWithCDCL ? !resolveConflictWithCDCL() : !_smtCore.popSplit() )
             {
                 struct timespec mainLoopEnd = TimeUtils::sampleMicro();
                 _statistics.incLongAttribute
@@ -413,6 +497,7 @@ void Engine::mainLoopStatistics()
 
 void Engine::performBoundTighteningAfterCaseSplit()
 {
+    MARABOU_TRACE_SPAN( "engine", "bound tightening after split" );
     // Tighten bounds of a first hidden layer with MILP solver
     performMILPSolverBoundedTighteningForSingleLayer( 1 );
     do
@@ -541,6 +626,7 @@ bool Engine::handleMalformedBasisException()
 
 void Engine::performConstraintFixingStep()
 {
+    MARABOU_TRACE_SPAN( "engine", "constraint fixing step" );
     // Statistics
     _statistics.incLongAttribute( Statistics::NUM_CONSTRAINT_FIXING_STEPS );
     struct timespec start = TimeUtils::sampleMicro();
@@ -561,6 +647,7 @@ void Engine::performConstraintFixingStep()
 
 bool Engine::performSimplexStep()
 {
+    MARABOU_TRACE_SPAN( "engine", "simplex step" );
     // Statistics
     _statistics.incLongAttribute( Statistics::NUM_SIMPLEX_STEPS );
     struct timespec start = TimeUtils::sampleMicro();
@@ -613,26 +700,36 @@ bool Engine::performSimplexStep()
             }
         });
 
-    // Obtain all eligible entering varaibles
-    List<unsigned> enteringVariableCandidates;
-    _tableau->getEntryCandidates( enteringVariableCandidates );
+    // Obtain all eligible entering varaibles, unless the strategy only
+    // prices some of them and searches for itself
+    unsigned numberOfCandidates = 0;
+    if ( _activeEntryStrategy->requiresEntryCandidates() )
+    {
+        numberOfCandidates = _tableau->getEntryCandidates( _enteringVariableCandidates );
+        _statistics.incLongAttribute( Statistics::NUM_PRICING_CANDIDATES_SCANNED,
+                                      _tableau->getN() - _tableau->getM() );
+    }
 
     unsigned bestLeaving = 0;
     double bestChangeRatio = 0.0;
-    Set<unsigned> excludedEnteringVariables;
     bool haveCandidate = false;
     unsigned bestEntering = 0;
     double bestPivotEntry = 0.0;
     unsigned tries = GlobalConfiguration::MAX_SIMPLEX_PIVOT_SEARCH_ITERATIONS;
 
+    // Start from a clean slate: a previous step may have been cut short
+    // by an exception before clearing its exclusions
+    _excludedEnteringVariables.clear();
+
     while ( tries > 0 )
     {
         --tries;
 
         // Attempt to pick the best entering variable from the available candidates
         if ( !_activeEntryStrategy->select( _tableau,
-                                            enteringVariableCandidates,
-                                            excludedEnteringVariables ) )
+                                            _enteringVariableCandidates,
+                                            numberOfCandidates,
+                                            _excludedEnteringVariables ) )
         {
             // No additional candidates can be found.
             break;
@@ -643,7 +740,7 @@ bool Engine::performSimplexStep()
 
         // We don't want to re-consider this candidate in future
         // iterations
-        excludedEnteringVariables.insert( _tableau->getEnteringVariableIndex() );
+        _excludedEnteringVariables.set( _tableau->getEnteringVariableIndex() );
 
         // Pick a leaving variable
         _tableau->computeChangeColumn();
@@ -715,7 +812,11 @@ bool Engine::performSimplexStep()
                 return true;
             }
             else
+            {
+                if ( _solveWithCDCL )
+                    explainSimplexFailure();
                 throw InfeasibleQueryException();
+            }
         }
     }
 
@@ -760,6 +861,238 @@ bool Engine::performSimplexStep()
     return false;
 }
 
+void Engine::explainSimplexFailure()
+{
+    _conflictBounds.clear();
+
+    /*
+      The fresh phase-one cost function is a Farkas certificate: with basic
+      costs c and reduced costs d, sum_i c_i * x_Bi = sum_j d_j * x_j + const
+      for any solution of the equations. The basic bounds cap the left-hand
+      side at sum_i c_i * bound_i, while the nonbasic bounds keep the
+      right-hand side above its current value minus |d_j| times the
+      distance of x_j to its blocking bound. The difference is the margin
+      by which these bounds are infeasible, and the bounds can be loosened
+      by a total of less than the margin (a nonbasic bound by delta counts
+      as |d_j| * delta) while remaining infeasible. This lets conflict
+      analysis attribute them to earlier decisions. When there is no
+      positive margin, the explanation is left empty and the conflict is
+      attributed to all of the decisions.
+    */
+    List<Tightening> bounds;
+    List<double> weights;
+    double margin = 0;
+
+    unsigned m = _tableau->getM();
+    for ( unsigned i = 0; i < m; ++i )
+    {
+        double cost = _costFunctionManager->getBasicCost( i );
+        if ( cost == 0 )
+            continue;
+
+        unsigned variable = _tableau->basicIndexToVariable( i );
+        double value = _tableau->getValue( variable );
+        if ( cost > 0 )
+        {
+            double bound = _tableau->getUpperBound( variable );
+            if ( !FloatUtils::isFinite( bound ) )
+                return;
+            margin += cost * ( value - bound );
+            bounds.append( Tightening( variable, bound, Tightening::UB ) );
+        }
+        else
+        {
+            double bound = _tableau->getLowerBound( variable );
+            if ( !FloatUtils::isFinite( bound ) )
+                return;
+            margin += cost * ( value - bound );
+            bounds.append( Tightening( variable, bound, Tightening::LB ) );
+        }
+        weights.append( FloatUtils::abs( cost ) );
+    }
+
+    // Increasing a nonbasic variable with a negative reduced cost would
+    // decrease the cost, so it is blocked by its upper bound, and vice versa
+    const double *costFunction = _costFunctionManager->getCostFunction();
+    unsigned numNonBasics = _tableau->getN() - m;
+    for ( unsigned i = 0; i < numNonBasics; ++i )
+    {
+        double cost = costFunction[i];
+        if ( cost == 0 )
+            continue;
+
+        unsigned variable = _tableau->nonBasicIndexToVariable( i );
+        double value = _tableau->getValue( variable );
+        if ( cost < 0 )
+        {
+            double bound = _tableau->getUpperBound( variable );
+            if ( !FloatUtils::isFinite( bound ) )
+                return;
+            margin += cost * ( bound - value );
+            bounds.append( Tightening( variable, bound, Tightening::UB ) );
+        }
+        else
+        {
+            double bound = _tableau->getLowerBound( variable );
+            if ( !FloatUtils::isFinite( bound ) )
+                return;
+            margin -= cost * ( value - bound );
+            bounds.append( Tightening( variable, bound, Tightening::LB ) );
+        }
+        weights.append( FloatUtils::abs( cost ) );
+    }
+
+    if ( bounds.empty() || !FloatUtils::isPositive( margin ) )
+        return;
+
+    // Split part of the margin evenly between the bounds, keeping the rest
+    // for round-off errors
+    double slack = GlobalConfiguration::CONFLICT_EXPLANATION_SLACK_RATIO *
+        margin / bounds.size();
+
+    auto weight = weights.begin();
+    for ( auto &bound : bounds )
+    {
+        double delta = slack / *weight;
+        bound._value += ( bound._type == Tightening::UB ) ? delta : -delta;
+        _conflictBounds.append( bound );
+        ++weight;
+    }
+}
+
+bool Engine::resolveConflictWithCDCL()
+{
+    List<Tightening> bounds = _conflictBounds;
+    _conflictBounds.clear();
+
+    /*
+      The row combination behind a simplex failure may use an equation
+      added by a case split. Such an equation is not a bound on the trail,
+      so the bounds alone would not explain the conflict.
+    */
+    bool equationsAdded = _tableau->getM() != _preprocessedQuery->getEquations().size();
+    bool explainedBySimplex = !bounds.empty();
+
+    // Otherwise, look for a variable whose bounds have crossed
+    if ( bounds.empty() )
+    {
+        for ( unsigned i = 0; i < _boundManager.getNumberOfVariables(); ++i )
+        {
+            if ( !_boundManager.consistentBounds( i ) )
+            {
+                bounds.append( Tightening( i, _boundManager.getLowerBound( i ),
+                                           Tightening::LB ) );
+                bounds.append( Tightening( i, _boundManager.getUpperBound( i ),
+                                           Tightening::UB ) );
+                break;
+            }
+        }
+    }
+
+    List<TrailEntry> conflict;
+    if ( bounds.empty() || ( explainedBySimplex && equationsAdded ) )
+        // The infeasibility was derived from all of the current bounds,
+        // e.g. by the network-level reasoner
+        _cdSmtCore.allDecisionsAsConflict( conflict );
+    else
+    {
+        _cdSmtCore.explainBounds( bounds, conflict );
+        _conflictBoundsUnderAnalysis = bounds;
+    }
+
+    _cdSmtCore.resetReportedViolations();
+    bool resolved = _cdSmtCore.resolveConflict( conflict );
+    _conflictBoundsUnderAnalysis.clear();
+    return resolved;
+}
+
+void Engine::reoptimizeWithDualSimplex()
+{
+    MARABOU_TRACE_SPAN( "engine", "dual simplex" );
+
+    // Crossing bounds are detected by the main loop
+    if ( !_tableau->allBoundsValid() || !_tableau->existsBasicOutOfBounds() )
+        return;
+
+    _tableau->resetDualPricingWeights();
+
+    /*
+      All reduced costs are zero, so a dual pivot may push other basic
+      variables further out of bounds. Give up once the sum of
+      infeasibilities has not decreased for a while, rather than cycle
+      until the pivot cap is reached.
+    */
+    double bestInfeasibility = _tableau->getSumOfInfeasibilities();
+    unsigned pivots = 0;
+    unsigned nonImprovingPivots = 0;
+    while ( true )
+    {
+        if ( pivots >= GlobalConfiguration::DUAL_SIMPLEX_MAX_PIVOTS_AFTER_SPLIT )
+        {
+            _statistics.incLongAttribute( Statistics::NUM_DUAL_SIMPLEX_PIVOT_CAP_HITS );
+            break;
+        }
+
+        if ( nonImprovingPivots >= GlobalConfiguration::DUAL_SIMPLEX_MAX_NON_IMPROVING_PIVOTS )
+        {
+            _statistics.incLongAttribute( Statistics::NUM_DUAL_SIMPLEX_STALLS );
+            break;
+        }
+
+        if ( !performDualSimplexStep() )
+            break;
+        ++pivots;
+
+        double infeasibility = _tableau->getSumOfInfeasibilities();
+        if ( FloatUtils::lt( infeasibility, bestInfeasibility ) )
+        {
+            bestInfeasibility = infeasibility;
+            nonImprovingPivots = 0;
+        }
+        else
+            ++nonImprovingPivots;
+    }
+
+    // The basis has changed, and the infeasibilities with it
+    _costFunctionManager->invalidateCostFunction();
+}
+
+bool Engine::performDualSimplexStep()
+{
+    struct timespec start = TimeUtils::sampleMicro();
+
+    bool pivoted = false;
+    if ( _tableau->pickDualLeavingVariable() )
+    {
+        _tableau->computePivotRow();
+        if ( _tableau->pickDualEnteringVariable() )
+        {
+            _tableau->computeChangeColumn();
+
+            // Leave unstable pivots to the primal simplex
+            unsigned leavingIndex = _tableau->getLeavingVariableIndex();
+            if ( FloatUtils::abs( _tableau->getChangeColumn()[leavingIndex] ) >=
+                 GlobalConfiguration::ACCEPTABLE_SIMPLEX_PIVOT_THRESHOLD )
+            {
+                _rowBoundTightener->examinePivotRow();
+                _tableau->updateDualPricingWeights();
+
+                _activeEntryStrategy->prePivotHook( _tableau, false );
+                _tableau->performPivot();
+                _activeEntryStrategy->postPivotHook( _tableau, false );
+
+                _statistics.incLongAttribute( Statistics::NUM_DUAL_SIMPLEX_STEPS );
+                pivoted = true;
+            }
+        }
+    }
+
+    struct timespec end = TimeUtils::sampleMicro();
+    _statistics.incLongAttribute( Statistics::TIME_DUAL_SIMPLEX_STEPS_MICRO,
+                                  TimeUtils::timePassed( start, end ) );
+    return pivoted;
+}
+
 void Engine::fixViolatedPlConstraintIfPossible()
 {
     List<PiecewiseLinearConstraint::Fix> fixes;
@@ -883,6 +1216,7 @@ void Engine::informConstraintsOfInitialBounds( InputQuery &inputQuery ) const
 
 void Engine::invokePreprocessor( const InputQuery &inputQuery, bool preprocess )
 {
+    MARABOU_TRACE_SPAN( "engine", "preprocessing" );
     if ( _verbosity > 0 )
         printf( "Engine::processInputQuery: Input query (before preprocessing): "
                 "%u equations, %u variables\n",
@@ -1285,13 +1619,31 @@ void Engine::initializeBoundsAndConstraintWatchersInTableau( unsigned
 void Engine::initializeNetworkLevelReasoning()
 {
     _networkLevelReasoner = _preprocessedQuery->getNetworkLevelReasoner();
+    _refutationNetwork = nullptr;
 
     if ( _networkLevelReasoner )
+    {
         _networkLevelReasoner->setTableau( _tableau );
+        _networkLevelReasoner->setNumberOfDeepPolyThreads( _numberOfDeepPolyThreads );
+    }
+
+    updateNetworkMemoryStatistics();
+}
+
+void Engine::updateNetworkMemoryStatistics()
+{
+    if ( !_networkLevelReasoner )
+        return;
+
+    _statistics.setLongAttribute( Statistics::NETWORK_PARAMETERS_MEMORY_BYTES,
+                                  _networkLevelReasoner->getParametersMemoryInBytes() );
+    _statistics.setLongAttribute( Statistics::SHARED_NETWORK_PARAMETERS_MEMORY_BYTES,
+                                  _networkLevelReasoner->getSharedParametersMemoryInBytes() );
 }
 
 bool Engine::processInputQuery( InputQuery &inputQuery, bool preprocess )
 {
+    MARABOU_TRACE_SPAN( "engine", "process input query" );
     ENGINE_LOG( "processInputQuery starting\n" );
     struct timespec start = TimeUtils::sampleMicro();
 
@@ -1425,12 +1777,13 @@ bool Engine::processInputQuery( InputQuery &inputQuery, bool preprocess )
         });
 
     _smtCore.storeDebuggingSolution( _preprocessedQuery->_debuggingSolution );
+    _cdSmtCore.storeDebuggingSolution( _preprocessedQuery->_debuggingSolution );
     return true;
 }
 
 void Engine::performMILPSolverBoundedTightening( InputQuery *inputQuery )
 {
-    if ( _networkLevelReasoner && Options::get()->gurobiEnabled() )
+    if ( _networkLevelReasoner )
     {
 	// Obtain from and store bounds into inputquery if it is not null.
         if ( inputQuery )
@@ -1448,6 +1801,7 @@ void Engine::performMILPSolverBoundedTightening( InputQuery *inputQuery )
         {
         case MILPSolverBoundTighteningType::LP_RELAXATION:
         case MILPSolverBoundTighteningType::LP_RELAXATION_INCREMENTAL:
+        case MILPSolverBoundTighteningType::LP_RELAXATION_WARM_START:
             _networkLevelReasoner->lpRelaxationPropagation();
             break;
 
@@ -1500,7 +1854,7 @@ void Engine::performMILPSolverBoundedTightening( InputQuery *inputQuery )
 
 void Engine::performMILPSolverBoundedTighteningForSingleLayer( unsigned targetIndex )
 {
-    if ( _networkLevelReasoner && _isGurobyEnabled && !_performLpTighteningAfterSplit
+    if ( _networkLevelReasoner && !_performLpTighteningAfterSplit
             && _milpSolverBoundTighteningType != MILPSolverBoundTighteningType::NONE )
     {
         _networkLevelReasoner->obtainCurrentBounds();
@@ -1509,6 +1863,7 @@ void Engine::performMILPSolverBoundedTighteningForSingleLayer( unsigned targetIn
         switch ( _milpSolverBoundTighteningType )
         {
         case MILPSolverBoundTighteningType::LP_RELAXATION:
+        case MILPSolverBoundTighteningType::LP_RELAXATION_WARM_START:
             _networkLevelReasoner->LPTighteningForOneLayer( targetIndex );
             break;
         case MILPSolverBoundTighteningType::LP_RELAXATION_INCREMENTAL:
@@ -1612,14 +1967,20 @@ void Engine::selectViolatedPlConstraint()
 {
     ASSERT( !_violatedPlConstraints.empty() );
 
-    _plConstraintToFix = _smtCore.chooseViolatedConstraintForFixing( _violatedPlConstraints );
+    if ( _solveWithCDCL )
+        _plConstraintToFix = _cdSmtCore.chooseViolatedConstraintForFixing( _violatedPlConstraints );
+    else
+        _plConstraintToFix = _smtCore.chooseViolatedConstraintForFixing( _violatedPlConstraints );
 
     ASSERT( _plConstraintToFix );
 }
 
 void Engine::reportPlViolation()
 {
-    _smtCore.reportViolatedConstraint( _plConstraintToFix );
+    if ( _solveWithCDCL )
+        _cdSmtCore.reportViolatedConstraint( _plConstraintToFix );
+    else
+        _smtCore.reportViolatedConstraint( _plConstraintToFix );
 }
 
 void Engine::storeState( EngineState &state, TableauStateStorageLevel level ) const
@@ -1635,6 +1996,7 @@ void Engine::storeState( EngineState &state, TableauStateStorageLevel level ) co
 
 void Engine::restoreState( const EngineState &state )
 {
+    MARABOU_TRACE_SPAN( "engine", "restore state" );
     ENGINE_LOG( "Restore state starting" );
 
     if ( state._tableauStateStorageLevel == TableauStateStorageLevel::STORE_NONE )
@@ -1673,6 +2035,25 @@ void Engine::setNumPlConstraintsDisabledByValidSplits( unsigned numConstraints )
     _numPlConstraintsDisabledByValidSplits = numConstraints;
 }
 
+bool Engine::searchStateIsContextDependent() const
+{
+    return _searchStateIsContextDependent;
+}
+
+void Engine::initializeContextDependentSearchState()
+{
+    for ( const auto &constraint : _plConstraints )
+        if ( !constraint->supportsContextDependentState() )
+            return;
+
+    // The engine may solve several queries, e.g. in DnC mode
+    for ( const auto &constraint : _plConstraints )
+        if ( constraint->getContext() == nullptr )
+            constraint->initializeCDOs( &_context );
+
+    _searchStateIsContextDependent = true;
+}
+
 bool Engine::attemptToMergeVariables( unsigned x1, unsigned x2 )
 {
     /*
@@ -1770,6 +2151,7 @@ bool Engine::attemptToMergeVariables( unsigned x1, unsigned x2 )
 
 void Engine::applySplit( const PiecewiseLinearCaseSplit &split )
 {
+    MARABOU_TRACE_SPAN( "engine", "apply split" );
     ENGINE_LOG( "" );
     ENGINE_LOG( "Applying a split. " );
 
@@ -1959,12 +2341,19 @@ bool Engine::applyValidConstraintCaseSplit( PiecewiseLinearConstraint *constrain
                              constraintString.ascii() ).ascii() );
 
         constraint->setActiveConstraint( false );
-        PiecewiseLinearCaseSplit validSplit = constraint->getValidCaseSplit();
-        _smtCore.recordImpliedValidSplit( validSplit );
-        applySplit( validSplit );
+        // The context undoes valid splits for the CDSmtCore, which records
+        // the fixed phase on its trail for conflict analysis
+        if ( _solveWithCDCL )
+            _cdSmtCore.pushBoundImplication( constraint );
+        else
+        {
+            PiecewiseLinearCaseSplit validSplit = constraint->getValidCaseSplit();
+            _smtCore.recordImpliedValidSplit( validSplit );
+            applySplit( validSplit );
+        }
         if ( _soiManager )
             _soiManager->removeCostComponentFromHeuristicCost( constraint );
-        ++_numPlConstraintsDisabledByValidSplits;
+        _numPlConstraintsDisabledByValidSplits = _numPlConstraintsDisabledByValidSplits + 1;
 
         return true;
     }
@@ -2006,6 +2395,7 @@ bool Engine::highDegradation()
 
 void Engine::tightenBoundsOnConstraintMatrix()
 {
+    MARABOU_TRACE_SPAN( "engine", "constraint matrix tightening" );
     struct timespec start = TimeUtils::sampleMicro();
 
     if ( _statistics.getLongAttribute( Statistics::NUM_MAIN_LOOP_ITERATIONS ) %
@@ -2024,6 +2414,7 @@ void Engine::tightenBoundsOnConstraintMatrix()
 
 void Engine::explicitBasisBoundTightening()
 {
+    MARABOU_TRACE_SPAN( "engine", "explicit basis tightening" );
     struct timespec start = TimeUtils::sampleMicro();
 
     bool saturation = GlobalConfiguration::EXPLICIT_BOUND_TIGHTENING_UNTIL_SATURATION;
@@ -2052,6 +2443,7 @@ void Engine::explicitBasisBoundTightening()
 
 void Engine::performPrecisionRestoration( PrecisionRestorer::RestoreBasics restoreBasics )
 {
+    MARABOU_TRACE_SPAN( "engine", "precision restoration" );
     struct timespec start = TimeUtils::sampleMicro();
 
     // debug
@@ -2207,6 +2599,7 @@ void Engine::performSimulation()
 
 void Engine::performSymbolicBoundTightening( InputQuery *inputQuery )
 {
+    MARABOU_TRACE_SPAN( "engine", "symbolic bound tightening" );
     if ( _symbolicBoundTighteningType == SymbolicBoundTighteningType::NONE ||
          ( !_networkLevelReasoner ) )
         return;
@@ -2322,6 +2715,176 @@ void Engine::postContextPopHook()
     _statistics.incLongAttribute( Statistics::TIME_CONTEXT_POP_HOOK, TimeUtils::timePassed( start, end ) );
 }
 
+unsigned Engine::getBoundLevel( unsigned variable, Tightening::BoundType type,
+                               double value ) const
+{
+    return _boundManager.getBoundLevel( variable, type, value );
+}
+
+double Engine::getLowerBound( unsigned variable ) const
+{
+    return _boundManager.getLowerBound( variable );
+}
+
+double Engine::getUpperBound( unsigned variable ) const
+{
+    return _boundManager.getUpperBound( variable );
+}
+
+bool Engine::caseSplitsAreInfeasible( unsigned level,
+                                      const List<PiecewiseLinearCaseSplit> &splits )
+{
+    MARABOU_TRACE_SPAN( "engine", "refute case splits" );
+    unsigned numberOfVariables = _boundManager.getNumberOfVariables();
+    Vector<double> lowerBounds( numberOfVariables );
+    Vector<double> upperBounds( numberOfVariables );
+    _boundManager.getBoundsAtLevel( level, lowerBounds.data(), upperBounds.data() );
+
+    // Equations of the splits are ignored, which only weakens the check
+    for ( const auto &split : splits )
+        for ( const auto &tightening : split.getBoundTightenings() )
+            tightenRefutationBound( tightening, lowerBounds, upperBounds );
+
+    bool useNetwork = _networkLevelReasoner &&
+        ( _symbolicBoundTighteningType == SymbolicBoundTighteningType::SYMBOLIC_BOUND_TIGHTENING ||
+          _symbolicBoundTighteningType == SymbolicBoundTighteningType::DEEP_POLY );
+
+    for ( unsigned round = 0; round < GlobalConfiguration::CONFLICT_REFUTATION_ROUNDS; ++round )
+    {
+        if ( refutationBoundsCross( lowerBounds, upperBounds ) ||
+             refutationBoundsImplyConflict( lowerBounds, upperBounds ) )
+            return true;
+
+        for ( const auto &equation : _preprocessedQuery->getEquations() )
+            propagateRefutationBounds( equation, lowerBounds, upperBounds );
+
+        if ( !useNetwork || refutationBoundsCross( lowerBounds, upperBounds ) ||
+             refutationBoundsImplyConflict( lowerBounds, upperBounds ) )
+            continue;
+
+        if ( !_refutationNetwork )
+        {
+            _refutationNetwork = std::unique_ptr<NLR::NetworkLevelReasoner>
+                ( new NLR::NetworkLevelReasoner );
+            _networkLevelReasoner->storeIntoOther( *_refutationNetwork );
+            _refutationNetwork->setNumberOfDeepPolyThreads( _numberOfDeepPolyThreads );
+        }
+
+        _refutationNetwork->obtainCurrentBounds( lowerBounds.data(), upperBounds.data() );
+        _refutationNetwork->clearConstraintTightenings();
+        if ( _symbolicBoundTighteningType ==
+             SymbolicBoundTighteningType::SYMBOLIC_BOUND_TIGHTENING )
+            _refutationNetwork->symbolicBoundPropagation();
+        else
+            _refutationNetwork->deepPolyPropagation();
+
+        List<Tightening> tightenings;
+        _refutationNetwork->getConstraintTightenings( tightenings );
+        for ( const auto &tightening : tightenings )
+            tightenRefutationBound( tightening, lowerBounds, upperBounds );
+    }
+
+    return refutationBoundsCross( lowerBounds, upperBounds ) ||
+        refutationBoundsImplyConflict( lowerBounds, upperBounds );
+}
+
+void Engine::tightenRefutationBound( const Tightening &tightening,
+                                     Vector<double> &lowerBounds,
+                                     Vector<double> &upperBounds ) const
+{
+    unsigned variable = tightening._variable;
+    if ( tightening._type == Tightening::LB )
+    {
+        if ( tightening._value > lowerBounds[variable] )
+            lowerBounds[variable] = tightening._value;
+    }
+    else if ( tightening._value < upperBounds[variable] )
+        upperBounds[variable] = tightening._value;
+}
+
+void Engine::propagateRefutationBounds( const Equation &equation,
+                                        Vector<double> &lowerBounds,
+                                        Vector<double> &upperBounds ) const
+{
+    // Both sides of an equality bound each other
+    if ( equation._type != Equation::GE )
+        propagateRefutationBounds( equation, 1, lowerBounds, upperBounds );
+    if ( equation._type != Equation::LE )
+        propagateRefutationBounds( equation, -1, lowerBounds, upperBounds );
+}
+
+void Engine::propagateRefutationBounds( const Equation &equation, double sign,
+                                        Vector<double> &lowerBounds,
+                                        Vector<double> &upperBounds ) const
+{
+    /*
+      The equation is sign * sum a_i x_i <= sign * scalar, so each term is
+      bounded from above by the scalar minus the minima of the other terms.
+    */
+    double finiteMinimum = 0;
+    unsigned numInfiniteMinima = 0;
+    for ( const auto &addend : equation._addends )
+    {
+        double coefficient = sign * addend._coefficient;
+        double bound = coefficient > 0 ? lowerBounds[addend._variable]
+            : upperBounds[addend._variable];
+        if ( !FloatUtils::isFinite( bound ) )
+            ++numInfiniteMinima;
+        else
+            finiteMinimum += coefficient * bound;
+    }
+
+    if ( numInfiniteMinima > 1 )
+        return;
+
+    for ( const auto &addend : equation._addends )
+    {
+        double coefficient = sign * addend._coefficient;
+        if ( FloatUtils::isZero( coefficient ) )
+            continue;
+
+        double bound = coefficient > 0 ? lowerBounds[addend._variable]
+            : upperBounds[addend._variable];
+        double othersMinimum;
+        if ( !FloatUtils::isFinite( bound ) )
+            othersMinimum = finiteMinimum;
+        else if ( numInfiniteMinima == 0 )
+            othersMinimum = finiteMinimum - coefficient * bound;
+        else
+            continue;
+
+        double value = ( sign * equation._scalar - othersMinimum ) / coefficient;
+        tightenRefutationBound( Tightening( addend._variable, value,
+                                            coefficient > 0 ? Tightening::UB : Tightening::LB ),
+                                lowerBounds, upperBounds );
+    }
+}
+
+bool Engine::refutationBoundsCross( const Vector<double> &lowerBounds,
+                                    const Vector<double> &upperBounds ) const
+{
+    for ( unsigned i = 0; i < lowerBounds.size(); ++i )
+        if ( lowerBounds[i] > upperBounds[i] + GlobalConfiguration::CONFLICT_REFUTATION_TOLERANCE )
+            return true;
+    return false;
+}
+
+bool Engine::refutationBoundsImplyConflict( const Vector<double> &lowerBounds,
+                                            const Vector<double> &upperBounds ) const
+{
+    if ( _conflictBoundsUnderAnalysis.empty() )
+        return false;
+
+    for ( const auto &bound : _conflictBoundsUnderAnalysis )
+    {
+        if ( bound._type == Tightening::LB ?
+             lowerBounds[bound._variable] < bound._value :
+             upperBounds[bound._variable] > bound._value )
+            return false;
+    }
+    return true;
+}
+
 void Engine::reset()
 {
     resetStatistics();
@@ -2336,6 +2899,7 @@ void Engine::resetStatistics()
     Statistics statistics;
     _statistics = statistics;
     _smtCore.setStatistics( &_statistics );
+    _cdSmtCore.setStatistics( &_statistics );
     _tableau->setStatistics( &_statistics );
     _rowBoundTightener->setStatistics( &_statistics );
     _preprocessor.setStatistics( &_statistics );
@@ -2354,6 +2918,15 @@ void Engine::resetSmtCore()
 {
     _smtCore.reset();
     _smtCore.initializeScoreTrackerIfNeeded( _plConstraints );
+    _cdSmtCore.reset();
+    clearIntervalSplitsForCDCL();
+}
+
+void Engine::clearIntervalSplitsForCDCL()
+{
+    for ( auto &disjunction : _intervalSplitsForCDCL )
+        delete disjunction;
+    _intervalSplitsForCDCL.clear();
 }
 
 void Engine::resetExitCode()
@@ -2459,7 +3032,14 @@ void Engine::updateDirections()
 void Engine::decideBranchingHeuristics()
 {
     DivideStrategy divideStrategy = Options::get()->getDivideStrategy();
-    if ( divideStrategy == DivideStrategy::Auto )
+    if ( _solveWithCDCL && divideStrategy == DivideStrategy::PseudoImpact )
+    {
+        // Pseudo impact requires DeepSoI, which CDCL turns off
+        divideStrategy = DivideStrategy::ReLUViolation;
+        if ( _verbosity >= 2 )
+            printf("Branching heuristics set to ReLUViolation for CDCL\n");
+    }
+    else if ( divideStrategy == DivideStrategy::Auto )
     {
         if ( _preprocessedQuery->getInputVariables().size() <
              GlobalConfiguration::INTERVAL_SPLITTING_THRESHOLD )
@@ -2487,6 +3067,7 @@ void Engine::decideBranchingHeuristics()
     ASSERT( divideStrategy != DivideStrategy::Auto );
     _smtCore.setBranchingHeuristics( divideStrategy );
     _smtCore.initializeScoreTrackerIfNeeded( _plConstraints );
+    _cdSmtCore.setBranchingHeuristics( divideStrategy );
 }
 
 PiecewiseLinearConstraint *Engine::pickSplitPLConstraintBasedOnPolarity()
@@ -2576,6 +3157,15 @@ PiecewiseLinearConstraint *Engine::pickSplitPLConstraintBasedOnIntervalWidth()
         List<PiecewiseLinearCaseSplit> splits;
         splits.append( s1 );
         splits.append( s2 );
+        if ( _solveWithCDCL )
+        {
+            // Learned clauses may refer to the split after it is undone
+            DisjunctionConstraint *disjunction = new DisjunctionConstraint( splits );
+            disjunction->initializeCDOs( &_context );
+            _intervalSplitsForCDCL.append( disjunction );
+            return disjunction;
+        }
+
         _disjunctionForSplitting = std::unique_ptr<DisjunctionConstraint>
             ( new DisjunctionConstraint( splits ) );
         return _disjunctionForSplitting.get();
@@ -2587,10 +3177,13 @@ PiecewiseLinearConstraint *Engine::pickSplitPLConstraint( DivideStrategy
 {
     ENGINE_LOG( Stringf( "Picking a split PLConstraint..." ).ascii() );
 
+    unsigned depth = _solveWithCDCL ?
+        _cdSmtCore.getDecisionLevel() : _smtCore.getStackDepth();
+
     PiecewiseLinearConstraint *candidatePLConstraint = NULL;
     if ( strategy == DivideStrategy::PseudoImpact )
     {
-        if ( _smtCore.getStackDepth() > 3 )
+        if ( depth > 3 )
             candidatePLConstraint = _smtCore.getConstraintsWithHighestScore();
         else if ( _preprocessedQuery->getInputVariables().size() <
                   GlobalConfiguration::INTERVAL_SPLITTING_THRESHOLD )
@@ -2603,8 +3196,7 @@ PiecewiseLinearConstraint *Engine::pickSplitPLConstraint( DivideStrategy
     else if ( strategy == DivideStrategy::EarliestReLU )
         candidatePLConstraint = pickSplitPLConstraintBasedOnTopology();
     else if ( strategy == DivideStrategy::LargestInterval &&
-              ( _smtCore.getStackDepth() %
-                GlobalConfiguration::INTERVAL_SPLITTING_FREQUENCY == 0 )
+              ( depth % GlobalConfiguration::INTERVAL_SPLITTING_FREQUENCY == 0 )
               )
     {
         // Conduct interval splitting periodically.
@@ -2755,7 +3347,7 @@ bool Engine::solveWithMILPEncoding( unsigned timeoutInSeconds )
 void Engine::extractSolutionFromGurobi( InputQuery &inputQuery )
 {
     ASSERT( _gurobi != nullptr );
-    Map<String, double> assignment;
+    Map<unsigned, double> assignment;
     double costOrObjective;
     _gurobi->extractSolution( assignment, costOrObjective );
 
@@ -2782,13 +3374,11 @@ void Engine::extractSolutionFromGurobi( InputQuery &inputQuery )
             variable = _preprocessor.getNewIndex( variable );
 
             // Finally, set the assigned value
-            String variableName = _milpEncoder->getVariableNameFromVariable( variable );
-            inputQuery.setSolutionValue( i, assignment[variableName] );
+            inputQuery.setSolutionValue( i, assignment[variable] );
         }
         else
         {
-            String variableName = _milpEncoder->getVariableNameFromVariable( i );
-            inputQuery.setSolutionValue( i, assignment[variableName] );
+            inputQuery.setSolutionValue( i, assignment[i] );
         }
     }
 }
@@ -2805,6 +3395,7 @@ const Preprocessor *Engine::getPreprocessor()
 
 bool Engine::performDeepSoILocalSearch()
 {
+    MARABOU_TRACE_SPAN( "engine", "deepsoi local search" );
     ENGINE_LOG( "Performing local search..." );
     struct timespec start = TimeUtils::sampleMicro();
     ASSERT( allVarsWithinBounds() );
@@ -3016,9 +3607,8 @@ void Engine::informLPSolverOfBounds()
         struct timespec start = TimeUtils::sampleMicro();
         for ( unsigned i = 0; i < _preprocessedQuery->getNumberOfVariables(); ++i )
         {
-            String variableName = _milpEncoder->getVariableNameFromVariable( i );
-            _gurobi->setLowerBound( variableName, _tableau->getLowerBound( i ) );
-            _gurobi->setUpperBound( variableName, _tableau->getUpperBound( i ) );
+            _gurobi->setLowerBound( i, _tableau->getLowerBound( i ) );
+            _gurobi->setUpperBound( i, _tableau->getUpperBound( i ) );
         }
         _gurobi->updateModel();
         struct timespec end = TimeUtils::sampleMicro();
@@ -3068,8 +3658,7 @@ void Engine::checkGurobiBoundConsistency() const
     {
         for ( unsigned i = 0; i < _preprocessedQuery->getNumberOfVariables(); ++i )
         {
-            String iName = _milpEncoder->getVariableNameFromVariable( i );
-            double gurobiLowerBound = _gurobi->getLowerBound( iName );
+            double gurobiLowerBound = _gurobi->getLowerBound( i );
             double lowerBound = _tableau->getLowerBound( i );
             if ( !FloatUtils::areEqual( gurobiLowerBound, lowerBound ) )
             {
@@ -3079,7 +3668,7 @@ void Engine::checkGurobiBoundConsistency() const
                                " Gurobi: %f, Tableau: %f",
                                i, gurobiLowerBound, lowerBound ).ascii() );
             }
-            double gurobiUpperBound = _gurobi->getUpperBound( iName );
+            double gurobiUpperBound = _gurobi->getUpperBound( i );
             double upperBound = _tableau->getUpperBound( i );
 
             if ( !FloatUtils::areEqual( gurobiUpperBound, upperBound ) )
@@ -20,8 +20,10 @@
 #include "AutoProjectedSteepestEdge.h"
 #include "AutoRowBoundTightener.h"
 #include "AutoTableau.h"
+#include "Bitset.h"
 #include "BlandsRule.h"
 #include "BoundManager.h"
+#include "CDSmtCore.h"
 #include "DantzigsRule.h"
 #include "DegradationChecker.h"
 #include "DivideStrategy.h"
@@ -33,7 +35,9 @@
 #include "LPSolverType.h"
 #include "Map.h"
 #include "MILPEncoder.h"
+#include "MultiplePricingRule.h"
 #include "Options.h"
+#include "PartialPricingRule.h"
 #include "PrecisionRestorer.h"
 #include "Preprocessor.h"
 #include "SignalHandler.h"
@@ -111,6 +115,12 @@ public:
     void restoreState( const EngineState &state );
     void setNumPlConstraintsDisabledByValidSplits( unsigned numConstraints );
 
+    /*
+      Return true iff backtracking the context restores the entire search
+      state of the engine, so that no snapshots are needed when splitting.
+    */
+    bool searchStateIsContextDependent() const;
+
     /*
       Preprocessor access.
     */
@@ -154,6 +164,30 @@ public:
     void postContextPopHook();
     void preContextPushHook();
 
+    /*
+      The lowest decision level at which the bound of a variable was at
+      least as tight as the given value.
+    */
+    unsigned getBoundLevel( unsigned variable, Tightening::BoundType type,
+                            double value ) const;
+
+    /*
+      The current bounds of a variable.
+    */
+    double getLowerBound( unsigned variable ) const;
+    double getUpperBound( unsigned variable ) const;
+
+    /*
+      Return true if the case splits, applied together to the bounds that
+      held at the given decision level, are refuted by a few rounds of bound propagation
+      over the equations of the preprocessed query and symbolic bound
+      tightening over a copy of the network: either the bounds of some
+      variable cross, or they imply the bounds of the conflict under
+      analysis. False means that the check was inconclusive.
+    */
+    bool caseSplitsAreInfeasible( unsigned level,
+                                  const List<PiecewiseLinearCaseSplit> &splits );
+
     /*
       Reset the state of the engine, before solving a new query
       (as part of DnC mode).
@@ -175,6 +209,12 @@ public:
     */
     void setVerbosity( unsigned verbosity );
 
+    /*
+      Set the number of threads that back-substitute DeepPoly bounds.
+      0 means the NUM_WORKERS option is used.
+    */
+    void setNumberOfDeepPolyThreads( unsigned numberOfThreads );
+
     /*
       Apply the stack to the newly created SmtCore, returns false if UNSAT is
       found in this process.
@@ -303,6 +343,8 @@ private:
     */
     BlandsRule _blandsRule;
     DantzigsRule _dantzigsRule;
+    PartialPricingRule _partialPricingRule;
+    MultiplePricingRule _multiplePricingRule;
     AutoProjectedSteepestEdgeRule _projectedSteepestEdgeRule;
     EntrySelectionStrategy *_activeEntryStrategy;
 
@@ -316,10 +358,22 @@ private:
     */
     SmtCore _smtCore;
 
+    /*
+      The conflict-driven SMT engine, which replaces the SmtCore when
+      solving with CDCL.
+    */
+    CDSmtCore _cdSmtCore;
+
     /*
       Number of pl constraints disabled by valid splits.
     */
-    unsigned _numPlConstraintsDisabledByValidSplits;
+    CVC4::context::CDO<unsigned> _numPlConstraintsDisabledByValidSplits;
+
+    /*
+      True iff the PL constraints keep their search state in
+      context-dependent objects. See initializeContextDependentSearchState().
+    */
+    bool _searchStateIsContextDependent;
 
     /*
       Degradation checker.
@@ -346,6 +400,14 @@ private:
     */
     double *_work;
 
+    /*
+      Pricing buffers for the simplex step (of size n-m): the indices
+      of the non-basic variables eligible for entry, and the ones that
+      were already tried and rejected in the current step.
+    */
+    unsigned *_enteringVariableCandidates;
+    Bitset _excludedEnteringVariables;
+
     /*
       Restoration status.
     */
@@ -394,6 +456,11 @@ private:
     */
     unsigned _verbosity;
 
+    /*
+      Number of threads used by DeepPoly, 0 for NUM_WORKERS
+    */
+    unsigned _numberOfDeepPolyThreads;
+
     /*
       Records for checking whether the solution process is, overall,
       making progress. _lastNumVisitedStates stores the previous number
@@ -414,11 +481,44 @@ private:
     */
     std::unique_ptr<PiecewiseLinearConstraint> _disjunctionForSplitting;
 
+    /*
+      Under CDCL, the disjunctions of the interval splits made so far. The
+      learned clauses may refer to them, so they are kept, with their search
+      state in the context, until the search is reset.
+    */
+    List<PiecewiseLinearConstraint *> _intervalSplitsForCDCL;
+
     /*
       Solve the query with MILP encoding
     */
     bool _solveWithMILP;
 
+    /*
+      Drive the search with the CDSmtCore, learning conflict clauses and
+      backjumping non-chronologically
+    */
+    bool _solveWithCDCL;
+
+    /*
+      Bounds that explain the most recent simplex failure, consumed by
+      conflict analysis
+    */
+    List<Tightening> _conflictBounds;
+
+    /*
+      A copy of the network-level reasoner on which case splits are
+      refuted during conflict analysis, leaving the bounds of the search
+      intact
+    */
+    std::unique_ptr<NLR::NetworkLevelReasoner> _refutationNetwork;
+
+    /*
+      The bounds of the conflict under analysis, which cannot hold
+      simultaneously. Case splits whose propagated bounds imply all of
+      them are refuted as well.
+    */
+    List<Tightening> _conflictBoundsUnderAnalysis;
+
     /*
       The solver to solve the LP during the complete search.
     */
@@ -445,8 +545,8 @@ private:
       there is a chance that multiple Engine object be accessing the Options object.
     */
     unsigned _simulationSize;
-    bool _isGurobyEnabled;
     bool _performLpTighteningAfterSplit;
+    bool _dualSimplexAfterSplit;
     MILPSolverBoundTighteningType _milpSolverBoundTighteningType;
 
     /*
@@ -475,6 +575,60 @@ private:
     */
     bool performSimplexStep();
 
+    /*
+      The simplex failed to reduce a fresh phase-one cost function.
+      Record in _conflictBounds the bounds of the out-of-bounds basic
+      variables and the bounds that block the nonbasic variables, which
+      together are infeasible.
+    */
+    void explainSimplexFailure();
+
+    /*
+      Analyze the conflict that made the current subproblem infeasible,
+      learn a clause and backjump. Return false if the conflict does not
+      depend on any decision, i.e. the query is unsat.
+    */
+    bool resolveConflictWithCDCL();
+
+    /*
+      Helpers for caseSplitsAreInfeasible: tighten the given bounds with
+      a tightening, with the bounds implied by an equation, or return
+      whether the bounds of some variable cross or the bounds imply those
+      of the conflict under analysis.
+    */
+    void tightenRefutationBound( const Tightening &tightening,
+                                 Vector<double> &lowerBounds,
+                                 Vector<double> &upperBounds ) const;
+    void propagateRefutationBounds( const Equation &equation,
+                                    Vector<double> &lowerBounds,
+                                    Vector<double> &upperBounds ) const;
+    void propagateRefutationBounds( const Equation &equation, double sign,
+                                    Vector<double> &lowerBounds,
+                                    Vector<double> &upperBounds ) const;
+    bool refutationBoundsCross( const Vector<double> &lowerBounds,
+                                const Vector<double> &upperBounds ) const;
+    bool refutationBoundsImplyConflict( const Vector<double> &lowerBounds,
+                                        const Vector<double> &upperBounds ) const;
+
+    /*
+      After a case split the tightened bounds typically leave some basic
+      variables out of bounds. Try to restore feasibility with at most
+      DUAL_SIMPLEX_MAX_PIVOTS_AFTER_SPLIT dual simplex steps, stopping
+      early once DUAL_SIMPLEX_MAX_NON_IMPROVING_PIVOTS consecutive steps
+      fail to decrease the sum of infeasibilities. Any remaining
+      infeasibility is left to the primal simplex. Only done with
+      --dual-simplex: every reduced cost is zero, so these pivots are a
+      heuristic repair rather than a dual phase.
+    */
+    void reoptimizeWithDualSimplex();
+
+    /*
+      Perform a single dual simplex step: pick a leaving basic variable
+      that is out of bounds, an entering variable from its row, and
+      pivot. Return false if no such step could be found.
+    */
+    bool performDualSimplexStep();
+
     /*
       Perform a constraint-fixing step: select a violated piece-wise
       linear constraint and attempt to fix it.
@@ -574,6 +728,14 @@ private:
     */
     void adjustWorkMemorySize();
 
+    /*
+      If every PL constraint supports it, initialize the constraints'
+      context-dependent objects, so that the SMT core can rely on context
+      push/pop for bounds, phases and the basis instead of storing engine
+      states on every split.
+    */
+    void initializeContextDependentSearchState();
+
     /*
       Store the original engine state within the precision restorer.
       Restore the tableau from the original version.
@@ -643,6 +805,12 @@ private:
     void initializeNetworkLevelReasoning();
     double *createConstraintMatrix();
     void addAuxiliaryVariables();
+
+    /*
+      Record how much of the network's weights and biases this engine
+      holds, and how much of it is shared with other engines
+    */
+    void updateNetworkMemoryStatistics();
     void augmentInitialBasisIfNeeded( List<unsigned> &initialBasis, const List<unsigned> &basicRows );
     void performMILPSolverBoundedTightening( InputQuery *inputQuery = nullptr );
 
@@ -678,6 +846,11 @@ private:
     */
     PiecewiseLinearConstraint *pickSplitPLConstraintBasedOnIntervalWidth();
 
+    /*
+      Delete the interval splits kept for CDCL
+    */
+    void clearIntervalSplitsForCDCL();
+
     /*
       Solve the input query with a MILP solver (Gurobi)
     */
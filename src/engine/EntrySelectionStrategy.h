@@ -16,8 +16,7 @@
 #ifndef __EntrySelectionStrategy_h__
 #define __EntrySelectionStrategy_h__
 
-#include "List.h"
-#include "Set.h"
+#include "Bitset.h"
 
 class ITableau;
 class Statistics;
@@ -35,12 +34,25 @@ public:
     virtual void initialize( const ITableau & /* tableau */ ) {};
 
     /*
-      Choose the entrying variable for the given tableau. Do not pick
-      a variable from the excluded set.
+      Choose the entrying variable for the given tableau, out of the
+      first numberOfCandidates non-basic indices in candidates. Do not
+      pick an index that is marked in the excluded bitset.
     */
     virtual bool select( ITableau &tableau,
-                         const List<unsigned> &candidates,
-                         const Set<unsigned> &excluded ) = 0;
+                         const unsigned *candidates,
+                         unsigned numberOfCandidates,
+                         const Bitset &excluded ) = 0;
+
+    /*
+      Whether select() needs the engine to collect all eligible
+      candidates first. Strategies that only price a subset of the
+      non-basic variables return false and look for eligible
+      variables themselves; they are then passed no candidates.
+    */
+    virtual bool requiresEntryCandidates() const
+    {
+        return true;
+    }
 
     /*
       This hook gets called after the entering and leaving variables
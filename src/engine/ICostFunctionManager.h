@@ -47,6 +47,7 @@ public:
                                                const double *changeColumn ) = 0;
     virtual double getBasicCost( unsigned basicIndex ) const = 0;
     virtual void adjustBasicCostAccuracy() = 0;
+    virtual void setRecheckAdjustedCostFunction( bool recheck ) = 0;
 
     virtual bool costFunctionInvalid() const = 0;
     virtual bool costFunctionJustComputed() const = 0;
@@ -19,6 +19,7 @@
 #include "DivideStrategy.h"
 #include "SnCDivideStrategy.h"
 #include "TableauStateStorageLevel.h"
+#include "Tightening.h"
 #include "List.h"
 #include "context/context.h"
 
@@ -72,6 +73,13 @@ public:
     virtual void restoreState( const EngineState &state ) = 0;
     virtual void setNumPlConstraintsDisabledByValidSplits( unsigned numConstraints ) = 0;
 
+    /*
+      Return true iff backtracking the context restores the entire search
+      state of the engine, in which case the SMT core does not store the
+      engine state when splitting.
+    */
+    virtual bool searchStateIsContextDependent() const = 0;
+
     /*
       Store the current stack of the smtCore into smtState
     */
@@ -121,6 +129,28 @@ public:
     virtual CVC4::context::Context &getContext() = 0;
 
     virtual bool consistentBounds() const = 0;
+
+    /*
+      The lowest decision level at which the bound of a variable was at
+      least as tight as the given value.
+    */
+    virtual unsigned getBoundLevel( unsigned variable,
+                                    Tightening::BoundType type,
+                                    double value ) const = 0;
+
+    /*
+      The current bounds of a variable.
+    */
+    virtual double getLowerBound( unsigned variable ) const = 0;
+    virtual double getUpperBound( unsigned variable ) const = 0;
+
+    /*
+      Return true if the given case splits, applied together to the bounds
+      that held at the given decision level, are refuted by bound
+      propagation. False means that the check was inconclusive.
+    */
+    virtual bool caseSplitsAreInfeasible( unsigned level,
+                                          const List<PiecewiseLinearCaseSplit> &splits ) = 0;
 };
 
 #endif // __IEngine_h__
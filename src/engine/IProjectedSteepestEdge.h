@@ -17,7 +17,6 @@
 #define __IProjectedSteepestEdge_h__
 
 #include "EntrySelectionStrategy.h"
-#include "Set.h"
 
 class String;
 class ITableau;
@@ -36,8 +35,9 @@ public:
       Apply the projected steepest edge pivot selection rule.
     */
     virtual bool select( ITableau &tableau,
-                         const List<unsigned> &candidates,
-                         const Set<unsigned> &excluded ) = 0;
+                         const unsigned *candidates,
+                         unsigned numberOfCandidates,
+                         const Bitset &excluded ) = 0;
 
     /*
       We use this hook to update gamma according to the entering
@@ -129,13 +129,17 @@ public:
     virtual unsigned getLeavingVariableIndex() const = 0;
     virtual double getChangeRatio() const = 0;
     virtual void setChangeRatio( double changeRatio ) = 0;
+    virtual void resetDualPricingWeights() = 0;
+    virtual bool pickDualLeavingVariable() = 0;
+    virtual bool pickDualEnteringVariable() = 0;
+    virtual void updateDualPricingWeights() = 0;
     virtual bool performingFakePivot() const = 0;
     virtual void performPivot() = 0;
     virtual double ratioConstraintPerBasic( unsigned basicIndex, double coefficient, bool decrease ) = 0;
     virtual bool isBasic( unsigned variable ) const = 0;
     virtual void setNonBasicAssignment( unsigned variable, double value, bool updateBasics ) = 0;
     virtual void computeCostFunction() = 0;
-    virtual void getEntryCandidates( List<unsigned> &candidates ) const = 0;
+    virtual unsigned getEntryCandidates( unsigned *candidates ) const = 0;
     virtual const double *getCostFunction() const = 0;
     virtual void computeChangeColumn() = 0;
     virtual const double *getChangeColumn() const = 0;
@@ -155,6 +159,13 @@ public:
     virtual unsigned getM() const = 0;
     virtual unsigned getN() const = 0;
     virtual void getTableauRow( unsigned index, TableauRow *row ) = 0;
+
+    /*
+      The dense column of A is written to a buffer shared by all calls,
+      at a cost of O(m) per call, and is only valid until the next call.
+      Callers that only go over the non-zero entries should use
+      getSparseAColumn() instead.
+    */
     virtual const double *getAColumn( unsigned variable ) const = 0;
     virtual void getSparseAColumn( unsigned variable, SparseUnsortedList *result ) const = 0;
     virtual void getSparseARow( unsigned row, SparseUnsortedList *result ) const = 0;
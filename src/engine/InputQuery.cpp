@@ -14,7 +14,10 @@
  **/
 
 #include "AutoFile.h"
+#include "BinaryQueryFormat.h"
+#include "ConstSimpleData.h"
 #include "Debug.h"
+#include "File.h"
 #include "FloatUtils.h"
 #include "InputQuery.h"
 #include "MStringf.h"
@@ -355,6 +358,12 @@ void InputQuery::storeDebuggingSolution( unsigned variable, double value )
 
 void InputQuery::saveQuery( const String &fileName )
 {
+    if ( String( fileName ).endsWith( BinaryQueryFormat::FILE_EXTENSION ) )
+    {
+        saveQueryInBinaryFormat( fileName );
+        return;
+    }
+
     AutoFile queryFile( fileName );
     queryFile->open( IFile::MODE_WRITE_TRUNCATE );
 
@@ -450,6 +459,131 @@ void InputQuery::saveQuery( const String &fileName )
     queryFile->close();
 }
 
+static void writeSection( File &file, const void *data, unsigned long long size )
+{
+    static const char padding[BinaryQueryFormat::SECTION_ALIGNMENT] = { 0 };
+
+    if ( size > 0 )
+        file.write( ConstSimpleData( data, size ) );
+
+    unsigned paddingSize =
+        BinaryQueryFormat::paddingFor( size, BinaryQueryFormat::SECTION_ALIGNMENT );
+    if ( paddingSize > 0 )
+        file.write( ConstSimpleData( padding, paddingSize ) );
+}
+
+static void writeBounds( File &file, const Map<unsigned, double> &bounds )
+{
+    Vector<uint32_t> variables;
+    Vector<double> values;
+    for ( const auto &bound : bounds )
+    {
+        variables.append( bound.first );
+        values.append( bound.second );
+    }
+
+    writeSection( file, variables.data(), variables.size() * sizeof(uint32_t) );
+    writeSection( file, values.data(), values.size() * sizeof(double) );
+}
+
+void InputQuery::saveQueryInBinaryFormat( const String &fileName ) const
+{
+    File file( fileName );
+    file.open( IFile::MODE_WRITE_TRUNCATE );
+
+    BinaryQueryFormat::Header header;
+    memset( &header, 0, sizeof(header) );
+    memcpy( header._magic, BinaryQueryFormat::MAGIC, sizeof(header._magic) );
+    header._version = BinaryQueryFormat::VERSION;
+    header._byteOrderMark = BinaryQueryFormat::BYTE_ORDER_MARK;
+    header._numberOfVariables = _numberOfVariables;
+    header._numberOfInputVariables = _inputIndexToVariable.size();
+    header._numberOfOutputVariables = _outputIndexToVariable.size();
+    header._numberOfLowerBounds = _lowerBounds.size();
+    header._numberOfUpperBounds = _upperBounds.size();
+    header._numberOfEquations = _equations.size();
+    header._numberOfConstraints = _plConstraints.size() + _tsConstraints.size();
+    for ( const auto &equation : _equations )
+        header._numberOfAddends += equation._addends.size();
+    writeSection( file, &header, sizeof(header) );
+
+    // Input and output variables
+    Vector<uint32_t> indexAndVariable;
+    for ( const auto &pair : _inputIndexToVariable )
+    {
+        indexAndVariable.append( pair.first );
+        indexAndVariable.append( pair.second );
+    }
+    writeSection( file, indexAndVariable.data(), indexAndVariable.size() * sizeof(uint32_t) );
+
+    indexAndVariable.clear();
+    for ( const auto &pair : _outputIndexToVariable )
+    {
+        indexAndVariable.append( pair.first );
+        indexAndVariable.append( pair.second );
+    }
+    writeSection( file, indexAndVariable.data(), indexAndVariable.size() * sizeof(uint32_t) );
+
+    // Bounds
+    writeBounds( file, _lowerBounds );
+    writeBounds( file, _upperBounds );
+
+    // Equations, with the addends in CSR form
+    Vector<uint32_t> types;
+    Vector<uint32_t> rowStart;
+    Vector<double> scalars;
+    Vector<uint32_t> variables;
+    Vector<double> coefficients;
+    rowStart.append( 0 );
+    for ( const auto &equation : _equations )
+    {
+        types.append( equation._type );
+        scalars.append( equation._scalar );
+        for ( const auto &addend : equation._addends )
+        {
+            variables.append( addend._variable );
+            coefficients.append( addend._coefficient );
+        }
+        rowStart.append( variables.size() );
+    }
+
+    writeSection( file, types.data(), types.size() * sizeof(uint32_t) );
+    writeSection( file, rowStart.data(), rowStart.size() * sizeof(uint32_t) );
+    writeSection( file, scalars.data(), scalars.size() * sizeof(double) );
+    writeSection( file, variables.data(), variables.size() * sizeof(uint32_t) );
+    writeSection( file, coefficients.data(), coefficients.size() * sizeof(double) );
+
+    // Non-linear constraints, which are short, so they are gathered and
+    // written at once
+    Vector<char> records;
+    auto appendBytes = [&]( const char *bytes, unsigned length )
+    {
+        for ( unsigned i = 0; i < length; ++i )
+            records.append( bytes[i] );
+    };
+    auto appendRecord = [&]( uint32_t kind, uint32_t type, const String &serialized )
+    {
+        BinaryQueryFormat::ConstraintRecord record;
+        record._kind = kind;
+        record._type = type;
+        record._length = serialized.length();
+
+        appendBytes( (const char *)&record, sizeof(record) );
+        appendBytes( serialized.ascii(), serialized.length() );
+        appendBytes( "\0\0\0", BinaryQueryFormat::paddingFor( record._length, 4 ) );
+    };
+
+    for ( const auto &constraint : _plConstraints )
+        appendRecord( BinaryQueryFormat::PIECEWISE_LINEAR, constraint->getType(),
+                      constraint->serializeToString() );
+    for ( const auto &constraint : _tsConstraints )
+        appendRecord( BinaryQueryFormat::TRANSCENDENTAL, constraint->getType(),
+                      constraint->serializeToString() );
+    writeSection( file, records.data(), records.size() );
+
+    file.close();
+}
+
 void InputQuery::markInputVariable( unsigned variable, unsigned inputIndex )
 {
     _variableToInputIndex[variable] = inputIndex;
@@ -784,6 +918,7 @@ bool InputQuery::constructWeighedSumLayer( NLR::NetworkLevelReasoner *nlr,
     nlr->addLayer( newLayerIndex, NLR::Layer::WEIGHTED_SUM, newNeurons.size() );
 
     NLR::Layer *layer = nlr->getLayer( newLayerIndex );
+    Map<unsigned, Vector<NLR::SparseWeightMatrix::Entry>> sourceLayerToWeights;
     for ( const auto &newNeuron : newNeurons )
     {
         handledVariableToLayer[newNeuron._variable] = newLayerIndex;
@@ -820,17 +955,41 @@ bool InputQuery::constructWeighedSumLayer( NLR::NetworkLevelReasoner *nlr,
             unsigned sourceLayer = handledVariableToLayer[addend._variable];
             unsigned sourceNeuron = nlr->getLayer( sourceLayer )->variableToNeuron( addend._variable );
 
-            // Mark the layer dependency
-            nlr->addLayerDependency( sourceLayer, newLayerIndex );
+            sourceLayerToWeights[sourceLayer].append
+                ( NLR::SparseWeightMatrix::Entry( sourceNeuron,
+                                                  newNeuron._neuron,
+                                                  factor * addend._coefficient ) );
+        }
+    }
+
+    /*
+      Convolutional and other sparsely-connected layers keep only their
+      non-zero weights. Their sparse matrices are built directly from the
+      equations, without allocating the dense matrices first.
+    */
+    for ( const auto &sourceLayerAndWeights : sourceLayerToWeights )
+    {
+        unsigned sourceLayer = sourceLayerAndWeights.first;
+        const Vector<NLR::SparseWeightMatrix::Entry> &weights = sourceLayerAndWeights.second;
+        unsigned sourceSize = nlr->getLayer( sourceLayer )->getSize();
 
-            nlr->setWeight( sourceLayer,
-                            sourceNeuron,
-                            newLayerIndex,
-                            newNeuron._neuron,
-                            factor * addend._coefficient );
+        if ( weights.size() <= GlobalConfiguration::NLR_SPARSE_WEIGHTS_MAX_DENSITY * sourceSize * layer->getSize() )
+        {
+            nlr->addLayerDependency( sourceLayer,
+                                     newLayerIndex,
+                                     new NLR::SparseWeightMatrix( sourceSize, layer->getSize(), weights ) );
+            continue;
         }
+
+        nlr->addLayerDependency( sourceLayer, newLayerIndex );
+        for ( const auto &weight : weights )
+            nlr->setWeight( sourceLayer, weight._row, newLayerIndex, weight._column, weight._value );
     }
 
+    // Zero coefficients are counted above, so a dense matrix may still
+    // turn out to be sparse enough
+    layer->compressWeights();
+
     INPUT_QUERY_LOG( "\tSuccessful!" );
     return true;
 }
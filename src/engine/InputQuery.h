@@ -110,6 +110,8 @@ public:
 
     /*
       Serializes the query to a file which can then be loaded using QueryLoader.
+      File names ending with BinaryQueryFormat::FILE_EXTENSION get the binary
+      format, all others the text format.
     */
     void saveQuery( const String &fileName );
 
@@ -155,6 +157,11 @@ private:
     */
     void freeConstraintsIfNeeded();
 
+    /*
+      Write the query in the layout described in BinaryQueryFormat.h
+    */
+    void saveQueryInBinaryFormat( const String &fileName ) const;
+
     /*
       Methods called by constructNetworkLevelReasoner
     */
@@ -0,0 +1,38 @@
+/*********************                                                        */
+/*! \file LPSolverFactory.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#ifndef __LPSolverFactory_h__
+#define __LPSolverFactory_h__
+
+#include "ILPSolver.h"
+
+class LPSolverFactory
+{
+public:
+    /*
+      Create the solver for the LP relaxations of the bound tightening,
+      according to the lp-tightening-solver option. The caller owns the
+      returned object.
+    */
+    static ILPSolver *createLPSolver();
+};
+
+#endif // __LPSolverFactory_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
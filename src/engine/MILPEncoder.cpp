@@ -18,6 +18,7 @@
 #include "GurobiWrapper.h"
 #include "MILPEncoder.h"
 #include "TimeUtils.h"
+#include "Vector.h"
 
 MILPEncoder::MILPEncoder( const ITableau &tableau )
     : _tableau( tableau )
@@ -36,10 +37,9 @@ void MILPEncoder::encodeInputQuery( GurobiWrapper &gurobi,
     {
         double lb = _tableau.getLowerBound( var );
         double ub = _tableau.getUpperBound( var );
-        String varName = Stringf( "x%u", var );
-        gurobi.addVariable( varName, lb, ub );
-        _variableToVariableName[var] = varName;
+        gurobi.addVariable( var, lb, ub );
     }
+    _binVarOffset = inputQuery.getNumberOfVariables();
 
     // Add equations
     for ( const auto &equation : inputQuery.getEquations() )
@@ -111,11 +111,12 @@ void MILPEncoder::encodeInputQuery( GurobiWrapper &gurobi,
     }
 }
 
-String MILPEncoder::getVariableNameFromVariable( unsigned variable )
+unsigned MILPEncoder::addBinaryVariable( GurobiWrapper &gurobi,
+                                         GurobiWrapper::VariableType type )
 {
-    if ( !_variableToVariableName.exists( variable ) )
-        throw CommonError( CommonError::KEY_DOESNT_EXIST_IN_MAP );
-    return _variableToVariableName[variable];
+    unsigned variable = _binVarOffset + _binVarIndex++;
+    gurobi.addVariable( variable, 0, 1, type );
+    return variable;
 }
 
 void MILPEncoder::encodeEquation( GurobiWrapper &gurobi, const Equation &equation )
@@ -123,9 +124,7 @@ void MILPEncoder::encodeEquation( GurobiWrapper &gurobi, const Equation &equatio
     List<GurobiWrapper::Term> terms;
     double scalar = equation._scalar;
     for ( const auto &term : equation._addends )
-        terms.append( GurobiWrapper::Term
-                      ( term._coefficient,
-                        Stringf( "x%u", term._variable ) ) );
+        terms.append( GurobiWrapper::Term( term._coefficient, term._variable ) );
     switch ( equation._type )
     {
     case Equation::EQ:
@@ -166,11 +165,8 @@ void MILPEncoder::encodeReLUConstraint( GurobiWrapper &gurobi,
       When a = 0, the constriants become:
           f - b <= - lb_b, f <= 0
     */
-    gurobi.addVariable( Stringf( "a%u", _binVarIndex ),
-                        0,
-                        1,
-                        relax ?
-                        GurobiWrapper::CONTINUOUS : GurobiWrapper::BINARY );
+    unsigned binVar = addBinaryVariable( gurobi, relax ?
+                                         GurobiWrapper::CONTINUOUS : GurobiWrapper::BINARY );
 
     unsigned sourceVariable = relu->getB();
     unsigned targetVariable = relu->getF();
@@ -178,14 +174,14 @@ void MILPEncoder::encodeReLUConstraint( GurobiWrapper &gurobi,
     double targetUb = _tableau.getUpperBound( targetVariable );
 
     List<GurobiWrapper::Term> terms;
-    terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-    terms.append( GurobiWrapper::Term( -1, Stringf( "x%u", sourceVariable ) ) );
-    terms.append( GurobiWrapper::Term( -sourceLb, Stringf( "a%u", _binVarIndex ) ) );
+    terms.append( GurobiWrapper::Term( 1, targetVariable ) );
+    terms.append( GurobiWrapper::Term( -1, sourceVariable ) );
+    terms.append( GurobiWrapper::Term( -sourceLb, binVar ) );
     gurobi.addLeqConstraint( terms, -sourceLb );
 
     terms.clear();
-    terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-    terms.append( GurobiWrapper::Term( -targetUb, Stringf( "a%u", _binVarIndex++ ) ) );
+    terms.append( GurobiWrapper::Term( 1, targetVariable ) );
+    terms.append( GurobiWrapper::Term( -targetUb, binVar ) );
     gurobi.addLeqConstraint( terms, 0 );
 }
 
@@ -197,16 +193,14 @@ void MILPEncoder::encodeMaxConstraint( GurobiWrapper &gurobi, MaxConstraint *max
 
     List<GurobiWrapper::Term> terms;
     List<PhaseStatus> phases = max->getAllCases();
+    Vector<unsigned> binVars;
     for ( unsigned i = 0; i < phases.size(); ++i )
     {
         // add a binary variable for each disjunct
-        gurobi.addVariable( Stringf( "a%u_%u", _binVarIndex, i ),
-                            0,
-                            1,
-                            relax ?
-                            GurobiWrapper::CONTINUOUS : GurobiWrapper::BINARY );
+        binVars.append( addBinaryVariable( gurobi, relax ?
+                                           GurobiWrapper::CONTINUOUS : GurobiWrapper::BINARY ) );
 
-        terms.append( GurobiWrapper::Term( 1, Stringf( "a%u_%u", _binVarIndex, i ) ) );
+        terms.append( GurobiWrapper::Term( 1, binVars[i] ) );
     }
 
     // add constraint: a_1 + a_2 + ... + = 1
@@ -216,7 +210,7 @@ void MILPEncoder::encodeMaxConstraint( GurobiWrapper &gurobi, MaxConstraint *max
     unsigned index = 0;
     for ( const auto &phase : phases )
     {
-        String binVarName = Stringf( "a%u_%u", _binVarIndex, index );
+        unsigned binVar = binVars[index];
         PiecewiseLinearCaseSplit split = max->getCaseSplit( phase );
         if ( phase == MAX_PHASE_ELIMINATED )
         {
@@ -229,8 +223,8 @@ void MILPEncoder::encodeMaxConstraint( GurobiWrapper &gurobi, MaxConstraint *max
             double yUb = _tableau.getUpperBound( y );
             double eliminatedValue = split.getBoundTightenings().begin()->_value;
 
-            terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", y ) ) );
-            terms.append( GurobiWrapper::Term( yUb - eliminatedValue, binVarName ) );
+            terms.append( GurobiWrapper::Term( 1, y ) );
+            terms.append( GurobiWrapper::Term( yUb - eliminatedValue, binVar ) );
             gurobi.addLeqConstraint( terms, yUb );
         }
         else
@@ -245,15 +239,13 @@ void MILPEncoder::encodeMaxConstraint( GurobiWrapper &gurobi, MaxConstraint *max
                 });
             unsigned aux = split.getBoundTightenings().begin()->_variable;
             double auxUb = _tableau.getUpperBound( aux );
-            terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", aux ) ) );
-            terms.append( GurobiWrapper::Term( auxUb, binVarName ) );
+            terms.append( GurobiWrapper::Term( 1, aux ) );
+            terms.append( GurobiWrapper::Term( auxUb, binVar ) );
             gurobi.addLeqConstraint( terms, auxUb );
         }
         terms.clear();
         ++index;
     }
-
-    _binVarIndex++;
 }
 
 void MILPEncoder::encodeAbsoluteValueConstraint( GurobiWrapper &gurobi,
@@ -290,25 +282,20 @@ void MILPEncoder::encodeAbsoluteValueConstraint( GurobiWrapper &gurobi,
       When a = 0, the constriants become:
       f - b <= ub_f - lb_b, f + b <= 0
     */
-    gurobi.addVariable( Stringf( "a%u", _binVarIndex ),
-                        0,
-                        1,
-                        relax ?
-                        GurobiWrapper::CONTINUOUS : GurobiWrapper::BINARY );
+    unsigned binVar = addBinaryVariable( gurobi, relax ?
+                                         GurobiWrapper::CONTINUOUS : GurobiWrapper::BINARY );
 
     List<GurobiWrapper::Term> terms;
-    terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-    terms.append( GurobiWrapper::Term( -1, Stringf( "x%u", sourceVariable ) ) );
-    terms.append( GurobiWrapper::Term( targetUb - sourceLb, Stringf( "a%u", _binVarIndex ) ) );
+    terms.append( GurobiWrapper::Term( 1, targetVariable ) );
+    terms.append( GurobiWrapper::Term( -1, sourceVariable ) );
+    terms.append( GurobiWrapper::Term( targetUb - sourceLb, binVar ) );
     gurobi.addLeqConstraint( terms, targetUb - sourceLb );
 
     terms.clear();
-    terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-    terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", sourceVariable ) ) );
-    terms.append( GurobiWrapper::Term( -( targetUb + sourceUb ),
-                                       Stringf( "a%u", _binVarIndex ) ) );
+    terms.append( GurobiWrapper::Term( 1, targetVariable ) );
+    terms.append( GurobiWrapper::Term( 1, sourceVariable ) );
+    terms.append( GurobiWrapper::Term( -( targetUb + sourceUb ), binVar ) );
     gurobi.addLeqConstraint( terms, 0 );
-    ++_binVarIndex;
 }
 
 void MILPEncoder::encodeDisjunctionConstraint( GurobiWrapper &gurobi,
@@ -321,16 +308,14 @@ void MILPEncoder::encodeDisjunctionConstraint( GurobiWrapper &gurobi,
     // terms for Gurobi
     List<GurobiWrapper::Term> terms;
     List<PiecewiseLinearCaseSplit> disjuncts = disj->getCaseSplits();
+    Vector<unsigned> binVars;
     for ( unsigned i = 0; i < disjuncts.size(); ++i )
     {
         // add a binary variable for each disjunct
-        gurobi.addVariable( Stringf( "a%u_%u", _binVarIndex, i ),
-                            0,
-                            1,
-                            relax ?
-                            GurobiWrapper::CONTINUOUS : GurobiWrapper::BINARY );
+        binVars.append( addBinaryVariable( gurobi, relax ?
+                                           GurobiWrapper::CONTINUOUS : GurobiWrapper::BINARY ) );
 
-        terms.append( GurobiWrapper::Term( 1, Stringf( "a%u_%u", _binVarIndex, i ) ) );
+        terms.append( GurobiWrapper::Term( 1, binVars[i] ) );
     }
 
     // add constraint: a_1 + a_2 + ... + >= 1
@@ -341,23 +326,19 @@ void MILPEncoder::encodeDisjunctionConstraint( GurobiWrapper &gurobi,
     unsigned index = 0;
     for ( const auto &disjunct : disjuncts )
     {
-        String binVarName = Stringf( "a%u_%u", _binVarIndex, index );
+        unsigned binVar = binVars[index];
         for ( const auto &tightening : disjunct.getBoundTightenings() )
         {
             // add indicator constraint: a_1 => disjunct1, etc.
-            terms.append( GurobiWrapper::Term
-                          ( 1, getVariableNameFromVariable
-                            ( tightening._variable ) ) );
+            terms.append( GurobiWrapper::Term( 1, tightening._variable ) );
             if ( tightening._type == Tightening::UB )
-                gurobi.addLeqIndicatorConstraint( binVarName, 1, terms, tightening._value );
+                gurobi.addLeqIndicatorConstraint( binVar, 1, terms, tightening._value );
             else
-                gurobi.addGeqIndicatorConstraint( binVarName, 1, terms, tightening._value );
+                gurobi.addGeqIndicatorConstraint( binVar, 1, terms, tightening._value );
             terms.clear();
         }
         ++index;
     }
-
-    _binVarIndex++;
 }
 
 void MILPEncoder::encodeSignConstraint( GurobiWrapper &gurobi,
@@ -394,18 +375,13 @@ void MILPEncoder::encodeSignConstraint( GurobiWrapper &gurobi,
       Moreover, when f is 1, 1 <= -2 / lb_b * b + 1, thus, b >= 0.
       When f is -1, -1 >= 2/ub_b * b - 1, thus, b <= 0.
     */
-    gurobi.addVariable( Stringf( "a%u", _binVarIndex ),
-                        0,
-                        1,
-                        relax ?
-                        GurobiWrapper::CONTINUOUS : GurobiWrapper::BINARY );
+    unsigned binVar = addBinaryVariable( gurobi, relax ?
+                                         GurobiWrapper::CONTINUOUS : GurobiWrapper::BINARY );
 
     List<GurobiWrapper::Term> terms;
-    terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-    terms.append( GurobiWrapper::Term( -2, Stringf( "a%u", _binVarIndex ) ) );
+    terms.append( GurobiWrapper::Term( 1, targetVariable ) );
+    terms.append( GurobiWrapper::Term( -2, binVar ) );
     gurobi.addEqConstraint( terms, -1 );
-
-    ++_binVarIndex;
 }
 
 void MILPEncoder::encodeSigmoidConstraint( GurobiWrapper &gurobi, SigmoidConstraint *sigmoid )
@@ -423,18 +399,15 @@ void MILPEncoder::encodeSigmoidConstraint( GurobiWrapper &gurobi, SigmoidConstra
         double tangentSlope = sigmoid->sigmoidDerivative( sourceLb );
 
         List<GurobiWrapper::Term> terms;
-        terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-        terms.append( GurobiWrapper::Term( -tangentSlope, Stringf( "x%u", sourceVariable ) ) );
+        terms.append( GurobiWrapper::Term( 1, targetVariable ) );
+        terms.append( GurobiWrapper::Term( -tangentSlope, sourceVariable ) );
         gurobi.addEqConstraint( terms, -tangentSlope * sourceLb + yAtTangentPoint );
     }
     else if ( FloatUtils::lt( sourceLb, 0 ) && FloatUtils::gt( sourceUb, 0 ) )
     {
         List<GurobiWrapper::Term> terms;
-        String binVarName = Stringf( "a%u", _binVarIndex ); // a = 1 -> the case where x_b >= 0, otherwise where x_b <= 0
-        gurobi.addVariable( binVarName,
-                            0,
-                            1,
-                            GurobiWrapper::BINARY );
+        // a = 1 -> the case where x_b >= 0, otherwise where x_b <= 0
+        unsigned binVar = addBinaryVariable( gurobi, GurobiWrapper::BINARY );
 
         // Constraint where x_b >= 0
         // Upper line is tangent and lower line is secant for an overapproximation with a linearization.
@@ -445,28 +418,28 @@ void MILPEncoder::encodeSigmoidConstraint( GurobiWrapper &gurobi, SigmoidConstra
         double tangentPoint = sourceUb / 2;
         double yAtTangentPoint = sigmoid->sigmoid( tangentPoint );
         double tangentSlope = sigmoid->sigmoidDerivative( tangentPoint );
-        terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-        terms.append( GurobiWrapper::Term( -tangentSlope, Stringf( "x%u", sourceVariable ) ) );
-        gurobi.addLeqIndicatorConstraint( binVarName, binVal, terms, -tangentSlope * tangentPoint + yAtTangentPoint );
+        terms.append( GurobiWrapper::Term( 1, targetVariable ) );
+        terms.append( GurobiWrapper::Term( -tangentSlope, sourceVariable ) );
+        gurobi.addLeqIndicatorConstraint( binVar, binVal, terms, -tangentSlope * tangentPoint + yAtTangentPoint );
         terms.clear();
 
         // secant line: x_f = secantSlope * (x_b - 0) + y_l
         double y_l = sigmoid->sigmoid( 0 );
         double y_u = sigmoid->sigmoid( sourceUb );
         double secantSlope = ( y_u - y_l ) / sourceUb;
-        terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-        terms.append( GurobiWrapper::Term( -secantSlope, Stringf( "x%u", sourceVariable ) ) );
-        gurobi.addGeqIndicatorConstraint( binVarName, binVal, terms, y_l );
+        terms.append( GurobiWrapper::Term( 1, targetVariable ) );
+        terms.append( GurobiWrapper::Term( -secantSlope, sourceVariable ) );
+        gurobi.addGeqIndicatorConstraint( binVar, binVal, terms, y_l );
         terms.clear();
 
         // lower bound of x_b
-        terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", sourceVariable ) ) );
-        gurobi.addGeqIndicatorConstraint( binVarName, binVal, terms, 0 );  
+        terms.append( GurobiWrapper::Term( 1, sourceVariable ) );
+        gurobi.addGeqIndicatorConstraint( binVar, binVal, terms, 0 );  
         terms.clear();
 
         // lower bound of x_f
-        terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-        gurobi.addGeqIndicatorConstraint( binVarName, binVal, terms, y_l );  
+        terms.append( GurobiWrapper::Term( 1, targetVariable ) );
+        gurobi.addGeqIndicatorConstraint( binVar, binVal, terms, y_l );  
         terms.clear(); 
 
         // Constraints where x_b <= 0
@@ -478,31 +451,29 @@ void MILPEncoder::encodeSigmoidConstraint( GurobiWrapper &gurobi, SigmoidConstra
         tangentPoint = sourceLb / 2;
         yAtTangentPoint = sigmoid->sigmoid( tangentPoint );
         tangentSlope = sigmoid->sigmoidDerivative( tangentPoint );
-        terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-        terms.append( GurobiWrapper::Term( -tangentSlope, Stringf( "x%u", sourceVariable ) ) );
-        gurobi.addGeqIndicatorConstraint( binVarName, binVal, terms, -tangentSlope * tangentPoint + yAtTangentPoint );
+        terms.append( GurobiWrapper::Term( 1, targetVariable ) );
+        terms.append( GurobiWrapper::Term( -tangentSlope, sourceVariable ) );
+        gurobi.addGeqIndicatorConstraint( binVar, binVal, terms, -tangentSlope * tangentPoint + yAtTangentPoint );
         terms.clear();
 
         // secant line: x_f = secantSlope * (x_b - sourceLb) + y_l
         y_u = y_l;
         y_l = sigmoid->sigmoid( sourceLb );
         secantSlope = ( y_u - y_l ) / ( 0 - sourceLb );
-        terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-        terms.append( GurobiWrapper::Term( -secantSlope, Stringf( "x%u", sourceVariable ) ) );
-        gurobi.addLeqIndicatorConstraint( binVarName, binVal, terms, -secantSlope * sourceLb + y_l );
+        terms.append( GurobiWrapper::Term( 1, targetVariable ) );
+        terms.append( GurobiWrapper::Term( -secantSlope, sourceVariable ) );
+        gurobi.addLeqIndicatorConstraint( binVar, binVal, terms, -secantSlope * sourceLb + y_l );
         terms.clear();
 
         // upper bound of x_b
-        terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", sourceVariable ) ) );
-        gurobi.addLeqIndicatorConstraint( binVarName, binVal, terms, 0 );  
+        terms.append( GurobiWrapper::Term( 1, sourceVariable ) );
+        gurobi.addLeqIndicatorConstraint( binVar, binVal, terms, 0 );  
         terms.clear();
 
         // upper bound of x_f
-        terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-        gurobi.addLeqIndicatorConstraint( binVarName, binVal, terms, y_u );  
+        terms.append( GurobiWrapper::Term( 1, targetVariable ) );
+        gurobi.addLeqIndicatorConstraint( binVar, binVal, terms, y_u );  
         terms.clear(); 
-
-        _binVarIndex++;
     }
     else
     {   
@@ -512,8 +483,8 @@ void MILPEncoder::encodeSigmoidConstraint( GurobiWrapper &gurobi, SigmoidConstra
         double tangentSlope = sigmoid->sigmoidDerivative( tangentPoint );
 
         List<GurobiWrapper::Term> terms;
-        terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-        terms.append( GurobiWrapper::Term( -tangentSlope, Stringf( "x%u", sourceVariable ) ) );
+        terms.append( GurobiWrapper::Term( 1, targetVariable ) );
+        terms.append( GurobiWrapper::Term( -tangentSlope, sourceVariable ) );
 
         if ( FloatUtils::gte( sourceLb, 0 ) )
         {
@@ -529,8 +500,8 @@ void MILPEncoder::encodeSigmoidConstraint( GurobiWrapper &gurobi, SigmoidConstra
         double y_u = sigmoid->sigmoid( sourceUb );
 
         double secantSlope = ( y_u - y_l ) / ( sourceUb - sourceLb );
-        terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-        terms.append( GurobiWrapper::Term( -secantSlope, Stringf( "x%u", sourceVariable ) ) );
+        terms.append( GurobiWrapper::Term( 1, targetVariable ) );
+        terms.append( GurobiWrapper::Term( -secantSlope, sourceVariable ) );
 
         if ( FloatUtils::gte( sourceLb, 0 ) )
         {
@@ -550,9 +521,7 @@ void MILPEncoder::encodeCostFunction( GurobiWrapper &gurobi,
     List<GurobiWrapper::Term> terms;
     for ( const auto &pair : cost._addends )
     {
-        terms.append( GurobiWrapper::Term
-                      ( pair.second,
-                        Stringf( "x%u", pair.first ) ) );
+        terms.append( GurobiWrapper::Term( pair.second, pair.first ) );
     }
     gurobi.setCost( terms, cost._constant );
 }
@@ -38,11 +38,6 @@ public:
     void encodeInputQuery( GurobiWrapper &gurobi, const InputQuery &inputQuery,
                            bool relax = false );
 
-    /*
-      get variable name from a variable in the encoded inputquery
-    */
-    String getVariableNameFromVariable( unsigned variable );
-
     inline void setStatistics( Statistics *statistics )
     {
         _statistics = statistics;
@@ -67,14 +62,19 @@ private:
     Statistics *_statistics;
 
     /*
-      Map the variable to the string encoded in Gurobi
+      Variables of the input query are encoded in Gurobi under their
+      own indices. Binary variables are numbered after them: the i'th
+      binary variable is _binVarOffset + i.
     */
-    Map<unsigned, String> _variableToVariableName;
+    unsigned _binVarOffset = 0;
+    unsigned _binVarIndex = 0;
 
     /*
-      Index for Guroby binary variables
+      Add a new binary variable (or its relaxation) to Gurobi, and
+      return its index.
     */
-    unsigned _binVarIndex = 0;
+    unsigned addBinaryVariable( GurobiWrapper &gurobi,
+                                GurobiWrapper::VariableType type );
 
     /*
       Encode an (in)equality into Gurobi.
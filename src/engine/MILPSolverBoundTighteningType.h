@@ -34,6 +34,9 @@ enum class MILPSolverBoundTighteningType
      ITERATIVE_PROPAGATION = 4,
      // Option to have no MILP bound tightening performed
      NONE = 5,
+     // Like LP_RELAXATION, but each solver keeps its model across
+     // neurons and warm-starts from its previous basis
+     LP_RELAXATION_WARM_START = 6,
 };
 
 #endif // __MILPSolverBoundTighteningType_h__
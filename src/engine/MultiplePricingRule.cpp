@@ -0,0 +1,155 @@
+/*********************                                                        */
+/*! \file MultiplePricingRule.cpp
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "FloatUtils.h"
+#include "GlobalConfiguration.h"
+#include "ITableau.h"
+#include "MultiplePricingRule.h"
+#include "Statistics.h"
+
+MultiplePricingRule::MultiplePricingRule()
+    : _minorIterations( 0 )
+{
+}
+
+bool MultiplePricingRule::select( ITableau &tableau,
+                                  const unsigned * /* candidates */,
+                                  unsigned /* numberOfCandidates */,
+                                  const Bitset &excluded )
+{
+    if ( selectFromList( tableau, excluded ) )
+        return true;
+
+    return fullPricing( tableau, excluded );
+}
+
+bool MultiplePricingRule::selectFromList( ITableau &tableau, const Bitset &excluded )
+{
+    if ( _candidateList.empty() ||
+         _minorIterations >= GlobalConfiguration::MULTIPLE_PRICING_MAX_MINOR_ITERATIONS )
+        return false;
+
+    const double *costFunction = tableau.getCostFunction();
+
+    bool found = false;
+    unsigned maxIndex = 0;
+    double maxValue = 0;
+
+    for ( unsigned i = 0; i < _candidateList.size(); ++i )
+    {
+        unsigned candidate = _candidateList[i];
+        if ( excluded.exists( candidate ) || !tableau.eligibleForEntry( candidate, costFunction ) )
+            continue;
+
+        double contenderValue = FloatUtils::abs( costFunction[candidate] );
+        if ( !found || FloatUtils::gt( contenderValue, maxValue ) )
+        {
+            found = true;
+            maxIndex = candidate;
+            maxValue = contenderValue;
+        }
+    }
+
+    if ( _statistics )
+        _statistics->incLongAttribute( Statistics::NUM_PRICING_CANDIDATES_SCANNED,
+                                       _candidateList.size() );
+
+    if ( !found )
+        return false;
+
+    tableau.setEnteringVariableIndex( maxIndex );
+    return true;
+}
+
+bool MultiplePricingRule::fullPricing( ITableau &tableau, const Bitset &excluded )
+{
+    const double *costFunction = tableau.getCostFunction();
+    unsigned numberOfNonBasics = tableau.getN() - tableau.getM();
+    unsigned listSize = GlobalConfiguration::MULTIPLE_PRICING_LIST_SIZE;
+
+    _candidateList.clear();
+    _candidateScores.clear();
+    _minorIterations = 0;
+
+    // Keep the listSize best candidates, sorted by decreasing score
+    for ( unsigned i = 0; i < numberOfNonBasics; ++i )
+    {
+        if ( excluded.exists( i ) || !tableau.eligibleForEntry( i, costFunction ) )
+            continue;
+
+        double score = FloatUtils::abs( costFunction[i] );
+        unsigned position = _candidateList.size();
+        if ( position == listSize )
+        {
+            if ( !FloatUtils::gt( score, _candidateScores[position - 1] ) )
+                continue;
+            --position;
+        }
+        else
+        {
+            _candidateList.append( i );
+            _candidateScores.append( score );
+        }
+
+        while ( position > 0 && FloatUtils::gt( score, _candidateScores[position - 1] ) )
+        {
+            _candidateList[position] = _candidateList[position - 1];
+            _candidateScores[position] = _candidateScores[position - 1];
+            --position;
+        }
+
+        _candidateList[position] = i;
+        _candidateScores[position] = score;
+    }
+
+    if ( _statistics )
+        _statistics->incLongAttribute( Statistics::NUM_PRICING_CANDIDATES_SCANNED,
+                                       numberOfNonBasics );
+
+    if ( _candidateList.empty() )
+        return false;
+
+    tableau.setEnteringVariableIndex( _candidateList[0] );
+    return true;
+}
+
+void MultiplePricingRule::postPivotHook( const ITableau &tableau, bool /* fakePivot */ )
+{
+    ++_minorIterations;
+
+    unsigned entering = tableau.getEnteringVariableIndex();
+    for ( unsigned i = 0; i < _candidateList.size(); ++i )
+    {
+        if ( _candidateList[i] == entering )
+        {
+            _candidateList.eraseAt( i );
+            _candidateScores.eraseAt( i );
+            break;
+        }
+    }
+}
+
+void MultiplePricingRule::resizeHook( const ITableau & /* tableau */ )
+{
+    _candidateList.clear();
+    _candidateScores.clear();
+    _minorIterations = 0;
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
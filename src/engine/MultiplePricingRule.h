@@ -0,0 +1,81 @@
+/*********************                                                        */
+/*! \file MultiplePricingRule.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#ifndef __MultiplePricingRule_h__
+#define __MultiplePricingRule_h__
+
+#include "EntrySelectionStrategy.h"
+#include "Vector.h"
+
+class MultiplePricingRule : public EntrySelectionStrategy
+{
+public:
+    MultiplePricingRule();
+
+    /*
+      Apply Dantzig's rule to the short list of attractive candidates
+      kept from the last full pricing pass. A full pass over all
+      non-basic variables, which also rebuilds the list, is performed
+      when no listed candidate is eligible any more, or after the list
+      has been used for MULTIPLE_PRICING_MAX_MINOR_ITERATIONS pivots.
+    */
+    bool select( ITableau &tableau,
+                 const unsigned *candidates,
+                 unsigned numberOfCandidates,
+                 const Bitset &excluded );
+
+    bool requiresEntryCandidates() const
+    {
+        return false;
+    }
+
+    /*
+      Count the pivot, and drop the entering variable's index from the
+      list: it now belongs to the variable that just left the basis.
+    */
+    void postPivotHook( const ITableau &tableau, bool fakePivot );
+
+    void resizeHook( const ITableau &tableau );
+
+    const Vector<unsigned> &getCandidateList() const
+    {
+        return _candidateList;
+    }
+
+private:
+    /*
+      The attractive candidates, by non-basic index, and the number of
+      pivots performed since they were collected.
+    */
+    Vector<unsigned> _candidateList;
+    unsigned _minorIterations;
+
+    /*
+      The score (absolute cost coefficient) of each listed candidate,
+      used while rebuilding the list.
+    */
+    Vector<double> _candidateScores;
+
+    bool selectFromList( ITableau &tableau, const Bitset &excluded );
+    bool fullPricing( ITableau &tableau, const Bitset &excluded );
+};
+
+#endif // __MultiplePricingRule_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
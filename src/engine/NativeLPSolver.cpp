@@ -0,0 +1,869 @@
+/*********************                                                        */
+/*! \file NativeLPSolver.cpp
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "BasisFactorizationFactory.h"
+#include "Debug.h"
+#include "FloatUtils.h"
+#include "GlobalConfiguration.h"
+#include "MStringf.h"
+#include "MalformedBasisException.h"
+#include "MarabouError.h"
+#include "NativeLPSolver.h"
+#include "Options.h"
+#include "SparseColumnsOfBasis.h"
+#include "TimeUtils.h"
+
+const unsigned NativeLPSolver::NO_INDEX;
+
+NativeLPSolver::NativeLPSolver()
+    : _objectiveConstant( 0 )
+    , _costSign( 1 )
+    , _cutoff( 0 )
+    , _cutoffInUse( false )
+    , _structureChanged( true )
+    , _basisFactorization( NULL )
+    , _factorizationSize( 0 )
+    , _basicValues( NULL )
+    , _basicCosts( NULL )
+    , _multipliers( NULL )
+    , _changeColumn( NULL )
+    , _denseColumn( NULL )
+    , _work( NULL )
+    , _workSize( 0 )
+    , _status( UNSOLVED )
+    , _optimalValue( 0 )
+    , _numberOfIterations( 0 )
+    , _timeoutInSeconds( Options::get()->getFloat( Options::MILP_SOLVER_TIMEOUT ) )
+{
+}
+
+NativeLPSolver::~NativeLPSolver()
+{
+    freeColumns();
+    freeWorkMemory();
+
+    if ( _basisFactorization )
+    {
+        delete _basisFactorization;
+        _basisFactorization = NULL;
+    }
+}
+
+void NativeLPSolver::freeColumns()
+{
+    for ( auto &column : _columns )
+    {
+        delete column;
+        column = NULL;
+    }
+    _columns.clear();
+}
+
+void NativeLPSolver::freeWorkMemory()
+{
+    if ( _basicValues )
+    {
+        delete[] _basicValues;
+        _basicValues = NULL;
+    }
+
+    if ( _basicCosts )
+    {
+        delete[] _basicCosts;
+        _basicCosts = NULL;
+    }
+
+    if ( _multipliers )
+    {
+        delete[] _multipliers;
+        _multipliers = NULL;
+    }
+
+    if ( _changeColumn )
+    {
+        delete[] _changeColumn;
+        _changeColumn = NULL;
+    }
+
+    if ( _denseColumn )
+    {
+        delete[] _denseColumn;
+        _denseColumn = NULL;
+    }
+
+    if ( _work )
+    {
+        delete[] _work;
+        _work = NULL;
+    }
+
+    _workSize = 0;
+}
+
+void NativeLPSolver::allocateWorkMemory( unsigned m )
+{
+    if ( _workSize == m )
+        return;
+
+    freeWorkMemory();
+
+    if ( m == 0 )
+        return;
+
+    _basicValues = new double[m];
+    _basicCosts = new double[m];
+    _multipliers = new double[m];
+    _changeColumn = new double[m];
+    _denseColumn = new double[m];
+    _work = new double[m];
+
+    if ( !_basicValues || !_basicCosts || !_multipliers ||
+         !_changeColumn || !_denseColumn || !_work )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "NativeLPSolver::workMemory" );
+
+    _workSize = m;
+}
+
+void NativeLPSolver::resetModel()
+{
+    // Remember the basis, in case the next model has the same shape
+    if ( !_variableStatus.empty() )
+    {
+        _previousBasicVariables = _basicVariables;
+        _previousVariableStatus = _variableStatus;
+    }
+
+    _handleToIndex.clear();
+    _lowerBounds.clear();
+    _upperBounds.clear();
+    _constraints.clear();
+    _objective.clear();
+    _objectiveConstant = 0;
+    _costSign = 1;
+    _cutoffInUse = false;
+
+    _basicVariables.clear();
+    _variableStatus.clear();
+    _structureChanged = true;
+
+    reset();
+}
+
+void NativeLPSolver::reset()
+{
+    _status = UNSOLVED;
+    _solution.clear();
+    _optimalValue = 0;
+    _numberOfIterations = 0;
+}
+
+void NativeLPSolver::modelChanged()
+{
+    if ( _status != UNSOLVED )
+        reset();
+}
+
+bool NativeLPSolver::handleInUse( unsigned variable ) const
+{
+    return variable < _handleToIndex.size() && _handleToIndex[variable] != NO_INDEX;
+}
+
+unsigned NativeLPSolver::getVariableIndex( unsigned variable ) const
+{
+    if ( !handleInUse( variable ) )
+        throw MarabouError( MarabouError::VARIABLE_DOESNT_EXIST_IN_SOLUTION,
+                            Stringf( "NativeLPSolver: unknown variable x%u", variable ).ascii() );
+
+    return _handleToIndex[variable];
+}
+
+void NativeLPSolver::addVariable( unsigned variable, double lb, double ub, VariableType type )
+{
+    ASSERT( !handleInUse( variable ) );
+
+    // Binary variables are relaxed
+    if ( type == BINARY )
+    {
+        lb = FloatUtils::max( lb, 0 );
+        ub = FloatUtils::min( ub, 1 );
+    }
+
+    while ( _handleToIndex.size() <= variable )
+        _handleToIndex.append( NO_INDEX );
+    _handleToIndex[variable] = _lowerBounds.size();
+    _lowerBounds.append( lb );
+    _upperBounds.append( ub );
+    _structureChanged = true;
+    modelChanged();
+}
+
+void NativeLPSolver::setLowerBound( unsigned variable, double lb )
+{
+    _lowerBounds[getVariableIndex( variable )] = lb;
+    modelChanged();
+}
+
+void NativeLPSolver::setUpperBound( unsigned variable, double ub )
+{
+    _upperBounds[getVariableIndex( variable )] = ub;
+    modelChanged();
+}
+
+double NativeLPSolver::getLowerBound( unsigned variable )
+{
+    return _lowerBounds[getVariableIndex( variable )];
+}
+
+double NativeLPSolver::getUpperBound( unsigned variable )
+{
+    return _upperBounds[getVariableIndex( variable )];
+}
+
+void NativeLPSolver::addLeqConstraint( const List<Term> &terms, double scalar )
+{
+    addConstraint( terms, FloatUtils::negativeInfinity(), scalar );
+}
+
+void NativeLPSolver::addGeqConstraint( const List<Term> &terms, double scalar )
+{
+    addConstraint( terms, scalar, FloatUtils::infinity() );
+}
+
+void NativeLPSolver::addEqConstraint( const List<Term> &terms, double scalar )
+{
+    addConstraint( terms, scalar, scalar );
+}
+
+void NativeLPSolver::addConstraint( const List<Term> &terms, double lb, double ub )
+{
+    Constraint constraint;
+    for ( const auto &term : terms )
+    {
+        unsigned variable = getVariableIndex( term._variable );
+        if ( !constraint._coefficients.exists( variable ) )
+            constraint._coefficients[variable] = 0;
+        constraint._coefficients[variable] += term._coefficient;
+    }
+
+    // The auxiliary variable carries the constraint's bounds
+    constraint._auxVariable = _lowerBounds.size();
+    _lowerBounds.append( lb );
+    _upperBounds.append( ub );
+
+    _constraints.append( constraint );
+    _structureChanged = true;
+    modelChanged();
+}
+
+void NativeLPSolver::setCost( const List<Term> &terms, double constant )
+{
+    setObjectiveFunction( terms, constant, 1 );
+}
+
+void NativeLPSolver::setObjective( const List<Term> &terms, double constant )
+{
+    setObjectiveFunction( terms, constant, -1 );
+}
+
+void NativeLPSolver::setObjectiveFunction( const List<Term> &terms, double constant, double costSign )
+{
+    _objective.clear();
+    for ( const auto &term : terms )
+    {
+        unsigned variable = getVariableIndex( term._variable );
+        if ( !_objective.exists( variable ) )
+            _objective[variable] = 0;
+        _objective[variable] += term._coefficient;
+    }
+
+    _objectiveConstant = constant;
+    _costSign = costSign;
+    modelChanged();
+}
+
+double NativeLPSolver::getOptimalCostOrObjective()
+{
+    return _optimalValue;
+}
+
+void NativeLPSolver::setCutoff( double cutoff )
+{
+    _cutoff = cutoff;
+    _cutoffInUse = true;
+}
+
+bool NativeLPSolver::optimal()
+{
+    return _status == OPTIMAL;
+}
+
+bool NativeLPSolver::cutoffOccurred()
+{
+    return _status == CUTOFF;
+}
+
+bool NativeLPSolver::infeasible()
+{
+    return _status == INFEASIBLE;
+}
+
+bool NativeLPSolver::timeout()
+{
+    return _status == TIMEOUT;
+}
+
+bool NativeLPSolver::haveFeasibleSolution()
+{
+    return _status == OPTIMAL || _status == CUTOFF;
+}
+
+void NativeLPSolver::setTimeLimit( double seconds )
+{
+    _timeoutInSeconds = seconds;
+}
+
+void NativeLPSolver::setVerbosity( unsigned /* verbosity */ )
+{
+}
+
+void NativeLPSolver::setNumberOfThreads( unsigned /* threads */ )
+{
+}
+
+void NativeLPSolver::extractSolution( Map<unsigned, double> &values, double &costOrObjective )
+{
+    values.clear();
+
+    for ( unsigned i = 0; i < _handleToIndex.size(); ++i )
+    {
+        if ( _handleToIndex[i] != NO_INDEX )
+            values[i] = _solution[_handleToIndex[i]];
+    }
+
+    costOrObjective = _optimalValue;
+}
+
+double NativeLPSolver::getObjectiveBound()
+{
+    if ( _status == OPTIMAL )
+        return _optimalValue;
+
+    // No bound is known: return the trivial one
+    return _costSign > 0 ? FloatUtils::negativeInfinity() : FloatUtils::infinity();
+}
+
+double NativeLPSolver::getAssignment( unsigned variable )
+{
+    return _solution[getVariableIndex( variable )];
+}
+
+bool NativeLPSolver::existsAssignment( unsigned variable )
+{
+    return handleInUse( variable ) && haveFeasibleSolution();
+}
+
+unsigned NativeLPSolver::getNumberOfSimplexIterations()
+{
+    return _numberOfIterations;
+}
+
+void NativeLPSolver::getColumnOfBasis( unsigned column, double *result ) const
+{
+    ASSERT( column < _basicVariables.size() );
+    _columns[_basicVariables[column]]->toDense( result );
+}
+
+void NativeLPSolver::getColumnOfBasis( unsigned column, SparseUnsortedList *result ) const
+{
+    ASSERT( column < _basicVariables.size() );
+    _columns[_basicVariables[column]]->storeIntoOther( result );
+}
+
+void NativeLPSolver::getSparseBasis( SparseColumnsOfBasis &basis ) const
+{
+    for ( unsigned i = 0; i < _basicVariables.size(); ++i )
+        basis._columns[i] = _columns[_basicVariables[i]];
+}
+
+void NativeLPSolver::rebuildColumns()
+{
+    freeColumns();
+
+    unsigned n = _lowerBounds.size();
+    unsigned m = _constraints.size();
+
+    for ( unsigned i = 0; i < n; ++i )
+        _columns.append( new SparseUnsortedList( m ) );
+
+    for ( unsigned i = 0; i < m; ++i )
+    {
+        for ( const auto &coefficient : _constraints[i]._coefficients )
+        {
+            if ( !FloatUtils::isZero( coefficient.second ) )
+                _columns[coefficient.first]->append( i, coefficient.second );
+        }
+        _columns[_constraints[i]._auxVariable]->append( i, -1 );
+    }
+
+    _structureChanged = false;
+}
+
+void NativeLPSolver::setSlackBasis()
+{
+    unsigned n = _lowerBounds.size();
+    unsigned m = _constraints.size();
+
+    _variableStatus.clear();
+    for ( unsigned i = 0; i < n; ++i )
+        _variableStatus.append( AT_LOWER );
+
+    _basicVariables.clear();
+    for ( unsigned i = 0; i < m; ++i )
+    {
+        _basicVariables.append( _constraints[i]._auxVariable );
+        _variableStatus[_constraints[i]._auxVariable] = BASIC;
+    }
+}
+
+void NativeLPSolver::initializeBasis()
+{
+    unsigned n = _lowerBounds.size();
+    unsigned m = _constraints.size();
+
+    if ( _variableStatus.empty() )
+    {
+        // A fresh model: warm start from the previous one, if it had the
+        // same shape
+        if ( _previousVariableStatus.size() == n && _previousBasicVariables.size() == m )
+        {
+            _variableStatus = _previousVariableStatus;
+            _basicVariables = _previousBasicVariables;
+        }
+        else
+        {
+            setSlackBasis();
+        }
+    }
+    else
+    {
+        // The model has grown since the last solve. New structural
+        // variables start non-basic, and the auxiliary variables of new
+        // constraints become basic. The resulting basis is block
+        // triangular, and hence remains non-singular.
+        for ( unsigned i = _variableStatus.size(); i < n; ++i )
+            _variableStatus.append( AT_LOWER );
+
+        for ( unsigned i = _basicVariables.size(); i < m; ++i )
+        {
+            _basicVariables.append( _constraints[i]._auxVariable );
+            _variableStatus[_constraints[i]._auxVariable] = BASIC;
+        }
+    }
+
+    ASSERT( _variableStatus.size() == n );
+    ASSERT( _basicVariables.size() == m );
+}
+
+void NativeLPSolver::adjustNonBasicStatuses()
+{
+    // Bounds may have changed since the last solve: place every non-basic
+    // variable at a finite bound, if it has one
+    for ( unsigned i = 0; i < _variableStatus.size(); ++i )
+    {
+        if ( _variableStatus[i] == BASIC )
+            continue;
+
+        bool lbFinite = FloatUtils::isFinite( _lowerBounds[i] );
+        bool ubFinite = FloatUtils::isFinite( _upperBounds[i] );
+
+        if ( _variableStatus[i] == AT_UPPER && ubFinite )
+            continue;
+
+        if ( lbFinite )
+            _variableStatus[i] = AT_LOWER;
+        else if ( ubFinite )
+            _variableStatus[i] = AT_UPPER;
+        else
+            _variableStatus[i] = AT_ZERO;
+    }
+}
+
+void NativeLPSolver::refactorize()
+{
+    unsigned m = _constraints.size();
+    if ( m == 0 )
+        return;
+
+    if ( !_basisFactorization || _factorizationSize != m )
+    {
+        if ( _basisFactorization )
+            delete _basisFactorization;
+
+        _basisFactorization = BasisFactorizationFactory::createBasisFactorization( m, *this );
+        _factorizationSize = m;
+    }
+
+    _basisFactorization->obtainFreshBasis();
+}
+
+double NativeLPSolver::getNonBasicValue( unsigned variable ) const
+{
+    switch ( _variableStatus[variable] )
+    {
+    case AT_LOWER:
+        return _lowerBounds[variable];
+
+    case AT_UPPER:
+        return _upperBounds[variable];
+
+    default:
+        return 0;
+    }
+}
+
+bool NativeLPSolver::isFixed( unsigned variable ) const
+{
+    return FloatUtils::areEqual( _lowerBounds[variable], _upperBounds[variable] );
+}
+
+void NativeLPSolver::computeBasicValues()
+{
+    unsigned m = _constraints.size();
+    if ( m == 0 )
+        return;
+
+    // B * xB = - sum_{j non-basic} A_j * x_j
+    std::fill_n( _work, m, 0 );
+    for ( unsigned i = 0; i < _variableStatus.size(); ++i )
+    {
+        if ( _variableStatus[i] == BASIC )
+            continue;
+
+        double value = getNonBasicValue( i );
+        if ( FloatUtils::isZero( value ) )
+            continue;
+
+        for ( const auto &entry : *_columns[i] )
+            _work[entry._index] -= entry._value * value;
+    }
+
+    _basisFactorization->forwardTransformation( _work, _basicValues );
+}
+
+bool NativeLPSolver::computeBasicCosts()
+{
+    // If some basic variable is out of bounds, the costs are those of
+    // phase one, i.e. the sum of infeasibilities. Otherwise, they are the
+    // objective's.
+    double tolerance = GlobalConfiguration::NATIVE_LP_SOLVER_FEASIBILITY_TOLERANCE;
+    unsigned m = _constraints.size();
+    bool phaseOne = false;
+
+    for ( unsigned i = 0; i < m; ++i )
+    {
+        unsigned variable = _basicVariables[i];
+        if ( _basicValues[i] < _lowerBounds[variable] - tolerance )
+        {
+            _basicCosts[i] = -1;
+            phaseOne = true;
+        }
+        else if ( _basicValues[i] > _upperBounds[variable] + tolerance )
+        {
+            _basicCosts[i] = 1;
+            phaseOne = true;
+        }
+        else
+        {
+            _basicCosts[i] = 0;
+        }
+    }
+
+    if ( !phaseOne )
+    {
+        for ( unsigned i = 0; i < m; ++i )
+        {
+            unsigned variable = _basicVariables[i];
+            _basicCosts[i] = _objective.exists( variable ) ?
+                _costSign * _objective[variable] : 0;
+        }
+    }
+
+    return phaseOne;
+}
+
+NativeLPSolver::SolverStatus NativeLPSolver::runSimplex()
+{
+    double tolerance = GlobalConfiguration::NATIVE_LP_SOLVER_FEASIBILITY_TOLERANCE;
+    unsigned n = _lowerBounds.size();
+    unsigned m = _constraints.size();
+    unsigned maxIterations = 50 * ( n + m ) + 1000;
+    unsigned degeneratePivots = 0;
+
+    struct timespec start = TimeUtils::sampleMicro();
+    unsigned long long timeoutInMicroSeconds = FloatUtils::isFinite( _timeoutInSeconds ) ?
+        (unsigned long long)( _timeoutInSeconds * 1000000 ) : 0;
+
+    refactorize();
+
+    while ( true )
+    {
+        if ( _numberOfIterations >= maxIterations )
+            return TIMEOUT;
+
+        if ( timeoutInMicroSeconds > 0 && _numberOfIterations % 100 == 0 )
+        {
+            struct timespec now = TimeUtils::sampleMicro();
+            if ( TimeUtils::timePassed( start, now ) > timeoutInMicroSeconds )
+                return TIMEOUT;
+        }
+
+        computeBasicValues();
+        bool phaseOne = computeBasicCosts();
+        if ( m > 0 )
+            _basisFactorization->backwardTransformation( _basicCosts, _multipliers );
+
+        // Pricing: Dantzig's rule, or Bland's rule once the search stalls
+        bool useBland = degeneratePivots >
+            GlobalConfiguration::NATIVE_LP_SOLVER_DEGENERATE_PIVOTS_BEFORE_BLAND;
+        unsigned entering = n;
+        double enteringDirection = 0;
+        double bestScore = 0;
+
+        for ( unsigned j = 0; j < n; ++j )
+        {
+            if ( _variableStatus[j] == BASIC )
+                continue;
+
+            if ( _variableStatus[j] != AT_ZERO && isFixed( j ) )
+                continue;
+
+            double reducedCost = 0;
+            if ( !phaseOne && _objective.exists( j ) )
+                reducedCost = _costSign * _objective[j];
+            for ( const auto &entry : *_columns[j] )
+                reducedCost -= _multipliers[entry._index] * entry._value;
+
+            double direction = 0;
+            if ( reducedCost < -GlobalConfiguration::ENTRY_ELIGIBILITY_TOLERANCE &&
+                 _variableStatus[j] != AT_UPPER )
+                direction = 1;
+            else if ( reducedCost > GlobalConfiguration::ENTRY_ELIGIBILITY_TOLERANCE &&
+                      _variableStatus[j] != AT_LOWER )
+                direction = -1;
+
+            if ( direction == 0 )
+                continue;
+
+            if ( FloatUtils::abs( reducedCost ) > bestScore )
+            {
+                entering = j;
+                enteringDirection = direction;
+                bestScore = FloatUtils::abs( reducedCost );
+
+                if ( useBland )
+                    break;
+            }
+        }
+
+        if ( entering == n )
+            return phaseOne ? INFEASIBLE : OPTIMAL;
+
+        ++_numberOfIterations;
+
+        // Ratio test. As the entering variable moves by t in its
+        // direction, basic variable i changes by -direction * t * alpha_i.
+        double stepLimit = FloatUtils::infinity();
+        unsigned leavingRow = m;
+        VariableStatus leavingStatus = AT_LOWER;
+        double leavingPivot = 0;
+
+        if ( m > 0 )
+        {
+            _columns[entering]->toDense( _denseColumn );
+            _basisFactorization->forwardTransformation( _denseColumn, _changeColumn );
+        }
+
+        for ( unsigned i = 0; i < m; ++i )
+        {
+            double alpha = _changeColumn[i];
+            if ( FloatUtils::abs( alpha ) < GlobalConfiguration::PIVOT_CHANGE_COLUMN_TOLERANCE )
+                continue;
+
+            unsigned variable = _basicVariables[i];
+            double rate = -enteringDirection * alpha;
+            double value = _basicValues[i];
+            double lb = _lowerBounds[variable];
+            double ub = _upperBounds[variable];
+
+            double limit = FloatUtils::infinity();
+            VariableStatus status = AT_LOWER;
+
+            if ( rate < 0 )
+            {
+                // Decreasing: blocked by the upper bound if it is currently
+                // above it, and otherwise by its lower bound
+                if ( value > ub + tolerance )
+                {
+                    limit = ( value - ub ) / -rate;
+                    status = AT_UPPER;
+                }
+                else if ( value >= lb - tolerance && FloatUtils::isFinite( lb ) )
+                {
+                    limit = FloatUtils::max( value - lb, 0 ) / -rate;
+                    status = AT_LOWER;
+                }
+            }
+            else
+            {
+                if ( value < lb - tolerance )
+                {
+                    limit = ( lb - value ) / rate;
+                    status = AT_LOWER;
+                }
+                else if ( value <= ub + tolerance && FloatUtils::isFinite( ub ) )
+                {
+                    limit = FloatUtils::max( ub - value, 0 ) / rate;
+                    status = AT_UPPER;
+                }
+            }
+
+            if ( !FloatUtils::isFinite( limit ) )
+                continue;
+
+            // Prefer large pivots among (almost) tied candidates
+            if ( limit < stepLimit - tolerance ||
+                 ( limit <= stepLimit + tolerance &&
+                   FloatUtils::abs( alpha ) > FloatUtils::abs( leavingPivot ) ) )
+            {
+                stepLimit = limit;
+                leavingRow = i;
+                leavingStatus = status;
+                leavingPivot = alpha;
+            }
+        }
+
+        // The entering variable may hit its own opposite bound first
+        double range = _upperBounds[entering] - _lowerBounds[entering];
+        if ( _variableStatus[entering] != AT_ZERO &&
+             FloatUtils::isFinite( range ) && range <= stepLimit )
+        {
+            _variableStatus[entering] =
+                ( _variableStatus[entering] == AT_LOWER ) ? AT_UPPER : AT_LOWER;
+            degeneratePivots = 0;
+            continue;
+        }
+
+        if ( leavingRow == m )
+        {
+            // Phase one is bounded below by zero, so this only happens in
+            // phase two, unless numerical trouble strikes
+            return phaseOne ? TIMEOUT : UNBOUNDED;
+        }
+
+        if ( stepLimit < tolerance )
+            ++degeneratePivots;
+        else
+            degeneratePivots = 0;
+
+        unsigned leaving = _basicVariables[leavingRow];
+        _variableStatus[leaving] = leavingStatus;
+        _variableStatus[entering] = BASIC;
+        _basicVariables[leavingRow] = entering;
+
+        _basisFactorization->updateToAdjacentBasis( leavingRow, _changeColumn, _denseColumn );
+    }
+}
+
+void NativeLPSolver::computeSolution()
+{
+    unsigned n = _lowerBounds.size();
+
+    _solution.clear();
+    for ( unsigned i = 0; i < n; ++i )
+        _solution.append( _variableStatus[i] == BASIC ? 0 : getNonBasicValue( i ) );
+
+    for ( unsigned i = 0; i < _basicVariables.size(); ++i )
+        _solution[_basicVariables[i]] = _basicValues[i];
+
+    _optimalValue = _objectiveConstant;
+    for ( const auto &term : _objective )
+        _optimalValue += term.second * _solution[term.first];
+}
+
+void NativeLPSolver::solve()
+{
+    reset();
+
+    for ( unsigned i = 0; i < _lowerBounds.size(); ++i )
+    {
+        if ( FloatUtils::gt( _lowerBounds[i], _upperBounds[i],
+                             GlobalConfiguration::NATIVE_LP_SOLVER_FEASIBILITY_TOLERANCE ) )
+        {
+            _status = INFEASIBLE;
+            return;
+        }
+    }
+
+    if ( _structureChanged )
+        rebuildColumns();
+
+    initializeBasis();
+    adjustNonBasicStatuses();
+    allocateWorkMemory( _constraints.size() );
+
+    try
+    {
+        _status = runSimplex();
+    }
+    catch ( const MalformedBasisException & )
+    {
+        // The warm-start basis (or an update) turned out singular: start
+        // over from the slack basis, which is always valid
+        NATIVE_LP_LOG( "Singular basis, restarting from the slack basis" );
+        setSlackBasis();
+        adjustNonBasicStatuses();
+
+        try
+        {
+            _status = runSimplex();
+        }
+        catch ( const MalformedBasisException & )
+        {
+            // Give up: no bound is reported
+            _status = TIMEOUT;
+        }
+    }
+
+    NATIVE_LP_LOG( Stringf( "Status: %u after %u iterations", _status, _numberOfIterations ).ascii() );
+
+    if ( _status != OPTIMAL )
+        return;
+
+    computeSolution();
+
+    // Report a cutoff if the optimum does not improve on the cutoff value
+    if ( _cutoffInUse )
+    {
+        if ( ( _costSign > 0 && _optimalValue > _cutoff ) ||
+             ( _costSign < 0 && _optimalValue < _cutoff ) )
+            _status = CUTOFF;
+    }
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,216 @@
+/*********************                                                        */
+/*! \file NativeLPSolver.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** An LP solver that does not depend on an external library: a bounded
+ ** primal simplex, using Marabou's own basis factorizations for the
+ ** FTRAN/BTRAN operations. It is meant for the LP relaxations of the
+ ** bound tightening procedures, which solve many similar LPs in a row:
+ ** the basis is kept across bound and objective changes, and across
+ ** rebuilding a model with the same shape, so that consecutive solves
+ ** are warm-started.
+ **
+ ** Each constraint sum a_j x_j (<=, >=, =) b is stored as an equation
+ ** sum a_j x_j - r = 0 over a new auxiliary variable r, bounded
+ ** according to the constraint type. The auxiliary variables form the
+ ** initial basis.
+ **
+ ** Binary variables are relaxed to [0, 1]: the solver only solves LPs.
+
+ **/
+
+#ifndef __NativeLPSolver_h__
+#define __NativeLPSolver_h__
+
+#include "IBasisFactorization.h"
+#include "ILPSolver.h"
+#include "MString.h"
+#include "Map.h"
+#include "SparseUnsortedList.h"
+#include "Vector.h"
+
+#include <climits>
+
+#define NATIVE_LP_LOG( x, ... ) LOG( GlobalConfiguration::NATIVE_LP_SOLVER_LOGGING, "NativeLPSolver: %s\n", x )
+
+class NativeLPSolver : public ILPSolver, public IBasisFactorization::BasisColumnOracle
+{
+public:
+    NativeLPSolver();
+    ~NativeLPSolver();
+
+    void addVariable( unsigned variable, double lb, double ub, VariableType type = CONTINUOUS );
+
+    void setLowerBound( unsigned variable, double lb );
+    void setUpperBound( unsigned variable, double ub );
+    double getLowerBound( unsigned variable );
+    double getUpperBound( unsigned variable );
+
+    void addLeqConstraint( const List<Term> &terms, double scalar );
+    void addGeqConstraint( const List<Term> &terms, double scalar );
+    void addEqConstraint( const List<Term> &terms, double scalar );
+
+    void setCost( const List<Term> &terms, double constant = 0 );
+    void setObjective( const List<Term> &terms, double constant = 0 );
+    double getOptimalCostOrObjective();
+
+    void setCutoff( double cutoff );
+
+    bool optimal();
+    bool cutoffOccurred();
+    bool infeasible();
+    bool timeout();
+    bool haveFeasibleSolution();
+
+    void setTimeLimit( double seconds );
+    void setVerbosity( unsigned verbosity );
+    void setNumberOfThreads( unsigned threads );
+
+    void solve();
+    void extractSolution( Map<unsigned, double> &values, double &costOrObjective );
+    double getObjectiveBound();
+
+    double getAssignment( unsigned variable );
+    bool existsAssignment( unsigned variable );
+
+    unsigned getNumberOfSimplexIterations();
+
+    void reset();
+    void resetModel();
+
+    /*
+      Methods of the BasisColumnOracle interface
+    */
+    void getColumnOfBasis( unsigned column, double *result ) const;
+    void getColumnOfBasis( unsigned column, SparseUnsortedList *result ) const;
+    void getSparseBasis( SparseColumnsOfBasis &basis ) const;
+
+private:
+    enum SolverStatus {
+        UNSOLVED = 0,
+        OPTIMAL = 1,
+        INFEASIBLE = 2,
+        UNBOUNDED = 3,
+        CUTOFF = 4,
+        TIMEOUT = 5,
+    };
+
+    enum VariableStatus {
+        BASIC = 0,
+        AT_LOWER = 1,
+        AT_UPPER = 2,
+        // A free non-basic variable, fixed at zero
+        AT_ZERO = 3,
+    };
+
+    struct Constraint
+    {
+        Map<unsigned, double> _coefficients;
+        unsigned _auxVariable;
+    };
+
+    /*
+      The model. Structural and auxiliary variables share one index
+      space, in order of creation, so that adding to the model never
+      renumbers existing variables. _handleToIndex maps the caller's
+      handles to this index space, with NO_INDEX for unused handles.
+    */
+    static const unsigned NO_INDEX = UINT_MAX;
+    Vector<unsigned> _handleToIndex;
+    Vector<double> _lowerBounds;
+    Vector<double> _upperBounds;
+    Vector<Constraint> _constraints;
+
+    /*
+      The objective, always minimized internally: _objective holds the
+      user's coefficients, and _costSign is -1 when maximizing.
+    */
+    Map<unsigned, double> _objective;
+    double _objectiveConstant;
+    double _costSign;
+    double _cutoff;
+    bool _cutoffInUse;
+
+    /*
+      The columns of the constraint matrix, rebuilt lazily when the
+      model's structure changes.
+    */
+    Vector<SparseUnsortedList *> _columns;
+    bool _structureChanged;
+
+    /*
+      The basis. _basicVariables[i] is the variable basic in row i.
+      The statuses of the previous model are remembered across
+      resetModel(), for warm-starting a model of the same shape.
+    */
+    Vector<unsigned> _basicVariables;
+    Vector<VariableStatus> _variableStatus;
+    Vector<unsigned> _previousBasicVariables;
+    Vector<VariableStatus> _previousVariableStatus;
+
+    IBasisFactorization *_basisFactorization;
+    unsigned _factorizationSize;
+
+    /*
+      Work memory, of size m
+    */
+    double *_basicValues;
+    double *_basicCosts;
+    double *_multipliers;
+    double *_changeColumn;
+    double *_denseColumn;
+    double *_work;
+    unsigned _workSize;
+
+    /*
+      The outcome of the last solve
+    */
+    SolverStatus _status;
+    Vector<double> _solution;
+    double _optimalValue;
+    unsigned _numberOfIterations;
+    double _timeoutInSeconds;
+
+    bool handleInUse( unsigned variable ) const;
+    unsigned getVariableIndex( unsigned variable ) const;
+    void addConstraint( const List<Term> &terms, double lb, double ub );
+    void setObjectiveFunction( const List<Term> &terms, double constant, double costSign );
+    void modelChanged();
+
+    /*
+      Prepare the columns, the basis and the work memory for solving
+    */
+    void rebuildColumns();
+    void initializeBasis();
+    void adjustNonBasicStatuses();
+    void setSlackBasis();
+    void allocateWorkMemory( unsigned m );
+    void freeWorkMemory();
+    void freeColumns();
+    void refactorize();
+
+    /*
+      The simplex itself. runSimplex() returns the final status.
+    */
+    SolverStatus runSimplex();
+    double getNonBasicValue( unsigned variable ) const;
+    void computeBasicValues();
+    bool computeBasicCosts();
+    void computeSolution();
+    bool isFixed( unsigned variable ) const;
+};
+
+#endif // __NativeLPSolver_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,97 @@
+/*********************                                                        */
+/*! \file PartialPricingRule.cpp
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "FloatUtils.h"
+#include "GlobalConfiguration.h"
+#include "ITableau.h"
+#include "PartialPricingRule.h"
+#include "Statistics.h"
+
+PartialPricingRule::PartialPricingRule()
+    : _windowStart( 0 )
+    , _searchEnd( 0 )
+{
+}
+
+bool PartialPricingRule::select( ITableau &tableau,
+                                 const unsigned * /* candidates */,
+                                 unsigned /* numberOfCandidates */,
+                                 const Bitset &excluded )
+{
+    const double *costFunction = tableau.getCostFunction();
+    unsigned numberOfNonBasics = tableau.getN() - tableau.getM();
+    if ( numberOfNonBasics == 0 )
+        return false;
+
+    if ( _windowStart >= numberOfNonBasics )
+        _windowStart = 0;
+
+    bool found = false;
+    unsigned maxIndex = 0;
+    double maxValue = 0;
+
+    unsigned scanned = 0;
+    unsigned index = _windowStart;
+    while ( scanned < numberOfNonBasics )
+    {
+        if ( !excluded.exists( index ) && tableau.eligibleForEntry( index, costFunction ) )
+        {
+            double contenderValue = FloatUtils::abs( costFunction[index] );
+            if ( !found || FloatUtils::gt( contenderValue, maxValue ) )
+            {
+                found = true;
+                maxIndex = index;
+                maxValue = contenderValue;
+            }
+        }
+
+        ++scanned;
+        ++index;
+        if ( index == numberOfNonBasics )
+            index = 0;
+
+        // Stop at the end of the first window that has a candidate
+        if ( found && scanned % GlobalConfiguration::PARTIAL_PRICING_WINDOW_SIZE == 0 )
+            break;
+    }
+
+    if ( _statistics )
+        _statistics->incLongAttribute( Statistics::NUM_PRICING_CANDIDATES_SCANNED,
+                                       scanned );
+
+    if ( !found )
+        return false;
+
+    _searchEnd = index;
+    tableau.setEnteringVariableIndex( maxIndex );
+    return true;
+}
+
+void PartialPricingRule::postPivotHook( const ITableau & /* tableau */, bool /* fakePivot */ )
+{
+    _windowStart = _searchEnd;
+}
+
+void PartialPricingRule::resizeHook( const ITableau & /* tableau */ )
+{
+    _windowStart = 0;
+    _searchEnd = 0;
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
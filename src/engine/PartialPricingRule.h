@@ -0,0 +1,69 @@
+/*********************                                                        */
+/*! \file PartialPricingRule.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#ifndef __PartialPricingRule_h__
+#define __PartialPricingRule_h__
+
+#include "EntrySelectionStrategy.h"
+
+class PartialPricingRule : public EntrySelectionStrategy
+{
+public:
+    PartialPricingRule();
+
+    /*
+      Apply Dantzig's rule to a window of consecutive non-basic
+      variables, starting at the current window. If no variable in the
+      window is eligible, move on to the next window, wrapping around,
+      until all non-basic variables have been priced.
+    */
+    bool select( ITableau &tableau,
+                 const unsigned *candidates,
+                 unsigned numberOfCandidates,
+                 const Bitset &excluded );
+
+    bool requiresEntryCandidates() const
+    {
+        return false;
+    }
+
+    /*
+      After a pivot, the next search starts where this one stopped.
+    */
+    void postPivotHook( const ITableau &tableau, bool fakePivot );
+
+    void resizeHook( const ITableau &tableau );
+
+    unsigned getWindowStart() const
+    {
+        return _windowStart;
+    }
+
+private:
+    /*
+      The first non-basic index of the current window, and the index
+      at which the last successful search ended.
+    */
+    unsigned _windowStart;
+    unsigned _searchEnd;
+};
+
+#endif // __PartialPricingRule_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -374,6 +374,17 @@ public:
      */
     void cdoCleanup();
 
+    /*
+       Return true iff, once its CDOs are initialized and a bound manager
+       is registered, all of the constraint's search state is restored by
+       backtracking the context. The SMT core need not store copies of such
+       constraints when splitting.
+     */
+    virtual bool supportsContextDependentState() const
+    {
+        return false;
+    }
+
     /**********************************************************************/
     /*             Context-dependent Search State Interface               */
     /**********************************************************************/
@@ -392,6 +403,11 @@ public:
      */
     virtual PhaseStatus nextFeasibleCase();
 
+    /*
+       Check whether a case is marked as infeasible under current search prefix.
+     */
+    bool isCaseInfeasible( PhaseStatus phase ) const;
+
     /*
        Returns number of cases not yet marked as infeasible.
      */
@@ -509,11 +525,6 @@ protected:
      */
     void initializeDuplicateCDOs( PiecewiseLinearConstraint *clone ) const;
 
-    /*
-       Check whether a case is marked as infeasible under current search prefix.
-     */
-    bool isCaseInfeasible( PhaseStatus phase ) const;
-
     /**********************************************************************/
     /*                         BOUND WRAPPER METHODS                      */
     /**********************************************************************/
@@ -581,7 +592,7 @@ protected:
     inline bool existsAssignment( unsigned variable ) const
     {
         if ( _gurobi )
-            return _gurobi->existsAssignment( Stringf( "x%u", variable ) );
+            return _gurobi->existsAssignment( variable );
         else if ( _tableau )
             return _tableau->existsValue( variable );
         else
@@ -595,7 +606,7 @@ protected:
             return _tableau->getValue( variable );
         }
         else
-            return _gurobi->getAssignment( Stringf( "x%u", variable ) );
+            return _gurobi->getAssignment( variable );
     }
 };
 
@@ -0,0 +1,33 @@
+/*********************                                                        */
+/*! \file PricingStrategy.h
+** \verbatim
+** This file is part of the Marabou project.
+** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved. See the file COPYING in the top-level source
+** directory for licensing information.\endverbatim
+**
+** [[ Add lengthier description here ]]
+
+**/
+
+#ifndef __PricingStrategy_h__
+#define __PricingStrategy_h__
+
+enum class PricingStrategy
+{
+    // Projected steepest edge over all eligible non-basic variables
+    PROJECTED_STEEPEST_EDGE,
+    // Largest cost coefficient over all eligible non-basic variables
+    DANTZIG,
+    // Smallest eligible variable index (anti-cycling)
+    BLAND,
+    // Largest cost coefficient within a rotating window of the
+    // non-basic variables
+    PARTIAL,
+    // Largest cost coefficient among a short list of candidates,
+    // refreshed by a full pricing pass once it runs dry
+    MULTIPLE,
+};
+
+#endif // __PricingStrategy_h__
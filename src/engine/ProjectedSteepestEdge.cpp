@@ -110,26 +110,10 @@ void ProjectedSteepestEdgeRule::resetReferenceSpace( const ITableau &tableau )
 }
 
 bool ProjectedSteepestEdgeRule::select( ITableau &tableau,
-                                        const List<unsigned> &candidates,
-                                        const Set<unsigned> &excluded )
+                                        const unsigned *candidates,
+                                        unsigned numberOfCandidates,
+                                        const Bitset &excluded )
 {
-    List<unsigned> remainingCandidates = candidates;
-
-    List<unsigned>::iterator it = remainingCandidates.begin();
-    while ( it != remainingCandidates.end() )
-    {
-        if ( excluded.exists( *it ) )
-            it = remainingCandidates.erase( it );
-        else
-            ++it;
-    }
-
-    if ( remainingCandidates.empty() )
-    {
-        PSE_LOG( "No candidates, select returning false" );
-        return false;
-    }
-
     // Obtain the cost function
     const double *costFunction = tableau.getCostFunction();
 
@@ -144,28 +128,32 @@ bool ProjectedSteepestEdgeRule::select( ITableau &tableau,
       is maximal.
     */
 
-    it = remainingCandidates.begin();
-    unsigned bestCandidate = *it;
-    double gammaValue = _gamma[*it];
-    double bestValue =
-        ( gammaValue < DBL_EPSILON ) ? 0 : ( costFunction[*it] * costFunction[*it] ) / gammaValue;
-
-    ++it;
+    bool found = false;
+    unsigned bestCandidate = 0;
+    double bestValue = 0;
 
-    while ( it != remainingCandidates.end() )
+    for ( unsigned i = 0; i < numberOfCandidates; ++i )
     {
-        unsigned contender = *it;
-        gammaValue = _gamma[*it];
+        unsigned contender = candidates[i];
+        if ( excluded.exists( contender ) )
+            continue;
+
+        double gammaValue = _gamma[contender];
         double contenderValue =
-            ( gammaValue < DBL_EPSILON ) ? 0 : ( costFunction[*it] * costFunction[*it] ) / gammaValue;
+            ( gammaValue < DBL_EPSILON ) ? 0 : ( costFunction[contender] * costFunction[contender] ) / gammaValue;
 
-        if ( contenderValue > bestValue )
+        if ( !found || contenderValue > bestValue )
         {
+            found = true;
             bestCandidate = contender;
             bestValue = contenderValue;
         }
+    }
 
-        ++it;
+    if ( !found )
+    {
+        PSE_LOG( "No candidates, select returning false" );
+        return false;
     }
 
     tableau.setEnteringVariableIndex( bestCandidate );
@@ -36,8 +36,9 @@ public:
       Apply the projected steepest edge pivot selection rule.
     */
     bool select( ITableau &tableau,
-                 const List<unsigned> &candidates,
-                 const Set<unsigned> &excluded );
+                 const unsigned *candidates,
+                 unsigned numberOfCandidates,
+                 const Bitset &excluded );
 
     /*
       We use this hook to update gamma according to the entering
@@ -62,6 +62,15 @@ public:
     */
     void restoreState( const PiecewiseLinearConstraint *state ) override;
 
+    /*
+      Besides its phase, activity and bounds, a ReLU keeps no state that
+      changes during the search
+    */
+    bool supportsContextDependentState() const override
+    {
+        return true;
+    }
+
     /*
       Register/unregister the constraint with a talbeau.
      */
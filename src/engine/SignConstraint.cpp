@@ -122,7 +122,7 @@ bool SignConstraint::satisfied() const
 
 List<PiecewiseLinearCaseSplit> SignConstraint::getCaseSplits() const
 {
-    if ( _phaseStatus != PHASE_NOT_FIXED )
+    if ( getPhaseStatus() != PHASE_NOT_FIXED )
         throw MarabouError( MarabouError::REQUESTED_CASE_SPLITS_FROM_FIXED_CONSTRAINT );
 
     List<PiecewiseLinearCaseSplit> splits;
@@ -167,7 +167,7 @@ List<PiecewiseLinearCaseSplit> SignConstraint::getCaseSplits() const
 
 List<PhaseStatus> SignConstraint::getAllCases() const
 {
-    if ( _phaseStatus != PHASE_NOT_FIXED )
+    if ( getPhaseStatus() != PHASE_NOT_FIXED )
         throw MarabouError( MarabouError::REQUESTED_CASE_SPLITS_FROM_FIXED_CONSTRAINT );
 
     if ( _direction == SIGN_PHASE_NEGATIVE )
@@ -219,7 +219,7 @@ PiecewiseLinearCaseSplit SignConstraint::getPositiveSplit() const
 
 bool SignConstraint::phaseFixed() const
 {
-    return _phaseStatus != PHASE_NOT_FIXED;
+    return getPhaseStatus() != PHASE_NOT_FIXED;
 }
 
 void SignConstraint::addAuxiliaryEquationsAfterPreprocessing( InputQuery
@@ -277,9 +277,9 @@ void SignConstraint::addAuxiliaryEquationsAfterPreprocessing( InputQuery
 
 PiecewiseLinearCaseSplit SignConstraint::getImpliedCaseSplit() const
 {
-    ASSERT( _phaseStatus != PHASE_NOT_FIXED );
+    ASSERT( getPhaseStatus() != PHASE_NOT_FIXED );
 
-    if ( _phaseStatus == PhaseStatus::SIGN_PHASE_POSITIVE )
+    if ( getPhaseStatus() == PhaseStatus::SIGN_PHASE_POSITIVE )
         return getPositiveSplit();
 
     return getNegativeSplit();
@@ -536,22 +536,22 @@ void SignConstraint::eliminateVariable( __attribute__((unused)) unsigned variabl
 
                   if ( FloatUtils::areEqual( fixedValue, 1 ) )
                   {
-                      ASSERT( _phaseStatus != SIGN_PHASE_NEGATIVE );
+                      ASSERT( getPhaseStatus() != SIGN_PHASE_NEGATIVE );
                   }
                   else if (FloatUtils::areEqual( fixedValue, -1 ) )
                   {
-                      ASSERT( _phaseStatus != SIGN_PHASE_POSITIVE );
+                      ASSERT( getPhaseStatus() != SIGN_PHASE_POSITIVE );
                   }
               }
               else if ( variable == _b )
               {
                   if ( FloatUtils::gte( fixedValue, 0 ) )
                   {
-                      ASSERT( _phaseStatus != SIGN_PHASE_NEGATIVE );
+                      ASSERT( getPhaseStatus() != SIGN_PHASE_NEGATIVE );
                   }
                   else if ( FloatUtils::lt( fixedValue, 0 ) )
                   {
-                      ASSERT( _phaseStatus != SIGN_PHASE_POSITIVE );
+                      ASSERT( getPhaseStatus() != SIGN_PHASE_POSITIVE );
                   }
               }
         });
@@ -574,8 +574,8 @@ void SignConstraint::dump( String &output ) const
 {
     output = Stringf( "SignConstraint: x%u = Sign( x%u ). Active? %s. PhaseStatus = %u (%s). ",
                       _f, _b,
-                      _constraintActive ? "Yes" : "No",
-                      _phaseStatus, phaseToString( _phaseStatus ).ascii()
+                      isActive() ? "Yes" : "No",
+                      getPhaseStatus(), phaseToString( getPhaseStatus() ).ascii()
                       );
 
     output += Stringf( "b in [%s, %s], ",
@@ -71,6 +71,15 @@ public:
     */
     void restoreState( const PiecewiseLinearConstraint *state ) override;
 
+    /*
+      The search state of a sign constraint is its phase, activity and
+      bounds, all of which are context-dependent
+    */
+    bool supportsContextDependentState() const override
+    {
+        return true;
+    }
+
     /*
       Register/unregister the constraint with a talbeau.
      */
@@ -25,6 +25,7 @@
 #include "PseudoImpactTracker.h"
 #include "ReluConstraint.h"
 #include "SmtCore.h"
+#include "TraceRecorder.h"
 
 SmtCore::SmtCore( IEngine *engine )
     : _statistics( NULL )
@@ -57,9 +58,29 @@ void SmtCore::freeMemory()
     _stack.clear();
 }
 
+EngineState *SmtCore::storeEngineStateIfNeeded( TableauStateStorageLevel level )
+{
+    if ( _engine->searchStateIsContextDependent() )
+        return NULL;
+
+    EngineState *state = new EngineState;
+    state->_stateId = _stateId;
+    ++_stateId;
+    _engine->storeState( *state, level );
+    return state;
+}
+
 void SmtCore::reset()
 {
     freeMemory();
+
+    // Backtrack whatever the previous query left on the stack
+    if ( _context.getLevel() > 0 )
+    {
+        _context.popto( 0 );
+        _engine->postContextPopHook();
+    }
+
     _impliedValidSplitsAtRoot.clear();
     _needToSplit = false;
     _constraintForSplitting = NULL;
@@ -132,6 +153,7 @@ bool SmtCore::needToSplit() const
 
 void SmtCore::performSplit()
 {
+    MARABOU_TRACE_SPAN( "smt", "split" );
     ASSERT( _needToSplit );
 
     _numRejectedPhasePatternProposal = 0;
@@ -163,12 +185,10 @@ void SmtCore::performSplit()
     ASSERT( splits.size() >= 2 ); // Not really necessary, can add code to handle this case.
     _constraintForSplitting->setActiveConstraint( false );
 
-    // Obtain the current state of the engine
-    EngineState *stateBeforeSplits = new EngineState;
-    stateBeforeSplits->_stateId = _stateId;
-    ++_stateId;
-    _engine->storeState( *stateBeforeSplits,
-                         TableauStateStorageLevel::STORE_BOUNDS_ONLY );
+    // Obtain the current state of the engine, unless it is restored by
+    // popping the context
+    EngineState *stateBeforeSplits = storeEngineStateIfNeeded
+        ( TableauStateStorageLevel::STORE_BOUNDS_ONLY );
     _engine->preContextPushHook();
     pushContext();
     SmtStackEntry *stackEntry = new SmtStackEntry;
@@ -239,6 +259,7 @@ void SmtCore::pushContext()
 
 bool SmtCore::popSplit()
 {
+    MARABOU_TRACE_SPAN( "smt", "pop" );
     SMT_LOG( "Performing a pop" );
 
     if ( _stack.empty() )
@@ -290,9 +311,14 @@ bool SmtCore::popSplit()
         popContext();
         _engine->postContextPopHook();
         // Restore the state of the engine
-        SMT_LOG( "\tRestoring engine state..." );
-        _engine->restoreState( *( stackEntry->_engineState ) );
-        SMT_LOG( "\tRestoring engine state - DONE" );
+        if ( stackEntry->_engineState )
+        {
+            SMT_LOG( "\tRestoring engine state..." );
+            _engine->restoreState( *( stackEntry->_engineState ) );
+            SMT_LOG( "\tRestoring engine state - DONE" );
+        }
+        else
+            resetSplitConditions();
 
         // Apply the new split and erase it from the list
         auto split = stackEntry->_alternativeSplits.begin();
@@ -511,12 +537,10 @@ void SmtCore::replaySmtStackEntry( SmtStackEntry *stackEntry )
     }
 
     // Obtain the current state of the engine
-    EngineState *stateBeforeSplits = new EngineState;
-    stateBeforeSplits->_stateId = _stateId;
-    ++_stateId;
-    _engine->storeState( *stateBeforeSplits,
-                         TableauStateStorageLevel::STORE_ENTIRE_TABLEAU_STATE );
-    stackEntry->_engineState = stateBeforeSplits;
+    stackEntry->_engineState = storeEngineStateIfNeeded
+        ( TableauStateStorageLevel::STORE_ENTIRE_TABLEAU_STATE );
+    _engine->preContextPushHook();
+    pushContext();
 
     // Apply all the splits
     _engine->applySplit( stackEntry->_activeSplit );
@@ -255,6 +255,13 @@ private:
       current search state.
     */
     unsigned _numRejectedPhasePatternProposal;
+
+    /*
+      Store the state of the engine before a split. Returns NULL if the
+      engine's search state is restored by popping the context, in which
+      case nothing needs to be stored.
+    */
+    EngineState *storeEngineStateIfNeeded( TableauStateStorageLevel level );
 };
 
 #endif // __SmtCore_h__
@@ -23,6 +23,8 @@
   A stack entry consists of the engine state before the split,
   the active split, the alternative splits (in case of backtrack),
   and also any implied splits that were discovered subsequently.
+  The engine state is NULL when the engine's search state is
+  restored by popping the context.
 */
 struct SmtStackEntry
 {
@@ -33,6 +33,7 @@
 #include "TableauRow.h"
 #include "TableauState.h"
 
+#include <algorithm>
 #include <string.h>
 
 Tableau::Tableau( IBoundManager &boundManager )
@@ -44,12 +45,15 @@ Tableau::Tableau( IBoundManager &boundManager )
     , _A( NULL )
     , _sparseColumnsOfA( NULL )
     , _sparseRowsOfA( NULL )
-    , _denseA( NULL )
+    , _denseAColumn( NULL )
     , _changeColumn( NULL )
     , _pivotRow( NULL )
     , _b( NULL )
     , _workM( NULL )
     , _workN( NULL )
+    , _breakpointRatios( NULL )
+    , _breakpointIndices( NULL )
+    , _numBreakpointsPassed( 0 )
     , _unitVector( NULL )
     , _basisFactorization( NULL )
     , _multipliers( NULL )
@@ -64,6 +68,7 @@ Tableau::Tableau( IBoundManager &boundManager )
     , _costFunctionManager( NULL )
     , _rhsIsAllZeros( true )
     , _lpSolverType( Options::get()->getLPSolverType() )
+    , _useLongStepRatioTest( Options::get()->getBool( Options::LONG_STEP_RATIO_TEST ) )
     , _gurobi( nullptr )
 {
 }
@@ -111,10 +116,10 @@ void Tableau::freeMemoryIfNeeded()
         _sparseRowsOfA = NULL;
     }
 
-    if ( _denseA )
+    if ( _denseAColumn )
     {
-        delete[] _denseA;
-        _denseA = NULL;
+        delete[] _denseAColumn;
+        _denseAColumn = NULL;
     }
 
     if ( _changeColumn )
@@ -200,6 +205,18 @@ void Tableau::freeMemoryIfNeeded()
         delete[] _workN;
         _workN = NULL;
     }
+
+    if ( _breakpointRatios )
+    {
+        delete[] _breakpointRatios;
+        _breakpointRatios = NULL;
+    }
+
+    if ( _breakpointIndices )
+    {
+        delete[] _breakpointIndices;
+        _breakpointIndices = NULL;
+    }
 }
 
 void Tableau::setDimensions( unsigned m, unsigned n )
@@ -219,7 +236,7 @@ void Tableau::setDimensions( unsigned m, unsigned n )
 
         for ( unsigned i = 0; i < n; ++i )
         {
-            _sparseColumnsOfA[i] = new SparseUnsortedList( _m );
+            _sparseColumnsOfA[i] = new SparseUnsortedList( _m, &_sparseListArena );
             if ( !_sparseColumnsOfA[i] )
                 throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::sparseColumnsOfA[i]" );
         }
@@ -230,14 +247,14 @@ void Tableau::setDimensions( unsigned m, unsigned n )
 
         for ( unsigned i = 0; i < m; ++i )
         {
-            _sparseRowsOfA[i] = new SparseUnsortedList( _n );
+            _sparseRowsOfA[i] = new SparseUnsortedList( _n, &_sparseListArena );
             if ( !_sparseRowsOfA[i] )
                 throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::sparseRowOfA[i]" );
         }
 
-        _denseA = new double[m*n];
-        if ( !_denseA )
-            throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::denseA" );
+        _denseAColumn = new double[m];
+        if ( !_denseAColumn )
+            throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::denseAColumn" );
 
         _changeColumn = new double[m];
         if ( !_changeColumn )
@@ -296,6 +313,14 @@ void Tableau::setDimensions( unsigned m, unsigned n )
         if ( !_workN )
             throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::work" );
 
+        _breakpointRatios = new double[m];
+        if ( !_breakpointRatios )
+            throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::breakpointRatios" );
+
+        _breakpointIndices = new unsigned[m];
+        if ( !_breakpointIndices )
+            throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::breakpointIndices" );
+
         if ( _statistics )
         {
             _statistics->setUnsignedAttribute( Statistics::CURRENT_TABLEAU_M, _m );
@@ -309,15 +334,17 @@ void Tableau::setConstraintMatrix( const double *A )
     _A->initialize( A, _m, _n );
 
     for ( unsigned column = 0; column < _n; ++column )
+        _sparseColumnsOfA[column]->clear();
+
+    for ( unsigned row = 0; row < _m; ++row )
     {
-        for ( unsigned row = 0; row < _m; ++row )
-            _denseA[column*_m + row] = A[row*_n + column];
+        _sparseRowsOfA[row]->initialize( A + ( row * _n ), _n );
 
-        _sparseColumnsOfA[column]->initialize( _denseA + ( column * _m ), _m );
+        for ( const auto &entry : *_sparseRowsOfA[row] )
+            _sparseColumnsOfA[entry._index]->append( row, entry._value );
     }
 
-    for ( unsigned row = 0; row < _m; ++row )
-        _sparseRowsOfA[row]->initialize( A + ( row * _n ), _n );
+    updateConstraintMatrixMemoryStatistics();
 }
 
 void Tableau::markAsBasic( unsigned variable )
@@ -470,7 +497,7 @@ bool Tableau::existsValue( unsigned variable ) const
 {
     if ( _lpSolverType == LPSolverType::GUROBI )
     {
-        return _gurobi->existsAssignment( Stringf( "x%u", variable ) );
+        return _gurobi->existsAssignment( variable );
     }
     else
     {
@@ -484,7 +511,7 @@ double Tableau::getValue( unsigned variable ) const
     if ( _lpSolverType == LPSolverType::GUROBI )
     {
         ASSERT( _gurobi );
-        return _gurobi->getAssignment( Stringf( "x%u", variable ) );
+        return _gurobi->getAssignment( variable );
     }
     else
     {
@@ -594,15 +621,17 @@ unsigned Tableau::getBasicStatusByIndex( unsigned basicIndex )
     return _basicStatus[basicIndex];
 }
 
-void Tableau::getEntryCandidates( List<unsigned> &candidates ) const
+unsigned Tableau::getEntryCandidates( unsigned *candidates ) const
 {
-    candidates.clear();
+    unsigned numberOfCandidates = 0;
     const double *costFunction = _costFunctionManager->getCostFunction();
     for ( unsigned i = 0; i < _n - _m; ++i )
     {
         if ( eligibleForEntry( i, costFunction ) )
-            candidates.append( i );
+            candidates[numberOfCandidates++] = i;
     }
+
+    return numberOfCandidates;
 }
 
 void Tableau::setEnteringVariableIndex( unsigned nonBasic )
@@ -703,6 +732,15 @@ void Tableau::performPivot()
     unsigned  nonBasic;
     (void) decrease;
     (void) nonBasic;
+
+    if ( _statistics && ( _numBreakpointsPassed > 0 ) )
+    {
+        _statistics->incLongAttribute( Statistics::NUM_TABLEAU_LONG_STEP_PIVOTS );
+        _statistics->incLongAttribute( Statistics::NUM_TABLEAU_LONG_STEP_BREAKPOINTS_PASSED,
+                                       _numBreakpointsPassed );
+    }
+    _numBreakpointsPassed = 0;
+
     if ( _leavingVariable == _m )
     {
         if ( _statistics )
@@ -946,7 +984,11 @@ void Tableau::pickLeavingVariable()
 
 void Tableau::pickLeavingVariable( double *changeColumn )
 {
-    if ( GlobalConfiguration::USE_HARRIS_RATIO_TEST )
+    _numBreakpointsPassed = 0;
+
+    if ( _useLongStepRatioTest && !isOptimizing() )
+        longStepRatioTest( changeColumn );
+    else if ( GlobalConfiguration::USE_HARRIS_RATIO_TEST )
         harrisRatioTest( changeColumn );
     else
         standardRatioTest( changeColumn );
@@ -1409,6 +1451,215 @@ void Tableau::harrisRatioTest( double *changeColumn )
     ASSERT( _leavingVariable != _m );
 }
 
+void Tableau::longStepRatioTest( double *changeColumn )
+{
+    /*
+      When looking for a feasible assignment, the Harris ratio test
+      stops at the first basic variable that hits a bound. If that
+      basic variable is out of bounds and is moving back towards its
+      range, reaching its violated bound only means that it stops
+      contributing to the cost function, and the entering variable may
+      keep moving for as long as the sum of infeasibilities keeps
+      decreasing. Each such bound is a breakpoint at which the slope of
+      the cost function grows by the basic's entry in the change
+      column. We pass breakpoints in increasing order until the slope
+      is no longer negative, and the basic variable of the last
+      breakpoint leaves the basis.
+
+      The step is still limited by the bounds of the basic variables
+      that are within bounds, by the bounds of the entering variable
+      (in which case a fake pivot is performed) and by the far bounds of
+      the out-of-bounds basic variables, which cannot leave the basis at
+      those bounds. If no breakpoint is passed, the result of the Harris
+      ratio test is kept.
+
+      Below, all ratios are the non-negative distance travelled by the
+      entering variable in its direction of change.
+    */
+
+    harrisRatioTest( changeColumn );
+
+    if ( ( _leavingVariable == _m ) || ( _costFunctionManager->getBasicCost( _leavingVariable ) == 0 ) )
+        return;
+
+    bool enteringDecreases = FloatUtils::isPositive( _costFunctionManager->getCostFunction()[_enteringVariable] );
+    double direction = enteringDecreases ? -1 : 1;
+
+    unsigned enteringVariable = _nonBasicIndexToVariable[_enteringVariable];
+    double enteringRange = enteringDecreases ?
+        _nonBasicAssignment[_enteringVariable] - getLowerBound( enteringVariable ) :
+        getUpperBound( enteringVariable ) - _nonBasicAssignment[_enteringVariable];
+
+    // The limit imposed by the entering variable and by the basic
+    // variables that are within bounds, relaxed as in the Harris
+    // ratio test; and the limit imposed by the far bounds
+    double hardLimit = enteringRange;
+    double farBoundLimit = FloatUtils::infinity();
+
+    // The rate of change of the cost function
+    double slope = 0;
+    unsigned numBreakpoints = 0;
+
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        if ( FloatUtils::abs( changeColumn[i] ) < GlobalConfiguration::PIVOT_CHANGE_COLUMN_TOLERANCE )
+            continue;
+
+        // The change in the basic per unit of distance travelled
+        double rate = -changeColumn[i] * direction;
+        unsigned basic = _basicIndexToVariable[i];
+        double basicCost = _costFunctionManager->getBasicCost( i );
+
+        if ( basicCost == 0 )
+        {
+            double bound = ( rate > 0 ) ? getUpperBound( basic ) : getLowerBound( basic );
+            double delta = GlobalConfiguration::HARRIS_RATIO_CONSTRAINT_ADDITIVE_TOLERANCE +
+                FloatUtils::abs( bound ) * GlobalConfiguration::HARRIS_RATIO_CONSTRAINT_MULTIPLICATIVE_TOLERANCE;
+            double relaxedBound = ( rate > 0 ) ? bound + delta : bound - delta;
+
+            double ratio = ( relaxedBound - _basicAssignment[i] ) / rate;
+            if ( ratio < 0 )
+                ratio = 0;
+            if ( ratio < hardLimit )
+                hardLimit = ratio;
+            continue;
+        }
+
+        slope += basicCost * rate;
+
+        // A basic moving away from its range does not limit the step
+        if ( ( basicCost > 0 ) == ( rate > 0 ) )
+            continue;
+
+        double nearBound = ( basicCost > 0 ) ? getUpperBound( basic ) : getLowerBound( basic );
+        double farBound = ( basicCost > 0 ) ? getLowerBound( basic ) : getUpperBound( basic );
+
+        double ratio = ( nearBound - _basicAssignment[i] ) / rate;
+        if ( ratio < 0 )
+            ratio = 0;
+        _breakpointRatios[i] = ratio;
+        _breakpointIndices[numBreakpoints] = i;
+        ++numBreakpoints;
+
+        double farRatio = ( farBound - _basicAssignment[i] ) / rate;
+        if ( farRatio < farBoundLimit )
+            farBoundLimit = farRatio;
+    }
+
+    // The slope should agree with the reduced cost of the entering variable
+    if ( !FloatUtils::isNegative( slope ) )
+        return;
+
+    double stepLimit = FloatUtils::min( hardLimit, farBoundLimit );
+    const double *ratios = _breakpointRatios;
+    std::sort( _breakpointIndices,
+               _breakpointIndices + numBreakpoints,
+               [ratios]( unsigned a, unsigned b ) { return ratios[a] < ratios[b]; } );
+
+    // Pass breakpoints while the cost function keeps decreasing
+    unsigned position = 0;
+    bool slopeTurned = false;
+    while ( ( position < numBreakpoints ) && ( _breakpointRatios[_breakpointIndices[position]] <= stepLimit ) )
+    {
+        slope += FloatUtils::abs( changeColumn[_breakpointIndices[position]] );
+        if ( !FloatUtils::isNegative( slope ) )
+        {
+            slopeTurned = true;
+            break;
+        }
+        ++position;
+    }
+
+    unsigned leaving = _m;
+    double leavingRatio = 0;
+
+    if ( slopeTurned )
+    {
+        // Among breakpoints at the same ratio, prefer the largest pivot
+        double ratio = _breakpointRatios[_breakpointIndices[position]];
+        unsigned first = position;
+        while ( ( first > 0 ) && FloatUtils::areEqual( _breakpointRatios[_breakpointIndices[first - 1]], ratio ) )
+            --first;
+
+        double largestPivot = 0;
+        for ( unsigned j = first;
+              ( j < numBreakpoints ) && FloatUtils::areEqual( _breakpointRatios[_breakpointIndices[j]], ratio );
+              ++j )
+        {
+            unsigned i = _breakpointIndices[j];
+            if ( FloatUtils::abs( changeColumn[i] ) > largestPivot )
+            {
+                largestPivot = FloatUtils::abs( changeColumn[i] );
+                leaving = i;
+            }
+        }
+
+        leavingRatio = ratio;
+        _numBreakpointsPassed = first;
+    }
+    else if ( ( position > 0 ) && ( farBoundLimit < hardLimit ) )
+    {
+        // Stop at the last breakpoint before some basic overshoots its range
+        leaving = _breakpointIndices[position - 1];
+        leavingRatio = _breakpointRatios[leaving];
+        _numBreakpointsPassed = position - 1;
+    }
+    else if ( enteringRange <= hardLimit )
+    {
+        // All breakpoints within range were passed, perform a fake pivot
+        _numBreakpointsPassed = position;
+        if ( _numBreakpointsPassed > 0 )
+        {
+            _leavingVariable = _m;
+            _changeRatio = direction * enteringRange;
+        }
+        return;
+    }
+    else
+    {
+        // A basic that is within bounds leaves, as in the Harris ratio test
+        double largestPivot = 0;
+        for ( unsigned i = 0; i < _m; ++i )
+        {
+            if ( ( FloatUtils::abs( changeColumn[i] ) < GlobalConfiguration::PIVOT_CHANGE_COLUMN_TOLERANCE ) ||
+                 ( _costFunctionManager->getBasicCost( i ) != 0 ) )
+                continue;
+
+            double rate = -changeColumn[i] * direction;
+            unsigned basic = _basicIndexToVariable[i];
+            double bound = ( rate > 0 ) ? getUpperBound( basic ) : getLowerBound( basic );
+            double ratio = ( bound - _basicAssignment[i] ) / rate;
+            if ( ratio < 0 )
+                ratio = 0;
+
+            double pivot = FloatUtils::abs( changeColumn[i] );
+            if ( ( ratio <= hardLimit ) && ( pivot > largestPivot ) )
+            {
+                largestPivot = pivot;
+                leaving = i;
+                leavingRatio = ratio;
+            }
+        }
+
+        // The relaxed limit may let the walk go past the leaving ratio
+        _numBreakpointsPassed = 0;
+        while ( ( _numBreakpointsPassed < position ) &&
+                ( _breakpointRatios[_breakpointIndices[_numBreakpointsPassed]] <= leavingRatio ) )
+            ++_numBreakpointsPassed;
+    }
+
+    // Keep the Harris choice unless breakpoints were actually passed
+    if ( ( leaving == _m ) || ( _numBreakpointsPassed == 0 ) )
+    {
+        _numBreakpointsPassed = 0;
+        return;
+    }
+
+    _leavingVariable = leaving;
+    _changeRatio = direction * leavingRatio;
+    _leavingVariableIncreases = ( -changeColumn[leaving] * direction > 0 );
+}
+
 double Tableau::getChangeRatio() const
 {
     return _changeRatio;
@@ -1419,6 +1670,128 @@ void Tableau::setChangeRatio( double changeRatio )
     _changeRatio = changeRatio;
 }
 
+void Tableau::resetDualPricingWeights()
+{
+    _dualPricingWeights.clear();
+    for ( unsigned i = 0; i < _m; ++i )
+        _dualPricingWeights.append( 1.0 );
+}
+
+bool Tableau::pickDualLeavingVariable()
+{
+    ASSERT( _dualPricingWeights.size() == _m );
+
+    // A marker to show that no leaving variable has been selected
+    _leavingVariable = _m;
+
+    // Dual Devex pricing: the largest infeasibility relative to the
+    // reference weight of the row
+    double bestScore = 0;
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        if ( !basicOutOfBounds( i ) )
+            continue;
+
+        unsigned basic = _basicIndexToVariable[i];
+        double infeasibility = basicTooLow( i ) ?
+            getLowerBound( basic ) - _basicAssignment[i] :
+            _basicAssignment[i] - getUpperBound( basic );
+
+        double score = infeasibility * infeasibility / _dualPricingWeights[i];
+        if ( score > bestScore )
+        {
+            bestScore = score;
+            _leavingVariable = i;
+        }
+    }
+
+    return _leavingVariable != _m;
+}
+
+bool Tableau::pickDualEnteringVariable()
+{
+    ASSERT( _leavingVariable < _m );
+    ASSERT( _pivotRow->_lhs == _basicIndexToVariable[_leavingVariable] );
+
+    /*
+      The pivot row reads basic = sum( coefficient * nonBasic ) + scalar.
+      The leaving variable moves to its violated bound, so a non-basic
+      is eligible for entry if it can move in the direction that pushes
+      the leaving variable towards that bound.
+
+      The engine solves a feasibility problem, so all reduced costs are
+      zero and every eligible variable ties in the dual ratio test. Ties
+      are broken in favor of variables whose new value stays within
+      their bounds, as they do not become infeasible when entering the
+      basis, and then in favor of larger pivot elements.
+    */
+    unsigned leavingBasic = _basicIndexToVariable[_leavingVariable];
+    _leavingVariableIncreases = basicTooLow( _leavingVariable );
+    double basicDelta = _leavingVariableIncreases ?
+        getLowerBound( leavingBasic ) - _basicAssignment[_leavingVariable] :
+        getUpperBound( leavingBasic ) - _basicAssignment[_leavingVariable];
+
+    unsigned bestEntering = _n - _m;
+    bool bestStaysWithinBounds = false;
+    double largestPivot = 0;
+
+    for ( unsigned i = 0; i < _n - _m; ++i )
+    {
+        double coefficient = _pivotRow->_row[i]._coefficient;
+        if ( FloatUtils::abs( coefficient ) < GlobalConfiguration::PIVOT_CHANGE_COLUMN_TOLERANCE )
+            continue;
+
+        bool enteringIncreases = ( coefficient > 0 ) == _leavingVariableIncreases;
+        if ( enteringIncreases ? !nonBasicCanIncrease( i ) : !nonBasicCanDecrease( i ) )
+            continue;
+
+        unsigned nonBasic = _nonBasicIndexToVariable[i];
+        double newValue = _nonBasicAssignment[i] + basicDelta / coefficient;
+        bool staysWithinBounds =
+            FloatUtils::gte( newValue, getLowerBound( nonBasic ) ) &&
+            FloatUtils::lte( newValue, getUpperBound( nonBasic ) );
+
+        double pivot = FloatUtils::abs( coefficient );
+        if ( ( staysWithinBounds && !bestStaysWithinBounds ) ||
+             ( staysWithinBounds == bestStaysWithinBounds && pivot > largestPivot ) )
+        {
+            bestEntering = i;
+            bestStaysWithinBounds = staysWithinBounds;
+            largestPivot = pivot;
+        }
+    }
+
+    if ( bestEntering == _n - _m )
+        return false;
+
+    _enteringVariable = bestEntering;
+    _changeRatio = basicDelta / _pivotRow->_row[bestEntering]._coefficient;
+    return true;
+}
+
+void Tableau::updateDualPricingWeights()
+{
+    ASSERT( _dualPricingWeights.size() == _m );
+    ASSERT( _leavingVariable < _m );
+
+    double pivotElement = _changeColumn[_leavingVariable];
+    ASSERT( !FloatUtils::isZero( pivotElement ) );
+
+    double leavingWeight = _dualPricingWeights[_leavingVariable];
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        if ( i == _leavingVariable || FloatUtils::isZero( _changeColumn[i] ) )
+            continue;
+
+        double ratio = _changeColumn[i] / pivotElement;
+        _dualPricingWeights[i] = FloatUtils::max( _dualPricingWeights[i], ratio * ratio * leavingWeight );
+    }
+
+    // The row of the leaving variable now belongs to the entering variable
+    _dualPricingWeights[_leavingVariable] =
+        FloatUtils::max( leavingWeight / ( pivotElement * pivotElement ), 1.0 );
+}
+
 void Tableau::computeChangeColumn()
 {
     // Compute d = inv(B) * a using the basis factorization
@@ -1580,7 +1953,23 @@ const SparseMatrix *Tableau::getSparseA() const
 
 const double *Tableau::getAColumn( unsigned variable ) const
 {
-    return _denseA + ( variable * _m );
+    _sparseColumnsOfA[variable]->toDense( _denseAColumn );
+    return _denseAColumn;
+}
+
+void Tableau::updateConstraintMatrixMemoryStatistics() const
+{
+    if ( !_statistics )
+        return;
+
+    // CSR storage (values, column indices, row offsets) plus the
+    // entries of the sparse rows and columns
+    unsigned long long bytes =
+        _A->getNnz() * ( sizeof(double) + sizeof(unsigned) ) +
+        ( _m + 1 ) * sizeof(unsigned) +
+        _sparseListArena.getNumberOfAllocatedBytes();
+
+    _statistics->setLongAttribute( Statistics::CONSTRAINT_MATRIX_MEMORY_BYTES, bytes );
 }
 
 void Tableau::getSparseAColumn( unsigned variable, SparseUnsortedList *result ) const
@@ -1633,7 +2022,6 @@ void Tableau::storeState( TableauState &state, TableauStateStorageLevel level )
             _sparseColumnsOfA[i]->storeIntoOther( state._sparseColumnsOfA[i] );
         for ( unsigned i = 0; i < _m; ++i )
             _sparseRowsOfA[i]->storeIntoOther( state._sparseRowsOfA[i] );
-        memcpy( state._denseA, _denseA, sizeof(double) * _m * _n );
 
         // Store right hand side vector _b
         memcpy( state._b, _b, sizeof(double) * _m );
@@ -1679,6 +2067,10 @@ void Tableau::updateVariablesToComplyWithBounds()
                                                         getUpperBound( variable ) );
         }
         computeBasicStatus();
+
+        // The basic statuses may have changed along with the bounds
+        if ( _costFunctionManager )
+            _costFunctionManager->invalidateCostFunction();
     }
 }
 
@@ -1700,7 +2092,6 @@ void Tableau::restoreState( const TableauState &state,
             state._sparseColumnsOfA[i]->storeIntoOther( _sparseColumnsOfA[i] );
         for ( unsigned i = 0; i < _m; ++i )
             state._sparseRowsOfA[i]->storeIntoOther( _sparseRowsOfA[i] );
-        memcpy( _denseA, state._denseA, sizeof(double) * _m * _n );
 
         // Restore right hand side vector _b
         memcpy( _b, state._b, sizeof(double) * _m );
@@ -1840,14 +2231,13 @@ unsigned Tableau::addEquation( const Equation &equation )
         _workN[addend._variable] = addend._coefficient;
         _sparseColumnsOfA[addend._variable]->set( _m - 1, addend._coefficient );
         _sparseRowsOfA[_m - 1]->set( addend._variable, addend._coefficient );
-        _denseA[(addend._variable * _m) + _m - 1] = addend._coefficient;
     }
 
     _workN[auxVariable] = 1;
     _sparseColumnsOfA[auxVariable]->set( _m - 1, 1 );
     _sparseRowsOfA[_m - 1]->set( auxVariable, 1 );
-    _denseA[(auxVariable * _m) + _m - 1] = 1;
     _A->addLastRow( _workN );
+    updateConstraintMatrixMemoryStatistics();
 
     // Invalidate the cost function, so that it is recomputed in the next iteration.
     _costFunctionManager->invalidateCostFunction();
@@ -1966,7 +2356,7 @@ void Tableau::addRow()
         newSparseColumnsOfA[i]->incrementSize();
     }
 
-    newSparseColumnsOfA[newN - 1] = new SparseUnsortedList( newM );
+    newSparseColumnsOfA[newN - 1] = new SparseUnsortedList( newM, &_sparseListArena );
     if ( !newSparseColumnsOfA[newN - 1] )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newSparseColumnsOfA[newN-1]" );
 
@@ -1984,27 +2374,19 @@ void Tableau::addRow()
         newSparseRowsOfA[i]->incrementSize();
     }
 
-    newSparseRowsOfA[newM - 1] = new SparseUnsortedList( newN );
+    newSparseRowsOfA[newM - 1] = new SparseUnsortedList( newN, &_sparseListArena );
     if ( !newSparseRowsOfA[newM - 1] )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newSparseRowsOfA[newN-1]" );
 
     delete[] _sparseRowsOfA;
     _sparseRowsOfA = newSparseRowsOfA;
 
-    // Allocate a larger _denseA, keep old entries
-    double *newDenseA = new double[newM * newN];
-    if ( !newDenseA )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newDenseA" );
-
-    for ( unsigned column = 0; column < _n; ++column )
-    {
-        memcpy( newDenseA + ( column * newM ), _denseA + ( column * _m ), sizeof(double) * _m );
-        newDenseA[column*newM + newM - 1] = 0.0;
-    }
-    std::fill_n( newDenseA + ( newN - 1 ) * newM, newM, 0.0 );
-
-    delete[] _denseA;
-    _denseA = newDenseA;
+    // Allocate a new denseAColumn. Don't need to initialize
+    double *newDenseAColumn = new double[newM];
+    if ( !newDenseAColumn )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newDenseAColumn" );
+    delete[] _denseAColumn;
+    _denseAColumn = newDenseAColumn;
 
     // Allocate a new changeColumn. Don't need to initialize
     double *newChangeColumn = new double[newM];
@@ -2091,6 +2473,19 @@ void Tableau::addRow()
     delete[] _workN;
     _workN = newWorkN;
 
+    // Allocate larger long-step ratio test buffers. Don't need to initialize.
+    double *newBreakpointRatios = new double[newM];
+    if ( !newBreakpointRatios )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newBreakpointRatios" );
+    delete[] _breakpointRatios;
+    _breakpointRatios = newBreakpointRatios;
+
+    unsigned *newBreakpointIndices = new unsigned[newM];
+    if ( !newBreakpointIndices )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newBreakpointIndices" );
+    delete[] _breakpointIndices;
+    _breakpointIndices = newBreakpointIndices;
+
     _m = newM;
     _n = newN;
     _costFunctionManager->initialize();
@@ -2546,10 +2941,7 @@ void Tableau::mergeColumns( unsigned x1, unsigned x2 )
     for ( unsigned i = 0; i < _m; ++i )
         _sparseRowsOfA[i]->mergeEntries( x2, x1 );
 
-    // And the dense ones, too
-    for ( unsigned i = 0; i < _m; ++i )
-        _denseA[x1*_m + i] += _denseA[x2*_m + i];
-    std::fill_n( _denseA + x2 * _m, _m, 0 );
+    updateConstraintMatrixMemoryStatistics();
 
     computeAssignment();
     computeCostFunction();
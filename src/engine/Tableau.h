@@ -27,6 +27,7 @@
 #include "SparseColumnsOfBasis.h"
 #include "SparseMatrix.h"
 #include "SparseUnsortedList.h"
+#include "SparseUnsortedListArena.h"
 #include "Statistics.h"
 
 #define TABLEAU_LOG( x, ... ) LOG( GlobalConfiguration::TABLEAU_LOGGING, "Tableau: %s\n", x )
@@ -232,6 +233,29 @@ public:
     double getChangeRatio() const;
     void setChangeRatio( double changeRatio );
 
+    /*
+      Dual simplex iterations, used to restore feasibility after bounds
+      have been tightened. The basic variable with the largest weighted
+      infeasibility leaves the basis and is set to its violated bound, and
+      the entering variable is found by a ratio test over the pivot row.
+      A dual step is performed by:
+
+        1. pickDualLeavingVariable()
+        2. computePivotRow()
+        3. pickDualEnteringVariable()
+        4. computeChangeColumn()
+        5. updateDualPricingWeights()
+        6. performPivot()
+
+      The pricing weights are Devex reference weights, which are reset to
+      1 by resetDualPricingWeights() whenever a new round of dual
+      iterations begins.
+    */
+    void resetDualPricingWeights();
+    bool pickDualLeavingVariable();
+    bool pickDualEnteringVariable();
+    void updateDualPricingWeights();
+
     /*
       Returns true iff the current iteration is a fake pivot, i.e. the
       entering variable jumping from one bound to the other.
@@ -284,11 +308,13 @@ public:
     void updateCostFunctionForPivot();
 
     /*
-      Get a list of non-basic variables eligible for entry into the
+      Get the non-basic variables eligible for entry into the
       basis, i.e. variables that can be changed in a way that would
-      reduce the cost value.
+      reduce the cost value. Their indices are stored in candidates,
+      which should have room for n-m entries, and their number is
+      returned.
     */
-    void getEntryCandidates( List<unsigned> &candidates ) const;
+    unsigned getEntryCandidates( unsigned *candidates ) const;
 
     /*
       Compute the multipliers for a given list of row coefficient.
@@ -331,7 +357,9 @@ public:
 
     /*
       Get the original constraint matrix A or a column thereof,
-      in dense form.
+      in dense form. The dense column is materialized from the
+      sparse column into a work buffer, which takes O(m) time, and
+      remains valid only until the next call.
     */
     const SparseMatrix *getSparseA() const;
     const double *getAColumn( unsigned variable ) const;
@@ -501,14 +529,18 @@ private:
     unsigned _m;
 
     /*
-      The constraint matrix A, and a collection of its
-      sparse columns. The matrix is also stored in dense
-      form (column-major).
+      The constraint matrix A, and a collection of its sparse rows
+      and columns. A is only stored in sparse form; dense columns
+      are materialized on demand into _denseAColumn.
+
+      The entries of the sparse rows and columns are allocated from
+      a common arena, to keep them close together in memory.
     */
     SparseMatrix *_A;
+    SparseUnsortedListArena _sparseListArena;
     SparseUnsortedList **_sparseColumnsOfA;
     SparseUnsortedList **_sparseRowsOfA;
-    double *_denseA;
+    mutable double *_denseAColumn;
 
     /*
       Used to compute inv(B)*a
@@ -531,6 +563,17 @@ private:
     double *_workM;
     double *_workN;
 
+    /*
+      Working memory for the long-step ratio test (of size m): the
+      ratio at which each out-of-bounds basic variable reaches its
+      violated bound, and the indices of these basic variables, sorted
+      by that ratio. Also, the number of breakpoints that the selected
+      pivot passes, reported when the pivot is performed.
+    */
+    double *_breakpointRatios;
+    unsigned *_breakpointIndices;
+    unsigned _numBreakpointsPassed;
+
     /*
       A unit vector of size m
     */
@@ -602,6 +645,11 @@ private:
     */
     bool _leavingVariableIncreases;
 
+    /*
+      Devex weights of the basic variables, used in dual pricing
+    */
+    Vector<double> _dualPricingWeights;
+
     /*
       The status of the basic assignment
     */
@@ -636,6 +684,12 @@ private:
     */
     LPSolverType _lpSolverType;
 
+    /*
+      Whether to use the long-step ratio test when looking for a
+      feasible assignment (see longStepRatioTest).
+    */
+    bool _useLongStepRatioTest;
+
     GurobiWrapper *_gurobi;
 
     /*
@@ -648,6 +702,12 @@ private:
     */
     void addRow();
 
+    /*
+      Report the memory used by the constraint matrix to the
+      statistics object
+    */
+    void updateConstraintMatrixMemoryStatistics() const;
+
     /*
       Update the variable assignment to reflect a pivot operation,
       without re-computing it from scratch.
@@ -659,6 +719,7 @@ private:
     */
     void standardRatioTest( double *changeColumn );
     void harrisRatioTest( double *changeColumn );
+    void longStepRatioTest( double *changeColumn );
 
     /*
       For debugging purposes only
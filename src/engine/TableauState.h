@@ -60,7 +60,6 @@ public:
     SparseMatrix *_A;
     SparseUnsortedList **_sparseColumnsOfA;
     SparseUnsortedList **_sparseRowsOfA;
-    double *_denseA;
 
     /*
       The right hand side
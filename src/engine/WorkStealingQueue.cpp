@@ -0,0 +1,208 @@
+/*********************                                                        */
+/*! \file WorkStealingQueue.cpp
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "Debug.h"
+#include "MarabouError.h"
+#include "WorkStealingQueue.h"
+
+WorkStealingQueue::WorkStealingQueue( unsigned numWorkers )
+    : _numWorkers( numWorkers )
+    , _deques( NULL )
+    , _numSteals( 0 )
+    , _epoch( 0 )
+    , _numParkedWorkers( 0 )
+    , _closed( false )
+{
+    ASSERT( numWorkers > 0 );
+
+    _deques = new WorkerDeque[numWorkers];
+    if ( !_deques )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "WorkStealingQueue::deques" );
+}
+
+WorkStealingQueue::~WorkStealingQueue()
+{
+    if ( _deques )
+    {
+        for ( unsigned i = 0; i < _numWorkers; ++i )
+        {
+            for ( const auto &subQuery : _deques[i]._subQueries )
+                delete subQuery;
+        }
+
+        delete[] _deques;
+        _deques = NULL;
+    }
+}
+
+void WorkStealingQueue::push( unsigned workerId, SubQuery *subQuery )
+{
+    ASSERT( workerId < _numWorkers );
+
+    {
+        std::lock_guard<std::mutex> lock( _deques[workerId]._mutex );
+        _deques[workerId]._subQueries.push_back( subQuery );
+    }
+
+    bool wakeUp;
+    {
+        std::lock_guard<std::mutex> lock( _parkMutex );
+        ++_epoch;
+        wakeUp = _numParkedWorkers > 0;
+    }
+
+    if ( wakeUp )
+        _workAvailable.notify_one();
+}
+
+bool WorkStealingQueue::pop( unsigned workerId, SubQuery *&subQuery )
+{
+    ASSERT( workerId < _numWorkers );
+
+    if ( popLocal( workerId, subQuery ) )
+        return true;
+
+    // Scan the other workers, starting from the next one, so that thieves
+    // do not all go after the same victim
+    for ( unsigned i = 1; i < _numWorkers; ++i )
+    {
+        if ( steal( ( workerId + i ) % _numWorkers, subQuery ) )
+        {
+            ++_numSteals;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool WorkStealingQueue::waitAndPop( unsigned workerId, SubQuery *&subQuery )
+{
+    while ( true )
+    {
+        unsigned long long epoch;
+        {
+            std::lock_guard<std::mutex> lock( _parkMutex );
+            if ( _closed )
+                return false;
+            epoch = _epoch;
+        }
+
+        if ( pop( workerId, subQuery ) )
+            return true;
+
+        std::unique_lock<std::mutex> lock( _parkMutex );
+        if ( _closed )
+            return false;
+
+        // Retry if work arrived in the meantime. A steal skips busy
+        // victims, so also make sure that the deques are indeed empty.
+        if ( _epoch != epoch || !empty() )
+            continue;
+
+        if ( _numParkedWorkers + 1 == _numWorkers )
+        {
+            // Everybody else is parked and there is no work left
+            _closed = true;
+            _workAvailable.notify_all();
+            return false;
+        }
+
+        ++_numParkedWorkers;
+        _workAvailable.wait( lock, [this, epoch]() { return _closed || _epoch != epoch; } );
+        --_numParkedWorkers;
+    }
+}
+
+void WorkStealingQueue::close()
+{
+    {
+        std::lock_guard<std::mutex> lock( _parkMutex );
+        _closed = true;
+    }
+
+    _workAvailable.notify_all();
+}
+
+bool WorkStealingQueue::closed() const
+{
+    std::lock_guard<std::mutex> lock( _parkMutex );
+    return _closed;
+}
+
+bool WorkStealingQueue::popLocal( unsigned workerId, SubQuery *&subQuery )
+{
+    std::lock_guard<std::mutex> lock( _deques[workerId]._mutex );
+    if ( _deques[workerId]._subQueries.empty() )
+        return false;
+
+    subQuery = _deques[workerId]._subQueries.back();
+    _deques[workerId]._subQueries.pop_back();
+    return true;
+}
+
+bool WorkStealingQueue::steal( unsigned victimId, SubQuery *&subQuery )
+{
+    // Peek without blocking on a busy victim; another one is tried instead
+    std::unique_lock<std::mutex> lock( _deques[victimId]._mutex, std::try_to_lock );
+    if ( !lock.owns_lock() || _deques[victimId]._subQueries.empty() )
+        return false;
+
+    subQuery = _deques[victimId]._subQueries.front();
+    _deques[victimId]._subQueries.pop_front();
+    return true;
+}
+
+void WorkStealingQueue::distribute( const SubQueries &subQueries )
+{
+    unsigned workerId = 0;
+    for ( const auto &subQuery : subQueries )
+    {
+        push( workerId, subQuery );
+        workerId = ( workerId + 1 ) % _numWorkers;
+    }
+}
+
+unsigned WorkStealingQueue::size() const
+{
+    unsigned result = 0;
+    for ( unsigned i = 0; i < _numWorkers; ++i )
+    {
+        std::lock_guard<std::mutex> lock( _deques[i]._mutex );
+        result += _deques[i]._subQueries.size();
+    }
+    return result;
+}
+
+bool WorkStealingQueue::empty() const
+{
+    return size() == 0;
+}
+
+unsigned WorkStealingQueue::getNumWorkers() const
+{
+    return _numWorkers;
+}
+
+unsigned long long WorkStealingQueue::getNumSteals() const
+{
+    return _numSteals.load();
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,120 @@
+/*********************                                                        */
+/*! \file WorkStealingQueue.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** The sub-queries of the divide-and-conquer solving mode, split into one
+ ** double-ended queue per worker. A worker pushes and pops at the back of
+ ** its own deque (LIFO), so it keeps working on the children of the query
+ ** it just solved. When its deque runs dry, it steals from the front of
+ ** another worker's deque (FIFO), i.e. takes the shallowest sub-query
+ ** there, which is also the one most likely to carry a lot of work.
+ **
+ ** A worker that finds no work at all parks on a condition variable
+ ** instead of polling, and is woken up by the next push. Once every worker
+ ** is parked, no worker is solving a sub-query, so none can produce more
+ ** work: the queue then closes itself and releases all the workers.
+
+**/
+
+#ifndef __WorkStealingQueue_h__
+#define __WorkStealingQueue_h__
+
+#include "SubQuery.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+class WorkStealingQueue
+{
+public:
+    WorkStealingQueue( unsigned numWorkers );
+    ~WorkStealingQueue();
+
+    /*
+      Push a sub-query to the back of the given worker's deque
+    */
+    void push( unsigned workerId, SubQuery *subQuery );
+
+    /*
+      Pop a sub-query for the given worker: first from the back of its own
+      deque, then by stealing from the front of the other workers' deques.
+      Return false if no sub-query could be found.
+    */
+    bool pop( unsigned workerId, SubQuery *&subQuery );
+
+    /*
+      Like pop(), but park the calling worker until a sub-query becomes
+      available. Return false once the queue is closed, either explicitly
+      or because every worker has run out of work.
+    */
+    bool waitAndPop( unsigned workerId, SubQuery *&subQuery );
+
+    /*
+      Close the queue and wake up all the parked workers
+    */
+    void close();
+    bool closed() const;
+
+    /*
+      Distribute the sub-queries among the workers, round-robin
+    */
+    void distribute( const SubQueries &subQueries );
+
+    /*
+      The number of sub-queries currently queued, over all workers. Only
+      a snapshot when other workers are running.
+    */
+    unsigned size() const;
+    bool empty() const;
+
+    unsigned getNumWorkers() const;
+
+    /*
+      The number of sub-queries that were stolen from another worker's
+      deque
+    */
+    unsigned long long getNumSteals() const;
+
+private:
+    struct WorkerDeque
+    {
+        mutable std::mutex _mutex;
+        std::deque<SubQuery *> _subQueries;
+    };
+
+    unsigned _numWorkers;
+    WorkerDeque *_deques;
+
+    std::atomic<unsigned long long> _numSteals;
+
+    /*
+      Parking. Every push advances _epoch, so that a worker that found
+      no work can tell whether a sub-query arrived before it parked.
+      These members are protected by _parkMutex.
+    */
+    mutable std::mutex _parkMutex;
+    std::condition_variable _workAvailable;
+    unsigned long long _epoch;
+    unsigned _numParkedWorkers;
+    bool _closed;
+
+    bool popLocal( unsigned workerId, SubQuery *&subQuery );
+    bool steal( unsigned victimId, SubQuery *&subQuery );
+};
+
+#endif // __WorkStealingQueue_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
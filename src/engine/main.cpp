@@ -17,6 +17,7 @@
 #include "Error.h"
 #include "Marabou.h"
 #include "Options.h"
+#include "TraceRecorder.h"
 
 #ifdef ENABLE_OPENBLAS
 #include "cblas.h"
@@ -95,6 +96,57 @@ int main( int argc, char **argv )
             printf( "Proof production is not yet supported with MILP solvers, turning SOLVE_WITH_MILP off.\n" );
         }
 
+        if ( Options::get()->getBool( Options::PRODUCE_PROOFS ) && ( options->getBool( Options::CDCL ) ) )
+        {
+            options->setBool( Options::CDCL, false );
+            if ( options->getInt( Options::VERBOSITY ) > 0 )
+                printf( "Proof production is not yet supported with CDCL, turning CDCL off.\n" );
+        }
+
+        if ( options->getBool( Options::CDCL ) )
+        {
+            // The conflict-driven search replaces DeepSoI, DnC and the MILP
+            // encoding. Only tell the user about the options they asked for.
+            bool verbose = options->getInt( Options::VERBOSITY ) > 0;
+
+            bool deepSoIRequested =
+                options->optionSpecified( "soi-split-threshold" ) ||
+                options->optionSpecified( "soi-search-strategy" ) ||
+                options->optionSpecified( "soi-init-strategy" ) ||
+                options->optionSpecified( "mcmc-beta" ) ||
+                ( options->getInt( Options::NUM_WORKERS ) > 1 &&
+                  !options->getBool( Options::NO_PARALLEL_DEEPSOI ) );
+            GlobalConfiguration::USE_DEEPSOI_LOCAL_SEARCH = false;
+            options->setBool( Options::NO_PARALLEL_DEEPSOI, true );
+            if ( deepSoIRequested && verbose )
+                printf( "CDCL is not yet supported with DEEPSOI search, turning search off.\n" );
+
+            if ( options->getBool( Options::DNC_MODE ) )
+            {
+                options->setBool( Options::DNC_MODE, false );
+                if ( verbose )
+                    printf( "CDCL is not yet supported with snc mode, turning snc off.\n" );
+            }
+
+            if ( options->getBool( Options::SOLVE_WITH_MILP ) )
+            {
+                options->setBool( Options::SOLVE_WITH_MILP, false );
+                if ( verbose )
+                    printf( "CDCL is not yet supported with MILP solvers, turning SOLVE_WITH_MILP off.\n" );
+            }
+        }
+
+        String traceFilePath = options->getString( Options::TRACE_FILE );
+        if ( traceFilePath != "" )
+        {
+#ifdef ENABLE_TRACING
+            TraceRecorder::get()->setEnabled( true );
+#else
+            printf( "Marabou was built without ENABLE_TRACING, no trace will be recorded.\n" );
+            traceFilePath = "";
+#endif
+        }
+
         if ( options->getBool( Options::DNC_MODE ) ||
              ( !options->getBool( Options::NO_PARALLEL_DEEPSOI ) &&
                !options->getBool( Options::SOLVE_WITH_MILP ) &&
@@ -107,6 +159,13 @@ int main( int argc, char **argv )
 #endif
             Marabou().run();
 	}
+
+        if ( traceFilePath != "" )
+        {
+            TraceRecorder::get()->setEnabled( false );
+            TraceRecorder::get()->writeChromeTrace( traceFilePath );
+            printf( "Trace written to %s\n", traceFilePath.ascii() );
+        }
     }
     catch ( const Error &e )
     {
@@ -125,6 +125,10 @@ public:
     {
     }
 
+    void setRecheckAdjustedCostFunction( bool /* recheck */ )
+    {
+    }
+
     bool costFunctionInvalid() const
     {
         return true;
@@ -16,8 +16,11 @@
 #ifndef __MockEngine_h__
 #define __MockEngine_h__
 
+#include "FloatUtils.h"
 #include "IEngine.h"
 #include "List.h"
+#include "Map.h"
+#include "Pair.h"
 #include "PiecewiseLinearCaseSplit.h"
 #include "PiecewiseLinearConstraint.h"
 #include "context/context.h"
@@ -33,6 +36,8 @@ public:
         wasDiscarded = false;
 
         lastStoredState = NULL;
+        lastRestoredState = NULL;
+        contextDependentSearchState = false;
     }
 
     ~MockEngine()
@@ -111,6 +116,12 @@ public:
     {
     }
 
+    bool contextDependentSearchState;
+    bool searchStateIsContextDependent() const
+    {
+        return contextDependentSearchState;
+    }
+
     unsigned _timeToSolve;
     IEngine::ExitCode _exitCode;
     bool solve( unsigned timeoutInSeconds )
@@ -209,6 +220,81 @@ public:
     CVC4::context::Context &getContext() { return _dontCare; }
 
     bool consistentBounds() const { return true; }
+
+    Map<unsigned, unsigned> _lowerBoundLevels;
+    Map<unsigned, unsigned> _upperBoundLevels;
+    void setBoundLevel( unsigned variable, Tightening::BoundType type, unsigned level )
+    {
+        if ( type == Tightening::LB )
+            _lowerBoundLevels[variable] = level;
+        else
+            _upperBoundLevels[variable] = level;
+    }
+
+    unsigned getBoundLevel( unsigned variable, Tightening::BoundType type,
+                            double /* value */ ) const
+    {
+        const Map<unsigned, unsigned> &levels =
+            ( type == Tightening::LB ) ? _lowerBoundLevels : _upperBoundLevels;
+        return levels.exists( variable ) ? levels.get( variable ) : 0;
+    }
+
+    Map<unsigned, double> _lowerBounds;
+    Map<unsigned, double> _upperBounds;
+    void setLowerBound( unsigned variable, double value )
+    {
+        _lowerBounds[variable] = value;
+    }
+
+    void setUpperBound( unsigned variable, double value )
+    {
+        _upperBounds[variable] = value;
+    }
+
+    double getLowerBound( unsigned variable ) const
+    {
+        return _lowerBounds.exists( variable ) ? _lowerBounds.get( variable )
+            : FloatUtils::negativeInfinity();
+    }
+
+    double getUpperBound( unsigned variable ) const
+    {
+        return _upperBounds.exists( variable ) ? _upperBounds.get( variable )
+            : FloatUtils::infinity();
+    }
+
+    /*
+      Sets of case splits that are refuted from the bounds at a decision
+      level, and at any higher level
+    */
+    List<Pair<unsigned, List<PiecewiseLinearCaseSplit>>> _infeasibleCaseSplits;
+    unsigned _numberOfInfeasibilityChecks = 0;
+    void addInfeasibleCaseSplits( const List<PiecewiseLinearCaseSplit> &splits,
+                                  unsigned level = 0 )
+    {
+        _infeasibleCaseSplits.append
+            ( Pair<unsigned, List<PiecewiseLinearCaseSplit>>( level, splits ) );
+    }
+
+    bool caseSplitsAreInfeasible( unsigned level,
+                                  const List<PiecewiseLinearCaseSplit> &splits )
+    {
+        ++_numberOfInfeasibilityChecks;
+        for ( const auto &infeasible : _infeasibleCaseSplits )
+        {
+            if ( infeasible.first() > level )
+                continue;
+
+            bool contained = true;
+            for ( const auto &split : infeasible.second() )
+                if ( !splits.exists( split ) )
+                    contained = false;
+
+            if ( contained )
+                return true;
+        }
+        return false;
+    }
 };
 
 #endif // __MockEngine_h__
@@ -52,8 +52,9 @@ public:
     }
 
     bool select( ITableau &,
-                 const List<unsigned> &,
-                 const Set<unsigned> & )
+                 const unsigned *,
+                 unsigned,
+                 const Bitset & )
     {
         return true;
     }
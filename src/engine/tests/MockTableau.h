@@ -95,9 +95,12 @@ public:
 
     List<unsigned> mockCandidates;
     unsigned mockEnteringVariable;
-    void getEntryCandidates( List<unsigned> &candidates ) const
+    unsigned getEntryCandidates( unsigned *candidates ) const
     {
-        candidates = mockCandidates;
+        unsigned numberOfCandidates = 0;
+        for ( const auto &candidate : mockCandidates )
+            candidates[numberOfCandidates++] = candidate;
+        return numberOfCandidates;
     }
 
     void setEnteringVariableIndex( unsigned nonBasic )
@@ -300,6 +303,11 @@ public:
     double getChangeRatio() const { return 0; }
     void setChangeRatio( double /* changeRatio */ ) {}
 
+    void resetDualPricingWeights() {}
+    bool pickDualLeavingVariable() { return false; }
+    bool pickDualEnteringVariable() { return false; }
+    void updateDualPricingWeights() {}
+
     void performPivot() {}
     bool performingFakePivot() const
     {
@@ -48,10 +48,10 @@ public:
     {
         BlandsRule blandsRule;
 
-        Set<unsigned> excluded;
-        List<unsigned> candidates;
+        Bitset excluded( 101 );
+        Vector<unsigned> candidates;
 
-        TS_ASSERT( !blandsRule.select( *tableau, candidates, excluded ) );
+        TS_ASSERT( !blandsRule.select( *tableau, candidates.data(), candidates.size(), excluded ) );
 
         candidates.append( 3 );
         tableau->nextNonBasicIndexToVariable[3] = 20;
@@ -65,22 +65,20 @@ public:
         candidates.append( 51 );
         tableau->nextNonBasicIndexToVariable[51] = 6;
 
-        TS_ASSERT( blandsRule.select( *tableau, candidates, excluded ) );
+        TS_ASSERT( blandsRule.select( *tableau, candidates.data(), candidates.size(), excluded ) );
         TS_ASSERT_EQUALS( tableau->mockEnteringVariable, 10U );
 
-        excluded.insert( 10 );
-        TS_ASSERT( blandsRule.select( *tableau, candidates, excluded ) );
+        excluded.set( 10 );
+        TS_ASSERT( blandsRule.select( *tableau, candidates.data(), candidates.size(), excluded ) );
         TS_ASSERT_EQUALS( tableau->mockEnteringVariable, 51U );
         excluded.clear();
 
         candidates.append( 100 );
         tableau->nextNonBasicIndexToVariable[100] = 1;
 
-        tableau->mockCandidates = candidates;
-
         // TS_ASSERT_EQUALS( blandsRule.select( candidates, *tableau ), 100U );
 
-        TS_ASSERT( blandsRule.select( *tableau, candidates, excluded ) );
+        TS_ASSERT( blandsRule.select( *tableau, candidates.data(), candidates.size(), excluded ) );
         TS_ASSERT_EQUALS( tableau->mockEnteringVariable, 100U );
     }
 };
@@ -250,6 +250,100 @@ public:
         }
     }
 
+    void test_bound_manager_backtracks_several_levels()
+    {
+        BoundManager boundManager( *context );
+        boundManager.initialize( 2 );
+
+        // Root level bounds are not backtracked
+        boundManager.setLowerBound( 0, 1 );
+        boundManager.setUpperBound( 1, 10 );
+
+        boundManager.storeLocalBounds();
+        context->push();
+        boundManager.setLowerBound( 0, 2 );
+        boundManager.setLowerBound( 0, 3 );
+
+        boundManager.storeLocalBounds();
+        context->push();
+        boundManager.setUpperBound( 1, 5 );
+        boundManager.setLowerBound( 0, 4 );
+
+        TS_ASSERT_EQUALS( boundManager.getLowerBound( 0 ), 4 );
+        TS_ASSERT_EQUALS( boundManager.getUpperBound( 1 ), 5 );
+
+        context->popto( 0 );
+        boundManager.restoreLocalBounds();
+
+        TS_ASSERT_EQUALS( boundManager.getLowerBound( 0 ), 1 );
+        TS_ASSERT_EQUALS( boundManager.getUpperBound( 1 ), 10 );
+
+        // The trail is reused after backtracking
+        boundManager.storeLocalBounds();
+        context->push();
+        boundManager.setUpperBound( 1, 7 );
+        TS_ASSERT_EQUALS( boundManager.getUpperBound( 1 ), 7 );
+
+        context->pop();
+        boundManager.restoreLocalBounds();
+        TS_ASSERT_EQUALS( boundManager.getLowerBound( 0 ), 1 );
+        TS_ASSERT_EQUALS( boundManager.getUpperBound( 1 ), 10 );
+    }
+
+    void test_bound_levels()
+    {
+        BoundManager boundManager( *context );
+        boundManager.initialize( 2 );
+
+        boundManager.setLowerBound( 0, 1 );
+
+        boundManager.storeLocalBounds();
+        context->push();
+        boundManager.setUpperBound( 1, 5 );
+
+        boundManager.storeLocalBounds();
+        context->push();
+        boundManager.setLowerBound( 0, 2 );
+        boundManager.setUpperBound( 1, 4 );
+
+        TS_ASSERT_EQUALS( boundManager.getBoundLevel( 0, Tightening::LB, 2 ), 2U );
+        TS_ASSERT_EQUALS( boundManager.getBoundLevel( 0, Tightening::LB, 1.5 ), 2U );
+        TS_ASSERT_EQUALS( boundManager.getBoundLevel( 0, Tightening::LB, 1 ), 0U );
+        TS_ASSERT_EQUALS( boundManager.getBoundLevel( 0, Tightening::UB,
+                                                      boundManager.getUpperBound( 0 ) ), 0U );
+        TS_ASSERT_EQUALS( boundManager.getBoundLevel( 1, Tightening::UB, 4 ), 2U );
+        TS_ASSERT_EQUALS( boundManager.getBoundLevel( 1, Tightening::UB, 4.5 ), 2U );
+        TS_ASSERT_EQUALS( boundManager.getBoundLevel( 1, Tightening::UB, 5 ), 1U );
+
+        double lowerBounds[2];
+        double upperBounds[2];
+        boundManager.getBoundsAtLevel( 0, lowerBounds, upperBounds );
+        TS_ASSERT_EQUALS( lowerBounds[0], 1 );
+        TS_ASSERT_EQUALS( upperBounds[0], boundManager.getUpperBound( 0 ) );
+        TS_ASSERT_EQUALS( lowerBounds[1], boundManager.getLowerBound( 1 ) );
+        TS_ASSERT( !FloatUtils::isFinite( upperBounds[1] ) );
+
+        boundManager.getBoundsAtLevel( 1, lowerBounds, upperBounds );
+        TS_ASSERT_EQUALS( lowerBounds[0], 1 );
+        TS_ASSERT_EQUALS( upperBounds[1], 5 );
+
+        boundManager.getBoundsAtLevel( 2, lowerBounds, upperBounds );
+        TS_ASSERT_EQUALS( lowerBounds[0], 2 );
+        TS_ASSERT_EQUALS( upperBounds[1], 4 );
+
+        context->pop();
+        boundManager.restoreLocalBounds();
+
+        TS_ASSERT_EQUALS( boundManager.getBoundLevel( 0, Tightening::LB, 1 ), 0U );
+        TS_ASSERT_EQUALS( boundManager.getBoundLevel( 1, Tightening::UB, 5 ), 1U );
+
+        context->pop();
+        boundManager.restoreLocalBounds();
+
+        TS_ASSERT_EQUALS( boundManager.getBoundLevel( 1, Tightening::UB,
+                                                      boundManager.getUpperBound( 1 ) ), 0U );
+    }
+
 };
 
 //
@@ -0,0 +1,434 @@
+/*********************                                                        */
+/*! \file Test_CDSmtCore.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include <cxxtest/TestSuite.h>
+
+#include "CDSmtCore.h"
+#include "DisjunctionConstraint.h"
+#include "InfeasibleQueryException.h"
+#include "MockEngine.h"
+#include "ReluConstraint.h"
+
+class CDSmtCoreTestSuite : public CxxTest::TestSuite
+{
+public:
+    MockEngine *engine;
+    ReluConstraint *relu1;
+    ReluConstraint *relu2;
+    ReluConstraint *relu3;
+
+    void setUp()
+    {
+        TS_ASSERT( engine = new MockEngine );
+
+        TS_ASSERT( relu1 = new ReluConstraint( 0, 1 ) );
+        TS_ASSERT( relu2 = new ReluConstraint( 2, 3 ) );
+        TS_ASSERT( relu3 = new ReluConstraint( 4, 5 ) );
+
+        relu1->initializeCDOs( &engine->getContext() );
+        relu2->initializeCDOs( &engine->getContext() );
+        relu3->initializeCDOs( &engine->getContext() );
+    }
+
+    void tearDown()
+    {
+        TS_ASSERT_THROWS_NOTHING( delete relu3 );
+        TS_ASSERT_THROWS_NOTHING( delete relu2 );
+        TS_ASSERT_THROWS_NOTHING( delete relu1 );
+        TS_ASSERT_THROWS_NOTHING( delete engine );
+    }
+
+    void test_resolve_conflict_backjumps()
+    {
+        CDSmtCore smtCore( engine, engine->getContext() );
+
+        smtCore.pushDecision( relu1, RELU_PHASE_ACTIVE );
+        smtCore.pushDecision( relu2, RELU_PHASE_ACTIVE );
+        smtCore.pushDecision( relu3, RELU_PHASE_INACTIVE );
+        TS_ASSERT_EQUALS( smtCore.getDecisionLevel(), 3U );
+
+        // relu2 does not participate in the conflict, so the search jumps
+        // over its decision level
+        List<TrailEntry> conflict;
+        conflict.append( TrailEntry( relu1, RELU_PHASE_ACTIVE ) );
+        conflict.append( TrailEntry( relu3, RELU_PHASE_INACTIVE ) );
+        TS_ASSERT( smtCore.resolveConflict( conflict ) );
+
+        TS_ASSERT_EQUALS( smtCore.getDecisionLevel(), 1U );
+        TS_ASSERT_EQUALS( smtCore.getLearnedClauses().size(), 1U );
+        TS_ASSERT_EQUALS( smtCore.getLearnedClauses()[0].size(), 2U );
+
+        auto trailEntry = smtCore.trailBegin();
+        TS_ASSERT_EQUALS( ( *trailEntry )._pwlConstraint, relu1 );
+        TS_ASSERT_EQUALS( ( *trailEntry )._phase, RELU_PHASE_ACTIVE );
+        ++trailEntry;
+        TS_ASSERT_EQUALS( ( *trailEntry )._pwlConstraint, relu3 );
+        TS_ASSERT_EQUALS( ( *trailEntry )._phase, RELU_PHASE_ACTIVE );
+        ++trailEntry;
+        TS_ASSERT( trailEntry == smtCore.trailEnd() );
+
+        TS_ASSERT( relu3->isCaseInfeasible( RELU_PHASE_INACTIVE ) );
+        TS_ASSERT( !relu2->isCaseInfeasible( RELU_PHASE_ACTIVE ) );
+    }
+
+    void test_learned_clause_propagation()
+    {
+        CDSmtCore smtCore( engine, engine->getContext() );
+
+        smtCore.pushDecision( relu1, RELU_PHASE_ACTIVE );
+        smtCore.pushDecision( relu3, RELU_PHASE_INACTIVE );
+
+        List<TrailEntry> conflict;
+        conflict.append( TrailEntry( relu1, RELU_PHASE_ACTIVE ) );
+        conflict.append( TrailEntry( relu3, RELU_PHASE_INACTIVE ) );
+        TS_ASSERT( smtCore.resolveConflict( conflict ) );
+
+        // Backtrack to the root and revisit relu1's active phase: the
+        // learned clause implies relu3's active phase
+        TrailEntry lastDecision( nullptr, CONSTRAINT_INFEASIBLE );
+        TS_ASSERT( smtCore.popDecisionLevel( lastDecision ) );
+        TS_ASSERT_EQUALS( smtCore.getDecisionLevel(), 0U );
+        TS_ASSERT( !relu3->isCaseInfeasible( RELU_PHASE_INACTIVE ) );
+
+        smtCore.pushDecision( relu2, RELU_PHASE_INACTIVE );
+        TS_ASSERT( smtCore.propagateLearnedClauses( conflict ) );
+        TS_ASSERT( !relu3->isCaseInfeasible( RELU_PHASE_INACTIVE ) );
+
+        smtCore.pushDecision( relu1, RELU_PHASE_ACTIVE );
+        TS_ASSERT( smtCore.propagateLearnedClauses( conflict ) );
+        TS_ASSERT( relu3->isCaseInfeasible( RELU_PHASE_INACTIVE ) );
+
+        List<PiecewiseLinearCaseSplit> splits;
+        smtCore.allSplitsSoFar( splits );
+        TS_ASSERT_EQUALS( splits.size(), 3U );
+        TS_ASSERT_EQUALS( splits.back(), relu3->getCaseSplit( RELU_PHASE_ACTIVE ) );
+    }
+
+    void test_conflict_without_decisions()
+    {
+        CDSmtCore smtCore( engine, engine->getContext() );
+
+        relu1->markInfeasible( RELU_PHASE_INACTIVE );
+        smtCore.pushImplication( relu1 );
+
+        List<TrailEntry> conflict;
+        conflict.append( TrailEntry( relu1, RELU_PHASE_ACTIVE ) );
+        TS_ASSERT( !smtCore.resolveConflict( conflict ) );
+        TS_ASSERT( smtCore.getLearnedClauses().empty() );
+    }
+
+    void test_implications_are_lifted_to_decisions()
+    {
+        CDSmtCore smtCore( engine, engine->getContext() );
+
+        smtCore.pushDecision( relu1, RELU_PHASE_ACTIVE );
+        smtCore.pushDecision( relu2, RELU_PHASE_ACTIVE );
+
+        // An implication without a recorded reason depends on all the
+        // decisions up to its level
+        relu3->markInfeasible( RELU_PHASE_ACTIVE );
+        smtCore.pushImplication( relu3 );
+
+        // The implication is the latest entry of the conflict level, so it
+        // is replaced by its reason, which leaves relu2's decision as the
+        // asserting literal
+        List<TrailEntry> conflict;
+        conflict.append( TrailEntry( relu3, RELU_PHASE_INACTIVE ) );
+        conflict.append( TrailEntry( relu2, RELU_PHASE_ACTIVE ) );
+        TS_ASSERT( smtCore.resolveConflict( conflict ) );
+
+        const Vector<TrailEntry> &clause = smtCore.getLearnedClauses()[0];
+        TS_ASSERT_EQUALS( clause.size(), 2U );
+        TS_ASSERT_EQUALS( clause[0]._pwlConstraint, relu2 );
+        TS_ASSERT_EQUALS( clause[1]._pwlConstraint, relu1 );
+        TS_ASSERT_EQUALS( smtCore.getDecisionLevel(), 1U );
+        TS_ASSERT( relu2->isCaseInfeasible( RELU_PHASE_ACTIVE ) );
+    }
+
+    void test_implications_of_learned_clauses_are_resolved()
+    {
+        CDSmtCore smtCore( engine, engine->getContext() );
+
+        // Learn that relu3 is active whenever relu1 is
+        smtCore.pushDecision( relu1, RELU_PHASE_ACTIVE );
+        smtCore.pushDecision( relu3, RELU_PHASE_INACTIVE );
+        List<TrailEntry> conflict;
+        conflict.append( TrailEntry( relu1, RELU_PHASE_ACTIVE ) );
+        conflict.append( TrailEntry( relu3, RELU_PHASE_INACTIVE ) );
+        TS_ASSERT( smtCore.resolveConflict( conflict ) );
+        TS_ASSERT_EQUALS( smtCore.getDecisionLevel(), 1U );
+
+        // relu3's implication is replaced by the other literal of the
+        // clause, relu1's decision, which becomes the asserting literal
+        // since relu2's decision is not in the conflict
+        smtCore.pushDecision( relu2, RELU_PHASE_ACTIVE );
+        conflict.clear();
+        conflict.append( TrailEntry( relu3, RELU_PHASE_ACTIVE ) );
+        conflict.append( TrailEntry( relu1, RELU_PHASE_ACTIVE ) );
+        TS_ASSERT( smtCore.resolveConflict( conflict ) );
+
+        TS_ASSERT_EQUALS( smtCore.getLearnedClauses().size(), 2U );
+        TS_ASSERT_EQUALS( smtCore.getLearnedClauses()[1].size(), 1U );
+        TS_ASSERT_EQUALS( smtCore.getDecisionLevel(), 0U );
+        TS_ASSERT( relu1->isCaseInfeasible( RELU_PHASE_ACTIVE ) );
+        TS_ASSERT( !relu2->isCaseInfeasible( RELU_PHASE_ACTIVE ) );
+    }
+
+    void test_phases_fixed_by_bounds_are_explained_by_the_bounds()
+    {
+        CDSmtCore smtCore( engine, engine->getContext() );
+
+        smtCore.pushDecision( relu1, RELU_PHASE_ACTIVE );
+        smtCore.pushDecision( relu3, RELU_PHASE_ACTIVE );
+
+        // At level 2, relu2 is inactive because of an upper bound on its
+        // input that was found at level 1
+        engine->setUpperBound( 2, -1 );
+        engine->setBoundLevel( 2, Tightening::UB, 1 );
+        relu2->setActiveConstraint( false );
+        relu2->setPhaseStatus( RELU_PHASE_INACTIVE );
+        smtCore.pushBoundImplication( relu2 );
+
+        // The implication only depends on relu1's decision, so the search
+        // backjumps to level 1 and flips relu3
+        List<TrailEntry> conflict;
+        conflict.append( TrailEntry( relu2, RELU_PHASE_INACTIVE ) );
+        conflict.append( TrailEntry( relu3, RELU_PHASE_ACTIVE ) );
+        TS_ASSERT( smtCore.resolveConflict( conflict ) );
+
+        const Vector<TrailEntry> &clause = smtCore.getLearnedClauses()[0];
+        TS_ASSERT_EQUALS( clause.size(), 2U );
+        TS_ASSERT_EQUALS( clause[0]._pwlConstraint, relu3 );
+        TS_ASSERT_EQUALS( clause[1]._pwlConstraint, relu1 );
+        TS_ASSERT_EQUALS( smtCore.getDecisionLevel(), 1U );
+        TS_ASSERT( relu3->isCaseInfeasible( RELU_PHASE_ACTIVE ) );
+    }
+
+    void test_learned_clauses_are_minimized_by_refutation()
+    {
+        CDSmtCore smtCore( engine, engine->getContext() );
+
+        smtCore.pushDecision( relu1, RELU_PHASE_ACTIVE );
+        smtCore.pushDecision( relu2, RELU_PHASE_ACTIVE );
+        smtCore.pushDecision( relu3, RELU_PHASE_INACTIVE );
+
+        // The engine refutes relu1's and relu3's phases without relu2's,
+        // so the conflict of all the decisions is reduced to them
+        List<PiecewiseLinearCaseSplit> infeasible;
+        infeasible.append( relu1->getCaseSplit( RELU_PHASE_ACTIVE ) );
+        infeasible.append( relu3->getCaseSplit( RELU_PHASE_INACTIVE ) );
+        engine->addInfeasibleCaseSplits( infeasible );
+
+        List<TrailEntry> conflict;
+        smtCore.allDecisionsAsConflict( conflict );
+        TS_ASSERT( smtCore.resolveConflict( conflict ) );
+
+        // One check of relu3's phase at level 1, one of the whole clause,
+        // and one per other literal
+        TS_ASSERT_EQUALS( engine->_numberOfInfeasibilityChecks, 4U );
+        const Vector<TrailEntry> &clause = smtCore.getLearnedClauses()[0];
+        TS_ASSERT_EQUALS( clause.size(), 2U );
+        TS_ASSERT_EQUALS( clause[0]._pwlConstraint, relu3 );
+        TS_ASSERT_EQUALS( clause[1]._pwlConstraint, relu1 );
+        TS_ASSERT_EQUALS( smtCore.getDecisionLevel(), 1U );
+        TS_ASSERT( relu3->isCaseInfeasible( RELU_PHASE_INACTIVE ) );
+        TS_ASSERT( !relu2->isCaseInfeasible( RELU_PHASE_ACTIVE ) );
+    }
+
+    void test_backjump_level_is_lowered_by_refutation()
+    {
+        CDSmtCore smtCore( engine, engine->getContext() );
+
+        smtCore.pushDecision( relu1, RELU_PHASE_ACTIVE );
+        smtCore.pushDecision( relu2, RELU_PHASE_ACTIVE );
+        smtCore.pushDecision( relu3, RELU_PHASE_INACTIVE );
+
+        // The bounds at level 1 refute relu3's phase, so relu1's decision,
+        // which is not in the conflict, replaces relu2's
+        List<PiecewiseLinearCaseSplit> infeasible;
+        infeasible.append( relu3->getCaseSplit( RELU_PHASE_INACTIVE ) );
+        engine->addInfeasibleCaseSplits( infeasible, 1 );
+
+        List<TrailEntry> conflict;
+        conflict.append( TrailEntry( relu2, RELU_PHASE_ACTIVE ) );
+        conflict.append( TrailEntry( relu3, RELU_PHASE_INACTIVE ) );
+        TS_ASSERT( smtCore.resolveConflict( conflict ) );
+
+        // Checks of relu3's phase at levels 1 and 0, and of the whole clause
+        TS_ASSERT_EQUALS( engine->_numberOfInfeasibilityChecks, 3U );
+        const Vector<TrailEntry> &clause = smtCore.getLearnedClauses()[0];
+        TS_ASSERT_EQUALS( clause.size(), 2U );
+        TS_ASSERT_EQUALS( clause[0]._pwlConstraint, relu3 );
+        TS_ASSERT_EQUALS( clause[1]._pwlConstraint, relu1 );
+        TS_ASSERT_EQUALS( smtCore.getDecisionLevel(), 1U );
+        TS_ASSERT( relu3->isCaseInfeasible( RELU_PHASE_INACTIVE ) );
+    }
+
+    void test_explain_bounds()
+    {
+        CDSmtCore smtCore( engine, engine->getContext() );
+
+        smtCore.pushDecision( relu1, RELU_PHASE_INACTIVE );
+        smtCore.pushDecision( relu2, RELU_PHASE_ACTIVE );
+        smtCore.pushDecision( relu3, RELU_PHASE_ACTIVE );
+
+        // The upper bound of x0 is set by relu1's inactive phase, and the
+        // upper bound of x7 holds at the root
+        engine->setBoundLevel( 0, Tightening::UB, 1 );
+        List<Tightening> bounds;
+        bounds.append( Tightening( 0, 0, Tightening::UB ) );
+        bounds.append( Tightening( 7, 3, Tightening::UB ) );
+
+        List<TrailEntry> conflict;
+        smtCore.explainBounds( bounds, conflict );
+        TS_ASSERT_EQUALS( conflict.size(), 1U );
+        TS_ASSERT_EQUALS( conflict.front()._pwlConstraint, relu1 );
+        TS_ASSERT_EQUALS( conflict.front()._phase, RELU_PHASE_INACTIVE );
+
+        // A bound propagated at level 2 depends on the first two decisions,
+        // but not on relu3's
+        engine->setBoundLevel( 6, Tightening::LB, 2 );
+        bounds.append( Tightening( 6, 5, Tightening::LB ) );
+        smtCore.explainBounds( bounds, conflict );
+        TS_ASSERT_EQUALS( conflict.size(), 3U );
+        for ( const auto &entry : conflict )
+            TS_ASSERT_DIFFERS( entry._pwlConstraint, relu3 );
+        TS_ASSERT_EQUALS( conflict.back()._pwlConstraint, relu2 );
+
+        // A bound that is tighter than the one set by the split is not
+        // explained by it
+        bounds.clear();
+        bounds.append( Tightening( 0, -1, Tightening::UB ) );
+        smtCore.explainBounds( bounds, conflict );
+        TS_ASSERT_EQUALS( conflict.size(), 1U );
+        TS_ASSERT_EQUALS( conflict.front()._pwlConstraint, relu1 );
+    }
+
+    void test_asserting_literal_of_multi_case_constraint_is_not_a_decision()
+    {
+        CDSmtCore smtCore( engine, engine->getContext() );
+
+        List<PiecewiseLinearCaseSplit> disjuncts;
+        for ( unsigned i = 0; i < 3; ++i )
+        {
+            PiecewiseLinearCaseSplit disjunct;
+            disjunct.storeBoundTightening( Tightening( 6, i, Tightening::LB ) );
+            disjunct.storeBoundTightening( Tightening( 6, i, Tightening::UB ) );
+            disjuncts.append( disjunct );
+        }
+        DisjunctionConstraint disjunction( disjuncts );
+        disjunction.initializeCDOs( &engine->getContext() );
+        PhaseStatus firstCase = disjunction.getAllCases().front();
+
+        smtCore.pushDecision( relu1, RELU_PHASE_ACTIVE );
+        smtCore.decideSplit( &disjunction );
+        TS_ASSERT_EQUALS( smtCore.getDecisionLevel(), 2U );
+        TS_ASSERT( !disjunction.isActive() );
+
+        List<TrailEntry> conflict;
+        conflict.append( TrailEntry( relu1, RELU_PHASE_ACTIVE ) );
+        conflict.append( TrailEntry( &disjunction, firstCase ) );
+        TS_ASSERT( smtCore.resolveConflict( conflict ) );
+
+        // Two cases of the disjunction are left, so the learned clause only
+        // excludes the first one, and the disjunction remains undecided
+        TS_ASSERT_EQUALS( smtCore.getDecisionLevel(), 1U );
+        TS_ASSERT( disjunction.isCaseInfeasible( firstCase ) );
+        TS_ASSERT_EQUALS( disjunction.numFeasibleCases(), 2U );
+        TS_ASSERT( disjunction.isActive() );
+
+        auto trailEntry = smtCore.trailBegin();
+        TS_ASSERT_EQUALS( ( *trailEntry )._pwlConstraint, relu1 );
+        ++trailEntry;
+        TS_ASSERT( trailEntry == smtCore.trailEnd() );
+    }
+
+    void test_decide_splits_on_the_constraint_picked_by_the_engine()
+    {
+        CDSmtCore smtCore( engine, engine->getContext() );
+
+        // An interval split, which is not a constraint of the query
+        List<PiecewiseLinearCaseSplit> halves;
+        PiecewiseLinearCaseSplit lowerHalf;
+        lowerHalf.storeBoundTightening( Tightening( 6, 0, Tightening::UB ) );
+        halves.append( lowerHalf );
+        PiecewiseLinearCaseSplit upperHalf;
+        upperHalf.storeBoundTightening( Tightening( 6, 0, Tightening::LB ) );
+        halves.append( upperHalf );
+        DisjunctionConstraint interval( halves );
+        interval.initializeCDOs( &engine->getContext() );
+        engine->setSplitPLConstraint( &interval );
+
+        smtCore.setConstraintViolationThreshold( 1 );
+        smtCore.reportViolatedConstraint( relu1 );
+        TS_ASSERT( smtCore.needToSplit() );
+        TS_ASSERT_THROWS_NOTHING( smtCore.decide() );
+        TS_ASSERT_EQUALS( smtCore.getDecisionLevel(), 1U );
+        TS_ASSERT( !interval.isActive() );
+        TS_ASSERT( relu1->isActive() );
+
+        // Undoing the decision reactivates the split
+        TrailEntry lastDecision( nullptr, CONSTRAINT_INFEASIBLE );
+        TS_ASSERT( smtCore.popDecisionLevel( lastDecision ) );
+        TS_ASSERT_EQUALS( lastDecision._pwlConstraint, &interval );
+        TS_ASSERT( interval.isActive() );
+    }
+
+    void test_decide_throws_if_the_query_is_unsat()
+    {
+        CDSmtCore smtCore( engine, engine->getContext() );
+
+        // Learn that relu3 cannot be active if relu1 is inactive, and that it
+        // cannot be inactive if relu2 is inactive
+        List<TrailEntry> conflict;
+        TrailEntry lastDecision( nullptr, CONSTRAINT_INFEASIBLE );
+        smtCore.pushDecision( relu1, RELU_PHASE_INACTIVE );
+        smtCore.pushDecision( relu3, RELU_PHASE_ACTIVE );
+        conflict.append( TrailEntry( relu1, RELU_PHASE_INACTIVE ) );
+        conflict.append( TrailEntry( relu3, RELU_PHASE_ACTIVE ) );
+        TS_ASSERT( smtCore.resolveConflict( conflict ) );
+        TS_ASSERT( smtCore.popDecisionLevel( lastDecision ) );
+
+        smtCore.pushDecision( relu2, RELU_PHASE_INACTIVE );
+        smtCore.pushDecision( relu3, RELU_PHASE_INACTIVE );
+        conflict.clear();
+        conflict.append( TrailEntry( relu2, RELU_PHASE_INACTIVE ) );
+        conflict.append( TrailEntry( relu3, RELU_PHASE_INACTIVE ) );
+        TS_ASSERT( smtCore.resolveConflict( conflict ) );
+        TS_ASSERT( smtCore.popDecisionLevel( lastDecision ) );
+        TS_ASSERT_EQUALS( smtCore.getDecisionLevel(), 0U );
+        TS_ASSERT_EQUALS( smtCore.getLearnedClauses().size(), 2U );
+
+        // Both relu1 and relu2 are inactive at the root
+        relu1->markInfeasible( RELU_PHASE_ACTIVE );
+        smtCore.pushImplication( relu1 );
+        relu2->markInfeasible( RELU_PHASE_ACTIVE );
+        smtCore.pushImplication( relu2 );
+
+        // Either case of relu3 falsifies a learned clause, independently of
+        // any decision
+        smtCore.setConstraintViolationThreshold( 1 );
+        smtCore.reportViolatedConstraint( relu3 );
+        TS_ASSERT( smtCore.needToSplit() );
+        TS_ASSERT_THROWS( smtCore.decide(), InfeasibleQueryException );
+        TS_ASSERT_EQUALS( smtCore.getDecisionLevel(), 0U );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
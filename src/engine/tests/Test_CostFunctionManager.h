@@ -115,6 +115,84 @@ public:
         TS_ASSERT_THROWS_NOTHING( delete manager );
     }
 
+    void test_adjust_basic_cost_accuracy()
+    {
+        CostFunctionManager *manager = NULL;
+        MockTableau tableau;
+
+        unsigned n = 5;
+        unsigned m = 3;
+        tableau.setDimensions( m, n );
+
+        TS_ASSERT( manager = new CostFunctionManager( &tableau ) );
+        TS_ASSERT_THROWS_NOTHING( manager->initialize() );
+
+        double multipliers[3] = { 0, 2, -3 };
+        memcpy( tableau.nextBtranOutput, multipliers, sizeof(double) * 3 );
+        tableau.nextNonBasicIndexToVariable[0] = 2;
+        tableau.nextNonBasicIndexToVariable[1] = 0;
+        double columnZero[] = { 1, -1, 2 };
+        double columnTwo[] = { 3, 1, 0 };
+        tableau.nextAColumn[0] = columnZero;
+        tableau.nextAColumn[2] = columnTwo;
+
+        tableau.nextBasicIndexToVariable[0] = 5;
+        tableau.nextBasicIndexToVariable[1] = 6;
+        tableau.nextBasicIndexToVariable[2] = 7;
+
+        tableau.lowerBounds[5] = 0;
+        tableau.upperBounds[5] = 1;
+        tableau.lowerBounds[6] = 0;
+        tableau.upperBounds[6] = 1;
+        tableau.lowerBounds[7] = 0;
+        tableau.upperBounds[7] = 1;
+
+        tableau.nextValues[5] = 10; // Too high
+        tableau.nextValues[6] = -10; // Too low
+        tableau.nextValues[7] = 0.5; // Okay
+
+        TS_ASSERT_THROWS_NOTHING( manager->computeCoreCostFunction() );
+
+        // By default, the adjusted function is considered fresh
+        tableau.nextValues[5] = 0.5;
+        TS_ASSERT_THROWS_NOTHING( manager->adjustBasicCostAccuracy() );
+        TS_ASSERT( manager->costFunctionJustComputed() );
+
+        // Otherwise, when the first basic returns within its bounds and
+        // its cost is dropped, the adjusted function may not be trusted to
+        // prove infeasibility
+        manager->setRecheckAdjustedCostFunction( true );
+        tableau.nextValues[5] = 10;
+        TS_ASSERT_THROWS_NOTHING( manager->computeCoreCostFunction() );
+        tableau.nextValues[5] = 0.5;
+        TS_ASSERT_THROWS_NOTHING( manager->adjustBasicCostAccuracy() );
+
+        double expectedBTranInput[] = { 0, -1, 0 };
+        TS_ASSERT_SAME_DATA( tableau.lastBtranInput, expectedBTranInput, sizeof(double) * m );
+        TS_ASSERT_EQUALS( manager->getCostFunctionStatus(),
+                          CostFunctionManager::COST_FUNCTION_UPDATED );
+
+        TS_ASSERT_THROWS_NOTHING( manager->computeCoreCostFunction() );
+        TS_ASSERT( manager->costFunctionJustComputed() );
+
+        // The third basic leaves its bounds, which the function does not
+        // account for
+        tableau.nextValues[7] = 10;
+        TS_ASSERT_THROWS_NOTHING( manager->adjustBasicCostAccuracy() );
+        TS_ASSERT_EQUALS( manager->getCostFunctionStatus(),
+                          CostFunctionManager::COST_FUNCTION_UPDATED );
+
+        // When optimizing, the adjusted function is considered fresh
+        tableau.toggleOptimization( true );
+        tableau.nextValues[7] = 0.5;
+        TS_ASSERT_THROWS_NOTHING( manager->computeCoreCostFunction() );
+        tableau.nextValues[6] = 0.5;
+        TS_ASSERT_THROWS_NOTHING( manager->adjustBasicCostAccuracy() );
+        TS_ASSERT( manager->costFunctionJustComputed() );
+
+        TS_ASSERT_THROWS_NOTHING( delete manager );
+    }
+
     void test_compute_cost_function()
     {
         CostFunctionManager *manager = NULL;
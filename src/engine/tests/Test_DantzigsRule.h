@@ -49,10 +49,10 @@ public:
     {
         DantzigsRule dantzigsRule;
 
-        Set<unsigned> excluded;
-        List<unsigned> candidates;
+        Bitset excluded( 101 );
+        Vector<unsigned> candidates;
 
-        TS_ASSERT( !dantzigsRule.select( *tableau, candidates, excluded ) );
+        TS_ASSERT( !dantzigsRule.select( *tableau, candidates.data(), candidates.size(), excluded ) );
 
         tableau->setDimensions( 10, 100 );
 
@@ -71,17 +71,17 @@ public:
         tableau->nextCostFunction[25] = -1202;
         tableau->nextCostFunction[33] = 10;
 
-        TS_ASSERT( dantzigsRule.select( *tableau, candidates, excluded ) );
+        TS_ASSERT( dantzigsRule.select( *tableau, candidates.data(), candidates.size(), excluded ) );
         TS_ASSERT_EQUALS( tableau->mockEnteringVariable, 10U );
 
-        excluded.insert( 10 );
-        TS_ASSERT( dantzigsRule.select( *tableau, candidates, excluded ) );
+        excluded.set( 10 );
+        TS_ASSERT( dantzigsRule.select( *tableau, candidates.data(), candidates.size(), excluded ) );
         TS_ASSERT_EQUALS( tableau->mockEnteringVariable, 51U );
         excluded.clear();
 
         candidates.append( 25 );
 
-        TS_ASSERT( dantzigsRule.select( *tableau, candidates, excluded ) );
+        TS_ASSERT( dantzigsRule.select( *tableau, candidates.data(), candidates.size(), excluded ) );
         TS_ASSERT_EQUALS( tableau->mockEnteringVariable, 25U );
     }
 };
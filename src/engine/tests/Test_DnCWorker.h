@@ -24,7 +24,7 @@ class DnCWorkerTestSuite : public CxxTest::TestSuite
 {
 public:
 
-    WorkerQueue *_workload;
+    WorkStealingQueue *_workload;
     std::shared_ptr<MockEngine> _engine;
 
     DnCWorkerTestSuite()
@@ -34,7 +34,7 @@ public:
 
     void setUp()
     {
-        _workload = new WorkerQueue( 0 );
+        _workload = new WorkStealingQueue( 1 );
 
         // Initialize the mockEngine
         _engine = std::make_shared<MockEngine>();
@@ -59,7 +59,7 @@ public:
         SubQuery *subQuery = NULL;
         while ( !_workload->empty() )
         {
-            _workload->pop( subQuery );
+            _workload->pop( 0, subQuery );
             if ( subQuery )
             {
                 delete subQuery;
@@ -97,7 +97,7 @@ public:
         subQuery->_queryId = "";
         subQuery->_split = std::move( split );
         subQuery->_timeoutInSeconds = 5;
-        TS_ASSERT( _workload->push( std::move( subQuery ) ) );
+        TS_ASSERT_THROWS_NOTHING( _workload->push( 0, subQuery ) );
     }
 
     // Test different branches of DnCWorker.popOneSubQueryAndSolve()
@@ -217,15 +217,15 @@ public:
 
         TS_ASSERT( gurobi3.haveFeasibleSolution() );
 
-        Map<String, double> values3;
+        Map<unsigned, double> values3;
         double costOrObjective3;
         
         gurobi3.extractSolution(values3, costOrObjective3 );
         
-        double x0_sol3 = values3["x0"];
-        double x1_sol3 = values3["x1"];
-        double x2_sol3 = values3["x2"];
-        double x3_sol3 = values3["x3"];
+        double x0_sol3 = values3[0];
+        double x1_sol3 = values3[1];
+        double x2_sol3 = values3[2];
+        double x3_sol3 = values3[3];
 
         TS_ASSERT_LESS_THAN_EQUALS( x1_sol3, x3_sol3 );
         TS_ASSERT_LESS_THAN_EQUALS( x2_sol3, x3_sol3 );
@@ -290,15 +290,15 @@ public:
 
         TS_ASSERT( gurobi4.haveFeasibleSolution() );
 
-        Map<String, double> values4;
+        Map<unsigned, double> values4;
         double costOrObjective4;
         
         gurobi4.extractSolution(values4, costOrObjective4 );
         
-        double x0_sol4 = values4["x0"];
-        double x1_sol4 = values4["x1"];
-        double x2_sol4 = values4["x2"];
-        double x3_sol4 = values4["x3"];
+        double x0_sol4 = values4[0];
+        double x1_sol4 = values4[1];
+        double x2_sol4 = values4[2];
+        double x3_sol4 = values4[3];
 
         TS_ASSERT_LESS_THAN_EQUALS( x1_sol4, x0_sol4 );
         TS_ASSERT_LESS_THAN_EQUALS( x2_sol4, x0_sol4 );
@@ -403,14 +403,14 @@ public:
 
         TS_ASSERT( gurobi1.haveFeasibleSolution() );
     
-        Map<String, double> solution1;
+        Map<unsigned, double> solution1;
         double costValue1;
 
         TS_ASSERT_THROWS_NOTHING( gurobi1.extractSolution( solution1, costValue1 ) );
 
-        TS_ASSERT( solution1.exists( "x0" ) );
-        TS_ASSERT( solution1.exists( "x1" ) );
-        TS_ASSERT( !solution1.exists( "a0" ) );
+        TS_ASSERT( solution1.exists( 0 ) );
+        TS_ASSERT( solution1.exists( 1 ) );
+        TS_ASSERT( !solution1.exists( 2 ) );
 
         /*
          * x0_ub < 0
@@ -443,14 +443,14 @@ public:
         TS_ASSERT_THROWS_NOTHING( gurobi2.solve() );
 
         TS_ASSERT( gurobi2.haveFeasibleSolution() );
-        Map<String, double> solution2;
+        Map<unsigned, double> solution2;
         double costValue2;
 
         TS_ASSERT_THROWS_NOTHING( gurobi2.extractSolution( solution2, costValue2 ) );
 
-        TS_ASSERT( solution2.exists( "x0" ) );
-        TS_ASSERT( solution2.exists( "x1" ) );
-        TS_ASSERT( !solution2.exists( "a0" ) );
+        TS_ASSERT( solution2.exists( 0 ) );
+        TS_ASSERT( solution2.exists( 1 ) );
+        TS_ASSERT( !solution2.exists( 2 ) );
 
         /*
          * x0_lb < 0 and x0_ub > 0
@@ -484,14 +484,14 @@ public:
 
         TS_ASSERT( gurobi3.haveFeasibleSolution() );
 
-        Map<String, double> solution3;
+        Map<unsigned, double> solution3;
         double costValue3;
 
         TS_ASSERT_THROWS_NOTHING( gurobi3.extractSolution( solution3, costValue3 ) );
 
-        TS_ASSERT( solution3.exists( "x0" ) );
-        TS_ASSERT( solution3.exists( "x1" ) );
-        TS_ASSERT( solution3.exists( "a0" ) );
+        TS_ASSERT( solution3.exists( 0 ) );
+        TS_ASSERT( solution3.exists( 1 ) );
+        TS_ASSERT( solution3.exists( 2 ) );
 
         /*
          * x0_lb = 0 and x0_ub = 0
@@ -525,14 +525,14 @@ public:
 
         TS_ASSERT( gurobi4.haveFeasibleSolution() );
 
-        Map<String, double> solution4;
+        Map<unsigned, double> solution4;
         double costValue4;
 
         TS_ASSERT_THROWS_NOTHING( gurobi4.extractSolution( solution4, costValue4 ) );
 
-        TS_ASSERT( solution4.exists( "x0" ) );
-        TS_ASSERT( solution4.exists( "x1" ) );
-        TS_ASSERT( !solution4.exists( "a0" ) );
+        TS_ASSERT( solution4.exists( 0 ) );
+        TS_ASSERT( solution4.exists( 1 ) );
+        TS_ASSERT( !solution4.exists( 2 ) );
 
         /*
          * x0_lb < 0 and x0_ub = 0
@@ -566,14 +566,14 @@ public:
 
         TS_ASSERT( gurobi5.haveFeasibleSolution() );
 
-        Map<String, double> solution5;
+        Map<unsigned, double> solution5;
         double costValue5;
 
         TS_ASSERT_THROWS_NOTHING( gurobi5.extractSolution( solution5, costValue5 ) );
 
-        TS_ASSERT( solution5.exists( "x0" ) );
-        TS_ASSERT( solution5.exists( "x1" ) );
-        TS_ASSERT( !solution5.exists( "a0" ) );
+        TS_ASSERT( solution5.exists( 0 ) );
+        TS_ASSERT( solution5.exists( 1 ) );
+        TS_ASSERT( !solution5.exists( 2 ) );
 
         /*
          * x0_lb = 0 and x0_ub > 0
@@ -607,14 +607,14 @@ public:
 
         TS_ASSERT( gurobi6.haveFeasibleSolution() );
 
-        Map<String, double> solution6;
+        Map<unsigned, double> solution6;
         double costValue6;
 
         TS_ASSERT_THROWS_NOTHING( gurobi6.extractSolution( solution6, costValue6 ) );
 
-        TS_ASSERT( solution6.exists( "x0" ) );
-        TS_ASSERT( solution6.exists( "x1" ) );
-        TS_ASSERT( !solution6.exists( "a0" ) );
+        TS_ASSERT( solution6.exists( 0 ) );
+        TS_ASSERT( solution6.exists( 1 ) );
+        TS_ASSERT( !solution6.exists( 2 ) );
 
 #else
         TS_ASSERT( true );
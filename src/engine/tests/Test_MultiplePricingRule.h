@@ -0,0 +1,117 @@
+/*********************                                                        */
+/*! \file Test_MultiplePricingRule.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "GlobalConfiguration.h"
+#include "MockTableau.h"
+#include "MultiplePricingRule.h"
+#include "Statistics.h"
+
+class MultiplePricingRuleTestSuite : public CxxTest::TestSuite
+{
+public:
+    MockTableau *tableau;
+
+    void setUp()
+    {
+        TS_ASSERT( tableau = new MockTableau );
+    }
+
+    void tearDown()
+    {
+        TS_ASSERT_THROWS_NOTHING( delete tableau );
+    }
+
+    unsigned long long scanned( const Statistics &statistics )
+    {
+        return statistics.getLongAttribute( Statistics::NUM_PRICING_CANDIDATES_SCANNED );
+    }
+
+    void test_select()
+    {
+        TS_ASSERT_EQUALS( GlobalConfiguration::MULTIPLE_PRICING_LIST_SIZE, 10U );
+        TS_ASSERT_EQUALS( GlobalConfiguration::MULTIPLE_PRICING_MAX_MINOR_ITERATIONS, 10U );
+
+        MultiplePricingRule multiplePricing;
+        Statistics statistics;
+        multiplePricing.setStatistics( &statistics );
+
+        tableau->setDimensions( 10, 110 );
+        Bitset excluded( 100 );
+
+        // Candidates 0..14, with increasingly attractive coefficients
+        for ( unsigned i = 0; i < 15; ++i )
+        {
+            tableau->mockCandidates.append( i );
+            tableau->nextCostFunction[i] = ( i % 2 ) ? ( i + 1.0 ) : -( i + 1.0 );
+        }
+
+        // The first selection prices everything, and keeps the 10 best
+        TS_ASSERT( multiplePricing.select( *tableau, NULL, 0, excluded ) );
+        TS_ASSERT_EQUALS( tableau->mockEnteringVariable, 14U );
+        TS_ASSERT_EQUALS( scanned( statistics ), 100U );
+
+        Vector<unsigned> expectedList = { 14, 13, 12, 11, 10, 9, 8, 7, 6, 5 };
+        TS_ASSERT_EQUALS( multiplePricing.getCandidateList(), expectedList );
+
+        // Pivot on 14, which then leaves the list
+        tableau->nextEnteringVariableIndex = 14;
+        multiplePricing.postPivotHook( *tableau, false );
+        TS_ASSERT_EQUALS( multiplePricing.getCandidateList().size(), 9U );
+
+        // A variable outside the list becomes attractive, but only the
+        // list is priced
+        tableau->nextCostFunction[3] = 100;
+        TS_ASSERT( multiplePricing.select( *tableau, NULL, 0, excluded ) );
+        TS_ASSERT_EQUALS( tableau->mockEnteringVariable, 13U );
+        TS_ASSERT_EQUALS( scanned( statistics ), 109U );
+
+        excluded.set( 13 );
+        TS_ASSERT( multiplePricing.select( *tableau, NULL, 0, excluded ) );
+        TS_ASSERT_EQUALS( tableau->mockEnteringVariable, 12U );
+        excluded.clear();
+
+        // Once no listed variable is eligible, everything is priced again
+        tableau->mockCandidates = { 0, 1, 2, 3, 4 };
+        TS_ASSERT( multiplePricing.select( *tableau, NULL, 0, excluded ) );
+        TS_ASSERT_EQUALS( tableau->mockEnteringVariable, 3U );
+
+        expectedList = { 3, 4, 2, 1, 0 };
+        TS_ASSERT_EQUALS( multiplePricing.getCandidateList(), expectedList );
+
+        // The list is also refreshed after enough pivots
+        tableau->nextEnteringVariableIndex = 50;
+        for ( unsigned i = 0; i < GlobalConfiguration::MULTIPLE_PRICING_MAX_MINOR_ITERATIONS; ++i )
+            multiplePricing.postPivotHook( *tableau, false );
+
+        tableau->nextCostFunction[3] = 1;
+        statistics.setLongAttribute( Statistics::NUM_PRICING_CANDIDATES_SCANNED, 0 );
+        TS_ASSERT( multiplePricing.select( *tableau, NULL, 0, excluded ) );
+        TS_ASSERT_EQUALS( tableau->mockEnteringVariable, 4U );
+        TS_ASSERT_EQUALS( scanned( statistics ), 100U );
+
+        // Nothing eligible
+        tableau->mockCandidates.clear();
+        TS_ASSERT( !multiplePricing.select( *tableau, NULL, 0, excluded ) );
+        TS_ASSERT( multiplePricing.getCandidateList().empty() );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,291 @@
+/*********************                                                        */
+/*! \file Test_NativeLPSolver.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "FloatUtils.h"
+#include "MString.h"
+#include "NativeLPSolver.h"
+
+class NativeLPSolverTestSuite : public CxxTest::TestSuite
+{
+public:
+    void setUp()
+    {
+    }
+
+    void tearDown()
+    {
+    }
+
+    void addSmallLP( NativeLPSolver &solver )
+    {
+        /*
+          x + y <= 4
+          x + 3y <= 6
+          x - y >= -1
+          0 <= x <= 3, 0 <= y <= 10
+
+          with x and y under the handles 0 and 1
+        */
+        solver.addVariable( 0, 0, 3 );
+        solver.addVariable( 1, 0, 10 );
+
+        List<ILPSolver::Term> terms;
+        terms.append( ILPSolver::Term( 1, 0 ) );
+        terms.append( ILPSolver::Term( 1, 1 ) );
+        solver.addLeqConstraint( terms, 4 );
+
+        terms.clear();
+        terms.append( ILPSolver::Term( 1, 0 ) );
+        terms.append( ILPSolver::Term( 3, 1 ) );
+        solver.addLeqConstraint( terms, 6 );
+
+        terms.clear();
+        terms.append( ILPSolver::Term( 1, 0 ) );
+        terms.append( ILPSolver::Term( -1, 1 ) );
+        solver.addGeqConstraint( terms, -1 );
+    }
+
+    void test_optimize_small_lp()
+    {
+        NativeLPSolver solver;
+        addSmallLP( solver );
+
+        // max x + 2y: optimal at x = 3, y = 1
+        List<ILPSolver::Term> objective;
+        objective.append( ILPSolver::Term( 1, 0 ) );
+        objective.append( ILPSolver::Term( 2, 1 ) );
+        solver.setObjective( objective );
+        solver.solve();
+
+        TS_ASSERT( solver.optimal() );
+        TS_ASSERT( FloatUtils::areEqual( solver.getOptimalCostOrObjective(), 5 ) );
+        TS_ASSERT( FloatUtils::areEqual( solver.getAssignment( 0 ), 3 ) );
+        TS_ASSERT( FloatUtils::areEqual( solver.getAssignment( 1 ), 1 ) );
+
+        Map<unsigned, double> values;
+        double value;
+        solver.extractSolution( values, value );
+        TS_ASSERT_EQUALS( values.size(), 2U );
+        TS_ASSERT( FloatUtils::areEqual( value, 5 ) );
+
+        // max y: the third constraint bounds y by x + 1, and the second by
+        // (6 - x) / 3, so y <= 1.75
+        objective.clear();
+        objective.append( ILPSolver::Term( 1, 1 ) );
+        solver.reset();
+        solver.setObjective( objective );
+        solver.solve();
+
+        TS_ASSERT( solver.optimal() );
+        TS_ASSERT( FloatUtils::areEqual( solver.getOptimalCostOrObjective(), 1.75 ) );
+
+        // min x - y: at x = 0, y = 1
+        objective.clear();
+        objective.append( ILPSolver::Term( 1, 0 ) );
+        objective.append( ILPSolver::Term( -1, 1 ) );
+        solver.setCost( objective );
+        solver.solve();
+
+        TS_ASSERT( solver.optimal() );
+        TS_ASSERT( FloatUtils::areEqual( solver.getOptimalCostOrObjective(), -1 ) );
+    }
+
+    void test_sparse_handles()
+    {
+        // Handles need not be contiguous, nor added in order
+        NativeLPSolver solver;
+        solver.addVariable( 7, 0, 2 );
+        solver.addVariable( 3, 0, 5 );
+
+        List<ILPSolver::Term> terms;
+        terms.append( ILPSolver::Term( 1, 7 ) );
+        terms.append( ILPSolver::Term( 1, 3 ) );
+        solver.addLeqConstraint( terms, 4 );
+
+        List<ILPSolver::Term> objective;
+        objective.append( ILPSolver::Term( 2, 7 ) );
+        objective.append( ILPSolver::Term( 1, 3 ) );
+        solver.setObjective( objective );
+        solver.solve();
+
+        TS_ASSERT( solver.optimal() );
+        TS_ASSERT( FloatUtils::areEqual( solver.getOptimalCostOrObjective(), 6 ) );
+        TS_ASSERT( FloatUtils::areEqual( solver.getAssignment( 7 ), 2 ) );
+        TS_ASSERT( FloatUtils::areEqual( solver.getAssignment( 3 ), 2 ) );
+        TS_ASSERT( solver.existsAssignment( 3 ) );
+        TS_ASSERT( !solver.existsAssignment( 0 ) );
+        TS_ASSERT( !solver.existsAssignment( 8 ) );
+
+        Map<unsigned, double> values;
+        double value;
+        solver.extractSolution( values, value );
+        TS_ASSERT_EQUALS( values.size(), 2U );
+        TS_ASSERT( values.exists( 3 ) );
+        TS_ASSERT( values.exists( 7 ) );
+    }
+
+    void test_infeasible()
+    {
+        NativeLPSolver solver;
+        addSmallLP( solver );
+
+        List<ILPSolver::Term> terms;
+        terms.append( ILPSolver::Term( 1, 0 ) );
+        terms.append( ILPSolver::Term( 1, 1 ) );
+        solver.addGeqConstraint( terms, 5 );
+
+        solver.setCost( terms );
+        solver.solve();
+
+        TS_ASSERT( solver.infeasible() );
+        TS_ASSERT( !solver.optimal() );
+        TS_ASSERT( !solver.haveFeasibleSolution() );
+
+        // Crossing bounds are detected without solving
+        NativeLPSolver solver2;
+        solver2.addVariable( 0, 0, 1 );
+        solver2.setLowerBound( 0, 2 );
+        solver2.solve();
+        TS_ASSERT( solver2.infeasible() );
+    }
+
+    void test_bound_changes_and_warm_start()
+    {
+        NativeLPSolver solver;
+        addSmallLP( solver );
+
+        List<ILPSolver::Term> objective;
+        objective.append( ILPSolver::Term( 1, 0 ) );
+        solver.setObjective( objective );
+        solver.solve();
+        TS_ASSERT( solver.optimal() );
+        TS_ASSERT( FloatUtils::areEqual( solver.getOptimalCostOrObjective(), 3 ) );
+
+        // Tighten the bound of x, and re-solve from the current basis
+        solver.setUpperBound( 0, 2 );
+        TS_ASSERT_EQUALS( solver.getUpperBound( 0 ), 2 );
+        solver.solve();
+        TS_ASSERT( solver.optimal() );
+        TS_ASSERT( FloatUtils::areEqual( solver.getOptimalCostOrObjective(), 2 ) );
+        TS_ASSERT_EQUALS( solver.getNumberOfSimplexIterations(), 0U );
+
+        // Rebuild the same model: the previous basis is reused
+        solver.resetModel();
+        addSmallLP( solver );
+        solver.setObjective( objective );
+        solver.solve();
+        TS_ASSERT( solver.optimal() );
+        TS_ASSERT( FloatUtils::areEqual( solver.getOptimalCostOrObjective(), 3 ) );
+
+        // Grow the model after solving: the constraint x <= y is added
+        List<ILPSolver::Term> terms;
+        terms.append( ILPSolver::Term( 1, 0 ) );
+        terms.append( ILPSolver::Term( -1, 1 ) );
+        solver.addLeqConstraint( terms, 0 );
+        solver.solve();
+        TS_ASSERT( solver.optimal() );
+        TS_ASSERT( FloatUtils::areEqual( solver.getOptimalCostOrObjective(), 1.5 ) );
+    }
+
+    void test_cutoff()
+    {
+        NativeLPSolver solver;
+        addSmallLP( solver );
+
+        List<ILPSolver::Term> objective;
+        objective.append( ILPSolver::Term( 1, 1 ) );
+        solver.setObjective( objective );
+
+        solver.setCutoff( 2 );
+        solver.solve();
+        TS_ASSERT( solver.cutoffOccurred() );
+        TS_ASSERT( !solver.optimal() );
+
+        solver.setCutoff( 1 );
+        solver.solve();
+        TS_ASSERT( solver.optimal() );
+    }
+
+    void test_relu_triangle_relaxation()
+    {
+        /*
+          The LP relaxation of y = ReLU( x ), -1 <= x <= 2:
+
+            y >= 0, y >= x, y <= 2/3 ( x + 1 )
+
+          Bounds are tightened the way the LP formulator does it.
+        */
+        NativeLPSolver solver;
+        solver.addVariable( 0, -1, 2 );
+        solver.addVariable( 1, 0, 2 );
+
+        List<ILPSolver::Term> terms;
+        terms.append( ILPSolver::Term( 1, 1 ) );
+        terms.append( ILPSolver::Term( -1, 0 ) );
+        solver.addGeqConstraint( terms, 0 );
+
+        terms.clear();
+        terms.append( ILPSolver::Term( 1, 1 ) );
+        terms.append( ILPSolver::Term( -2.0 / 3, 0 ) );
+        solver.addLeqConstraint( terms, 2.0 / 3 );
+
+        List<ILPSolver::Term> objective;
+        objective.append( ILPSolver::Term( 1, 1 ) );
+
+        solver.setObjective( objective );
+        solver.solve();
+        TS_ASSERT( solver.optimal() );
+        TS_ASSERT( FloatUtils::areEqual( solver.getObjectiveBound(), 2 ) );
+
+        // With x <= 0.5, y <= 1
+        solver.setUpperBound( 0, 0.5 );
+        solver.reset();
+        solver.setObjective( objective );
+        solver.solve();
+        TS_ASSERT( solver.optimal() );
+        TS_ASSERT( FloatUtils::areEqual( solver.getObjectiveBound(), 1 ) );
+
+        solver.setCost( objective );
+        solver.solve();
+        TS_ASSERT( solver.optimal() );
+        TS_ASSERT( FloatUtils::areEqual( solver.getObjectiveBound(), 0 ) );
+
+        // A free variable, defined by an equation
+        solver.addVariable( 2, FloatUtils::negativeInfinity(), FloatUtils::infinity() );
+        terms.clear();
+        terms.append( ILPSolver::Term( 1, 2 ) );
+        terms.append( ILPSolver::Term( -1, 0 ) );
+        terms.append( ILPSolver::Term( 2, 1 ) );
+        solver.addEqConstraint( terms, 1 );
+
+        objective.clear();
+        objective.append( ILPSolver::Term( 1, 2 ) );
+        solver.setCost( objective );
+        solver.solve();
+
+        // min x - 2y + 1: with y <= 2/3 ( x + 1 ), the minimum is at x = 0.5,
+        // y = 1, i.e. -0.5
+        TS_ASSERT( solver.optimal() );
+        TS_ASSERT( FloatUtils::areEqual( solver.getOptimalCostOrObjective(), -0.5 ) );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
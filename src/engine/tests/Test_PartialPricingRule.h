@@ -0,0 +1,98 @@
+/*********************                                                        */
+/*! \file Test_PartialPricingRule.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "GlobalConfiguration.h"
+#include "MockTableau.h"
+#include "PartialPricingRule.h"
+#include "Statistics.h"
+
+class PartialPricingRuleTestSuite : public CxxTest::TestSuite
+{
+public:
+    MockTableau *tableau;
+
+    void setUp()
+    {
+        TS_ASSERT( tableau = new MockTableau );
+    }
+
+    void tearDown()
+    {
+        TS_ASSERT_THROWS_NOTHING( delete tableau );
+    }
+
+    void test_select_rotates_windows()
+    {
+        TS_ASSERT_EQUALS( GlobalConfiguration::PARTIAL_PRICING_WINDOW_SIZE, 250U );
+
+        PartialPricingRule partialPricing;
+        Statistics statistics;
+        partialPricing.setStatistics( &statistics );
+
+        // 1000 non-basic variables, i.e. four windows
+        tableau->setDimensions( 10, 1010 );
+        Bitset excluded( 1000 );
+
+        tableau->mockCandidates = { 5, 100, 300, 900 };
+        tableau->nextCostFunction[5] = -3;
+        tableau->nextCostFunction[100] = 8;
+        tableau->nextCostFunction[300] = -50;
+        tableau->nextCostFunction[900] = 20;
+
+        // Not a candidate, so its coefficient doesn't matter
+        tableau->nextCostFunction[7] = 1000;
+
+        // Only the first window is priced
+        TS_ASSERT( partialPricing.select( *tableau, NULL, 0, excluded ) );
+        TS_ASSERT_EQUALS( tableau->mockEnteringVariable, 100U );
+        TS_ASSERT_EQUALS( statistics.getLongAttribute( Statistics::NUM_PRICING_CANDIDATES_SCANNED ), 250U );
+
+        excluded.set( 100 );
+        TS_ASSERT( partialPricing.select( *tableau, NULL, 0, excluded ) );
+        TS_ASSERT_EQUALS( tableau->mockEnteringVariable, 5U );
+        excluded.clear();
+
+        // After a pivot, pricing moves on to the next window
+        partialPricing.postPivotHook( *tableau, false );
+        TS_ASSERT_EQUALS( partialPricing.getWindowStart(), 250U );
+        TS_ASSERT( partialPricing.select( *tableau, NULL, 0, excluded ) );
+        TS_ASSERT_EQUALS( tableau->mockEnteringVariable, 300U );
+
+        // Windows without candidates are skipped
+        partialPricing.postPivotHook( *tableau, false );
+        TS_ASSERT( partialPricing.select( *tableau, NULL, 0, excluded ) );
+        TS_ASSERT_EQUALS( tableau->mockEnteringVariable, 900U );
+
+        // ... and the search wraps around
+        partialPricing.postPivotHook( *tableau, false );
+        TS_ASSERT_EQUALS( partialPricing.getWindowStart(), 0U );
+        TS_ASSERT( partialPricing.select( *tableau, NULL, 0, excluded ) );
+        TS_ASSERT_EQUALS( tableau->mockEnteringVariable, 100U );
+
+        // No eligible variables: everything is priced, nothing is found
+        statistics.setLongAttribute( Statistics::NUM_PRICING_CANDIDATES_SCANNED, 0 );
+        tableau->mockCandidates.clear();
+        TS_ASSERT( !partialPricing.select( *tableau, NULL, 0, excluded ) );
+        TS_ASSERT_EQUALS( statistics.getLongAttribute( Statistics::NUM_PRICING_CANDIDATES_SCANNED ), 1000U );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
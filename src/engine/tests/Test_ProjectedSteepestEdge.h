@@ -58,14 +58,14 @@ public:
 
         // Next, we're going to ask pse to pick an entering variable.
         // All variables are eligible, none are excluded
-        Set<unsigned> excluded;
+        Bitset excluded( 3 );
 
-        List<unsigned> candidates = { 0, 1, 2 };
+        Vector<unsigned> candidates = { 0, 1, 2 };
         double costFunction[] = { -5.0, -3.0, -7.0 };
 
         memcpy( tableau.nextCostFunction, costFunction, sizeof(costFunction) );
 
-        TS_ASSERT_THROWS_NOTHING( pse.select( tableau, candidates, excluded ) );
+        TS_ASSERT_THROWS_NOTHING( pse.select( tableau, candidates.data(), candidates.size(), excluded ) );
 
         // The largest cost^2/gamma belongs to variable #2, so it should enter
         TS_ASSERT_EQUALS( tableau.mockEnteringVariable, 2U );
@@ -88,7 +88,7 @@ public:
         candidates.append( 0 );
         candidates.append( 1 );
 
-        TS_ASSERT_THROWS_NOTHING( pse.select( tableau, candidates, excluded ) );
+        TS_ASSERT_THROWS_NOTHING( pse.select( tableau, candidates.data(), candidates.size(), excluded ) );
         TS_ASSERT_EQUALS( tableau.mockEnteringVariable, 0U );
 
         tableau.mockLeavingVariable = 2;
@@ -104,7 +104,7 @@ public:
         candidates.clear();
         candidates.append( 1 );
 
-        TS_ASSERT_THROWS_NOTHING( pse.select( tableau, candidates, excluded ) );
+        TS_ASSERT_THROWS_NOTHING( pse.select( tableau, candidates.data(), candidates.size(), excluded ) );
         TS_ASSERT_EQUALS( tableau.mockEnteringVariable, 1U );
 
         // The entering variable is 1 (index 1), leaving variable is 3 (index 0)
@@ -161,7 +161,7 @@ public:
         costFunction[0] = 4.0; costFunction[1] = -2.0; costFunction[2] = -4.0;
         memcpy( tableau.nextCostFunction, costFunction, sizeof(costFunction) );
 
-        TS_ASSERT_THROWS_NOTHING( pse.select( tableau, candidates, excluded ) );
+        TS_ASSERT_THROWS_NOTHING( pse.select( tableau, candidates.data(), candidates.size(), excluded ) );
         TS_ASSERT_EQUALS( tableau.mockEnteringVariable, 1U );
 
         // The entering variable is 3 (index 1), leaving variable is 4 (index 1)
@@ -204,11 +204,6 @@ public:
         TS_ASSERT( FloatUtils::areEqual( pse.getGamma( 1 ), 0.25 ) );
         TS_ASSERT( FloatUtils::areEqual( pse.getGamma( 2 ), 10.0 ) );
     }
-
-    void test_todo()
-    {
-        TS_TRACE( "Move 'excluded' computation out to the Engine instead of repeating it in every invocation of PSE.select()" );
-    }
 };
 
 //
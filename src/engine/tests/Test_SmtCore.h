@@ -368,6 +368,49 @@ public:
         TS_ASSERT( !engine->lastStoredState );
     }
 
+    void test_perform_split_with_context_dependent_search_state()
+    {
+        engine->contextDependentSearchState = true;
+
+        SmtCore smtCore( engine );
+
+        MockConstraint constraint;
+
+        PiecewiseLinearCaseSplit split1;
+        split1.storeBoundTightening( Tightening( 1, 3.0, Tightening::LB ) );
+
+        PiecewiseLinearCaseSplit split2;
+        split2.storeBoundTightening( Tightening( 1, 3.0, Tightening::UB ) );
+
+        constraint.nextSplits.append( split1 );
+        constraint.nextSplits.append( split2 );
+
+        for ( unsigned i = 0; i < ( unsigned ) Options::get()->getInt( Options::CONSTRAINT_VIOLATION_THRESHOLD ); ++i )
+            smtCore.reportViolatedConstraint( &constraint );
+
+        // The split is performed, but no engine state is stored
+        TS_ASSERT_THROWS_NOTHING( smtCore.performSplit() );
+        TS_ASSERT_EQUALS( smtCore.getStackDepth(), 1U );
+        TS_ASSERT_EQUALS( engine->getContext().getLevel(), 1 );
+        TS_ASSERT_EQUALS( engine->lastLowerBounds.size(), 1U );
+        TS_ASSERT( !engine->lastStoredState );
+
+        engine->lastLowerBounds.clear();
+
+        // Popping relies on the context alone
+        TS_ASSERT( smtCore.popSplit() );
+        TS_ASSERT_EQUALS( smtCore.getStackDepth(), 1U );
+        TS_ASSERT_EQUALS( engine->getContext().getLevel(), 1 );
+        TS_ASSERT( !engine->lastRestoredState );
+        TS_ASSERT( engine->lastLowerBounds.empty() );
+        TS_ASSERT_EQUALS( engine->lastUpperBounds.size(), 1U );
+
+        // Resetting backtracks the context to the root
+        TS_ASSERT_THROWS_NOTHING( smtCore.reset() );
+        TS_ASSERT_EQUALS( smtCore.getStackDepth(), 0U );
+        TS_ASSERT_EQUALS( engine->getContext().getLevel(), 0 );
+    }
+
     void test_all_splits_so_far()
     {
         SmtCore smtCore( engine );
@@ -23,6 +23,7 @@
 #include "MockErrno.h"
 #include "MarabouError.h"
 #include "Options.h"
+#include "Statistics.h"
 #include "Tableau.h"
 #include "TableauRow.h"
 #include "TableauState.h"
@@ -70,9 +71,8 @@ public:
 
     bool hasCandidates( const ITableau &tableau ) const
     {
-        List<unsigned> candidates;
-        tableau.getEntryCandidates( candidates );
-        return !candidates.empty();
+        Vector<unsigned> candidates( tableau.getN() - tableau.getM() );
+        return tableau.getEntryCandidates( candidates.data() ) > 0;
     }
 
     void initializeTableauValues( Tableau &tableau )
@@ -397,6 +397,103 @@ public:
         TS_ASSERT_THROWS_NOTHING( delete tableau );
     }
 
+    void test_long_step_ratio_test()
+    {
+        Tableau *tableau = NULL;
+        MockCostFunctionManager costFunctionManager;
+        Context context;
+        BoundManager boundManager( context );
+
+        Options::get()->setBool( Options::LONG_STEP_RATIO_TEST, true );
+
+        TS_ASSERT_THROWS_NOTHING( boundManager.initialize( 7 ) );
+        TS_ASSERT( tableau = new Tableau( boundManager ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setDimensions( 3, 7 ) );
+        tableau->registerCostFunctionManager( &costFunctionManager );
+        initializeTableauValues( *tableau );
+
+        for ( unsigned i = 0; i < 4; ++i )
+        {
+            TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( i, 1 ) );
+            TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( i, 10 ) );
+        }
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 4, 219 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 4, 228 ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 5, 112 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 5, 114 ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 6, 400 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 6, 402 ) );
+
+        List<unsigned> basics = { 4, 5, 6 };
+        TS_ASSERT_THROWS_NOTHING( tableau->initializeTableau( basics ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->computeCostFunction() );
+
+        costFunctionManager.nextCostFunction = new double[4];
+        costFunctionManager.nextCostFunction[0] = -1;
+        costFunctionManager.nextCostFunction[1] = -1;
+        costFunctionManager.nextCostFunction[2] = -1;
+        costFunctionManager.nextCostFunction[3] = -1;
+
+        costFunctionManager.nextBasicCost[0] = -1;
+        costFunctionManager.nextBasicCost[1] =  0;
+        costFunctionManager.nextBasicCost[2] = +1;
+
+        // Entering variable is 2, it needs to increase and can increase by 9
+        tableau->setEnteringVariableIndex( 2u );
+
+        // Current basic values are: 217 (below LB), 113 (between), 406 (above UB)
+        TS_ASSERT_EQUALS( tableau->getValue( 4 ), 217.0 );
+        TS_ASSERT_EQUALS( tableau->getValue( 5 ), 113.0 );
+        TS_ASSERT_EQUALS( tableau->getValue( 6 ), 406.0 );
+
+        double d1[] = { -1, 0, 0.5 };
+        // Var 4 reaches its lower bound at 2, and var 6 its upper bound
+        // at 8. The infeasibility keeps decreasing after 2, so var 4 is
+        // passed and var 6 leaves.
+        TS_ASSERT_THROWS_NOTHING( tableau->pickLeavingVariable( d1 ) );
+        TS_ASSERT_EQUALS( tableau->getLeavingVariable(), 6u );
+        TS_ASSERT_EQUALS( tableau->getChangeRatio(), 8.0 );
+
+        double d2[] = { -1, -0.2, 0.05 };
+        // Var 4 is passed at 2, but var 5 is within bounds and hits its
+        // upper bound at 5, before var 6 reaches its bound at 80.
+        TS_ASSERT_THROWS_NOTHING( tableau->pickLeavingVariable( d2 ) );
+        TS_ASSERT_EQUALS( tableau->getLeavingVariable(), 5u );
+        TS_ASSERT( FloatUtils::areEqual( tableau->getChangeRatio(), 5.0 ) );
+
+        double d3[] = { -1, -1, 0.5 };
+        // Var 5 hits its upper bound at 1, before any breakpoint: the
+        // result is the same as that of the Harris ratio test.
+        TS_ASSERT_THROWS_NOTHING( tableau->pickLeavingVariable( d3 ) );
+        TS_ASSERT_EQUALS( tableau->getLeavingVariable(), 5u );
+        TS_ASSERT_EQUALS( tableau->getChangeRatio(), 1.0 );
+
+        double d4[] = { -1, 0, 2 };
+        // Var 4 reaches its lower bound at 2, and var 6 its upper bound
+        // at 2 as well. No breakpoint is passed, and the Harris ratio test
+        // picks the larger pivot.
+        TS_ASSERT_THROWS_NOTHING( tableau->pickLeavingVariable( d4 ) );
+        TS_ASSERT_EQUALS( tableau->getLeavingVariable(), 6u );
+        TS_ASSERT_EQUALS( tableau->getChangeRatio(), 2.0 );
+
+        double d5[] = { -0.5, 0, 0.1 };
+        // Var 4 reaches its lower bound at 4 and var 6 its upper bound at
+        // 40. Past var 4 the infeasibility still decreases, and the
+        // entering variable moves on until its own bound, at 9.
+        TS_ASSERT_THROWS_NOTHING( tableau->pickLeavingVariable( d5 ) );
+        TS_ASSERT_EQUALS( tableau->getLeavingVariable(), 2u );
+        TS_ASSERT_EQUALS( tableau->getChangeRatio(), 9.0 );
+
+        TS_ASSERT_THROWS_NOTHING( delete tableau );
+
+        Options::get()->setBool( Options::LONG_STEP_RATIO_TEST, false );
+    }
+
     void test_perform_pivot_nonbasic_goes_to_opposite_bound()
     {
         Tableau *tableau = NULL;
@@ -1103,8 +1200,14 @@ public:
         TS_ASSERT_THROWS_NOTHING( boundManager.registerTableau( tableau ) );
         TS_ASSERT_THROWS_NOTHING( tableau->setDimensions( 3, 7 ) );
         tableau->registerCostFunctionManager( &costFunctionManager );
+        Statistics statistics;
+        tableau->setStatistics( &statistics );
         initializeTableauValues( *tableau );
 
+        unsigned long long initialMemory =
+            statistics.getLongAttribute( Statistics::CONSTRAINT_MATRIX_MEMORY_BYTES );
+        TS_ASSERT( initialMemory > 0 );
+
         for ( unsigned i = 0; i < 4; ++i )
         {
             TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( i, 1 ) );
@@ -1249,6 +1352,22 @@ public:
         TS_ASSERT_EQUALS( tableau->getValue( 6 ), 403.0 );
         TS_ASSERT_EQUALS( tableau->getValue( 7 ), 11.0 ); // 473 - 4 - 6 - 4 - 4*112
 
+        // Dense columns of A are served from the sparse columns
+        const double *column = tableau->getAColumn( 2 );
+        TS_ASSERT_EQUALS( column[0], 1.0 );
+        TS_ASSERT_EQUALS( column[1], 1.0 );
+        TS_ASSERT_EQUALS( column[2], 3.0 );
+        TS_ASSERT_EQUALS( column[3], -4.0 );
+
+        column = tableau->getAColumn( 7 );
+        TS_ASSERT_EQUALS( column[0], 0.0 );
+        TS_ASSERT_EQUALS( column[1], 0.0 );
+        TS_ASSERT_EQUALS( column[2], 0.0 );
+        TS_ASSERT_EQUALS( column[3], 1.0 );
+
+        TS_ASSERT( statistics.getLongAttribute( Statistics::CONSTRAINT_MATRIX_MEMORY_BYTES ) >
+                   initialMemory );
+
         TS_ASSERT_THROWS_NOTHING( delete tableau );
     }
 
@@ -1629,6 +1748,72 @@ public:
         TS_ASSERT_THROWS_NOTHING( delete tableau );
     }
 
+    void test_dual_simplex_step()
+    {
+        Tableau *tableau = NULL;
+        MockCostFunctionManager costFunctionManager;
+        Context context;
+        BoundManager boundManager( context );
+
+        TS_ASSERT_THROWS_NOTHING( boundManager.initialize( 7 ) );
+        TS_ASSERT( tableau = new Tableau( boundManager ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setDimensions( 3, 7 ) );
+        tableau->registerCostFunctionManager( &costFunctionManager );
+        initializeTableauValues( *tableau );
+
+        for ( unsigned i = 0; i < 4; ++i )
+        {
+            TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( i, 1 ) );
+            TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( i, 10 ) );
+        }
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 4, 219 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 4, 228 ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 5, 112 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 5, 114 ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 6, 400 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 6, 402 ) );
+
+        List<unsigned> basics = { 4, 5, 6 };
+        TS_ASSERT_THROWS_NOTHING( tableau->initializeTableau( basics ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->resetDualPricingWeights() );
+
+        // Current basic values are: 217 (2 below its lower bound), 113
+        // and 406 (4 above its upper bound). With unit weights, the
+        // larger infeasibility is picked.
+        TS_ASSERT( tableau->pickDualLeavingVariable() );
+        TS_ASSERT_EQUALS( tableau->getLeavingVariableIndex(), 2u );
+
+        // The pivot row is x7 = 420 - 4x1 - 3x2 - 3x3 - 4x4, and x7 needs
+        // to decrease by 4. Every non-basic can increase and stays within
+        // its bounds, so the largest pivot element wins (x1 before x4).
+        TS_ASSERT_THROWS_NOTHING( tableau->computePivotRow() );
+        TS_ASSERT( tableau->pickDualEnteringVariable() );
+        TS_ASSERT_EQUALS( tableau->getEnteringVariable(), 0u );
+        TS_ASSERT_EQUALS( tableau->getChangeRatio(), 1.0 );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->computeChangeColumn() );
+        TS_ASSERT_THROWS_NOTHING( tableau->updateDualPricingWeights() );
+        TS_ASSERT_THROWS_NOTHING( tableau->performPivot() );
+
+        // x7 leaves at its upper bound, x1 enters with value 2
+        TS_ASSERT( tableau->isBasic( 0 ) );
+        TS_ASSERT( !tableau->isBasic( 6 ) );
+        TS_ASSERT_EQUALS( tableau->getValue( 6 ), 402.0 );
+        TS_ASSERT_EQUALS( tableau->getValue( 0 ), 2.0 );
+        TS_ASSERT_EQUALS( tableau->getValue( 4 ), 214.0 );
+        TS_ASSERT_EQUALS( tableau->getValue( 5 ), 112.0 );
+
+        // Only x5 is still out of bounds
+        TS_ASSERT( tableau->pickDualLeavingVariable() );
+        TS_ASSERT_EQUALS( tableau->getLeavingVariableIndex(), 0u );
+
+        TS_ASSERT_THROWS_NOTHING( delete tableau );
+    }
+
     void test_todo()
     {
         TS_TRACE( "When resizing the talbeau, allocate a larger size and only use part of it, "
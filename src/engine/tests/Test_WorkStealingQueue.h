@@ -0,0 +1,224 @@
+/*********************                                                        */
+/*! \file Test_WorkStealingQueue.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "MStringf.h"
+#include "WorkStealingQueue.h"
+
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <thread>
+
+class WorkStealingQueueTestSuite : public CxxTest::TestSuite
+{
+public:
+    SubQuery *createSubQuery( unsigned depth )
+    {
+        SubQuery *subQuery = new SubQuery;
+        subQuery->_queryId = Stringf( "%u", depth );
+        subQuery->_split = std::unique_ptr<PiecewiseLinearCaseSplit>
+            ( new PiecewiseLinearCaseSplit );
+        subQuery->_timeoutInSeconds = 0;
+        subQuery->_depth = depth;
+        return subQuery;
+    }
+
+    void test_local_pop_is_lifo()
+    {
+        WorkStealingQueue queue( 2 );
+
+        TS_ASSERT( queue.empty() );
+
+        queue.push( 0, createSubQuery( 1 ) );
+        queue.push( 0, createSubQuery( 2 ) );
+        queue.push( 0, createSubQuery( 3 ) );
+        TS_ASSERT_EQUALS( queue.size(), 3U );
+
+        SubQuery *subQuery = NULL;
+        for ( unsigned depth = 3; depth >= 1; --depth )
+        {
+            TS_ASSERT( queue.pop( 0, subQuery ) );
+            TS_ASSERT_EQUALS( subQuery->_depth, depth );
+            delete subQuery;
+        }
+
+        TS_ASSERT( !queue.pop( 0, subQuery ) );
+        TS_ASSERT( queue.empty() );
+        TS_ASSERT_EQUALS( queue.getNumSteals(), 0U );
+    }
+
+    void test_steal_is_fifo()
+    {
+        WorkStealingQueue queue( 3 );
+
+        queue.push( 1, createSubQuery( 1 ) );
+        queue.push( 1, createSubQuery( 2 ) );
+        queue.push( 1, createSubQuery( 3 ) );
+
+        // Worker 0 has nothing, so it takes the shallowest query of worker 1
+        SubQuery *subQuery = NULL;
+        TS_ASSERT( queue.pop( 0, subQuery ) );
+        TS_ASSERT_EQUALS( subQuery->_depth, 1U );
+        delete subQuery;
+
+        TS_ASSERT( queue.pop( 2, subQuery ) );
+        TS_ASSERT_EQUALS( subQuery->_depth, 2U );
+        delete subQuery;
+
+        TS_ASSERT( queue.pop( 1, subQuery ) );
+        TS_ASSERT_EQUALS( subQuery->_depth, 3U );
+        delete subQuery;
+
+        TS_ASSERT_EQUALS( queue.getNumSteals(), 2U );
+        TS_ASSERT( queue.empty() );
+    }
+
+    void test_distribute()
+    {
+        WorkStealingQueue queue( 2 );
+
+        SubQueries subQueries;
+        for ( unsigned i = 0; i < 5; ++i )
+            subQueries.append( createSubQuery( i ) );
+        queue.distribute( subQueries );
+        TS_ASSERT_EQUALS( queue.size(), 5U );
+
+        // Round-robin: worker 1 owns queries 1 and 3
+        SubQuery *subQuery = NULL;
+        TS_ASSERT( queue.pop( 1, subQuery ) );
+        TS_ASSERT_EQUALS( subQuery->_depth, 3U );
+        delete subQuery;
+        TS_ASSERT( queue.pop( 1, subQuery ) );
+        TS_ASSERT_EQUALS( subQuery->_depth, 1U );
+        delete subQuery;
+        TS_ASSERT_EQUALS( queue.getNumSteals(), 0U );
+
+        // The remaining queries are released by the destructor
+    }
+
+    void test_concurrent_workers()
+    {
+        enum {
+            NUM_WORKERS = 4,
+            NUM_SUB_QUERIES = 1000,
+        };
+
+        WorkStealingQueue queue( NUM_WORKERS );
+        for ( unsigned i = 0; i < NUM_SUB_QUERIES; ++i )
+            queue.push( 0, createSubQuery( i ) );
+
+        std::atomic_uint numPopped( 0 );
+        std::list<std::thread> threads;
+        for ( unsigned i = 0; i < NUM_WORKERS; ++i )
+        {
+            threads.push_back( std::thread( [&queue, &numPopped, i]() {
+                SubQuery *subQuery = NULL;
+                while ( numPopped.load() < NUM_SUB_QUERIES )
+                {
+                    if ( queue.pop( i, subQuery ) )
+                    {
+                        delete subQuery;
+                        ++numPopped;
+                    }
+                }
+            } ) );
+        }
+
+        for ( auto &thread : threads )
+            thread.join();
+
+        TS_ASSERT_EQUALS( numPopped.load(), (unsigned)NUM_SUB_QUERIES );
+        TS_ASSERT( queue.empty() );
+    }
+
+    void test_parked_workers_terminate_when_no_work_is_left()
+    {
+        enum {
+            NUM_WORKERS = 4,
+            MAX_DEPTH = 10,
+        };
+
+        // Each popped query at depth < MAX_DEPTH produces two children, so
+        // workers are repeatedly parked and woken up until the binary tree
+        // is exhausted
+        WorkStealingQueue queue( NUM_WORKERS );
+        queue.push( 0, createSubQuery( 0 ) );
+
+        std::atomic_uint numSolved( 0 );
+        std::list<std::thread> threads;
+        for ( unsigned i = 0; i < NUM_WORKERS; ++i )
+        {
+            threads.push_back( std::thread( [&queue, &numSolved, i, this]() {
+                SubQuery *subQuery = NULL;
+                while ( queue.waitAndPop( i, subQuery ) )
+                {
+                    if ( subQuery->_depth < MAX_DEPTH )
+                    {
+                        queue.push( i, createSubQuery( subQuery->_depth + 1 ) );
+                        queue.push( i, createSubQuery( subQuery->_depth + 1 ) );
+                    }
+                    delete subQuery;
+                    ++numSolved;
+                }
+            } ) );
+        }
+
+        for ( auto &thread : threads )
+            thread.join();
+
+        TS_ASSERT_EQUALS( numSolved.load(), ( 2U << MAX_DEPTH ) - 1 );
+        TS_ASSERT( queue.empty() );
+        TS_ASSERT( queue.closed() );
+    }
+
+    void test_close_releases_parked_workers()
+    {
+        WorkStealingQueue queue( 3 );
+
+        std::atomic_uint numReleased( 0 );
+        std::list<std::thread> threads;
+        for ( unsigned i = 0; i < 2; ++i )
+        {
+            threads.push_back( std::thread( [&queue, &numReleased, i]() {
+                SubQuery *subQuery = NULL;
+                TS_ASSERT( !queue.waitAndPop( i, subQuery ) );
+                ++numReleased;
+            } ) );
+        }
+
+        // The third worker never waits, so the other two stay parked until
+        // the queue is closed
+        std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+        TS_ASSERT_EQUALS( numReleased.load(), 0U );
+        TS_ASSERT( !queue.closed() );
+
+        queue.close();
+        for ( auto &thread : threads )
+            thread.join();
+
+        TS_ASSERT_EQUALS( numReleased.load(), 2U );
+
+        SubQuery *subQuery = NULL;
+        TS_ASSERT( !queue.waitAndPop( 2, subQuery ) );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -28,20 +28,19 @@
 #include "MatrixMultiplication.h"
 #include "MStringf.h"
 #include "NLRError.h"
+#include "Options.h"
 #include "TimeUtils.h"
 
 #include <boost/thread.hpp>
 
 namespace NLR {
 
-DeepPolyAnalysis::DeepPolyAnalysis( LayerOwner *layerOwner )
+DeepPolyAnalysis::DeepPolyAnalysis( LayerOwner *layerOwner, unsigned blockSize,
+                                    unsigned numberOfThreads )
     : _layerOwner( layerOwner )
-    , _work1SymbolicLb( NULL )
-    , _work1SymbolicUb( NULL )
-    , _work2SymbolicLb( NULL )
-    , _work2SymbolicUb( NULL )
-    , _workSymbolicLowerBias( NULL )
-    , _workSymbolicUpperBias( NULL )
+    , _workerPool( NULL )
+    , _blockSize( blockSize )
+    , _numberOfThreads( numberOfThreads )
 {
     const Map<unsigned, Layer *> &layers = _layerOwner->getLayerIndexToLayer();
     allocateMemory( layers );
@@ -72,39 +71,20 @@ void DeepPolyAnalysis::freeMemoryIfNeeded()
         if ( pair.second )
             delete pair.second;
     }
-    if ( _work1SymbolicLb )
-    {
-        delete[] _work1SymbolicLb;
-        _work1SymbolicLb = NULL;
-    }
-    if ( _work2SymbolicLb )
-    {
-        delete[] _work2SymbolicLb;
-        _work2SymbolicLb = NULL;
-    }
-    if ( _work1SymbolicUb )
-    {
-        delete[] _work1SymbolicUb;
-        _work1SymbolicUb = NULL;
-    }
-    if ( _work2SymbolicUb )
-    {
-        delete[] _work2SymbolicUb;
-        _work2SymbolicUb = NULL;
-    }
-    if ( _workSymbolicLowerBias )
-    {
-        delete[] _workSymbolicLowerBias;
-        _workSymbolicLowerBias = NULL;
-    }
-    if ( _workSymbolicUpperBias )
+    _deepPolyElements.clear();
+
+    if ( _workerPool )
     {
-        delete[] _workSymbolicUpperBias;
-        _workSymbolicUpperBias = NULL;
+        delete _workerPool;
+        _workerPool = NULL;
     }
+
+    for ( const auto &workspace : _workspaces )
+        delete workspace;
+    _workspaces.clear();
 }
 
-void DeepPolyAnalysis::run()
+void DeepPolyAnalysis::run( unsigned firstLayer )
 {
     struct timespec deepPolyStart;
     (void) deepPolyStart;
@@ -122,6 +102,8 @@ void DeepPolyAnalysis::run()
         */
         unsigned index = pair.first;
         Layer *layer = pair.second;
+        if ( index < firstLayer )
+            continue;
 
         ASSERT( _deepPolyElements.exists( index ) );
         log( Stringf( "Running deeppoly analysis for layer %u...", index ) );
@@ -171,21 +153,43 @@ void DeepPolyAnalysis::allocateMemory( const Map<unsigned, Layer *> &layers )
             maxLayerSize = thisLayerSize;
     }
 
-   _work1SymbolicLb= new double[maxLayerSize * maxLayerSize];
-   _work1SymbolicUb= new double[maxLayerSize * maxLayerSize];
-   _work2SymbolicLb= new double[maxLayerSize * maxLayerSize];
-   _work2SymbolicUb= new double[maxLayerSize * maxLayerSize];
+    if ( _numberOfThreads == 0 )
+        _numberOfThreads = std::max( 1, Options::get()->getInt( Options::NUM_WORKERS ) );
+
+    // Back-substitution goes over the neurons of a layer in blocks, and
+    // the four symbolic work buffers of a workspace hold blockSize x
+    // maxLayerSize entries each. BLAS rounds products of different
+    // widths differently, so blocks narrower than a layer can change its
+    // bounds in the last bits. The block size must therefore not depend
+    // on the number of threads, or neither would the bounds. The memory
+    // budget limits the number of threads instead.
+    unsigned long long budget =
+        (unsigned long long)Options::get()->getInt( Options::DEEP_POLY_MEMORY_BUDGET_IN_MB )
+        * 1024 * 1024;
+    unsigned long long bytesPerNeuron = 4ULL * maxLayerSize * sizeof(double);
+
+    if ( _blockSize == 0 )
+    {
+        _blockSize = std::min( maxLayerSize, GlobalConfiguration::DEEP_POLY_BLOCK_SIZE );
+        if ( budget > 0 && bytesPerNeuron > 0 )
+            _blockSize = (unsigned)std::max<unsigned long long>
+                ( 1, std::min<unsigned long long>( budget / bytesPerNeuron, _blockSize ) );
+    }
+    else if ( _blockSize > maxLayerSize )
+        _blockSize = maxLayerSize;
 
-   _workSymbolicLowerBias = new double[maxLayerSize];
-   _workSymbolicUpperBias = new double[maxLayerSize];
+    unsigned numberOfWorkers = _numberOfThreads;
+    if ( budget > 0 && bytesPerNeuron > 0 && _blockSize > 0 )
+        numberOfWorkers = (unsigned)std::max<unsigned long long>
+            ( 1, std::min<unsigned long long>( budget / ( bytesPerNeuron * _blockSize ),
+                                               numberOfWorkers ) );
 
-   std::fill_n( _work1SymbolicLb, maxLayerSize * maxLayerSize, 0 );
-   std::fill_n( _work1SymbolicUb, maxLayerSize * maxLayerSize, 0 );
-   std::fill_n( _work2SymbolicLb, maxLayerSize * maxLayerSize, 0 );
-   std::fill_n( _work2SymbolicUb, maxLayerSize * maxLayerSize, 0 );
+    log( Stringf( "Back-substituting blocks of %u neurons with %u threads",
+                  _blockSize, numberOfWorkers ) );
 
-   std::fill_n( _workSymbolicLowerBias, maxLayerSize, 0 );
-   std::fill_n( _workSymbolicUpperBias, maxLayerSize, 0 );
+    for ( unsigned i = 0; i < numberOfWorkers; ++i )
+        _workspaces.append( new DeepPolyWorkspace( maxLayerSize, _blockSize ) );
+    _workerPool = new DeepPolyWorkerPool( numberOfWorkers );
 }
 
 DeepPolyElement *DeepPolyAnalysis::createDeepPolyElement( Layer *layer )
@@ -198,10 +202,7 @@ DeepPolyElement *DeepPolyAnalysis::createDeepPolyElement( Layer *layer )
     {
         deepPolyElement = new DeepPolyWeightedSumElement( layer );
         // Weighted sum layers need working memory for back substitution
-        deepPolyElement->setWorkingMemory( _work1SymbolicLb, _work1SymbolicUb,
-                                           _work2SymbolicLb, _work2SymbolicUb,
-                                           _workSymbolicLowerBias,
-                                           _workSymbolicUpperBias );
+        deepPolyElement->setWorkingMemory( _workspaces, _workerPool );
     }
     else if ( type ==  Layer::RELU )
         deepPolyElement = new DeepPolyReLUElement( layer );
@@ -17,9 +17,12 @@
 #define __DeepPolyAnalysis_h__
 
 #include "DeepPolyElement.h"
+#include "DeepPolyWorkerPool.h"
+#include "DeepPolyWorkspace.h"
 #include "Layer.h"
 #include "LayerOwner.h"
 #include "Map.h"
+#include "Vector.h"
 #include <climits>
 
 namespace NLR {
@@ -28,10 +31,27 @@ class DeepPolyAnalysis
 {
 public:
 
-    DeepPolyAnalysis( LayerOwner *layerOwner );
+    /*
+      The neurons of a layer are back-substituted blockSize at a time.
+      If blockSize is 0, it is DEEP_POLY_BLOCK_SIZE, or less if a single
+      block would not fit in the DEEP_POLY_MEMORY_BUDGET_IN_MB option.
+      The blocks are shared out between numberOfThreads threads, or
+      NUM_WORKERS threads if numberOfThreads is 0, but no more threads
+      than the memory budget holds workspaces for. The bounds do not depend
+      on the number of threads, but layers wider than a block may get
+      bounds that differ in the last bits from a whole-layer
+      back-substitution.
+    */
+    DeepPolyAnalysis( LayerOwner *layerOwner, unsigned blockSize = 0,
+                      unsigned numberOfThreads = 0 );
     ~DeepPolyAnalysis();
 
-    void run();
+    /*
+      Execute the abstract elements in topological order. Elements of
+      layers before firstLayer keep the symbolic bounds computed in a
+      previous run.
+    */
+    void run( unsigned firstLayer = 0 );
 
 private:
     LayerOwner *_layerOwner;
@@ -42,14 +62,18 @@ private:
     Map<unsigned, DeepPolyElement *> _deepPolyElements;
 
     /*
-      Working memory for the abstract elements to execute
+      Working memory for the abstract elements to execute, one workspace
+      per worker of the pool
+    */
+    Vector<DeepPolyWorkspace *> _workspaces;
+    DeepPolyWorkerPool *_workerPool;
+
+    /*
+      The number of neurons of a layer whose symbolic bounds are
+      back-substituted together
     */
-    double * _work1SymbolicLb;
-    double * _work1SymbolicUb;
-    double * _work2SymbolicLb;
-    double * _work2SymbolicUb;
-    double * _workSymbolicLowerBias;
-    double * _workSymbolicUpperBias;
+    unsigned _blockSize;
+    unsigned _numberOfThreads;
 
     void allocateMemory( const Map<unsigned, Layer *> &layers );
     void freeMemoryIfNeeded();
@@ -16,13 +16,12 @@
 #include "DeepPolyWeightedSumElement.h"
 #include "FloatUtils.h"
 
+#include <atomic>
 #include <string.h>
 
 namespace NLR {
 
 DeepPolyWeightedSumElement::DeepPolyWeightedSumElement( Layer *layer )
-    : _workLb( NULL )
-    , _workUb( NULL )
 {
     _layer = layer;
     _size = layer->getSize();
@@ -51,6 +50,94 @@ void DeepPolyWeightedSumElement::computeBoundWithBackSubstitution
 {
     log( "Computing bounds with back substitution..." );
 
+    // The bounds of different neurons are independent of each other, so
+    // the neurons of this layer are back-substituted in blocks that fit
+    // the working memory, and the blocks are shared out between the
+    // workers of the pool, each using a workspace of its own. The blocks
+    // only depend on the block size, and the arithmetic of a block does
+    // not depend on the worker that picks it up, so the bounds are the
+    // same whatever the number of workers.
+    ASSERT( !_workspaces.empty() );
+    unsigned blockSize = _workspaces[0]->getMaxBlockSize();
+    ASSERT( blockSize > 0 );
+    unsigned numberOfBlocks = ( _size + blockSize - 1 ) / blockSize;
+
+    if ( _workerPool->getNumberOfWorkers() == 1 || numberOfBlocks == 1 )
+    {
+        for ( unsigned block = 0; block < numberOfBlocks; ++block )
+            computeBlockBoundWithBackSubstitution( block * blockSize, blockSize,
+                                                   *_workspaces[0],
+                                                   deepPolyElementsBefore );
+    }
+    else
+    {
+        std::atomic_uint nextBlock( 0 );
+        _workerPool->run( [&]( unsigned worker )
+        {
+            unsigned block;
+            while ( ( block = nextBlock++ ) < numberOfBlocks )
+                computeBlockBoundWithBackSubstitution( block * blockSize, blockSize,
+                                                       *_workspaces[worker],
+                                                       deepPolyElementsBefore );
+        } );
+    }
+
+    log( "Computing bounds with back substitution - done" );
+}
+
+void DeepPolyWeightedSumElement::copyWeightsOfBlock( unsigned sourceLayerIndex,
+                                                     unsigned sourceLayerSize,
+                                                     const DeepPolyWorkspace &workspace,
+                                                     double *symbolicLb,
+                                                     double *symbolicUb ) const
+{
+    // The weights are stored source neuron by source neuron, and the
+    // block is a contiguous range of target neurons in each of them
+    unsigned blockSize = workspace._blockSize;
+    if ( _layer->hasSparseWeights( sourceLayerIndex ) )
+    {
+        const SparseWeightMatrix *weights = _layer->getSparseWeights( sourceLayerIndex );
+        const unsigned *rowStart = weights->getRowStart();
+        const unsigned *columns = weights->getColumnIndices();
+        const double *values = weights->getValues();
+
+        std::fill_n( symbolicLb, sourceLayerSize * blockSize, 0 );
+        std::fill_n( symbolicUb, sourceLayerSize * blockSize, 0 );
+        for ( unsigned i = 0; i < sourceLayerSize; ++i )
+        {
+            const unsigned *first = std::lower_bound( columns + rowStart[i],
+                                                      columns + rowStart[i + 1],
+                                                      workspace._blockStart );
+            for ( unsigned k = first - columns; k < rowStart[i + 1]; ++k )
+            {
+                if ( columns[k] >= workspace._blockStart + blockSize )
+                    break;
+                unsigned index = i * blockSize + columns[k] - workspace._blockStart;
+                symbolicLb[index] = values[k];
+                symbolicUb[index] = values[k];
+            }
+        }
+        return;
+    }
+
+    const double *weights = _layer->getWeights( sourceLayerIndex );
+    for ( unsigned i = 0; i < sourceLayerSize; ++i )
+    {
+        const double *row = weights + i * _size + workspace._blockStart;
+        memcpy( symbolicLb + i * blockSize, row, blockSize * sizeof(double) );
+        memcpy( symbolicUb + i * blockSize, row, blockSize * sizeof(double) );
+    }
+}
+
+void DeepPolyWeightedSumElement::computeBlockBoundWithBackSubstitution
+( unsigned blockStart, unsigned blockSize, DeepPolyWorkspace &workspace,
+  const Map<unsigned, DeepPolyElement *> &deepPolyElementsBefore )
+{
+    workspace._blockStart = blockStart;
+    workspace._blockSize = std::min( blockSize, _size - blockStart );
+    log( Stringf( "Back-substituting neurons %u to %u...", blockStart,
+                  blockStart + workspace._blockSize - 1 ) );
+
     // Start with the symbolic upper-/lower- bounds of this layer with
     // respect to its immediate predecessor.
     Map<unsigned, unsigned> predecessorIndices = getPredecessorIndices();
@@ -58,7 +145,7 @@ void DeepPolyWeightedSumElement::computeBoundWithBackSubstitution
     unsigned counter = 0;
     unsigned numPredecessors = predecessorIndices.size();
     ASSERT( numPredecessors > 0 );
-    // # The invariant we are maintaining:
+    // # The invariant we are maintaining, for the neurons in the block:
     // thisLayer <= ( residualUb * residualLayer for each residualLayer ) +
     //                _work1SymbolicUb * currentElement + _workSymbolicUpperBias;
     // thisLayer >= ( residualLb * residualLayer for each residualLayer ) +
@@ -72,12 +159,10 @@ void DeepPolyWeightedSumElement::computeBoundWithBackSubstitution
         {
             log( Stringf( "Adding residual from layer %u...",
                           predecessorIndex ) );
-            allocateMemoryForResidualsIfNeeded( predecessorIndex, pair.second );
-            const double *weights = _layer->getWeights( predecessorIndex );
-            memcpy( _residualLb[predecessorIndex], weights,
-                    _size * pair.second * sizeof(double) );
-            memcpy( _residualUb[predecessorIndex], weights,
-                    _size * pair.second * sizeof(double) );
+            workspace.addResidualLayer( predecessorIndex, pair.second );
+            copyWeightsOfBlock( predecessorIndex, pair.second, workspace,
+                                workspace._residualLb[predecessorIndex],
+                                workspace._residualUb[predecessorIndex] );
             ++counter;
             log( Stringf( "Adding residual from layer %u - done", pair.first ) );
         }
@@ -89,21 +174,20 @@ void DeepPolyWeightedSumElement::computeBoundWithBackSubstitution
         deepPolyElementsBefore[predecessorIndex];
     unsigned sourceLayerSize = precedingElement->getSize();
 
-    const double *weights = _layer->getWeights( predecessorIndex );
-    memcpy( _work1SymbolicLb,
-            weights, _size * sourceLayerSize * sizeof(double) );
-    memcpy( _work1SymbolicUb,
-            weights, _size * sourceLayerSize * sizeof(double) );
+    copyWeightsOfBlock( predecessorIndex, sourceLayerSize, workspace,
+                        workspace._work1SymbolicLb, workspace._work1SymbolicUb );
 
-    double *bias = _layer->getBiases();
-    memcpy( _workSymbolicLowerBias, bias, _size * sizeof(double) );
-    memcpy( _workSymbolicUpperBias, bias, _size * sizeof(double) );
+    const double *bias = _layer->getBiases() + blockStart;
+    memcpy( workspace._workSymbolicLowerBias, bias,
+            workspace._blockSize * sizeof(double) );
+    memcpy( workspace._workSymbolicUpperBias, bias,
+            workspace._blockSize * sizeof(double) );
 
     DeepPolyElement *currentElement = precedingElement;
-    concretizeSymbolicBound( _work1SymbolicLb, _work1SymbolicUb,
-                             _workSymbolicLowerBias,
-                             _workSymbolicUpperBias,
-                             currentElement, deepPolyElementsBefore );
+    concretizeSymbolicBound( workspace._work1SymbolicLb, workspace._work1SymbolicUb,
+                             workspace._workSymbolicLowerBias,
+                             workspace._workSymbolicUpperBias,
+                             currentElement, workspace, deepPolyElementsBefore );
     log( Stringf( "Computing symbolic bounds with respect to layer %u - done",
                   predecessorIndex ) );
 
@@ -128,107 +212,112 @@ void DeepPolyWeightedSumElement::computeBoundWithBackSubstitution
                 unsigned predecessorIndex = pair.first;
                 log( Stringf( "Adding residual from layer %u...",
                               predecessorIndex ) );
-                allocateMemoryForResidualsIfNeeded( predecessorIndex,
-                                                    pair.second );
+                workspace.addResidualLayer( predecessorIndex, pair.second );
                 // Do we need to add bias here?
                 currentElement->symbolicBoundInTermsOfPredecessor
-                    ( _work1SymbolicLb, _work1SymbolicUb, NULL, NULL,
-                      _residualLb[predecessorIndex],
-                      _residualUb[predecessorIndex],
-                      _size, precedingElement );
+                    ( workspace._work1SymbolicLb, workspace._work1SymbolicUb,
+                      NULL, NULL,
+                      workspace._residualLb[predecessorIndex],
+                      workspace._residualUb[predecessorIndex],
+                      workspace._blockSize, precedingElement );
                 ++counter;
                 log( Stringf( "Adding residual from layer %u - done", pair.first ) );
             }
         }
 
-        std::fill_n( _work2SymbolicLb, _size * precedingElement->getSize(), 0 );
-        std::fill_n( _work2SymbolicUb, _size * precedingElement->getSize(), 0 );
+        unsigned symbolicSize = workspace._blockSize * precedingElement->getSize();
+        std::fill_n( workspace._work2SymbolicLb, symbolicSize, 0 );
+        std::fill_n( workspace._work2SymbolicUb, symbolicSize, 0 );
         currentElement->symbolicBoundInTermsOfPredecessor
-            ( _work1SymbolicLb, _work1SymbolicUb, _workSymbolicLowerBias,
-              _workSymbolicUpperBias, _work2SymbolicLb, _work2SymbolicUb,
-              _size, precedingElement );
+            ( workspace._work1SymbolicLb, workspace._work1SymbolicUb,
+              workspace._workSymbolicLowerBias, workspace._workSymbolicUpperBias,
+              workspace._work2SymbolicLb, workspace._work2SymbolicUb,
+              workspace._blockSize, precedingElement );
 
         // The symbolic lower-bound is
         // _work2SymbolicLb * precedingElement + residualLb1 * residualElement1 +
         // residualLb2 * residualElement2 + ...
         // If the precedingElement is a residual source layer, we can merge
         // in the residualWeights, and remove it from the residual source layers.
-        if ( _residualLayerIndices.exists( predecessorIndex ) )
+        if ( workspace._residualLayerIndices.exists( predecessorIndex ) )
         {
             log( Stringf( "merge residual from layer %u...", predecessorIndex ) );
             // Add weights of this residual layer
-            for ( unsigned i = 0; i < _size * precedingElement->getSize(); ++i )
+            double *residualLb = workspace._residualLb[predecessorIndex];
+            double *residualUb = workspace._residualUb[predecessorIndex];
+            for ( unsigned i = 0; i < symbolicSize; ++i )
             {
-                _work2SymbolicLb[i] += _residualLb[predecessorIndex][i];
-                _work2SymbolicUb[i] += _residualUb[predecessorIndex][i];
+                workspace._work2SymbolicLb[i] += residualLb[i];
+                workspace._work2SymbolicUb[i] += residualUb[i];
             }
-            _residualLayerIndices.erase( predecessorIndex );
-            std::fill_n( _residualLb[predecessorIndex],
-                         _size * precedingElement->getSize(), 0 );
-            std::fill_n( _residualUb[predecessorIndex],
-                         _size * precedingElement->getSize(), 0 );
+            workspace._residualLayerIndices.erase( predecessorIndex );
+            std::fill_n( residualLb, symbolicSize, 0 );
+            std::fill_n( residualUb, symbolicSize, 0 );
             log( Stringf( "merge residual from layer %u - done", predecessorIndex ) );
         }
 
         DEBUG({
                 // Residual layers topologically after precedingElement should
                 // have been merged already.
-                for ( const auto &residualLayerIndex : _residualLayerIndices )
+                for ( const auto &residualLayerIndex : workspace._residualLayerIndices )
                 {
                     ASSERT( residualLayerIndex < predecessorIndex );
                 }
             });
 
-        double *temp = _work1SymbolicLb;
-        _work1SymbolicLb = _work2SymbolicLb;
-        _work2SymbolicLb = temp;
-
-        temp = _work1SymbolicUb;
-        _work1SymbolicUb = _work2SymbolicUb;
-        _work2SymbolicUb = temp;
+        workspace.swapWorkBuffers();
 
         currentElement = precedingElement;
-        concretizeSymbolicBound( _work1SymbolicLb, _work1SymbolicUb,
-                                 _workSymbolicLowerBias, _workSymbolicUpperBias,
-                                 currentElement, deepPolyElementsBefore );
+        concretizeSymbolicBound( workspace._work1SymbolicLb,
+                                 workspace._work1SymbolicUb,
+                                 workspace._workSymbolicLowerBias,
+                                 workspace._workSymbolicUpperBias,
+                                 currentElement, workspace,
+                                 deepPolyElementsBefore );
     }
-    ASSERT( _residualLayerIndices.empty() );
-    log( "Computing bounds with back substitution - done" );
+    ASSERT( workspace._residualLayerIndices.empty() );
 }
 
 void DeepPolyWeightedSumElement::concretizeSymbolicBound
 ( const double *symbolicLb, const double*symbolicUb, double const
   *symbolicLowerBias, const double *symbolicUpperBias, DeepPolyElement
-  *sourceElement, const Map<unsigned, DeepPolyElement *>
-  &deepPolyElementsBefore )
+  *sourceElement, DeepPolyWorkspace &workspace,
+  const Map<unsigned, DeepPolyElement *> &deepPolyElementsBefore )
 {
     log( "Concretizing bound..." );
-    std::fill_n( _workLb, _size, 0 );
-    std::fill_n( _workUb, _size, 0 );
+    double *workLb = workspace._workLb;
+    double *workUb = workspace._workUb;
+    std::fill_n( workLb, workspace._blockSize, 0 );
+    std::fill_n( workUb, workspace._blockSize, 0 );
 
     concretizeSymbolicBoundForSourceLayer( symbolicLb, symbolicUb,
                                            symbolicLowerBias, symbolicUpperBias,
-                                           sourceElement );
+                                           sourceElement, workspace );
 
-    for ( const auto &residualLayerIndex : _residualLayerIndices )
+    for ( const auto &residualLayerIndex : workspace._residualLayerIndices )
     {
         ASSERT( residualLayerIndex < sourceElement->getLayerIndex() );
         DeepPolyElement *residualElement =
             deepPolyElementsBefore[residualLayerIndex];
-        concretizeSymbolicBoundForSourceLayer( _residualLb[residualLayerIndex],
-                                               _residualUb[residualLayerIndex],
+        concretizeSymbolicBoundForSourceLayer( workspace._residualLb[residualLayerIndex],
+                                               workspace._residualUb[residualLayerIndex],
                                                NULL,
                                                NULL,
-                                               residualElement );
+                                               residualElement,
+                                               workspace );
     }
-    for ( unsigned i = 0; i <_size; ++i )
+
+    // Each neuron belongs to a single block, so no other thread writes
+    // to these bounds
+    for ( unsigned i = 0; i < workspace._blockSize; ++i )
     {
-        if ( _lb[i] < _workLb[i] )
-            _lb[i] = _workLb[i];
-        if ( _ub[i] > _workUb[i] )
-            _ub[i] = _workUb[i];
-        log( Stringf( "Neuron%u working LB: %f, UB: %f", i, _workLb[i], _workUb[i] ) );
-        log( Stringf( "Neuron%u LB: %f, UB: %f", i, _lb[i], _ub[i] ) );
+        unsigned neuron = workspace._blockStart + i;
+        if ( _lb[neuron] < workLb[i] )
+            _lb[neuron] = workLb[i];
+        if ( _ub[neuron] > workUb[i] )
+            _ub[neuron] = workUb[i];
+        log( Stringf( "Neuron%u working LB: %f, UB: %f", neuron, workLb[i], workUb[i] ) );
+        log( Stringf( "Neuron%u LB: %f, UB: %f", neuron, _lb[neuron], _ub[neuron] ) );
     }
 
     log( "Concretizing bound - done" );
@@ -237,7 +326,7 @@ void DeepPolyWeightedSumElement::concretizeSymbolicBound
 void DeepPolyWeightedSumElement::concretizeSymbolicBoundForSourceLayer
 ( const double *symbolicLb, const double*symbolicUb, const double
   *symbolicLowerBias, const double *symbolicUpperBias, DeepPolyElement
-  *sourceElement )
+  *sourceElement, DeepPolyWorkspace &workspace )
 {
     /*
     DEBUG({
@@ -285,6 +374,9 @@ void DeepPolyWeightedSumElement::concretizeSymbolicBoundForSourceLayer
     */
 
     // Get concrete bounds
+    unsigned blockSize = workspace._blockSize;
+    double *workLb = workspace._workLb;
+    double *workUb = workspace._workUb;
     for ( unsigned i = 0; i < sourceElement->getSize(); ++i )
     {
         double sourceLb = sourceElement->getLowerBoundFromLayer( i );
@@ -293,36 +385,36 @@ void DeepPolyWeightedSumElement::concretizeSymbolicBoundForSourceLayer
         log( Stringf( "Bounds of neuron%u_%u: [%f, %f]\n", sourceElement->
                       getLayerIndex(), i, sourceLb, sourceUb ) );
 
-        for ( unsigned j = 0; j < _size; ++j )
+        for ( unsigned j = 0; j < blockSize; ++j )
         {
             // Compute lower bound
-            double weight = symbolicLb[i * _size + j];
+            double weight = symbolicLb[i * blockSize + j];
             if ( weight >= 0 )
             {
-                _workLb[j] += ( weight * sourceLb );
+                workLb[j] += ( weight * sourceLb );
             } else
             {
-                _workLb[j] += ( weight * sourceUb );
+                workLb[j] += ( weight * sourceUb );
             }
 
             // Compute upper bound
-            weight = symbolicUb[i * _size + j];
+            weight = symbolicUb[i * blockSize + j];
             if ( weight >= 0 )
             {
-                _workUb[j] += ( weight * sourceUb );
+                workUb[j] += ( weight * sourceUb );
             } else
             {
-                _workUb[j] += ( weight * sourceLb );
+                workUb[j] += ( weight * sourceLb );
             }
         }
     }
 
-    for ( unsigned i = 0; i < _size; ++i )
+    for ( unsigned i = 0; i < blockSize; ++i )
     {
         if ( symbolicLowerBias )
-            _workLb[i] += symbolicLowerBias[i];
+            workLb[i] += symbolicLowerBias[i];
         if ( symbolicUpperBias )
-            _workUb[i] += symbolicUpperBias[i];
+            workUb[i] += symbolicUpperBias[i];
     }
 }
 
@@ -338,17 +430,26 @@ void DeepPolyWeightedSumElement::symbolicBoundInTermsOfPredecessor
                   predecessorIndex ) );
     unsigned predecessorSize = predecessor->getSize();
 
-    double *weights = _layer->getWeights( predecessorIndex );
-    double *biases = _layer->getBiases();
+    const double *biases = _layer->getBiases();
 
     // newSymbolicLb = weights * symbolicLb
     // newSymbolicUb = weights * symbolicUb
-    matrixMultiplication( weights, symbolicLb,
-                          symbolicLbInTermsOfPredecessor, predecessorSize,
-                          _size, targetLayerSize );
-    matrixMultiplication( weights, symbolicUb,
-                          symbolicUbInTermsOfPredecessor, predecessorSize,
-                          _size, targetLayerSize );
+    if ( _layer->hasSparseWeights( predecessorIndex ) )
+    {
+        const SparseWeightMatrix *weights = _layer->getSparseWeights( predecessorIndex );
+        weights->rightMultiply( symbolicLb, symbolicLbInTermsOfPredecessor, targetLayerSize );
+        weights->rightMultiply( symbolicUb, symbolicUbInTermsOfPredecessor, targetLayerSize );
+    }
+    else
+    {
+        const double *weights = _layer->getWeights( predecessorIndex );
+        matrixMultiplication( weights, symbolicLb,
+                              symbolicLbInTermsOfPredecessor, predecessorSize,
+                              _size, targetLayerSize );
+        matrixMultiplication( weights, symbolicUb,
+                              symbolicUbInTermsOfPredecessor, predecessorSize,
+                              _size, targetLayerSize );
+    }
 
     // symbolicLowerBias = biases * symbolicLb
     // symbolicUpperBias = biases * symbolicUb
@@ -362,62 +463,16 @@ void DeepPolyWeightedSumElement::symbolicBoundInTermsOfPredecessor
                   predecessorIndex ) );
 }
 
-void DeepPolyWeightedSumElement::allocateMemoryForResidualsIfNeeded
-( unsigned residualLayerIndex, unsigned residualLayerSize )
-{
-    _residualLayerIndices.insert( residualLayerIndex );
-    unsigned matrixSize = residualLayerSize * _size;
-    if ( !_residualLb.exists( residualLayerIndex ) )
-    {
-        double *residualLb = new double[matrixSize];
-        std::fill_n( residualLb, matrixSize, 0 );
-        _residualLb[residualLayerIndex] = residualLb;
-    }
-    if ( !_residualUb.exists( residualLayerIndex ) )
-    {
-        double *residualUb = new double[residualLayerSize * _size];
-        std::fill_n( residualUb, matrixSize, 0 );
-        _residualUb[residualLayerIndex] = residualUb;
-    }
-}
-
 void DeepPolyWeightedSumElement::allocateMemory()
 {
     freeMemoryIfNeeded();
 
     DeepPolyElement::allocateMemory();
-
-    _workLb = new double[_size];
-    _workUb = new double[_size];
-
-    std::fill_n( _workLb, _size, FloatUtils::negativeInfinity() );
-    std::fill_n( _workUb, _size, FloatUtils::infinity() );
 }
 
 void DeepPolyWeightedSumElement::freeMemoryIfNeeded()
 {
     DeepPolyElement::freeMemoryIfNeeded();
-    if ( _workLb )
-    {
-        delete[] _workLb;
-        _workLb = NULL;
-    }
-    if ( _workUb )
-    {
-        delete[] _workUb;
-        _workUb = NULL;
-    }
-    for ( auto const &pair : _residualLb )
-    {
-        delete[] pair.second;
-    }
-    _residualLb.clear();
-    for ( auto const &pair : _residualUb )
-    {
-        delete[] pair.second;
-    }
-    _residualUb.clear();
-    _residualLayerIndices.clear();
 }
 
 void DeepPolyWeightedSumElement::log( const String &message )
@@ -40,17 +40,6 @@ public:
 
 private:
 
-    /*
-      Memory allocated to store concrete bounds computed at different stages
-      of back substitution.
-    */
-    double *_workLb;
-    double *_workUb;
-
-    Set<unsigned>  _residualLayerIndices;
-    Map<unsigned, double *>  _residualLb;
-    Map<unsigned, double *>  _residualUb;
-
     /*
       Compute the concrete upper- and lower- bounds of this layer by concretizing
       the symbolic bounds with respect to every preceding element.
@@ -58,6 +47,24 @@ private:
     void computeBoundWithBackSubstitution( const Map<unsigned, DeepPolyElement *>
                                            &deepPolyElementsBefore );
 
+    /*
+      Back-substitute the bounds of the neurons in [blockStart,
+      blockStart + blockSize), using the given workspace.
+    */
+    void computeBlockBoundWithBackSubstitution( unsigned blockStart,
+                                                unsigned blockSize,
+                                                DeepPolyWorkspace &workspace,
+                                                const Map<unsigned, DeepPolyElement *>
+                                                &deepPolyElementsBefore );
+
+    /*
+      Copy the columns of the workspace's current block out of this
+      layer's weights with respect to a source layer
+    */
+    void copyWeightsOfBlock( unsigned sourceLayerIndex, unsigned sourceLayerSize,
+                             const DeepPolyWorkspace &workspace,
+                             double *symbolicLb, double *symbolicUb ) const;
+
     /*
       Compute concrete bounds using symbolic bounds with respect to a
       sourceElement.
@@ -66,6 +73,7 @@ private:
                                   *symbolicUb, const double *symbolicLowerBias,
                                   const double *symbolicUpperBias,
                                   DeepPolyElement *sourceElement,
+                                  DeepPolyWorkspace &workspace,
                                   const Map<unsigned, DeepPolyElement *>
                                   &deepPolyElementsBefore );
 
@@ -73,10 +81,9 @@ private:
                                                 const double*symbolicUb,
                                                 const double *symbolicLowerBias,
                                                 const double *symbolicUpperBias,
-                                                DeepPolyElement *sourceElement );
+                                                DeepPolyElement *sourceElement,
+                                                DeepPolyWorkspace &workspace );
 
-    void allocateMemoryForResidualsIfNeeded( unsigned residualLayerIndex,
-                                             unsigned residualLayerSize );
     void allocateMemory();
     void freeMemoryIfNeeded();
     void log( const String &message );
@@ -0,0 +1,112 @@
+/*********************                                                        */
+/*! \file DeepPolyWorkerPool.cpp
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "Debug.h"
+#include "DeepPolyWorkerPool.h"
+
+namespace NLR {
+
+DeepPolyWorkerPool::DeepPolyWorkerPool( unsigned numberOfWorkers )
+    : _numberOfWorkers( numberOfWorkers )
+    , _task( NULL )
+    , _generation( 0 )
+    , _running( 0 )
+    , _stop( false )
+{
+    ASSERT( _numberOfWorkers > 0 );
+
+    for ( unsigned i = 1; i < _numberOfWorkers; ++i )
+        _threads.push_back( boost::thread( &DeepPolyWorkerPool::workerLoop, this, i ) );
+}
+
+DeepPolyWorkerPool::~DeepPolyWorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock( _mutex );
+        _stop = true;
+    }
+    _taskReady.notify_all();
+
+    for ( auto &thread : _threads )
+        thread.join();
+}
+
+unsigned DeepPolyWorkerPool::getNumberOfWorkers() const
+{
+    return _numberOfWorkers;
+}
+
+void DeepPolyWorkerPool::run( const std::function<void( unsigned )> &task )
+{
+    if ( _numberOfWorkers == 1 )
+    {
+        task( 0 );
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock( _mutex );
+        _task = &task;
+        _running = _numberOfWorkers;
+        _exception = nullptr;
+        ++_generation;
+    }
+    _taskReady.notify_all();
+
+    runTask( 0 );
+
+    std::unique_lock<std::mutex> lock( _mutex );
+    _taskDone.wait( lock, [this] { return _running == 0; } );
+    _task = NULL;
+
+    if ( _exception )
+        std::rethrow_exception( _exception );
+}
+
+void DeepPolyWorkerPool::workerLoop( unsigned worker )
+{
+    unsigned long long lastGeneration = 0;
+    while ( true )
+    {
+        {
+            std::unique_lock<std::mutex> lock( _mutex );
+            _taskReady.wait( lock, [&] { return _stop || _generation != lastGeneration; } );
+            if ( _stop )
+                return;
+            lastGeneration = _generation;
+        }
+
+        runTask( worker );
+    }
+}
+
+void DeepPolyWorkerPool::runTask( unsigned worker )
+{
+    std::exception_ptr exception = nullptr;
+    try
+    {
+        ( *_task )( worker );
+    }
+    catch ( ... )
+    {
+        exception = std::current_exception();
+    }
+
+    std::lock_guard<std::mutex> lock( _mutex );
+    if ( exception && !_exception )
+        _exception = exception;
+    if ( --_running == 0 )
+        _taskDone.notify_one();
+}
+
+} // namespace NLR
@@ -0,0 +1,71 @@
+/*********************                                                        */
+/*! \file DeepPolyWorkerPool.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Threads that back-substitute the blocks of DeepPoly's weighted sum
+ ** layers. They are started once per analysis and wait between layers,
+ ** instead of being spawned for every layer of every run.
+
+**/
+
+#ifndef __DeepPolyWorkerPool_h__
+#define __DeepPolyWorkerPool_h__
+
+#include <boost/thread.hpp>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace NLR {
+
+class DeepPolyWorkerPool
+{
+public:
+    /*
+      The calling thread counts as a worker, so numberOfWorkers - 1
+      threads are started.
+    */
+    DeepPolyWorkerPool( unsigned numberOfWorkers );
+    ~DeepPolyWorkerPool();
+
+    unsigned getNumberOfWorkers() const;
+
+    /*
+      Call task( worker ) once for every worker, the calling thread
+      being worker 0, and return when all calls have returned. If a
+      call throws, the exception is rethrown here.
+    */
+    void run( const std::function<void( unsigned )> &task );
+
+private:
+    unsigned _numberOfWorkers;
+    std::vector<boost::thread> _threads;
+
+    std::mutex _mutex;
+    std::condition_variable _taskReady;
+    std::condition_variable _taskDone;
+
+    /*
+      The current task, a counter that tells the workers a new task was
+      posted, and the number of workers still running it
+    */
+    const std::function<void( unsigned )> *_task;
+    unsigned long long _generation;
+    unsigned _running;
+    bool _stop;
+    std::exception_ptr _exception;
+
+    void workerLoop( unsigned worker );
+    void runTask( unsigned worker );
+};
+
+} // namespace NLR
+
+#endif // __DeepPolyWorkerPool_h__
@@ -0,0 +1,101 @@
+/*********************                                                        */
+/*! \file DeepPolyWorkspace.cpp
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "DeepPolyWorkspace.h"
+
+#include <algorithm>
+
+namespace NLR {
+
+DeepPolyWorkspace::DeepPolyWorkspace( unsigned maxLayerSize,
+                                      unsigned maxBlockSize )
+    : _blockStart( 0 )
+    , _blockSize( 0 )
+    , _maxLayerSize( maxLayerSize )
+    , _maxBlockSize( maxBlockSize )
+{
+    unsigned workSize = _maxBlockSize * _maxLayerSize;
+    _work1SymbolicLb = new double[workSize];
+    _work1SymbolicUb = new double[workSize];
+    _work2SymbolicLb = new double[workSize];
+    _work2SymbolicUb = new double[workSize];
+
+    _workSymbolicLowerBias = new double[_maxBlockSize];
+    _workSymbolicUpperBias = new double[_maxBlockSize];
+
+    _workLb = new double[_maxBlockSize];
+    _workUb = new double[_maxBlockSize];
+
+    std::fill_n( _work1SymbolicLb, workSize, 0 );
+    std::fill_n( _work1SymbolicUb, workSize, 0 );
+    std::fill_n( _work2SymbolicLb, workSize, 0 );
+    std::fill_n( _work2SymbolicUb, workSize, 0 );
+
+    std::fill_n( _workSymbolicLowerBias, _maxBlockSize, 0 );
+    std::fill_n( _workSymbolicUpperBias, _maxBlockSize, 0 );
+
+    std::fill_n( _workLb, _maxBlockSize, 0 );
+    std::fill_n( _workUb, _maxBlockSize, 0 );
+}
+
+DeepPolyWorkspace::~DeepPolyWorkspace()
+{
+    delete[] _work1SymbolicLb;
+    delete[] _work1SymbolicUb;
+    delete[] _work2SymbolicLb;
+    delete[] _work2SymbolicUb;
+    delete[] _workSymbolicLowerBias;
+    delete[] _workSymbolicUpperBias;
+    delete[] _workLb;
+    delete[] _workUb;
+
+    for ( const auto &pair : _residualLb )
+        delete[] pair.second;
+    for ( const auto &pair : _residualUb )
+        delete[] pair.second;
+}
+
+unsigned DeepPolyWorkspace::getMaxBlockSize() const
+{
+    return _maxBlockSize;
+}
+
+void DeepPolyWorkspace::addResidualLayer( unsigned layerIndex,
+                                          unsigned layerSize )
+{
+    _residualLayerIndices.insert( layerIndex );
+
+    // Residual buffers are zero between uses, and are sized for the
+    // largest block
+    unsigned matrixSize = layerSize * _maxBlockSize;
+    if ( !_residualLb.exists( layerIndex ) )
+    {
+        double *residualLb = new double[matrixSize];
+        std::fill_n( residualLb, matrixSize, 0 );
+        _residualLb[layerIndex] = residualLb;
+    }
+    if ( !_residualUb.exists( layerIndex ) )
+    {
+        double *residualUb = new double[matrixSize];
+        std::fill_n( residualUb, matrixSize, 0 );
+        _residualUb[layerIndex] = residualUb;
+    }
+}
+
+void DeepPolyWorkspace::swapWorkBuffers()
+{
+    std::swap( _work1SymbolicLb, _work2SymbolicLb );
+    std::swap( _work1SymbolicUb, _work2SymbolicUb );
+}
+
+} // namespace NLR
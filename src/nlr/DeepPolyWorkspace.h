@@ -0,0 +1,80 @@
+/*********************                                                        */
+/*! \file DeepPolyWorkspace.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Scratch memory used by a weighted sum element to back-substitute the
+ ** symbolic bounds of one block of its neurons. Every thread taking part
+ ** in the back-substitution owns a workspace of its own.
+
+**/
+
+#ifndef __DeepPolyWorkspace_h__
+#define __DeepPolyWorkspace_h__
+
+#include "Map.h"
+#include "Set.h"
+
+namespace NLR {
+
+class DeepPolyWorkspace
+{
+public:
+    DeepPolyWorkspace( unsigned maxLayerSize, unsigned maxBlockSize );
+    ~DeepPolyWorkspace();
+
+    unsigned getMaxBlockSize() const;
+
+    /*
+      Mark a layer as a residual source of the current block, allocating
+      its residual buffers on first use.
+    */
+    void addResidualLayer( unsigned layerIndex, unsigned layerSize );
+
+    /*
+      Exchange the two sets of symbolic buffers, once the bounds in work2
+      have been computed from those in work1.
+    */
+    void swapWorkBuffers();
+
+    /*
+      The symbolic bounds of the block, with respect to the element
+      currently being substituted, and the next one.
+    */
+    double *_work1SymbolicLb;
+    double *_work1SymbolicUb;
+    double *_work2SymbolicLb;
+    double *_work2SymbolicUb;
+    double *_workSymbolicLowerBias;
+    double *_workSymbolicUpperBias;
+
+    /*
+      Concrete bounds of the block, obtained at the current stage of
+      back-substitution
+    */
+    double *_workLb;
+    double *_workUb;
+
+    /*
+      The range of neurons of the target layer currently held in the
+      workspace
+    */
+    unsigned _blockStart;
+    unsigned _blockSize;
+
+    Set<unsigned> _residualLayerIndices;
+    Map<unsigned, double *> _residualLb;
+    Map<unsigned, double *> _residualUb;
+
+private:
+    unsigned _maxLayerSize;
+    unsigned _maxBlockSize;
+};
+
+} // namespace NLR
+
+#endif // __DeepPolyWorkspace_h__
@@ -47,16 +47,16 @@ void IterativePropagator::optimizeBoundsWithIterativePropagation( const Map<unsi
     // Time to wait if no idle worker is availble
     boost::chrono::milliseconds waitTime( numberOfWorkers - 1 );
 
-    Map<GurobiWrapper *, unsigned> solverToIndex;
+    Map<ILPSolver *, unsigned> solverToIndex;
     // Create a queue of free workers
     // When a worker is working, it is popped off the queue, when it is done, it
     // is added back to the queue.
     SolverQueue freeSolvers( numberOfWorkers );
     for ( unsigned i = 0; i < numberOfWorkers; ++i )
     {
-        GurobiWrapper *gurobi = new GurobiWrapper();
-        solverToIndex[gurobi] = i;
-        enqueueSolver( freeSolvers, gurobi );
+        ILPSolver *solver = new GurobiWrapper();
+        solverToIndex[solver] = i;
+        enqueueSolver( freeSolvers, solver );
     }
 
     std::vector<boost::thread> threads( numberOfWorkers );
@@ -81,17 +81,17 @@ void IterativePropagator::optimizeBoundsWithIterativePropagation( const Map<unsi
     NeuronIndex lastFixedNeuronThisIteration = lastIndex;
     bool shouldQuit = false;
 
-    struct timespec gurobiStart;
-    (void) gurobiStart;
-    struct timespec gurobiEnd;
-    (void) gurobiEnd;
+    struct timespec solverStart;
+    (void) solverStart;
+    struct timespec solverEnd;
+    (void) solverEnd;
 
-    gurobiStart = TimeUtils::sampleMicro();
+    solverStart = TimeUtils::sampleMicro();
 
     do
     {
         if ( Options::get()->getInt( Options::VERBOSITY ) > 0 )
-            printf( "Number of tighter bounds found by Gurobi before this iteration: %u. Sign changes: %u. Cutoffs: %u\n",
+            printf( "Number of tighter bounds found by the LP solver before this iteration: %u. Sign changes: %u. Cutoffs: %u\n",
                     tighterBoundCounter.load(), signChanges.load(), cutoffs.load() );
 
         mtx.lock();
@@ -162,7 +162,7 @@ void IterativePropagator::optimizeBoundsWithIterativePropagation( const Map<unsi
                 }
 
                 // Wait until there is an idle solver
-                GurobiWrapper *freeSolver;
+                ILPSolver *freeSolver;
                 while ( !freeSolvers.pop( freeSolver ) )
                     boost::this_thread::sleep_for( waitTime );
 
@@ -194,16 +194,16 @@ void IterativePropagator::optimizeBoundsWithIterativePropagation( const Map<unsi
         }
 
         if ( Options::get()->getInt( Options::VERBOSITY ) > 0 )
-            printf( "Number of tighter bounds found by Gurobi after this iteration: %u. Sign changes: %u. Cutoffs: %u\n",
+            printf( "Number of tighter bounds found by the LP solver after this iteration: %u. Sign changes: %u. Cutoffs: %u\n",
                     tighterBoundCounter.load(), signChanges.load(), cutoffs.load() );
     }
     while ( !shouldQuit );
 
-    gurobiEnd = TimeUtils::sampleMicro();
+    solverEnd = TimeUtils::sampleMicro();
 
-    IterativePropagator_LOG( Stringf( "Number of tighter bounds found by Gurobi: %u. Sign changes: %u. Cutoffs: %u\n",
+    IterativePropagator_LOG( Stringf( "Number of tighter bounds found by the LP solver: %u. Sign changes: %u. Cutoffs: %u\n",
                                tighterBoundCounter.load(), signChanges.load(), cutoffs.load() ).ascii() );
-    IterativePropagator_LOG( Stringf( "Seconds spent Gurobiing: %llu\n", TimeUtils::timePassed( gurobiStart, gurobiEnd ) / 1000000 ).ascii() );
+    IterativePropagator_LOG( Stringf( "Seconds spent in the LP solver: %llu\n", TimeUtils::timePassed( solverStart, solverEnd ) / 1000000 ).ascii() );
 
     clearSolverQueue( freeSolvers );
 
@@ -218,22 +218,22 @@ void IterativePropagator::setCutoff( double cutoff )
 }
 
 
-double IterativePropagator::optimizeWithGurobi( GurobiWrapper &gurobi, MinOrMax
-                                           minOrMax, String variableName,
+double IterativePropagator::optimizeWithSolver( ILPSolver &solver, MinOrMax
+                                           minOrMax, unsigned variable,
                                            double cutoffValue,
                                            std::atomic_bool *infeasible )
 {
-    List<GurobiWrapper::Term> terms;
-    terms.append( GurobiWrapper::Term( 1, variableName ) );
+    List<ILPSolver::Term> terms;
+    terms.append( ILPSolver::Term( 1, variable ) );
 
     if ( minOrMax == MAX )
-        gurobi.setObjective( terms );
+        solver.setObjective( terms );
     else
-        gurobi.setCost( terms );
+        solver.setCost( terms );
 
-    gurobi.solve();
+    solver.solve();
 
-    if ( gurobi.infeasible() )
+    if ( solver.infeasible() )
     {
         if ( infeasible )
         {
@@ -244,19 +244,19 @@ double IterativePropagator::optimizeWithGurobi( GurobiWrapper &gurobi, MinOrMax
             throw InfeasibleQueryException();
     }
 
-    if ( gurobi.cutoffOccurred() )
+    if ( solver.cutoffOccurred() )
         return cutoffValue;
 
-    if ( gurobi.optimal() )
+    if ( solver.optimal() )
     {
-        Map<String, double> dontCare;
+        Map<unsigned, double> dontCare;
         double result = 0;
-        gurobi.extractSolution( dontCare, result );
+        solver.extractSolution( dontCare, result );
         return result;
     }
-    else if ( gurobi.timeout() )
+    else if ( solver.timeout() )
     {
-        return gurobi.getObjectiveBound();
+        return solver.getObjectiveBound();
     }
 
     throw NLRError( NLRError::UNEXPECTED_RETURN_STATUS_FROM_GUROBI );
@@ -278,18 +278,18 @@ void IterativePropagator::tightenSingleVariableBounds( ThreadArgument &argument
                 tightenSingleVariableLowerBounds( argument );
         }
         SolverQueue &freeSolvers = argument._freeSolvers;
-        GurobiWrapper *gurobi = argument._gurobi;
-        enqueueSolver( freeSolvers, gurobi );
+        ILPSolver *solver = argument._solver;
+        enqueueSolver( freeSolvers, solver );
     }
     catch ( boost::thread_interrupted& )
     {
-        enqueueSolver( argument._freeSolvers, argument._gurobi );
+        enqueueSolver( argument._freeSolvers, argument._solver );
     }
 }
 
 bool IterativePropagator::tightenSingleVariableLowerBounds( ThreadArgument &argument )
 {
-    GurobiWrapper *gurobi = argument._gurobi;
+    ILPSolver *solver = argument._solver;
     Layer *layer = argument._layer;
     unsigned index = argument._index;
     double currentLb = argument._currentLb;
@@ -304,9 +304,8 @@ bool IterativePropagator::tightenSingleVariableLowerBounds( ThreadArgument &argu
     NeuronIndex *lastFixedNeuron = argument._lastFixedNeuron;
 
     unsigned variable = layer->neuronToVariable( index );
-    Stringf variableName( "x%u", variable );
-    gurobi->reset();
-    double lb = optimizeWithGurobi( *gurobi, MinOrMax::MIN, variableName,
+    solver->reset();
+    double lb = optimizeWithSolver( *solver, MinOrMax::MIN, variable,
                                     cutoffValue, &infeasible );
 
     // Store the new bound if it is tighter
@@ -345,7 +344,7 @@ bool IterativePropagator::tightenSingleVariableLowerBounds( ThreadArgument &argu
 
 bool IterativePropagator::tightenSingleVariableUpperBounds( ThreadArgument &argument )
 {
-    GurobiWrapper *gurobi = argument._gurobi;
+    ILPSolver *solver = argument._solver;
     Layer *layer = argument._layer;
     unsigned index = argument._index;
     double currentUb = argument._currentUb;
@@ -360,9 +359,8 @@ bool IterativePropagator::tightenSingleVariableUpperBounds( ThreadArgument &argu
     NeuronIndex *lastFixedNeuron = argument._lastFixedNeuron;
 
     unsigned variable = layer->neuronToVariable( index );
-    Stringf variableName( "x%u", variable );
-    gurobi->reset();
-    double ub = optimizeWithGurobi( *gurobi, MinOrMax::MAX, variableName,
+    solver->reset();
+    double ub = optimizeWithSolver( *solver, MinOrMax::MAX, variable,
                                     cutoffValue, &infeasible );
 
     // Store the new bound if it is tighter
@@ -55,11 +55,11 @@ private:
     double _cutoffValue;
 
     /*
-      Optimize for the min/max value of variableName with respect to the constraints
-      encoded in gurobi. If the query is infeasible, *infeasible is set to true.
+      Optimize for the min/max value of variable with respect to the constraints
+      encoded in the solver. If the query is infeasible, *infeasible is set to true.
     */
-    static double optimizeWithGurobi( GurobiWrapper &gurobi, MinOrMax minOrMax,
-                                      String variableName, double cutoffValue,
+    static double optimizeWithSolver( ILPSolver &solver, MinOrMax minOrMax,
+                                      unsigned variable, double cutoffValue,
                                       std::atomic_bool *infeasible = NULL );
 
     /*
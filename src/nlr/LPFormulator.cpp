@@ -13,9 +13,9 @@
 
  **/
 
-#include "GurobiWrapper.h"
 #include "InfeasibleQueryException.h"
 #include "LPFormulator.h"
+#include "LPSolverFactory.h"
 #include "Layer.h"
 #include "MStringf.h"
 #include "NLRError.h"
@@ -23,12 +23,16 @@
 #include "TimeUtils.h"
 #include "Vector.h"
 
+#include <memory>
+
 namespace NLR {
 
 LPFormulator::LPFormulator( LayerOwner *layerOwner )
     : _layerOwner( layerOwner )
     , _cutoffInUse( false )
     , _cutoffValue( 0 )
+    , _reuseModels( false )
+    , _numberOfModelBuilds( 0 )
 {
 }
 
@@ -36,33 +40,33 @@ LPFormulator::~LPFormulator()
 {
 }
 
-double LPFormulator::solveLPRelaxation( GurobiWrapper &gurobi,
+double LPFormulator::solveLPRelaxation( ILPSolver &solver,
                                         const Map<unsigned, Layer *> &layers,
-                                        MinOrMax minOrMax, String variableName,
+                                        MinOrMax minOrMax, unsigned variable,
                                         unsigned lastLayer )
 {
-    gurobi.resetModel();
-    createLPRelaxation( layers, gurobi, lastLayer );
-    return optimizeWithGurobi( gurobi, minOrMax, variableName, _cutoffValue );
+    solver.resetModel();
+    createLPRelaxation( layers, solver, lastLayer );
+    return optimizeWithSolver( solver, minOrMax, variable, _cutoffValue );
 }
 
-double LPFormulator::optimizeWithGurobi( GurobiWrapper &gurobi,
-                                         MinOrMax minOrMax, String variableName,
+double LPFormulator::optimizeWithSolver( ILPSolver &solver,
+                                         MinOrMax minOrMax, unsigned variable,
                                          double cutoffValue, std::atomic_bool *infeasible )
 {
-    List<GurobiWrapper::Term> terms;
-    terms.append( GurobiWrapper::Term( 1, variableName ) );
+    List<ILPSolver::Term> terms;
+    terms.append( ILPSolver::Term( 1, variable ) );
 
     if ( minOrMax == MAX )
-        gurobi.setObjective( terms );
+        solver.setObjective( terms );
     else
-        gurobi.setCost( terms );
+        solver.setCost( terms );
 
-    gurobi.setTimeLimit( FloatUtils::infinity() );
+    solver.setTimeLimit( FloatUtils::infinity() );
 
-    gurobi.solve();
+    solver.solve();
 
-    if ( gurobi.infeasible() )
+    if ( solver.infeasible() )
     {
         if ( infeasible )
         {
@@ -73,19 +77,19 @@ double LPFormulator::optimizeWithGurobi( GurobiWrapper &gurobi,
             throw InfeasibleQueryException();
     }
 
-    if ( gurobi.cutoffOccurred() )
+    if ( solver.cutoffOccurred() )
         return cutoffValue;
 
-    if ( gurobi.optimal() )
+    if ( solver.optimal() )
     {
-        Map<String, double> dontCare;
+        Map<unsigned, double> dontCare;
         double result = 0;
-        gurobi.extractSolution( dontCare, result );
+        solver.extractSolution( dontCare, result );
         return result;
     }
-    else if ( gurobi.timeout() )
+    else if ( solver.timeout() )
     {
-        return gurobi.getObjectiveBound();
+        return solver.getObjectiveBound();
     }
 
     throw NLRError( NLRError::UNEXPECTED_RETURN_STATUS_FROM_GUROBI );
@@ -93,10 +97,11 @@ double LPFormulator::optimizeWithGurobi( GurobiWrapper &gurobi,
 
 void LPFormulator::optimizeBoundsWithIncrementalLpRelaxation( const Map<unsigned, Layer *> &layers )
 {
-    GurobiWrapper gurobi;
+    std::unique_ptr<ILPSolver> ownedSolver( LPSolverFactory::createLPSolver() );
+    ILPSolver &solver = *ownedSolver;
 
-    List<GurobiWrapper::Term> terms;
-    Map<String, double> dontCare;
+    List<ILPSolver::Term> terms;
+    Map<unsigned, double> dontCare;
     double lb = 0;
     double ub = 0;
     double currentLb = 0;
@@ -106,12 +111,12 @@ void LPFormulator::optimizeBoundsWithIncrementalLpRelaxation( const Map<unsigned
     unsigned signChanges = 0;
     unsigned cutoffs = 0;
 
-    struct timespec gurobiStart;
-    (void) gurobiStart;
-    struct timespec gurobiEnd;
-    (void) gurobiEnd;
+    struct timespec solverStart;
+    (void) solverStart;
+    struct timespec solverEnd;
+    (void) solverEnd;
 
-    gurobiStart = TimeUtils::sampleMicro();
+    solverStart = TimeUtils::sampleMicro();
 
     for ( unsigned i = 0; i < _layerOwner->getNumberOfLayers(); ++i )
     {
@@ -121,7 +126,7 @@ void LPFormulator::optimizeBoundsWithIncrementalLpRelaxation( const Map<unsigned
         */
         ASSERT( layers.exists( i ) );
         Layer *layer = layers[i];
-        addLayerToModel( gurobi, layer );
+        addLayerToModel( solver, layer );
 
         for ( unsigned j = 0; j < layer->getSize(); ++j )
         {
@@ -135,30 +140,29 @@ void LPFormulator::optimizeBoundsWithIncrementalLpRelaxation( const Map<unsigned
                 continue;
 
             unsigned variable = layer->neuronToVariable( j );
-            Stringf variableName( "x%u", variable );
 
             terms.clear();
-            terms.append( GurobiWrapper::Term( 1, variableName ) );
+            terms.append( ILPSolver::Term( 1, variable ) );
 
             // Maximize
-            gurobi.reset();
-            gurobi.setObjective( terms );
-            gurobi.solve();
+            solver.reset();
+            solver.setObjective( terms );
+            solver.solve();
 
-            if ( gurobi.infeasible() )
+            if ( solver.infeasible() )
                 throw InfeasibleQueryException();
 
-            if ( gurobi.cutoffOccurred() )
+            if ( solver.cutoffOccurred() )
             {
                 ub = _cutoffValue;
             }
-            else if ( gurobi.optimal() )
+            else if ( solver.optimal() )
             {
-                gurobi.extractSolution( dontCare, ub );
+                solver.extractSolution( dontCare, ub );
             }
-            else if ( gurobi.timeout() )
+            else if ( solver.timeout() )
             {
-                ub = gurobi.getObjectiveBound();
+                ub = solver.getObjectiveBound();
             }
             else
             {
@@ -168,7 +172,7 @@ void LPFormulator::optimizeBoundsWithIncrementalLpRelaxation( const Map<unsigned
             // If the bound is tighter, store it
             if ( ub < currentUb )
             {
-                gurobi.setUpperBound( variableName, ub );
+                solver.setUpperBound( variable, ub );
 
                 if ( FloatUtils::isPositive( currentUb ) &&
                      !FloatUtils::isPositive( ub ) )
@@ -188,24 +192,24 @@ void LPFormulator::optimizeBoundsWithIncrementalLpRelaxation( const Map<unsigned
             }
 
             // Minimize
-            gurobi.reset();
-            gurobi.setCost( terms );
-            gurobi.solve();
+            solver.reset();
+            solver.setCost( terms );
+            solver.solve();
 
-            if ( gurobi.infeasible() )
+            if ( solver.infeasible() )
                 throw InfeasibleQueryException();
 
-            if ( gurobi.cutoffOccurred() )
+            if ( solver.cutoffOccurred() )
             {
                 lb = _cutoffValue;
             }
-            else if ( gurobi.optimal() )
+            else if ( solver.optimal() )
             {
-                gurobi.extractSolution( dontCare, lb );
+                solver.extractSolution( dontCare, lb );
             }
-            else if ( gurobi.timeout() )
+            else if ( solver.timeout() )
             {
-                lb = gurobi.getObjectiveBound();
+                lb = solver.getObjectiveBound();
             }
             else
             {
@@ -215,7 +219,7 @@ void LPFormulator::optimizeBoundsWithIncrementalLpRelaxation( const Map<unsigned
             // If the bound is tighter, store it
             if ( lb > currentLb )
             {
-                gurobi.setLowerBound( variableName, lb );
+                solver.setLowerBound( variable, lb );
 
                 if ( FloatUtils::isNegative( currentLb ) &&
                      !FloatUtils::isNegative( lb ) )
@@ -236,27 +240,33 @@ void LPFormulator::optimizeBoundsWithIncrementalLpRelaxation( const Map<unsigned
         }
     }
 
-    gurobiEnd = TimeUtils::sampleMicro();
+    solverEnd = TimeUtils::sampleMicro();
 
-    LPFormulator_LOG( Stringf( "Number of tighter bounds found by Gurobi: %u. Sign changes: %u. Cutoffs: %u\n",
+    LPFormulator_LOG( Stringf( "Number of tighter bounds found by the LP solver: %u. Sign changes: %u. Cutoffs: %u\n",
                                tighterBoundCounter, signChanges, cutoffs ).ascii() );
-    LPFormulator_LOG( Stringf( "Seconds spent Gurobiing: %llu\n", TimeUtils::timePassed( gurobiStart, gurobiEnd ) / 1000000 ).ascii() );
+    LPFormulator_LOG( Stringf( "Seconds spent in the LP solver: %llu\n", TimeUtils::timePassed( solverStart, solverEnd ) / 1000000 ).ascii() );
 }
 
-void LPFormulator::optimizeBoundsWithLpRelaxation( const Map<unsigned, Layer *> &layers )
+void LPFormulator::optimizeBoundsWithLpRelaxation( const Map<unsigned, Layer *> &layers,
+                                                   bool reuseModels )
 {
     unsigned numberOfWorkers = Options::get()->getInt( Options::NUM_WORKERS );
 
-    Map<GurobiWrapper *, unsigned> solverToIndex;
+    _reuseModels = reuseModels;
+    _numberOfModelBuilds = 0;
+    _tighteningLog.clear();
+    _solverModels.clear();
+
+    Map<ILPSolver *, unsigned> solverToIndex;
     // Create a queue of free workers
     // When a worker is working, it is popped off the queue, when it is done, it
     // is added back to the queue.
     SolverQueue freeSolvers( numberOfWorkers );
     for ( unsigned i = 0; i < numberOfWorkers; ++i )
     {
-        GurobiWrapper *gurobi = new GurobiWrapper();
-        solverToIndex[gurobi] = i;
-        enqueueSolver( freeSolvers, gurobi );
+        ILPSolver *solver = LPSolverFactory::createLPSolver();
+        solverToIndex[solver] = i;
+        enqueueSolver( freeSolvers, solver );
     }
 
     boost::thread *threads = new boost::thread[numberOfWorkers];
@@ -267,12 +277,12 @@ void LPFormulator::optimizeBoundsWithLpRelaxation( const Map<unsigned, Layer *>
     std::atomic_uint signChanges( 0 );
     std::atomic_uint cutoffs( 0 );
 
-    struct timespec gurobiStart;
-    (void) gurobiStart;
-    struct timespec gurobiEnd;
-    (void) gurobiEnd;
+    struct timespec solverStart;
+    (void) solverStart;
+    struct timespec solverEnd;
+    (void) solverEnd;
 
-    gurobiStart = TimeUtils::sampleMicro();
+    solverStart = TimeUtils::sampleMicro();
 
     for ( const auto &currentLayer : layers )
     {
@@ -298,11 +308,11 @@ void LPFormulator::optimizeBoundsWithLpRelaxation( const Map<unsigned, Layer *>
         threads[i].join();
     }
 
-    gurobiEnd = TimeUtils::sampleMicro();
+    solverEnd = TimeUtils::sampleMicro();
 
-    LPFormulator_LOG( Stringf( "Number of tighter bounds found by Gurobi: %u. Sign changes: %u. Cutoffs: %u\n",
+    LPFormulator_LOG( Stringf( "Number of tighter bounds found by the LP solver: %u. Sign changes: %u. Cutoffs: %u\n",
                                tighterBoundCounter.load(), signChanges.load(), cutoffs.load() ).ascii() );
-    LPFormulator_LOG( Stringf( "Seconds spent Gurobiing: %llu\n", TimeUtils::timePassed( gurobiStart, gurobiEnd ) / 1000000 ).ascii() );
+    LPFormulator_LOG( Stringf( "Seconds spent in the LP solver: %llu\n", TimeUtils::timePassed( solverStart, solverEnd ) / 1000000 ).ascii() );
 
     clearSolverQueue( freeSolvers );
 
@@ -310,20 +320,27 @@ void LPFormulator::optimizeBoundsWithLpRelaxation( const Map<unsigned, Layer *>
         throw InfeasibleQueryException();
 }
 
-void LPFormulator::optimizeBoundsOfOneLayerWithLpRelaxation( const Map<unsigned, Layer *> &layers, unsigned targetIndex )
+void LPFormulator::optimizeBoundsOfOneLayerWithLpRelaxation( const Map<unsigned, Layer *> &layers,
+                                                             unsigned targetIndex,
+                                                             bool reuseModels )
 {
     unsigned numberOfWorkers = Options::get()->getInt( Options::NUM_WORKERS );
 
-    Map<GurobiWrapper *, unsigned> solverToIndex;
+    _reuseModels = reuseModels;
+    _numberOfModelBuilds = 0;
+    _tighteningLog.clear();
+    _solverModels.clear();
+
+    Map<ILPSolver *, unsigned> solverToIndex;
     // Create a queue of free workers
     // When a worker is working, it is popped off the queue, when it is done, it
     // is added back to the queue.
     SolverQueue freeSolvers( numberOfWorkers );
     for ( unsigned i = 0; i < numberOfWorkers; ++i )
     {
-        GurobiWrapper *gurobi = new GurobiWrapper();
-        solverToIndex[gurobi] = i;
-        enqueueSolver( freeSolvers, gurobi );
+        ILPSolver *solver = LPSolverFactory::createLPSolver();
+        solverToIndex[solver] = i;
+        enqueueSolver( freeSolvers, solver );
     }
 
     boost::thread *threads = new boost::thread[numberOfWorkers];
@@ -334,12 +351,12 @@ void LPFormulator::optimizeBoundsOfOneLayerWithLpRelaxation( const Map<unsigned,
     std::atomic_uint signChanges( 0 );
     std::atomic_uint cutoffs( 0 );
 
-    struct timespec gurobiStart;
-    (void) gurobiStart;
-    struct timespec gurobiEnd;
-    (void) gurobiEnd;
+    struct timespec solverStart;
+    (void) solverStart;
+    struct timespec solverEnd;
+    (void) solverEnd;
 
-    gurobiStart = TimeUtils::sampleMicro();
+    solverStart = TimeUtils::sampleMicro();
 
     Layer *layer = layers[targetIndex];
 
@@ -362,11 +379,11 @@ void LPFormulator::optimizeBoundsOfOneLayerWithLpRelaxation( const Map<unsigned,
         threads[i].join();
     }
 
-    gurobiEnd = TimeUtils::sampleMicro();
+    solverEnd = TimeUtils::sampleMicro();
 
-    LPFormulator_LOG( Stringf( "Number of tighter bounds found by Gurobi: %u. Sign changes: %u. Cutoffs: %u\n",
+    LPFormulator_LOG( Stringf( "Number of tighter bounds found by the LP solver: %u. Sign changes: %u. Cutoffs: %u\n",
                                tighterBoundCounter.load(), signChanges.load(), cutoffs.load() ).ascii() );
-    LPFormulator_LOG( Stringf( "Seconds spent Gurobiing: %llu\n", TimeUtils::timePassed( gurobiStart, gurobiEnd ) / 1000000 ).ascii() );
+    LPFormulator_LOG( Stringf( "Seconds spent in the LP solver: %llu\n", TimeUtils::timePassed( solverStart, solverEnd ) / 1000000 ).ascii() );
 
     clearSolverQueue( freeSolvers );
 
@@ -386,7 +403,7 @@ void LPFormulator::optimizeBoundsOfNeuronsWithLpRlaxation( ThreadArgument &args
     unsigned targetIndex = args._targetIndex;
     unsigned lastIndexOfRelaxation = args._lastIndexOfRelaxation;
 
-    const Map<GurobiWrapper *, unsigned> solverToIndex = *args._solverToIndex;
+    const Map<ILPSolver *, unsigned> solverToIndex = *args._solverToIndex;
     SolverQueue &freeSolvers = args._freeSolvers;
     std::mutex &mtx = args._mtx;
     std::atomic_bool &infeasible = args._infeasible;
@@ -401,8 +418,9 @@ void LPFormulator::optimizeBoundsOfNeuronsWithLpRlaxation( ThreadArgument &args
     bool skipTightenLb = false; // If true, skip lower bound tightening
     bool skipTightenUb = false; // If true, skip upper bound tightening
 
-    // declare simulations as local var to avoid a problem which can happen due to multi thread process.
-    const Vector<Vector<double>> *simulations = _layerOwner->getLayer( targetIndex )->getSimulations();
+    // declare the simulated layer as local var to avoid a problem which can happen due to multi thread process.
+    const Layer *simulatedLayer = _layerOwner->getLayer( targetIndex );
+    unsigned numberOfSimulations = simulatedLayer->getNumberOfSimulations();
 
     for ( unsigned i = 0; i < layer->getSize(); ++i )
     {
@@ -419,8 +437,10 @@ void LPFormulator::optimizeBoundsOfNeuronsWithLpRlaxation( ThreadArgument &args
         skipTightenUb = false;
 
         // Loop for simulation
-        for ( const auto &simValue : (*simulations).get( i ) )
+        const double *simulations = simulatedLayer->getSimulations( i );
+        for ( unsigned j = 0; j < numberOfSimulations; ++j )
         {
+            double simValue = simulations[j];
             if ( _cutoffInUse && _cutoffValue < simValue ) // If x_lower < 0 < x_sim, do not try to call tightning upper bound.
                 skipTightenUb = true;
 
@@ -462,14 +482,21 @@ void LPFormulator::optimizeBoundsOfNeuronsWithLpRlaxation( ThreadArgument &args
         }
 
         // Wait until there is an idle solver
-        GurobiWrapper *freeSolver;
+        ILPSolver *freeSolver;
         while ( !freeSolvers.pop( freeSolver ) )
             boost::this_thread::sleep_for( waitTime );
 
-        freeSolver->resetModel();
+        if ( !_reuseModels )
+            freeSolver->resetModel();
 
         mtx.lock();
-        createLPRelaxation( layers, *freeSolver, lastIndexOfRelaxation );
+        if ( _reuseModels )
+            prepareReusedModel( layers, *freeSolver, lastIndexOfRelaxation );
+        else
+        {
+            createLPRelaxation( layers, *freeSolver, lastIndexOfRelaxation );
+            ++_numberOfModelBuilds;
+        }
         mtx.unlock();
 
         // spawn a thread to tighten the bounds for the current variable
@@ -483,6 +510,8 @@ void LPFormulator::optimizeBoundsOfNeuronsWithLpRlaxation( ThreadArgument &args
                                     std::ref( cutoffs ),
                                     skipTightenLb,
                                     skipTightenUb );
+        if ( _reuseModels )
+            argument._tighteningLog = &_tighteningLog;
 
         if ( numberOfWorkers == 1 )
             tightenSingleVariableBoundsWithLPRelaxation( argument );
@@ -497,7 +526,7 @@ void LPFormulator::tightenSingleVariableBoundsWithLPRelaxation( ThreadArgument &
 {
     try
     {
-        GurobiWrapper *gurobi = argument._gurobi;
+        ILPSolver *solver = argument._solver;
         Layer *layer = argument._layer;
         unsigned index = argument._index;
         double currentLb = argument._currentLb;
@@ -513,17 +542,17 @@ void LPFormulator::tightenSingleVariableBoundsWithLPRelaxation( ThreadArgument &
         std::atomic_uint &cutoffs = argument._cutoffs;
         bool skipTightenLb = argument._skipTightenLb;
         bool skipTightenUb = argument._skipTightenUb;
+        Vector<Tightening> *tighteningLog = argument._tighteningLog;
 
         LPFormulator_LOG( Stringf( "Tightening bounds for layer %u index %u",
                                    layer->getLayerIndex(), index ).ascii() );
 
         unsigned variable = layer->neuronToVariable( index );
-        Stringf variableName( "x%u", variable );
 
         if ( !skipTightenUb )
         {
             LPFormulator_LOG( Stringf( "Computing upperbound..." ).ascii() );
-            double ub = optimizeWithGurobi( *gurobi, MinOrMax::MAX, variableName,
+            double ub = optimizeWithSolver( *solver, MinOrMax::MAX, variable,
                                             cutoffValue, &infeasible );
             LPFormulator_LOG( Stringf( "Upperbound computed %f", ub ).ascii() );
 
@@ -539,6 +568,8 @@ void LPFormulator::tightenSingleVariableBoundsWithLPRelaxation( ThreadArgument &
                 layerOwner->receiveTighterBound( Tightening( variable,
                                                             ub,
                                                             Tightening::UB ) );
+                if ( tighteningLog )
+                    tighteningLog->append( Tightening( variable, ub, Tightening::UB ) );
                 mtx.unlock();
 
                 ++tighterBoundCounter;
@@ -546,7 +577,7 @@ void LPFormulator::tightenSingleVariableBoundsWithLPRelaxation( ThreadArgument &
                 if ( cutoffInUse && ub < cutoffValue )
                 {
                     ++cutoffs;
-                    enqueueSolver( freeSolvers, gurobi );
+                    enqueueSolver( freeSolvers, solver );
                     return;
                 }
             }
@@ -555,8 +586,10 @@ void LPFormulator::tightenSingleVariableBoundsWithLPRelaxation( ThreadArgument &
         if ( !skipTightenLb )
         {
             LPFormulator_LOG( Stringf( "Computing lowerbound..." ).ascii() );
-            gurobi->reset();
-            double lb = optimizeWithGurobi( *gurobi, MinOrMax::MIN, variableName,
+            // A reused model keeps the previous basis, to warm-start from
+            if ( !tighteningLog )
+                solver->reset();
+            double lb = optimizeWithSolver( *solver, MinOrMax::MIN, variable,
                                             cutoffValue, &infeasible );
             LPFormulator_LOG( Stringf( "Lowerbound computed: %f", lb ).ascii() );
             // Store the new bound if it is tighter
@@ -571,6 +604,8 @@ void LPFormulator::tightenSingleVariableBoundsWithLPRelaxation( ThreadArgument &
                 layerOwner->receiveTighterBound( Tightening( variable,
                                                             lb,
                                                             Tightening::LB ) );
+                if ( tighteningLog )
+                    tighteningLog->append( Tightening( variable, lb, Tightening::LB ) );
                 mtx.unlock();
                 ++tighterBoundCounter;
 
@@ -578,16 +613,16 @@ void LPFormulator::tightenSingleVariableBoundsWithLPRelaxation( ThreadArgument &
                     ++cutoffs;
             }
         }
-        enqueueSolver( freeSolvers, gurobi );
+        enqueueSolver( freeSolvers, solver );
     }
     catch ( boost::thread_interrupted& )
     {
-        enqueueSolver( argument._freeSolvers, argument._gurobi );
+        enqueueSolver( argument._freeSolvers, argument._solver );
     }
 }
 
 void LPFormulator::createLPRelaxation( const Map<unsigned, Layer *> &layers,
-                                       GurobiWrapper &gurobi,
+                                       ILPSolver &solver,
                                        unsigned lastLayer )
 {
     for ( const auto &layer : layers )
@@ -595,32 +630,73 @@ void LPFormulator::createLPRelaxation( const Map<unsigned, Layer *> &layers,
         if ( layer.second->getLayerIndex() > lastLayer )
             continue;
 
-        addLayerToModel( gurobi, layer.second );
+        addLayerToModel( solver, layer.second );
+    }
+}
+
+void LPFormulator::prepareReusedModel( const Map<unsigned, Layer *> &layers,
+                                       ILPSolver &solver,
+                                       unsigned lastLayer )
+{
+    if ( !_solverModels.exists( &solver ) ||
+         _solverModels[&solver]._lastLayer != lastLayer )
+    {
+        // A new layer prefix: the relaxation is built from the current
+        // bounds, which already reflect the whole tightening log
+        solver.resetModel();
+        createLPRelaxation( layers, solver, lastLayer );
+        ++_numberOfModelBuilds;
+        _solverModels[&solver] = SolverModel( lastLayer, _tighteningLog.size() );
+        return;
+    }
+
+    // Same prefix: only apply the bounds discovered since the model was
+    // last used
+    SolverModel &model = _solverModels[&solver];
+    for ( unsigned i = model._appliedTightenings; i < _tighteningLog.size(); ++i )
+    {
+        const Tightening &tightening = _tighteningLog[i];
+        if ( tightening._type == Tightening::UB )
+        {
+            if ( tightening._value < solver.getUpperBound( tightening._variable ) )
+                solver.setUpperBound( tightening._variable, tightening._value );
+        }
+        else
+        {
+            if ( tightening._value > solver.getLowerBound( tightening._variable ) )
+                solver.setLowerBound( tightening._variable, tightening._value );
+        }
     }
+    model._appliedTightenings = _tighteningLog.size();
 }
 
-void LPFormulator::addLayerToModel( GurobiWrapper &gurobi, const Layer *layer )
+unsigned LPFormulator::getNumberOfModelBuilds() const
+{
+    return _numberOfModelBuilds;
+}
+
+void LPFormulator::addLayerToModel( ILPSolver &solver, const Layer *layer )
 {
     switch ( layer->getLayerType() )
     {
     case Layer::INPUT:
-        addInputLayerToLpRelaxation( gurobi, layer );
+        addInputLayerToLpRelaxation( solver, layer );
         break;
 
     case Layer::RELU:
-        addReluLayerToLpRelaxation( gurobi, layer );
+        addReluLayerToLpRelaxation( solver, layer );
         break;
 
     case Layer::WEIGHTED_SUM:
-        addWeightedSumLayerToLpRelaxation( gurobi, layer );
+        addWeightedSumLayerToLpRelaxation( solver, layer );
         break;
 
     case Layer::SIGN:
-        addSignLayerToLpRelaxation( gurobi, layer );
+        addSignLayerToLpRelaxation( solver, layer );
         break;
 
     case Layer::MAX:
-        addMaxLayerToLpRelaxation( gurobi, layer );
+        addMaxLayerToLpRelaxation( solver, layer );
         break;
 
     default:
@@ -629,19 +705,19 @@ void LPFormulator::addLayerToModel( GurobiWrapper &gurobi, const Layer *layer )
     }
 }
 
-void LPFormulator::addInputLayerToLpRelaxation( GurobiWrapper &gurobi,
+void LPFormulator::addInputLayerToLpRelaxation( ILPSolver &solver,
                                                 const Layer *layer )
 {
     for ( unsigned i = 0; i < layer->getSize(); ++i )
     {
         unsigned variable = layer->neuronToVariable( i );
-        gurobi.addVariable( Stringf( "x%u", variable ),
+        solver.addVariable( variable,
                             layer->getLb( i ),
                             layer->getUb( i ) );
     }
 }
 
-void LPFormulator::addReluLayerToLpRelaxation( GurobiWrapper &gurobi,
+void LPFormulator::addReluLayerToLpRelaxation( ILPSolver &solver,
                                                const Layer *layer )
 {
     for ( unsigned i = 0; i < layer->getSize(); ++i )
@@ -660,7 +736,7 @@ void LPFormulator::addReluLayerToLpRelaxation( GurobiWrapper &gurobi,
                 double sourceValue = sourceLayer->getEliminatedNeuronValue( sourceNeuron );
                 double targetValue = sourceValue > 0 ? sourceValue : 0;
 
-                gurobi.addVariable( Stringf( "x%u", targetVariable ),
+                solver.addVariable( targetVariable,
                                     targetValue,
                                     targetValue );
 
@@ -671,7 +747,7 @@ void LPFormulator::addReluLayerToLpRelaxation( GurobiWrapper &gurobi,
             double sourceLb = sourceLayer->getLb( sourceNeuron );
             double sourceUb = sourceLayer->getUb( sourceNeuron );
 
-            gurobi.addVariable( Stringf( "x%u", targetVariable ),
+            solver.addVariable( targetVariable,
                                 0,
                                 layer->getUb( i ) );
 
@@ -681,17 +757,17 @@ void LPFormulator::addReluLayerToLpRelaxation( GurobiWrapper &gurobi,
                 if ( sourceLb < 0 )
                     sourceLb = 0;
 
-                List<GurobiWrapper::Term> terms;
-                terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-                terms.append( GurobiWrapper::Term( -1, Stringf( "x%u", sourceVariable ) ) );
-                gurobi.addEqConstraint( terms, 0 );
+                List<ILPSolver::Term> terms;
+                terms.append( ILPSolver::Term( 1, targetVariable ) );
+                terms.append( ILPSolver::Term( -1, sourceVariable ) );
+                solver.addEqConstraint( terms, 0 );
             }
             else if ( !FloatUtils::isPositive( sourceUb ) )
             {
                 // The ReLU is inactive, y = 0
-                List<GurobiWrapper::Term> terms;
-                terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-                gurobi.addEqConstraint( terms, 0 );
+                List<ILPSolver::Term> terms;
+                terms.append( ILPSolver::Term( 1, targetVariable ) );
+                solver.addEqConstraint( terms, 0 );
             }
             else
             {
@@ -706,15 +782,15 @@ void LPFormulator::addReluLayerToLpRelaxation( GurobiWrapper &gurobi,
                 */
 
                 // y >= 0
-                List<GurobiWrapper::Term> terms;
-                terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-                gurobi.addGeqConstraint( terms, 0 );
+                List<ILPSolver::Term> terms;
+                terms.append( ILPSolver::Term( 1, targetVariable ) );
+                solver.addGeqConstraint( terms, 0 );
 
                 // y >= x, i.e. y - x >= 0
                 terms.clear();
-                terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-                terms.append( GurobiWrapper::Term( -1, Stringf( "x%u", sourceVariable ) ) );
-                gurobi.addGeqConstraint( terms, 0 );
+                terms.append( ILPSolver::Term( 1, targetVariable ) );
+                terms.append( ILPSolver::Term( -1, sourceVariable ) );
+                solver.addGeqConstraint( terms, 0 );
 
                 /*
                          u        ul
@@ -722,15 +798,15 @@ void LPFormulator::addReluLayerToLpRelaxation( GurobiWrapper &gurobi,
                        u - l     u - l
                 */
                 terms.clear();
-                terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-                terms.append( GurobiWrapper::Term( -sourceUb / ( sourceUb - sourceLb ), Stringf( "x%u", sourceVariable ) ) );
-                gurobi.addLeqConstraint( terms, ( -sourceUb * sourceLb ) / ( sourceUb - sourceLb ) );
+                terms.append( ILPSolver::Term( 1, targetVariable ) );
+                terms.append( ILPSolver::Term( -sourceUb / ( sourceUb - sourceLb ), sourceVariable ) );
+                solver.addLeqConstraint( terms, ( -sourceUb * sourceLb ) / ( sourceUb - sourceLb ) );
             }
         }
     }
 }
 
-void LPFormulator::addSignLayerToLpRelaxation( GurobiWrapper &gurobi,
+void LPFormulator::addSignLayerToLpRelaxation( ILPSolver &solver,
                                                const Layer *layer )
 {
     for ( unsigned i = 0; i < layer->getSize(); ++i )
@@ -750,7 +826,7 @@ void LPFormulator::addSignLayerToLpRelaxation( GurobiWrapper &gurobi,
             double sourceValue = sourceLayer->getEliminatedNeuronValue( sourceNeuron );
             double targetValue = FloatUtils::isNegative( sourceValue ) ? -1 : 1;
 
-            gurobi.addVariable( Stringf( "x%u", targetVariable ),
+            solver.addVariable( targetVariable,
                                 targetValue,
                                 targetValue );
 
@@ -764,12 +840,12 @@ void LPFormulator::addSignLayerToLpRelaxation( GurobiWrapper &gurobi,
         if ( !FloatUtils::isNegative( sourceLb ) )
         {
             // The Sign is positive, y = 1
-            gurobi.addVariable( Stringf( "x%u", targetVariable ), 1, 1 );
+            solver.addVariable( targetVariable, 1, 1 );
         }
         else if ( FloatUtils::isNegative( sourceUb ) )
         {
             // The Sign is negative, y = -1
-            gurobi.addVariable( Stringf( "x%u", targetVariable ), -1, -1 );
+            solver.addVariable( targetVariable, -1, -1 );
         }
         else
         {
@@ -785,17 +861,17 @@ void LPFormulator::addSignLayerToLpRelaxation( GurobiWrapper &gurobi,
             */
 
             // -1 <= y <= 1
-            gurobi.addVariable( Stringf( "x%u", targetVariable ), -1, 1 );
+            solver.addVariable( targetVariable, -1, 1 );
 
             /*
                      2
               y <= ----- x + 1
                     - l
             */
-            List<GurobiWrapper::Term> terms;
-            terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-            terms.append( GurobiWrapper::Term( 2.0 / sourceLb, Stringf( "x%u", sourceVariable ) ) );
-            gurobi.addLeqConstraint( terms, 1 );
+            List<ILPSolver::Term> terms;
+            terms.append( ILPSolver::Term( 1, targetVariable ) );
+            terms.append( ILPSolver::Term( 2.0 / sourceLb, sourceVariable ) );
+            solver.addLeqConstraint( terms, 1 );
 
             /*
                      2
@@ -803,14 +879,14 @@ void LPFormulator::addSignLayerToLpRelaxation( GurobiWrapper &gurobi,
                      u
             */
             terms.clear();
-            terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-            terms.append( GurobiWrapper::Term( -2.0 / sourceUb, Stringf( "x%u", sourceVariable ) ) );
-            gurobi.addGeqConstraint( terms, -1 );
+            terms.append( ILPSolver::Term( 1, targetVariable ) );
+            terms.append( ILPSolver::Term( -2.0 / sourceUb, sourceVariable ) );
+            solver.addGeqConstraint( terms, -1 );
         }
     }
 }
 
-void LPFormulator::addMaxLayerToLpRelaxation( GurobiWrapper &gurobi,
+void LPFormulator::addMaxLayerToLpRelaxation( ILPSolver &solver,
                                               const Layer *layer )
 {
     for ( unsigned i = 0; i < layer->getSize(); ++i )
@@ -819,7 +895,7 @@ void LPFormulator::addMaxLayerToLpRelaxation( GurobiWrapper &gurobi,
             continue;
 
         unsigned targetVariable = layer->neuronToVariable( i );
-        gurobi.addVariable( Stringf( "x%u", targetVariable ), layer->getLb( i ), layer->getUb( i ) );
+        solver.addVariable( targetVariable, layer->getLb( i ), layer->getUb( i ) );
 
         List<NeuronIndex> sources = layer->getActivationSources( i );
 
@@ -828,7 +904,7 @@ void LPFormulator::addMaxLayerToLpRelaxation( GurobiWrapper &gurobi,
 
         double maxConcreteUb = FloatUtils::negativeInfinity();
 
-        List<GurobiWrapper::Term> terms;
+        List<ILPSolver::Term> terms;
 
         for ( const auto &source : sources )
         {
@@ -848,9 +924,9 @@ void LPFormulator::addMaxLayerToLpRelaxation( GurobiWrapper &gurobi,
 
             // Target is at least source: target - source >= 0
             terms.clear();
-            terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-            terms.append( GurobiWrapper::Term( -1, Stringf( "x%u", sourceVariable ) ) );
-            gurobi.addGeqConstraint( terms, 0 );
+            terms.append( ILPSolver::Term( 1, targetVariable ) );
+            terms.append( ILPSolver::Term( -1, sourceVariable ) );
+            solver.addGeqConstraint( terms, 0 );
 
             // Find maximal concrete upper bound
             double sourceUb = sourceLayer->getUb( sourceNeuron );
@@ -863,8 +939,8 @@ void LPFormulator::addMaxLayerToLpRelaxation( GurobiWrapper &gurobi,
             // At least one of the sources has a fixed value,
             // and this fixed value dominates other sources.
             terms.clear();
-            terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-            gurobi.addEqConstraint( terms, maxFixedSourceValue );
+            terms.append( ILPSolver::Term( 1, targetVariable ) );
+            solver.addEqConstraint( terms, maxFixedSourceValue );
         }
         else
         {
@@ -872,58 +948,62 @@ void LPFormulator::addMaxLayerToLpRelaxation( GurobiWrapper &gurobi,
             if ( haveFixedSourceValue )
             {
                 terms.clear();
-                terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-                gurobi.addGeqConstraint( terms, maxFixedSourceValue );
+                terms.append( ILPSolver::Term( 1, targetVariable ) );
+                solver.addGeqConstraint( terms, maxFixedSourceValue );
             }
 
             // Target must be smaller than greatest concrete upper bound
             terms.clear();
-            terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-            gurobi.addLeqConstraint( terms, maxConcreteUb );
+            terms.append( ILPSolver::Term( 1, targetVariable ) );
+            solver.addLeqConstraint( terms, maxConcreteUb );
         }
     }
 }
 
-void LPFormulator::addWeightedSumLayerToLpRelaxation( GurobiWrapper &gurobi, const Layer *layer )
+void LPFormulator::addWeightedSumLayerToLpRelaxation( ILPSolver &solver, const Layer *layer )
 {
-    for ( unsigned i = 0; i < layer->getSize(); ++i )
+    unsigned size = layer->getSize();
+    Vector<List<ILPSolver::Term>> terms( size );
+    Vector<double> biases( size );
+
+    for ( unsigned i = 0; i < size; ++i )
     {
         if ( !layer->neuronEliminated( i ) )
         {
             unsigned variable = layer->neuronToVariable( i );
 
-            gurobi.addVariable( Stringf( "x%u", variable ),
+            solver.addVariable( variable,
                                 layer->getLb( i ),
                                 layer->getUb( i ) );
 
-            List<GurobiWrapper::Term> terms;
-            terms.append( GurobiWrapper::Term( -1, Stringf( "x%u", variable ) ) );
+            terms[i].append( ILPSolver::Term( -1, variable ) );
+            biases[i] = -layer->getBias( i );
+        }
+    }
 
-            double bias = -layer->getBias( i );
+    // Only the non-zero weights are visited, so sparse layers contribute
+    // as many terms as they have non-zero weights
+    for ( const auto &sourceLayerPair : layer->getSourceLayers() )
+    {
+        const Layer *sourceLayer = _layerOwner->getLayer( sourceLayerPair.first );
 
-            for ( const auto &sourceLayerPair : layer->getSourceLayers() )
-            {
-                const Layer *sourceLayer = _layerOwner->getLayer( sourceLayerPair.first );
-                unsigned sourceLayerSize = sourceLayerPair.second;
+        layer->forEachWeight( sourceLayerPair.first,
+                              [&]( unsigned j, unsigned i, double weight )
+        {
+            if ( layer->neuronEliminated( i ) )
+                return;
 
-                for ( unsigned j = 0; j < sourceLayerSize; ++j )
-                {
-                    double weight = layer->getWeight( sourceLayerPair.first, j, i );
-                    if ( !sourceLayer->neuronEliminated( j ) )
-                    {
-                        Stringf sourceVariableName( "x%u",
-                                                    sourceLayer->neuronToVariable( j ) );
-                        terms.append( GurobiWrapper::Term( weight, sourceVariableName ) );
-                    }
-                    else
-                    {
-                        bias -= weight * sourceLayer->getEliminatedNeuronValue( j );
-                    }
-                }
-            }
+            if ( !sourceLayer->neuronEliminated( j ) )
+                terms[i].append( ILPSolver::Term( weight, sourceLayer->neuronToVariable( j ) ) );
+            else
+                biases[i] -= weight * sourceLayer->getEliminatedNeuronValue( j );
+        } );
+    }
 
-            gurobi.addEqConstraint( terms, bias );
-        }
+    for ( unsigned i = 0; i < size; ++i )
+    {
+        if ( !layer->neuronEliminated( i ) )
+            solver.addEqConstraint( terms[i], biases[i] );
     }
 }
 
@@ -16,10 +16,12 @@
 #ifndef __LPFormulator_h__
 #define __LPFormulator_h__
 
-#include "GurobiWrapper.h"
+#include "ILPSolver.h"
 #include "LayerOwner.h"
 #include "ParallelSolver.h"
 #include "Map.h"
+#include "Tightening.h"
+#include "Vector.h"
 #include <climits>
 
 #include <atomic>
@@ -48,10 +50,18 @@ public:
       if the LPFormulator is used in stand-alone mode. The process can
       also be performed incrementally, which means that the underlying
       LP model is adjusted from the previous call, instead of being
-      constructed from scratch
+      constructed from scratch.
+
+      With reuseModels, each solver builds the relaxation once per
+      layer prefix, and is then reused for the following neurons:
+      only the objective and the bounds tightened in the meantime
+      change, so that the solver warm-starts from its previous basis.
     */
-    void optimizeBoundsWithLpRelaxation( const Map<unsigned, Layer *> &layers );
-    void optimizeBoundsOfOneLayerWithLpRelaxation( const Map<unsigned, Layer *> &layers, unsigned targetIndex );
+    void optimizeBoundsWithLpRelaxation( const Map<unsigned, Layer *> &layers,
+                                         bool reuseModels = false );
+    void optimizeBoundsOfOneLayerWithLpRelaxation( const Map<unsigned, Layer *> &layers,
+                                                   unsigned targetIndex,
+                                                   bool reuseModels = false );
     void optimizeBoundsWithIncrementalLpRelaxation( const Map<unsigned, Layer *> &layers );
 
     /*
@@ -68,15 +78,22 @@ public:
       tightening
     */
     void createLPRelaxation( const Map<unsigned, Layer *> &layers,
-                             GurobiWrapper &gurobi,
+                             ILPSolver &solver,
                              unsigned lastLayer = UINT_MAX );
 
-    double solveLPRelaxation( GurobiWrapper &gurobi,
+    double solveLPRelaxation( ILPSolver &solver,
                               const Map<unsigned, Layer *> &layers,
-                              MinOrMax minOrMax, String variableName,
+                              MinOrMax minOrMax, unsigned variable,
                               unsigned lastLayer = UINT_MAX );
 
-    void addLayerToModel( GurobiWrapper &gurobi, const Layer *layer );
+    void addLayerToModel( ILPSolver &solver, const Layer *layer );
+
+    /*
+      The number of LP models built by the last call that optimized the
+      bounds of neurons. Without reuseModels, a model is built for every
+      neuron, otherwise once per solver and layer prefix.
+    */
+    unsigned getNumberOfModelBuilds() const;
 
 private:
 
@@ -84,29 +101,66 @@ private:
     bool _cutoffInUse;
     double _cutoffValue;
 
-    void addInputLayerToLpRelaxation( GurobiWrapper &gurobi,
+    /*
+      The models of the solvers, when reused across neurons: the last
+      layer each model encodes, and how many entries of the tightening
+      log have been applied to it.
+    */
+    struct SolverModel
+    {
+        SolverModel()
+            : _lastLayer( 0 )
+            , _appliedTightenings( 0 )
+        {
+        }
+
+        SolverModel( unsigned lastLayer, unsigned appliedTightenings )
+            : _lastLayer( lastLayer )
+            , _appliedTightenings( appliedTightenings )
+        {
+        }
+
+        unsigned _lastLayer;
+        unsigned _appliedTightenings;
+    };
+
+    bool _reuseModels;
+    unsigned _numberOfModelBuilds;
+    Vector<Tightening> _tighteningLog;
+    Map<ILPSolver *, SolverModel> _solverModels;
+
+    /*
+      Get a reused solver ready for the next neuron: build its model if
+      it encodes a different layer prefix, or otherwise bring its
+      bounds up to date.
+    */
+    void prepareReusedModel( const Map<unsigned, Layer *> &layers,
+                             ILPSolver &solver,
+                             unsigned lastLayer );
+
+    void addInputLayerToLpRelaxation( ILPSolver &solver,
                                       const Layer *layer );
 
-    void addReluLayerToLpRelaxation( GurobiWrapper &gurobi,
+    void addReluLayerToLpRelaxation( ILPSolver &solver,
                                      const Layer *layer );
 
-    void addSignLayerToLpRelaxation( GurobiWrapper &gurobi,
+    void addSignLayerToLpRelaxation( ILPSolver &solver,
                                      const Layer *layer );
 
-    void addMaxLayerToLpRelaxation( GurobiWrapper &gurobi,
+    void addMaxLayerToLpRelaxation( ILPSolver &solver,
                                      const Layer *layer );
 
-    void addWeightedSumLayerToLpRelaxation( GurobiWrapper &gurobi,
+    void addWeightedSumLayerToLpRelaxation( ILPSolver &solver,
                                             const Layer *layer );
 
     void optimizeBoundsOfNeuronsWithLpRlaxation( ThreadArgument &args );
 
     /*
-      Optimize for the min/max value of variableName with respect to the constraints
-      encoded in gurobi. If the query is infeasible, *infeasible is set to true.
+      Optimize for the min/max value of variable with respect to the constraints
+      encoded in the solver. If the query is infeasible, *infeasible is set to true.
     */
-    static double optimizeWithGurobi( GurobiWrapper &gurobi, MinOrMax minOrMax,
-                                      String variableName, double cutoffValue,
+    static double optimizeWithSolver( ILPSolver &solver, MinOrMax minOrMax,
+                                      unsigned variable, double cutoffValue,
                                       std::atomic_bool *infeasible = NULL );
 
     /*
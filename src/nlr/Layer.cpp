@@ -15,6 +15,8 @@
 
 #include "InputQuery.h"
 #include "Layer.h"
+#include "MStringf.h"
+#include "NLRError.h"
 #include "Options.h"
 #include "SymbolicBoundTighteningType.h"
 
@@ -35,8 +37,10 @@ Layer::Layer( unsigned index, Type type, unsigned size, LayerOwner *layerOwner )
     , _type( type )
     , _size( size )
     , _layerOwner( layerOwner )
-    , _bias( NULL )
+    , _parameters( std::make_shared<Parameters>() )
     , _assignment( NULL )
+    , _numberOfSimulations( 0 )
+    , _simulations( NULL )
     , _lb( NULL )
     , _ub( NULL )
     , _inputLayerSize( 0 )
@@ -54,10 +58,10 @@ Layer::Layer( unsigned index, Type type, unsigned size, LayerOwner *layerOwner )
 
 void Layer::allocateMemory()
 {
-    if ( _type == WEIGHTED_SUM )
+    if ( _type == WEIGHTED_SUM && !_parameters->_bias )
     {
-        _bias = new double[_size];
-        std::fill_n( _bias, _size, 0 );
+        _parameters->_bias = new double[_size];
+        std::fill_n( _parameters->_bias, _size, 0 );
     }
 
     _lb = new double[_size];
@@ -68,7 +72,9 @@ void Layer::allocateMemory()
 
     _assignment = new double[_size];
 
-    _simulations.assign( _size, Vector<double>( Options::get()->getInt( Options::NUMBER_OF_SIMULATIONS ) ) );
+    _numberOfSimulations = Options::get()->getInt( Options::NUMBER_OF_SIMULATIONS );
+    _simulations = new double[_size * _numberOfSimulations];
+    std::fill_n( _simulations, _size * _numberOfSimulations, 0 );
 
     _inputLayerSize = ( _type == INPUT ) ? _size : _layerOwner->getLayer( 0 )->getSize();
     if ( Options::get()->getSymbolicBoundTighteningType() ==
@@ -116,12 +122,37 @@ double Layer::getAssignment( unsigned neuron ) const
 
 void Layer::setSimulations( const Vector<Vector<double>> *values )
 {
-    _simulations = *values;
+    // The simulation matrix was sized when the layer was allocated
+    if ( values->size() != _size )
+        throw NLRError( NLRError::SIMULATION_SIZE_MISMATCH,
+                        Stringf( "Expected simulations for %u neurons, got %u",
+                                 _size, values->size() ).ascii() );
+
+    for ( unsigned i = 0; i < _size; ++i )
+    {
+        if ( values->get( i ).size() != _numberOfSimulations )
+            throw NLRError( NLRError::SIMULATION_SIZE_MISMATCH,
+                            Stringf( "Expected %u simulations for neuron %u, got %u",
+                                     _numberOfSimulations, i, values->get( i ).size() ).ascii() );
+
+        memcpy( _simulations + i * _numberOfSimulations, values->get( i ).data(),
+                sizeof(double) * _numberOfSimulations );
+    }
+}
+
+const double *Layer::getSimulations() const
+{
+    return _simulations;
+}
+
+const double *Layer::getSimulations( unsigned neuron ) const
+{
+    return _simulations + neuron * _numberOfSimulations;
 }
 
-const Vector<Vector<double>> *Layer::getSimulations() const
+unsigned Layer::getNumberOfSimulations() const
 {
-    return &_simulations;
+    return _numberOfSimulations;
 }
 
 void Layer::computeAssignment()
@@ -131,7 +162,7 @@ void Layer::computeAssignment()
     if ( _type == WEIGHTED_SUM )
     {
         // Initialize to bias
-        memcpy( _assignment, _bias, sizeof(double) * _size );
+        memcpy( _assignment, _parameters->_bias, sizeof(double) * _size );
 
         // Process each of the source layers
         for ( auto &sourceLayerEntry : _sourceLayers )
@@ -139,8 +170,21 @@ void Layer::computeAssignment()
             const Layer *sourceLayer = _layerOwner->getLayer( sourceLayerEntry.first );
             const double *sourceAssignment = sourceLayer->getAssignment();
             unsigned sourceSize = sourceLayerEntry.second;
-            const double *weights = _layerToWeights[sourceLayerEntry.first];
 
+            if ( hasSparseWeights( sourceLayerEntry.first ) )
+            {
+                const SparseWeightMatrix *weights = getSparseWeights( sourceLayerEntry.first );
+                const unsigned *rowStart = weights->getRowStart();
+                const unsigned *columns = weights->getColumnIndices();
+                const double *values = weights->getValues();
+
+                for ( unsigned i = 0; i < sourceSize; ++i )
+                    for ( unsigned k = rowStart[i]; k < rowStart[i + 1]; ++k )
+                        _assignment[columns[k]] += ( sourceAssignment[i] * values[k] );
+                continue;
+            }
+
+            const double *weights = _parameters->_layerToWeights[sourceLayerEntry.first];
             for ( unsigned i = 0; i < sourceSize; ++i )
                 for ( unsigned j = 0; j < _size; ++j )
                     _assignment[j] += ( sourceAssignment[i] * weights[i * _size + j] );
@@ -223,38 +267,62 @@ void Layer::computeSimulations()
 {
     ASSERT( _type != INPUT );
 
-    unsigned simulationSize = Options::get()->getInt( Options::NUMBER_OF_SIMULATIONS );
+    // All the kernels below work on whole rows of the simulation matrices,
+    // i.e. on all the simulations of one neuron at a time
+    const unsigned numberOfSimulations = _numberOfSimulations;
+
     if ( _type == WEIGHTED_SUM )
     {
-        // Process each of the source layers
+        // Initialize to bias
+        for ( unsigned i = 0; i < _size; ++i )
+            std::fill_n( _simulations + i * numberOfSimulations, numberOfSimulations, _parameters->_bias[i] );
+
+        // Process each of the source layers: the weight matrix is stored
+        // as (sourceSize x size), so this adds W^T * sourceSimulations
         for ( auto &sourceLayerEntry : _sourceLayers )
         {
             const Layer *sourceLayer = _layerOwner->getLayer( sourceLayerEntry.first );
-            const Vector<Vector<double>> *sourceSimulations = sourceLayer->getSimulations();
+            ASSERT( sourceLayer->getNumberOfSimulations() == numberOfSimulations );
 
             unsigned sourceSize = sourceLayerEntry.second;
-            const double *weights = _layerToWeights[sourceLayerEntry.first];
 
-            for ( unsigned i = 0; i < _size; i++ )
+            if ( hasSparseWeights( sourceLayerEntry.first ) )
             {
-                for ( unsigned j = 0; j < simulationSize; ++j )
-                    _simulations[i][j] = _bias[i];
+                // Add each source row, scaled by its non-zero weights, to
+                // the rows of the target neurons
+                const SparseWeightMatrix *weights = getSparseWeights( sourceLayerEntry.first );
+                const unsigned *rowStart = weights->getRowStart();
+                const unsigned *columns = weights->getColumnIndices();
+                const double *values = weights->getValues();
+
+                for ( unsigned i = 0; i < sourceSize; ++i )
+                {
+                    const double *source = sourceLayer->getSimulations( i );
+                    for ( unsigned k = rowStart[i]; k < rowStart[i + 1]; ++k )
+                    {
+                        double *target = _simulations + columns[k] * numberOfSimulations;
+                        for ( unsigned j = 0; j < numberOfSimulations; ++j )
+                            target[j] += values[k] * source[j];
+                    }
+                }
+                continue;
             }
 
-            for ( unsigned i = 0; i < sourceSize; ++i )
-                for ( unsigned j = 0; j < simulationSize; ++j )
-                    for ( unsigned k = 0; k < _size; ++k )
-                        _simulations[k][j] += ( ( *sourceSimulations ).get( i ).get( j ) * weights[i * _size + k] );
+            const double *weights = _parameters->_layerToWeights[sourceLayerEntry.first];
+            matrixMultiplicationTransposedA( weights, sourceLayer->getSimulations(),
+                                             _simulations, sourceSize, _size,
+                                             numberOfSimulations );
         }
-    } 
+    }
     else if ( _type == RELU )
     {
         for ( unsigned i = 0; i < _size; ++i )
         {
-            NeuronIndex sourceIndex = *_neuronToActivationSources[i].begin();            
-            const Vector<double> &simulations = ( *( _layerOwner->getLayer( sourceIndex._layer )->getSimulations() ) ).get( sourceIndex._neuron );
-            for ( unsigned j = 0; j < simulationSize; ++j )
-                _simulations[i][j] = FloatUtils::max( simulations.get( j ), 0 );
+            NeuronIndex sourceIndex = *_neuronToActivationSources[i].begin();
+            const double *source = _layerOwner->getLayer( sourceIndex._layer )->getSimulations( sourceIndex._neuron );
+            double *target = _simulations + i * numberOfSimulations;
+            for ( unsigned j = 0; j < numberOfSimulations; ++j )
+                target[j] = FloatUtils::max( source[j], 0 );
         }
     }
     else if ( _type == ABSOLUTE_VALUE )
@@ -262,26 +330,24 @@ void Layer::computeSimulations()
         for ( unsigned i = 0; i < _size; ++i )
         {
             NeuronIndex sourceIndex = *_neuronToActivationSources[i].begin();
-            const Vector<double> &simulations = ( *( _layerOwner->getLayer( sourceIndex._layer )->getSimulations() ) ).get( sourceIndex._neuron );
-            for ( unsigned j = 0; j < simulationSize; ++j ) 
-                _simulations[i][j] = FloatUtils::abs( simulations.get( j ) );
+            const double *source = _layerOwner->getLayer( sourceIndex._layer )->getSimulations( sourceIndex._neuron );
+            double *target = _simulations + i * numberOfSimulations;
+            for ( unsigned j = 0; j < numberOfSimulations; ++j )
+                target[j] = std::fabs( source[j] );
         }
     }
     else if ( _type == MAX )
     {
         for ( unsigned i = 0; i < _size; ++i )
         {
-            for ( unsigned j = 0; j < simulationSize; ++j )
-            {
-                _simulations[i][j] = FloatUtils::negativeInfinity();
+            double *target = _simulations + i * numberOfSimulations;
+            std::fill_n( target, numberOfSimulations, FloatUtils::negativeInfinity() );
 
-                for ( const auto &input : _neuronToActivationSources[i] )
-                {
-                    //double value = ( *( _layerOwner->getLayer( input._layer )->getSimulations() ) )[input._neuron][j];
-                    double value = ( *( _layerOwner->getLayer( input._layer )->getSimulations() ) ).get( input._neuron ).get( j );
-                    if ( value > _simulations[i][j] )
-                        _simulations[i][j] = value;
-                }
+            for ( const auto &input : _neuronToActivationSources[i] )
+            {
+                const double *source = _layerOwner->getLayer( input._layer )->getSimulations( input._neuron );
+                for ( unsigned j = 0; j < numberOfSimulations; ++j )
+                    target[j] = source[j] > target[j] ? source[j] : target[j];
             }
         }
     }
@@ -290,9 +356,10 @@ void Layer::computeSimulations()
         for ( unsigned i = 0; i < _size; ++i )
         {
             NeuronIndex sourceIndex = *_neuronToActivationSources[i].begin();
-            const Vector<double> &simulations = ( *( _layerOwner->getLayer( sourceIndex._layer )->getSimulations() ) ).get( i );
-            for ( unsigned j = 0; j < simulationSize; ++j )
-                _simulations[i][j] = FloatUtils::isNegative( simulations.get( j ) ) ? -1 : 1;
+            const double *source = _layerOwner->getLayer( sourceIndex._layer )->getSimulations( sourceIndex._neuron );
+            double *target = _simulations + i * numberOfSimulations;
+            for ( unsigned j = 0; j < numberOfSimulations; ++j )
+                target[j] = FloatUtils::isNegative( source[j] ) ? -1 : 1;
         }
     }
     else if ( _type == SIGMOID )
@@ -300,9 +367,10 @@ void Layer::computeSimulations()
         for ( unsigned i = 0; i < _size; ++i )
         {
             NeuronIndex sourceIndex = *_neuronToActivationSources[i].begin();
-            const Vector<double> &simulations = ( *( _layerOwner->getLayer( sourceIndex._layer )->getSimulations() ) ).get( i );
-            for ( unsigned j = 0; j < simulationSize; ++j )
-                _simulations[i][j] = 1 / ( 1 + std::exp( -simulations.get( j ) ) );
+            const double *source = _layerOwner->getLayer( sourceIndex._layer )->getSimulations( sourceIndex._neuron );
+            double *target = _simulations + i * numberOfSimulations;
+            for ( unsigned j = 0; j < numberOfSimulations; ++j )
+                target[j] = 1 / ( 1 + std::exp( -source[j] ) );
         }
     }
     else
@@ -315,10 +383,8 @@ void Layer::computeSimulations()
     // was computed due to left-over weights, etc, their set values
     // prevail.
     for ( const auto &eliminated : _eliminatedNeurons )
-    {
-        for ( unsigned j = 0; j < simulationSize; ++j )
-            _simulations[eliminated.first][j] = eliminated.second;
-    }
+        std::fill_n( _simulations + eliminated.first * numberOfSimulations,
+                     numberOfSimulations, eliminated.second );
 }
 
 void Layer::addSourceLayer( unsigned layerNumber, unsigned layerSize )
@@ -332,16 +398,30 @@ void Layer::addSourceLayer( unsigned layerNumber, unsigned layerSize )
 
     if ( _type == WEIGHTED_SUM )
     {
-        _layerToWeights[layerNumber] = new double[layerSize * _size];
-        _layerToPositiveWeights[layerNumber] = new double[layerSize * _size];
-        _layerToNegativeWeights[layerNumber] = new double[layerSize * _size];
-
-        std::fill_n( _layerToWeights[layerNumber], layerSize * _size, 0 );
-        std::fill_n( _layerToPositiveWeights[layerNumber], layerSize * _size, 0 );
-        std::fill_n( _layerToNegativeWeights[layerNumber], layerSize * _size, 0 );
+        makeParametersPrivate();
+        _parameters->_layerToWeights[layerNumber] = new double[layerSize * _size];
+        _parameters->_layerToPositiveWeights[layerNumber] = new double[layerSize * _size];
+        _parameters->_layerToNegativeWeights[layerNumber] = new double[layerSize * _size];
+
+        std::fill_n( _parameters->_layerToWeights[layerNumber], layerSize * _size, 0 );
+        std::fill_n( _parameters->_layerToPositiveWeights[layerNumber], layerSize * _size, 0 );
+        std::fill_n( _parameters->_layerToNegativeWeights[layerNumber], layerSize * _size, 0 );
     }
 }
 
+void Layer::addSourceLayer( unsigned layerNumber, unsigned layerSize, SparseWeightMatrix *weights )
+{
+    ASSERT( _type == WEIGHTED_SUM );
+    ASSERT( !_sourceLayers.exists( layerNumber ) );
+    ASSERT( weights->getNumberOfRows() == layerSize );
+    ASSERT( weights->getNumberOfColumns() == _size );
+
+    _sourceLayers[layerNumber] = layerSize;
+
+    makeParametersPrivate();
+    _parameters->_layerToSparseWeights[layerNumber] = weights;
+}
+
 const Map<unsigned, unsigned> &Layer::getSourceLayers() const
 {
     return _sourceLayers;
@@ -349,38 +429,54 @@ const Map<unsigned, unsigned> &Layer::getSourceLayers() const
 
 const double *Layer::getWeightMatrix( unsigned sourceLayer ) const
 {
-    ASSERT( _layerToWeights.exists( sourceLayer ) );
-    return _layerToWeights[sourceLayer];
+    ASSERT( !hasSparseWeights( sourceLayer ) );
+    ASSERT( _parameters->_layerToWeights.exists( sourceLayer ) );
+    return _parameters->_layerToWeights.at( sourceLayer );
 }
 
 void Layer::removeSourceLayer( unsigned sourceLayer )
 {
     ASSERT( _sourceLayers.exists( sourceLayer ) );
 
-    delete[] _layerToWeights[sourceLayer];
-    delete[] _layerToPositiveWeights[sourceLayer];
-    delete[] _layerToNegativeWeights[sourceLayer];
+    makeParametersPrivate();
+
+    if ( hasSparseWeights( sourceLayer ) )
+    {
+        delete _parameters->_layerToSparseWeights[sourceLayer];
+        _parameters->_layerToSparseWeights.erase( sourceLayer );
+        _sourceLayers.erase( sourceLayer );
+        return;
+    }
+
+    delete[] _parameters->_layerToWeights[sourceLayer];
+    delete[] _parameters->_layerToPositiveWeights[sourceLayer];
+    delete[] _parameters->_layerToNegativeWeights[sourceLayer];
 
     _sourceLayers.erase( sourceLayer );
-    _layerToWeights.erase( sourceLayer );
-    _layerToPositiveWeights.erase( sourceLayer );
-    _layerToNegativeWeights.erase( sourceLayer );
+    _parameters->_layerToWeights.erase( sourceLayer );
+    _parameters->_layerToPositiveWeights.erase( sourceLayer );
+    _parameters->_layerToNegativeWeights.erase( sourceLayer );
 }
 
 void Layer::setWeight( unsigned sourceLayer, unsigned sourceNeuron, unsigned targetNeuron, double weight )
 {
+    makeParametersPrivate();
+
+    if ( hasSparseWeights( sourceLayer ) )
+        decompressWeights( sourceLayer );
+
     unsigned index = sourceNeuron * _size + targetNeuron;
-    _layerToWeights[sourceLayer][index] = weight;
+    _parameters->_layerToWeights[sourceLayer][index] = weight;
 
     if ( weight > 0 )
     {
-        _layerToPositiveWeights[sourceLayer][index] = weight;
-        _layerToNegativeWeights[sourceLayer][index] = 0;
+        _parameters->_layerToPositiveWeights[sourceLayer][index] = weight;
+        _parameters->_layerToNegativeWeights[sourceLayer][index] = 0;
     }
     else
     {
-        _layerToPositiveWeights[sourceLayer][index] = 0;
-        _layerToNegativeWeights[sourceLayer][index] = weight;
+        _parameters->_layerToPositiveWeights[sourceLayer][index] = 0;
+        _parameters->_layerToNegativeWeights[sourceLayer][index] = weight;
     }
 }
 
@@ -388,38 +484,234 @@ double Layer::getWeight( unsigned sourceLayer,
                          unsigned sourceNeuron,
                          unsigned targetNeuron ) const
 {
+    if ( hasSparseWeights( sourceLayer ) )
+        return getSparseWeights( sourceLayer )->get( sourceNeuron, targetNeuron );
+
     unsigned index = sourceNeuron * _size + targetNeuron;
-    return _layerToWeights[sourceLayer][index];
+    return _parameters->_layerToWeights.at( sourceLayer )[index];
 }
 
-double *Layer::getWeights( unsigned sourceLayerIndex ) const
+const double *Layer::getWeights( unsigned sourceLayerIndex ) const
 {
-    return _layerToWeights[sourceLayerIndex];
+    ASSERT( !hasSparseWeights( sourceLayerIndex ) );
+    return _parameters->_layerToWeights.at( sourceLayerIndex );
 }
 
-double *Layer::getPositiveWeights( unsigned sourceLayerIndex ) const
+const double *Layer::getPositiveWeights( unsigned sourceLayerIndex ) const
 {
-    return _layerToPositiveWeights[sourceLayerIndex];
+    ASSERT( !hasSparseWeights( sourceLayerIndex ) );
+    return _parameters->_layerToPositiveWeights.at( sourceLayerIndex );
 }
 
-double *Layer::getNegativeWeights( unsigned sourceLayerIndex ) const
+const double *Layer::getNegativeWeights( unsigned sourceLayerIndex ) const
 {
-    return _layerToNegativeWeights[sourceLayerIndex];
+    ASSERT( !hasSparseWeights( sourceLayerIndex ) );
+    return _parameters->_layerToNegativeWeights.at( sourceLayerIndex );
+}
+
+void Layer::compressWeights( double maxDensity )
+{
+    if ( _type != WEIGHTED_SUM )
+        return;
+
+    List<unsigned> toCompress;
+    for ( const auto &weights : _parameters->_layerToWeights )
+    {
+        unsigned size = _sourceLayers[weights.first] * _size;
+        if ( SparseWeightMatrix::countNonZeros( weights.second, size ) <= maxDensity * size )
+            toCompress.append( weights.first );
+    }
+
+    if ( toCompress.empty() )
+        return;
+
+    makeParametersPrivate();
+
+    for ( unsigned sourceLayer : toCompress )
+    {
+        _parameters->_layerToSparseWeights[sourceLayer] =
+            new SparseWeightMatrix( _parameters->_layerToWeights[sourceLayer],
+                                    _sourceLayers[sourceLayer], _size );
+
+        delete[] _parameters->_layerToWeights[sourceLayer];
+        delete[] _parameters->_layerToPositiveWeights[sourceLayer];
+        delete[] _parameters->_layerToNegativeWeights[sourceLayer];
+
+        _parameters->_layerToWeights.erase( sourceLayer );
+        _parameters->_layerToPositiveWeights.erase( sourceLayer );
+        _parameters->_layerToNegativeWeights.erase( sourceLayer );
+    }
+}
+
+void Layer::decompressWeights()
+{
+    if ( _parameters->_layerToSparseWeights.empty() )
+        return;
+
+    makeParametersPrivate();
+
+    List<unsigned> sparseSources;
+    for ( const auto &weights : _parameters->_layerToSparseWeights )
+        sparseSources.append( weights.first );
+
+    for ( unsigned sourceLayer : sparseSources )
+        decompressWeights( sourceLayer );
+}
+
+void Layer::decompressWeights( unsigned sourceLayerIndex )
+{
+    ASSERT( !parametersAreShared() );
+
+    SparseWeightMatrix *sparse = _parameters->_layerToSparseWeights[sourceLayerIndex];
+    unsigned size = _sourceLayers[sourceLayerIndex] * _size;
+
+    double *weights = new double[size];
+    double *positiveWeights = new double[size];
+    double *negativeWeights = new double[size];
+
+    sparse->toDense( weights );
+    for ( unsigned i = 0; i < size; ++i )
+    {
+        positiveWeights[i] = weights[i] > 0 ? weights[i] : 0;
+        negativeWeights[i] = weights[i] > 0 ? 0 : weights[i];
+    }
+
+    _parameters->_layerToWeights[sourceLayerIndex] = weights;
+    _parameters->_layerToPositiveWeights[sourceLayerIndex] = positiveWeights;
+    _parameters->_layerToNegativeWeights[sourceLayerIndex] = negativeWeights;
+
+    delete sparse;
+    _parameters->_layerToSparseWeights.erase( sourceLayerIndex );
+}
+
+bool Layer::hasSparseWeights( unsigned sourceLayerIndex ) const
+{
+    return _parameters->_layerToSparseWeights.exists( sourceLayerIndex );
+}
+
+const SparseWeightMatrix *Layer::getSparseWeights( unsigned sourceLayerIndex ) const
+{
+    return _parameters->_layerToSparseWeights.at( sourceLayerIndex );
+}
+
+void Layer::forEachWeight( unsigned sourceLayerIndex,
+                           const std::function<void( unsigned, unsigned, double )> &function ) const
+{
+    unsigned sourceSize = _sourceLayers[sourceLayerIndex];
+
+    if ( hasSparseWeights( sourceLayerIndex ) )
+    {
+        const SparseWeightMatrix *sparse = getSparseWeights( sourceLayerIndex );
+        const unsigned *rowStart = sparse->getRowStart();
+        const unsigned *columns = sparse->getColumnIndices();
+        const double *values = sparse->getValues();
+
+        for ( unsigned i = 0; i < sourceSize; ++i )
+            for ( unsigned k = rowStart[i]; k < rowStart[i + 1]; ++k )
+                function( i, columns[k], values[k] );
+        return;
+    }
+
+    const double *weights = _parameters->_layerToWeights.at( sourceLayerIndex );
+    for ( unsigned i = 0; i < sourceSize; ++i )
+        for ( unsigned j = 0; j < _size; ++j )
+            if ( weights[i * _size + j] != 0 )
+                function( i, j, weights[i * _size + j] );
 }
 
 void Layer::setBias( unsigned neuron, double bias )
 {
-    _bias[neuron] = bias;
+    makeParametersPrivate();
+    _parameters->_bias[neuron] = bias;
 }
 
 double Layer::getBias( unsigned neuron ) const
 {
-    return _bias[neuron];
+    return _parameters->_bias[neuron];
+}
+
+const double *Layer::getBiases() const
+{
+    return _parameters->_bias;
+}
+
+unsigned long long Layer::getParametersMemoryInBytes() const
+{
+    unsigned long long bytes = 0;
+    for ( const auto &weights : _parameters->_layerToWeights )
+        bytes += 3 * sizeof(double) * _sourceLayers[weights.first] * _size;
+
+    for ( const auto &weights : _parameters->_layerToSparseWeights )
+        bytes += weights.second->getMemoryInBytes();
+
+    if ( _parameters->_bias )
+        bytes += sizeof(double) * _size;
+
+    return bytes;
 }
 
-double *Layer::getBiases() const
+bool Layer::parametersAreShared() const
 {
-    return _bias;
+    return _parameters.use_count() > 1;
+}
+
+void Layer::makeParametersPrivate()
+{
+    if ( !parametersAreShared() )
+        return;
+
+    std::shared_ptr<Parameters> privateCopy = std::make_shared<Parameters>();
+
+    for ( const auto &weights : _parameters->_layerToWeights )
+    {
+        unsigned sourceLayer = weights.first;
+        unsigned size = _sourceLayers.get( sourceLayer ) * _size;
+
+        privateCopy->_layerToWeights[sourceLayer] = new double[size];
+        privateCopy->_layerToPositiveWeights[sourceLayer] = new double[size];
+        privateCopy->_layerToNegativeWeights[sourceLayer] = new double[size];
+
+        memcpy( privateCopy->_layerToWeights[sourceLayer],
+                _parameters->_layerToWeights[sourceLayer], sizeof(double) * size );
+        memcpy( privateCopy->_layerToPositiveWeights[sourceLayer],
+                _parameters->_layerToPositiveWeights[sourceLayer], sizeof(double) * size );
+        memcpy( privateCopy->_layerToNegativeWeights[sourceLayer],
+                _parameters->_layerToNegativeWeights[sourceLayer], sizeof(double) * size );
+    }
+
+    for ( const auto &weights : _parameters->_layerToSparseWeights )
+        privateCopy->_layerToSparseWeights[weights.first] = new SparseWeightMatrix( *weights.second );
+
+    if ( _parameters->_bias )
+    {
+        privateCopy->_bias = new double[_size];
+        memcpy( privateCopy->_bias, _parameters->_bias, sizeof(double) * _size );
+    }
+
+    _parameters = privateCopy;
+}
+
+Layer::Parameters::Parameters()
+    : _bias( NULL )
+{
+}
+
+Layer::Parameters::~Parameters()
+{
+    for ( const auto &weights : _layerToWeights )
+        delete[] weights.second;
+
+    for ( const auto &weights : _layerToPositiveWeights )
+        delete[] weights.second;
+
+    for ( const auto &weights : _layerToNegativeWeights )
+        delete[] weights.second;
+
+    for ( const auto &weights : _layerToSparseWeights )
+        delete weights.second;
+
+    if ( _bias )
+        delete[] _bias;
 }
 
 void Layer::addActivationSource( unsigned sourceLayer, unsigned sourceNeuron, unsigned targetNeuron )
@@ -462,40 +754,89 @@ void Layer::setNeuronVariable( unsigned neuron, unsigned variable )
 
 void Layer::obtainCurrentBounds( const InputQuery &inputQuery )
 {
+    bool changed = false;
     for ( unsigned i = 0; i < _size; ++i )
     {
+        double lb;
+        double ub;
         if ( _neuronToVariable.exists( i ) )
         {
             unsigned variable = _neuronToVariable[i];
-            _lb[i] = inputQuery.getLowerBound( variable );
-            _ub[i] = inputQuery.getUpperBound( variable );
+            lb = inputQuery.getLowerBound( variable );
+            ub = inputQuery.getUpperBound( variable );
         }
         else
         {
             ASSERT( _eliminatedNeurons.exists( i ) );
-            _lb[i] = _eliminatedNeurons[i];
-            _ub[i] = _eliminatedNeurons[i];
+            lb = _eliminatedNeurons[i];
+            ub = _eliminatedNeurons[i];
         }
+
+        changed = changed || _lb[i] != lb || _ub[i] != ub;
+        _lb[i] = lb;
+        _ub[i] = ub;
     }
+
+    if ( changed )
+        _layerOwner->markLayerDirty( _layerIndex );
+}
+
+void Layer::obtainCurrentBounds( const double *lowerBounds, const double *upperBounds )
+{
+    bool changed = false;
+    for ( unsigned i = 0; i < _size; ++i )
+    {
+        double lb;
+        double ub;
+        if ( _neuronToVariable.exists( i ) )
+        {
+            unsigned variable = _neuronToVariable[i];
+            lb = lowerBounds[variable];
+            ub = upperBounds[variable];
+        }
+        else
+        {
+            ASSERT( _eliminatedNeurons.exists( i ) );
+            lb = _eliminatedNeurons[i];
+            ub = _eliminatedNeurons[i];
+        }
+
+        changed = changed || _lb[i] != lb || _ub[i] != ub;
+        _lb[i] = lb;
+        _ub[i] = ub;
+    }
+
+    if ( changed )
+        _layerOwner->markLayerDirty( _layerIndex );
 }
 
 void Layer::obtainCurrentBounds()
 {
+    bool changed = false;
     for ( unsigned i = 0; i < _size; ++i )
     {
+        double lb;
+        double ub;
         if ( _neuronToVariable.exists( i ) )
         {
             unsigned variable = _neuronToVariable[i];
-            _lb[i] = _layerOwner->getTableau()->getLowerBound( variable );
-            _ub[i] = _layerOwner->getTableau()->getUpperBound( variable );
+            lb = _layerOwner->getTableau()->getLowerBound( variable );
+            ub = _layerOwner->getTableau()->getUpperBound( variable );
         }
         else
         {
             ASSERT( _eliminatedNeurons.exists( i ) );
-            _lb[i] = _eliminatedNeurons[i];
-            _ub[i] = _eliminatedNeurons[i];
+            lb = _eliminatedNeurons[i];
+            ub = _eliminatedNeurons[i];
         }
+
+        changed = changed || _lb[i] != lb || _ub[i] != ub;
+        _lb[i] = lb;
+        _ub[i] = ub;
     }
+
+    if ( changed )
+        _layerOwner->markLayerDirty( _layerIndex );
 }
 
 double Layer::getLb( unsigned neuron ) const
@@ -527,13 +868,21 @@ double *Layer::getUbs() const
 void Layer::setLb( unsigned neuron, double bound )
 {
     ASSERT( !_eliminatedNeurons.exists( neuron ) );
-    _lb[neuron] = bound;
+    if ( _lb[neuron] != bound )
+    {
+        _lb[neuron] = bound;
+        _layerOwner->markLayerDirty( _layerIndex );
+    }
 }
 
 void Layer::setUb( unsigned neuron, double bound )
 {
     ASSERT( !_eliminatedNeurons.exists( neuron ) );
-    _ub[neuron] = bound;
+    if ( _ub[neuron] != bound )
+    {
+        _ub[neuron] = bound;
+        _layerOwner->markLayerDirty( _layerIndex );
+    }
 }
 
 void Layer::computeIntervalArithmeticBounds()
@@ -574,8 +923,8 @@ void Layer::computeIntervalArithmeticBoundsForWeightedSum()
 
     for ( unsigned i = 0; i < _size; ++i )
     {
-        newLb[i] = _bias[i];
-        newUb[i] = _bias[i];
+        newLb[i] = _parameters->_bias[i];
+        newUb[i] = _parameters->_bias[i];
     }
 
     for ( const auto &sourceLayerEntry : _sourceLayers )
@@ -583,8 +932,29 @@ void Layer::computeIntervalArithmeticBoundsForWeightedSum()
         unsigned sourceLayerIndex = sourceLayerEntry.first;
         unsigned sourceLayerSize = sourceLayerEntry.second;
         const Layer *sourceLayer = _layerOwner->getLayer( sourceLayerIndex );
-        const double *weights = _layerToWeights[sourceLayerIndex];
 
+        if ( hasSparseWeights( sourceLayerIndex ) )
+        {
+            forEachWeight( sourceLayerIndex, [&]( unsigned j, unsigned i, double weight )
+            {
+                double previousLb = sourceLayer->getLb( j );
+                double previousUb = sourceLayer->getUb( j );
+
+                if ( weight > 0 )
+                {
+                    newLb[i] += weight * previousLb;
+                    newUb[i] += weight * previousUb;
+                }
+                else
+                {
+                    newLb[i] += weight * previousUb;
+                    newUb[i] += weight * previousLb;
+                }
+            } );
+            continue;
+        }
+
+        const double *weights = _parameters->_layerToWeights[sourceLayerIndex];
         for ( unsigned i = 0; i < _size; ++i )
         {
             for ( unsigned j = 0; j < sourceLayerSize; ++j )
@@ -1338,8 +1708,8 @@ void Layer::computeSymbolicBoundsForWeightedSum()
         }
         else
         {
-            _symbolicLowerBias[i] = _bias[i];
-            _symbolicUpperBias[i] = _bias[i];
+            _symbolicLowerBias[i] = _parameters->_bias[i];
+            _symbolicUpperBias[i] = _parameters->_bias[i];
         }
     }
 
@@ -1356,16 +1726,52 @@ void Layer::computeSymbolicBoundsForWeightedSum()
           newLB = oldUB * negWeights + oldLB * posWeights
         */
 
-        matrixMultiplication( sourceLayer->getSymbolicUb(), _layerToPositiveWeights[sourceLayerIndex],
+        if ( hasSparseWeights( sourceLayerIndex ) )
+        {
+            // Only the non-zero weights contribute, so walk them directly
+            // and update the symbolic bounds and biases of their targets
+            const double *sourceSymbolicLb = sourceLayer->getSymbolicLb();
+            const double *sourceSymbolicUb = sourceLayer->getSymbolicUb();
+            const double *sourceLowerBias = sourceLayer->getSymbolicLowerBias();
+            const double *sourceUpperBias = sourceLayer->getSymbolicUpperBias();
+
+            forEachWeight( sourceLayerIndex, [&]( unsigned k, unsigned j, double weight )
+            {
+                if ( _eliminatedNeurons.exists( j ) )
+                    return;
+
+                const double *sourceForUb = weight > 0 ? sourceSymbolicUb : sourceSymbolicLb;
+                const double *sourceForLb = weight > 0 ? sourceSymbolicLb : sourceSymbolicUb;
+                for ( unsigned i = 0; i < _inputLayerSize; ++i )
+                {
+                    _symbolicUb[i * _size + j] += sourceForUb[i * sourceLayerSize + k] * weight;
+                    _symbolicLb[i * _size + j] += sourceForLb[i * sourceLayerSize + k] * weight;
+                }
+
+                if ( weight > 0 )
+                {
+                    _symbolicLowerBias[j] += sourceLowerBias[k] * weight;
+                    _symbolicUpperBias[j] += sourceUpperBias[k] * weight;
+                }
+                else
+                {
+                    _symbolicLowerBias[j] += sourceUpperBias[k] * weight;
+                    _symbolicUpperBias[j] += sourceLowerBias[k] * weight;
+                }
+            } );
+            continue;
+        }
+
+        matrixMultiplication( sourceLayer->getSymbolicUb(), _parameters->_layerToPositiveWeights[sourceLayerIndex],
                               _symbolicUb, _inputLayerSize,
                               sourceLayerSize, _size );
-        matrixMultiplication( sourceLayer->getSymbolicLb(), _layerToNegativeWeights[sourceLayerIndex],
+        matrixMultiplication( sourceLayer->getSymbolicLb(), _parameters->_layerToNegativeWeights[sourceLayerIndex],
                               _symbolicUb, _inputLayerSize,
                               sourceLayerSize, _size );
-        matrixMultiplication( sourceLayer->getSymbolicLb(), _layerToPositiveWeights[sourceLayerIndex],
+        matrixMultiplication( sourceLayer->getSymbolicLb(), _parameters->_layerToPositiveWeights[sourceLayerIndex],
                               _symbolicLb, _inputLayerSize,
                               sourceLayerSize, _size);
-        matrixMultiplication( sourceLayer->getSymbolicUb(), _layerToNegativeWeights[sourceLayerIndex],
+        matrixMultiplication( sourceLayer->getSymbolicUb(), _parameters->_layerToNegativeWeights[sourceLayerIndex],
                               _symbolicLb, _inputLayerSize,
                               sourceLayerSize, _size);
 
@@ -1392,7 +1798,7 @@ void Layer::computeSymbolicBoundsForWeightedSum()
             // Add the weighted bias from the source layer
             for ( unsigned k = 0; k < sourceLayerSize; ++k )
             {
-                double weight = _layerToWeights[sourceLayerIndex][k * _size + j];
+                double weight = _parameters->_layerToWeights[sourceLayerIndex][k * _size + j];
 
                 if ( weight > 0 )
                 {
@@ -1543,8 +1949,10 @@ unsigned Layer::getLayerIndex() const
 }
 
 Layer::Layer( const Layer *other )
-    : _bias( NULL )
+    : _parameters( other->_parameters )
     , _assignment( NULL )
+    , _numberOfSimulations( 0 )
+    , _simulations( NULL )
     , _lb( NULL )
     , _ub( NULL )
     , _inputLayerSize( 0 )
@@ -1564,28 +1972,8 @@ Layer::Layer( const Layer *other )
 
     allocateMemory();
 
-    for ( auto &sourceLayerEntry : other->_sourceLayers )
-    {
-        addSourceLayer( sourceLayerEntry.first, sourceLayerEntry.second );
-
-        if ( other->_layerToWeights.exists( sourceLayerEntry.first ) )
-            memcpy( _layerToWeights[sourceLayerEntry.first],
-                    other->_layerToWeights[sourceLayerEntry.first],
-                    sizeof(double) * sourceLayerEntry.second * _size );
-
-        if ( other->_layerToPositiveWeights.exists( sourceLayerEntry.first ) )
-            memcpy( _layerToPositiveWeights[sourceLayerEntry.first],
-                    other->_layerToPositiveWeights[sourceLayerEntry.first],
-                    sizeof(double) * sourceLayerEntry.second * _size );
-
-        if ( other->_layerToNegativeWeights.exists( sourceLayerEntry.first ) )
-            memcpy( _layerToNegativeWeights[sourceLayerEntry.first],
-                    other->_layerToNegativeWeights[sourceLayerEntry.first],
-                    sizeof(double) * sourceLayerEntry.second * _size );
-    }
-
-    if ( other->_bias )
-        memcpy( _bias, other->_bias, sizeof(double) * _size );
+    // The weights and biases are shared with the other layer
+    _sourceLayers = other->_sourceLayers;
 
     _neuronToActivationSources = other->_neuronToActivationSources;
 
@@ -1638,23 +2026,8 @@ double Layer::getSymbolicUbOfUb( unsigned neuron ) const
 
 void Layer::freeMemoryIfNeeded()
 {
-    for ( const auto &weights : _layerToWeights )
-        delete[] weights.second;
-    _layerToWeights.clear();
-
-    for ( const auto &weights : _layerToPositiveWeights )
-        delete[] weights.second;
-    _layerToPositiveWeights.clear();
-
-    for ( const auto &weights : _layerToNegativeWeights )
-        delete[] weights.second;
-    _layerToNegativeWeights.clear();
-
-    if ( _bias )
-    {
-        delete[] _bias;
-        _bias = NULL;
-    }
+    // The parameters are released with the last layer referring to them
+    _parameters = nullptr;
 
     if ( _assignment )
     {
@@ -1662,6 +2035,12 @@ void Layer::freeMemoryIfNeeded()
         _assignment = NULL;
     }
 
+    if ( _simulations )
+    {
+        delete[] _simulations;
+        _simulations = NULL;
+    }
+
     if ( _lb )
     {
         delete[] _lb;
@@ -1786,13 +2165,13 @@ void Layer::dump() const
                 continue;
             }
 
-            printf( "\t\tx%u = %+.4lf\n\t\t\t", _neuronToVariable[i], _bias[i] );
+            printf( "\t\tx%u = %+.4lf\n\t\t\t", _neuronToVariable[i], _parameters->_bias[i] );
             for ( const auto &sourceLayerEntry : _sourceLayers )
             {
                 const Layer *sourceLayer = _layerOwner->getLayer( sourceLayerEntry.first );
                 for ( unsigned j = 0; j < sourceLayer->getSize(); ++j )
                 {
-                    double weight = _layerToWeights[sourceLayerEntry.first][j * _size + i];
+                    double weight = getWeight( sourceLayerEntry.first, j, i );
                     if ( !FloatUtils::isZero( weight ) )
                     {
                         if ( sourceLayer->_neuronToVariable.exists( j ) )
@@ -1876,6 +2255,10 @@ double Layer::getEliminatedNeuronValue( unsigned neuron ) const
 
 void Layer::reduceIndexFromAllMaps( unsigned startIndex )
 {
+    // Copying shared parameters looks up the size of each source layer,
+    // so it has to happen while the two maps are still keyed alike
+    makeParametersPrivate();
+
     // Adjust the source layers
     Map<unsigned, unsigned> copyOfSources = _sourceLayers;
     _sourceLayers.clear();
@@ -1883,9 +2266,10 @@ void Layer::reduceIndexFromAllMaps( unsigned startIndex )
         _sourceLayers[pair.first >= startIndex ? pair.first - 1 : pair.first] = pair.second;
 
     // Adjust all weight maps
-    adjustWeightMapIndexing( _layerToWeights, startIndex );
-    adjustWeightMapIndexing( _layerToPositiveWeights, startIndex );
-    adjustWeightMapIndexing( _layerToNegativeWeights, startIndex );
+    adjustWeightMapIndexing( _parameters->_layerToWeights, startIndex );
+    adjustWeightMapIndexing( _parameters->_layerToPositiveWeights, startIndex );
+    adjustWeightMapIndexing( _parameters->_layerToNegativeWeights, startIndex );
+    adjustWeightMapIndexing( _parameters->_layerToSparseWeights, startIndex );
 
     // Adjust the neuron activations
     for ( auto &neuronToSources : _neuronToActivationSources )
@@ -1906,6 +2290,14 @@ void Layer::adjustWeightMapIndexing( Map<unsigned, double *> &map, unsigned star
         map[pair.first >= startIndex ? pair.first - 1 : pair.first] = pair.second;
 }
 
+void Layer::adjustWeightMapIndexing( Map<unsigned, SparseWeightMatrix *> &map, unsigned startIndex )
+{
+    Map<unsigned, SparseWeightMatrix *> copyOfWeights = map;
+    map.clear();
+    for ( const auto &pair : copyOfWeights )
+        map[pair.first >= startIndex ? pair.first - 1 : pair.first] = pair.second;
+}
+
 void Layer::reduceIndexAfterMerge( unsigned startIndex )
 {
     if ( _layerIndex >= startIndex )
@@ -1926,26 +2318,49 @@ bool Layer::operator==( const Layer &layer ) const
     if ( _inputLayerSize != layer._inputLayerSize )
         return false;
 
-    if ( ( _bias && !layer._bias ) || ( !_bias && layer._bias ) )
+    if ( ( _parameters->_bias && !layer._parameters->_bias ) || ( !_parameters->_bias && layer._parameters->_bias ) )
         return false;
 
-    if ( _bias && layer._bias )
+    if ( _parameters->_bias && layer._parameters->_bias )
     {
-        if ( std::memcmp( _bias, layer._bias, _size * sizeof(double) ) != 0 )
+        if ( std::memcmp( _parameters->_bias, layer._parameters->_bias, _size * sizeof(double) ) != 0 )
             return false;
     }
 
     if ( _sourceLayers != layer._sourceLayers )
         return false;
 
-    if ( !compareWeights( _layerToWeights, layer._layerToWeights ) )
-        return false;
+    if ( _type != WEIGHTED_SUM )
+        return true;
 
-    if ( !compareWeights( _layerToPositiveWeights, layer._layerToPositiveWeights ) )
-        return false;
+    for ( const auto &sourceLayer : _sourceLayers )
+    {
+        if ( !compareWeightsOfSourceLayer( layer, sourceLayer.first ) )
+            return false;
+    }
 
-    if ( !compareWeights( _layerToNegativeWeights, layer._layerToNegativeWeights ) )
-        return false;
+    return true;
+}
+
+bool Layer::compareWeightsOfSourceLayer( const Layer &layer, unsigned sourceLayerIndex ) const
+{
+    if ( !hasSparseWeights( sourceLayerIndex ) && !layer.hasSparseWeights( sourceLayerIndex ) )
+    {
+        unsigned bytes = _size * _sourceLayers[sourceLayerIndex] * sizeof(double);
+        return
+            std::memcmp( getWeights( sourceLayerIndex ),
+                         layer.getWeights( sourceLayerIndex ), bytes ) == 0 &&
+            std::memcmp( getPositiveWeights( sourceLayerIndex ),
+                         layer.getPositiveWeights( sourceLayerIndex ), bytes ) == 0 &&
+            std::memcmp( getNegativeWeights( sourceLayerIndex ),
+                         layer.getNegativeWeights( sourceLayerIndex ), bytes ) == 0;
+    }
+
+    // The weights are equal regardless of the form they are kept in
+    for ( unsigned i = 0; i < _sourceLayers[sourceLayerIndex]; ++i )
+        for ( unsigned j = 0; j < _size; ++j )
+            if ( getWeight( sourceLayerIndex, i, j ) != layer.getWeight( sourceLayerIndex, i, j ) )
+                return false;
 
     return true;
 }
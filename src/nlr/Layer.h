@@ -19,6 +19,7 @@
 #include "AbsoluteValueConstraint.h"
 #include "Debug.h"
 #include "FloatUtils.h"
+#include "GlobalConfiguration.h"
 #include "LayerOwner.h"
 #include "MarabouError.h"
 #include "MatrixMultiplication.h"
@@ -27,8 +28,12 @@
 #include "ReluConstraint.h"
 #include "SigmoidConstraint.h"
 #include "SignConstraint.h"
+#include "SparseWeightMatrix.h"
 #include "Vector.h"
 
+#include <functional>
+#include <memory>
+
 namespace NLR {
 
 class Layer
@@ -57,6 +62,7 @@ public:
 
     void setLayerOwner( LayerOwner *layerOwner );
     void addSourceLayer( unsigned layerNumber, unsigned layerSize );
+    void addSourceLayer( unsigned layerNumber, unsigned layerSize, SparseWeightMatrix *weights );
     void removeSourceLayer( unsigned sourceLayer );
     const Map<unsigned, unsigned> &getSourceLayers() const;
     const double *getWeightMatrix( unsigned sourceLayer ) const;
@@ -75,13 +81,40 @@ public:
     double getWeight( unsigned sourceLayer,
                       unsigned sourceNeuron,
                       unsigned targetNeuron ) const;
-    double *getWeights( unsigned sourceLayerIndex ) const;
-    double *getPositiveWeights( unsigned sourceLayerIndex ) const;
-    double *getNegativeWeights( unsigned sourceLayerIndex ) const;
+    const double *getWeights( unsigned sourceLayerIndex ) const;
+    const double *getPositiveWeights( unsigned sourceLayerIndex ) const;
+    const double *getNegativeWeights( unsigned sourceLayerIndex ) const;
+
+    /*
+      Weights with respect to a source layer are kept either as dense
+      matrices, which getWeights() and friends return, or as a sparse
+      matrix. compressWeights() switches every source layer whose
+      fraction of non-zero weights is at most maxDensity to the sparse
+      form, and decompressWeights() switches all of them back.
+    */
+    void compressWeights( double maxDensity = GlobalConfiguration::NLR_SPARSE_WEIGHTS_MAX_DENSITY );
+    void decompressWeights();
+    bool hasSparseWeights( unsigned sourceLayerIndex ) const;
+    const SparseWeightMatrix *getSparseWeights( unsigned sourceLayerIndex ) const;
+
+    /*
+      Call function( sourceNeuron, targetNeuron, weight ) on every
+      non-zero weight with respect to a source layer, in increasing
+      order of source neuron, whichever form the weights are kept in
+    */
+    void forEachWeight( unsigned sourceLayerIndex,
+                        const std::function<void( unsigned, unsigned, double )> &function ) const;
 
     void setBias( unsigned neuron, double bias );
     double getBias( unsigned neuron ) const;
-    double *getBiases() const;
+    const double *getBiases() const;
+
+    /*
+      The memory taken by the weights and biases of this layer, and
+      whether they are currently shared with copies of the layer
+    */
+    unsigned long long getParametersMemoryInBytes() const;
+    bool parametersAreShared() const;
 
     void addActivationSource( unsigned sourceLayer,
                               unsigned sourceNeuron,
@@ -107,11 +140,15 @@ public:
     void computeAssignment();
 
     /*
-      Set/get the simulations, or compute it from source layers
+      Set/get the simulations, or compute it from source layers. The
+      simulations are kept in one row-major (size x number of simulations)
+      matrix: row i holds the values of neuron i in every simulation.
     */
-   void setSimulations( const Vector<Vector<double>> *values );
-   void computeSimulations();
-   const Vector<Vector<double>> *getSimulations() const;
+    void setSimulations( const Vector<Vector<double>> *values );
+    void computeSimulations();
+    const double *getSimulations() const;
+    const double *getSimulations( unsigned neuron ) const;
+    unsigned getNumberOfSimulations() const;
 
     /*
       Bound related functionality: grab the current bounds from the
@@ -126,6 +163,7 @@ public:
     double *getUbs() const;
 
     void obtainCurrentBounds( const InputQuery &inputQuery );
+    void obtainCurrentBounds( const double *lowerBounds, const double *upperBounds );
     void obtainCurrentBounds();
     void computeSymbolicBounds();
     void computeIntervalArithmeticBounds();
@@ -161,14 +199,31 @@ private:
 
     Map<unsigned, unsigned> _sourceLayers;
 
-    Map<unsigned, double *> _layerToWeights;
-    Map<unsigned, double *> _layerToPositiveWeights;
-    Map<unsigned, double *> _layerToNegativeWeights;
-    double *_bias;
+    /*
+      The weights and biases of the layer. These are fixed once the
+      network has been constructed, so a layer cloned from another one
+      (e.g., in the engine of each DnC worker) shares them with the
+      original instead of copying them. A layer about to modify its
+      parameters first takes a private copy of them.
+    */
+    struct Parameters
+    {
+        Parameters();
+        ~Parameters();
+
+        Map<unsigned, double *> _layerToWeights;
+        Map<unsigned, double *> _layerToPositiveWeights;
+        Map<unsigned, double *> _layerToNegativeWeights;
+        Map<unsigned, SparseWeightMatrix *> _layerToSparseWeights;
+        double *_bias;
+    };
+
+    std::shared_ptr<Parameters> _parameters;
 
     double *_assignment;
 
-    Vector<Vector<double>> _simulations;
+    unsigned _numberOfSimulations;
+    double *_simulations;
 
     double *_lb;
     double *_ub;
@@ -192,6 +247,17 @@ private:
     void allocateMemory();
     void freeMemoryIfNeeded();
 
+    /*
+      Make sure the parameters are not shared with any other layer,
+      before they are modified
+    */
+    void makeParametersPrivate();
+
+    /*
+      Store the weights with respect to a source layer in dense form
+    */
+    void decompressWeights( unsigned sourceLayerIndex );
+
     /*
       Helper functions for symbolic bound tightening
     */
@@ -221,6 +287,9 @@ private:
 
     void adjustWeightMapIndexing( Map<unsigned, double *> &map,
                                   unsigned indexToStart );
+    void adjustWeightMapIndexing( Map<unsigned, SparseWeightMatrix *> &map,
+                                  unsigned indexToStart );
+    bool compareWeightsOfSourceLayer( const Layer &layer, unsigned sourceLayerIndex ) const;
     };
 
 } // namespace NLR
@@ -32,6 +32,7 @@ public:
     virtual const ITableau *getTableau() const = 0;
     virtual unsigned getNumberOfLayers() const = 0;
     virtual void receiveTighterBound( Tightening tightening ) = 0;
+    virtual void markLayerDirty( unsigned layerIndex ) = 0;
 };
 
 } // namespace NLR
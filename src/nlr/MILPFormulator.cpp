@@ -49,14 +49,15 @@ void MILPFormulator::optimizeBoundsWithIncrementalMILPEncoding( const Map<unsign
     _signChanges = 0;
     _cutoffs = 0;
 
-    GurobiWrapper gurobi;
+    GurobiWrapper solver;
+    unsigned indicatorOffset = getIndicatorVariableOffset( layers );
 
     double currentLb;
     double currentUb;
-    List<GurobiWrapper::Term> terms;
-    Map<String, double> dontCare;
+    List<ILPSolver::Term> terms;
+    Map<unsigned, double> dontCare;
 
-    struct timespec gurobiStart = TimeUtils::sampleMicro();
+    struct timespec solverStart = TimeUtils::sampleMicro();
 
     for ( unsigned i = 0; i < _layerOwner->getNumberOfLayers(); ++i )
     {
@@ -66,7 +67,7 @@ void MILPFormulator::optimizeBoundsWithIncrementalMILPEncoding( const Map<unsign
         */
         ASSERT( layers.exists( i ) );
         Layer *layer = layers[i];
-        _lpFormulator.addLayerToModel( gurobi, layer );
+        _lpFormulator.addLayerToModel( solver, layer );
 
         /*
           The optimiziation is performed layer by layer, and for each
@@ -93,29 +94,28 @@ void MILPFormulator::optimizeBoundsWithIncrementalMILPEncoding( const Map<unsign
             if ( _cutoffInUse && ( currentLb >= _cutoffValue || currentUb <= _cutoffValue ) )
             {
                 if ( layerRequiresMILP )
-                    addNeuronToModel( gurobi, layer, j, _layerOwner );
+                    addNeuronToModel( solver, layer, j, _layerOwner, indicatorOffset );
                 continue;
             }
 
             unsigned variable = layer->neuronToVariable( j );
-            Stringf variableName( "x%u", variable );
 
             terms.clear();
-            terms.append( GurobiWrapper::Term( 1, variableName ) );
+            terms.append( ILPSolver::Term( 1, variable ) );
 
             // Maximize, using just the LP relaxation for the current layer
-            if ( tightenUpperBound( gurobi, layer, j, variable, currentUb ) )
+            if ( tightenUpperBound( solver, layer, j, variable, currentUb ) )
             {
                 if ( layerRequiresMILP )
-                    addNeuronToModel( gurobi, layer, j, _layerOwner );
+                    addNeuronToModel( solver, layer, j, _layerOwner, indicatorOffset );
                 continue;
             }
 
             // Minimize, using just the LP relaxation for the current layer
-            if ( tightenLowerBound( gurobi, layer, j, variable, currentLb ) )
+            if ( tightenLowerBound( solver, layer, j, variable, currentLb ) )
             {
                 if ( layerRequiresMILP )
-                    addNeuronToModel( gurobi, layer, j, _layerOwner );
+                    addNeuronToModel( solver, layer, j, _layerOwner, indicatorOffset );
                 continue;
             }
 
@@ -125,39 +125,39 @@ void MILPFormulator::optimizeBoundsWithIncrementalMILPEncoding( const Map<unsign
             if ( !layerRequiresMILP )
                 continue;
 
-            addNeuronToModel( gurobi, layer, j, _layerOwner );
+            addNeuronToModel( solver, layer, j, _layerOwner, indicatorOffset );
 
             // Maximize, using just the exact MILP encoding
-            if ( tightenUpperBound( gurobi, layer, j, variable, currentUb ) )
+            if ( tightenUpperBound( solver, layer, j, variable, currentUb ) )
                 continue;
 
             // Minimize, using just the exact MILP encoding
-            if ( tightenLowerBound( gurobi, layer, j, variable, currentLb ) )
+            if ( tightenLowerBound( solver, layer, j, variable, currentLb ) )
                 continue;
         }
     }
 
-    struct timespec gurobiEnd = TimeUtils::sampleMicro();
+    struct timespec solverEnd = TimeUtils::sampleMicro();
 
-    log( Stringf( "Number of tighter bounds found by Gurobi: %u. Sign changes: %u. Cutoffs: %u\n",
+    log( Stringf( "Number of tighter bounds found by the LP solver: %u. Sign changes: %u. Cutoffs: %u\n",
                   _tighterBoundCounter, _signChanges, _cutoffs ) );
-    log( Stringf( "Seconds spent Gurobiing: %llu\n", TimeUtils::timePassed( gurobiStart, gurobiEnd ) / 1000000 ) );
+    log( Stringf( "Seconds spent in the LP solver: %llu\n", TimeUtils::timePassed( solverStart, solverEnd ) / 1000000 ) );
 }
 
 void MILPFormulator::optimizeBoundsWithMILPEncoding( const Map<unsigned, Layer *> &layers )
 {
     unsigned numberOfWorkers = Options::get()->getInt( Options::NUM_WORKERS );
 
-    Map<GurobiWrapper *, unsigned> solverToIndex;
+    Map<ILPSolver *, unsigned> solverToIndex;
     // Create a queue of free workers
     // When a worker is working, it is popped off the queue, when it is done, it
     // is added back to the queue.
     SolverQueue freeSolvers( numberOfWorkers );
     for ( unsigned i = 0; i < numberOfWorkers; ++i )
     {
-        GurobiWrapper *gurobi = new GurobiWrapper();
-        solverToIndex[gurobi] = i;
-        enqueueSolver( freeSolvers, gurobi );
+        ILPSolver *solver = new GurobiWrapper();
+        solverToIndex[solver] = i;
+        enqueueSolver( freeSolvers, solver );
     }
 
     boost::thread *threads = new boost::thread[numberOfWorkers];
@@ -168,7 +168,7 @@ void MILPFormulator::optimizeBoundsWithMILPEncoding( const Map<unsigned, Layer *
     std::atomic_uint signChanges( 0 );
     std::atomic_uint cutoffs( 0 );
 
-    struct timespec gurobiStart = TimeUtils::sampleMicro();
+    struct timespec solverStart = TimeUtils::sampleMicro();
 
     for ( const auto &currentLayer : layers )
     {
@@ -194,11 +194,11 @@ void MILPFormulator::optimizeBoundsWithMILPEncoding( const Map<unsigned, Layer *
         threads[i].join();
     }
 
-    struct timespec gurobiEnd = TimeUtils::sampleMicro();
+    struct timespec solverEnd = TimeUtils::sampleMicro();
 
-    log( Stringf( "Number of tighter bounds found by Gurobi: %u. Sign changes: %u. Cutoffs: %u\n",
+    log( Stringf( "Number of tighter bounds found by the LP solver: %u. Sign changes: %u. Cutoffs: %u\n",
                   tighterBoundCounter.load(), signChanges.load(), cutoffs.load() ) );
-    log( Stringf( "Seconds spent Gurobiing: %llu\n", TimeUtils::timePassed( gurobiStart, gurobiEnd ) / 1000000 ) );
+    log( Stringf( "Seconds spent in the LP solver: %llu\n", TimeUtils::timePassed( solverStart, solverEnd ) / 1000000 ) );
     clearSolverQueue( freeSolvers );
 
     if ( infeasible )
@@ -209,16 +209,16 @@ void MILPFormulator::optimizeBoundsOfOneLayerWithMILPEncoding( const Map<unsigne
 {
     unsigned numberOfWorkers = Options::get()->getInt( Options::NUM_WORKERS );
 
-    Map<GurobiWrapper *, unsigned> solverToIndex;
+    Map<ILPSolver *, unsigned> solverToIndex;
     // Create a queue of free workers
     // When a worker is working, it is popped off the queue, when it is done, it
     // is added back to the queue.
     SolverQueue freeSolvers( numberOfWorkers );
     for ( unsigned i = 0; i < numberOfWorkers; ++i )
     {
-        GurobiWrapper *gurobi = new GurobiWrapper();
-        solverToIndex[gurobi] = i;
-        enqueueSolver( freeSolvers, gurobi );
+        ILPSolver *solver = new GurobiWrapper();
+        solverToIndex[solver] = i;
+        enqueueSolver( freeSolvers, solver );
     }
 
     boost::thread *threads = new boost::thread[numberOfWorkers];
@@ -229,7 +229,7 @@ void MILPFormulator::optimizeBoundsOfOneLayerWithMILPEncoding( const Map<unsigne
     std::atomic_uint signChanges( 0 );
     std::atomic_uint cutoffs( 0 );
 
-    struct timespec gurobiStart = TimeUtils::sampleMicro();
+    struct timespec solverStart = TimeUtils::sampleMicro();
 
     Layer *layer = layers[targetIndex];
 
@@ -252,11 +252,11 @@ void MILPFormulator::optimizeBoundsOfOneLayerWithMILPEncoding( const Map<unsigne
         threads[i].join();
     }
 
-    struct timespec gurobiEnd = TimeUtils::sampleMicro();
+    struct timespec solverEnd = TimeUtils::sampleMicro();
 
-    log( Stringf( "Number of tighter bounds found by Gurobi: %u. Sign changes: %u. Cutoffs: %u\n",
+    log( Stringf( "Number of tighter bounds found by the LP solver: %u. Sign changes: %u. Cutoffs: %u\n",
                   tighterBoundCounter.load(), signChanges.load(), cutoffs.load() ) );
-    log( Stringf( "Seconds spent Gurobiing: %llu\n", TimeUtils::timePassed( gurobiStart, gurobiEnd ) / 1000000 ) );
+    log( Stringf( "Seconds spent in the LP solver: %llu\n", TimeUtils::timePassed( solverStart, solverEnd ) / 1000000 ) );
     clearSolverQueue( freeSolvers );
 
     if ( infeasible )
@@ -275,7 +275,7 @@ void MILPFormulator::optimizeBoundsOfNeuronsWithMILPEncoding( ThreadArgument &ar
     unsigned targetIndex = args._targetIndex;
     unsigned lastIndexOfRelaxation = args._lastIndexOfRelaxation;
 
-    Map<GurobiWrapper *, unsigned> solverToIndex = *args._solverToIndex;
+    Map<ILPSolver *, unsigned> solverToIndex = *args._solverToIndex;
     SolverQueue &freeSolvers = args._freeSolvers;
     std::mutex &mtx = args._mtx;
     std::atomic_bool &infeasible = args._infeasible;
@@ -290,8 +290,9 @@ void MILPFormulator::optimizeBoundsOfNeuronsWithMILPEncoding( ThreadArgument &ar
     bool skipTightenLb = false; // If true, skip lower bound tightening
     bool skipTightenUb = false; // If true, skip upper bound tightening
 
-    // declare simulations as local var to avoid a problem which can happen due to multi thread process.
-    const Vector<Vector<double>> *simulations = _layerOwner->getLayer( targetIndex )->getSimulations();
+    // declare the simulated layer as local var to avoid a problem which can happen due to multi thread process.
+    const Layer *simulatedLayer = _layerOwner->getLayer( targetIndex );
+    unsigned numberOfSimulations = simulatedLayer->getNumberOfSimulations();
 
     for ( unsigned i = 0; i < layer->getSize(); ++i )
     {
@@ -308,8 +309,10 @@ void MILPFormulator::optimizeBoundsOfNeuronsWithMILPEncoding( ThreadArgument &ar
         skipTightenUb = false;
 
         // Loop for simulation
-        for ( const auto &simValue : (*simulations).get( i ) )
+        const double *simulations = simulatedLayer->getSimulations( i );
+        for ( unsigned j = 0; j < numberOfSimulations; ++j )
         {
+            double simValue = simulations[j];
             if ( _cutoffInUse && _cutoffValue < simValue ) // If x_lower < 0 < x_sim, do not try to call tightning upper bound.
                 skipTightenUb = true;
 
@@ -351,7 +354,7 @@ void MILPFormulator::optimizeBoundsOfNeuronsWithMILPEncoding( ThreadArgument &ar
         }
 
         // Wait until there is an idle solver
-        GurobiWrapper *freeSolver;
+        ILPSolver *freeSolver;
         while ( !freeSolvers.pop( freeSolver ) )
             boost::this_thread::sleep_for( waitTime );
 
@@ -400,7 +403,7 @@ void MILPFormulator::tightenSingleVariableBoundsWithMILPEncoding( ThreadArgument
           ReLUs, as their phase would become fixed in these cases)
         */
 
-        GurobiWrapper *gurobi = argument._gurobi;
+        ILPSolver *solver = argument._solver;
         Layer *layer = argument._layer;
         const Map<unsigned, Layer *> &layers = *( argument._layers );
         unsigned index = argument._index;
@@ -423,12 +426,11 @@ void MILPFormulator::tightenSingleVariableBoundsWithMILPEncoding( ThreadArgument
                                    layer->getLayerIndex(), index ).ascii() );
 
         unsigned variable = layer->neuronToVariable( index );
-        Stringf variableName( "x%u", variable );
 
         if ( !skipTightenLb )
         {
             log( Stringf( "Computing lowerbound..." ).ascii() );
-            double lb = optimizeWithGurobi( *gurobi, MinOrMax::MIN, variableName,
+            double lb = optimizeWithSolver( *solver, MinOrMax::MIN, variable,
                                             cutoffValue, &infeasible );
             log( Stringf( "Lowerbound computed: %f", lb ).ascii() );
 
@@ -450,7 +452,7 @@ void MILPFormulator::tightenSingleVariableBoundsWithMILPEncoding( ThreadArgument
                 if ( cutoffInUse && lb > cutoffValue )
                 {
                     ++cutoffs;
-                    enqueueSolver( freeSolvers, gurobi );
+                    enqueueSolver( freeSolvers, solver );
                     return;
                 }
             }
@@ -459,8 +461,8 @@ void MILPFormulator::tightenSingleVariableBoundsWithMILPEncoding( ThreadArgument
         if ( !skipTightenUb )
         {
             log( Stringf( "Computing upperbound..." ).ascii() );
-            gurobi->reset();
-            double ub = optimizeWithGurobi( *gurobi, MinOrMax::MAX, variableName,
+            solver->reset();
+            double ub = optimizeWithSolver( *solver, MinOrMax::MAX, variable,
                                             cutoffValue, &infeasible );
             log( Stringf( "Upperbound computed %f", ub ).ascii() );
 
@@ -483,28 +485,29 @@ void MILPFormulator::tightenSingleVariableBoundsWithMILPEncoding( ThreadArgument
                 if ( cutoffInUse && ub < cutoffValue )
                 {
                     ++cutoffs;
-                    enqueueSolver( freeSolvers, gurobi );
+                    enqueueSolver( freeSolvers, solver );
                     return;
                 }
             }
         }
 
-        gurobi->reset();
+        solver->reset();
         // Exact encoding
         // Now, add the MILP constraints
         unsigned lastLayer = layer->getLayerIndex();
+        unsigned indicatorOffset = getIndicatorVariableOffset( layers );
         for ( const auto &layer : layers )
         {
             if ( layer.second->getLayerIndex() > lastLayer )
                 continue;
 
-            addLayerToModel( *gurobi, layer.second, layerOwner );
+            addLayerToModel( *solver, layer.second, layerOwner, indicatorOffset );
         }
 
         if ( !skipTightenLb )
         {
             log( Stringf( "Computing lowerbound..." ).ascii() );
-            double lb = optimizeWithGurobi( *gurobi, MinOrMax::MIN, variableName,
+            double lb = optimizeWithSolver( *solver, MinOrMax::MIN, variable,
                                     cutoffValue, &infeasible );
             log( Stringf( "Lowerbound computed: %f", lb ).ascii() );
 
@@ -526,7 +529,7 @@ void MILPFormulator::tightenSingleVariableBoundsWithMILPEncoding( ThreadArgument
                 if ( cutoffInUse && lb > cutoffValue )
                 {
                     ++cutoffs;
-                    enqueueSolver( freeSolvers, gurobi );
+                    enqueueSolver( freeSolvers, solver );
                     return;
                 }
             }
@@ -538,8 +541,8 @@ void MILPFormulator::tightenSingleVariableBoundsWithMILPEncoding( ThreadArgument
                                     layer->getLayerIndex(), index ).ascii() );
 
             log( Stringf( "Computing upperbound..." ).ascii() );
-            gurobi->reset();
-            double ub = optimizeWithGurobi( *gurobi, MinOrMax::MAX, variableName,
+            solver->reset();
+            double ub = optimizeWithSolver( *solver, MinOrMax::MAX, variable,
                                     cutoffValue, &infeasible );
             log( Stringf( "Upperbound computed %f", ub ).ascii() );
 
@@ -564,33 +567,47 @@ void MILPFormulator::tightenSingleVariableBoundsWithMILPEncoding( ThreadArgument
             }
         }
 
-        enqueueSolver( freeSolvers, gurobi );
+        enqueueSolver( freeSolvers, solver );
     }
     catch ( boost::thread_interrupted& )
     {
-        enqueueSolver( argument._freeSolvers, argument._gurobi );
+        enqueueSolver( argument._freeSolvers, argument._solver );
     }
 }
 
 void MILPFormulator::createMILPEncoding( const Map<unsigned, Layer *> &layers,
-                                         GurobiWrapper &gurobi,
+                                         ILPSolver &solver,
                                          unsigned lastLayer )
 {
     // First, create the LP relaxation of the problem
-    _lpFormulator.createLPRelaxation( layers, gurobi, lastLayer );
+    _lpFormulator.createLPRelaxation( layers, solver, lastLayer );
 
     // Now, add the MILP constraints
+    unsigned indicatorOffset = getIndicatorVariableOffset( layers );
     for ( const auto &layer : layers )
     {
         if ( layer.second->getLayerIndex() > lastLayer )
             continue;
 
-        addLayerToModel( gurobi, layer.second, _layerOwner );
+        addLayerToModel( solver, layer.second, _layerOwner, indicatorOffset );
     }
 }
 
-void MILPFormulator::addLayerToModel( GurobiWrapper &gurobi, const Layer *layer,
-                                      LayerOwner *layerOwner )
+unsigned MILPFormulator::getIndicatorVariableOffset( const Map<unsigned, Layer *> &layers )
+{
+    unsigned offset = 0;
+    for ( const auto &layer : layers )
+    {
+        unsigned maxVariable = layer.second->getMaxVariable();
+        if ( maxVariable + 1 > offset )
+            offset = maxVariable + 1;
+    }
+
+    return offset;
+}
+
+void MILPFormulator::addLayerToModel( ILPSolver &solver, const Layer *layer,
+                                      LayerOwner *layerOwner, unsigned indicatorOffset )
 {
     switch ( layer->getLayerType() )
     {
@@ -599,7 +616,7 @@ void MILPFormulator::addLayerToModel( GurobiWrapper &gurobi, const Layer *layer,
             break;
 
         case Layer::RELU:
-            addReluLayerToMILPFormulation( gurobi, layer, layerOwner );
+            addReluLayerToMILPFormulation( solver, layer, layerOwner, indicatorOffset );
             break;
 
         default:
@@ -608,8 +625,9 @@ void MILPFormulator::addLayerToModel( GurobiWrapper &gurobi, const Layer *layer,
     }
 }
 
-void MILPFormulator::addNeuronToModel( GurobiWrapper &gurobi, const Layer *layer,
-                                       unsigned neuron, LayerOwner *layerOwner )
+void MILPFormulator::addNeuronToModel( ILPSolver &solver, const Layer *layer,
+                                       unsigned neuron, LayerOwner *layerOwner,
+                                       unsigned indicatorOffset )
 {
     if ( layer->getLayerType() != Layer::RELU )
         throw NLRError( NLRError::LAYER_TYPE_NOT_SUPPORTED, "MILPFormulator" );
@@ -647,48 +665,50 @@ void MILPFormulator::addNeuronToModel( GurobiWrapper &gurobi, const Layer *layer
       y - ua <= 0
     */
 
-    gurobi.addVariable( Stringf( "a%u", targetVariable ),
+    unsigned indicatorVariable = indicatorOffset + targetVariable;
+    solver.addVariable( indicatorVariable,
                         0,
                         1,
-                        GurobiWrapper::BINARY );
+                        ILPSolver::BINARY );
 
-    List<GurobiWrapper::Term> terms;
-    terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-    terms.append( GurobiWrapper::Term( -1, Stringf( "x%u", sourceVariable ) ) );
-    terms.append( GurobiWrapper::Term( -sourceLb, Stringf( "a%u", targetVariable ) ) );
-    gurobi.addLeqConstraint( terms, -sourceLb );
+    List<ILPSolver::Term> terms;
+    terms.append( ILPSolver::Term( 1, targetVariable ) );
+    terms.append( ILPSolver::Term( -1, sourceVariable ) );
+    terms.append( ILPSolver::Term( -sourceLb, indicatorVariable ) );
+    solver.addLeqConstraint( terms, -sourceLb );
 
     terms.clear();
-    terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-    terms.append( GurobiWrapper::Term( -sourceUb, Stringf( "a%u", targetVariable ) ) );
-    gurobi.addLeqConstraint( terms, 0 );
+    terms.append( ILPSolver::Term( 1, targetVariable ) );
+    terms.append( ILPSolver::Term( -sourceUb, indicatorVariable ) );
+    solver.addLeqConstraint( terms, 0 );
 }
 
-void MILPFormulator::addReluLayerToMILPFormulation( GurobiWrapper &gurobi,
+void MILPFormulator::addReluLayerToMILPFormulation( ILPSolver &solver,
                                                     const Layer *layer,
-                                                    LayerOwner *layerOwner )
+                                                    LayerOwner *layerOwner,
+                                                    unsigned indicatorOffset )
 {
     for ( unsigned i = 0; i < layer->getSize(); ++i )
     {
-        addNeuronToModel( gurobi, layer, i, layerOwner );
+        addNeuronToModel( solver, layer, i, layerOwner, indicatorOffset );
     }
 }
 
-double MILPFormulator::optimizeWithGurobi( GurobiWrapper &gurobi,
-                                           MinOrMax minOrMax, String variableName,
+double MILPFormulator::optimizeWithSolver( ILPSolver &solver,
+                                           MinOrMax minOrMax, unsigned variable,
                                            double cutoffValue, std::atomic_bool *infeasible )
 {
-    List<GurobiWrapper::Term> terms;
-    terms.append( GurobiWrapper::Term( 1, variableName ) );
+    List<ILPSolver::Term> terms;
+    terms.append( ILPSolver::Term( 1, variable ) );
 
     if ( minOrMax == MAX )
-        gurobi.setObjective( terms );
+        solver.setObjective( terms );
     else
-        gurobi.setCost( terms );
+        solver.setCost( terms );
 
-    gurobi.solve();
+    solver.solve();
 
-    if ( gurobi.infeasible() )
+    if ( solver.infeasible() )
     {
         if ( infeasible )
         {
@@ -699,19 +719,19 @@ double MILPFormulator::optimizeWithGurobi( GurobiWrapper &gurobi,
             throw InfeasibleQueryException();
     }
 
-    if ( gurobi.cutoffOccurred() )
+    if ( solver.cutoffOccurred() )
         return cutoffValue;
 
-    if ( gurobi.optimal() )
+    if ( solver.optimal() )
     {
-        Map<String, double> dontCare;
+        Map<unsigned, double> dontCare;
         double result = 0;
-        gurobi.extractSolution( dontCare, result );
+        solver.extractSolution( dontCare, result );
         return result;
     }
-    else if ( gurobi.timeout() )
+    else if ( solver.timeout() )
     {
-        return gurobi.getObjectiveBound();
+        return solver.getObjectiveBound();
     }
 
     throw NLRError( NLRError::UNEXPECTED_RETURN_STATUS_FROM_GUROBI );
@@ -755,7 +775,7 @@ void MILPFormulator::setCutoff( double cutoff )
     _cutoffValue = cutoff;
 }
 
-bool MILPFormulator::tightenUpperBound( GurobiWrapper &gurobi,
+bool MILPFormulator::tightenUpperBound( ILPSolver &solver,
                                         Layer *layer,
                                         unsigned neuron,
                                         unsigned variable,
@@ -763,43 +783,41 @@ bool MILPFormulator::tightenUpperBound( GurobiWrapper &gurobi,
 {
     double newUb = FloatUtils::infinity();
 
-    Stringf variableName( "x%u", variable );
-
-    List<GurobiWrapper::Term> terms;
-    terms.append( GurobiWrapper::Term( 1, variableName ) );
+    List<ILPSolver::Term> terms;
+    terms.append( ILPSolver::Term( 1, variable ) );
 
-    gurobi.reset();
-    gurobi.setObjective( terms );
-    gurobi.solve();
+    solver.reset();
+    solver.setObjective( terms );
+    solver.solve();
 
-    if ( gurobi.infeasible() )
+    if ( solver.infeasible() )
         throw InfeasibleQueryException();
 
-    if ( gurobi.cutoffOccurred() )
+    if ( solver.cutoffOccurred() )
     {
         newUb = _cutoffValue;
     }
-    else if ( gurobi.optimal() )
+    else if ( solver.optimal() )
     {
-        Map<String, double> dontCare;
-        gurobi.extractSolution( dontCare, newUb );
+        Map<unsigned, double> dontCare;
+        solver.extractSolution( dontCare, newUb );
     }
-    else if ( gurobi.timeout() )
+    else if ( solver.timeout() )
     {
-        newUb = gurobi.getObjectiveBound();
+        newUb = solver.getObjectiveBound();
     }
     else
     {
         throw NLRError( NLRError::UNEXPECTED_RETURN_STATUS_FROM_GUROBI );
     }
 
-    Map<String, double> dontCare;
-    gurobi.extractSolution( dontCare, newUb );
+    Map<unsigned, double> dontCare;
+    solver.extractSolution( dontCare, newUb );
 
     // If the bound is tighter, store it
     if ( newUb < currentUb )
     {
-        gurobi.setUpperBound( variableName, newUb );
+        solver.setUpperBound( variable, newUb );
 
         if ( FloatUtils::isPositive( currentUb ) &&
              !FloatUtils::isPositive( newUb ) )
@@ -823,37 +841,36 @@ bool MILPFormulator::tightenUpperBound( GurobiWrapper &gurobi,
     return false;
 }
 
-bool MILPFormulator::tightenLowerBound( GurobiWrapper &gurobi,
+bool MILPFormulator::tightenLowerBound( ILPSolver &solver,
                                         Layer *layer,
                                         unsigned neuron,
                                         unsigned variable,
                                         double &currentLb )
 {
     double newLb = FloatUtils::negativeInfinity();
-    Stringf variableName( "x%u", variable );
 
-    List<GurobiWrapper::Term> terms;
-    terms.append( GurobiWrapper::Term( 1, variableName ) );
+    List<ILPSolver::Term> terms;
+    terms.append( ILPSolver::Term( 1, variable ) );
 
-    gurobi.reset();
-    gurobi.setCost( terms );
-    gurobi.solve();
+    solver.reset();
+    solver.setCost( terms );
+    solver.solve();
 
-    if ( gurobi.infeasible() )
+    if ( solver.infeasible() )
         throw InfeasibleQueryException();
 
-    if ( gurobi.cutoffOccurred() )
+    if ( solver.cutoffOccurred() )
     {
         newLb = _cutoffValue;
     }
-    else if ( gurobi.optimal() )
+    else if ( solver.optimal() )
     {
-        Map<String, double> dontCare;
-        gurobi.extractSolution( dontCare, newLb );
+        Map<unsigned, double> dontCare;
+        solver.extractSolution( dontCare, newLb );
     }
-    else if ( gurobi.timeout() )
+    else if ( solver.timeout() )
     {
-        newLb = gurobi.getObjectiveBound();
+        newLb = solver.getObjectiveBound();
     }
     else
     {
@@ -863,7 +880,7 @@ bool MILPFormulator::tightenLowerBound( GurobiWrapper &gurobi,
     // If the bound is tighter, store it
     if ( newLb > currentLb )
     {
-        gurobi.setLowerBound( variableName, newLb );
+        solver.setLowerBound( variable, newLb );
 
         if ( FloatUtils::isNegative( currentLb ) &&
              !FloatUtils::isNegative( newLb ) )
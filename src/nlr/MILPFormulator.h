@@ -51,7 +51,7 @@ public:
     void setCutoff( double cutoff );
 
     void createMILPEncoding( const Map<unsigned, Layer *> &layers,
-                             GurobiWrapper &gurobi,
+                             ILPSolver &solver,
                              unsigned lastLayer = UINT_MAX );
 
 private:
@@ -63,36 +63,46 @@ private:
     bool _cutoffInUse;
     double _cutoffValue;
 
-    bool tightenLowerBound( GurobiWrapper &gurobi,
+    bool tightenLowerBound( ILPSolver &solver,
                             Layer *layer,
                             unsigned neuron,
                             unsigned variable,
                             double &currentLb );
 
-    bool tightenUpperBound( GurobiWrapper &gurobi,
+    bool tightenUpperBound( ILPSolver &solver,
                             Layer *layer,
                             unsigned neuron,
                             unsigned variable,
                             double &currentUb );
 
-    static void addLayerToModel( GurobiWrapper &gurobi, const Layer *layer,
-                                 LayerOwner *layerOwner );
+    /*
+      The binary variable of a ReLU neuron whose output is variable x
+      is given the handle indicatorOffset + x, where indicatorOffset
+      follows the largest variable of the network.
+    */
+    static unsigned getIndicatorVariableOffset( const Map<unsigned, Layer *> &layers );
+
+    static void addLayerToModel( ILPSolver &solver, const Layer *layer,
+                                 LayerOwner *layerOwner,
+                                 unsigned indicatorOffset );
 
-    static void addReluLayerToMILPFormulation( GurobiWrapper &gurobi,
+    static void addReluLayerToMILPFormulation( ILPSolver &solver,
                                                const Layer *layer,
-                                               LayerOwner *layerOwner );
+                                               LayerOwner *layerOwner,
+                                               unsigned indicatorOffset );
 
-    static void addNeuronToModel( GurobiWrapper &gurobi,
+    static void addNeuronToModel( ILPSolver &solver,
                                   const Layer *layer,
                                   unsigned neuron,
-                                  LayerOwner *layerOwner );
+                                  LayerOwner *layerOwner,
+                                  unsigned indicatorOffset );
 
     /*
-      Optimize for the min/max value of variableName with respect to the constraints
-      encoded in gurobi. If the query is infeasible, *infeasible is set to true.
+      Optimize for the min/max value of variable with respect to the constraints
+      encoded in the solver. If the query is infeasible, *infeasible is set to true.
     */
-    static double optimizeWithGurobi( GurobiWrapper &gurobi, MinOrMax minOrMax,
-                                      String variableName, double cutoffValue,
+    static double optimizeWithSolver( ILPSolver &solver, MinOrMax minOrMax,
+                                      unsigned variable, double cutoffValue,
                                       std::atomic_bool *infeasible = NULL );
 
     void storeUbIfNeeded( Layer *layer,
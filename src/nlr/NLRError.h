@@ -25,6 +25,7 @@ public:
         UNEXPECTED_RETURN_STATUS_FROM_GUROBI = 0,
         LAYER_TYPE_NOT_SUPPORTED = 1,
         INPUT_LAYER_NOT_THE_FIRST_LAYER = 2,
+        SIMULATION_SIZE_MISMATCH = 3,
     };
 
     NLRError( NLRError::Code code ) : Error( "NLRError", (int)code )
@@ -30,6 +30,7 @@
 #include "Options.h"
 #include "ReluConstraint.h"
 #include "SignConstraint.h"
+#include "TraceRecorder.h"
 #include <cstring>
 
 namespace NLR {
@@ -37,6 +38,9 @@ namespace NLR {
 NetworkLevelReasoner::NetworkLevelReasoner()
     : _tableau( NULL )
     , _deepPolyAnalysis( nullptr )
+    , _numberOfDeepPolyThreads( 0 )
+    , _firstDirtyLayerForSymbolicBounds( 0 )
+    , _firstDirtyLayerForDeepPoly( 0 )
 {
 }
 
@@ -63,6 +67,7 @@ void NetworkLevelReasoner::addLayer( unsigned layerIndex, Layer::Type type, unsi
 {
     Layer *layer = new Layer( layerIndex, type, layerSize, this );
     _layerIndexToLayer[layerIndex] = layer;
+    markLayerDirty( layerIndex );
 }
 
 void NetworkLevelReasoner::addLayerDependency( unsigned sourceLayer, unsigned targetLayer )
@@ -70,6 +75,15 @@ void NetworkLevelReasoner::addLayerDependency( unsigned sourceLayer, unsigned ta
     _layerIndexToLayer[targetLayer]->addSourceLayer( sourceLayer, _layerIndexToLayer[sourceLayer]->getSize() );
 }
 
+void NetworkLevelReasoner::addLayerDependency( unsigned sourceLayer,
+                                               unsigned targetLayer,
+                                               SparseWeightMatrix *weights )
+{
+    _layerIndexToLayer[targetLayer]->addSourceLayer
+        ( sourceLayer, _layerIndexToLayer[sourceLayer]->getSize(), weights );
+    markLayerDirty( targetLayer );
+}
+
 void NetworkLevelReasoner::setWeight( unsigned sourceLayer,
                                       unsigned sourceNeuron,
                                       unsigned targetLayer,
@@ -78,11 +92,13 @@ void NetworkLevelReasoner::setWeight( unsigned sourceLayer,
 {
     _layerIndexToLayer[targetLayer]->setWeight
         ( sourceLayer, sourceNeuron, targetNeuron, weight );
+    markLayerDirty( targetLayer );
 }
 
 void NetworkLevelReasoner::setBias( unsigned layer, unsigned neuron, double bias )
 {
     _layerIndexToLayer[layer]->setBias( neuron, bias );
+    markLayerDirty( layer );
 }
 
 void NetworkLevelReasoner::addActivationSource( unsigned sourceLayer,
@@ -186,28 +202,87 @@ void NetworkLevelReasoner::clearConstraintTightenings()
     _boundTightenings.clear();
 }
 
+void NetworkLevelReasoner::markLayerDirty( unsigned layerIndex )
+{
+    if ( layerIndex < _firstDirtyLayerForSymbolicBounds )
+        _firstDirtyLayerForSymbolicBounds = layerIndex;
+    if ( layerIndex < _firstDirtyLayerForDeepPoly )
+        _firstDirtyLayerForDeepPoly = layerIndex;
+}
+
+void NetworkLevelReasoner::markAllLayersDirty()
+{
+    _firstDirtyLayerForSymbolicBounds = 0;
+    _firstDirtyLayerForDeepPoly = 0;
+}
+
+unsigned NetworkLevelReasoner::getFirstDirtyLayerForSymbolicBounds() const
+{
+    return _firstDirtyLayerForSymbolicBounds;
+}
+
+unsigned NetworkLevelReasoner::getFirstDirtyLayerForDeepPoly() const
+{
+    return _firstDirtyLayerForDeepPoly;
+}
+
 void NetworkLevelReasoner::symbolicBoundPropagation()
 {
-    for ( unsigned i = 0; i < _layerIndexToLayer.size(); ++i )
+    MARABOU_TRACE_SPAN( "nlr", "symbolic bound propagation" );
+    unsigned numberOfLayers = _layerIndexToLayer.size();
+    for ( unsigned i = _firstDirtyLayerForSymbolicBounds; i < numberOfLayers; ++i )
+    {
+        /*
+          Tighter bounds discovered for this layer are already taken
+          into account by the layers that follow, but the cached
+          DeepPoly state of this layer becomes stale.
+        */
+        unsigned numTightenings = _boundTightenings.size();
         _layerIndexToLayer[i]->computeSymbolicBounds();
+        if ( _boundTightenings.size() > numTightenings )
+            markLayerDirty( i );
+    }
+
+    _firstDirtyLayerForSymbolicBounds = numberOfLayers;
 }
 
 void NetworkLevelReasoner::deepPolyPropagation()
 {
+    MARABOU_TRACE_SPAN( "nlr", "deeppoly propagation" );
     if ( _deepPolyAnalysis == nullptr )
+    {
         _deepPolyAnalysis = std::unique_ptr<DeepPolyAnalysis>
-            ( new DeepPolyAnalysis( this ) );
-    _deepPolyAnalysis->run();
+            ( new DeepPolyAnalysis( this, 0, _numberOfDeepPolyThreads ) );
+        _firstDirtyLayerForDeepPoly = 0;
+    }
+    _deepPolyAnalysis->run( _firstDirtyLayerForDeepPoly );
+
+    _firstDirtyLayerForDeepPoly = _layerIndexToLayer.size();
+}
+
+void NetworkLevelReasoner::setNumberOfDeepPolyThreads( unsigned numberOfThreads )
+{
+    if ( numberOfThreads == _numberOfDeepPolyThreads )
+        return;
+
+    // The analysis holds one workspace per thread, so it is rebuilt on
+    // the next run
+    _numberOfDeepPolyThreads = numberOfThreads;
+    _deepPolyAnalysis = nullptr;
 }
 
 void NetworkLevelReasoner::lpRelaxationPropagation()
 {
+    MARABOU_TRACE_SPAN( "nlr", "lp relaxation propagation" );
     LPFormulator lpFormulator( this );
     lpFormulator.setCutoff( 0 );
 
     if ( Options::get()->getMILPSolverBoundTighteningType() ==
          MILPSolverBoundTighteningType::LP_RELAXATION )
         lpFormulator.optimizeBoundsWithLpRelaxation( _layerIndexToLayer );
+    else if ( Options::get()->getMILPSolverBoundTighteningType() ==
+              MILPSolverBoundTighteningType::LP_RELAXATION_WARM_START )
+        lpFormulator.optimizeBoundsWithLpRelaxation( _layerIndexToLayer, true );
     else if ( Options::get()->getMILPSolverBoundTighteningType() ==
               MILPSolverBoundTighteningType::LP_RELAXATION_INCREMENTAL )
         lpFormulator.optimizeBoundsWithIncrementalLpRelaxation( _layerIndexToLayer );
@@ -221,12 +296,16 @@ void NetworkLevelReasoner::LPTighteningForOneLayer( unsigned targetIndex )
     if ( Options::get()->getMILPSolverBoundTighteningType() ==
          MILPSolverBoundTighteningType::LP_RELAXATION )
         lpFormulator.optimizeBoundsOfOneLayerWithLpRelaxation( _layerIndexToLayer, targetIndex );
+    else if ( Options::get()->getMILPSolverBoundTighteningType() ==
+              MILPSolverBoundTighteningType::LP_RELAXATION_WARM_START )
+        lpFormulator.optimizeBoundsOfOneLayerWithLpRelaxation( _layerIndexToLayer, targetIndex, true );
 
     // TODO: implement for LP_RELAXATION_INCREMENTAL
 }
 
 void NetworkLevelReasoner::MILPPropagation()
 {
+    MARABOU_TRACE_SPAN( "nlr", "milp propagation" );
     MILPFormulator milpFormulator( this );
     milpFormulator.setCutoff( 0 );
 
@@ -252,6 +331,7 @@ void NetworkLevelReasoner::MILPTighteningForOneLayer( unsigned targetIndex )
 
 void NetworkLevelReasoner::iterativePropagation()
 {
+    MARABOU_TRACE_SPAN( "nlr", "iterative propagation" );
     IterativePropagator iterativePropagator( this );
     iterativePropagator.setCutoff( 0 );
     iterativePropagator.optimizeBoundsWithIterativePropagation( _layerIndexToLayer );
@@ -259,8 +339,14 @@ void NetworkLevelReasoner::iterativePropagation()
 
 void NetworkLevelReasoner::intervalArithmeticBoundPropagation()
 {
+    MARABOU_TRACE_SPAN( "nlr", "interval arithmetic propagation" );
     for ( unsigned i = 1; i < _layerIndexToLayer.size(); ++i )
+    {
+        unsigned numTightenings = _boundTightenings.size();
         _layerIndexToLayer[i]->computeIntervalArithmeticBounds();
+        if ( _boundTightenings.size() > numTightenings )
+            markLayerDirty( i );
+    }
 }
 
 void NetworkLevelReasoner::freeMemoryIfNeeded()
@@ -285,6 +371,10 @@ void NetworkLevelReasoner::storeIntoOther( NetworkLevelReasoner &other ) const
     // Other has fresh copies of the PLCs, so its topological order
     // shouldn't contain any stale data
     other._constraintsInTopologicalOrder.clear();
+
+    // Cached symbolic bounds refer to the old layers
+    other._deepPolyAnalysis = nullptr;
+    other.markAllLayersDirty();
 }
 
 void NetworkLevelReasoner::updateVariableIndices( const Map<unsigned, unsigned> &oldIndexToNewIndex,
@@ -292,6 +382,7 @@ void NetworkLevelReasoner::updateVariableIndices( const Map<unsigned, unsigned>
 {
     for ( auto &layer : _layerIndexToLayer )
         layer.second->updateVariableIndices( oldIndexToNewIndex, mergedVariables );
+    markAllLayersDirty();
 }
 
 void NetworkLevelReasoner::obtainCurrentBounds( const InputQuery &inputQuery )
@@ -300,6 +391,13 @@ void NetworkLevelReasoner::obtainCurrentBounds( const InputQuery &inputQuery )
         layer.second->obtainCurrentBounds( inputQuery );
 }
 
+void NetworkLevelReasoner::obtainCurrentBounds( const double *lowerBounds,
+                                                const double *upperBounds )
+{
+    for ( const auto &layer : _layerIndexToLayer )
+        layer.second->obtainCurrentBounds( lowerBounds, upperBounds );
+}
+
 void NetworkLevelReasoner::obtainCurrentBounds()
 {
     ASSERT( _tableau );
@@ -321,6 +419,7 @@ void NetworkLevelReasoner::eliminateVariable( unsigned variable, double value )
 {
     for ( auto &layer : _layerIndexToLayer )
         layer.second->eliminateVariable( variable, value );
+    markAllLayersDirty();
 }
 
 
@@ -520,25 +619,25 @@ void NetworkLevelReasoner::generateInputQueryForMaxLayer( InputQuery &inputQuery
 
 void NetworkLevelReasoner::generateInputQueryForWeightedSumLayer( InputQuery &inputQuery, const Layer &layer )
 {
+    Vector<Equation> equations( layer.getSize() );
     for ( unsigned i = 0; i < layer.getSize(); ++i )
     {
-        Equation eq;
-        eq.setScalar( -layer.getBias( i ) );
-        eq.addAddend( -1, layer.neuronToVariable( i ) );
-
-        for ( const auto &it : layer.getSourceLayers() )
-        {
-            const Layer *sourceLayer = _layerIndexToLayer[it.first];
+        equations[i].setScalar( -layer.getBias( i ) );
+        equations[i].addAddend( -1, layer.neuronToVariable( i ) );
+    }
 
-            for ( unsigned j = 0; j < sourceLayer->getSize(); ++j )
-            {
-                double coefficient = layer.getWeight( sourceLayer->getLayerIndex(), j, i );
-                eq.addAddend( coefficient, sourceLayer->neuronToVariable( j ) );
-            }
-        }
+    for ( const auto &it : layer.getSourceLayers() )
+    {
+        const Layer *sourceLayer = _layerIndexToLayer[it.first];
 
-        inputQuery.addEquation( eq );
+        layer.forEachWeight( it.first, [&]( unsigned j, unsigned i, double coefficient )
+        {
+            equations[i].addAddend( coefficient, sourceLayer->neuronToVariable( j ) );
+        } );
     }
+
+    for ( const auto &equation : equations )
+        inputQuery.addEquation( equation );
 }
 
 void NetworkLevelReasoner::mergeConsecutiveWSLayers()
@@ -549,7 +648,10 @@ void NetworkLevelReasoner::mergeConsecutiveWSLayers()
     while ( layer < _layerIndexToLayer.size() )
     {
         if ( suitableForMerging( layer ) )
+        {
             mergeWSLayers( layer );
+            markAllLayersDirty();
+        }
         else
             ++layer;
     }
@@ -599,6 +701,15 @@ void NetworkLevelReasoner::mergeWSLayers( unsigned secondLayerIndex )
     Layer *firstLayer = _layerIndexToLayer[firstLayerIndex];
     unsigned lastLayerIndex = _layerIndexToLayer.size() - 1;
 
+    // The merge multiplies dense weight matrices. The merged layer is
+    // compressed again afterwards if either of the layers was sparse
+    bool compressAfterMerge = false;
+    for ( const Layer *layer : { firstLayer, secondLayer } )
+        for ( const auto &source : layer->getSourceLayers() )
+            compressAfterMerge = compressAfterMerge || layer->hasSparseWeights( source.first );
+    firstLayer->decompressWeights();
+    secondLayer->decompressWeights();
+
     // Iterate over all inputs to the first layer
     for ( const auto &pair : firstLayer->getSourceLayers() )
     {
@@ -651,6 +762,9 @@ void NetworkLevelReasoner::mergeWSLayers( unsigned secondLayerIndex )
     // Remove the first layer from second layer's sources
     secondLayer->removeSourceLayer( firstLayerIndex );
 
+    if ( compressAfterMerge )
+        secondLayer->compressWeights();
+
     // Finally, remove the first layer from the map and delete it
     _layerIndexToLayer.erase( firstLayerIndex );
     delete firstLayer;
@@ -710,6 +824,25 @@ unsigned NetworkLevelReasoner::getMaxLayerSize() const
     return maxSize;
 }
 
+unsigned long long NetworkLevelReasoner::getParametersMemoryInBytes() const
+{
+    unsigned long long bytes = 0;
+    for ( const auto &layer : _layerIndexToLayer )
+        bytes += layer.second->getParametersMemoryInBytes();
+    return bytes;
+}
+
+unsigned long long NetworkLevelReasoner::getSharedParametersMemoryInBytes() const
+{
+    unsigned long long bytes = 0;
+    for ( const auto &layer : _layerIndexToLayer )
+    {
+        if ( layer.second->parametersAreShared() )
+            bytes += layer.second->getParametersMemoryInBytes();
+    }
+    return bytes;
+}
+
 const Map<unsigned, Layer *> &NetworkLevelReasoner::getLayerIndexToLayer() const
 {
     return _layerIndexToLayer;
@@ -49,6 +49,15 @@ public:
     */
     void addLayer( unsigned layerIndex, Layer::Type type, unsigned layerSize );
     void addLayerDependency( unsigned sourceLayer, unsigned targetLayer );
+
+    /*
+      Add a dependency whose weights are given as a sparse matrix. The
+      target layer takes ownership of the matrix, and never allocates
+      the dense weights.
+    */
+    void addLayerDependency( unsigned sourceLayer,
+                             unsigned targetLayer,
+                             SparseWeightMatrix *weights );
     void setWeight( unsigned sourceLayer,
                     unsigned sourceNeuron,
                     unsigned targetLayer,
@@ -89,7 +98,8 @@ public:
       Bound propagation methods:
 
         - obtainCurrentBounds: make the NLR obtain the current bounds
-          on all variables from the tableau.
+          on all variables from the tableau, from an input query, or
+          from arrays indexed by variable.
 
         - Interval arithmetic: compute the bounds of a layer's neurons
           based on the concrete bounds of the previous layer.
@@ -110,6 +120,12 @@ public:
         - receiveTighterBound: this is a callback from the layer
           objects, through which they report tighter bounds.
 
+        - markLayerDirty: this is a callback from the layer objects,
+          through which they report that their concrete bounds have
+          changed. Symbolic bound tightening and DeepPoly only
+          recompute layers starting from the first dirty one, and
+          reuse the cached symbolic bounds of the layers before it.
+
         - getConstraintTightenings: this is the function that an
           external user calls in order to collect the tighter bounds
           discovered by the NLR.
@@ -119,10 +135,17 @@ public:
     const ITableau *getTableau() const;
 
     void obtainCurrentBounds( const InputQuery &inputQuery );
+    void obtainCurrentBounds( const double *lowerBounds, const double *upperBounds );
     void obtainCurrentBounds();
     void intervalArithmeticBoundPropagation();
     void symbolicBoundPropagation();
     void deepPolyPropagation();
+
+    /*
+      The number of threads DeepPoly back-substitutes with. 0 stands for
+      the NUM_WORKERS option.
+    */
+    void setNumberOfDeepPolyThreads( unsigned numberOfThreads );
     void lpRelaxationPropagation();
     void LPTighteningForOneLayer( unsigned targetIndex );
     void MILPPropagation();
@@ -133,6 +156,11 @@ public:
     void getConstraintTightenings( List<Tightening> &tightenings );
     void clearConstraintTightenings();
 
+    void markLayerDirty( unsigned layerIndex );
+    void markAllLayersDirty();
+    unsigned getFirstDirtyLayerForSymbolicBounds() const;
+    unsigned getFirstDirtyLayerForDeepPoly() const;
+
     /*
       For debugging purposes: dump the network topology
     */
@@ -183,6 +211,13 @@ public:
     */
     unsigned getMaxLayerSize() const;
 
+    /*
+      The memory taken by the weights and biases of all layers, and the
+      part of it that is shared with copies of this reasoner
+    */
+    unsigned long long getParametersMemoryInBytes() const;
+    unsigned long long getSharedParametersMemoryInBytes() const;
+
     const Map<unsigned, Layer *> &getLayerIndexToLayer() const;
 
 private:
@@ -194,6 +229,15 @@ private:
 
 
     std::unique_ptr<DeepPolyAnalysis> _deepPolyAnalysis;
+    unsigned _numberOfDeepPolyThreads;
+
+    /*
+      The index of the first layer whose bounds have changed since the
+      last run of symbolic bound tightening / DeepPoly. Layers below
+      the watermark still hold valid symbolic bounds from that run.
+    */
+    unsigned _firstDirtyLayerForSymbolicBounds;
+    unsigned _firstDirtyLayerForDeepPoly;
 
     void freeMemoryIfNeeded();
 
@@ -28,12 +28,12 @@ namespace NLR {
 void ParallelSolver::clearSolverQueue( SolverQueue &freeSolvers )
 {
     // Remove the solvers
-    GurobiWrapper *freeSolver;
+    ILPSolver *freeSolver;
     while ( freeSolvers.pop( freeSolver ) )
         delete freeSolver;
 }
 
-void ParallelSolver::enqueueSolver( SolverQueue &solvers, GurobiWrapper *solver )
+void ParallelSolver::enqueueSolver( SolverQueue &solvers, ILPSolver *solver )
 {
     if ( !solvers.push( solver ) )
     {
@@ -16,7 +16,9 @@
 #ifndef __ParallelSolver_h__
 #define __ParallelSolver_h__
 
-#include "GurobiWrapper.h"
+#include "ILPSolver.h"
+#include "Tightening.h"
+#include "Vector.h"
 
 #include <atomic>
 #include <boost/lockfree/queue.hpp>
@@ -34,7 +36,7 @@ class ParallelSolver
 public:
 
     typedef boost::lockfree::queue
-    <GurobiWrapper *, boost::lockfree::fixed_sized<true>> SolverQueue;
+    <ILPSolver *, boost::lockfree::fixed_sized<true>> SolverQueue;
 
     /*
       Arguments for the spawned thread. This is needed because Boost::thread does
@@ -42,7 +44,7 @@ public:
     */
     struct ThreadArgument{
 
-        ThreadArgument( GurobiWrapper *gurobi, Layer *layer,
+        ThreadArgument( ILPSolver *solver, Layer *layer,
                         const Map<unsigned, Layer *> *layers,
                         unsigned index, double currentLb, double currentUb,
                         bool cutoffInUse, double cutoffValue,
@@ -52,7 +54,7 @@ public:
                         std::atomic_uint &signChanges,
                         std::atomic_uint &cutoffs,
                         bool skipTightenLb, bool skipTightenUb )
-        : _gurobi( gurobi )
+        : _solver( solver )
         , _layer( layer )
         , _layers( layers )
         , _index( index )
@@ -70,10 +72,11 @@ public:
         , _skipTightenLb ( skipTightenLb )
         , _skipTightenUb ( skipTightenUb )
         , _lastFixedNeuron( NULL )
+        , _tighteningLog( NULL )
         {
         }
 
-        ThreadArgument( GurobiWrapper *gurobi, Layer *layer,
+        ThreadArgument( ILPSolver *solver, Layer *layer,
                         unsigned index, double currentLb, double currentUb,
                         bool cutoffInUse, double cutoffValue,
                         LayerOwner *layerOwner, SolverQueue &freeSolvers,
@@ -82,7 +85,7 @@ public:
                         std::atomic_uint &signChanges,
                         std::atomic_uint &cutoffs,
                         bool skipTightenLb, bool skipTightenUb )
-        : _gurobi( gurobi )
+        : _solver( solver )
         , _layer( layer )
         , _layers( NULL )
         , _index( index )
@@ -100,10 +103,11 @@ public:
         , _skipTightenLb ( skipTightenLb )
         , _skipTightenUb ( skipTightenUb )
         , _lastFixedNeuron( NULL )
+        , _tighteningLog( NULL )
         {
         }
 
-        ThreadArgument( GurobiWrapper *gurobi, Layer *layer,
+        ThreadArgument( ILPSolver *solver, Layer *layer,
                         unsigned index, double currentLb, double currentUb,
                         bool cutoffInUse, double cutoffValue,
                         LayerOwner *layerOwner, SolverQueue &freeSolvers,
@@ -111,7 +115,7 @@ public:
                         std::atomic_uint &tighterBoundCounter,
                         std::atomic_uint &signChanges,
                         std::atomic_uint &cutoffs, NeuronIndex *lastFixedNeuron )
-        : _gurobi( gurobi )
+        : _solver( solver )
         , _layer( layer )
         , _layers( NULL )
         , _index( index )
@@ -127,6 +131,7 @@ public:
         , _signChanges( signChanges )
         , _cutoffs( cutoffs )
         , _lastFixedNeuron( lastFixedNeuron )
+        , _tighteningLog( NULL )
         {
         }
 
@@ -139,7 +144,7 @@ public:
                         unsigned lastIndexOfRelaxation,
                         unsigned targetIndex,
                         boost::thread *threads,
-                        const Map<GurobiWrapper *, unsigned> *solverToIndex )
+                        const Map<ILPSolver *, unsigned> *solverToIndex )
         : _layer( layer )
         , _layers( layers )
         , _freeSolvers( freeSolvers )
@@ -152,10 +157,11 @@ public:
         , _targetIndex ( targetIndex )
         , _threads( threads )
         , _solverToIndex( solverToIndex )
+        , _tighteningLog( NULL )
         {
         }
 
-        GurobiWrapper *_gurobi;
+        ILPSolver *_solver;
         Layer *_layer;
         const Map<unsigned, Layer *> *_layers;
         unsigned _index;
@@ -176,7 +182,14 @@ public:
         unsigned _lastIndexOfRelaxation;
         unsigned _targetIndex;
         boost::thread *_threads;
-        const Map<GurobiWrapper *, unsigned> *_solverToIndex;
+        const Map<ILPSolver *, unsigned> *_solverToIndex;
+
+        /*
+          When solvers keep their models across neurons, the bounds
+          discovered are also appended here (under _mtx), so that they
+          can be applied to the other solvers' models.
+        */
+        Vector<Tightening> *_tighteningLog;
     };
 
     /*
@@ -184,7 +197,7 @@ public:
     */
     static void clearSolverQueue( SolverQueue &freeSolvers );
 
-    static void enqueueSolver( SolverQueue &solvers, GurobiWrapper *solver );
+    static void enqueueSolver( SolverQueue &solvers, ILPSolver *solver );
 };
 
 } // namespace NLR
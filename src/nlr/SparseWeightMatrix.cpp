@@ -0,0 +1,214 @@
+/*********************                                                        */
+/*! \file SparseWeightMatrix.cpp
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "Debug.h"
+#include "SparseWeightMatrix.h"
+
+#include <algorithm>
+#include <string.h>
+
+namespace NLR {
+
+SparseWeightMatrix::SparseWeightMatrix( const double *dense, unsigned rows, unsigned columns )
+    : _rows( rows )
+    , _columns( columns )
+    , _nnz( countNonZeros( dense, rows * columns ) )
+{
+    _rowStart = new unsigned[_rows + 1];
+    _columnIndices = new unsigned[_nnz];
+    _values = new double[_nnz];
+
+    unsigned index = 0;
+    for ( unsigned i = 0; i < _rows; ++i )
+    {
+        _rowStart[i] = index;
+        for ( unsigned j = 0; j < _columns; ++j )
+        {
+            double weight = dense[i * _columns + j];
+            if ( weight == 0 )
+                continue;
+
+            _columnIndices[index] = j;
+            _values[index] = weight;
+            ++index;
+        }
+    }
+    _rowStart[_rows] = index;
+
+    ASSERT( index == _nnz );
+}
+
+SparseWeightMatrix::SparseWeightMatrix( unsigned rows, unsigned columns, const Vector<Entry> &entries )
+    : _rows( rows )
+    , _columns( columns )
+    , _nnz( 0 )
+{
+    // Order the entries by position. The sort is stable, so among
+    // duplicates the last occurrence comes last.
+    Vector<unsigned> order;
+    for ( unsigned i = 0; i < entries.size(); ++i )
+        order.append( i );
+
+    std::stable_sort( order.begin(), order.end(),
+                      [&]( unsigned a, unsigned b )
+                      {
+                          if ( entries[a]._row != entries[b]._row )
+                              return entries[a]._row < entries[b]._row;
+                          return entries[a]._column < entries[b]._column;
+                      } );
+
+    _rowStart = new unsigned[_rows + 1];
+    _columnIndices = new unsigned[entries.size()];
+    _values = new double[entries.size()];
+
+    unsigned row = 0;
+    _rowStart[0] = 0;
+    for ( unsigned i = 0; i < order.size(); ++i )
+    {
+        const Entry &entry = entries[order[i]];
+        ASSERT( entry._row < _rows && entry._column < _columns );
+
+        if ( i + 1 < order.size() &&
+             entries[order[i + 1]]._row == entry._row &&
+             entries[order[i + 1]]._column == entry._column )
+            continue;
+
+        if ( entry._value == 0 )
+            continue;
+
+        while ( row < entry._row )
+            _rowStart[++row] = _nnz;
+
+        _columnIndices[_nnz] = entry._column;
+        _values[_nnz] = entry._value;
+        ++_nnz;
+    }
+
+    while ( row < _rows )
+        _rowStart[++row] = _nnz;
+}
+
+SparseWeightMatrix::SparseWeightMatrix( const SparseWeightMatrix &other )
+    : _rows( other._rows )
+    , _columns( other._columns )
+    , _nnz( other._nnz )
+{
+    _rowStart = new unsigned[_rows + 1];
+    _columnIndices = new unsigned[_nnz];
+    _values = new double[_nnz];
+
+    memcpy( _rowStart, other._rowStart, sizeof(unsigned) * ( _rows + 1 ) );
+    memcpy( _columnIndices, other._columnIndices, sizeof(unsigned) * _nnz );
+    memcpy( _values, other._values, sizeof(double) * _nnz );
+}
+
+SparseWeightMatrix::~SparseWeightMatrix()
+{
+    delete[] _rowStart;
+    delete[] _columnIndices;
+    delete[] _values;
+}
+
+unsigned SparseWeightMatrix::getNumberOfRows() const
+{
+    return _rows;
+}
+
+unsigned SparseWeightMatrix::getNumberOfColumns() const
+{
+    return _columns;
+}
+
+unsigned SparseWeightMatrix::getNnz() const
+{
+    return _nnz;
+}
+
+double SparseWeightMatrix::get( unsigned row, unsigned column ) const
+{
+    ASSERT( row < _rows && column < _columns );
+
+    const unsigned *begin = _columnIndices + _rowStart[row];
+    const unsigned *end = _columnIndices + _rowStart[row + 1];
+    const unsigned *entry = std::lower_bound( begin, end, column );
+
+    if ( entry == end || *entry != column )
+        return 0;
+
+    return _values[entry - _columnIndices];
+}
+
+const unsigned *SparseWeightMatrix::getRowStart() const
+{
+    return _rowStart;
+}
+
+const unsigned *SparseWeightMatrix::getColumnIndices() const
+{
+    return _columnIndices;
+}
+
+const double *SparseWeightMatrix::getValues() const
+{
+    return _values;
+}
+
+void SparseWeightMatrix::toDense( double *result ) const
+{
+    std::fill_n( result, _rows * _columns, 0 );
+    for ( unsigned i = 0; i < _rows; ++i )
+        for ( unsigned k = _rowStart[i]; k < _rowStart[i + 1]; ++k )
+            result[i * _columns + _columnIndices[k]] = _values[k];
+}
+
+void SparseWeightMatrix::rightMultiply( const double *right, double *result, unsigned p ) const
+{
+    for ( unsigned i = 0; i < _rows; ++i )
+    {
+        double *resultRow = result + i * p;
+        for ( unsigned k = _rowStart[i]; k < _rowStart[i + 1]; ++k )
+        {
+            double weight = _values[k];
+            const double *rightRow = right + _columnIndices[k] * p;
+            for ( unsigned j = 0; j < p; ++j )
+                resultRow[j] += weight * rightRow[j];
+        }
+    }
+}
+
+unsigned long long SparseWeightMatrix::getMemoryInBytes() const
+{
+    return sizeof(unsigned) * ( _rows + 1 ) +
+        ( sizeof(unsigned) + sizeof(double) ) * (unsigned long long)_nnz;
+}
+
+bool SparseWeightMatrix::operator==( const SparseWeightMatrix &other ) const
+{
+    return _rows == other._rows &&
+        _columns == other._columns &&
+        _nnz == other._nnz &&
+        memcmp( _rowStart, other._rowStart, sizeof(unsigned) * ( _rows + 1 ) ) == 0 &&
+        memcmp( _columnIndices, other._columnIndices, sizeof(unsigned) * _nnz ) == 0 &&
+        memcmp( _values, other._values, sizeof(double) * _nnz ) == 0;
+}
+
+unsigned SparseWeightMatrix::countNonZeros( const double *dense, unsigned size )
+{
+    unsigned count = 0;
+    for ( unsigned i = 0; i < size; ++i )
+        if ( dense[i] != 0 )
+            ++count;
+    return count;
+}
+
+} // namespace NLR
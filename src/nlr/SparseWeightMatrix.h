@@ -0,0 +1,102 @@
+/*********************                                                        */
+/*! \file SparseWeightMatrix.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#ifndef __SparseWeightMatrix_h__
+#define __SparseWeightMatrix_h__
+
+#include "Vector.h"
+
+namespace NLR {
+
+/*
+  The weights of a weighted sum layer with respect to one of its source
+  layers, in Compressed Sparse Row (CSR) format. Like the dense weight
+  matrices of a layer, there is one row per source neuron and one column
+  per target neuron.
+
+  The entries of row i are stored at positions [rowStart[i], rowStart[i+1])
+  of the values and column indices arrays, in increasing column order.
+  Only non-zero weights are stored.
+*/
+class SparseWeightMatrix
+{
+public:
+    struct Entry
+    {
+        Entry( unsigned row, unsigned column, double value )
+            : _row( row )
+            , _column( column )
+            , _value( value )
+        {
+        }
+
+        unsigned _row;
+        unsigned _column;
+        double _value;
+    };
+
+    SparseWeightMatrix( const double *dense, unsigned rows, unsigned columns );
+
+    /*
+      Construct the matrix directly from its entries, given in any
+      order. If an entry appears more than once, the last occurrence
+      prevails. Zero entries are not stored.
+    */
+    SparseWeightMatrix( unsigned rows, unsigned columns, const Vector<Entry> &entries );
+    SparseWeightMatrix( const SparseWeightMatrix &other );
+    ~SparseWeightMatrix();
+
+    unsigned getNumberOfRows() const;
+    unsigned getNumberOfColumns() const;
+    unsigned getNnz() const;
+
+    double get( unsigned row, unsigned column ) const;
+
+    const unsigned *getRowStart() const;
+    const unsigned *getColumnIndices() const;
+    const double *getValues() const;
+
+    /*
+      Write the matrix, in dense row-major form, into result
+    */
+    void toDense( double *result ) const;
+
+    /*
+      result ( rows x p ) += this * right ( columns x p )
+    */
+    void rightMultiply( const double *right, double *result, unsigned p ) const;
+
+    unsigned long long getMemoryInBytes() const;
+
+    bool operator==( const SparseWeightMatrix &other ) const;
+
+    /*
+      The number of non-zero entries in a dense matrix
+    */
+    static unsigned countNonZeros( const double *dense, unsigned size );
+
+private:
+    unsigned _rows;
+    unsigned _columns;
+    unsigned _nnz;
+
+    unsigned *_rowStart;
+    unsigned *_columnIndices;
+    double *_values;
+
+    SparseWeightMatrix &operator=( const SparseWeightMatrix &other ) = delete;
+};
+
+} // namespace NLR
+
+#endif // __SparseWeightMatrix_h__
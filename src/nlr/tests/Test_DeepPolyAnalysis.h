@@ -16,12 +16,15 @@
 #include <cxxtest/TestSuite.h>
 
 #include "../../engine/tests/MockTableau.h"
+#include "DeepPolyAnalysis.h"
 #include "FloatUtils.h"
 #include "InputQuery.h"
 #include "Layer.h"
 #include "NetworkLevelReasoner.h"
 #include "Tightening.h"
 
+#include <cmath>
+
 class DeepPolyAnalysisTestSuite : public CxxTest::TestSuite
 {
 public:
@@ -909,4 +912,175 @@ public:
         TS_ASSERT( FloatUtils::areEqual( nlr.getLayer(3)->getLb( 1 ), -0.5516, 0.0001 ) );
         TS_ASSERT( FloatUtils::areEqual( nlr.getLayer(3)->getUb( 1 ), 0.5516, 0.0001 ) );
     }
+
+    void populateWideNetwork( NLR::NetworkLevelReasoner &nlr, MockTableau &tableau )
+    {
+        /*
+          20 inputs, two ReLU layers of 60 neurons and 10 outputs. The
+          weights are not exactly representable, so that products of
+          different widths round differently.
+        */
+        unsigned sizes[] = { 20, 60, 60, 60, 60, 10 };
+        NLR::Layer::Type types[] = { NLR::Layer::INPUT, NLR::Layer::WEIGHTED_SUM,
+                                     NLR::Layer::RELU, NLR::Layer::WEIGHTED_SUM,
+                                     NLR::Layer::RELU, NLR::Layer::WEIGHTED_SUM };
+
+        unsigned variable = 0;
+        for ( unsigned layer = 0; layer < 6; ++layer )
+        {
+            nlr.addLayer( layer, types[layer], sizes[layer] );
+            if ( layer > 0 )
+                nlr.addLayerDependency( layer - 1, layer );
+
+            for ( unsigned i = 0; i < sizes[layer]; ++i )
+                nlr.setNeuronVariable( NLR::NeuronIndex( layer, i ), variable++ );
+        }
+
+        for ( unsigned layer = 1; layer < 6; layer += 2 )
+        {
+            for ( unsigned i = 0; i < sizes[layer - 1]; ++i )
+                for ( unsigned j = 0; j < sizes[layer]; ++j )
+                    nlr.setWeight( layer - 1, i, layer, j,
+                                   std::sin( 0.7 * i + 1.3 * j + layer ) / 3 );
+
+            for ( unsigned j = 0; j < sizes[layer]; ++j )
+                nlr.setBias( layer, j, std::cos( 1.1 * j + layer ) / 10 );
+        }
+
+        for ( unsigned layer = 2; layer < 6; layer += 2 )
+            for ( unsigned i = 0; i < sizes[layer]; ++i )
+                nlr.addActivationSource( layer - 1, i, layer, i );
+
+        // Very loose bounds for neurons except inputs
+        double large = 1000000;
+
+        tableau.getBoundManager().initialize( variable );
+        for ( unsigned i = sizes[0]; i < variable; ++i )
+        {
+            tableau.setLowerBound( i, -large );
+            tableau.setUpperBound( i, large );
+        }
+    }
+
+    typedef void ( DeepPolyAnalysisTestSuite::*PopulateFunction )
+        ( NLR::NetworkLevelReasoner &, MockTableau & );
+
+    void runDeepPolyInBlocks( PopulateFunction populate, unsigned numInputs,
+                              unsigned blockSize, unsigned numberOfThreads,
+                              NLR::NetworkLevelReasoner &nlr, MockTableau &tableau,
+                              bool compressWeights = false )
+    {
+        nlr.setTableau( &tableau );
+        ( this->*populate )( nlr, tableau );
+
+        if ( compressWeights )
+        {
+            for ( unsigned i = 0; i < nlr.getNumberOfLayers(); ++i )
+                nlr.getLayer( i )->compressWeights( 1 );
+        }
+
+        for ( unsigned i = 0; i < numInputs; ++i )
+        {
+            tableau.setLowerBound( i, -1 );
+            tableau.setUpperBound( i, 1 );
+        }
+
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        NLR::DeepPolyAnalysis analysis( &nlr, blockSize, numberOfThreads );
+        TS_ASSERT_THROWS_NOTHING( analysis.run() );
+    }
+
+    void compareBlockedAndUnblockedDeepPoly( PopulateFunction populate, unsigned numInputs,
+                                             unsigned blockSize, unsigned numberOfThreads,
+                                             bool compressWeights = false )
+    {
+        NLR::NetworkLevelReasoner unblocked;
+        MockTableau unblockedTableau;
+        runDeepPolyInBlocks( populate, numInputs, 0, 1, unblocked, unblockedTableau );
+
+        NLR::NetworkLevelReasoner blocked;
+        MockTableau blockedTableau;
+        runDeepPolyInBlocks( populate, numInputs, blockSize, numberOfThreads,
+                             blocked, blockedTableau, compressWeights );
+
+        for ( const auto &pair : unblocked.getLayerIndexToLayer() )
+        {
+            const NLR::Layer *layer = pair.second;
+            const NLR::Layer *blockedLayer = blocked.getLayer( pair.first );
+            for ( unsigned i = 0; i < layer->getSize(); ++i )
+            {
+                TS_ASSERT( FloatUtils::areEqual( layer->getLb( i ), blockedLayer->getLb( i ) ) );
+                TS_ASSERT( FloatUtils::areEqual( layer->getUb( i ), blockedLayer->getUb( i ) ) );
+            }
+        }
+    }
+
+    void test_deeppoly_in_blocks_gives_the_same_bounds()
+    {
+        // Back-substitute a single neuron at a time
+        compareBlockedAndUnblockedDeepPoly( &DeepPolyAnalysisTestSuite::populateNetwork, 2, 1, 1 );
+        compareBlockedAndUnblockedDeepPoly( &DeepPolyAnalysisTestSuite::populateResidualNetwork1, 1, 1, 1 );
+        compareBlockedAndUnblockedDeepPoly( &DeepPolyAnalysisTestSuite::populateResidualNetwork2, 1, 1, 1 );
+        compareBlockedAndUnblockedDeepPoly( &DeepPolyAnalysisTestSuite::populateMaxNetwork, 2, 1, 1 );
+    }
+
+    void test_multithreaded_deeppoly_gives_the_same_bounds()
+    {
+        // Threads pick up blocks of a single neuron
+        compareBlockedAndUnblockedDeepPoly( &DeepPolyAnalysisTestSuite::populateNetwork, 2, 1, 2 );
+        compareBlockedAndUnblockedDeepPoly( &DeepPolyAnalysisTestSuite::populateResidualNetwork1, 1, 1, 3 );
+        compareBlockedAndUnblockedDeepPoly( &DeepPolyAnalysisTestSuite::populateResidualNetwork2, 1, 1, 2 );
+        compareBlockedAndUnblockedDeepPoly( &DeepPolyAnalysisTestSuite::populateMaxNetwork, 2, 1, 4 );
+
+        // Default blocks
+        compareBlockedAndUnblockedDeepPoly( &DeepPolyAnalysisTestSuite::populateNetwork, 2, 0, 2 );
+        compareBlockedAndUnblockedDeepPoly( &DeepPolyAnalysisTestSuite::populateMaxNetwork, 2, 0, 3 );
+
+        // Blocks round differently from whole layers, but agree up to
+        // the default comparison tolerance
+        compareBlockedAndUnblockedDeepPoly( &DeepPolyAnalysisTestSuite::populateWideNetwork, 20, 7, 1 );
+        compareBlockedAndUnblockedDeepPoly( &DeepPolyAnalysisTestSuite::populateWideNetwork, 20, 7, 4 );
+    }
+
+    void test_multithreaded_deeppoly_is_deterministic()
+    {
+        // With the same block size, the bounds are identical whatever
+        // the number of threads
+        for ( unsigned blockSize : { 1, 7, 16 } )
+        {
+            NLR::NetworkLevelReasoner singleThreaded;
+            MockTableau singleThreadedTableau;
+            runDeepPolyInBlocks( &DeepPolyAnalysisTestSuite::populateWideNetwork, 20, blockSize, 1,
+                                 singleThreaded, singleThreadedTableau );
+
+            for ( unsigned numberOfThreads : { 2, 3, 4 } )
+            {
+                NLR::NetworkLevelReasoner multithreaded;
+                MockTableau multithreadedTableau;
+                runDeepPolyInBlocks( &DeepPolyAnalysisTestSuite::populateWideNetwork, 20, blockSize,
+                                     numberOfThreads, multithreaded, multithreadedTableau );
+
+                for ( const auto &pair : singleThreaded.getLayerIndexToLayer() )
+                {
+                    const NLR::Layer *layer = pair.second;
+                    const NLR::Layer *multithreadedLayer = multithreaded.getLayer( pair.first );
+                    for ( unsigned i = 0; i < layer->getSize(); ++i )
+                    {
+                        TS_ASSERT_EQUALS( layer->getLb( i ), multithreadedLayer->getLb( i ) );
+                        TS_ASSERT_EQUALS( layer->getUb( i ), multithreadedLayer->getUb( i ) );
+                    }
+                }
+            }
+        }
+    }
+
+    void test_deeppoly_with_compressed_weights()
+    {
+        // All weights kept in sparse form, with and without blocks
+        compareBlockedAndUnblockedDeepPoly( &DeepPolyAnalysisTestSuite::populateNetwork, 2, 0, 1, true );
+        compareBlockedAndUnblockedDeepPoly( &DeepPolyAnalysisTestSuite::populateResidualNetwork1, 1, 1, 1, true );
+        compareBlockedAndUnblockedDeepPoly( &DeepPolyAnalysisTestSuite::populateResidualNetwork2, 1, 1, 2, true );
+        compareBlockedAndUnblockedDeepPoly( &DeepPolyAnalysisTestSuite::populateMaxNetwork, 2, 1, 1, true );
+        compareBlockedAndUnblockedDeepPoly( &DeepPolyAnalysisTestSuite::populateNetworkReindex, 2, 1, 1, true );
+    }
 };
@@ -0,0 +1,75 @@
+/*********************                                                        */
+/*! \file Test_DeepPolyWorkerPool.h
+** \verbatim
+** This file is part of the Marabou project.
+** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved. See the file COPYING in the top-level source
+** directory for licensing information.\endverbatim
+**
+** [[ Add lengthier description here ]]
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "DeepPolyWorkerPool.h"
+#include "MarabouError.h"
+
+#include <atomic>
+
+class DeepPolyWorkerPoolTestSuite : public CxxTest::TestSuite
+{
+public:
+    void setUp()
+    {
+    }
+
+    void tearDown()
+    {
+    }
+
+    void test_every_worker_runs_every_task()
+    {
+        for ( unsigned numberOfWorkers = 1; numberOfWorkers <= 4; ++numberOfWorkers )
+        {
+            NLR::DeepPolyWorkerPool pool( numberOfWorkers );
+            TS_ASSERT_EQUALS( pool.getNumberOfWorkers(), numberOfWorkers );
+
+            // The same threads are reused across tasks
+            for ( unsigned task = 0; task < 50; ++task )
+            {
+                std::atomic_uint calls( 0 );
+                std::atomic_uint workerSum( 0 );
+                pool.run( [&]( unsigned worker )
+                {
+                    ++calls;
+                    workerSum += worker;
+                } );
+
+                TS_ASSERT_EQUALS( calls.load(), numberOfWorkers );
+                TS_ASSERT_EQUALS( workerSum.load(), numberOfWorkers * ( numberOfWorkers - 1 ) / 2 );
+            }
+        }
+    }
+
+    void test_exceptions_reach_the_caller()
+    {
+        NLR::DeepPolyWorkerPool pool( 3 );
+
+        TS_ASSERT_THROWS_EQUALS( pool.run( []( unsigned worker )
+                                           {
+                                               if ( worker == 2 )
+                                                   throw MarabouError( MarabouError::DEBUGGING_ERROR );
+                                           } ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::DEBUGGING_ERROR );
+
+        // The pool is still usable afterwards
+        std::atomic_uint calls( 0 );
+        TS_ASSERT_THROWS_NOTHING( pool.run( [&]( unsigned ) { ++calls; } ) );
+        TS_ASSERT_EQUALS( calls.load(), 3U );
+    }
+};
+
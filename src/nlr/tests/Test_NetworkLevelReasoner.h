@@ -18,7 +18,9 @@
 #include "../../engine/tests/MockTableau.h" // TODO: fix this
 #include "FloatUtils.h"
 #include "InputQuery.h"
+#include "LPFormulator.h"
 #include "Layer.h"
+#include "NLRError.h"
 #include "NetworkLevelReasoner.h"
 #include "Options.h"
 #include "Tightening.h"
@@ -469,6 +471,45 @@ public:
         TS_ASSERT( FloatUtils::areEqual( output1[1], output2[1] ) );
     }
 
+    void test_store_into_other_shares_parameters()
+    {
+        NLR::NetworkLevelReasoner nlr;
+
+        populateNetwork( nlr );
+
+        // Three weighted-sum layers: 6, 6 and 4 weights (each kept along
+        // with its positive and negative parts), and 3, 2 and 2 biases
+        unsigned long long expectedBytes = ( 3 * ( 6 + 6 + 4 ) + 3 + 2 + 2 ) * sizeof(double);
+        TS_ASSERT_EQUALS( nlr.getParametersMemoryInBytes(), expectedBytes );
+        TS_ASSERT_EQUALS( nlr.getSharedParametersMemoryInBytes(), 0U );
+
+        {
+            NLR::NetworkLevelReasoner nlr2;
+            TS_ASSERT_THROWS_NOTHING( nlr.storeIntoOther( nlr2 ) );
+
+            TS_ASSERT_EQUALS( nlr.getSharedParametersMemoryInBytes(), expectedBytes );
+            TS_ASSERT_EQUALS( nlr2.getSharedParametersMemoryInBytes(), expectedBytes );
+            TS_ASSERT_EQUALS( nlr.getLayer( 1 )->getWeights( 0 ),
+                              nlr2.getLayer( 1 )->getWeights( 0 ) );
+
+            // Changing the copy does not affect the original
+            nlr2.setWeight( 0, 0, 1, 0, 5 );
+            nlr2.setBias( 5, 0, 3 );
+
+            TS_ASSERT_EQUALS( nlr.getLayer( 1 )->getWeight( 0, 0, 0 ), 1 );
+            TS_ASSERT_EQUALS( nlr2.getLayer( 1 )->getWeight( 0, 0, 0 ), 5 );
+            TS_ASSERT_EQUALS( nlr.getLayer( 5 )->getBias( 0 ), 0 );
+            TS_ASSERT_EQUALS( nlr2.getLayer( 5 )->getBias( 0 ), 3 );
+
+            // Only layer 3 is still shared
+            TS_ASSERT_EQUALS( nlr.getSharedParametersMemoryInBytes(),
+                              ( 3 * 6 + 2 ) * sizeof(double) );
+            TS_ASSERT_EQUALS( nlr2.getParametersMemoryInBytes(), expectedBytes );
+        }
+
+        TS_ASSERT_EQUALS( nlr.getSharedParametersMemoryInBytes(), 0U );
+    }
+
     void test_interval_arithmetic_bound_propagation_relu_constraints()
     {
         NLR::NetworkLevelReasoner nlr;
@@ -943,6 +984,96 @@ public:
             TS_ASSERT( bounds.exists( bound ) );
     }
 
+    void test_lp_relaxation_with_native_solver()
+    {
+        Options::get()->setString( Options::LP_TIGHTENING_SOLVER, "native" );
+
+        for ( const auto &type : { "lp", "lp-inc", "lp-warm" } )
+        {
+            Options::get()->setString( Options::MILP_SOLVER_BOUND_TIGHTENING_TYPE, type );
+
+            NLR::NetworkLevelReasoner nlr;
+            MockTableau tableau;
+            nlr.setTableau( &tableau );
+            populateNetworkSBT( nlr, tableau );
+
+            tableau.setLowerBound( 0, -1 );
+            tableau.setUpperBound( 0, 1 );
+            tableau.setLowerBound( 1, -1 );
+            tableau.setUpperBound( 1, 1 );
+
+            TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+            TS_ASSERT_THROWS_NOTHING( nlr.intervalArithmeticBoundPropagation() );
+            TS_ASSERT_THROWS_NOTHING( nlr.lpRelaxationPropagation() );
+
+            /*
+              x2: [-5, 5], x3: [-2, 2], and both ReLUs are relaxed with
+              triangles:
+
+                x4 >= 0, x4 >= x2, x4 <= 0.5 x2 + 2.5
+                x5 >= 0, x5 >= x3, x5 <= 0.5 x3 + 1
+
+              Interval arithmetic gives x6 = x4 - x5 in [-2, 5], whereas
+              the relaxation gives [-7/6, 3].
+            */
+            List<Tightening> bounds;
+            TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+
+            double lb = FloatUtils::negativeInfinity();
+            double ub = FloatUtils::infinity();
+            for ( const auto &bound : bounds )
+            {
+                if ( bound._variable == 6 && bound._type == Tightening::LB )
+                    lb = FloatUtils::max( lb, bound._value );
+                else if ( bound._variable == 6 && bound._type == Tightening::UB )
+                    ub = FloatUtils::min( ub, bound._value );
+            }
+
+            TS_ASSERT( FloatUtils::areEqual( lb, -7.0 / 6, 0.0001 ) );
+            TS_ASSERT( FloatUtils::areEqual( ub, 3, 0.0001 ) );
+        }
+
+        Options::get()->setString( Options::MILP_SOLVER_BOUND_TIGHTENING_TYPE, "none" );
+    }
+
+    void test_lp_relaxation_reuses_models_across_neurons()
+    {
+        Options::get()->setString( Options::LP_TIGHTENING_SOLVER, "native" );
+
+        unsigned numberOfModelBuilds[2];
+        double upperBounds[2];
+        for ( unsigned reuse = 0; reuse < 2; ++reuse )
+        {
+            NLR::NetworkLevelReasoner nlr;
+            MockTableau tableau;
+            nlr.setTableau( &tableau );
+            populateNetworkSBT( nlr, tableau );
+
+            tableau.setLowerBound( 0, -1 );
+            tableau.setUpperBound( 0, 1 );
+            tableau.setLowerBound( 1, -1 );
+            tableau.setUpperBound( 1, 1 );
+
+            TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+            TS_ASSERT_THROWS_NOTHING( nlr.intervalArithmeticBoundPropagation() );
+
+            NLR::LPFormulator lpFormulator( &nlr );
+            TS_ASSERT_THROWS_NOTHING( lpFormulator.optimizeBoundsWithLpRelaxation
+                                      ( nlr.getLayerIndexToLayer(), reuse == 1 ) );
+
+            numberOfModelBuilds[reuse] = lpFormulator.getNumberOfModelBuilds();
+            upperBounds[reuse] = nlr.getLayer( 3 )->getUb( 0 );
+        }
+
+        // Without reuse, a model is built for each of the 7 neurons. With
+        // reuse, the single solver builds one model per layer prefix.
+        TS_ASSERT_EQUALS( numberOfModelBuilds[0], 7U );
+        TS_ASSERT_EQUALS( numberOfModelBuilds[1], 4U );
+
+        TS_ASSERT( FloatUtils::areEqual( upperBounds[0], 3, 0.0001 ) );
+        TS_ASSERT( FloatUtils::areEqual( upperBounds[1], 3, 0.0001 ) );
+    }
+
     void test_sbt_relus_active_and_inactive()
     {
         Options::get()->setString( Options::SYMBOLIC_BOUND_TIGHTENING_TYPE,
@@ -1095,6 +1226,82 @@ public:
             TS_ASSERT( expectedBounds.exists( bound ) );
     }
 
+    void test_sbt_recomputes_from_first_dirty_layer()
+    {
+        Options::get()->setString( Options::SYMBOLIC_BOUND_TIGHTENING_TYPE,
+                                   "sbt" );
+
+        NLR::NetworkLevelReasoner nlr;
+        MockTableau tableau;
+        nlr.setTableau( &tableau );
+        populateNetworkSBT( nlr, tableau );
+
+        tableau.setLowerBound( 0, 4 );
+        tableau.setUpperBound( 0, 6 );
+        tableau.setLowerBound( 1, 1 );
+        tableau.setUpperBound( 1, 5 );
+
+        nlr.setBias( 1, 0, -15 );
+
+        TS_ASSERT_EQUALS( nlr.getFirstDirtyLayerForSymbolicBounds(), 0U );
+
+        // First invocation: same bounds as in the not-fixed test above
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( nlr.symbolicBoundPropagation() );
+        TS_ASSERT_EQUALS( nlr.getFirstDirtyLayerForSymbolicBounds(), 4U );
+
+        List<Tightening> bounds;
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+        TS_ASSERT_EQUALS( bounds.size(), 10U );
+
+        // The tightenings make it back to the tableau
+        for ( const auto &bound : bounds )
+        {
+            if ( bound._type == Tightening::LB )
+                tableau.setLowerBound( bound._variable, bound._value );
+            else
+                tableau.setUpperBound( bound._variable, bound._value );
+        }
+
+        // Nothing changed, so nothing is recomputed
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_EQUALS( nlr.getFirstDirtyLayerForSymbolicBounds(), 4U );
+        TS_ASSERT_THROWS_NOTHING( nlr.symbolicBoundPropagation() );
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+        TS_ASSERT( bounds.empty() );
+
+        // Fix the first ReLU to be inactive, as a case split would
+        tableau.setUpperBound( 4, 0 );
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_EQUALS( nlr.getFirstDirtyLayerForSymbolicBounds(), 2U );
+
+        TS_ASSERT_THROWS_NOTHING( nlr.symbolicBoundPropagation() );
+        TS_ASSERT_EQUALS( nlr.getFirstDirtyLayerForSymbolicBounds(), 4U );
+
+        /*
+          Layers 0 and 1 are reused. x4 is now 0, so:
+
+          x6.lb =  - x0 - x1  : [-11, -5]
+          x6.ub =  - x0 - x1  : [-11, -5]
+
+          Only the upper bound of x6 is tighter than before.
+        */
+        List<Tightening> expectedBounds({
+                Tightening( 6, -5, Tightening::UB ),
+                    });
+
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+        TS_ASSERT_EQUALS( expectedBounds.size(), bounds.size() );
+        for ( const auto &bound : bounds )
+            TS_ASSERT( expectedBounds.exists( bound ) );
+
+        // Changing an input bound invalidates everything
+        tableau.setUpperBound( 0, 5 );
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_EQUALS( nlr.getFirstDirtyLayerForSymbolicBounds(), 0U );
+        TS_ASSERT_EQUALS( nlr.getFirstDirtyLayerForDeepPoly(), 0U );
+    }
+
     void test_sbt_relus_active_and_externally_fixed()
     {
         Options::get()->setString( Options::SYMBOLIC_BOUND_TIGHTENING_TYPE,
@@ -1760,8 +1967,8 @@ public:
 
         for ( unsigned i = 0; i < simulationSize; ++i )
         {
-            TS_ASSERT( FloatUtils::areEqual( ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) ).get( 0 ).get( i ), 1 ) );
-            TS_ASSERT( FloatUtils::areEqual( ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) ).get( 1 ).get( i ), 4 ) );
+            TS_ASSERT( FloatUtils::areEqual( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations( 0 )[i], 1 ) );
+            TS_ASSERT( FloatUtils::areEqual( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations( 1 )[i], 4 ) );
         }
 
         // With ReLUs, case 1
@@ -1773,8 +1980,8 @@ public:
 
         for ( unsigned i = 0; i < simulationSize; ++i )
         {
-            TS_ASSERT( FloatUtils::areEqual( ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) ).get( 0 ).get( i ), 1 ) );
-            TS_ASSERT( FloatUtils::areEqual( ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) ).get( 1 ).get( i ), 1 ) );
+            TS_ASSERT( FloatUtils::areEqual( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations( 0 )[i], 1 ) );
+            TS_ASSERT( FloatUtils::areEqual( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations( 1 )[i], 1 ) );
         }
 
         // With ReLUs, case 1 and 2
@@ -1786,8 +1993,82 @@ public:
 
         for ( unsigned i = 0; i < simulationSize; ++i )
         {
-            TS_ASSERT( FloatUtils::areEqual( ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) ).get( 0 ).get( i ), 0 ) );
-            TS_ASSERT( FloatUtils::areEqual( ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) ).get( 1 ).get( i ), 0 ) );
+            TS_ASSERT( FloatUtils::areEqual( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations( 0 )[i], 0 ) );
+            TS_ASSERT( FloatUtils::areEqual( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations( 1 )[i], 0 ) );
+        }
+    }
+
+    void test_simulate_wrong_size()
+    {
+        NLR::NetworkLevelReasoner nlr;
+
+        populateNetwork( nlr );
+
+        unsigned simulationSize = Options::get()->getInt( Options::NUMBER_OF_SIMULATIONS );
+
+        // Too few simulations per neuron
+        Vector<Vector<double>> simulations1;
+        simulations1.append( Vector<double>( simulationSize - 1, 0 ) );
+        simulations1.append( Vector<double>( simulationSize - 1, 0 ) );
+
+        TS_ASSERT_THROWS_EQUALS( nlr.simulate( &simulations1 ),
+                                 const NLRError &e,
+                                 e.getCode(),
+                                 NLRError::SIMULATION_SIZE_MISMATCH );
+
+        // Too many simulations per neuron
+        Vector<Vector<double>> simulations2;
+        simulations2.append( Vector<double>( simulationSize + 1, 0 ) );
+        simulations2.append( Vector<double>( simulationSize + 1, 0 ) );
+
+        TS_ASSERT_THROWS_EQUALS( nlr.simulate( &simulations2 ),
+                                 const NLRError &e,
+                                 e.getCode(),
+                                 NLRError::SIMULATION_SIZE_MISMATCH );
+
+        // Wrong number of input neurons
+        Vector<Vector<double>> simulations3;
+        simulations3.append( Vector<double>( simulationSize, 0 ) );
+
+        TS_ASSERT_THROWS_EQUALS( nlr.simulate( &simulations3 ),
+                                 const NLRError &e,
+                                 e.getCode(),
+                                 NLRError::SIMULATION_SIZE_MISMATCH );
+    }
+
+    void test_simulate_matches_evaluate()
+    {
+        NLR::NetworkLevelReasoner nlr;
+
+        populateNetwork( nlr );
+
+        unsigned simulationSize = Options::get()->getInt( Options::NUMBER_OF_SIMULATIONS );
+
+        // Every simulation gets a different input point
+        Vector<Vector<double>> simulations;
+        simulations.append( Vector<double>( simulationSize ) );
+        simulations.append( Vector<double>( simulationSize ) );
+        for ( unsigned i = 0; i < simulationSize; ++i )
+        {
+            simulations[0][i] = ( (double)i - 5 ) / 3;
+            simulations[1][i] = ( (double)( i % 7 ) - 3 ) / 2;
+        }
+
+        TS_ASSERT_THROWS_NOTHING( nlr.simulate( &simulations ) );
+
+        const NLR::Layer *outputLayer = nlr.getLayer( nlr.getNumberOfLayers() - 1 );
+        TS_ASSERT_EQUALS( outputLayer->getNumberOfSimulations(), simulationSize );
+
+        double input[2];
+        double output[2];
+        for ( unsigned i = 0; i < simulationSize; ++i )
+        {
+            input[0] = simulations[0][i];
+            input[1] = simulations[1][i];
+            TS_ASSERT_THROWS_NOTHING( nlr.evaluate( input, output ) );
+
+            TS_ASSERT( FloatUtils::areEqual( outputLayer->getSimulations( 0 )[i], output[0] ) );
+            TS_ASSERT( FloatUtils::areEqual( outputLayer->getSimulations( 1 )[i], output[1] ) );
         }
     }
 
@@ -1808,8 +2089,8 @@ public:
 
         for ( unsigned i = 0; i < simulationSize; ++i )
         {
-            TS_ASSERT( FloatUtils::areEqual( ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) ).get( 0 ).get( i ), 0.6750, 0.0001 ) );
-            TS_ASSERT( FloatUtils::areEqual( ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) ).get( 1 ).get( i ), 3.0167, 0.0001 ) );
+            TS_ASSERT( FloatUtils::areEqual( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations( 0 )[i], 0.6750, 0.0001 ) );
+            TS_ASSERT( FloatUtils::areEqual( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations( 1 )[i], 3.0167, 0.0001 ) );
         }
 
         // case 2
@@ -1821,8 +2102,8 @@ public:
 
         for ( unsigned i = 0; i < simulationSize; ++i )
         {
-            TS_ASSERT( FloatUtils::areEqual( ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) ).get( 0 ).get( i ), 0.6032, 0.0001 ) );
-            TS_ASSERT( FloatUtils::areEqual( ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) ).get( 1 ).get( i ), 2.5790, 0.0001 ) );
+            TS_ASSERT( FloatUtils::areEqual( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations( 0 )[i], 0.6032, 0.0001 ) );
+            TS_ASSERT( FloatUtils::areEqual( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations( 1 )[i], 2.5790, 0.0001 ) );
         }
 
         // case 3
@@ -1834,8 +2115,8 @@ public:
 
         for ( unsigned i = 0; i < simulationSize; ++i )
         {
-            TS_ASSERT( FloatUtils::areEqual( ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) ).get( 0 ).get( i ), 0.5045, 0.0001 ) );
-            TS_ASSERT( FloatUtils::areEqual( ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) ).get( 1 ).get( i ), 2.1957, 0.0001 ) );
+            TS_ASSERT( FloatUtils::areEqual( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations( 0 )[i], 0.5045, 0.0001 ) );
+            TS_ASSERT( FloatUtils::areEqual( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations( 1 )[i], 2.1957, 0.0001 ) );
         }
     }
 
@@ -1893,7 +2174,7 @@ public:
         TS_ASSERT_THROWS_NOTHING( nlr.simulate( &simulations1 ) );
 
         for ( unsigned i = 0; i < simulationSize; ++i )
-            TS_ASSERT( FloatUtils::areEqual( ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) ).get( 0 ).get( i ), 2 ) );
+            TS_ASSERT( FloatUtils::areEqual( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations( 0 )[i], 2 ) );
 
         // Simulate2
         Vector<Vector<double>> simulations2;
@@ -1903,7 +2184,7 @@ public:
         TS_ASSERT_THROWS_NOTHING( nlr.simulate( &simulations2 ) );
 
         for ( unsigned i = 0; i < simulationSize; ++i )
-            TS_ASSERT( FloatUtils::areEqual( ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) ).get( 0 ).get( i ), 0 ) );
+            TS_ASSERT( FloatUtils::areEqual( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations( 0 )[i], 0 ) );
     }
 
     void test_simulate_relus_and_abs()
@@ -1961,8 +2242,8 @@ public:
 
         for ( unsigned i = 0; i < simulationSize; ++i )
         {
-            TS_ASSERT( FloatUtils::areEqual( ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) ).get( 0 ).get( i ), 2 ) );
-            TS_ASSERT( FloatUtils::areEqual( ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) ).get( 1 ).get( i ), 2 ) );
+            TS_ASSERT( FloatUtils::areEqual( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations( 0 )[i], 2 ) );
+            TS_ASSERT( FloatUtils::areEqual( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations( 1 )[i], 2 ) );
         }
 
         // Simulate2
@@ -1974,8 +2255,8 @@ public:
 
         for ( unsigned i = 0; i < simulationSize; ++i )
         {
-            TS_ASSERT( FloatUtils::areEqual( ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) ).get( 0 ).get( i ), 4 ) );
-            TS_ASSERT( FloatUtils::areEqual( ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) ).get( 1 ).get( i ), 4 ) );
+            TS_ASSERT( FloatUtils::areEqual( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations( 0 )[i], 4 ) );
+            TS_ASSERT( FloatUtils::areEqual( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations( 1 )[i], 4 ) );
         }
     }
 
@@ -2102,4 +2383,228 @@ public:
         for ( const auto &bound : expectedBounds )
             TS_ASSERT( bounds.exists( bound ) );
     }
+
+    void compressAllWeights( NLR::NetworkLevelReasoner &nlr )
+    {
+        // Every weight matrix qualifies with a maximal density of 1
+        for ( unsigned i = 0; i < nlr.getNumberOfLayers(); ++i )
+            nlr.getLayer( i )->compressWeights( 1 );
+    }
+
+    void test_compressed_weights()
+    {
+        NLR::NetworkLevelReasoner dense;
+        populateNetwork( dense );
+
+        NLR::NetworkLevelReasoner sparse;
+        populateNetwork( sparse );
+        compressAllWeights( sparse );
+
+        TS_ASSERT( sparse.getLayer( 1 )->hasSparseWeights( 0 ) );
+        TS_ASSERT( sparse.getLayer( 5 )->hasSparseWeights( 4 ) );
+        TS_ASSERT( !dense.getLayer( 1 )->hasSparseWeights( 0 ) );
+
+        // Layer 5 has 3 non-zero weights out of 4
+        TS_ASSERT_EQUALS( sparse.getLayer( 5 )->getSparseWeights( 4 )->getNnz(), 3U );
+
+        for ( unsigned i = 0; i < dense.getNumberOfLayers(); ++i )
+            TS_ASSERT( *dense.getLayer( i ) == *sparse.getLayer( i ) );
+
+        double input[2];
+        double denseOutput[2];
+        double sparseOutput[2];
+        for ( int x = -2; x <= 2; ++x )
+        {
+            input[0] = x;
+            input[1] = 1 - x;
+            TS_ASSERT_THROWS_NOTHING( dense.evaluate( input, denseOutput ) );
+            TS_ASSERT_THROWS_NOTHING( sparse.evaluate( input, sparseOutput ) );
+            TS_ASSERT( FloatUtils::areEqual( denseOutput[0], sparseOutput[0] ) );
+            TS_ASSERT( FloatUtils::areEqual( denseOutput[1], sparseOutput[1] ) );
+        }
+
+        // Changing a weight brings back the dense form
+        sparse.setWeight( 0, 0, 1, 0, 5 );
+        TS_ASSERT( !sparse.getLayer( 1 )->hasSparseWeights( 0 ) );
+        TS_ASSERT_EQUALS( sparse.getLayer( 1 )->getWeight( 0, 0, 0 ), 5 );
+        TS_ASSERT_EQUALS( sparse.getLayer( 1 )->getWeight( 0, 1, 0 ), dense.getLayer( 1 )->getWeight( 0, 1, 0 ) );
+    }
+
+    void test_compressed_weights_are_shared_and_copied()
+    {
+        NLR::NetworkLevelReasoner nlr;
+        populateNetwork( nlr );
+        compressAllWeights( nlr );
+
+        NLR::NetworkLevelReasoner nlr2;
+        TS_ASSERT_THROWS_NOTHING( nlr.storeIntoOther( nlr2 ) );
+        TS_ASSERT( nlr2.getLayer( 3 )->hasSparseWeights( 2 ) );
+        TS_ASSERT_EQUALS( nlr.getLayer( 3 )->getSparseWeights( 2 ),
+                          nlr2.getLayer( 3 )->getSparseWeights( 2 ) );
+
+        // Decompressing the copy does not affect the original
+        nlr2.getLayer( 3 )->decompressWeights();
+        TS_ASSERT( !nlr2.getLayer( 3 )->hasSparseWeights( 2 ) );
+        TS_ASSERT( nlr.getLayer( 3 )->hasSparseWeights( 2 ) );
+        TS_ASSERT( *nlr.getLayer( 3 ) == *nlr2.getLayer( 3 ) );
+    }
+
+    void test_simulate_with_compressed_weights()
+    {
+        NLR::NetworkLevelReasoner dense;
+        populateNetwork( dense );
+
+        NLR::NetworkLevelReasoner sparse;
+        populateNetwork( sparse );
+        compressAllWeights( sparse );
+
+        unsigned simulationSize = Options::get()->getInt( Options::NUMBER_OF_SIMULATIONS );
+
+        Vector<Vector<double>> simulations;
+        simulations.append( Vector<double>( simulationSize ) );
+        simulations.append( Vector<double>( simulationSize ) );
+        for ( unsigned i = 0; i < simulationSize; ++i )
+        {
+            simulations[0][i] = ( (double)i - 5 ) / 3;
+            simulations[1][i] = ( (double)( i % 7 ) - 3 ) / 2;
+        }
+
+        TS_ASSERT_THROWS_NOTHING( dense.simulate( &simulations ) );
+        TS_ASSERT_THROWS_NOTHING( sparse.simulate( &simulations ) );
+
+        const NLR::Layer *denseOutput = dense.getLayer( dense.getNumberOfLayers() - 1 );
+        const NLR::Layer *sparseOutput = sparse.getLayer( sparse.getNumberOfLayers() - 1 );
+        for ( unsigned i = 0; i < simulationSize; ++i )
+        {
+            TS_ASSERT( FloatUtils::areEqual( denseOutput->getSimulations( 0 )[i],
+                                             sparseOutput->getSimulations( 0 )[i] ) );
+            TS_ASSERT( FloatUtils::areEqual( denseOutput->getSimulations( 1 )[i],
+                                             sparseOutput->getSimulations( 1 )[i] ) );
+        }
+    }
+
+    void compareTighteningsWithCompressedWeights( bool useDeepPoly )
+    {
+        Options::get()->setString( Options::SYMBOLIC_BOUND_TIGHTENING_TYPE,
+                                   useDeepPoly ? "deeppoly" : "sbt" );
+
+        List<Tightening> bounds[2];
+        for ( unsigned compressed = 0; compressed < 2; ++compressed )
+        {
+            NLR::NetworkLevelReasoner nlr;
+            MockTableau tableau;
+            nlr.setTableau( &tableau );
+            populateNetworkSBT( nlr, tableau );
+            if ( compressed )
+                compressAllWeights( nlr );
+
+            tableau.setLowerBound( 0, 4 );
+            tableau.setUpperBound( 0, 6 );
+            tableau.setLowerBound( 1, -5 );
+            tableau.setUpperBound( 1, 5 );
+
+            TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+            TS_ASSERT_THROWS_NOTHING( nlr.intervalArithmeticBoundPropagation() );
+            if ( useDeepPoly )
+            {
+                TS_ASSERT_THROWS_NOTHING( nlr.deepPolyPropagation() );
+            }
+            else
+            {
+                TS_ASSERT_THROWS_NOTHING( nlr.symbolicBoundPropagation() );
+            }
+            TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds[compressed] ) );
+        }
+
+        TS_ASSERT_EQUALS( bounds[0].size(), bounds[1].size() );
+        for ( const auto &bound : bounds[0] )
+            TS_ASSERT( bounds[1].exists( bound ) );
+    }
+
+    void test_bound_propagation_with_compressed_weights()
+    {
+        compareTighteningsWithCompressedWeights( false );
+        compareTighteningsWithCompressedWeights( true );
+    }
+
+    void test_generate_input_query_with_compressed_weights()
+    {
+        NLR::NetworkLevelReasoner nlr;
+        populateNetwork( nlr );
+        compressAllWeights( nlr );
+
+        InputQuery ipq = nlr.generateInputQuery();
+
+        // Zero weights do not show up in the equations
+        for ( const auto &equation : ipq.getEquations() )
+            for ( const auto &addend : equation._addends )
+                TS_ASSERT( !FloatUtils::isZero( addend._coefficient ) );
+
+        TS_ASSERT( ipq.constructNetworkLevelReasoner() );
+        NLR::NetworkLevelReasoner *reconstructedNlr = ipq.getNetworkLevelReasoner();
+
+        double input[2];
+        double output[2];
+        double expectedOutput[2];
+        for ( int x = -2; x <= 2; ++x )
+        {
+            input[0] = x;
+            input[1] = 2 * x - 1;
+            TS_ASSERT_THROWS_NOTHING( nlr.evaluate( input, expectedOutput ) );
+            TS_ASSERT_THROWS_NOTHING( reconstructedNlr->evaluate( input, output ) );
+            TS_ASSERT( FloatUtils::areEqual( output[0], expectedOutput[0] ) );
+            TS_ASSERT( FloatUtils::areEqual( output[1], expectedOutput[1] ) );
+        }
+    }
+
+    void test_construct_sparse_layer_from_equations()
+    {
+        // 30 inputs x0..x29, a layer y30..y59 with yi = 2x(i-30) - 1
+        // (3% dense), and a single output z60 = sum of all yi
+        InputQuery ipq;
+        ipq.setNumberOfVariables( 61 );
+
+        for ( unsigned i = 0; i < 30; ++i )
+            ipq.markInputVariable( i, i );
+
+        for ( unsigned i = 0; i < 30; ++i )
+        {
+            Equation equation;
+            equation.addAddend( 2, i );
+            equation.addAddend( -1, 30 + i );
+            equation.setScalar( 1 );
+            ipq.addEquation( equation );
+        }
+
+        Equation sum;
+        for ( unsigned i = 0; i < 30; ++i )
+            sum.addAddend( 1, 30 + i );
+        sum.addAddend( -1, 60 );
+        sum.setScalar( 0 );
+        ipq.addEquation( sum );
+
+        TS_ASSERT( ipq.constructNetworkLevelReasoner() );
+        NLR::NetworkLevelReasoner *nlr = ipq.getNetworkLevelReasoner();
+
+        TS_ASSERT_EQUALS( nlr->getNumberOfLayers(), 3U );
+        TS_ASSERT( nlr->getLayer( 1 )->hasSparseWeights( 0 ) );
+        TS_ASSERT_EQUALS( nlr->getLayer( 1 )->getSparseWeights( 0 )->getNnz(), 30U );
+        TS_ASSERT( !nlr->getLayer( 2 )->hasSparseWeights( 1 ) );
+
+        for ( unsigned i = 0; i < 30; ++i )
+        {
+            TS_ASSERT_EQUALS( nlr->getLayer( 1 )->getWeight( 0, i, i ), 2 );
+            TS_ASSERT_EQUALS( nlr->getLayer( 1 )->getWeight( 0, i, ( i + 1 ) % 30 ), 0 );
+            TS_ASSERT_EQUALS( nlr->getLayer( 1 )->getBias( i ), -1 );
+        }
+
+        double input[30];
+        double output;
+        for ( unsigned i = 0; i < 30; ++i )
+            input[i] = i;
+
+        // sum( 2i - 1 ) for i = 0..29
+        TS_ASSERT_THROWS_NOTHING( nlr->evaluate( input, &output ) );
+        TS_ASSERT( FloatUtils::areEqual( output, 840 ) );
+    }
 };
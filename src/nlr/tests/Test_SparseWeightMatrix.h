@@ -0,0 +1,125 @@
+/*********************                                                        */
+/*! \file Test_SparseWeightMatrix.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "FloatUtils.h"
+#include "MatrixMultiplication.h"
+#include "SparseWeightMatrix.h"
+
+#include <string.h>
+
+class SparseWeightMatrixTestSuite : public CxxTest::TestSuite
+{
+public:
+    void setUp()
+    {
+    }
+
+    void tearDown()
+    {
+    }
+
+    void test_construction_and_access()
+    {
+        double dense[] = {
+            0, 2, 0, 0,
+            0, 0, 0, 0,
+            -1, 0, 0, 3,
+        };
+
+        NLR::SparseWeightMatrix matrix( dense, 3, 4 );
+
+        TS_ASSERT_EQUALS( matrix.getNumberOfRows(), 3U );
+        TS_ASSERT_EQUALS( matrix.getNumberOfColumns(), 4U );
+        TS_ASSERT_EQUALS( matrix.getNnz(), 3U );
+        TS_ASSERT_EQUALS( NLR::SparseWeightMatrix::countNonZeros( dense, 12 ), 3U );
+
+        for ( unsigned i = 0; i < 3; ++i )
+            for ( unsigned j = 0; j < 4; ++j )
+                TS_ASSERT_EQUALS( matrix.get( i, j ), dense[i * 4 + j] );
+
+        const unsigned *rowStart = matrix.getRowStart();
+        TS_ASSERT_EQUALS( rowStart[0], 0U );
+        TS_ASSERT_EQUALS( rowStart[1], 1U );
+        TS_ASSERT_EQUALS( rowStart[2], 1U );
+        TS_ASSERT_EQUALS( rowStart[3], 3U );
+        TS_ASSERT_EQUALS( matrix.getColumnIndices()[1], 0U );
+        TS_ASSERT_EQUALS( matrix.getColumnIndices()[2], 3U );
+
+        double result[12];
+        matrix.toDense( result );
+        TS_ASSERT_SAME_DATA( result, dense, sizeof(dense) );
+
+        NLR::SparseWeightMatrix copy( matrix );
+        TS_ASSERT( copy == matrix );
+    }
+
+    void test_right_multiply_matches_dense()
+    {
+        double dense[] = {
+            1, 0, 0,
+            0, 0, -2,
+        };
+        double right[] = {
+            1, 2,
+            3, 4,
+            5, 6,
+        };
+
+        NLR::SparseWeightMatrix matrix( dense, 2, 3 );
+
+        double expected[] = { 1, 1, 1, 1 };
+        double result[] = { 1, 1, 1, 1 };
+        matrixMultiplication( dense, right, expected, 2, 3, 2 );
+        matrix.rightMultiply( right, result, 2 );
+
+        for ( unsigned i = 0; i < 4; ++i )
+            TS_ASSERT( FloatUtils::areEqual( result[i], expected[i] ) );
+    }
+
+    void test_construction_from_entries()
+    {
+        // Unordered, with a duplicate (the last occurrence prevails)
+        // and an explicit zero
+        Vector<NLR::SparseWeightMatrix::Entry> entries;
+        entries.append( NLR::SparseWeightMatrix::Entry( 2, 3, 5 ) );
+        entries.append( NLR::SparseWeightMatrix::Entry( 0, 1, 2 ) );
+        entries.append( NLR::SparseWeightMatrix::Entry( 2, 0, -1 ) );
+        entries.append( NLR::SparseWeightMatrix::Entry( 1, 2, 0 ) );
+        entries.append( NLR::SparseWeightMatrix::Entry( 2, 3, 3 ) );
+
+        double dense[] = {
+            0, 2, 0, 0,
+            0, 0, 0, 0,
+            -1, 0, 0, 3,
+        };
+
+        NLR::SparseWeightMatrix matrix( 3, 4, entries );
+        NLR::SparseWeightMatrix expected( dense, 3, 4 );
+
+        TS_ASSERT_EQUALS( matrix.getNnz(), 3U );
+        TS_ASSERT( matrix == expected );
+
+        // Trailing empty rows
+        Vector<NLR::SparseWeightMatrix::Entry> firstRowOnly;
+        firstRowOnly.append( NLR::SparseWeightMatrix::Entry( 0, 0, 1 ) );
+        NLR::SparseWeightMatrix sparse( 3, 2, firstRowOnly );
+
+        const unsigned *rowStart = sparse.getRowStart();
+        TS_ASSERT_EQUALS( rowStart[0], 0U );
+        TS_ASSERT_EQUALS( rowStart[1], 1U );
+        TS_ASSERT_EQUALS( rowStart[2], 1U );
+        TS_ASSERT_EQUALS( rowStart[3], 1U );
+    }
+};
@@ -355,6 +355,60 @@ public:
         delete[] expectedOutput;
     }
 
+    void test_eliminate_one_pair_in_copy()
+    {
+        unsigned originalNumberOfLayer = 7;
+
+        NLR::NetworkLevelReasoner nlr;
+        populateNetwork_CaseB( nlr );
+
+        // The copy shares the weights and biases of the original
+        NLR::NetworkLevelReasoner copy;
+        nlr.storeIntoOther( copy );
+        TS_ASSERT( copy.getSharedParametersMemoryInBytes() > 0 );
+
+        copy.mergeConsecutiveWSLayers();
+        TS_ASSERT_EQUALS( copy.getNumberOfLayers(), originalNumberOfLayer - 1 )
+        TS_ASSERT_EQUALS( nlr.getNumberOfLayers(), originalNumberOfLayer )
+
+        NLR::NetworkLevelReasoner expectedCopy;
+        populateNetworkAfterMerge_CaseB( expectedCopy );
+
+        NLR::NetworkLevelReasoner expectedOriginal;
+        populateNetwork_CaseB( expectedOriginal );
+
+        // Check the layers of both networks are correct
+        for ( unsigned layerNumber = 0; layerNumber < originalNumberOfLayer - 1; ++layerNumber )
+        {
+            TS_ASSERT( *copy.getLayer( layerNumber ) == *expectedCopy.getLayer( layerNumber ) )
+        }
+
+        for ( unsigned layerNumber = 0; layerNumber < originalNumberOfLayer; ++layerNumber )
+        {
+            TS_ASSERT( *nlr.getLayer( layerNumber ) == *expectedOriginal.getLayer( layerNumber ) )
+        }
+
+        // Check the NN outputs are correct
+        double input[2];
+        double output[2];
+        double expectedOutput[2];
+        for ( int i = -250; i < 250; ++i )
+        {
+            input[0] = ( i - 99 ) / 2 + 1;
+            input[1] = ( 12 * i ) / 3 - 7;
+
+            copy.evaluate( input, output );
+            expectedCopy.evaluate( input, expectedOutput );
+            TS_ASSERT( FloatUtils::areEqual( output[0], expectedOutput[0] ) );
+            TS_ASSERT( FloatUtils::areEqual( output[1], expectedOutput[1] ) );
+
+            nlr.evaluate( input, output );
+            expectedOriginal.evaluate( input, expectedOutput );
+            TS_ASSERT( FloatUtils::areEqual( output[0], expectedOutput[0] ) );
+            TS_ASSERT( FloatUtils::areEqual( output[1], expectedOutput[1] ) );
+        }
+    }
+
     // A NN with a single pair of subsequent WS layers, but 3 different activation
     // layers are input for the 1st WS out of the pair
     void populateNetwork_CaseC( NLR::NetworkLevelReasoner &nlr )
@@ -20,21 +20,18 @@ BoundExplainer::BoundExplainer( unsigned numberOfVariables, unsigned numberOfRow
     : _context( ctx ),
       _numberOfVariables( numberOfVariables )
     , _numberOfRows( numberOfRows )
-    , _upperBoundExplanations( _numberOfVariables, Vector<CDO<double> *>( 0 ) )
-    , _lowerBoundExplanations( _numberOfVariables, Vector<CDO<double> *>( 0 ) )
-    , _trivialUpperBoundExplanation( 0 )
-    , _trivialLowerBoundExplanation( 0 )
+    , _upperBoundExplanations( 0 )
+    , _lowerBoundExplanations( 0 )
+    , _explanations( &ctx )
+    , _upperBoundAllocated( numberOfVariables )
+    , _lowerBoundAllocated( numberOfVariables )
+    , _sum( numberOfRows, 0 )
+    , _rowCoefficients( numberOfRows, 0 )
 {
      for ( unsigned i = 0; i < _numberOfVariables; ++i )
      {
-         for ( unsigned j = 0; j < _numberOfRows; ++j )
-         {
-            _upperBoundExplanations[i].append( new ( true ) CDO<double>( &ctx, 0 ) );
-            _lowerBoundExplanations[i].append( new ( true ) CDO<double>( &ctx, 0 ) );
-         }
-
-         _trivialUpperBoundExplanation.append( new ( true ) CDO<bool>( &ctx, true ) ) ;
-         _trivialLowerBoundExplanation.append( new ( true ) CDO<bool>( &ctx, true ) );
+         _upperBoundExplanations.append( new ( true ) CDExplanation( &ctx, NULL ) );
+         _lowerBoundExplanations.append( new ( true ) CDExplanation( &ctx, NULL ) );
      }
 }
 
@@ -42,14 +39,8 @@ BoundExplainer::~BoundExplainer()
 {
     for ( unsigned i = 0; i < _numberOfVariables; ++i )
     {
-        for ( unsigned j = 0; j < _numberOfRows; ++j )
-        {
-            _upperBoundExplanations[i][j]->deleteSelf();
-            _lowerBoundExplanations[i][j]->deleteSelf();
-        }
-
-        _trivialUpperBoundExplanation[i]->deleteSelf();
-        _trivialLowerBoundExplanation[i]->deleteSelf();
+        _upperBoundExplanations[i]->deleteSelf();
+        _lowerBoundExplanations[i]->deleteSelf();
     }
 }
 
@@ -58,18 +49,35 @@ BoundExplainer &BoundExplainer::operator=( const BoundExplainer &other )
     if ( this == &other )
         return *this;
 
+    ASSERT( _numberOfVariables == other._numberOfVariables );
+
     _numberOfRows = other._numberOfRows;
     _numberOfVariables = other._numberOfVariables;
+    _sum = Vector<double>( _numberOfRows, 0 );
+    _rowCoefficients = Vector<double>( _numberOfRows, 0 );
 
+    // Explanations are copied, as the other explainer frees its own on backtracking
     for ( unsigned i = 0; i < _numberOfVariables; ++i )
     {
-        for ( unsigned j = 0; j < _numberOfRows; ++j )
+        for ( bool isUpper : { true, false } )
         {
-            _upperBoundExplanations[i][j]->set( other._upperBoundExplanations[i][j]->get() );
-            _lowerBoundExplanations[i][j]->set( other._lowerBoundExplanations[i][j]->get() );
+            const SparseUnsortedList *explanation = isUpper ? other._upperBoundExplanations[i]->get() : other._lowerBoundExplanations[i]->get();
+            CDExplanation *target = isUpper ? _upperBoundExplanations[i] : _lowerBoundExplanations[i];
+
+            if ( !explanation )
+            {
+                target->set( NULL );
+                continue;
+            }
+
+            SparseUnsortedList *copy = new SparseUnsortedList( *explanation );
+            _explanations.push_back( copy );
+            target->set( copy );
+
+            AllocatedExplanation &allocated = isUpper ? _upperBoundAllocated[i] : _lowerBoundAllocated[i];
+            allocated._list = copy;
+            allocated._level = _context.getLevel();
         }
-        _trivialUpperBoundExplanation[i]->set( other._trivialUpperBoundExplanation[i]->get() );
-        _trivialLowerBoundExplanation[i]->set( other._trivialLowerBoundExplanation[i]->get() );
     }
 
     return *this;
@@ -85,10 +93,24 @@ unsigned BoundExplainer::getNumberOfVariables() const
     return _numberOfVariables;
 }
 
-const Vector<CDO<double> *> &BoundExplainer::getExplanation( unsigned var, bool isUpper )
+const SparseUnsortedList &BoundExplainer::getExplanation( unsigned var, bool isUpper ) const
 {
     ASSERT ( var < _numberOfVariables );
-    return isUpper ? _upperBoundExplanations[var] : _lowerBoundExplanations[var];
+    const SparseUnsortedList *explanation = isUpper ? _upperBoundExplanations[var]->get() : _lowerBoundExplanations[var]->get();
+    return explanation ? *explanation : _zeroExplanation;
+}
+
+unsigned long long BoundExplainer::getNumberOfNonZeros() const
+{
+    unsigned long long nonZeros = 0;
+    for ( unsigned i = 0; i < _numberOfVariables; ++i )
+    {
+        if ( _upperBoundExplanations[i]->get() )
+            nonZeros += _upperBoundExplanations[i]->get()->getNnz();
+        if ( _lowerBoundExplanations[i]->get() )
+            nonZeros += _lowerBoundExplanations[i]->get()->getNnz();
+    }
+    return nonZeros;
 }
 
 void BoundExplainer::updateBoundExplanation( const TableauRow &row, bool isUpper )
@@ -126,9 +148,8 @@ void BoundExplainer::updateBoundExplanation( const TableauRow &row, bool isUpper
         ci = -1;
 
     ASSERT( !FloatUtils::isZero( ci ) );
-    Vector<double> rowCoefficients = Vector<double>( _numberOfRows, 0 );
-    Vector<double> sum = Vector<double>( _numberOfRows, 0 );
-    Vector<CDO<double> *> tempBound;
+    std::fill( _rowCoefficients.begin(), _rowCoefficients.end(), 0 );
+    std::fill( _sum.begin(), _sum.end(), 0 );
 
     for ( unsigned i = 0; i < row._size; ++i )
     {
@@ -147,11 +168,10 @@ void BoundExplainer::updateBoundExplanation( const TableauRow &row, bool isUpper
         // If we're currently explaining a lower bound, we use upper bound explanation iff variable's coefficient is negative
         tempUpper = ( isUpper && realCoefficient > 0 ) || ( !isUpper && realCoefficient < 0 );
 
-        if ( ( tempUpper && *_trivialUpperBoundExplanation[curVar] ) || ( !tempUpper && *_trivialLowerBoundExplanation[curVar] ) )
+        if ( isExplanationTrivial( curVar, tempUpper ) )
             continue;
 
-        tempBound = tempUpper ? _upperBoundExplanations[curVar] : _lowerBoundExplanations[curVar];
-        addVecTimesScalar( sum, tempBound, realCoefficient );
+        addVecTimesScalar( _sum, getExplanation( curVar, tempUpper ), realCoefficient );
     }
 
     // Include lhs as well, if needed
@@ -161,19 +181,16 @@ void BoundExplainer::updateBoundExplanation( const TableauRow &row, bool isUpper
         if ( !FloatUtils::isZero( realCoefficient ) )
         {
             tempUpper = ( isUpper && realCoefficient > 0 ) || ( !isUpper && realCoefficient < 0 );
-            if ( !( tempUpper && *_trivialUpperBoundExplanation[row._lhs] ) && !( !tempUpper && *_trivialLowerBoundExplanation[row._lhs] ) )
-            {
-                tempBound = tempUpper ? _upperBoundExplanations[row._lhs] : _lowerBoundExplanations[row._lhs];
-                addVecTimesScalar( sum, tempBound, realCoefficient );
-            }
+            if ( !isExplanationTrivial( row._lhs, tempUpper ) )
+                addVecTimesScalar( _sum, getExplanation( row._lhs, tempUpper ), realCoefficient );
         }
     }
 
     // Update according to row coefficients
-    extractRowCoefficients( row, rowCoefficients, ci );
-    addVecTimesScalar( sum, rowCoefficients, 1 );
+    extractRowCoefficients( row, _rowCoefficients, ci );
+    addVecTimesScalar( _sum, _rowCoefficients, 1 );
 
-    setExplanation( sum, var, isUpper );
+    setExplanation( _sum, var, isUpper );
 }
 
 void BoundExplainer::updateBoundExplanationSparse( const SparseUnsortedList &row, bool isUpper, unsigned var )
@@ -197,9 +214,8 @@ void BoundExplainer::updateBoundExplanationSparse( const SparseUnsortedList &row
     }
 
     ASSERT( !FloatUtils::isZero( ci ) );
-    Vector<double> rowCoefficients = Vector<double>( _numberOfRows, 0 );
-    Vector<double> sum = Vector<double>( _numberOfRows, 0 );
-    Vector<CDO<double> *> tempBound;
+    std::fill( _rowCoefficients.begin(), _rowCoefficients.end(), 0 );
+    std::fill( _sum.begin(), _sum.end(), 0 );
 
     for ( const auto &entry : row )
     {
@@ -216,29 +232,28 @@ void BoundExplainer::updateBoundExplanationSparse( const SparseUnsortedList &row
         // If we're currently explaining a lower bound, we use upper bound explanation iff variable's coefficient is negative
         tempUpper = ( isUpper && realCoefficient > 0 ) || ( !isUpper && realCoefficient < 0 );
 
-        if ( ( tempUpper && *_trivialUpperBoundExplanation[entry._index] ) || ( !tempUpper && *_trivialLowerBoundExplanation[entry._index] ) )
+        if ( isExplanationTrivial( entry._index, tempUpper ) )
             continue;
 
-        tempBound = tempUpper ? _upperBoundExplanations[entry._index] : _lowerBoundExplanations[entry._index];
-        addVecTimesScalar( sum, tempBound, realCoefficient );
+        addVecTimesScalar( _sum, getExplanation( entry._index, tempUpper ), realCoefficient );
     }
 
     // Update according to row coefficients
-    extractSparseRowCoefficients( row, rowCoefficients, ci );
-    addVecTimesScalar( sum, rowCoefficients, 1 );
+    extractSparseRowCoefficients( row, _rowCoefficients, ci );
+    addVecTimesScalar( _sum, _rowCoefficients, 1 );
 
-    setExplanation( sum, var, isUpper );
+    setExplanation( _sum, var, isUpper );
 }
 
-void BoundExplainer::addVecTimesScalar( Vector<double> &sum, const Vector<CVC4::context::CDO<double> *> &input,  double scalar ) const
+void BoundExplainer::addVecTimesScalar( Vector<double> &sum, const SparseUnsortedList &input,  double scalar ) const
 {
     if ( input.empty() || FloatUtils::isZero( scalar ) )
         return;
 
-    ASSERT( sum.size() == _numberOfRows && input.size() == _numberOfRows );
+    ASSERT( sum.size() == _numberOfRows && input.getSize() <= _numberOfRows );
 
-    for ( unsigned i = 0; i < _numberOfRows; ++i )
-        sum[i] += scalar * ( *input[i] );
+    for ( const auto &entry : input )
+        sum[entry._index] += scalar * entry._value;
 }
 
 void BoundExplainer::addVecTimesScalar( Vector<double> &sum, const Vector<double> &input,  double scalar ) const
@@ -287,53 +302,50 @@ void BoundExplainer::addVariable()
     ++_numberOfRows;
     ++_numberOfVariables;
 
-    // Add info to all current explanations
-    for ( unsigned i = 0; i < _numberOfVariables - 1; ++i )
-    {
-        _upperBoundExplanations[i].append( new ( true ) CDO<double>( &_context, 0 ) );
-        _lowerBoundExplanations[i].append( new ( true ) CDO<double>( &_context, 0 ) );
-    }
-
-    // Add a new explanation for the new variable
-    _trivialUpperBoundExplanation.append( new ( true ) CDO<bool>( &_context, true ) );
-    _trivialLowerBoundExplanation.append( new ( true ) CDO<bool>( &_context, true ) );
+    // The new row has a zero coefficient in all current explanations, so
+    // only the explanations of the new variable are added
+    _upperBoundExplanations.append( new ( true ) CDExplanation( &_context, NULL ) );
+    _lowerBoundExplanations.append( new ( true ) CDExplanation( &_context, NULL ) );
+    _upperBoundAllocated.append( AllocatedExplanation() );
+    _lowerBoundAllocated.append( AllocatedExplanation() );
 
-    _upperBoundExplanations.append( Vector<CDO<double> *>( 0 ) );
-    _lowerBoundExplanations.append( Vector<CDO<double> *>( 0 ) );
-
-    for ( unsigned i = 0; i < _numberOfRows; ++i )
-    {
-        _upperBoundExplanations[_numberOfVariables - 1].append( new ( true ) CDO<double>( &_context, 0 ) );
-        _lowerBoundExplanations[_numberOfVariables - 1].append( new ( true ) CDO<double>( &_context, 0 ) );
-    }
+    _sum.append( 0 );
+    _rowCoefficients.append( 0 );
 
     ASSERT( _upperBoundExplanations.size() == _numberOfVariables );
-    ASSERT( _upperBoundExplanations[0].size() == _numberOfRows );
-    ASSERT( _trivialUpperBoundExplanation.size() == _numberOfVariables );
+    ASSERT( _lowerBoundExplanations.size() == _numberOfVariables );
 }
 
 void BoundExplainer::resetExplanation( unsigned var, bool isUpper )
 {
     ASSERT( var < _numberOfVariables );
-    Vector<CDO<double> *> temp = isUpper ? _upperBoundExplanations[var] : _lowerBoundExplanations[var];
-
-    for ( unsigned i = 0; i < _numberOfRows; ++i )
-        temp[i]->set( 0 );
-
-    isUpper ? _trivialUpperBoundExplanation[var]->set( true ) : _trivialLowerBoundExplanation[var]->set( true );
+    ( isUpper ? _upperBoundExplanations[var] : _lowerBoundExplanations[var] )->set( NULL );
 }
 
 void BoundExplainer::setExplanation( const Vector<double> &explanation, unsigned var, bool isUpper )
 {
     ASSERT( var < _numberOfVariables && ( explanation.empty() || explanation.size() == _numberOfRows ) );
-    Vector<CDO<double> *> temp = isUpper ? _upperBoundExplanations[var] : _lowerBoundExplanations[var];
-    for ( unsigned i = 0; i < _numberOfRows; ++i )
-        temp[i]->set( explanation[i] );
 
-    isUpper ? _trivialUpperBoundExplanation[var]->set( false ) : _trivialLowerBoundExplanation[var]->set( false );
+    CDExplanation *current = isUpper ? _upperBoundExplanations[var] : _lowerBoundExplanations[var];
+    AllocatedExplanation &allocated = isUpper ? _upperBoundAllocated[var] : _lowerBoundAllocated[var];
+
+    // Zero entries are not stored
+    if ( allocated._list && current->get() == allocated._list && allocated._level == _context.getLevel() )
+    {
+        // Repeated tightenings at one level overwrite the superseded list
+        allocated._list->initialize( explanation.data(), explanation.size() );
+        return;
+    }
+
+    SparseUnsortedList *sparseExplanation = new SparseUnsortedList( explanation.data(), explanation.size() );
+    _explanations.push_back( sparseExplanation );
+    current->set( sparseExplanation );
+
+    allocated._list = sparseExplanation;
+    allocated._level = _context.getLevel();
 }
 
 bool BoundExplainer::isExplanationTrivial( unsigned var, bool isUpper ) const
 {
-    return isUpper ? *_trivialUpperBoundExplanation[var] : *_trivialLowerBoundExplanation[var];
-}
\ No newline at end of file
+    return ( isUpper ? _upperBoundExplanations[var] : _lowerBoundExplanations[var] )->get() == NULL;
+}
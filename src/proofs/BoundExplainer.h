@@ -15,6 +15,7 @@
 #ifndef __BoundsExplainer_h__
 #define __BoundsExplainer_h__
 
+#include "context/cdlist.h"
 #include "context/cdo.h"
 #include "context/context.h"
 #include "SparseUnsortedList.h"
@@ -22,7 +23,16 @@
 #include "Vector.h"
 
 /*
-  A class which encapsulates bounds explanations of all variables of a tableau
+  A class which encapsulates bounds explanations of all variables of a tableau.
+
+  An explanation is a combination of the rows of the initial tableau, and
+  usually only a few of its coefficients are non-zero. Each explanation is
+  stored as an immutable sparse list, and each bound holds a
+  context-dependent pointer to its current explanation, with NULL standing
+  for the zero explanation. Updating a bound allocates a new list, unless
+  its current list was allocated in the current context and can be
+  overwritten. Backtracking restores the previous pointer and frees the
+  lists that were created in the popped contexts.
 */
 class BoundExplainer
 {
@@ -42,9 +52,16 @@ public:
     unsigned getNumberOfVariables() const;
 
     /*
-      Returns a bound explanation
+      Returns the non-zero coefficients of a bound explanation. The list
+      is valid until the explanation is changed or the context is popped.
     */
-    const Vector<CVC4::context::CDO<double> *> &getExplanation( unsigned var, bool isUpper );
+    const SparseUnsortedList &getExplanation( unsigned var, bool isUpper ) const;
+
+    /*
+      Returns the total number of non-zero coefficients in all current
+      explanations
+    */
+    unsigned long long getNumberOfNonZeros() const;
 
     /*
       Given a row, updates the values of the bound explanations of its lhs according to the row
@@ -62,7 +79,8 @@ public:
     void updateBoundExplanationSparse( const SparseUnsortedList &row, bool isUpper, unsigned var );
 
     /*
-      Adds a zero explanation at the end, and a zero entry to all explanations
+      Adds a zero explanation at the end, and a zero entry to all explanations.
+      As explanations are sparse, the existing ones are left unchanged.
      */
     void addVariable();
 
@@ -82,21 +100,61 @@ public:
     bool isExplanationTrivial( unsigned var, bool isUpper ) const;
 
 private:
+    // Frees the explanations created in a context when it is popped
+    struct DeleteExplanation
+    {
+        void operator()( SparseUnsortedList **explanation ) const
+        {
+            delete *explanation;
+        }
+    };
+
+    typedef CVC4::context::CDO<const SparseUnsortedList *> CDExplanation;
+
     CVC4::context::Context &_context;
 
     unsigned _numberOfVariables;
     unsigned _numberOfRows;
 
-    Vector<Vector<CVC4::context::CDO<double> *>> _upperBoundExplanations;
-    Vector<Vector<CVC4::context::CDO<double> *>> _lowerBoundExplanations;
+    Vector<CDExplanation *> _upperBoundExplanations;
+    Vector<CDExplanation *> _lowerBoundExplanations;
+
+    // Owns every explanation that may still be referenced
+    CVC4::context::CDList<SparseUnsortedList *, DeleteExplanation> _explanations;
+
+    /*
+      The list last allocated for each bound, and the context level it was
+      allocated at. While it is still the bound's explanation at that
+      level, no saved context refers to it.
+    */
+    struct AllocatedExplanation
+    {
+        AllocatedExplanation()
+            : _list( NULL )
+            , _level( 0 )
+        {
+        }
+
+        SparseUnsortedList *_list;
+        int _level;
+    };
+
+    Vector<AllocatedExplanation> _upperBoundAllocated;
+    Vector<AllocatedExplanation> _lowerBoundAllocated;
 
-    Vector<CVC4::context::CDO<bool> *> _trivialUpperBoundExplanation;
-    Vector<CVC4::context::CDO<bool> *> _trivialLowerBoundExplanation;
+    // Returned for trivial explanations
+    SparseUnsortedList _zeroExplanation;
+
+    /*
+      Dense work space for computing an explanation
+    */
+    Vector<double> _sum;
+    Vector<double> _rowCoefficients;
 
     /*
       Adds a multiplication of an array by scalar to another array
     */
-    void addVecTimesScalar( Vector<double> &sum, const Vector<CVC4::context::CDO<double> *> &input, double scalar ) const;
+    void addVecTimesScalar( Vector<double> &sum, const SparseUnsortedList &input, double scalar ) const;
 
     void addVecTimesScalar( Vector<double> &sum, const Vector<double> &input, double scalar ) const;
 
@@ -14,12 +14,15 @@
 
 #include "Checker.h"
 
+#include <thread>
+
 Checker::Checker( const UnsatCertificateNode *root,
                   unsigned proofSize,
                   const SparseMatrix *initialTableau,
                   const Vector<double> &groundUpperBounds,
                   const Vector<double> &groundLowerBounds,
-                  const List<PiecewiseLinearConstraint *> &problemConstraints )
+                  const List<PiecewiseLinearConstraint *> &problemConstraints,
+                  unsigned numberOfThreads )
     : _root( root )
     , _proofSize( proofSize )
     , _initialTableau( initialTableau )
@@ -27,40 +30,122 @@ Checker::Checker( const UnsatCertificateNode *root,
     , _groundLowerBounds( groundLowerBounds )
     , _problemConstraints( problemConstraints )
     , _delegationCounter( 0 )
+    , _numberOfThreads( numberOfThreads > 0 ? numberOfThreads : 1 )
+    , _numberOfBusyWorkers( 0 )
+    , _certified( true )
 {
+    unsigned index = 0;
     for ( auto constraint : problemConstraints )
-      constraint->setPhaseStatus( PHASE_NOT_FIXED );
+    {
+        constraint->setPhaseStatus( PHASE_NOT_FIXED );
+        _constraintToIndex[constraint] = index;
+        ++index;
+    }
 }
 
 bool Checker::check()
 {
-    return checkNode( _root );
+    NodeState rootState;
+    rootState._groundUpperBounds = _groundUpperBounds;
+    rootState._groundLowerBounds = _groundLowerBounds;
+    rootState._phaseStatuses = Vector<PhaseStatus>( _problemConstraints.size(), PHASE_NOT_FIXED );
+
+    unsigned order = 0;
+    _delegatedNodeToOrder.clear();
+    _delegatedInstances.clear();
+    orderDelegatedNodes( _root, order );
+
+    _certified = true;
+
+    if ( _numberOfThreads == 1 )
+    {
+        if ( !checkNode( _root, rootState ) )
+            _certified = false;
+    }
+    else
+    {
+        _tasks.push_back( new CheckTask{ _root, std::move( rootState ) } );
+
+        std::list<std::thread> workers;
+        for ( unsigned i = 0; i < _numberOfThreads; ++i )
+            workers.emplace_back( &Checker::checkTasks, this );
+
+        for ( auto &worker : workers )
+            worker.join();
+
+        ASSERT( _tasks.empty() && _numberOfBusyWorkers == 0 );
+    }
+
+    writeToFiles();
+
+    return _certified;
+}
+
+void Checker::checkTasks()
+{
+    while ( true )
+    {
+        CheckTask *task = NULL;
+        {
+            std::unique_lock<std::mutex> lock( _tasksMutex );
+            _tasksChanged.wait( lock, [this] { return !_tasks.empty() || _numberOfBusyWorkers == 0; } );
+
+            // Nothing is queued, and no worker can queue more
+            if ( _tasks.empty() )
+                return;
+
+            task = _tasks.front();
+            _tasks.pop_front();
+            ++_numberOfBusyWorkers;
+        }
+
+        if ( !checkNode( task->_node, task->_state ) )
+            _certified = false;
+        delete task;
+
+        {
+            std::lock_guard<std::mutex> lock( _tasksMutex );
+            --_numberOfBusyWorkers;
+            if ( _numberOfBusyWorkers == 0 && _tasks.empty() )
+                _tasksChanged.notify_all();
+        }
+    }
 }
 
-bool Checker::checkNode( const UnsatCertificateNode *node )
+bool Checker::offerTask( const UnsatCertificateNode *node, NodeState &state )
 {
-    Vector<double> groundUpperBoundsBackup( _groundUpperBounds );
-    Vector<double> groundLowerBoundsBackup( _groundLowerBounds );
+    if ( _numberOfThreads == 1 )
+        return false;
 
-    _upperBoundChanges.push( {} );
-    _lowerBoundChanges.push( {} );
+    {
+        std::lock_guard<std::mutex> lock( _tasksMutex );
+        // Enough work is queued already, keep descending
+        if ( _tasks.size() + _numberOfBusyWorkers >= _numberOfThreads )
+            return false;
 
+        _tasks.push_back( new CheckTask{ node, std::move( state ) } );
+    }
+
+    _tasksChanged.notify_one();
+    return true;
+}
+
+bool Checker::checkNode( const UnsatCertificateNode *node, NodeState &state )
+{
     // Update ground bounds according to head split
     for ( const auto &tightening : node->getSplit().getBoundTightenings() )
     {
-        auto &temp = tightening._type == Tightening::UB ? _groundUpperBounds : _groundLowerBounds;
+        auto &temp = tightening._type == Tightening::UB ? state._groundUpperBounds : state._groundLowerBounds;
         temp[tightening._variable] = tightening._value;
-
-        tightening._type == Tightening::UB ? _upperBoundChanges.top().insert( tightening._variable ) : _lowerBoundChanges.top().insert( tightening._variable );
     }
 
     // Check all PLC bound propagations
-    if ( !checkAllPLCExplanations( node, GlobalConfiguration::LEMMA_CERTIFICATION_TOLERANCE ) )
+    if ( !checkAllPLCExplanations( node, GlobalConfiguration::LEMMA_CERTIFICATION_TOLERANCE, state ) )
         return false;
 
     // Save to file if marked
     if ( node->getDelegationStatus() == DelegationStatus::DELEGATE_SAVE )
-        writeToFile();
+        saveDelegatedInstance( node, state );
 
     // Skip if leaf has the SAT solution, or if was marked to delegate
     if ( node->getSATSolutionFlag() || node->getDelegationStatus() != DelegationStatus::DONT_DELEGATE )
@@ -69,7 +154,7 @@ bool Checker::checkNode( const UnsatCertificateNode *node )
     // Check if it is a leaf, and if so use contradiction to check
     // return true iff it is certified
     if ( node->isValidLeaf() )
-        return checkContradiction( node );
+        return checkContradiction( node, state );
 
     // If not a valid leaf, skip only if it is leaf that was not visited
     if ( !node->getVisited() && !node->getContradiction() && node->getChildren().empty() )
@@ -94,40 +179,41 @@ bool Checker::checkNode( const UnsatCertificateNode *node )
     if ( !checkSingleVarSplits( childrenSplits ) && !childrenSplitConstraint )
         return false;
 
-    for ( const auto &child : node->getChildren() )
+    const auto &children = node->getChildren();
+    for ( auto it = children.begin(); it != children.end(); ++it )
     {
+        const UnsatCertificateNode *child = *it;
+
+        // The last child takes over the state of this node, the others get a copy
+        bool isLastChild = ( std::next( it ) == children.end() );
+        NodeState childState;
+        if ( isLastChild )
+            childState = std::move( state );
+        else
+            childState = state;
+
         // Fix the phase of the constraint corresponding to the children
         if ( childrenSplitConstraint && childrenSplitConstraint->getType() == PiecewiseLinearFunctionType::RELU )
         {
             auto tightenings = child->getSplit().getBoundTightenings();
+            PhaseStatus &phase = childState._phaseStatuses[_constraintToIndex.at( childrenSplitConstraint )];
             if ( tightenings.front()._type == Tightening::LB || tightenings.back()._type == Tightening::LB  )
-                childrenSplitConstraint->setPhaseStatus( RELU_PHASE_ACTIVE );
+                phase = RELU_PHASE_ACTIVE;
             else
-                childrenSplitConstraint->setPhaseStatus( RELU_PHASE_INACTIVE );
+                phase = RELU_PHASE_INACTIVE;
         }
 
-        if ( !checkNode( child ) )
+        if ( !isLastChild && offerTask( child, childState ) )
+            continue;
+
+        if ( !checkNode( child, childState ) )
             answer = false;
     }
 
-    // Revert all changes
-    if ( childrenSplitConstraint )
-        childrenSplitConstraint->setPhaseStatus( PHASE_NOT_FIXED );
-
-    // Revert only bounds that where changed during checking the current node
-    for ( unsigned i : _upperBoundChanges.top() )
-        _groundUpperBounds[i] = groundUpperBoundsBackup[i];
-
-    for ( unsigned i : _lowerBoundChanges.top() )
-        _groundLowerBounds[i] = groundLowerBoundsBackup[i];
-
-    _upperBoundChanges.pop();
-    _lowerBoundChanges.pop();
-
     return answer;
 }
 
-bool Checker::checkContradiction( const UnsatCertificateNode *node ) const
+bool Checker::checkContradiction( const UnsatCertificateNode *node, const NodeState &state ) const
 {
     ASSERT( node->isValidLeaf() && !node->getSATSolutionFlag() );
     const double *contradiction = node->getContradiction()->getContradiction();
@@ -135,15 +221,15 @@ bool Checker::checkContradiction( const UnsatCertificateNode *node ) const
     if ( contradiction == NULL )
     {
         double infeasibleVar = node->getContradiction()->getVar();
-        return FloatUtils::isNegative( _groundUpperBounds[infeasibleVar] - _groundLowerBounds[infeasibleVar] );
+        return FloatUtils::isNegative( state._groundUpperBounds[infeasibleVar] - state._groundLowerBounds[infeasibleVar] );
     }
 
-    double contradictionUpperBound = UNSATCertificateUtils::computeCombinationUpperBound( contradiction, _initialTableau, _groundUpperBounds.data(), _groundLowerBounds.data(), _proofSize, _groundUpperBounds.size() );
+    double contradictionUpperBound = UNSATCertificateUtils::computeCombinationUpperBound( contradiction, _initialTableau, state._groundUpperBounds.data(), state._groundLowerBounds.data(), _proofSize, state._groundUpperBounds.size() );
 
     return FloatUtils::isNegative( contradictionUpperBound );
 }
 
-bool Checker::checkAllPLCExplanations( const UnsatCertificateNode *node, double epsilon )
+bool Checker::checkAllPLCExplanations( const UnsatCertificateNode *node, double epsilon, NodeState &state ) const
 {
     // Create copies of the gb, check for their validity, and pass these changes to all the children
     // Assuming the splits of the children are ok.
@@ -163,12 +249,13 @@ bool Checker::checkAllPLCExplanations( const UnsatCertificateNode *node, double
         BoundType affectedVarBound = plcExplanation->getAffectedVarBound();
         PiecewiseLinearFunctionType constraintType = plcExplanation->getConstraintType();
 
-        double explainedBound = UNSATCertificateUtils::computeBound( causingVar, causingVarBound == UPPER, explanation, _initialTableau, _groundUpperBounds.data(), _groundLowerBounds.data(), _proofSize, _groundUpperBounds.size() );
+        double explainedBound = UNSATCertificateUtils::computeBound( causingVar, causingVarBound == UPPER, explanation, _initialTableau, state._groundUpperBounds.data(), state._groundLowerBounds.data(), _proofSize, state._groundUpperBounds.size() );
         unsigned b = 0;
         unsigned f = 0;
         unsigned aux = 0;
 
         // Make sure propagation was made by a problem constraint
+        unsigned constraintIndex = 0;
         for ( const auto &constraint : _problemConstraints )
         {
             constraintVars = constraint->getParticipatingVariables();
@@ -182,10 +269,11 @@ bool Checker::checkAllPLCExplanations( const UnsatCertificateNode *node, double
 
                 // If explanation is phase fixing, mark it
                 if ( ( affectedVarBound == LOWER && affectedVar == f && FloatUtils::isPositive( bound ) ) || ( affectedVarBound == UPPER && affectedVar == aux && FloatUtils::isZero( bound ) ) )
-                    constraint->setPhaseStatus( RELU_PHASE_ACTIVE );
+                    state._phaseStatuses[constraintIndex] = RELU_PHASE_ACTIVE;
                 else if ( ( affectedVarBound == LOWER && affectedVar == aux && FloatUtils::isPositive( bound ) ) || ( affectedVarBound == UPPER && affectedVar == f && FloatUtils::isZero( bound ) ) )
-                    constraint->setPhaseStatus( RELU_PHASE_INACTIVE );
+                    state._phaseStatuses[constraintIndex] = RELU_PHASE_INACTIVE;
             }
+            ++constraintIndex;
         }
 
         if ( !constraintMatched )
@@ -241,24 +329,20 @@ bool Checker::checkAllPLCExplanations( const UnsatCertificateNode *node, double
             return false;
 
         // If so, update the ground bounds and continue
-        auto &temp = affectedVarBound == UPPER ? _groundUpperBounds : _groundLowerBounds;
+        auto &temp = affectedVarBound == UPPER ? state._groundUpperBounds : state._groundLowerBounds;
         bool isTighter = affectedVarBound ? FloatUtils::lt( bound, temp[affectedVar] ) : FloatUtils::gt( bound, temp[affectedVar] );
         if ( isTighter )
-        {
             temp[affectedVar] = bound;
-            ASSERT( !_upperBoundChanges.empty() && !_lowerBoundChanges.empty() );
-            affectedVarBound == UPPER ? _upperBoundChanges.top().insert( affectedVar ) : _lowerBoundChanges.top().insert( affectedVar );
-        }
     }
     return true;
 }
 
-double Checker::explainBound( unsigned var, bool isUpper, const double *explanation ) const
+double Checker::explainBound( unsigned var, bool isUpper, const double *explanation, const NodeState &state ) const
 {
-    return UNSATCertificateUtils::computeBound( var, isUpper, explanation, _initialTableau, _groundUpperBounds.data(), _groundLowerBounds.data(), _proofSize, _groundUpperBounds.size() );
+    return UNSATCertificateUtils::computeBound( var, isUpper, explanation, _initialTableau, state._groundUpperBounds.data(), state._groundLowerBounds.data(), _proofSize, state._groundUpperBounds.size() );
 }
 
-PiecewiseLinearConstraint *Checker::getCorrespondingReLUConstraint( const List<PiecewiseLinearCaseSplit> &splits )
+PiecewiseLinearConstraint *Checker::getCorrespondingReLUConstraint( const List<PiecewiseLinearCaseSplit> &splits ) const
 {
     if ( splits.size() != 2 )
         return NULL;
@@ -283,7 +367,7 @@ PiecewiseLinearConstraint *Checker::getCorrespondingReLUConstraint( const List<P
 
     // Check that f = b + aux corresponds to a problem constraints
     PiecewiseLinearConstraint *correspondingConstraint = NULL;
-    for ( auto &constraint : _problemConstraints )
+    for ( const auto &constraint : _problemConstraints )
     {
         auto constraintVars = constraint->getParticipatingVariables();
         if ( constraint->getType() == PiecewiseLinearFunctionType::RELU && constraintVars.front() == b && constraintVars.exists( f ) && ( activeSplit.size() == 1 || constraintVars.back() == aux ) )
@@ -294,18 +378,27 @@ PiecewiseLinearConstraint *Checker::getCorrespondingReLUConstraint( const List<P
     return correspondingConstraint;
 }
 
-void Checker::writeToFile()
+void Checker::orderDelegatedNodes( const UnsatCertificateNode *node, unsigned &order )
+{
+    if ( node->getDelegationStatus() == DelegationStatus::DELEGATE_SAVE )
+        _delegatedNodeToOrder[node] = order++;
+
+    for ( const auto &child : node->getChildren() )
+        orderDelegatedNodes( child, order );
+}
+
+void Checker::saveDelegatedInstance( const UnsatCertificateNode *node, const NodeState &state )
 {
     List<String> leafInstance;
 
     // Write with SmtLibWriter
     unsigned b, f;
     unsigned m = _proofSize;
-    unsigned n = _groundUpperBounds.size();
+    unsigned n = state._groundUpperBounds.size();
 
     SmtLibWriter::addHeader( n, leafInstance );
-    SmtLibWriter::addGroundUpperBounds( _groundUpperBounds, leafInstance );
-    SmtLibWriter::addGroundLowerBounds( _groundLowerBounds, leafInstance );
+    SmtLibWriter::addGroundUpperBounds( state._groundUpperBounds, leafInstance );
+    SmtLibWriter::addGroundLowerBounds( state._groundLowerBounds, leafInstance );
 
     auto tableauRow = SparseUnsortedList();
 
@@ -315,24 +408,40 @@ void Checker::writeToFile()
         SmtLibWriter::addTableauRow(  tableauRow , leafInstance );
     }
 
-    for ( auto &constraint : _problemConstraints )
+    unsigned constraintIndex = 0;
+    for ( const auto &constraint : _problemConstraints )
+    {
         if ( constraint->getType() == PiecewiseLinearFunctionType::RELU )
         {
             auto vars = constraint->getParticipatingVariables();
             b = vars.front();
             vars.popBack();
             f = vars.back();
-            SmtLibWriter::addReLUConstraint( b, f, constraint->getPhaseStatus(), leafInstance );
+            SmtLibWriter::addReLUConstraint( b, f, state._phaseStatuses[constraintIndex], leafInstance );
         }
+        ++constraintIndex;
+    }
 
     SmtLibWriter::addFooter( leafInstance );
-    File file ( "delegated" + std::to_string( _delegationCounter ) + ".smtlib" );
-    SmtLibWriter::writeInstanceToFile( file, leafInstance );
 
-    ++_delegationCounter;
+    std::lock_guard<std::mutex> lock( _delegatedInstancesMutex );
+    _delegatedInstances[_delegatedNodeToOrder.at( node )] = leafInstance;
+}
+
+void Checker::writeToFiles()
+{
+    for ( const auto &delegated : _delegatedInstances )
+    {
+        File file ( "delegated" + std::to_string( _delegationCounter ) + ".smtlib" );
+        SmtLibWriter::writeInstanceToFile( file, delegated.second );
+
+        ++_delegationCounter;
+    }
+
+    _delegatedInstances.clear();
 }
 
-bool Checker::checkSingleVarSplits( const List<PiecewiseLinearCaseSplit> &splits )
+bool Checker::checkSingleVarSplits( const List<PiecewiseLinearCaseSplit> &splits ) const
 {
     if ( splits.size() != 2 )
         return false;
@@ -15,12 +15,22 @@
 #ifndef __Checker_h__
 #define __Checker_h__
 
-#include "Set.h"
-#include "Stack.h"
+#include "Map.h"
 #include "UnsatCertificateNode.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+
 /*
-  A class responsible to certify the UnsatCertificate
+  A class responsible to certify the UnsatCertificate.
+
+  Once the split of a node and its bound propagations are applied, the
+  subtrees of its children are independent, so the checker can work on
+  several subtrees at once. Every subtree carries its own copy of the ground
+  bounds and of the phases of the problem constraints, and workers hand
+  children over to idle workers through a shared queue.
 */
 class Checker
 {
@@ -30,15 +40,37 @@ public:
              const SparseMatrix *initialTableau,
              const Vector<double> &groundUpperBounds,
              const Vector<double> &groundLowerBounds,
-             const List<PiecewiseLinearConstraint *> &_problemConstraints );
+             const List<PiecewiseLinearConstraint *> &_problemConstraints,
+             unsigned numberOfThreads = 1 );
 
     /*
       Checks if the tree is indeed a correct proof of unsatisfiability.
-      If called from a certificate of a satisfiable query, checks that all proofs for bound propagations and unsatisfiable leaves are correct
+      If called from a certificate of a satisfiable query, checks that all proofs for bound propagations and unsatisfiable leaves are correct.
+      Each call starts from the ground bounds given to the constructor. The
+      verdict and the delegated files do not depend on the number of threads.
     */
     bool check();
 
 private:
+    /*
+      The ground bounds and constraint phases that hold in a node of the
+      tree. Phases are indexed by the position of the constraint in
+      _problemConstraints.
+    */
+    struct NodeState
+    {
+        Vector<double> _groundUpperBounds;
+        Vector<double> _groundLowerBounds;
+        Vector<PhaseStatus> _phaseStatuses;
+    };
+
+    // A subtree waiting to be checked, and the state of its parent
+    struct CheckTask
+    {
+        const UnsatCertificateNode *_node;
+        NodeState _state;
+    };
+
     // The root of the tree to check
     const UnsatCertificateNode *_root;
     unsigned _proofSize;
@@ -50,48 +82,91 @@ private:
     Vector<double> _groundLowerBounds;
 
     List<PiecewiseLinearConstraint *> _problemConstraints;
+    Map<const PiecewiseLinearConstraint *, unsigned> _constraintToIndex;
 
     unsigned _delegationCounter;
 
-    // Keeps track of bounds changes, so only stored bounds will be reverted when traveling the tree
-    Stack<Set<unsigned>> _upperBoundChanges;
-    Stack<Set<unsigned>> _lowerBoundChanges;
+    unsigned _numberOfThreads;
+
+    /*
+      Subtrees handed over to other workers, and the number of workers
+      currently checking a subtree. Checking ends when both are empty.
+    */
+    std::list<CheckTask *> _tasks;
+    unsigned _numberOfBusyWorkers;
+    std::mutex _tasksMutex;
+    std::condition_variable _tasksChanged;
+
+    // Cleared as soon as any check fails
+    std::atomic<bool> _certified;
 
+    /*
+      The instances of the nodes marked with DELEGATE_SAVE, keyed by the
+      position of the node in a preorder traversal of the tree, so that
+      they are numbered as in a sequential check
+    */
+    Map<const UnsatCertificateNode *, unsigned> _delegatedNodeToOrder;
+    Map<unsigned, List<String>> _delegatedInstances;
+    std::mutex _delegatedInstancesMutex;
 
     /*
-      Checks a node in the certificate tree
+      Checks a node in the certificate tree, and all the subtrees below it
+      that are not handed over to other workers. The state is updated
+      with the split and the bound propagations of the node.
     */
-    bool checkNode( const UnsatCertificateNode *node );
+    bool checkNode( const UnsatCertificateNode *node, NodeState &state );
+
+    /*
+      Takes subtrees from the queue until none are left and all workers
+      are idle
+    */
+    void checkTasks();
+
+    /*
+      Queues a child for another worker if some worker is likely to be
+      idle. Returns false if the caller should check the child itself.
+    */
+    bool offerTask( const UnsatCertificateNode *node, NodeState &state );
 
     /*
       Return true iff the changes in the ground bounds are certified, with tolerance to errors with at most size epsilon
     */
-    bool checkAllPLCExplanations( const UnsatCertificateNode *node, double epsilon );
+    bool checkAllPLCExplanations( const UnsatCertificateNode *node, double epsilon, NodeState &state ) const;
 
     /*
       Checks a contradiction
     */
-    bool checkContradiction( const UnsatCertificateNode *node ) const;
+    bool checkContradiction( const UnsatCertificateNode *node, const NodeState &state ) const;
 
     /*
       Computes a bound according to an explanation
     */
-    double explainBound( unsigned var, bool isUpper, const double *explanation ) const;
+    double explainBound( unsigned var, bool isUpper, const double *explanation, const NodeState &state ) const;
+
+    /*
+      Assigns the delegated nodes their position in the preorder
+    */
+    void orderDelegatedNodes( const UnsatCertificateNode *node, unsigned &order );
+
+    /*
+      Stores the data of a node marked to delegate as an smtlib instance
+    */
+    void saveDelegatedInstance( const UnsatCertificateNode *node, const NodeState &state );
 
     /*
-      Write the data marked to delegate to a smtlib file format
+      Write the data marked to delegate to smtlib files, in preorder
     */
-    void writeToFile();
+    void writeToFiles();
 
     /*
       Return a pointer to the problem constraint representing the split
     */
-    PiecewiseLinearConstraint *getCorrespondingReLUConstraint( const List<PiecewiseLinearCaseSplit> &splits );
+    PiecewiseLinearConstraint *getCorrespondingReLUConstraint( const List<PiecewiseLinearCaseSplit> &splits ) const;
 
     /*
       Return true iff a list of splits represents a splits over a single variable
     */
-    bool checkSingleVarSplits( const List<PiecewiseLinearCaseSplit> &splits );
+    bool checkSingleVarSplits( const List<PiecewiseLinearCaseSplit> &splits ) const;
 };
 
 #endif //__Checker_h__
\ No newline at end of file
@@ -65,14 +65,14 @@ void SmtLibWriter::addTableauRow( const SparseUnsortedList &row, List<String> &i
     instance.append( assertRowLine + "\n" );
 }
 
-void SmtLibWriter::addGroundUpperBounds( Vector<double> &bounds, List<String> &instance )
+void SmtLibWriter::addGroundUpperBounds( const Vector<double> &bounds, List<String> &instance )
 {
     unsigned n = bounds.size();
     for ( unsigned i = 0; i < n; ++i )
         instance.append( String( "( assert ( <= x" + std::to_string( i ) ) + String( " " ) + signedValue( bounds[i] ) + " ) )\n" );
 }
 
-void SmtLibWriter::addGroundLowerBounds( Vector<double> &bounds, List<String> &instance )
+void SmtLibWriter::addGroundLowerBounds( const Vector<double> &bounds, List<String> &instance )
 {
     unsigned n = bounds.size();
     for ( unsigned i = 0; i < n; ++i )
@@ -51,12 +51,12 @@ public:
     /*
       Adds lines representing the ground upper bounds, in SMTLIB format, to the SMTLIB instance
     */
-    static void addGroundUpperBounds( Vector<double> &bounds, List<String> &instance );
+    static void addGroundUpperBounds( const Vector<double> &bounds, List<String> &instance );
 
     /*
       Adds lines representing the ground lower bounds, in SMTLIB format, to the SMTLIB instance
     */
-    static void addGroundLowerBounds( Vector<double> &bounds, List<String> &instance );
+    static void addGroundLowerBounds( const Vector<double> &bounds, List<String> &instance );
 
     /*
       Writes an instances to a file
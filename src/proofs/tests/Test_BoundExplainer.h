@@ -36,6 +36,14 @@ public:
         TS_ASSERT_THROWS_NOTHING( delete context; );
     }
 
+    Vector<double> toDense( const BoundExplainer &be, unsigned var, bool isUpper )
+    {
+        Vector<double> dense( be.getNumberOfRows(), 0 );
+        for ( const auto &entry : be.getExplanation( var, isUpper ) )
+            dense[entry._index] = entry._value;
+        return dense;
+    }
+
     /*
       Test initialization of BoundExplainer
     */
@@ -66,10 +74,10 @@ public:
         BoundExplainer be( numberOfVariables, numberOfRows, *context );
 
         TS_ASSERT_THROWS_NOTHING( be.setExplanation( Vector<double>( numberOfVariables, value ), 0, true ) );
-        auto explanation = be.getExplanation( 0, true );
+        auto explanation = toDense( be, 0, true );
 
         for ( auto num : explanation )
-            TS_ASSERT_EQUALS( num->get(), value );
+            TS_ASSERT_EQUALS( num, value );
     }
 
     /*
@@ -90,8 +98,8 @@ public:
 
         for ( unsigned i = 0; i < numberOfVariables; ++ i )
         {
-            TS_ASSERT( be.isExplanationTrivial( i, true ) || ( be.getExplanation( i, true ).last()->get() == 0 && be.getExplanation( i, true ).size() == numberOfVariables + 1 ) );
-            TS_ASSERT( be.isExplanationTrivial( i, false ) || ( be.getExplanation( i, false ).last()->get() == 0 && be.getExplanation( i, false ).size() == numberOfVariables + 1 ) );
+            TS_ASSERT( be.isExplanationTrivial( i, true ) || ( toDense( be, i, true ).last() == 0 && toDense( be, i, true ).size() == numberOfVariables + 1 ) );
+            TS_ASSERT( be.isExplanationTrivial( i, false ) || ( toDense( be, i, false ).last() == 0 && toDense( be, i, false ).size() == numberOfVariables + 1 ) );
         }
 
         TS_ASSERT( be.isExplanationTrivial( numberOfVariables, true ) );
@@ -149,20 +157,20 @@ public:
         Vector<double> res1 { 2, -3, 0 };
 
         for ( unsigned i = 0; i < 3; ++i )
-            TS_ASSERT_EQUALS( be.getExplanation( 2, true )[i]->get(), res1[i] );
+            TS_ASSERT_EQUALS( toDense( be, 2, true )[i], res1[i] );
 
         be.updateBoundExplanation( updateTableauRow, false, 3 );
         // Result is 2 * { 0, 0, 2.5 } + { -1, 1, 0 }
         Vector<double> res2 { -1, 2, 5 };
         for ( unsigned i = 0; i < 3; ++i )
-            TS_ASSERT_EQUALS( be.getExplanation( 3, false )[i]->get(), res2[i] );
+            TS_ASSERT_EQUALS( toDense( be, 3, false )[i], res2[i] );
 
         be.updateBoundExplanation( updateTableauRow, false, 1 );
         // Result is -0.5 * { 1, 0, 0 } + 0.5 * { -1, 2, 5 } - 0.5 * { 1, -1, 0 }
         Vector<double> res3 { -1.5, 1.5, 2.5 };
 
         for ( unsigned i = 0; i < 3; ++i )
-            TS_ASSERT_EQUALS( be.getExplanation( 1, false )[i]->get(), res3[i] );
+            TS_ASSERT_EQUALS( toDense( be, 1, false )[i], res3[i] );
 
         // row3:= x1 = x5
         // Row coefficients are { 0, 0, 2.5 }
@@ -174,6 +182,86 @@ public:
         // Result is  ( 1 / 2.5 ) * ( -2.5 ) * { -1.5, 1.5, 2.5 } + ( 1 / 2.5 ) * { 0, 0, 2.5 }
         Vector<double> res4 { 1.5, -1.5, -1.5 };
         for ( unsigned i = 0; i < 3; ++i)
-            TS_ASSERT_EQUALS( be.getExplanation( 5, true )[i]->get(), res4[i] );
+            TS_ASSERT_EQUALS( toDense( be, 5, true )[i], res4[i] );
+    }
+
+    /*
+      Test that explanations are stored sparsely, and restored on backtracking
+    */
+    void test_explanations_are_context_dependent()
+    {
+        unsigned numberOfVariables = 3;
+        unsigned numberOfRows = 4;
+        BoundExplainer be( numberOfVariables, numberOfRows, *context );
+
+        Vector<double> explanation1 { 0, 2, 0, 0 };
+        Vector<double> explanation2 { 1, 0, 0, -3 };
+
+        be.setExplanation( explanation1, 0, true );
+        TS_ASSERT_EQUALS( be.getNumberOfNonZeros(), 1U );
+
+        context->push();
+        be.setExplanation( explanation2, 0, true );
+        be.setExplanation( explanation2, 1, false );
+        be.resetExplanation( 2, true );
+        TS_ASSERT_EQUALS( be.getNumberOfNonZeros(), 4U );
+        TS_ASSERT_EQUALS( toDense( be, 0, true ), explanation2 );
+
+        context->push();
+        be.resetExplanation( 0, true );
+        TS_ASSERT( be.isExplanationTrivial( 0, true ) );
+
+        context->pop();
+        TS_ASSERT_EQUALS( toDense( be, 0, true ), explanation2 );
+
+        context->pop();
+        TS_ASSERT_EQUALS( toDense( be, 0, true ), explanation1 );
+        TS_ASSERT( be.isExplanationTrivial( 1, false ) );
+        TS_ASSERT_EQUALS( be.getNumberOfNonZeros(), 1U );
+    }
+
+    /*
+      Test that repeated updates of a bound in one context reuse its list,
+      without affecting the explanations saved for backtracking
+    */
+    void test_repeated_updates_reuse_explanation()
+    {
+        unsigned numberOfVariables = 3;
+        unsigned numberOfRows = 4;
+        BoundExplainer be( numberOfVariables, numberOfRows, *context );
+
+        Vector<double> explanation1 { 0, 2, 0, 0 };
+        Vector<double> explanation2 { 1, 0, 0, -3 };
+        Vector<double> explanation3 { 0, 0, 5, 0 };
+
+        be.setExplanation( explanation1, 0, true );
+        const SparseUnsortedList *list = &be.getExplanation( 0, true );
+
+        be.setExplanation( explanation2, 0, true );
+        TS_ASSERT_EQUALS( &be.getExplanation( 0, true ), list );
+        TS_ASSERT_EQUALS( toDense( be, 0, true ), explanation2 );
+
+        // A new context needs its own list, and then reuses it
+        context->push();
+        be.setExplanation( explanation3, 0, true );
+        const SparseUnsortedList *innerList = &be.getExplanation( 0, true );
+        TS_ASSERT_DIFFERS( innerList, list );
+
+        be.setExplanation( explanation1, 0, true );
+        TS_ASSERT_EQUALS( &be.getExplanation( 0, true ), innerList );
+        TS_ASSERT_EQUALS( toDense( be, 0, true ), explanation1 );
+
+        context->pop();
+        TS_ASSERT_EQUALS( &be.getExplanation( 0, true ), list );
+        TS_ASSERT_EQUALS( toDense( be, 0, true ), explanation2 );
+
+        // Back at the outer level, a new list is allocated and then reused
+        be.setExplanation( explanation3, 0, true );
+        const SparseUnsortedList *outerList = &be.getExplanation( 0, true );
+        TS_ASSERT_EQUALS( toDense( be, 0, true ), explanation3 );
+
+        be.setExplanation( explanation2, 0, true );
+        TS_ASSERT_EQUALS( &be.getExplanation( 0, true ), outerList );
+        TS_ASSERT_EQUALS( toDense( be, 0, true ), explanation2 );
     }
 };
@@ -16,6 +16,10 @@
 #include "CSRMatrix.h"
 #include "cxxtest/TestSuite.h"
 
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
 class CheckerTestSuite : public CxxTest::TestSuite
 {
 public:
@@ -82,4 +86,281 @@ public:
 
         delete root;
     }
+
+    PiecewiseLinearCaseSplit singleVarSplit( unsigned var, double value, Tightening::BoundType type )
+    {
+        PiecewiseLinearCaseSplit split;
+        split.storeBoundTightening( Tightening( var, value, type ) );
+        return split;
+    }
+
+    /*
+      Splits var at 0.5 under node, and recursively splits the next
+      variables under both children. Once depth reaches 0, splits
+      variable 5 at 3: the upper child is refuted since the ground upper
+      bound of variable 5 is 2, and the lower child is handed to
+      markLeaf.
+    */
+    template <typename MarkLeaf>
+    void buildTree( UnsatCertificateNode *node, unsigned var, unsigned depth, MarkLeaf markLeaf )
+    {
+        node->setVisited();
+
+        if ( depth == 0 )
+        {
+            auto *refuted = new UnsatCertificateNode( node, singleVarSplit( 5, 3, Tightening::LB ) );
+            refuted->setVisited();
+            refuted->setContradiction( new Contradiction( 5 ) );
+
+            auto *leaf = new UnsatCertificateNode( node, singleVarSplit( 5, 3, Tightening::UB ) );
+            leaf->setVisited();
+            markLeaf( leaf );
+            return;
+        }
+
+        auto *lower = new UnsatCertificateNode( node, singleVarSplit( var, 0.5, Tightening::UB ) );
+        auto *upper = new UnsatCertificateNode( node, singleVarSplit( var, 0.5, Tightening::LB ) );
+        buildTree( lower, var + 1, depth - 1, markLeaf );
+        buildTree( upper, var + 1, depth - 1, markLeaf );
+    }
+
+    void test_certification_on_several_threads()
+    {
+        unsigned m = 3, n = 6;
+        double A[] = { 1, 0, -1, 1, 0, 0, 0, -1, 2, 0, 1, 0, 0.5, 0, -1, 0, 0, 1 };
+
+        auto initialTableau = CSRMatrix( A, m, n );
+
+        Vector<double> groundUpperBounds( n, 1 );
+        Vector<double> groundLowerBounds( n, 0 );
+        groundUpperBounds[5] = 2;
+
+        List<PiecewiseLinearConstraint *> constraintsList;
+
+        auto *root = new UnsatCertificateNode( NULL, PiecewiseLinearCaseSplit() );
+        buildTree( root, 0, 4, []( UnsatCertificateNode *leaf )
+        {
+            leaf->setSATSolutionFlag();
+        } );
+
+        for ( unsigned numberOfThreads : { 1, 2, 4, 8 } )
+        {
+            Checker checker( root, m, &initialTableau, groundUpperBounds, groundLowerBounds, constraintsList, numberOfThreads );
+            TS_ASSERT( checker.check() );
+        }
+
+        delete root;
+
+        // The last leaf lies above the split of variable 0, so refuting it
+        // by the bounds of variable 0 fails
+        root = new UnsatCertificateNode( NULL, PiecewiseLinearCaseSplit() );
+        unsigned numberOfLeaves = 0;
+        buildTree( root, 0, 4, [&numberOfLeaves]( UnsatCertificateNode *leaf )
+        {
+            if ( ++numberOfLeaves == 16 )
+                leaf->setContradiction( new Contradiction( 0 ) );
+            else
+                leaf->setSATSolutionFlag();
+        } );
+
+        for ( unsigned numberOfThreads : { 1, 2, 4, 8 } )
+        {
+            Checker checker( root, m, &initialTableau, groundUpperBounds, groundLowerBounds, constraintsList, numberOfThreads );
+            TS_ASSERT( !checker.check() );
+        }
+
+        delete root;
+    }
+
+    /*
+      Splits variable 0 at 0.5 under the root and variable 1 at 0.5 under
+      both children, and hands the four leaves to markLeaf in preorder
+    */
+    template <typename MarkLeaf>
+    UnsatCertificateNode *buildTwoLevelTree( MarkLeaf markLeaf )
+    {
+        auto *root = new UnsatCertificateNode( NULL, PiecewiseLinearCaseSplit() );
+        root->setVisited();
+
+        unsigned leafIndex = 0;
+        for ( Tightening::BoundType type : { Tightening::UB, Tightening::LB } )
+        {
+            auto *child = new UnsatCertificateNode( root, singleVarSplit( 0, 0.5, type ) );
+            child->setVisited();
+
+            auto *lower = new UnsatCertificateNode( child, singleVarSplit( 1, 0.5, Tightening::UB ) );
+            auto *upper = new UnsatCertificateNode( child, singleVarSplit( 1, 0.5, Tightening::LB ) );
+            lower->setVisited();
+            upper->setVisited();
+            markLeaf( lower, leafIndex++ );
+            markLeaf( upper, leafIndex++ );
+        }
+
+        return root;
+    }
+
+    bool verdictOnSeveralThreadsIs( const UnsatCertificateNode *root, unsigned m, const SparseMatrix *initialTableau,
+                                    const Vector<double> &groundUpperBounds, const Vector<double> &groundLowerBounds,
+                                    const List<PiecewiseLinearConstraint *> &constraintsList, bool expected )
+    {
+        bool match = true;
+        for ( unsigned numberOfThreads : { 1, 2, 4, 8 } )
+        {
+            Checker checker( root, m, initialTableau, groundUpperBounds, groundLowerBounds, constraintsList, numberOfThreads );
+            if ( checker.check() != expected )
+                match = false;
+        }
+        return match;
+    }
+
+    void test_verdicts_on_several_threads()
+    {
+        unsigned m = 3, n = 6;
+        double A[] = { 1, 0, -1, 1, 0, 0, 0, -1, 2, 0, 1, 0, 0.5, 0, -1, 0, 0, 1 };
+
+        auto initialTableau = CSRMatrix( A, m, n );
+
+        Vector<double> groundUpperBounds( n, 1 );
+        Vector<double> groundLowerBounds( n, 0 );
+        groundUpperBounds[5] = 2;
+
+        List<PiecewiseLinearConstraint *> constraintsList;
+
+        // Every leaf is certified by a flag
+        auto *root = buildTwoLevelTree( []( UnsatCertificateNode *leaf, unsigned index )
+        {
+            if ( index % 2 == 0 )
+                leaf->setSATSolutionFlag();
+            else
+                leaf->setDelegationStatus( DelegationStatus::DELEGATE_DONT_SAVE );
+        } );
+        TS_ASSERT( verdictOnSeveralThreadsIs( root, m, &initialTableau, groundUpperBounds, groundLowerBounds, constraintsList, true ) );
+        delete root;
+
+        // The first leaf cannot be refuted by the bounds of variable 0
+        root = buildTwoLevelTree( []( UnsatCertificateNode *leaf, unsigned index )
+        {
+            if ( index == 0 )
+                leaf->setContradiction( new Contradiction( 0 ) );
+            else
+                leaf->setSATSolutionFlag();
+        } );
+        TS_ASSERT( verdictOnSeveralThreadsIs( root, m, &initialTableau, groundUpperBounds, groundLowerBounds, constraintsList, false ) );
+        delete root;
+
+        // Splitting variable 5 at 3 leaves the upper child with crossing
+        // bounds, since the ground upper bound of variable 5 is 2
+        root = new UnsatCertificateNode( NULL, PiecewiseLinearCaseSplit() );
+        root->setVisited();
+        auto *satisfied = new UnsatCertificateNode( root, singleVarSplit( 5, 3, Tightening::UB ) );
+        satisfied->setVisited();
+        satisfied->setSATSolutionFlag();
+        auto *refuted = new UnsatCertificateNode( root, singleVarSplit( 5, 3, Tightening::LB ) );
+        refuted->setVisited();
+        refuted->setContradiction( new Contradiction( 5 ) );
+        TS_ASSERT( verdictOnSeveralThreadsIs( root, m, &initialTableau, groundUpperBounds, groundLowerBounds, constraintsList, true ) );
+        delete root;
+
+        // The lower bound 2 of variable 4 refutes a leaf under variable 0 <=
+        // 0.5, but holds for no leaf under variable 0 >= 0.5
+        root = new UnsatCertificateNode( NULL, PiecewiseLinearCaseSplit() );
+        root->setVisited();
+        auto *lower = new UnsatCertificateNode( root, singleVarSplit( 0, 0.5, Tightening::UB ) );
+        auto *upper = new UnsatCertificateNode( root, singleVarSplit( 0, 0.5, Tightening::LB ) );
+        lower->setVisited();
+        upper->setVisited();
+        refuted = new UnsatCertificateNode( lower, singleVarSplit( 4, 2, Tightening::LB ) );
+        refuted->setVisited();
+        refuted->setContradiction( new Contradiction( 4 ) );
+        satisfied = new UnsatCertificateNode( lower, singleVarSplit( 4, 2, Tightening::UB ) );
+        satisfied->setVisited();
+        satisfied->setSATSolutionFlag();
+        auto *unrefuted = new UnsatCertificateNode( upper, singleVarSplit( 1, 0.5, Tightening::UB ) );
+        unrefuted->setVisited();
+        unrefuted->setContradiction( new Contradiction( 4 ) );
+        satisfied = new UnsatCertificateNode( upper, singleVarSplit( 1, 0.5, Tightening::LB ) );
+        satisfied->setVisited();
+        satisfied->setSATSolutionFlag();
+        TS_ASSERT( verdictOnSeveralThreadsIs( root, m, &initialTableau, groundUpperBounds, groundLowerBounds, constraintsList, false ) );
+        delete root;
+
+        // The tree of test_certification, with the leaves certified by flags
+        ReluConstraint relu1 = ReluConstraint( 0, 2 );
+        ReluConstraint relu2 = ReluConstraint( 1, 3 );
+        List<PiecewiseLinearConstraint *> reluList = { &relu1, &relu2 };
+
+        root = new UnsatCertificateNode( NULL, PiecewiseLinearCaseSplit() );
+        auto *child1 = new UnsatCertificateNode( root, relu1.getCaseSplits().back() );
+        auto *child2 = new UnsatCertificateNode( root, relu1.getCaseSplits().front() );
+        auto *child2_1 = new UnsatCertificateNode( child2, relu2.getCaseSplits().back() );
+        auto *child2_2 = new UnsatCertificateNode( child2, relu2.getCaseSplits().front() );
+        root->setVisited();
+        child1->setVisited();
+        child2->setVisited();
+        child2_1->setVisited();
+        child1->setSATSolutionFlag();
+        child2_1->setDelegationStatus( DelegationStatus::DELEGATE_DONT_SAVE );
+        TS_ASSERT( verdictOnSeveralThreadsIs( root, m, &initialTableau, groundUpperBounds, groundLowerBounds, reluList, true ) );
+
+        // The last leaf has no contradiction
+        child2_2->setVisited();
+        TS_ASSERT( verdictOnSeveralThreadsIs( root, m, &initialTableau, groundUpperBounds, groundLowerBounds, reluList, false ) );
+        delete root;
+    }
+
+    String readFile( const String &path )
+    {
+        std::ifstream file( path.ascii() );
+        std::stringstream contents;
+        contents << file.rdbuf();
+        return String( contents.str() );
+    }
+
+    void test_delegated_files_hold_the_bounds_of_their_leaf()
+    {
+        unsigned m = 3, n = 6;
+        double A[] = { 1, 0, -1, 1, 0, 0, 0, -1, 2, 0, 1, 0, 0.5, 0, -1, 0, 0, 1 };
+
+        auto initialTableau = CSRMatrix( A, m, n );
+
+        Vector<double> groundUpperBounds( n, 1 );
+        Vector<double> groundLowerBounds( n, 0 );
+        groundUpperBounds[5] = 2;
+
+        List<PiecewiseLinearConstraint *> constraintsList;
+
+        auto *root = buildTwoLevelTree( []( UnsatCertificateNode *leaf, unsigned /* index */ )
+        {
+            leaf->setDelegationStatus( DelegationStatus::DELEGATE_SAVE );
+        } );
+
+        // The bounds of variables 0 and 1 along the path of each leaf, in
+        // preorder
+        const char *expectedBounds[4][2] = {
+            { "( assert ( <= x0 0.500000 ) )", "( assert ( <= x1 0.500000 ) )" },
+            { "( assert ( <= x0 0.500000 ) )", "( assert ( >= x1 0.500000 ) )" },
+            { "( assert ( >= x0 0.500000 ) )", "( assert ( <= x1 0.500000 ) )" },
+            { "( assert ( >= x0 0.500000 ) )", "( assert ( >= x1 0.500000 ) )" },
+        };
+
+        for ( unsigned numberOfThreads : { 1, 2, 4 } )
+        {
+            Checker checker( root, m, &initialTableau, groundUpperBounds, groundLowerBounds, constraintsList, numberOfThreads );
+            TS_ASSERT( checker.check() );
+
+            for ( unsigned i = 0; i < 4; ++i )
+            {
+                String path = Stringf( "delegated%u.smtlib", i );
+                String contents = readFile( path );
+                TS_ASSERT( contents.contains( expectedBounds[i][0] ) );
+                TS_ASSERT( contents.contains( expectedBounds[i][1] ) );
+                TS_ASSERT( !contents.contains( expectedBounds[i ^ 1][1] ) );
+                TS_ASSERT( !contents.contains( expectedBounds[i ^ 2][0] ) );
+                TS_ASSERT( contents.contains( "( assert ( <= x5 2.000000 ) )" ) );
+                unlink( path.ascii() );
+            }
+        }
+
+        delete root;
+    }
 };
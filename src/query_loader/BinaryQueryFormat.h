@@ -0,0 +1,101 @@
+/*********************                                                        */
+/*! \file BinaryQueryFormat.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** The layout of binary input query files (.ipqb), which are written by
+ ** InputQuery::saveQuery and memory-mapped by QueryLoader. All values are
+ ** stored in the byte order of the machine that wrote the file. After the
+ ** header come the following sections, each starting at an 8-byte
+ ** boundary:
+ **
+ **   input variables      (index, variable) pairs of uint32
+ **   output variables     (index, variable) pairs of uint32
+ **   lower bounds         uint32 variables, then double values
+ **   upper bounds         uint32 variables, then double values
+ **   equation types       uint32 (Equation::EquationType)
+ **   equation rows        numberOfEquations + 1 uint32 offsets into
+ **                        the addends (CSR)
+ **   equation scalars     double
+ **   addend variables     uint32
+ **   addend coefficients  double
+ **   constraints          one record per non-linear constraint: a
+ **                        ConstraintRecord, followed by the serialized
+ **                        constraint and padding to 4 bytes
+
+ **/
+
+#ifndef __BinaryQueryFormat_h__
+#define __BinaryQueryFormat_h__
+
+#include <cstdint>
+
+namespace BinaryQueryFormat {
+
+// Files with this extension are read and written in the binary format
+static const char *const FILE_EXTENSION = ".ipqb";
+
+static const char MAGIC[8] = { 'M', 'A', 'R', 'A', 'B', 'O', 'U', 'Q' };
+
+// Bumped whenever the layout changes
+static const uint32_t VERSION = 1;
+
+// Reads differently if the file was written with another byte order
+static const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+// Sections start at multiples of this
+static const unsigned SECTION_ALIGNMENT = 8;
+
+struct Header
+{
+    char _magic[8];
+    uint32_t _version;
+    uint32_t _byteOrderMark;
+    uint32_t _numberOfVariables;
+    uint32_t _numberOfInputVariables;
+    uint32_t _numberOfOutputVariables;
+    uint32_t _numberOfLowerBounds;
+    uint32_t _numberOfUpperBounds;
+    uint32_t _numberOfEquations;
+    uint32_t _numberOfAddends;
+    uint32_t _numberOfConstraints;
+};
+
+static_assert( sizeof(Header) % SECTION_ALIGNMENT == 0,
+               "Sections must start aligned after the header" );
+
+enum ConstraintKind {
+    PIECEWISE_LINEAR = 0,
+    TRANSCENDENTAL = 1,
+};
+
+struct ConstraintRecord
+{
+    // A ConstraintKind
+    uint32_t _kind;
+    // A PiecewiseLinearFunctionType or TranscendentalFunctionType
+    uint32_t _type;
+    // The length of the serialized constraint that follows
+    uint32_t _length;
+};
+
+inline unsigned paddingFor( unsigned long long size, unsigned alignment )
+{
+    return ( alignment - size % alignment ) % alignment;
+}
+
+} // namespace BinaryQueryFormat
+
+#endif // __BinaryQueryFormat_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
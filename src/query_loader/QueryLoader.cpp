@@ -15,6 +15,7 @@
  **/
 
 #include "AutoFile.h"
+#include "BinaryQueryFormat.h"
 #include "Debug.h"
 #include "DisjunctionConstraint.h"
 #include "Equation.h"
@@ -23,10 +24,13 @@
 #include "MStringf.h"
 #include "MarabouError.h"
 #include "MaxConstraint.h"
+#include "MemoryMappedFile.h"
 #include "QueryLoader.h"
 #include "ReluConstraint.h"
 #include "SignConstraint.h"
 
+#include <cstring>
+
 InputQuery QueryLoader::loadQuery( const String &fileName )
 {
     if ( !IFile::exists( fileName ) )
@@ -34,6 +38,9 @@ InputQuery QueryLoader::loadQuery( const String &fileName )
         throw MarabouError( MarabouError::FILE_DOES_NOT_EXIST, Stringf( "File %s not found.\n", fileName.ascii() ).ascii() );
     }
 
+    if ( String( fileName ).endsWith( BinaryQueryFormat::FILE_EXTENSION ) )
+        return loadBinaryQuery( fileName );
+
     InputQuery inputQuery;
     AutoFile input( fileName );
     input->open( IFile::MODE_READ );
@@ -236,6 +243,186 @@ InputQuery QueryLoader::loadQuery( const String &fileName )
     return inputQuery;
 }
 
+/*
+  Hands out consecutive sections of a binary query, checking that they lie
+  within the file
+*/
+class BinaryQueryReader
+{
+public:
+    BinaryQueryReader( const char *data, size_t size, const String &fileName )
+        : _data( data )
+        , _size( size )
+        , _offset( 0 )
+        , _fileName( fileName )
+    {
+    }
+
+    template<class T>
+    const T *readSection( unsigned long long count )
+    {
+        return (const T *)read( count * sizeof(T), BinaryQueryFormat::SECTION_ALIGNMENT );
+    }
+
+    const char *read( unsigned long long size, unsigned alignment )
+    {
+        unsigned long long paddedSize = size + BinaryQueryFormat::paddingFor( size, alignment );
+        if ( paddedSize > _size - _offset )
+            fail( "the file is truncated" );
+
+        const char *result = _data + _offset;
+        _offset += paddedSize;
+        return result;
+    }
+
+    bool done() const
+    {
+        return _offset == _size;
+    }
+
+    void fail( const char *reason ) const
+    {
+        throw MarabouError( MarabouError::INVALID_BINARY_QUERY,
+                            Stringf( "%s: %s", _fileName.ascii(), reason ).ascii() );
+    }
+
+private:
+    const char *_data;
+    size_t _size;
+    size_t _offset;
+    String _fileName;
+};
+
+InputQuery QueryLoader::loadBinaryQuery( const String &fileName )
+{
+    MemoryMappedFile file( fileName );
+    BinaryQueryReader reader( file.data(), file.size(), fileName );
+
+    const BinaryQueryFormat::Header *header =
+        reader.readSection<BinaryQueryFormat::Header>( 1 );
+    if ( memcmp( header->_magic, BinaryQueryFormat::MAGIC, sizeof(header->_magic) ) != 0 )
+        reader.fail( "not a binary input query" );
+    if ( header->_byteOrderMark != BinaryQueryFormat::BYTE_ORDER_MARK )
+        reader.fail( "written with a different byte order" );
+    if ( header->_version != BinaryQueryFormat::VERSION )
+        reader.fail( Stringf( "unsupported version %u", header->_version ).ascii() );
+
+    QL_LOG( Stringf( "Number of variables: %u\n", header->_numberOfVariables ).ascii() );
+    QL_LOG( Stringf( "Number of equations: %u\n", header->_numberOfEquations ).ascii() );
+    QL_LOG( Stringf( "Number of non-linear constraints: %u\n",
+                     header->_numberOfConstraints ).ascii() );
+
+    InputQuery inputQuery;
+    inputQuery.setNumberOfVariables( header->_numberOfVariables );
+
+    // Input and output variables
+    const uint32_t *inputs = reader.readSection<uint32_t>( 2ULL * header->_numberOfInputVariables );
+    for ( unsigned i = 0; i < header->_numberOfInputVariables; ++i )
+        inputQuery.markInputVariable( inputs[2 * i + 1], inputs[2 * i] );
+
+    const uint32_t *outputs = reader.readSection<uint32_t>( 2ULL * header->_numberOfOutputVariables );
+    for ( unsigned i = 0; i < header->_numberOfOutputVariables; ++i )
+        inputQuery.markOutputVariable( outputs[2 * i + 1], outputs[2 * i] );
+
+    // Bounds
+    const uint32_t *variables = reader.readSection<uint32_t>( header->_numberOfLowerBounds );
+    const double *values = reader.readSection<double>( header->_numberOfLowerBounds );
+    for ( unsigned i = 0; i < header->_numberOfLowerBounds; ++i )
+        inputQuery.setLowerBound( variables[i], values[i] );
+
+    variables = reader.readSection<uint32_t>( header->_numberOfUpperBounds );
+    values = reader.readSection<double>( header->_numberOfUpperBounds );
+    for ( unsigned i = 0; i < header->_numberOfUpperBounds; ++i )
+        inputQuery.setUpperBound( variables[i], values[i] );
+
+    // Equations
+    const uint32_t *types = reader.readSection<uint32_t>( header->_numberOfEquations );
+    const uint32_t *rowStart = reader.readSection<uint32_t>( header->_numberOfEquations + 1ULL );
+    const double *scalars = reader.readSection<double>( header->_numberOfEquations );
+    const uint32_t *addendVariables = reader.readSection<uint32_t>( header->_numberOfAddends );
+    const double *coefficients = reader.readSection<double>( header->_numberOfAddends );
+
+    // Validate all row offsets before indexing the addends with them
+    if ( rowStart[0] != 0 || rowStart[header->_numberOfEquations] != header->_numberOfAddends )
+        reader.fail( "the equations do not match the number of addends" );
+    for ( unsigned i = 0; i < header->_numberOfEquations; ++i )
+    {
+        if ( rowStart[i] > rowStart[i + 1] )
+            reader.fail( "the equations are not sorted" );
+    }
+
+    for ( unsigned i = 0; i < header->_numberOfEquations; ++i )
+    {
+        if ( types[i] > Equation::LE )
+            throw MarabouError( MarabouError::INVALID_EQUATION_TYPE, Stringf( "Invalid Equation Type\n" ).ascii() );
+
+        Equation equation( (Equation::EquationType)types[i] );
+        equation.setScalar( scalars[i] );
+        for ( unsigned j = rowStart[i]; j < rowStart[i + 1]; ++j )
+            equation.addAddend( coefficients[j], addendVariables[j] );
+
+        inputQuery.addEquation( equation );
+    }
+
+    // Non-linear constraints
+    for ( unsigned i = 0; i < header->_numberOfConstraints; ++i )
+    {
+        const BinaryQueryFormat::ConstraintRecord *record =
+            (const BinaryQueryFormat::ConstraintRecord *)
+            reader.read( sizeof(BinaryQueryFormat::ConstraintRecord), 4 );
+        String serializedConstraint( reader.read( record->_length, 4 ), record->_length );
+
+        QL_LOG( Stringf( "Non-Linear Constraint: %u, serialized:\t%s \n",
+                         i, serializedConstraint.ascii() ).ascii() );
+
+        if ( record->_kind == BinaryQueryFormat::PIECEWISE_LINEAR )
+        {
+            switch ( record->_type )
+            {
+            case RELU:
+                inputQuery.addPiecewiseLinearConstraint( new ReluConstraint( serializedConstraint ) );
+                break;
+
+            case ABSOLUTE_VALUE:
+                inputQuery.addPiecewiseLinearConstraint( new AbsoluteValueConstraint( serializedConstraint ) );
+                break;
+
+            case MAX:
+                inputQuery.addPiecewiseLinearConstraint( new MaxConstraint( serializedConstraint ) );
+                break;
+
+            case DISJUNCTION:
+                inputQuery.addPiecewiseLinearConstraint( new DisjunctionConstraint( serializedConstraint ) );
+                break;
+
+            case SIGN:
+                inputQuery.addPiecewiseLinearConstraint( new SignConstraint( serializedConstraint ) );
+                break;
+
+            default:
+                throw MarabouError( MarabouError::UNSUPPORTED_PIECEWISE_LINEAR_CONSTRAINT,
+                                    Stringf( "Unsupported piecewise-linear constraint type: %u\n",
+                                             record->_type ).ascii() );
+            }
+        }
+        else if ( record->_kind == BinaryQueryFormat::TRANSCENDENTAL && record->_type == SIGMOID )
+        {
+            inputQuery.addTranscendentalConstraint( new SigmoidConstraint( serializedConstraint ) );
+        }
+        else
+        {
+            throw MarabouError( MarabouError::UNSUPPORTED_NON_LINEAR_CONSTRAINT,
+                                Stringf( "Unsupported non-linear constraint: kind %u, type %u\n",
+                                         record->_kind, record->_type ).ascii() );
+        }
+    }
+
+    if ( !reader.done() )
+        reader.fail( "unexpected data after the constraints" );
+
+    inputQuery.constructNetworkLevelReasoner();
+    return inputQuery;
+}
 
 //
 // Local Variables:
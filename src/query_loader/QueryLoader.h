@@ -29,9 +29,14 @@ public:
     unsigned _numConstraunsigneds;
 
     /*
-      Parse a serialized query and return it in InputQuery form
+      Parse a serialized query and return it in InputQuery form. Files
+      ending with BinaryQueryFormat::FILE_EXTENSION are expected to be in
+      the binary format, all others in the text format.
     */
     static InputQuery loadQuery( const String &fileName );
+
+private:
+    static InputQuery loadBinaryQuery( const String &fileName );
 };
 
 #endif // __QueryLoader_h__
@@ -16,18 +16,29 @@
 #include <cxxtest/TestSuite.h>
 
 #include "AutoFile.h"
+#include "BinaryQueryFormat.h"
 #include "Equation.h"
+#include "File.h"
 #include "InputQuery.h"
+#include "MarabouError.h"
+#include "MemoryMappedFile.h"
+#include "MockErrno.h"
 #include "MockFileFactory.h"
 #include "QueryLoader.h"
 #include "ReluConstraint.h"
+#include "T/sys/stat.h"
 #include "T/unistd.h"
 
 const String QUERY_TEST_FILE( "QueryTest.txt" );
+const String BINARY_QUERY_TEST_FILE( "QueryTest.ipqb" );
 
 class MockForQueryLoader
-    : public MockFileFactory
+    : public MockErrno
+    , public MockFileFactory
     , public T::Base_stat
+    , public T::Base_open
+    , public T::Base_write
+    , public T::Base_close
 {
 public:
     int stat( const char */* path */, StructStat */* buf */ )
@@ -35,6 +46,22 @@ public:
         // 0 means file exists
         return 0;
     }
+
+    // Binary queries are written to and mapped from the disk
+    int open( const char *pathname, int flags, mode_t mode )
+    {
+        return ::open( pathname, flags, mode );
+    }
+
+    ssize_t write( int fd, const void *buf, size_t count )
+    {
+        return ::write( fd, buf, count );
+    }
+
+    int close( int fd )
+    {
+        return ::close( fd );
+    }
 };
 
 class QueryLoaderTestSuite : public CxxTest::TestSuite
@@ -52,10 +79,8 @@ public:
         TS_ASSERT_THROWS_NOTHING( delete mock );
     }
 
-    void test_load_query()
+    void populateQuery( InputQuery &inputQuery )
     {
-        // Set up simple query as a test
-        InputQuery inputQuery;
         inputQuery.setNumberOfVariables( 10 );
 
         // Input layer with one variable
@@ -122,14 +147,10 @@ public:
         equation4.setScalar( 0.5 );     // Equation bias
         inputQuery.addEquation( equation4 );
 
-        // Save the query and then reload the query
-        inputQuery.saveQuery( QUERY_TEST_FILE );
-
-        mock->mockFile.wasCreated = false;
-        mock->mockFile.wasDiscarded = false;
-
-        InputQuery inputQuery2 = QueryLoader::loadQuery( QUERY_TEST_FILE );
+    }
 
+    void compareQueries( InputQuery &inputQuery, InputQuery &inputQuery2 )
+    {
         // Check that inputQuery is unchanged when saving and loading the query
         // Number of variables unchanged
         TS_ASSERT( inputQuery.getNumberOfVariables() == inputQuery2.getNumberOfVariables() );
@@ -178,6 +199,150 @@ public:
         tsConstraint2 = (SigmoidConstraint *)*tsIt2;
         TS_ASSERT( tsConstraint->serializeToString() == tsConstraint2->serializeToString() );
     }
+
+    void test_load_query()
+    {
+        // Set up simple query as a test
+        InputQuery inputQuery;
+        populateQuery( inputQuery );
+
+        // Save the query and then reload the query
+        inputQuery.saveQuery( QUERY_TEST_FILE );
+
+        mock->mockFile.wasCreated = false;
+        mock->mockFile.wasDiscarded = false;
+
+        InputQuery inputQuery2 = QueryLoader::loadQuery( QUERY_TEST_FILE );
+
+        compareQueries( inputQuery, inputQuery2 );
+    }
+
+    void test_load_binary_query()
+    {
+        InputQuery inputQuery;
+        populateQuery( inputQuery );
+
+        // Not representable in the text format
+        inputQuery.setUpperBound( 1, 1.0 / 3 );
+        inputQuery.markInputVariable( 2, 1 );
+
+        inputQuery.saveQuery( BINARY_QUERY_TEST_FILE );
+        InputQuery inputQuery2 = QueryLoader::loadQuery( BINARY_QUERY_TEST_FILE );
+
+        compareQueries( inputQuery, inputQuery2 );
+        TS_ASSERT_EQUALS( inputQuery2.getUpperBound( 1 ), 1.0 / 3 );
+        TS_ASSERT_EQUALS( inputQuery2.inputVariableByIndex( 0 ), 0U );
+        TS_ASSERT_EQUALS( inputQuery2.inputVariableByIndex( 1 ), 2U );
+
+        unlink( BINARY_QUERY_TEST_FILE.ascii() );
+    }
+
+    void test_convert_between_text_and_binary_queries()
+    {
+        InputQuery inputQuery;
+        populateQuery( inputQuery );
+
+        // Text to binary
+        inputQuery.saveQuery( QUERY_TEST_FILE );
+        String text = mock->mockFile.writtenLines;
+        mock->mockFile.wasCreated = false;
+        mock->mockFile.wasDiscarded = false;
+
+        InputQuery fromText = QueryLoader::loadQuery( QUERY_TEST_FILE );
+        fromText.saveQuery( BINARY_QUERY_TEST_FILE );
+
+        // Binary to text
+        InputQuery fromBinary = QueryLoader::loadQuery( BINARY_QUERY_TEST_FILE );
+        compareQueries( inputQuery, fromBinary );
+
+        mock->mockFile.wasCreated = false;
+        mock->mockFile.wasDiscarded = false;
+        mock->mockFile.writtenLines = "";
+        fromBinary.saveQuery( QUERY_TEST_FILE );
+        TS_ASSERT_EQUALS( mock->mockFile.writtenLines, text );
+
+        unlink( BINARY_QUERY_TEST_FILE.ascii() );
+    }
+
+    void test_load_invalid_binary_query()
+    {
+        InputQuery inputQuery;
+        populateQuery( inputQuery );
+        inputQuery.saveQuery( BINARY_QUERY_TEST_FILE );
+
+        String contents;
+        {
+            MemoryMappedFile file( BINARY_QUERY_TEST_FILE );
+            contents = String( file.data(), file.size() );
+        }
+
+        // Truncated
+        writeFile( BINARY_QUERY_TEST_FILE, contents.substring( 0, contents.length() / 2 ) );
+        TS_ASSERT_THROWS_EQUALS( QueryLoader::loadQuery( BINARY_QUERY_TEST_FILE ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::INVALID_BINARY_QUERY );
+
+        // Not a binary query
+        writeFile( BINARY_QUERY_TEST_FILE, String( "10\n0\n0\n0\n0\n0\n0\n" ) );
+        TS_ASSERT_THROWS_EQUALS( QueryLoader::loadQuery( BINARY_QUERY_TEST_FILE ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::INVALID_BINARY_QUERY );
+
+        // Row offsets that point past the addends, in an equation before
+        // the last one
+        BinaryQueryFormat::Header header;
+        memcpy( &header, contents.ascii(), sizeof(header) );
+        TS_ASSERT( header._numberOfEquations >= 2 );
+
+        unsigned long long rowStartOffset = sizeof(header) +
+            padded( 2 * header._numberOfInputVariables * sizeof(uint32_t) ) +
+            padded( 2 * header._numberOfOutputVariables * sizeof(uint32_t) ) +
+            padded( header._numberOfLowerBounds * sizeof(uint32_t) ) +
+            padded( header._numberOfLowerBounds * sizeof(double) ) +
+            padded( header._numberOfUpperBounds * sizeof(uint32_t) ) +
+            padded( header._numberOfUpperBounds * sizeof(double) ) +
+            padded( header._numberOfEquations * sizeof(uint32_t) );
+
+        uint32_t rowStart = 1000000;
+        writeFile( BINARY_QUERY_TEST_FILE,
+                   patch( contents, rowStartOffset + sizeof(uint32_t), rowStart ) );
+        TS_ASSERT_THROWS_EQUALS( QueryLoader::loadQuery( BINARY_QUERY_TEST_FILE ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::INVALID_BINARY_QUERY );
+
+        // The first row does not start at the first addend
+        rowStart = 1;
+        writeFile( BINARY_QUERY_TEST_FILE, patch( contents, rowStartOffset, rowStart ) );
+        TS_ASSERT_THROWS_EQUALS( QueryLoader::loadQuery( BINARY_QUERY_TEST_FILE ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::INVALID_BINARY_QUERY );
+
+        unlink( BINARY_QUERY_TEST_FILE.ascii() );
+    }
+
+    unsigned long long padded( unsigned long long size )
+    {
+        return size + BinaryQueryFormat::paddingFor( size, BinaryQueryFormat::SECTION_ALIGNMENT );
+    }
+
+    String patch( const String &contents, unsigned long long offset, uint32_t value )
+    {
+        std::string bytes( contents.ascii(), contents.length() );
+        memcpy( &bytes[offset], &value, sizeof(value) );
+        return String( bytes.data(), bytes.size() );
+    }
+
+    void writeFile( const String &path, const String &contents )
+    {
+        File file( path );
+        file.open( IFile::MODE_WRITE_TRUNCATE );
+        file.write( contents );
+        file.close();
+    }
 };
 
 //